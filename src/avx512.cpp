@@ -0,0 +1,577 @@
+/**************************************************************************************************
+ * Apache License, Version 2.0
+ * Copyright (c) 2024 chciken/Niko Zurstraßen
+ **************************************************************************************************/
+
+#include "avx512.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+using namespace FfUtils;
+
+namespace {
+
+template <typename FT>
+using Uint = typename FloatToUint<FT>::type;
+
+template <typename FT>
+constexpr i32 BiasedExponent(Uint<FT> a) {
+  return static_cast<i32>((a >> NumSignificandBits<FT>()) & ((1u << NumExponentBits<FT>()) - 1));
+}
+
+// Unbiased exponent and fraction (without the leading one) of a finite nonzero value. Subnormals are normalized.
+template <typename FT>
+constexpr void Decompose(FT a, i32& exp, u64& frac) {
+  constexpr i32 kSigBits = NumSignificandBits<FT>();
+  const Uint<FT> ua = std::bit_cast<Uint<FT>>(a);
+  const i32 biased = BiasedExponent<FT>(ua);
+  frac = ua & ((1ull << kSigBits) - 1);
+  if (biased == 0) {
+    const i32 shift = std::countl_zero(frac) - (64 - kSigBits) + 1;
+    frac = (frac << shift) & ((1ull << kSigBits) - 1);
+    exp = 1 - Bias<FT>() - shift;
+  } else {
+    exp = biased - Bias<FT>();
+  }
+}
+
+template <typename FT>
+constexpr FT Pack(Uint<FT> sign, i32 biased_exp, u64 frac) {
+  return std::bit_cast<FT>(
+      static_cast<Uint<FT>>(sign | (static_cast<Uint<FT>>(biased_exp) << NumSignificandBits<FT>()) | frac));
+}
+
+// 2^k for k between the exponent of the smallest subnormal and the largest exponent.
+template <typename FT>
+constexpr FT Pow2(i32 k) {
+  constexpr i32 kSigBits = NumSignificandBits<FT>();
+  constexpr i32 kMinExp = 1 - Bias<FT>();
+  if (k >= kMinExp)
+    return Pack<FT>(0, k + Bias<FT>(), 0);
+  return Pack<FT>(0, 0, 1ull << (k - kMinExp + kSigBits));
+}
+
+constexpr Vfpu::RoundingMode kRoundingModes[4] = {Vfpu::kRoundTiesToEven, Vfpu::kRoundTowardNegative,
+                                                   Vfpu::kRoundTowardPositive, Vfpu::kRoundTowardZero};
+
+}  // namespace
+
+Avx512::Avx512() : FloppyFloat() {}
+
+template <typename FT>
+FT Avx512::QnanIndefinite() {
+  if constexpr (std::is_same_v<FT, f16>)
+    return qnan16_;
+  else if constexpr (std::is_same_v<FT, f32>)
+    return qnan32_;
+  else
+    return qnan64_;
+}
+
+template <typename FT>
+FT Avx512::QuietNan(FT a) {
+  if (IsSnan(a))
+    invalid = true;
+  return SetQuietBit(a);
+}
+
+template <typename FT, bool quiet>
+FT Avx512::GetExp(FT a) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  FlushInputs(a);
+  if (IsNan(a)) [[unlikely]]
+    return QuietNan(a);
+  if (IsZero(a))
+    return -std::numeric_limits<FT>::infinity();
+  if (IsInf(a))
+    return std::numeric_limits<FT>::infinity();
+
+  i32 exp;
+  u64 frac;
+  Decompose(a, exp, frac);
+  return static_cast<FT>(exp);  // Exact.
+}
+
+template f16 Avx512::GetExp<f16>(f16 a);
+template f32 Avx512::GetExp<f32>(f32 a);
+template f64 Avx512::GetExp<f64>(f64 a);
+template f16 Avx512::GetExp<f16, true>(f16 a);
+template f32 Avx512::GetExp<f32, true>(f32 a);
+template f64 Avx512::GetExp<f64, true>(f64 a);
+
+template <typename FT, bool quiet>
+FT Avx512::GetMant(FT a, u8 imm8) {
+  using UT = Uint<FT>;
+  constexpr i32 kSigBits = NumSignificandBits<FT>();
+  constexpr i32 kBias = Bias<FT>();
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  FlushInputs(a);
+  const UT ua = std::bit_cast<UT>(a);
+  if (IsNan(a)) [[unlikely]]
+    return QuietNan(a);
+  if ((imm8 & 0x8) && (ua & SignMask<FT>())) {  // Includes -0.
+    invalid = true;
+    return QnanIndefinite<FT>();
+  }
+
+  const UT sign = (imm8 & 0x4) ? 0 : (ua & SignMask<FT>());
+  if (IsZero(a) || IsInf(a))
+    return Pack<FT>(sign, kBias, 0);
+
+  i32 exp;
+  u64 frac;
+  Decompose(a, exp, frac);
+  i32 out_exp = kBias;
+  switch (imm8 & 0x3) {
+  case 1:  // [1/2, 2): Odd exponents yield [1/2, 1).
+    out_exp -= exp & 1;
+    break;
+  case 2:  // [1/2, 1)
+    out_exp -= 1;
+    break;
+  case 3:  // [3/4, 3/2): Significands of 1.5 and above are halved.
+    out_exp -= static_cast<i32>(frac >> (kSigBits - 1));
+    break;
+  default:  // [1, 2)
+    break;
+  }
+  return Pack<FT>(sign, out_exp, frac);
+}
+
+template f16 Avx512::GetMant<f16>(f16 a, u8 imm8);
+template f32 Avx512::GetMant<f32>(f32 a, u8 imm8);
+template f64 Avx512::GetMant<f64>(f64 a, u8 imm8);
+template f16 Avx512::GetMant<f16, true>(f16 a, u8 imm8);
+template f32 Avx512::GetMant<f32, true>(f32 a, u8 imm8);
+template f64 Avx512::GetMant<f64, true>(f64 a, u8 imm8);
+
+// a * 2^n for a finite nonzero a. Results in the normal range are exact. Otherwise a is first scaled exactly to the
+// largest or smallest normal exponent, so that the final multiplication rounds once and raises the right flags. The
+// factor 2^n of tiny results may be subnormal, which must neither be flushed nor raise DE.
+template <typename FT, Avx512::RoundingMode rm>
+FT Avx512::ScaleFinite(FT a, i32 n) {
+  constexpr i32 kSigBits = NumSignificandBits<FT>();
+  constexpr i32 kMinExp = 1 - Bias<FT>();
+  constexpr i32 kMaxExp = Bias<FT>();
+  i32 exp;
+  u64 frac;
+  Decompose(a, exp, frac);
+  const f64 significand = std::ldexp(static_cast<f64>(a), -exp);  // In [1, 2).
+  const i32 target = exp + n;
+  if (target > kMaxExp) {
+    return Mul<FT, rm>(static_cast<FT>(std::ldexp(significand, kMaxExp)),
+                       Pow2<FT>(std::min(target - kMaxExp, kMaxExp)));
+  } else if (target >= kMinExp) [[likely]] {
+    return static_cast<FT>(std::ldexp(significand, target));
+  } else {
+    const FT factor = Pow2<FT>(std::max(target - kMinExp, kMinExp - kSigBits));
+    return FlushDenormals<FT>([this, factor](FT x) { return Mul<FT, rm>(x, factor); }, [](FT) { return false; },
+                              static_cast<FT>(std::ldexp(significand, kMinExp)));
+  }
+}
+
+template <typename FT, Avx512::RoundingMode rm, bool quiet>
+FT Avx512::ScaleF(FT a, FT b) {
+  constexpr FT kInf = std::numeric_limits<FT>::infinity();
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  FlushInputs(a, b);
+  if (IsNan(a) || IsNan(b)) [[unlikely]] {
+    if (IsSnan(a) || IsSnan(b))
+      invalid = true;
+    if (!IsNan(a))
+      return SetQuietBit(b);
+    if (!IsSnan(a) && IsInf(b))  // A quiet NaN scaled by +inf is +inf, by -inf +0.
+      return b > 0 ? kInf : static_cast<FT>(0.f);
+    return SetQuietBit(a);
+  }
+
+  if (IsInf(b)) [[unlikely]] {
+    if ((b > 0 && IsZero(a)) || (b < 0 && IsInf(a))) {
+      invalid = true;
+      return QnanIndefinite<FT>();
+    }
+    if (b > 0)
+      return std::signbit(a) ? -kInf : kInf;
+    return std::signbit(a) ? static_cast<FT>(-0.f) : static_cast<FT>(0.f);
+  }
+
+  if (IsZero(a) || IsInf(a))
+    return a;
+  const f64 floor_b = std::clamp(std::floor(static_cast<f64>(b)), -65536., 65536.);  // Beyond saturates anyway.
+  return ScaleFinite<FT, rm>(a, static_cast<i32>(floor_b));
+}
+
+template f16 Avx512::ScaleF<f16, Avx512::kRoundTiesToEven>(f16 a, f16 b);
+template f16 Avx512::ScaleF<f16, Avx512::kRoundTowardPositive>(f16 a, f16 b);
+template f16 Avx512::ScaleF<f16, Avx512::kRoundTowardNegative>(f16 a, f16 b);
+template f16 Avx512::ScaleF<f16, Avx512::kRoundTowardZero>(f16 a, f16 b);
+template f16 Avx512::ScaleF<f16, Avx512::kRoundTiesToAway>(f16 a, f16 b);
+
+template f32 Avx512::ScaleF<f32, Avx512::kRoundTiesToEven>(f32 a, f32 b);
+template f32 Avx512::ScaleF<f32, Avx512::kRoundTowardPositive>(f32 a, f32 b);
+template f32 Avx512::ScaleF<f32, Avx512::kRoundTowardNegative>(f32 a, f32 b);
+template f32 Avx512::ScaleF<f32, Avx512::kRoundTowardZero>(f32 a, f32 b);
+template f32 Avx512::ScaleF<f32, Avx512::kRoundTiesToAway>(f32 a, f32 b);
+
+template f64 Avx512::ScaleF<f64, Avx512::kRoundTiesToEven>(f64 a, f64 b);
+template f64 Avx512::ScaleF<f64, Avx512::kRoundTowardPositive>(f64 a, f64 b);
+template f64 Avx512::ScaleF<f64, Avx512::kRoundTowardNegative>(f64 a, f64 b);
+template f64 Avx512::ScaleF<f64, Avx512::kRoundTowardZero>(f64 a, f64 b);
+template f64 Avx512::ScaleF<f64, Avx512::kRoundTiesToAway>(f64 a, f64 b);
+
+template f16 Avx512::ScaleF<f16, Avx512::kRoundTiesToEven, true>(f16 a, f16 b);
+template f16 Avx512::ScaleF<f16, Avx512::kRoundTowardPositive, true>(f16 a, f16 b);
+template f16 Avx512::ScaleF<f16, Avx512::kRoundTowardNegative, true>(f16 a, f16 b);
+template f16 Avx512::ScaleF<f16, Avx512::kRoundTowardZero, true>(f16 a, f16 b);
+template f16 Avx512::ScaleF<f16, Avx512::kRoundTiesToAway, true>(f16 a, f16 b);
+
+template f32 Avx512::ScaleF<f32, Avx512::kRoundTiesToEven, true>(f32 a, f32 b);
+template f32 Avx512::ScaleF<f32, Avx512::kRoundTowardPositive, true>(f32 a, f32 b);
+template f32 Avx512::ScaleF<f32, Avx512::kRoundTowardNegative, true>(f32 a, f32 b);
+template f32 Avx512::ScaleF<f32, Avx512::kRoundTowardZero, true>(f32 a, f32 b);
+template f32 Avx512::ScaleF<f32, Avx512::kRoundTiesToAway, true>(f32 a, f32 b);
+
+template f64 Avx512::ScaleF<f64, Avx512::kRoundTiesToEven, true>(f64 a, f64 b);
+template f64 Avx512::ScaleF<f64, Avx512::kRoundTowardPositive, true>(f64 a, f64 b);
+template f64 Avx512::ScaleF<f64, Avx512::kRoundTowardNegative, true>(f64 a, f64 b);
+template f64 Avx512::ScaleF<f64, Avx512::kRoundTowardZero, true>(f64 a, f64 b);
+template f64 Avx512::ScaleF<f64, Avx512::kRoundTiesToAway, true>(f64 a, f64 b);
+
+template <typename FT>
+FT Avx512::ScaleF(FT a, FT b) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return ScaleF<FT, kRoundTiesToEven>(a, b);
+  case kRoundTiesToAway:
+    return ScaleF<FT, kRoundTiesToAway>(a, b);
+  case kRoundTowardPositive:
+    return ScaleF<FT, kRoundTowardPositive>(a, b);
+  case kRoundTowardNegative:
+    return ScaleF<FT, kRoundTowardNegative>(a, b);
+  case kRoundTowardZero:
+    return ScaleF<FT, kRoundTowardZero>(a, b);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template f16 Avx512::ScaleF<f16>(f16 a, f16 b);
+template f32 Avx512::ScaleF<f32>(f32 a, f32 b);
+template f64 Avx512::ScaleF<f64>(f64 a, f64 b);
+
+template <typename FT, bool quiet>
+FT Avx512::RndScale(FT a, u8 imm8) {
+  constexpr i32 kSigBits = NumSignificandBits<FT>();
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  FlushInputs<false>(a);
+  const i32 m = imm8 >> 4;
+  if (m == 0 || IsNan(a) || IsInf(a) || IsZero(a))
+    return Roundx86(a, imm8 & 0xf);
+
+  i32 exp;
+  u64 frac;
+  Decompose(a, exp, frac);
+  if (exp >= kSigBits - m)  // Already a multiple of 2^-m.
+    return a;
+  const FT rounded = Roundx86(static_cast<FT>(a * Pow2<FT>(m)), imm8 & 0xf);  // Scaling is exact in both directions.
+  return static_cast<FT>(rounded * Pow2<FT>(-m));
+}
+
+template f16 Avx512::RndScale<f16>(f16 a, u8 imm8);
+template f32 Avx512::RndScale<f32>(f32 a, u8 imm8);
+template f64 Avx512::RndScale<f64>(f64 a, u8 imm8);
+template f16 Avx512::RndScale<f16, true>(f16 a, u8 imm8);
+template f32 Avx512::RndScale<f32, true>(f32 a, u8 imm8);
+template f64 Avx512::RndScale<f64, true>(f64 a, u8 imm8);
+
+template <typename FT, bool quiet>
+FT Avx512::Reduce(FT a, u8 imm8) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  FlushInputs<false>(a);
+  if (IsNan(a)) [[unlikely]]
+    return QuietNan(a);
+  if (IsInf(a)) [[unlikely]]
+    return static_cast<FT>(0.f);
+
+  const bool was_inexact = inexact;
+  const FT rounded = RndScale(a, imm8);
+  // Only inexact if |a| < 2^-m and the rounding went away from zero. The static variants of Sub neither flush nor
+  // raise DE, like VREDUCE.
+  FT result;
+  switch ((imm8 & 0x4) ? rounding_mode : kRoundingModes[imm8 & 0x3]) {
+  case kRoundTiesToEven:
+    result = Sub<FT, kRoundTiesToEven>(a, rounded);
+    break;
+  case kRoundTiesToAway:
+    result = Sub<FT, kRoundTiesToAway>(a, rounded);
+    break;
+  case kRoundTowardPositive:
+    result = Sub<FT, kRoundTowardPositive>(a, rounded);
+    break;
+  case kRoundTowardNegative:
+    result = Sub<FT, kRoundTowardNegative>(a, rounded);
+    break;
+  case kRoundTowardZero:
+    result = Sub<FT, kRoundTowardZero>(a, rounded);
+    break;
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+  if (imm8 & 0x8)
+    inexact = was_inexact;
+  return result;
+}
+
+template f16 Avx512::Reduce<f16>(f16 a, u8 imm8);
+template f32 Avx512::Reduce<f32>(f32 a, u8 imm8);
+template f64 Avx512::Reduce<f64>(f64 a, u8 imm8);
+template f16 Avx512::Reduce<f16, true>(f16 a, u8 imm8);
+template f32 Avx512::Reduce<f32, true>(f32 a, u8 imm8);
+template f64 Avx512::Reduce<f64, true>(f64 a, u8 imm8);
+
+template <typename FT, bool quiet>
+FT Avx512::Range(FT a, FT b, u8 imm8) {
+  using UT = Uint<FT>;
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  FlushInputs(a, b);
+  if (IsSnan(a)) [[unlikely]]
+    return QuietNan(a);
+  if (IsSnan(b)) [[unlikely]]
+    return QuietNan(b);
+
+  const UT ua = std::bit_cast<UT>(a);
+  const UT ub = std::bit_cast<UT>(b);
+  const UT abs_a = ua & ~SignMask<FT>();
+  const UT abs_b = ub & ~SignMask<FT>();
+  UT selected;
+  if (IsNan(b)) {
+    selected = ua;
+  } else if (IsNan(a)) {
+    selected = ub;
+  } else if (abs_a == abs_b && ((ua ^ ub) & SignMask<FT>())) {
+    // Opposite signs and the same magnitude (including zeros): Minima select the negative, maxima the positive value.
+    const bool select_negative = !(imm8 & 0x1);
+    selected = (static_cast<bool>(ua & SignMask<FT>()) == select_negative) ? ua : ub;
+  } else {
+    switch (imm8 & 0x3) {
+    case 0:
+      selected = a <= b ? ua : ub;
+      break;
+    case 1:
+      selected = a <= b ? ub : ua;
+      break;
+    case 2:
+      selected = abs_a <= abs_b ? ua : ub;
+      break;
+    default:
+      selected = abs_a <= abs_b ? ub : ua;
+      break;
+    }
+  }
+
+  switch ((imm8 >> 2) & 0x3) {
+  case 0:
+    return std::bit_cast<FT>(static_cast<UT>((selected & ~SignMask<FT>()) | (ua & SignMask<FT>())));
+  case 1:
+    return std::bit_cast<FT>(selected);
+  case 2:
+    return std::bit_cast<FT>(static_cast<UT>(selected & ~SignMask<FT>()));
+  default:
+    return std::bit_cast<FT>(static_cast<UT>(selected | SignMask<FT>()));
+  }
+}
+
+template f32 Avx512::Range<f32>(f32 a, f32 b, u8 imm8);
+template f64 Avx512::Range<f64>(f64 a, f64 b, u8 imm8);
+template f32 Avx512::Range<f32, true>(f32 a, f32 b, u8 imm8);
+template f64 Avx512::Range<f64, true>(f64 a, f64 b, u8 imm8);
+
+template <typename FT, bool quiet>
+FT Avx512::FixupImm(FT dst, FT a, typename FloatToUint<FT>::type table, u8 imm8) {
+  constexpr FT kInf = std::numeric_limits<FT>::infinity();
+  constexpr FT kMax = std::numeric_limits<FT>::max();
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  FlushInputs<false>(a);  // Subnormals are classified as zeros with DAZ.
+  const bool negative = std::signbit(a);
+
+  enum Token { kQnan, kSnan, kZero, kPosOne, kNegInf, kPosInf, kNegValue, kPosValue };
+  Token token;
+  if (IsNan(a))
+    token = IsSnan(a) ? kSnan : kQnan;
+  else if (IsZero(a))
+    token = kZero;
+  else if (a == static_cast<FT>(1.f))
+    token = kPosOne;
+  else if (IsInf(a))
+    token = negative ? kNegInf : kPosInf;
+  else
+    token = negative ? kNegValue : kPosValue;
+
+  switch (token) {
+  case kZero:
+    division_by_zero |= static_cast<bool>(imm8 & 0x01);
+    invalid |= static_cast<bool>(imm8 & 0x02);
+    break;
+  case kPosOne:
+    division_by_zero |= static_cast<bool>(imm8 & 0x04);
+    invalid |= static_cast<bool>(imm8 & 0x08);
+    break;
+  case kSnan:
+    invalid |= static_cast<bool>(imm8 & 0x10);
+    break;
+  case kNegInf:
+    invalid |= static_cast<bool>(imm8 & 0x20);
+    break;
+  case kNegValue:
+    invalid |= static_cast<bool>(imm8 & 0x40);
+    break;
+  case kPosInf:
+    invalid |= static_cast<bool>(imm8 & 0x80);
+    break;
+  default:
+    break;
+  }
+
+  switch ((static_cast<u32>(table) >> (4 * token)) & 0xf) {
+  case 0x0:
+    return dst;
+  case 0x1:
+    return a;
+  case 0x2:
+    return IsNan(a) ? SetQuietBit(a) : QnanIndefinite<FT>();
+  case 0x3:
+    return QnanIndefinite<FT>();
+  case 0x4:
+    return -kInf;
+  case 0x5:
+    return kInf;
+  case 0x6:
+    return negative ? -kInf : kInf;
+  case 0x7:
+    return static_cast<FT>(-0.f);
+  case 0x8:
+    return static_cast<FT>(0.f);
+  case 0x9:
+    return static_cast<FT>(-1.f);
+  case 0xa:
+    return static_cast<FT>(1.f);
+  case 0xb:
+    return static_cast<FT>(0.5f);
+  case 0xc:
+    return static_cast<FT>(90.f);
+  case 0xd:
+    return static_cast<FT>(1.5707963267948966);  // pi/2
+  case 0xe:
+    return kMax;
+  default:
+    return -kMax;
+  }
+}
+
+template f32 Avx512::FixupImm<f32>(f32 dst, f32 a, u32 table, u8 imm8);
+template f64 Avx512::FixupImm<f64>(f64 dst, f64 a, u64 table, u8 imm8);
+template f32 Avx512::FixupImm<f32, true>(f32 dst, f32 a, u32 table, u8 imm8);
+template f64 Avx512::FixupImm<f64, true>(f64 dst, f64 a, u64 table, u8 imm8);
+
+template <typename FT, Avx512::Operation op>
+void Avx512::Batch(FT* dst, const FT* a, const FT* b, u8 imm8, std::size_t n) {
+  using UT = Uint<FT>;
+  constexpr i32 kSigBits = NumSignificandBits<FT>();
+  constexpr i32 kBias = Bias<FT>();
+  constexpr i32 kMaxBiasedExp = (1 << NumExponentBits<FT>()) - 2;
+  constexpr std::size_t kBlockSize = 64;
+
+  if constexpr (op == kGetExp || op == kGetMant) {
+    // Branchless kernels for normal operands, see GetExp and GetMant.
+    const UT sign_mask = (imm8 & 0x4) ? 0 : SignMask<FT>();
+    const UT reject_negative = (imm8 & 0x8) ? SignMask<FT>() : 0;
+    const i32 parity_mask = (imm8 & 0x3) == 1 ? 1 : 0;
+    const i32 msb_mask = (imm8 & 0x3) == 3 ? 1 : 0;
+    const i32 base_exp = kBias - ((imm8 & 0x3) == 2 ? 1 : 0);
+    for (std::size_t i = 0; i < n; i += kBlockSize) {
+      const std::size_t block_size = std::min(kBlockSize, n - i);
+      UT ua[kBlockSize];
+      FT result[kBlockSize];
+      std::memcpy(ua, a + i, block_size * sizeof(FT));
+      bool normal = true;
+      for (std::size_t j = 0; j < block_size; ++j) {
+        const i32 biased = BiasedExponent<FT>(ua[j]);
+        normal &= biased >= 1 && biased <= kMaxBiasedExp && !(ua[j] & reject_negative);
+        if constexpr (op == kGetExp) {
+          result[j] = static_cast<FT>(biased - kBias);
+        } else {
+          const u64 frac = ua[j] & ((1ull << kSigBits) - 1);
+          const i32 out_exp = base_exp - (((biased - kBias) & parity_mask) +
+                                          (static_cast<i32>(frac >> (kSigBits - 1)) & msb_mask));
+          result[j] = Pack<FT>(ua[j] & sign_mask, out_exp, frac);
+        }
+      }
+
+      if (normal) [[likely]] {
+        std::memcpy(dst + i, result, block_size * sizeof(FT));
+        continue;
+      }
+
+      for (std::size_t j = 0; j < block_size; ++j) {
+        const FT value = std::bit_cast<FT>(ua[j]);
+        if constexpr (op == kGetExp)
+          dst[i + j] = GetExp(value);
+        else
+          dst[i + j] = GetMant(value, imm8);
+      }
+    }
+  } else {
+    for (std::size_t i = 0; i < n; ++i) {
+      if constexpr (op == kScaleF)
+        dst[i] = ScaleF(a[i], b[i]);
+      else if constexpr (op == kRndScale)
+        dst[i] = RndScale(a[i], imm8);
+      else if constexpr (op == kReduce)
+        dst[i] = Reduce(a[i], imm8);
+      else
+        dst[i] = Range(a[i], b[i], imm8);
+    }
+  }
+}
+
+template <typename FT>
+void Avx512::Batch(Operation op, FT* dst, const FT* a, const FT* b, u8 imm8, std::size_t n) {
+  switch (op) {
+  case kGetExp:
+    return Batch<FT, kGetExp>(dst, a, b, imm8, n);
+  case kGetMant:
+    return Batch<FT, kGetMant>(dst, a, b, imm8, n);
+  case kScaleF:
+    return Batch<FT, kScaleF>(dst, a, b, imm8, n);
+  case kRndScale:
+    return Batch<FT, kRndScale>(dst, a, b, imm8, n);
+  case kReduce:
+    return Batch<FT, kReduce>(dst, a, b, imm8, n);
+  case kRange:
+    if constexpr (std::is_same_v<FT, f16>)
+      throw std::runtime_error(std::string("AVX512-FP16 has no VRANGE"));
+    else
+      return Batch<FT, kRange>(dst, a, b, imm8, n);
+  default:
+    throw std::runtime_error(std::string("Unknown AVX-512 operation"));
+  }
+}
+
+template void Avx512::Batch<f16>(Operation op, f16* dst, const f16* a, const f16* b, u8 imm8, std::size_t n);
+template void Avx512::Batch<f32>(Operation op, f32* dst, const f32* a, const f32* b, u8 imm8, std::size_t n);
+template void Avx512::Batch<f64>(Operation op, f64* dst, const f64* a, const f64* b, u8 imm8, std::size_t n);
+
+template <typename FT>
+void Avx512::FixupImmBatch(FT* dst, const FT* a, const typename FloatToUint<FT>::type* table, u8 imm8,
+                           std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i)
+    dst[i] = FixupImm(dst[i], a[i], table[i], imm8);
+}
+
+template void Avx512::FixupImmBatch<f32>(f32* dst, const f32* a, const u32* table, u8 imm8, std::size_t n);
+template void Avx512::FixupImmBatch<f64>(f64* dst, const f64* a, const u64* table, u8 imm8, std::size_t n);
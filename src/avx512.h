@@ -0,0 +1,77 @@
+#pragma once
+/**************************************************************************************************
+ * Apache License, Version 2.0
+ * Copyright (c) 2024 chciken/Niko Zurstraßen
+ **************************************************************************************************/
+
+#include <cstddef>
+
+#include "floppy_float.h"
+#include "utils.h"
+
+// Simulates the AVX-512 floating-point manipulation instructions for f32 and f64, and for f16 where AVX512-FP16
+// provides them (all but VRANGE and VFIXUPIMM). NaN results follow the configuration, so SetupToX86() is expected.
+// Subnormal operands are treated as zero with Vfpu::flush_inputs (MXCSR.DAZ). Otherwise, GetExp, GetMant, ScaleF and
+// Range raise input_denormal (DE) for them, whereas RndScale, Reduce and FixupImm don't report DE. With quiet set, the
+// operations leave all flags untouched (AVX-512 {sae}).
+class Avx512 : public FloppyFloat {
+ public:
+  Avx512();
+
+  enum Operation { kGetExp, kGetMant, kScaleF, kRndScale, kReduce, kRange };
+
+  // See "vgetexp": floor(log2(|a|)) as a floating-point number. Zeros yield -inf, infinities +inf.
+  template <typename FT, bool quiet = false>
+  FT GetExp(FT a);
+
+  // See "vgetmant": The significand normalized to the interval imm8[1:0] ([1, 2), [1/2, 2), [1/2, 1), [3/4, 3/2))
+  // with the sign control imm8[3:2] (sign of a, positive, or invalid for negative operands).
+  template <typename FT, bool quiet = false>
+  FT GetMant(FT a, FfUtils::u8 imm8);
+
+  // See "vscalef": a * 2^floor(b) with a single rounding in rm (AVX-512 {er}, which implies {sae} with quiet set) or in
+  // the dynamic rounding mode. Tiny results are replaced with zero with Vfpu::flush_outputs (MXCSR.FTZ).
+  template <typename FT, RoundingMode rm, bool quiet = false>
+  FT ScaleF(FT a, FT b);
+  template <typename FT>
+  FT ScaleF(FT a, FT b);
+
+  // See "vrndscale": Rounds to imm8[7:4] fraction bits, otherwise like Roundx86.
+  template <typename FT, bool quiet = false>
+  FT RndScale(FT a, FfUtils::u8 imm8);
+
+  // See "vreduce": a - RndScale(a, imm8), subtracted with the rounding control of imm8.
+  template <typename FT, bool quiet = false>
+  FT Reduce(FT a, FfUtils::u8 imm8);
+
+  // See "vrange": Minimum, maximum, minimum magnitude, or maximum magnitude selected by imm8[1:0], and the sign
+  // control imm8[3:2] (sign of a, sign of the selected value, positive, or negative).
+  template <typename FT, bool quiet = false>
+  FT Range(FT a, FT b, FfUtils::u8 imm8);
+
+  // See "vfixupimm": Classifies a into one of eight tokens, which selects a 4-bit response from the low 32 bits of
+  // table (keep dst, pass a through, or one of several constants). imm8 selects the tokens that raise invalid or
+  // division by zero.
+  template <typename FT, bool quiet = false>
+  FT FixupImm(FT dst, FT a, typename FfUtils::FloatToUint<FT>::type table, FfUtils::u8 imm8);
+
+  // Packed forms that apply an operation to whole arrays. b is only read by binary operations and may be nullptr
+  // otherwise. They loop over the elements with the scalar operations, except for blocks of normal operands of GetExp
+  // and GetMant, which are computed by branchless kernels.
+  template <typename FT>
+  void Batch(Operation op, FT* dst, const FT* a, const FT* b, FfUtils::u8 imm8, std::size_t n);
+  template <typename FT>
+  void FixupImmBatch(FT* dst, const FT* a, const typename FfUtils::FloatToUint<FT>::type* table, FfUtils::u8 imm8,
+                     std::size_t n);
+
+ protected:
+  template <typename FT>
+  FT QnanIndefinite();
+  template <typename FT>
+  FT QuietNan(FT a);
+  template <typename FT, RoundingMode rm>
+  FT ScaleFinite(FT a, FfUtils::i32 n);
+
+  template <typename FT, Operation op>
+  void Batch(FT* dst, const FT* a, const FT* b, FfUtils::u8 imm8, std::size_t n);
+};
@@ -0,0 +1,325 @@
+/**************************************************************************************************
+ * Apache License, Version 2.0
+ * Copyright (c) 2024 chciken/Niko Zurstraßen
+ **************************************************************************************************/
+
+#include "complex_float.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+using namespace FfUtils;
+
+namespace {
+
+// Residual c - (a + b) of the f64 sum c = a + b (2Sum).
+constexpr f64 TwoSum(f64 a, f64 b, f64 c) {
+  const f64 ad = c - b;
+  const f64 bd = c - ad;
+  return (ad - a) + (bd - b);
+}
+
+// Turns the f64 sum c with residual c - exact into its round-to-odd counterpart (see RoundToOdd of FloppyFloat). An
+// even c moves one step towards the exact value. Branchless, so that the kernel loop vectorizes.
+constexpr f64 RoundToOdd(f64 c, f64 residual) {
+  const u64 uc = std::bit_cast<u64>(c);
+  const u64 step = 1ull - 2ull * (((std::bit_cast<u64>(residual) ^ uc) >> 63) ^ 1ull);  // -1 if the signs match.
+  return std::bit_cast<f64>(uc + (residual != 0. ? step * ((uc & 1ull) ^ 1ull) : 0ull));
+}
+
+// Hosts without f16 arithmetic convert f16 by calls into the runtime library, so the kernel converts f16 with integer
+// operations. Infinities and NaNs widen to finite values, which is fine as their lanes are not regular.
+template <typename FT>
+constexpr f64 Widen(FT a) {
+  if constexpr (std::is_same_v<FT, f16>) {
+    const u16 ua = std::bit_cast<u16>(a);
+    const u64 exponent = (ua >> 10) & 0x1fu;
+    const u64 normal = (0ull - exponent) >> 63;
+    const u64 mantissa = (ua & 0x3ffu) | (normal << 10);
+    const f64 scale = std::bit_cast<f64>((exponent + (normal ^ 1ull) + 1023 - 25) << 52);
+    const f64 magnitude = static_cast<f64>(static_cast<i32>(mantissa)) * scale;  // SSE2 only converts i32 to f64.
+    return std::bit_cast<f64>(std::bit_cast<u64>(magnitude) | (static_cast<u64>(ua & 0x8000u) << 48));
+  } else {
+    return static_cast<f64>(a);
+  }
+}
+
+template <typename FT>
+constexpr bool IsFinite(FT a) {
+  if constexpr (std::is_same_v<FT, f16>)
+    return (std::bit_cast<u16>(a) & 0x7c00u) != 0x7c00u;
+  else
+    return !IsInfOrNan(a);
+}
+
+template <typename FT>
+constexpr bool IsDenormal(FT a) {
+  using UT = FloatToUint<FT>::type;
+  return static_cast<UT>((std::bit_cast<UT>(a) & ~SignMask<FT>()) - 1u) < MaxSignificand<FT>();
+}
+
+// The kernel computes f16 and f32 operations in f64, where products are exact and sums are rounded to odd. The
+// conversion to FT then rounds to nearest even as if from the exact value. A result is regular if it neither
+// overflows nor may be tiny; exact zeros are regular. The flags are integers, as compilers do not vectorize
+// reductions of bools.
+template <typename FT>
+constexpr FT RoundNearest(f64 odd, u32& inexact, u32& regular) {
+  if constexpr (std::is_same_v<FT, f16>) {
+    // Rebiasing the exponent turns the upper bits into the f16 encoding; the lower 42 bits are rounded off. Tiny and
+    // overflowing values give garbage, but are not regular. Comparisons are in f64 and u32, as SSE2 has no u64 ones.
+    const u64 uo = std::bit_cast<u64>(odd);
+    const u64 rebiased = (uo & ~SignMask<f64>()) - (static_cast<u64>(1023 - 15) << 52);
+    const u64 rounded = (rebiased + (1ull << 41) - 1ull + ((rebiased >> 42) & 1ull)) >> 42;
+    const u32 dropped = static_cast<u32>(rebiased) | (static_cast<u32>(rebiased >> 32) & 0x3ffu);
+    inexact |= dropped != 0u;
+    const f64 magnitude = std::abs(odd);
+    regular &= (odd == 0.) | ((magnitude > 0x1p-14) & (magnitude < 0x1.ffcp15));  // Below 65520 stays finite.
+    const u64 sign = (uo >> 48) & 0x8000u;
+    return std::bit_cast<f16>(static_cast<u16>(sign | (odd == 0. ? 0ull : rounded)));
+  } else {
+    const FT result = static_cast<FT>(odd);
+    inexact |= static_cast<f64>(result) != odd;
+    regular &= (odd == 0.) | ((std::abs(odd) > static_cast<f64>(nl<FT>::min())) & !IsInf(result));
+    return result;
+  }
+}
+
+template <typename FT>
+constexpr FT MulKernel(f64 a, f64 b, u32& inexact, u32& regular) {
+  return RoundNearest<FT>(a * b, inexact, regular);
+}
+
+template <typename FT>
+constexpr FT AddKernel(f64 a, f64 b, u32& inexact, u32& regular) {
+  const f64 c = a + b;
+  return RoundNearest<FT>(RoundToOdd(c, TwoSum(a, b, c)), inexact, regular);
+}
+
+template <typename FT>
+constexpr FT FmaKernel(f64 a, f64 b, f64 c, u32& inexact, u32& regular) {
+  const f64 p = a * b;
+  const f64 d = p + c;
+  return RoundNearest<FT>(RoundToOdd(d, TwoSum(p, c, d)), inexact, regular);
+}
+
+template <typename FT, ComplexFloat::Operation op>
+constexpr void Kernel(FT* result, const FT* acc, const FT* a, const FT* b, u32 denormals, u32& inexact,
+                      u32& regular) {
+  using Op = ComplexFloat;
+  constexpr bool kReadsAcc = op != Op::kCadd90Arm && op != Op::kCadd270Arm && op != Op::kMulcX86 &&
+                             op != Op::kConjMulcX86;
+  regular = IsFinite(a[0]) & IsFinite(a[1]) & IsFinite(b[0]) & IsFinite(b[1]);
+  if constexpr (kReadsAcc)
+    regular &= IsFinite(acc[0]) & IsFinite(acc[1]);
+  // Subnormal operands are not regular if they are flushed or raise the denormal flag (see ChecksDenormals).
+  u32 denormal = IsDenormal(a[0]) | IsDenormal(a[1]) | IsDenormal(b[0]) | IsDenormal(b[1]);
+  if constexpr (kReadsAcc)
+    denormal |= IsDenormal(acc[0]) | IsDenormal(acc[1]);
+  regular &= (denormal & denormals) ^ 1u;
+  const f64 ar = Widen(a[0]), ai = Widen(a[1]), br = Widen(b[0]), bi = Widen(b[1]);
+  const f64 dr = kReadsAcc ? Widen(acc[0]) : 0., di = kReadsAcc ? Widen(acc[1]) : 0.;
+  if constexpr (op == Op::kCmla0Arm) {
+    result[0] = FmaKernel<FT>(ar, br, dr, inexact, regular);
+    result[1] = FmaKernel<FT>(ar, bi, di, inexact, regular);
+  } else if constexpr (op == Op::kCmla90Arm) {
+    result[0] = FmaKernel<FT>(ai, -bi, dr, inexact, regular);
+    result[1] = FmaKernel<FT>(ai, br, di, inexact, regular);
+  } else if constexpr (op == Op::kCmla180Arm) {
+    result[0] = FmaKernel<FT>(ar, -br, dr, inexact, regular);
+    result[1] = FmaKernel<FT>(ar, -bi, di, inexact, regular);
+  } else if constexpr (op == Op::kCmla270Arm) {
+    result[0] = FmaKernel<FT>(ai, bi, dr, inexact, regular);
+    result[1] = FmaKernel<FT>(ai, -br, di, inexact, regular);
+  } else if constexpr (op == Op::kCadd90Arm) {
+    result[0] = AddKernel<FT>(ar, -bi, inexact, regular);
+    result[1] = AddKernel<FT>(ai, br, inexact, regular);
+  } else if constexpr (op == Op::kCadd270Arm) {
+    result[0] = AddKernel<FT>(ar, bi, inexact, regular);
+    result[1] = AddKernel<FT>(ai, -br, inexact, regular);
+  } else {
+    constexpr bool kMulc = op == Op::kMulcX86 || op == Op::kConjMulcX86;
+    constexpr bool kConj = op == Op::kConjMaddcX86 || op == Op::kConjMulcX86;
+    const FT tr = kMulc ? MulKernel<FT>(ar, br, inexact, regular) : FmaKernel<FT>(ar, br, dr, inexact, regular);
+    const FT ti = kMulc ? MulKernel<FT>(ai, br, inexact, regular) : FmaKernel<FT>(ai, br, di, inexact, regular);
+    result[0] = FmaKernel<FT>(kConj ? ai : -ai, bi, Widen(tr), inexact, regular);
+    result[1] = FmaKernel<FT>(kConj ? -ar : ar, bi, Widen(ti), inexact, regular);
+  }
+}
+
+}  // namespace
+
+ComplexFloat::ComplexFloat() : FloppyFloat() {}
+
+template <typename FT, ComplexFloat::Operation op, Vfpu::RoundingMode rm>
+void ComplexFloat::Apply(FT* result, const FT* acc, const FT* a, const FT* b) {
+  // The operands are read before anything is written, as result may alias them. Arm negates an element before the
+  // multiplication (FPNeg, which also flips the sign of NaNs). x86 subtracts products without negating NaN operands.
+  const FT ar = a[0], ai = a[1], br = b[0], bi = b[1];
+  FT re, im;
+  if constexpr (op == kCmla0Arm) {
+    re = Fma<FT, rm, false, true>(ar, br, acc[0]);
+    im = Fma<FT, rm, false, true>(ar, bi, acc[1]);
+  } else if constexpr (op == kCmla90Arm) {
+    re = Fma<FT, rm, false, true>(ai, Negate(bi), acc[0]);
+    im = Fma<FT, rm, false, true>(ai, br, acc[1]);
+  } else if constexpr (op == kCmla180Arm) {
+    re = Fma<FT, rm, false, true>(ar, Negate(br), acc[0]);
+    im = Fma<FT, rm, false, true>(ar, Negate(bi), acc[1]);
+  } else if constexpr (op == kCmla270Arm) {
+    re = Fma<FT, rm, false, true>(ai, bi, acc[0]);
+    im = Fma<FT, rm, false, true>(ai, Negate(br), acc[1]);
+  } else if constexpr (op == kCadd90Arm) {
+    re = Add<FT, rm, false, true>(ar, Negate(bi));
+    im = Add<FT, rm, false, true>(ai, br);
+  } else if constexpr (op == kCadd270Arm) {
+    re = Add<FT, rm, false, true>(ar, bi);
+    im = Add<FT, rm, false, true>(ai, Negate(br));
+  } else {
+    constexpr bool kMulc = op == kMulcX86 || op == kConjMulcX86;
+    const FT tr = kMulc ? Mul<FT, rm, false, true>(ar, br) : Fma<FT, rm, false, true>(ar, br, acc[0]);
+    const FT ti = kMulc ? Mul<FT, rm, false, true>(ai, br) : Fma<FT, rm, false, true>(ai, br, acc[1]);
+    if constexpr (op == kConjMaddcX86 || op == kConjMulcX86) {
+      re = Fma<FT, rm, false, true>(ai, bi, tr);
+      im = Fnma<FT, rm, false, true>(ar, bi, ti);
+    } else {
+      re = Fnma<FT, rm, false, true>(ai, bi, tr);
+      im = Fma<FT, rm, false, true>(ar, bi, ti);
+    }
+  }
+  result[0] = re;
+  result[1] = im;
+}
+
+template <typename FT, ComplexFloat::Operation op, Vfpu::RoundingMode rm>
+void ComplexFloat::Batch(FT* dst, const FT* a, const FT* b, std::size_t n) {
+  std::size_t i = 0;
+  if constexpr (rm == kRoundTiesToEven && !std::is_same_v<FT, f64>) {
+    constexpr std::size_t kBlockSize = 64;
+    FT result[2 * kBlockSize];
+    u32 regular[kBlockSize];
+    const u32 denormals = ChecksDenormals<FT>();
+    for (; i + kBlockSize <= n; i += kBlockSize) {
+      u32 block_inexact = 0;
+      for (std::size_t j = 0; j < kBlockSize; ++j) {
+        u32 lane_inexact = 0;
+        Kernel<FT, op>(&result[2 * j], &dst[2 * (i + j)], &a[2 * (i + j)], &b[2 * (i + j)], denormals, lane_inexact,
+                        regular[j]);
+        block_inexact |= lane_inexact & regular[j];
+      }
+      for (std::size_t j = 0; j < kBlockSize; ++j)
+        if (!regular[j]) [[unlikely]]
+          Apply<FT, op, rm>(&result[2 * j], &dst[2 * (i + j)], &a[2 * (i + j)], &b[2 * (i + j)]);
+      std::copy_n(result, 2 * kBlockSize, &dst[2 * i]);
+      inexact |= block_inexact != 0;
+    }
+  }
+  for (; i < n; ++i)
+    Apply<FT, op, rm>(&dst[2 * i], &dst[2 * i], &a[2 * i], &b[2 * i]);
+}
+
+template <typename FT, ComplexFloat::Operation op>
+void ComplexFloat::Batch(FT* dst, const FT* a, const FT* b, std::size_t n) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return Batch<FT, op, kRoundTiesToEven>(dst, a, b, n);
+  case kRoundTiesToAway:
+    return Batch<FT, op, kRoundTiesToAway>(dst, a, b, n);
+  case kRoundTowardPositive:
+    return Batch<FT, op, kRoundTowardPositive>(dst, a, b, n);
+  case kRoundTowardNegative:
+    return Batch<FT, op, kRoundTowardNegative>(dst, a, b, n);
+  case kRoundTowardZero:
+    return Batch<FT, op, kRoundTowardZero>(dst, a, b, n);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <typename FT>
+void ComplexFloat::Batch(Operation op, FT* dst, const FT* a, const FT* b, std::size_t n) {
+  switch (op) {
+  case kCmla0Arm:
+    return Batch<FT, kCmla0Arm>(dst, a, b, n);
+  case kCmla90Arm:
+    return Batch<FT, kCmla90Arm>(dst, a, b, n);
+  case kCmla180Arm:
+    return Batch<FT, kCmla180Arm>(dst, a, b, n);
+  case kCmla270Arm:
+    return Batch<FT, kCmla270Arm>(dst, a, b, n);
+  case kCadd90Arm:
+    return Batch<FT, kCadd90Arm>(dst, a, b, n);
+  case kCadd270Arm:
+    return Batch<FT, kCadd270Arm>(dst, a, b, n);
+  case kMaddcX86:
+    return Batch<FT, kMaddcX86>(dst, a, b, n);
+  case kConjMaddcX86:
+    return Batch<FT, kConjMaddcX86>(dst, a, b, n);
+  case kMulcX86:
+    return Batch<FT, kMulcX86>(dst, a, b, n);
+  case kConjMulcX86:
+    return Batch<FT, kConjMulcX86>(dst, a, b, n);
+  default:
+    throw std::runtime_error(std::string("Unknown complex operation"));
+  }
+}
+
+template void ComplexFloat::Batch<f16>(Operation op, f16* dst, const f16* a, const f16* b, std::size_t n);
+template void ComplexFloat::Batch<f32>(Operation op, f32* dst, const f32* a, const f32* b, std::size_t n);
+template void ComplexFloat::Batch<f64>(Operation op, f64* dst, const f64* a, const f64* b, std::size_t n);
+
+template <typename FT>
+void ComplexFloat::CmlaArm(FT* dst, const FT* a, const FT* b, u32 rotation) {
+  switch (rotation) {
+  case 0:
+    return Batch(kCmla0Arm, dst, a, b, 1);
+  case 90:
+    return Batch(kCmla90Arm, dst, a, b, 1);
+  case 180:
+    return Batch(kCmla180Arm, dst, a, b, 1);
+  case 270:
+    return Batch(kCmla270Arm, dst, a, b, 1);
+  default:
+    throw std::runtime_error(std::string("Unknown rotation"));
+  }
+}
+
+template void ComplexFloat::CmlaArm<f16>(f16* dst, const f16* a, const f16* b, u32 rotation);
+template void ComplexFloat::CmlaArm<f32>(f32* dst, const f32* a, const f32* b, u32 rotation);
+template void ComplexFloat::CmlaArm<f64>(f64* dst, const f64* a, const f64* b, u32 rotation);
+
+template <typename FT>
+void ComplexFloat::CaddArm(FT* dst, const FT* a, const FT* b, u32 rotation) {
+  switch (rotation) {
+  case 90:
+    return Batch(kCadd90Arm, dst, a, b, 1);
+  case 270:
+    return Batch(kCadd270Arm, dst, a, b, 1);
+  default:
+    throw std::runtime_error(std::string("Unknown rotation"));
+  }
+}
+
+template void ComplexFloat::CaddArm<f16>(f16* dst, const f16* a, const f16* b, u32 rotation);
+template void ComplexFloat::CaddArm<f32>(f32* dst, const f32* a, const f32* b, u32 rotation);
+template void ComplexFloat::CaddArm<f64>(f64* dst, const f64* a, const f64* b, u32 rotation);
+
+template <typename FT>
+void ComplexFloat::MaddcX86(FT* dst, const FT* a, const FT* b, bool conjugate) {
+  Batch(conjugate ? kConjMaddcX86 : kMaddcX86, dst, a, b, 1);
+}
+
+template void ComplexFloat::MaddcX86<f16>(f16* dst, const f16* a, const f16* b, bool conjugate);
+template void ComplexFloat::MaddcX86<f32>(f32* dst, const f32* a, const f32* b, bool conjugate);
+template void ComplexFloat::MaddcX86<f64>(f64* dst, const f64* a, const f64* b, bool conjugate);
+
+template <typename FT>
+void ComplexFloat::MulcX86(FT* dst, const FT* a, const FT* b, bool conjugate) {
+  Batch(conjugate ? kConjMulcX86 : kMulcX86, dst, a, b, 1);
+}
+
+template void ComplexFloat::MulcX86<f16>(f16* dst, const f16* a, const f16* b, bool conjugate);
+template void ComplexFloat::MulcX86<f32>(f32* dst, const f32* a, const f32* b, bool conjugate);
+template void ComplexFloat::MulcX86<f64>(f64* dst, const f64* a, const f64* b, bool conjugate);
@@ -0,0 +1,67 @@
+#pragma once
+/**************************************************************************************************
+ * Apache License, Version 2.0
+ * Copyright (c) 2024 chciken/Niko Zurstraßen
+ **************************************************************************************************/
+
+#include <cstddef>
+
+#include "floppy_float.h"
+#include "utils.h"
+
+// Simulates the complex-number instructions for f16, f32, and f64. A complex number is a pair of adjacent elements
+// with the real part first. Each operation reproduces the sequence of roundings of the respective instruction, so
+// that results and flags match bit by bit. NaN results follow the configuration, and subnormals are flushed like by the
+// arithmetic operations (see Vfpu::flush_inputs).
+class ComplexFloat : public FloppyFloat {
+ public:
+  ComplexFloat();
+
+  enum Operation {
+    kCmla0Arm,
+    kCmla90Arm,
+    kCmla180Arm,
+    kCmla270Arm,
+    kCadd90Arm,
+    kCadd270Arm,
+    kMaddcX86,
+    kConjMaddcX86,
+    kMulcX86,
+    kConjMulcX86
+  };
+
+  // See "fcmla": Adds the partial products of a and b selected by the rotation (0, 90, 180, or 270 degrees) to dst
+  // with one fused multiply-add per part. The rotations 0 and 90 together accumulate a * b, 0 and 270 a * conj(b).
+  template <typename FT>
+  void CmlaArm(FT* dst, const FT* a, const FT* b, FfUtils::u32 rotation);
+
+  // See "fcadd": a + i * b (rotation 90) or a - i * b (rotation 270) with one rounding per part.
+  template <typename FT>
+  void CaddArm(FT* dst, const FT* a, const FT* b, FfUtils::u32 rotation);
+
+  // See "vfmaddcph" and "vfcmaddcph": dst + a * b or dst + a * conj(b) as two fused multiply-adds per part, the first
+  // of which is rounded. x86 only defines f16.
+  template <typename FT>
+  void MaddcX86(FT* dst, const FT* a, const FT* b, bool conjugate);
+
+  // See "vfmulcph" and "vfcmulcph": a * b or a * conj(b) as a rounded product and a fused multiply-add per part.
+  template <typename FT>
+  void MulcX86(FT* dst, const FT* a, const FT* b, bool conjugate);
+
+  // Applies an operation to n complex numbers (2 * n elements). Blocks of f16 and f32 values that round to nearest
+  // even are computed by a branchless kernel in f64. Only complex numbers with infinities, NaNs, results that may
+  // underflow or overflow, or subnormal operands that are flushed or raise input_denormal take the scalar path. The
+  // flags accumulate. dst may alias a or b.
+  template <typename FT>
+  void Batch(Operation op, FT* dst, const FT* a, const FT* b, std::size_t n);
+
+ protected:
+  // Computes one complex number into result from the accumulator acc (dst of the public functions), a, and b.
+  template <typename FT, Operation op, RoundingMode rm>
+  void Apply(FT* result, const FT* acc, const FT* a, const FT* b);
+
+  template <typename FT, Operation op, RoundingMode rm>
+  void Batch(FT* dst, const FT* a, const FT* b, std::size_t n);
+  template <typename FT, Operation op>
+  void Batch(FT* dst, const FT* a, const FT* b, std::size_t n);
+};
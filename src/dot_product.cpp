@@ -0,0 +1,432 @@
+/**************************************************************************************************
+ * Apache License, Version 2.0
+ * Copyright (c) 2024 chciken/Niko Zurstraßen
+ **************************************************************************************************/
+
+#include "dot_product.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace FfUtils;
+
+namespace {
+
+template <typename FT>
+using Uint = typename FloatToUint<FT>::type;
+
+// Exact conversion to the wider type AT that keeps signaling NaNs signaling, so that the arithmetic in AT raises
+// invalid for them. Host conversions quiet them.
+template <typename AT, typename FT>
+constexpr AT Widen(FT a) {
+  if constexpr (std::is_same_v<AT, FT>) {
+    return a;
+  } else {
+    if (IsNan(a)) [[unlikely]] {
+      const Uint<AT> sign = static_cast<Uint<AT>>(std::signbit(a)) << (NumBits<AT>() - 1);
+      const Uint<AT> frac = static_cast<Uint<AT>>(GetSignificand(a))
+                            << (NumSignificandBits<AT>() - NumSignificandBits<FT>());
+      return std::bit_cast<AT>(static_cast<Uint<AT>>(sign | ExponentMask<AT>() | frac));
+    }
+    return static_cast<AT>(a);
+  }
+}
+
+// Residual of the f64 sum c = a + b (2Sum).
+constexpr f64 TwoSum(f64 a, f64 b, f64 c) {
+  const f64 ad = c - b;
+  const f64 bd = c - ad;
+  return (ad - a) + (bd - b);
+}
+
+// Turns the f64 sum c with residual c - exact into its round-to-odd counterpart (see RoundToOdd of FloppyFloat).
+constexpr f64 RoundToOdd(f64 c, f64 residual) {
+  u64 uc = std::bit_cast<u64>(c);
+  if (residual != 0. && !(uc & 1ull)) {
+    if (std::signbit(residual) == std::signbit(c))
+      uc -= 1ull;
+    else
+      uc += 1ull;
+  }
+  return std::bit_cast<f64>(uc);
+}
+
+// Sign, integer significand, and exponent of the least significant bit of a finite value.
+template <typename FT>
+constexpr void Decompose(FT a, bool& sign, u64& sig, i32& exp) {
+  constexpr i32 kSigBits = NumSignificandBits<FT>();
+  const u64 ua = std::bit_cast<Uint<FT>>(a);
+  const i32 biased = static_cast<i32>((ua >> kSigBits) & ((1u << NumExponentBits<FT>()) - 1));
+  sign = std::signbit(a);
+  sig = ua & ((1ull << kSigBits) - 1);
+  if (biased != 0)
+    sig |= 1ull << kSigBits;
+  exp = std::max(biased, 1) - Bias<FT>() - kSigBits;
+}
+
+// Two's complement fixed-point number whose least significant bit weighs 2^base. Wide enough for the exact sum of
+// any number of products of f64 values and an f64 accumulator.
+class WideAccumulator {
+ public:
+  WideAccumulator(i32 base, i32 num_limbs) : base_(base), num_limbs_(num_limbs) {
+    std::fill_n(limbs_.begin(), num_limbs + 2, 0ull);
+  }
+
+  // Adds (-1)^negative * sig * 2^exp with exp >= base and sig < 2^128 - 2^64.
+  void Add(bool negative, u128 sig, i32 exp) {
+    const i32 shift = exp - base_;
+    const i32 first = shift / 64;
+    const i32 r = shift % 64;
+    const u64 lo = static_cast<u64>(sig);
+    const u64 hi = static_cast<u64>(sig >> 64);
+    const u64 words[3] = {lo << r, r ? (lo >> (64 - r)) | (hi << r) : hi, r ? hi >> (64 - r) : 0};
+    u64 carry = 0;
+    for (i32 i = first; i < num_limbs_; ++i) {
+      const u64 word = i - first < 3 ? words[i - first] : 0;
+      if (i - first >= 3 && !carry)
+        break;
+      if (negative) {
+        const u128 d = static_cast<u128>(limbs_[i]) - word - carry;
+        limbs_[i] = static_cast<u64>(d);
+        carry = (d >> 64) ? 1 : 0;
+      } else {
+        const u128 s = static_cast<u128>(limbs_[i]) + word + carry;
+        limbs_[i] = static_cast<u64>(s);
+        carry = static_cast<u64>(s >> 64);
+      }
+    }
+  }
+
+  // Rounds the sum to odd with the 113 bits of f128. Returns false if the sum is zero.
+  bool ToF128(f128& result) {
+    const bool negative = limbs_[num_limbs_ - 1] >> 63;
+    if (negative) {
+      u64 carry = 1;
+      for (i32 i = 0; i < num_limbs_; ++i) {
+        const u128 s = static_cast<u128>(~limbs_[i]) + carry;
+        limbs_[i] = static_cast<u64>(s);
+        carry = static_cast<u64>(s >> 64);
+      }
+    }
+    i32 top = num_limbs_ - 1;
+    while (top >= 0 && !limbs_[top])
+      --top;
+    if (top < 0)
+      return false;
+
+    constexpr i32 kSigBits = NumSignificandBits<f128>();
+    const i32 msb = top * 64 + 63 - std::countl_zero(limbs_[top]);
+    const i32 lsb = msb - kSigBits;
+    u128 sig;
+    bool sticky = false;
+    if (lsb <= 0) {
+      sig = ((static_cast<u128>(limbs_[1]) << 64) | limbs_[0]) << -lsb;
+    } else {
+      const i32 i = lsb / 64;
+      const i32 r = lsb % 64;
+      sig = ((static_cast<u128>(limbs_[i + 1]) << 64) | limbs_[i]) >> r;
+      if (r)
+        sig |= static_cast<u128>(limbs_[i + 2]) << (128 - r);
+      sticky = limbs_[i] & ((1ull << r) - 1);
+      for (i32 j = 0; j < i; ++j)
+        sticky |= limbs_[j] != 0;
+    }
+    sig = (sig & ((static_cast<u128>(1) << kSigBits) - 1)) | sticky;
+    const u128 biased = static_cast<u128>(base_ + msb + Bias<f128>());
+    result = std::bit_cast<f128>((static_cast<u128>(negative) << 127) | (biased << kSigBits) | sig);
+    return true;
+  }
+
+ private:
+  static constexpr i32 kMaxLimbs = 72;
+  std::array<u64, kMaxLimbs + 2> limbs_;
+  i32 base_;
+  i32 num_limbs_;
+};
+
+}  // namespace
+
+DotProduct::DotProduct() : FloppyFloat() {}
+
+template <typename FT>
+FT DotProduct::DefaultNan() {
+  if constexpr (std::is_same_v<FT, f32>)
+    return qnan32_;
+  else
+    return qnan64_;
+}
+
+template <typename FT, typename AT>
+AT DotProduct::SpecialDot(const FT* a, const FT* b, std::size_t n, AT acc) {
+  // Products of an infinity and zero are invalid, even if a quiet NaN decides the result.
+  bool invalid_product = false;
+  for (std::size_t i = 0; i < n; ++i)
+    invalid_product |= (IsInf(a[i]) && IsZero(b[i])) || (IsZero(a[i]) && IsInf(b[i]));
+
+  // NaN operands take precedence. x86 passes the first NaN on, Arm the first signaling NaN or else the first NaN
+  // with the accumulator in front. The other configurations return the default NaN.
+  AT first_nan = 0, first_snan = 0;
+  bool has_nan = false, has_snan = false;
+  auto visit = [&](AT x) {
+    if (IsNan(x)) {
+      if (!has_nan)
+        first_nan = x;
+      if (IsSnan(x) && !has_snan)
+        first_snan = x;
+      has_nan = true;
+      has_snan |= IsSnan(x);
+    }
+  };
+  if (nan_propagation_scheme == kNanPropArm64)
+    visit(acc);
+  for (std::size_t i = 0; i < n; ++i) {
+    visit(Widen<AT>(a[i]));
+    visit(Widen<AT>(b[i]));
+  }
+  if (nan_propagation_scheme != kNanPropArm64)
+    visit(acc);
+  if (has_nan) {
+    if (has_snan || invalid_product)
+      invalid = true;
+    if (nan_propagation_scheme == kNanPropX86sse)
+      return SetQuietBit(first_nan);
+    if (nan_propagation_scheme == kNanPropArm64)
+      return SetQuietBit(has_snan ? first_snan : first_nan);
+    return DefaultNan<AT>();
+  }
+  if (invalid_product) {
+    invalid = true;
+    return DefaultNan<AT>();
+  }
+
+  // Sums of infinities with different signs are invalid.
+  bool pos_inf = IsPosInf(acc), neg_inf = IsNegInf(acc);
+  for (std::size_t i = 0; i < n; ++i)
+    if (IsInf(a[i]) || IsInf(b[i]))
+      (std::signbit(a[i]) != std::signbit(b[i]) ? neg_inf : pos_inf) = true;
+  if (pos_inf && neg_inf) {
+    invalid = true;
+    return DefaultNan<AT>();
+  }
+  return pos_inf ? nl<AT>::infinity() : -nl<AT>::infinity();
+}
+
+template <typename FT, typename AT, Vfpu::RoundingMode rm>
+AT DotProduct::ExactDot(const FT* a, const FT* b, std::size_t n, AT acc) {
+  // The first pass finds infinities, NaNs, and the range of the exact sum, the second one accumulates.
+  if (IsInfOrNan(acc))
+    return SpecialDot(a, b, n, acc);
+  i32 min_exp = nl<i32>::max(), max_exp = nl<i32>::min();
+  bool any_neg = false, all_neg = true;
+  auto range = [&](bool sign, u64 sig_a, u64 sig_b, i32 exp) {
+    any_neg |= sign;
+    all_neg &= sign;
+    if (sig_a && sig_b) {
+      min_exp = std::min(min_exp, exp);
+      max_exp = std::max(max_exp, exp + static_cast<i32>(std::bit_width(sig_a) + std::bit_width(sig_b)));
+    }
+  };
+  bool sign, sign_b;
+  u64 sig, sig_b;
+  i32 exp, exp_b;
+  Decompose(acc, sign, sig, exp);
+  range(sign, sig, 1, exp);
+  for (std::size_t i = 0; i < n; ++i) {
+    if (IsInfOrNan(a[i]) || IsInfOrNan(b[i]))
+      return SpecialDot(a, b, n, acc);
+    Decompose(a[i], sign, sig, exp);
+    Decompose(b[i], sign_b, sig_b, exp_b);
+    range(sign != sign_b, sig, sig_b, exp + exp_b);
+  }
+
+  // Exact zero sums are -0 if all terms are -0, or if any term is negative when rounding toward negative.
+  constexpr bool kRoundDown = rm == kRoundTowardNegative;
+  if (min_exp == nl<i32>::max())
+    return (kRoundDown ? any_neg : all_neg) ? -static_cast<AT>(0) : static_cast<AT>(0);
+
+  const i32 num_bits = max_exp - min_exp + static_cast<i32>(std::bit_width(n + 1)) + 1;
+  WideAccumulator sum(min_exp, num_bits / 64 + 1);
+  Decompose(acc, sign, sig, exp);
+  if (sig)
+    sum.Add(sign, sig, exp);
+  for (std::size_t i = 0; i < n; ++i) {
+    Decompose(a[i], sign, sig, exp);
+    Decompose(b[i], sign_b, sig_b, exp_b);
+    if (sig && sig_b)
+      sum.Add(sign != sign_b, static_cast<u128>(sig) * sig_b, exp + exp_b);
+  }
+
+  // Rounding to odd first keeps the final rounding correct, as f128 has more than two extra bits.
+  f128 rounded;
+  if (!sum.ToF128(rounded))
+    return kRoundDown ? -static_cast<AT>(0) : static_cast<AT>(0);
+  if constexpr (std::is_same_v<AT, f32>)
+    return F128ToF32<rm>(rounded);
+  else
+    return F128ToF64<rm>(rounded);
+}
+
+template <typename FT, typename AT, Vfpu::RoundingMode rm>
+AT DotProduct::FusedDot(const FT* a, const FT* b, std::size_t n, AT acc) {
+  if constexpr (!std::is_same_v<FT, f64>) {
+    // Products of f16, bf16, and f32 values are exact in f64. The sum is kept as the unevaluated pair hi + lo as long
+    // as that stays exact, which is the common case. Infinities, NaNs, zeros, and wider sums are left to ExactDot.
+    f64 hi = static_cast<f64>(acc);
+    f64 lo = 0.;
+    bool exact = true;
+    for (std::size_t i = 0; i < n; ++i) {
+      const f64 product = static_cast<f64>(a[i]) * static_cast<f64>(b[i]);
+      const f64 sum = hi + product;
+      const f64 error = -TwoSum(hi, product, sum);
+      const f64 next_lo = lo + error;
+      exact &= TwoSum(lo, error, next_lo) == 0.;
+      hi = sum;
+      lo = next_lo;
+    }
+    if (exact && std::isfinite(hi) && hi != 0.) [[likely]] {
+      const f64 sum = hi + lo;
+      const f64 residual = TwoSum(hi, lo, sum);
+      if constexpr (std::is_same_v<AT, f32>) {
+        return F64ToF32<rm>(RoundToOdd(sum, residual));
+      } else {
+        if (residual == 0.)
+          return sum;
+        // hi + lo fits into the significand of f128 unless lo is far below hi.
+        if (std::ilogb(hi) - std::ilogb(lo) < NumSignificandBits<f128>() - NumSignificandBits<f64>())
+          return F128ToF64<rm>(static_cast<f128>(hi) + static_cast<f128>(lo));
+      }
+    }
+  }
+  return ExactDot<FT, AT, rm>(a, b, n, acc);
+}
+
+template <typename AT, typename FT>
+AT DotProduct::WidenOperand(FT a) {
+  FlushInputs(a);
+  return Widen<AT>(a);
+}
+
+template <typename FT, typename AT, Vfpu::RoundingMode rm>
+AT DotProduct::PairwiseSum(const FT* a, const FT* b, std::size_t n) {
+  if (n == 1)
+    return Mul<AT, rm, false, true>(WidenOperand<AT>(a[0]), WidenOperand<AT>(b[0]));
+  const std::size_t half = (n + 1) / 2;
+  const AT left = PairwiseSum<FT, AT, rm>(a, b, half);
+  const AT right = PairwiseSum<FT, AT, rm>(a + half, b + half, n - half);
+  return Add<AT, rm, false, true>(left, right);
+}
+
+template <typename FT, typename AT, DotProduct::Profile profile, Vfpu::RoundingMode rm>
+AT DotProduct::Dot(const FT* a, const FT* b, std::size_t n, AT acc) {
+  if constexpr (profile == kFused) {
+    if (ChecksDenormals<FT>() || ChecksDenormals<AT>()) {
+      // The products are never rounded, so only the operands and the final result are flushed. The operands are
+      // flushed in copies, which are only made if there are subnormal ones.
+      const auto is_subnormal = [](FT x) { return IsSubnormal(x); };
+      std::vector<FT> flushed_a, flushed_b;
+      if (std::any_of(a, a + n, is_subnormal) || std::any_of(b, b + n, is_subnormal)) [[unlikely]] {
+        flushed_a.assign(a, a + n);
+        flushed_b.assign(b, b + n);
+        for (std::size_t i = 0; i < n; ++i)
+          FlushInputs(flushed_a[i], flushed_b[i]);
+        a = flushed_a.data();
+        b = flushed_b.data();
+      }
+      return FlushDenormals<AT>([&](AT x) { return FusedDot<FT, AT, rm>(a, b, n, x); }, [](AT) { return false; },
+                                acc);
+    }
+    return FusedDot<FT, AT, rm>(a, b, n, acc);
+  } else if constexpr (profile == kPerStep) {
+    for (std::size_t i = 0; i < n; ++i)
+      acc = Add<AT, rm, false, true>(acc, Mul<AT, rm, false, true>(WidenOperand<AT>(a[i]), WidenOperand<AT>(b[i])));
+    return acc;
+  } else {
+    if (n == 0)
+      return acc;
+    return Add<AT, rm, false, true>(acc, PairwiseSum<FT, AT, rm>(a, b, n));
+  }
+}
+
+template <typename FT, typename AT>
+AT DotProduct::Dot(Profile profile, const FT* a, const FT* b, std::size_t n, AT acc) {
+  Batch(profile, &acc, a, b, n, 1);
+  return acc;
+}
+
+template f32 DotProduct::Dot<f16, f32>(Profile profile, const f16* a, const f16* b, std::size_t n, f32 acc);
+template f32 DotProduct::Dot<bf16, f32>(Profile profile, const bf16* a, const bf16* b, std::size_t n, f32 acc);
+template f32 DotProduct::Dot<f32, f32>(Profile profile, const f32* a, const f32* b, std::size_t n, f32 acc);
+template f64 DotProduct::Dot<f32, f64>(Profile profile, const f32* a, const f32* b, std::size_t n, f64 acc);
+template f64 DotProduct::Dot<f64, f64>(Profile profile, const f64* a, const f64* b, std::size_t n, f64 acc);
+
+template <typename FT, typename AT, DotProduct::Profile profile, Vfpu::RoundingMode rm>
+void DotProduct::Batch(AT* dst, const FT* a, const FT* b, std::size_t n, std::size_t count) {
+  for (std::size_t j = 0; j < count; ++j)
+    dst[j] = Dot<FT, AT, profile, rm>(a + j * n, b + j * n, n, dst[j]);
+}
+
+template <typename FT, typename AT, DotProduct::Profile profile>
+void DotProduct::Batch(AT* dst, const FT* a, const FT* b, std::size_t n, std::size_t count) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return Batch<FT, AT, profile, kRoundTiesToEven>(dst, a, b, n, count);
+  case kRoundTiesToAway:
+    return Batch<FT, AT, profile, kRoundTiesToAway>(dst, a, b, n, count);
+  case kRoundTowardPositive:
+    return Batch<FT, AT, profile, kRoundTowardPositive>(dst, a, b, n, count);
+  case kRoundTowardNegative:
+    return Batch<FT, AT, profile, kRoundTowardNegative>(dst, a, b, n, count);
+  case kRoundTowardZero:
+    return Batch<FT, AT, profile, kRoundTowardZero>(dst, a, b, n, count);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <typename FT, typename AT>
+void DotProduct::Batch(Profile profile, AT* dst, const FT* a, const FT* b, std::size_t n, std::size_t count) {
+  switch (profile) {
+  case kFused:
+    return Batch<FT, AT, kFused>(dst, a, b, n, count);
+  case kPerStep:
+    return Batch<FT, AT, kPerStep>(dst, a, b, n, count);
+  case kPairwise:
+    return Batch<FT, AT, kPairwise>(dst, a, b, n, count);
+  default:
+    throw std::runtime_error(std::string("Unknown dot product profile"));
+  }
+}
+
+template void DotProduct::Batch<f16, f32>(Profile profile, f32* dst, const f16* a, const f16* b, std::size_t n,
+                                          std::size_t count);
+template void DotProduct::Batch<bf16, f32>(Profile profile, f32* dst, const bf16* a, const bf16* b, std::size_t n,
+                                           std::size_t count);
+template void DotProduct::Batch<f32, f32>(Profile profile, f32* dst, const f32* a, const f32* b, std::size_t n,
+                                          std::size_t count);
+template void DotProduct::Batch<f32, f64>(Profile profile, f64* dst, const f32* a, const f32* b, std::size_t n,
+                                          std::size_t count);
+template void DotProduct::Batch<f64, f64>(Profile profile, f64* dst, const f64* a, const f64* b, std::size_t n,
+                                          std::size_t count);
+
+void DotProduct::Dpps(f32* dst, const f32* a, const f32* b, u8 imm8) {
+  f32 products[4];
+  for (i32 i = 0; i < 4; ++i)
+    products[i] = ((imm8 >> (4 + i)) & 1) ? Mul<f32>(a[i], b[i]) : 0.f32;
+  const f32 sum = Add<f32>(Add<f32>(products[0], products[1]), Add<f32>(products[2], products[3]));
+  for (i32 i = 0; i < 4; ++i)
+    dst[i] = ((imm8 >> i) & 1) ? sum : 0.f32;
+}
+
+void DotProduct::Dppd(f64* dst, const f64* a, const f64* b, u8 imm8) {
+  f64 products[2];
+  for (i32 i = 0; i < 2; ++i)
+    products[i] = ((imm8 >> (4 + i)) & 1) ? Mul<f64>(a[i], b[i]) : 0.f64;
+  const f64 sum = Add<f64>(products[0], products[1]);
+  for (i32 i = 0; i < 2; ++i)
+    dst[i] = ((imm8 >> i) & 1) ? sum : 0.f64;
+}
@@ -0,0 +1,64 @@
+#pragma once
+/**************************************************************************************************
+ * Apache License, Version 2.0
+ * Copyright (c) 2024 chciken/Niko Zurstraßen
+ **************************************************************************************************/
+
+#include <cstddef>
+
+#include "floppy_float.h"
+#include "utils.h"
+
+// Simulates dot-product instructions, which differ in where they round. A profile describes the rounding:
+//   kFused:    The products and their sum with the accumulator are exact and rounded once (Arm "fdot" and other
+//              multi-term fused dot products).
+//   kPerStep:  Each product is rounded, then added to the accumulator one after another with a rounding per step.
+//   kPairwise: Each product is rounded, the products are summed as a balanced binary tree with a rounding per addition,
+//              and the accumulator is added last (x86 "dpps"/"dppd").
+// Products and sums are computed in the accumulator type AT. Supported are (f16, f32), (bf16, f32), (f32, f32),
+// (f32, f64), and (f64, f64) as (FT, AT). The bf16 instructions with their own non-IEEE rounding are DotBf16x86 and
+// DotBf16Arm of FloppyFloat. Subnormals are flushed like by the arithmetic operations (see Vfpu::flush_inputs), with
+// the operands under the controls of FT and the products and sums under those of AT.
+class DotProduct : public FloppyFloat {
+ public:
+  DotProduct();
+
+  enum Profile { kFused, kPerStep, kPairwise };
+
+  // acc + a[0] * b[0] + ... + a[n - 1] * b[n - 1] rounded according to the profile and the dynamic rounding mode.
+  template <typename FT, typename AT>
+  AT Dot(Profile profile, const FT* a, const FT* b, std::size_t n, AT acc);
+
+  // Computes count dot products of n terms each: dst[j] = Dot(profile, a + j * n, b + j * n, n, dst[j]). The profile
+  // and the rounding mode are dispatched once for all of them. The flags accumulate.
+  template <typename FT, typename AT>
+  void Batch(Profile profile, AT* dst, const FT* a, const FT* b, std::size_t n, std::size_t count);
+
+  // See "dpps" and "dppd": The products of the lanes selected by imm8[7:4] (others are +0) are summed pairwise. The
+  // sum is written to the lanes selected by imm8[3:0], the others are set to +0. dst may alias a or b.
+  void Dpps(FfUtils::f32* dst, const FfUtils::f32* a, const FfUtils::f32* b, FfUtils::u8 imm8);  // 4 lanes.
+  void Dppd(FfUtils::f64* dst, const FfUtils::f64* a, const FfUtils::f64* b, FfUtils::u8 imm8);  // 2 lanes.
+
+ protected:
+  template <typename FT>
+  FT DefaultNan();
+  // Flushes a subnormal operand (see FlushInputs) and widens it to AT.
+  template <typename AT, typename FT>
+  AT WidenOperand(FT a);
+
+  template <typename FT, typename AT, Profile profile, RoundingMode rm>
+  AT Dot(const FT* a, const FT* b, std::size_t n, AT acc);
+  template <typename FT, typename AT, RoundingMode rm>
+  AT PairwiseSum(const FT* a, const FT* b, std::size_t n);
+  template <typename FT, typename AT, RoundingMode rm>
+  AT FusedDot(const FT* a, const FT* b, std::size_t n, AT acc);
+  template <typename FT, typename AT, RoundingMode rm>
+  AT ExactDot(const FT* a, const FT* b, std::size_t n, AT acc);
+  template <typename FT, typename AT>
+  AT SpecialDot(const FT* a, const FT* b, std::size_t n, AT acc);
+
+  template <typename FT, typename AT, Profile profile>
+  void Batch(AT* dst, const FT* a, const FT* b, std::size_t n, std::size_t count);
+  template <typename FT, typename AT, Profile profile, RoundingMode rm>
+  void Batch(AT* dst, const FT* a, const FT* b, std::size_t n, std::size_t count);
+};
@@ -0,0 +1,554 @@
+/**************************************************************************************************
+ * Apache License, Version 2.0
+ * Copyright (c) 2024 chciken/Niko Zurstraßen
+ **************************************************************************************************/
+
+#include "estimator.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+using namespace FfUtils;
+
+namespace {
+
+// See RISC-V "V" extension: "Vector Floating-Point Reciprocal Estimate Instruction". Indexed by the 7 leading
+// fraction bits, holds the 7 leading fraction bits of the estimate.
+constexpr u8 kRecipTableRiscv[128] = {
+    127, 125, 123, 121, 119, 117, 116, 114, 112, 110, 109, 107, 105, 104, 102, 100, 99, 97, 96, 94, 93, 91,
+    90,  88,  87,  85,  84,  83,  81,  80,  79,  77,  76,  75,  74,  72,  71,  70,  69, 68, 66, 65, 64, 63,
+    62,  61,  60,  59,  58,  57,  56,  55,  54,  53,  52,  51,  50,  49,  48,  47,  46, 45, 44, 43, 42, 41,
+    40,  40,  39,  38,  37,  36,  35,  35,  34,  33,  32,  31,  31,  30,  29,  28,  28, 27, 26, 25, 25, 24,
+    23,  23,  22,  21,  21,  20,  19,  19,  18,  17,  17,  16,  15,  15,  14,  14,  13, 12, 12, 11, 11, 10,
+    9,   9,   8,   8,   7,   7,   6,   5,   5,   4,   4,   3,   3,   2,   2,   1,   1,  0};
+
+// See RISC-V "V" extension: "Vector Floating-Point Reciprocal Square-Root Estimate Instruction". Indexed by the
+// exponent LSB and the 6 leading fraction bits, holds the 7 leading fraction bits of the estimate.
+constexpr u8 kRsqrtTableRiscv[128] = {
+    52,  51,  50,  48,  47,  46,  44,  43,  42,  41,  40,  39,  38,  36,  35,  34,  33, 32, 31, 30, 30, 29,
+    28,  27,  26,  25,  24,  23,  23,  22,  21,  20,  19,  19,  18,  17,  16,  16,  15, 14, 14, 13, 12, 12,
+    11,  10,  10,  9,   9,   8,   7,   7,   6,   6,   5,   4,   4,   3,   3,   2,   2,  1,  1,  0,  127, 125,
+    123, 121, 119, 118, 116, 114, 113, 111, 109, 108, 106, 105, 103, 102, 100, 99,  97, 96, 95, 93, 92, 91,
+    90,  88,  87,  86,  85,  84,  83,  82,  80,  79,  78,  77,  76,  75,  74,  73,  72, 71, 70, 70, 69, 68,
+    67,  66,  65,  64,  63,  63,  62,  61,  60,  59,  59,  58,  57,  56,  56,  55,  54, 53};
+
+// See Arm A64 pseudocode: RecipEstimate(). a in [256, 511] represents [0.5, 1.0), the result in [256, 511]
+// represents [1.0, 2.0).
+constexpr u32 RecipEstimateArm(u32 a) {
+  a = a * 2 + 1;  // In units of 1/1024 rounded to nearest.
+  const u32 b = (1u << 19) / a;
+  return (b + 1) / 2;
+}
+
+// See Arm A64 pseudocode: RecipSqrtEstimate(). a in [128, 511] represents [0.25, 1.0), the result in [256, 511]
+// represents [1.0, 2.0).
+constexpr u32 RecipSqrtEstimateArm(u32 a) {
+  if (a < 256) {
+    a = a * 2 + 1;  // In units of 1/512 rounded to nearest.
+  } else {
+    a = (a >> 1) << 1;
+    a = (a + 1) * 2;  // In units of 1/256 rounded to nearest.
+  }
+  u64 b = 512;
+  while (a * (b + 1) * (b + 1) < (1ull << 28))
+    ++b;
+  return static_cast<u32>((b + 1) / 2);
+}
+
+// Only the low 8 bits of the Arm estimates are stored, the leading one is implicit.
+constexpr auto kRecipTableArm = [] {
+  std::array<u8, 256> table{};
+  for (u32 i = 0; i < table.size(); ++i)
+    table[i] = static_cast<u8>(RecipEstimateArm(256 + i));
+  return table;
+}();
+
+constexpr auto kRsqrtTableArm = [] {
+  std::array<u8, 384> table{};
+  for (u32 i = 0; i < table.size(); ++i)
+    table[i] = static_cast<u8>(RecipSqrtEstimateArm(128 + i));
+  return table;
+}();
+
+// See Intel SDM: "VRCP14SS" and "VRSQRT14SS". The estimates are piecewise linear in the leading fraction bits: The
+// segment index selects base and slope, the next 10 bits L give the 16 fraction bits of the estimate as
+// (base - slope * L) >> 10. The remaining fraction bits only matter for exact powers of two. Checked against the
+// hardware for all f32 operands.
+struct LinearSegment {
+  u32 base;
+  u32 slope;
+};
+
+// Indexed by the 6 leading fraction bits, L are the next 10 fraction bits.
+constexpr LinearSegment kRecipTableX86[64] = {
+    {67105280, 2018}, {65039360, 1954}, {63038464, 1898}, {61095936, 1842}, {59209216, 1786}, {57380352, 1738},
+    {55600640, 1686}, {53873664, 1642}, {52192256, 1594}, {50558976, 1554}, {48967680, 1510}, {47420416, 1470},
+    {45914112, 1434}, {44447232, 1398}, {43016704, 1362}, {41621504, 1326}, {40263168, 1294}, {38937088, 1262},
+    {37645312, 1234}, {36382208, 1202}, {35150336, 1174}, {33947136, 1146}, {32773120, 1122}, {31623680, 1094},
+    {30501888, 1070}, {29405184, 1046}, {28334592, 1026}, {27284480, 1002}, {26258944, 982}, {25254400, 958},
+    {24271872, 938}, {23309824, 918}, {22369280, 902}, {21446144, 882}, {20543488, 866}, {19656704, 846},
+    {18789376, 830}, {17938944, 814}, {17104896, 798}, {16287232, 782}, {15486976, 770}, {14699008, 754},
+    {13926912, 738}, {13170176, 726}, {12427776, 714}, {11696640, 698}, {10980352, 686}, {10276864, 674},
+    {9586176, 662}, {8907264, 650}, {8240128, 638}, {7586816, 630}, {6941696, 618}, {6308352, 606}, {5687296, 598},
+    {5074432, 586}, {4473856, 578}, {3882496, 570}, {3299840, 558}, {2729472, 550}, {2167296, 542}, {1613312, 534},
+    {1067520, 526}, {529920, 518}};
+
+// Indexed by the negated exponent LSB and the 5 leading fraction bits, L are the next 10 fraction bits.
+constexpr LinearSegment kRsqrtTableX86[64] = {
+    {67102976, 2002}, {65052928, 1910}, {63096064, 1830}, {61223424, 1754}, {59428352, 1682}, {57706240, 1614},
+    {56052992, 1550}, {54464768, 1494}, {52935168, 1438}, {51462400, 1386}, {50042624, 1338}, {48673792, 1294},
+    {47350272, 1250}, {46070272, 1206}, {44834560, 1170}, {43637504, 1134}, {42477312, 1098}, {41353984, 1066},
+    {40263424, 1034}, {39204864, 1002}, {38178048, 974}, {37180160, 946}, {36210688, 922}, {35267328, 898},
+    {34348800, 874}, {33454848, 850}, {32585216, 830}, {31735296, 806}, {30908160, 786}, {30103040, 770},
+    {29314816, 750}, {28547584, 734}, {27792640, 1414}, {26343680, 1350}, {24960000, 1294}, {23634944, 1238},
+    {22367232, 1190}, {21149440, 1142}, {19980544, 1098}, {18856192, 1054}, {17775872, 1018}, {16734976, 982},
+    {15729920, 946}, {14761216, 914}, {13825280, 882}, {12921344, 854}, {12046592, 826}, {11201280, 802},
+    {10381056, 778}, {9585408, 754}, {8814336, 730}, {8067328, 710}, {7340800, 690}, {6635008, 670}, {5948416, 650},
+    {5281792, 634}, {4633088, 618}, {4001024, 602}, {3385088, 586}, {2784768, 570}, {2200832, 558}, {1629440, 542},
+    {1073152, 530}, {529920, 518}};
+
+template <typename FT>
+using Uint = typename FloatToUint<FT>::type;
+
+template <typename FT>
+constexpr i32 BiasedExponent(Uint<FT> a) {
+  return static_cast<i32>((a >> NumSignificandBits<FT>()) & ((1u << NumExponentBits<FT>()) - 1));
+}
+
+template <typename FT>
+constexpr u64 Fraction(Uint<FT> a) {
+  return a & ((1ull << NumSignificandBits<FT>()) - 1);
+}
+
+// Normalizes the fraction of a subnormal like the reference algorithms: The leading one is shifted out and the
+// exponent becomes the negated number of leading zeros.
+template <typename FT>
+constexpr void NormalizeOperand(i32& exp, u64& frac) {
+  constexpr i32 kSigBits = NumSignificandBits<FT>();
+  const i32 lz = std::countl_zero(frac) - (64 - kSigBits);
+  exp = -lz;
+  frac = (frac << (lz + 1)) & ((1ull << kSigBits) - 1);
+}
+
+// Reciprocal results with exponents 0 and -1 become subnormal.
+template <typename FT>
+constexpr u64 DenormalizeFraction(i32 exp, u64 frac) {
+  constexpr i32 kSigBits = NumSignificandBits<FT>();
+  frac = (frac >> 1) | (1ull << (kSigBits - 1));
+  return frac >> -exp;
+}
+
+template <typename FT>
+constexpr Uint<FT> Pack(Uint<FT> sign, i32 exp, u64 frac) {
+  return static_cast<Uint<FT>>(sign | (static_cast<Uint<FT>>(exp) << NumSignificandBits<FT>()) | frac);
+}
+
+template <typename FT>
+constexpr u64 RecipFractionX86(u64 frac) {
+  constexpr i32 kSigBits = NumSignificandBits<FT>();
+  const LinearSegment& segment = kRecipTableX86[frac >> (kSigBits - 6)];
+  const u32 l = static_cast<u32>(frac >> (kSigBits - 16)) & 0x3ff;
+  return static_cast<u64>((segment.base - segment.slope * l) >> 10) << (kSigBits - 16);
+}
+
+template <typename FT>
+constexpr u64 RsqrtFractionX86(i32 exp, u64 frac) {
+  constexpr i32 kSigBits = NumSignificandBits<FT>();
+  const LinearSegment& segment = kRsqrtTableX86[((~exp & 1) << 5) | (frac >> (kSigBits - 5))];
+  const u32 l = static_cast<u32>(frac >> (kSigBits - 15)) & 0x3ff;
+  return static_cast<u64>((segment.base - segment.slope * l) >> 10) << (kSigBits - 16);
+}
+
+// True if the operand is normal and so is the result, which is the common case computed by EstimateNormal.
+template <typename FT, Estimator::Operation op>
+constexpr bool IsNormalCase(Uint<FT> a) {
+  constexpr i32 kBias = Bias<FT>();
+  const i32 exp = BiasedExponent<FT>(a);
+  if constexpr (op == Estimator::kRecipEstimateRiscv || op == Estimator::kRecipEstimateArm ||
+                op == Estimator::kRecipEstimateX86)
+    return exp >= 1 && exp <= 2 * kBias - 2;
+  else if constexpr (op == Estimator::kRsqrtEstimateRiscv || op == Estimator::kRsqrtEstimateArm ||
+                     op == Estimator::kRsqrtEstimateX86)
+    return !(a & SignMask<FT>()) && exp >= 1 && exp <= 2 * kBias;
+  else
+    return exp >= 1 && exp <= 2 * kBias;
+}
+
+template <typename FT, Estimator::Operation op>
+constexpr Uint<FT> EstimateNormal(Uint<FT> a) {
+  using UT = Uint<FT>;
+  constexpr i32 kSigBits = NumSignificandBits<FT>();
+  constexpr i32 kBias = Bias<FT>();
+  const UT sign = a & SignMask<FT>();
+  const i32 exp = BiasedExponent<FT>(a);
+  const u64 frac = Fraction<FT>(a);
+  if constexpr (op == Estimator::kRecipEstimateRiscv) {
+    const u64 out_frac = static_cast<u64>(kRecipTableRiscv[frac >> (kSigBits - 7)]) << (kSigBits - 7);
+    return Pack<FT>(sign, 2 * kBias - 1 - exp, out_frac);
+  } else if constexpr (op == Estimator::kRsqrtEstimateRiscv) {
+    const u32 index = static_cast<u32>(((exp & 1) << 6) | (frac >> (kSigBits - 6)));
+    const u64 out_frac = static_cast<u64>(kRsqrtTableRiscv[index]) << (kSigBits - 7);
+    return Pack<FT>(0, (3 * kBias - 1 - exp) / 2, out_frac);
+  } else if constexpr (op == Estimator::kRecipEstimateArm) {
+    const u64 out_frac = static_cast<u64>(kRecipTableArm[frac >> (kSigBits - 8)]) << (kSigBits - 8);
+    return Pack<FT>(sign, 2 * kBias - 1 - exp, out_frac);
+  } else if constexpr (op == Estimator::kRsqrtEstimateArm) {
+    const u32 scaled = (exp & 1) ? static_cast<u32>(128 | (frac >> (kSigBits - 7)))
+                                 : static_cast<u32>(256 | (frac >> (kSigBits - 8)));
+    const u64 out_frac = static_cast<u64>(kRsqrtTableArm[scaled - 128]) << (kSigBits - 8);
+    return Pack<FT>(0, (3 * kBias - 1 - exp) / 2, out_frac);
+  } else if constexpr (op == Estimator::kRecipEstimateX86) {
+    const bool exact = frac == 0;
+    return Pack<FT>(sign, 2 * kBias - 1 - exp + exact, exact ? 0 : RecipFractionX86<FT>(frac));
+  } else if constexpr (op == Estimator::kRsqrtEstimateX86) {
+    const bool exact = frac == 0 && (exp & 1);
+    return Pack<FT>(0, (3 * kBias - 1 - exp) / 2 + exact, exact ? 0 : RsqrtFractionX86<FT>(exp, frac));
+  } else {
+    return Pack<FT>(sign, ~exp & ((1 << NumExponentBits<FT>()) - 1), 0);
+  }
+}
+
+}  // namespace
+
+Estimator::Estimator() : FloppyFloat() {}
+
+template <typename FT>
+FT Estimator::DefaultNan() {
+  if constexpr (std::is_same_v<FT, f16>)
+    return qnan16_;
+  else if constexpr (std::is_same_v<FT, f32>)
+    return qnan32_;
+  else
+    return qnan64_;
+}
+
+template <typename FT>
+FT Estimator::PropagateNan(FT a) {
+  if (IsSnan(a))
+    invalid = true;
+  if (nan_propagation_scheme == kNanPropX86sse || nan_propagation_scheme == kNanPropArm64)
+    return SetQuietBit(a);
+  return DefaultNan<FT>();
+}
+
+// The same for RISC-V and Arm: Rounding toward zero, and rounding away from the sign, yield the largest finite number.
+template <typename FT>
+FT Estimator::OverflowResult(bool sign) {
+  overflow = true;
+  inexact = true;
+  const bool to_max = rounding_mode == kRoundTowardZero || (rounding_mode == kRoundTowardNegative && !sign) ||
+                      (rounding_mode == kRoundTowardPositive && sign);
+  const FT result = to_max ? nl<FT>::max() : nl<FT>::infinity();
+  return sign ? -result : result;
+}
+
+template <typename FT>
+FT Estimator::RecipEstimateRiscv(FT a) {
+  using UT = Uint<FT>;
+  constexpr i32 kSigBits = NumSignificandBits<FT>();
+  constexpr i32 kBias = Bias<FT>();
+  const UT ua = std::bit_cast<UT>(a);
+  if (IsNormalCase<FT, kRecipEstimateRiscv>(ua)) [[likely]]
+    return std::bit_cast<FT>(EstimateNormal<FT, kRecipEstimateRiscv>(ua));
+
+  const UT sign = ua & SignMask<FT>();
+  if (IsNan(a))
+    return PropagateNan(a);
+  if (IsInf(a))
+    return std::bit_cast<FT>(sign);
+  if (IsZero(a)) {
+    division_by_zero = true;
+    return std::bit_cast<FT>(static_cast<UT>(sign | ExponentMask<FT>()));
+  }
+
+  i32 exp = BiasedExponent<FT>(ua);
+  u64 frac = Fraction<FT>(ua);
+  if (exp == 0) {
+    NormalizeOperand<FT>(exp, frac);
+    if (exp < -1)
+      return OverflowResult<FT>(sign);
+  }
+  i32 out_exp = 2 * kBias - 1 - exp;
+  u64 out_frac = static_cast<u64>(kRecipTableRiscv[frac >> (kSigBits - 7)]) << (kSigBits - 7);
+  if (out_exp <= 0) {
+    out_frac = DenormalizeFraction<FT>(out_exp, out_frac);
+    out_exp = 0;
+  }
+  return std::bit_cast<FT>(Pack<FT>(sign, out_exp, out_frac));
+}
+
+template f16 Estimator::RecipEstimateRiscv<f16>(f16 a);
+template f32 Estimator::RecipEstimateRiscv<f32>(f32 a);
+template f64 Estimator::RecipEstimateRiscv<f64>(f64 a);
+
+template <typename FT>
+FT Estimator::RsqrtEstimateRiscv(FT a) {
+  using UT = Uint<FT>;
+  constexpr i32 kSigBits = NumSignificandBits<FT>();
+  constexpr i32 kBias = Bias<FT>();
+  const UT ua = std::bit_cast<UT>(a);
+  if (IsNormalCase<FT, kRsqrtEstimateRiscv>(ua)) [[likely]]
+    return std::bit_cast<FT>(EstimateNormal<FT, kRsqrtEstimateRiscv>(ua));
+
+  const UT sign = ua & SignMask<FT>();
+  if (IsNan(a))
+    return PropagateNan(a);
+  if (IsZero(a)) {
+    division_by_zero = true;
+    return std::bit_cast<FT>(static_cast<UT>(sign | ExponentMask<FT>()));
+  }
+  if (sign) {
+    invalid = true;
+    return DefaultNan<FT>();
+  }
+  if (IsInf(a))
+    return static_cast<FT>(0.f);
+
+  i32 exp = 0;
+  u64 frac = Fraction<FT>(ua);
+  NormalizeOperand<FT>(exp, frac);  // Subnormal.
+  const u32 index = static_cast<u32>(((exp & 1) << 6) | (frac >> (kSigBits - 6)));
+  const u64 out_frac = static_cast<u64>(kRsqrtTableRiscv[index]) << (kSigBits - 7);
+  return std::bit_cast<FT>(Pack<FT>(0, (3 * kBias - 1 - exp) / 2, out_frac));
+}
+
+template f16 Estimator::RsqrtEstimateRiscv<f16>(f16 a);
+template f32 Estimator::RsqrtEstimateRiscv<f32>(f32 a);
+template f64 Estimator::RsqrtEstimateRiscv<f64>(f64 a);
+
+template <typename FT>
+FT Estimator::RecipEstimateArm(FT a) {
+  using UT = Uint<FT>;
+  constexpr i32 kSigBits = NumSignificandBits<FT>();
+  constexpr i32 kBias = Bias<FT>();
+  const UT ua = std::bit_cast<UT>(a);
+  if (IsNormalCase<FT, kRecipEstimateArm>(ua)) [[likely]]
+    return std::bit_cast<FT>(EstimateNormal<FT, kRecipEstimateArm>(ua));
+
+  FlushInputs<false>(a);  // FPCR.FZ raises IDC, FPCR.FIZ does not. Only x86 knows DE.
+  const UT sign = ua & SignMask<FT>();
+  if (IsNan(a))
+    return PropagateNan(a);
+  if (IsInf(a))
+    return std::bit_cast<FT>(sign);
+  if (IsZero(a)) {
+    division_by_zero = true;
+    return std::bit_cast<FT>(static_cast<UT>(sign | ExponentMask<FT>()));
+  }
+
+  i32 exp = BiasedExponent<FT>(ua);
+  u64 frac = Fraction<FT>(ua);
+  if (exp == 0) {
+    NormalizeOperand<FT>(exp, frac);
+    if (exp < -1)  // |a| < 2^-(bias + 1)
+      return OverflowResult<FT>(sign);
+  }
+  i32 out_exp = 2 * kBias - 1 - exp;
+  u64 out_frac = static_cast<u64>(kRecipTableArm[frac >> (kSigBits - 8)]) << (kSigBits - 8);
+  if (out_exp <= 0) {
+    if (std::is_same_v<FT, f16> ? flush_outputs_f16 : flush_outputs) {
+      underflow = true;  // FPSR.UFC without IXC.
+      return std::bit_cast<FT>(sign);
+    }
+    out_frac = DenormalizeFraction<FT>(out_exp, out_frac);
+    out_exp = 0;
+  }
+  return std::bit_cast<FT>(Pack<FT>(sign, out_exp, out_frac));
+}
+
+template f16 Estimator::RecipEstimateArm<f16>(f16 a);
+template f32 Estimator::RecipEstimateArm<f32>(f32 a);
+template f64 Estimator::RecipEstimateArm<f64>(f64 a);
+
+template <typename FT>
+FT Estimator::RsqrtEstimateArm(FT a) {
+  using UT = Uint<FT>;
+  constexpr i32 kSigBits = NumSignificandBits<FT>();
+  constexpr i32 kBias = Bias<FT>();
+  const UT ua = std::bit_cast<UT>(a);
+  if (IsNormalCase<FT, kRsqrtEstimateArm>(ua)) [[likely]]
+    return std::bit_cast<FT>(EstimateNormal<FT, kRsqrtEstimateArm>(ua));
+
+  FlushInputs<false>(a);
+  const UT sign = ua & SignMask<FT>();
+  if (IsNan(a))
+    return PropagateNan(a);
+  if (IsZero(a)) {
+    division_by_zero = true;
+    return std::bit_cast<FT>(static_cast<UT>(sign | ExponentMask<FT>()));
+  }
+  if (sign) {
+    invalid = true;
+    return DefaultNan<FT>();
+  }
+  if (IsInf(a))
+    return static_cast<FT>(0.f);
+
+  i32 exp = 0;
+  u64 frac = Fraction<FT>(ua);
+  NormalizeOperand<FT>(exp, frac);  // Subnormal.
+  const u32 scaled = (exp & 1) ? static_cast<u32>(128 | (frac >> (kSigBits - 7)))
+                               : static_cast<u32>(256 | (frac >> (kSigBits - 8)));
+  const u64 out_frac = static_cast<u64>(kRsqrtTableArm[scaled - 128]) << (kSigBits - 8);
+  return std::bit_cast<FT>(Pack<FT>(0, (3 * kBias - 1 - exp) / 2, out_frac));
+}
+
+template f16 Estimator::RsqrtEstimateArm<f16>(f16 a);
+template f32 Estimator::RsqrtEstimateArm<f32>(f32 a);
+template f64 Estimator::RsqrtEstimateArm<f64>(f64 a);
+
+template <typename FT>
+FT Estimator::RecipExponentArm(FT a) {
+  using UT = Uint<FT>;
+  const UT ua = std::bit_cast<UT>(a);
+  if (IsNan(a)) [[unlikely]]
+    return PropagateNan(a);
+  if (BiasedExponent<FT>(ua) == 0) {  // Zeros and subnormals get the largest finite exponent.
+    FlushInputs<false>(a);             // Only for IDC, flushing doesn't change the result.
+    return std::bit_cast<FT>(Pack<FT>(ua & SignMask<FT>(), (1 << NumExponentBits<FT>()) - 2, 0));
+  }
+  return std::bit_cast<FT>(EstimateNormal<FT, kRecipExponentArm>(ua));
+}
+
+template f16 Estimator::RecipExponentArm<f16>(f16 a);
+template f32 Estimator::RecipExponentArm<f32>(f32 a);
+template f64 Estimator::RecipExponentArm<f64>(f64 a);
+
+template <typename FT>
+FT Estimator::RecipEstimateX86(FT a) {
+  using UT = Uint<FT>;
+  constexpr i32 kBias = Bias<FT>();
+  const UT ua = std::bit_cast<UT>(a);
+  if (IsNormalCase<FT, kRecipEstimateX86>(ua)) [[likely]]
+    return std::bit_cast<FT>(EstimateNormal<FT, kRecipEstimateX86>(ua));
+
+  const UT sign = ua & SignMask<FT>();
+  if (IsNan(a))
+    return SetQuietBit(a);  // Without invalid, even for signaling NaNs.
+  if (IsInf(a))
+    return std::bit_cast<FT>(sign);
+  if (IsZero(a) || (flush_inputs && IsSubnormal(a)))
+    return std::bit_cast<FT>(static_cast<UT>(sign | ExponentMask<FT>()));
+
+  i32 exp = BiasedExponent<FT>(ua);
+  u64 frac = Fraction<FT>(ua);
+  if (exp == 0)
+    NormalizeOperand<FT>(exp, frac);
+  const bool exact = frac == 0;
+  i32 out_exp = 2 * kBias - 1 - exp + exact;
+  if (out_exp > 2 * kBias)  // Infinity regardless of the rounding mode.
+    return std::bit_cast<FT>(static_cast<UT>(sign | ExponentMask<FT>()));
+  u64 out_frac = exact ? 0 : RecipFractionX86<FT>(frac);
+  if (out_exp <= 0) {
+    if (flush_outputs)
+      return std::bit_cast<FT>(sign);
+    out_frac = DenormalizeFraction<FT>(out_exp, out_frac);  // Exact, the estimate has only 16 fraction bits.
+    out_exp = 0;
+  }
+  return std::bit_cast<FT>(Pack<FT>(sign, out_exp, out_frac));
+}
+
+template f32 Estimator::RecipEstimateX86<f32>(f32 a);
+template f64 Estimator::RecipEstimateX86<f64>(f64 a);
+
+template <typename FT>
+FT Estimator::RsqrtEstimateX86(FT a) {
+  using UT = Uint<FT>;
+  constexpr i32 kBias = Bias<FT>();
+  const UT ua = std::bit_cast<UT>(a);
+  if (IsNormalCase<FT, kRsqrtEstimateX86>(ua)) [[likely]]
+    return std::bit_cast<FT>(EstimateNormal<FT, kRsqrtEstimateX86>(ua));
+
+  const UT sign = ua & SignMask<FT>();
+  if (IsNan(a))
+    return SetQuietBit(a);
+  if (IsZero(a) || (flush_inputs && IsSubnormal(a)))
+    return std::bit_cast<FT>(static_cast<UT>(sign | ExponentMask<FT>()));
+  if (sign)
+    return DefaultNan<FT>();
+  if (IsInf(a))
+    return static_cast<FT>(0.f);
+
+  i32 exp = 0;
+  u64 frac = Fraction<FT>(ua);
+  NormalizeOperand<FT>(exp, frac);  // Subnormal.
+  const bool exact = frac == 0 && (exp & 1);
+  const u64 out_frac = exact ? 0 : RsqrtFractionX86<FT>(exp, frac);
+  return std::bit_cast<FT>(Pack<FT>(0, (3 * kBias - 1 - exp) / 2 + exact, out_frac));
+}
+
+template f32 Estimator::RsqrtEstimateX86<f32>(f32 a);
+template f64 Estimator::RsqrtEstimateX86<f64>(f64 a);
+
+template <typename FT, Estimator::Operation op>
+void Estimator::Batch(FT* dst, const FT* a, std::size_t n) {
+  using UT = Uint<FT>;
+  constexpr std::size_t kBlockSize = 64;
+  for (std::size_t i = 0; i < n; i += kBlockSize) {
+    const std::size_t block_size = std::min(kBlockSize, n - i);
+    UT ua[kBlockSize];
+    UT result[kBlockSize];
+    std::memcpy(ua, a + i, block_size * sizeof(FT));
+    bool normal = true;
+    for (std::size_t j = 0; j < block_size; ++j) {
+      normal &= IsNormalCase<FT, op>(ua[j]);
+      result[j] = EstimateNormal<FT, op>(ua[j]);
+    }
+
+    if (normal) [[likely]] {
+      std::memcpy(dst + i, result, block_size * sizeof(FT));
+      continue;
+    }
+
+    for (std::size_t j = 0; j < block_size; ++j) {
+      const FT value = std::bit_cast<FT>(ua[j]);
+      if constexpr (op == kRecipEstimateRiscv)
+        dst[i + j] = RecipEstimateRiscv(value);
+      else if constexpr (op == kRsqrtEstimateRiscv)
+        dst[i + j] = RsqrtEstimateRiscv(value);
+      else if constexpr (op == kRecipEstimateArm)
+        dst[i + j] = RecipEstimateArm(value);
+      else if constexpr (op == kRsqrtEstimateArm)
+        dst[i + j] = RsqrtEstimateArm(value);
+      else if constexpr (op == kRecipEstimateX86)
+        dst[i + j] = RecipEstimateX86(value);
+      else if constexpr (op == kRsqrtEstimateX86)
+        dst[i + j] = RsqrtEstimateX86(value);
+      else
+        dst[i + j] = RecipExponentArm(value);
+    }
+  }
+}
+
+template <typename FT>
+void Estimator::Batch(Operation op, FT* dst, const FT* a, std::size_t n) {
+  switch (op) {
+  case kRecipEstimateRiscv:
+    return Batch<FT, kRecipEstimateRiscv>(dst, a, n);
+  case kRsqrtEstimateRiscv:
+    return Batch<FT, kRsqrtEstimateRiscv>(dst, a, n);
+  case kRecipEstimateArm:
+    return Batch<FT, kRecipEstimateArm>(dst, a, n);
+  case kRsqrtEstimateArm:
+    return Batch<FT, kRsqrtEstimateArm>(dst, a, n);
+  case kRecipExponentArm:
+    return Batch<FT, kRecipExponentArm>(dst, a, n);
+  case kRecipEstimateX86:
+    if constexpr (!std::is_same_v<FT, f16>)
+      return Batch<FT, kRecipEstimateX86>(dst, a, n);
+    [[fallthrough]];
+  case kRsqrtEstimateX86:
+    if constexpr (!std::is_same_v<FT, f16>)
+      return Batch<FT, kRsqrtEstimateX86>(dst, a, n);
+    [[fallthrough]];
+  default:
+    throw std::runtime_error(std::string("Unknown estimate operation"));
+  }
+}
+
+template void Estimator::Batch<f16>(Operation op, f16* dst, const f16* a, std::size_t n);
+template void Estimator::Batch<f32>(Operation op, f32* dst, const f32* a, std::size_t n);
+template void Estimator::Batch<f64>(Operation op, f64* dst, const f64* a, std::size_t n);
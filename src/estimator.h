@@ -0,0 +1,72 @@
+#pragma once
+/**************************************************************************************************
+ * Apache License, Version 2.0
+ * Copyright (c) 2024 chciken/Niko Zurstraßen
+ **************************************************************************************************/
+
+#include <cstddef>
+
+#include "floppy_float.h"
+#include "utils.h"
+
+// Simulates the reciprocal and reciprocal square root estimate instructions whose results are specified bit by bit.
+// RISC-V and Arm define them by lookup tables (RISC-V) or by a reference algorithm (Arm), which are reproduced here
+// as small tables indexed by the leading fraction bits. The estimates are available for f16, f32, and f64.
+// The AVX-512 estimates (VRCP14/VRSQRT14) are bit exact as well and are available for f32 and f64. The legacy
+// x86 estimates (RCPSS/RSQRTSS) and PowerPC (fres/frsqrte) only bound the relative error, their results differ
+// between implementations and are not modeled.
+class Estimator : public FloppyFloat {
+ public:
+  Estimator();
+
+  enum Operation {
+    kRecipEstimateRiscv,
+    kRsqrtEstimateRiscv,
+    kRecipEstimateArm,
+    kRsqrtEstimateArm,
+    kRecipExponentArm,
+    kRecipEstimateX86,
+    kRsqrtEstimateX86
+  };
+
+  // See RISC-V "V" extension: "vfrec7" and "vfrsqrt7". Estimates with 7 significant bits. The reciprocal of a small
+  // subnormal overflows according to the dynamic rounding mode.
+  template <typename FT>
+  FT RecipEstimateRiscv(FT a);
+  template <typename FT>
+  FT RsqrtEstimateRiscv(FT a);
+
+  // See Arm A64: "FRECPE", "FRSQRTE", and "FRECPX". Estimates with 8 significant bits. Subnormal operands are flushed
+  // with flush_inputs (FPCR.FZ/FZ16 raise IDC), subnormal reciprocals with flush_outputs (raising only underflow).
+  template <typename FT>
+  FT RecipEstimateArm(FT a);
+  template <typename FT>
+  FT RsqrtEstimateArm(FT a);
+  template <typename FT>
+  FT RecipExponentArm(FT a);
+
+  // See Intel SDM: "VRCP14SS" and "VRSQRT14SS". Estimates with a relative error below 2^-14 and 16 fraction bits,
+  // which are exact for powers of two (VRSQRT14: even powers). The rounding mode is ignored and no flags are raised,
+  // but subnormals are flushed with flush_inputs (MXCSR.DAZ) and flush_outputs (MXCSR.FTZ). Only f32 and f64.
+  template <typename FT>
+  FT RecipEstimateX86(FT a);
+  template <typename FT>
+  FT RsqrtEstimateX86(FT a);
+
+  // Applies an operation to whole arrays. Blocks of normal operands with normal results are computed by a branchless
+  // kernel, all others by the scalar functions. The flags accumulate over all n elements. dst may alias a. The x86
+  // operations throw for f16.
+  template <typename FT>
+  void Batch(Operation op, FT* dst, const FT* a, std::size_t n);
+
+ protected:
+  template <typename FT>
+  FT DefaultNan();
+  template <typename FT>
+  FT PropagateNan(FT a);
+  template <typename FT>
+  FT OverflowResult(bool sign);
+
+  template <typename FT, Operation op>
+  void Batch(FT* dst, const FT* a, std::size_t n);
+};
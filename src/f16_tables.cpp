@@ -0,0 +1,308 @@
+/**************************************************************************************************
+ * Apache License, Version 2.0
+ * Copyright (c) 2024 chciken/Niko Zurstraßen
+ **************************************************************************************************/
+
+#include "f16_tables.h"
+
+#include <bit>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "narrow_float.h"
+
+using namespace FfUtils;
+
+namespace {
+
+constexpr u32 kNumRoundingModes = 5;
+constexpr u32 kTableSize = 1u << 16;
+
+// Image layout: A header followed by the tables, each with one u32 entry per f16 encoding. Sqrt entries hold the
+// result in bits 0-15, integer entries the (17-bit) result sign-extended from bit 23. The exception flags are in bits
+// 24-28 (see kNarrowFlagInvalid etc. shifted by 16), bit 31 marks results that are forwarded to FloppyFloat.
+constexpr u32 kSqrt = 0;  // One table per rounding mode.
+constexpr u32 kToInt = kSqrt + kNumRoundingModes;
+constexpr u32 kToF32 = kToInt + kNumRoundingModes;
+constexpr u32 kClass = kToF32 + 1;
+constexpr u32 kNumTables = kClass + 1;
+
+constexpr u32 kForward = 1u << 31;
+constexpr u32 kFlagShift = 16;
+constexpr u32 kHeaderSize = 4;  // In u32 words.
+constexpr u32 kMagic = 0x46313654;  // "F16T"
+constexpr u32 kVersion = 1;
+constexpr std::size_t kImageSize = (kHeaderSize + kNumTables * kTableSize) * sizeof(u32);
+
+std::once_flag image_once;
+const u32* image = nullptr;
+
+u32 FlagBits(const Vfpu& fpu) {
+  const u32 flags = (fpu.invalid ? kNarrowFlagInvalid : 0) | (fpu.division_by_zero ? kNarrowFlagDivisionByZero : 0) |
+                    (fpu.overflow ? kNarrowFlagOverflow : 0) | (fpu.underflow ? kNarrowFlagUnderflow : 0) |
+                    (fpu.inexact ? kNarrowFlagInexact : 0);
+  return flags << kFlagShift;
+}
+
+template <Vfpu::RoundingMode rm>
+void GenerateRoundingTables(FloppyFloat& fpu, u32* tables) {
+  u32* sqrt_table = tables + (kSqrt + static_cast<u32>(rm)) * kTableSize;
+  u32* int_table = tables + (kToInt + static_cast<u32>(rm)) * kTableSize;
+  for (u32 i = 0; i < kTableSize; ++i) {
+    const f16 a = std::bit_cast<f16>(static_cast<u16>(i));
+
+    fpu.ClearFlags();
+    const f16 root = fpu.Sqrt<f16, rm>(a);
+    sqrt_table[i] = (fpu.invalid || IsNan(root)) ? kForward : (FlagBits(fpu) | std::bit_cast<u16>(root));
+
+    fpu.ClearFlags();
+    const i64 integer = fpu.F16ToI64<rm>(a);
+    int_table[i] = fpu.invalid ? kForward : (FlagBits(fpu) | (static_cast<u32>(integer) & 0xffffffu));
+  }
+}
+
+std::unique_ptr<u32[]> GenerateImage() {
+  auto result = std::make_unique<u32[]>(kImageSize / sizeof(u32));
+  result[0] = kMagic;
+  result[1] = kVersion;
+  result[2] = kNumTables;
+  result[3] = kTableSize;
+  u32* tables = result.get() + kHeaderSize;
+
+  FloppyFloat fpu;
+  GenerateRoundingTables<Vfpu::kRoundTiesToEven>(fpu, tables);
+  GenerateRoundingTables<Vfpu::kRoundTiesToAway>(fpu, tables);
+  GenerateRoundingTables<Vfpu::kRoundTowardPositive>(fpu, tables);
+  GenerateRoundingTables<Vfpu::kRoundTowardNegative>(fpu, tables);
+  GenerateRoundingTables<Vfpu::kRoundTowardZero>(fpu, tables);
+  for (u32 i = 0; i < kTableSize; ++i) {
+    const f16 a = std::bit_cast<f16>(static_cast<u16>(i));
+    tables[kToF32 * kTableSize + i] = IsNan(a) ? 0 : std::bit_cast<u32>(static_cast<f32>(a));
+    tables[kClass * kTableSize + i] = fpu.Class(a);
+  }
+  return result;
+}
+
+const u32* Image() {
+  std::call_once(image_once, [] { image = GenerateImage().release(); });
+  return image;
+}
+
+constexpr i32 EntryToInt(u32 entry) {
+  return static_cast<i32>(entry << 8) >> 8;
+}
+
+}  // namespace
+
+F16Tables::F16Tables() : FloppyFloat(), image_(Image() + kHeaderSize) {}
+
+bool F16Tables::SaveImage(const std::string& path) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char*>(Image()), kImageSize);
+  return static_cast<bool>(file);
+}
+
+bool F16Tables::MapImage(const std::string& path) {
+#if defined(__unix__) || defined(__APPLE__)
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat st;
+  void* mapped = MAP_FAILED;
+  if (fstat(fd, &st) == 0 && static_cast<std::size_t>(st.st_size) == kImageSize)
+    mapped = mmap(nullptr, kImageSize, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapped == MAP_FAILED)
+    return false;
+
+  const u32* header = static_cast<const u32*>(mapped);
+  bool used = false;
+  if (header[0] == kMagic && header[1] == kVersion && header[2] == kNumTables && header[3] == kTableSize) {
+    std::call_once(image_once, [&] {
+      image = header;
+      used = true;
+    });
+  }
+  if (!used)
+    munmap(mapped, kImageSize);
+  return used;
+#else
+  (void)path;
+  return false;
+#endif
+}
+
+u32 F16Tables::Lookup(u32 table, f16 a) {
+  return image_[table * kTableSize + std::bit_cast<u16>(a)];
+}
+
+// Unsigned conversions of negative results are invalid.
+template <typename IT>
+bool F16Tables::IsForwarded(u32 entry) {
+  if constexpr (std::is_signed_v<IT>)
+    return entry & kForward;
+  else
+    return (entry & kForward) || EntryToInt(entry) < 0;
+}
+
+template <typename FT, Vfpu::RoundingMode rm, bool quiet, bool flush>
+FT F16Tables::Sqrt(FT a) {
+  if constexpr (std::is_same_v<FT, f16>) {
+    const u32 entry = Lookup(kSqrt + rm, a);
+    if ((entry & kForward) || (flush && ChecksDenormals<f16>() && IsSubnormal(a))) [[unlikely]]
+      return FloppyFloat::Sqrt<FT, rm, quiet, flush>(a);
+    if constexpr (!quiet)
+      RaiseNarrowFlags(*this, entry >> kFlagShift);
+    return std::bit_cast<f16>(static_cast<u16>(entry));
+  } else {
+    return FloppyFloat::Sqrt<FT, rm, quiet, flush>(a);
+  }
+}
+
+template f16 F16Tables::Sqrt<f16, F16Tables::kRoundTiesToEven>(f16 a);
+template f16 F16Tables::Sqrt<f16, F16Tables::kRoundTowardPositive>(f16 a);
+template f16 F16Tables::Sqrt<f16, F16Tables::kRoundTowardNegative>(f16 a);
+template f16 F16Tables::Sqrt<f16, F16Tables::kRoundTowardZero>(f16 a);
+template f16 F16Tables::Sqrt<f16, F16Tables::kRoundTiesToAway>(f16 a);
+template f32 F16Tables::Sqrt<f32, F16Tables::kRoundTiesToEven>(f32 a);
+template f32 F16Tables::Sqrt<f32, F16Tables::kRoundTowardPositive>(f32 a);
+template f32 F16Tables::Sqrt<f32, F16Tables::kRoundTowardNegative>(f32 a);
+template f32 F16Tables::Sqrt<f32, F16Tables::kRoundTowardZero>(f32 a);
+template f32 F16Tables::Sqrt<f32, F16Tables::kRoundTiesToAway>(f32 a);
+template f64 F16Tables::Sqrt<f64, F16Tables::kRoundTiesToEven>(f64 a);
+template f64 F16Tables::Sqrt<f64, F16Tables::kRoundTowardPositive>(f64 a);
+template f64 F16Tables::Sqrt<f64, F16Tables::kRoundTowardNegative>(f64 a);
+template f64 F16Tables::Sqrt<f64, F16Tables::kRoundTowardZero>(f64 a);
+template f64 F16Tables::Sqrt<f64, F16Tables::kRoundTiesToAway>(f64 a);
+
+template f16 F16Tables::Sqrt<f16, F16Tables::kRoundTiesToEven, true>(f16 a);
+template f16 F16Tables::Sqrt<f16, F16Tables::kRoundTowardPositive, true>(f16 a);
+template f16 F16Tables::Sqrt<f16, F16Tables::kRoundTowardNegative, true>(f16 a);
+template f16 F16Tables::Sqrt<f16, F16Tables::kRoundTowardZero, true>(f16 a);
+template f16 F16Tables::Sqrt<f16, F16Tables::kRoundTiesToAway, true>(f16 a);
+template f32 F16Tables::Sqrt<f32, F16Tables::kRoundTiesToEven, true>(f32 a);
+template f32 F16Tables::Sqrt<f32, F16Tables::kRoundTowardPositive, true>(f32 a);
+template f32 F16Tables::Sqrt<f32, F16Tables::kRoundTowardNegative, true>(f32 a);
+template f32 F16Tables::Sqrt<f32, F16Tables::kRoundTowardZero, true>(f32 a);
+template f32 F16Tables::Sqrt<f32, F16Tables::kRoundTiesToAway, true>(f32 a);
+template f64 F16Tables::Sqrt<f64, F16Tables::kRoundTiesToEven, true>(f64 a);
+template f64 F16Tables::Sqrt<f64, F16Tables::kRoundTowardPositive, true>(f64 a);
+template f64 F16Tables::Sqrt<f64, F16Tables::kRoundTowardNegative, true>(f64 a);
+template f64 F16Tables::Sqrt<f64, F16Tables::kRoundTowardZero, true>(f64 a);
+template f64 F16Tables::Sqrt<f64, F16Tables::kRoundTiesToAway, true>(f64 a);
+
+template f16 F16Tables::Sqrt<f16, F16Tables::kRoundTiesToEven, false, true>(f16 a);
+template f16 F16Tables::Sqrt<f16, F16Tables::kRoundTowardPositive, false, true>(f16 a);
+template f16 F16Tables::Sqrt<f16, F16Tables::kRoundTowardNegative, false, true>(f16 a);
+template f16 F16Tables::Sqrt<f16, F16Tables::kRoundTowardZero, false, true>(f16 a);
+template f16 F16Tables::Sqrt<f16, F16Tables::kRoundTiesToAway, false, true>(f16 a);
+template f32 F16Tables::Sqrt<f32, F16Tables::kRoundTiesToEven, false, true>(f32 a);
+template f32 F16Tables::Sqrt<f32, F16Tables::kRoundTowardPositive, false, true>(f32 a);
+template f32 F16Tables::Sqrt<f32, F16Tables::kRoundTowardNegative, false, true>(f32 a);
+template f32 F16Tables::Sqrt<f32, F16Tables::kRoundTowardZero, false, true>(f32 a);
+template f32 F16Tables::Sqrt<f32, F16Tables::kRoundTiesToAway, false, true>(f32 a);
+template f64 F16Tables::Sqrt<f64, F16Tables::kRoundTiesToEven, false, true>(f64 a);
+template f64 F16Tables::Sqrt<f64, F16Tables::kRoundTowardPositive, false, true>(f64 a);
+template f64 F16Tables::Sqrt<f64, F16Tables::kRoundTowardNegative, false, true>(f64 a);
+template f64 F16Tables::Sqrt<f64, F16Tables::kRoundTowardZero, false, true>(f64 a);
+template f64 F16Tables::Sqrt<f64, F16Tables::kRoundTiesToAway, false, true>(f64 a);
+
+template f16 F16Tables::Sqrt<f16, F16Tables::kRoundTiesToEven, true, true>(f16 a);
+template f16 F16Tables::Sqrt<f16, F16Tables::kRoundTowardPositive, true, true>(f16 a);
+template f16 F16Tables::Sqrt<f16, F16Tables::kRoundTowardNegative, true, true>(f16 a);
+template f16 F16Tables::Sqrt<f16, F16Tables::kRoundTowardZero, true, true>(f16 a);
+template f16 F16Tables::Sqrt<f16, F16Tables::kRoundTiesToAway, true, true>(f16 a);
+template f32 F16Tables::Sqrt<f32, F16Tables::kRoundTiesToEven, true, true>(f32 a);
+template f32 F16Tables::Sqrt<f32, F16Tables::kRoundTowardPositive, true, true>(f32 a);
+template f32 F16Tables::Sqrt<f32, F16Tables::kRoundTowardNegative, true, true>(f32 a);
+template f32 F16Tables::Sqrt<f32, F16Tables::kRoundTowardZero, true, true>(f32 a);
+template f32 F16Tables::Sqrt<f32, F16Tables::kRoundTiesToAway, true, true>(f32 a);
+template f64 F16Tables::Sqrt<f64, F16Tables::kRoundTiesToEven, true, true>(f64 a);
+template f64 F16Tables::Sqrt<f64, F16Tables::kRoundTowardPositive, true, true>(f64 a);
+template f64 F16Tables::Sqrt<f64, F16Tables::kRoundTowardNegative, true, true>(f64 a);
+template f64 F16Tables::Sqrt<f64, F16Tables::kRoundTowardZero, true, true>(f64 a);
+template f64 F16Tables::Sqrt<f64, F16Tables::kRoundTiesToAway, true, true>(f64 a);
+
+template <typename FT>
+FT F16Tables::Sqrt(FT a) {
+  if constexpr (std::is_same_v<FT, f16>) {
+    const u32 entry = Lookup(kSqrt + rounding_mode, a);
+    if ((entry & kForward) || (ChecksDenormals<f16>() && IsSubnormal(a))) [[unlikely]]
+      return FloppyFloat::Sqrt<FT>(a);
+    RaiseNarrowFlags(*this, entry >> kFlagShift);
+    return std::bit_cast<f16>(static_cast<u16>(entry));
+  } else {
+    return FloppyFloat::Sqrt<FT>(a);
+  }
+}
+
+template f16 F16Tables::Sqrt<f16>(f16 a);
+template f32 F16Tables::Sqrt<f32>(f32 a);
+template f64 F16Tables::Sqrt<f64>(f64 a);
+
+template <typename FT>
+u32 F16Tables::Class(FT a) {
+  if constexpr (std::is_same_v<FT, f16>)
+    return Lookup(kClass, a);
+  else
+    return FloppyFloat::Class<FT>(a);
+}
+
+template u32 F16Tables::Class<f16>(f16 a);
+template u32 F16Tables::Class<f32>(f32 a);
+template u32 F16Tables::Class<f64>(f64 a);
+
+f32 F16Tables::F16ToF32(f16 a) {
+  if (IsNan(a)) [[unlikely]]
+    return FloppyFloat::F16ToF32(a);
+  return std::bit_cast<f32>(Lookup(kToF32, a));
+}
+
+f64 F16Tables::F16ToF64(f16 a) {
+  if (IsNan(a)) [[unlikely]]
+    return FloppyFloat::F16ToF64(a);
+  return static_cast<f64>(std::bit_cast<f32>(Lookup(kToF32, a)));  // Exact.
+}
+
+#define F16_TABLES_TO_INT(name, IT)                                                        \
+  template <Vfpu::RoundingMode rm, bool quiet>                                             \
+  IT F16Tables::name(f16 a) {                                                              \
+    const u32 entry = Lookup(kToInt + rm, a);                                              \
+    if (IsForwarded<IT>(entry)) [[unlikely]]                                               \
+      return FloppyFloat::name<rm, quiet>(a);                                              \
+    if constexpr (!quiet)                                                                  \
+      RaiseNarrowFlags(*this, entry >> kFlagShift);                                        \
+    return static_cast<IT>(EntryToInt(entry));                                             \
+  }                                                                                        \
+                                                                                           \
+  IT F16Tables::name(f16 a) {                                                              \
+    const u32 entry = Lookup(kToInt + rounding_mode, a);                                   \
+    if (IsForwarded<IT>(entry) || (ChecksDenormals<f16>() && IsSubnormal(a))) [[unlikely]] \
+      return FloppyFloat::name(a);                                                         \
+    RaiseNarrowFlags(*this, entry >> kFlagShift);                                          \
+    return static_cast<IT>(EntryToInt(entry));                                             \
+  }                                                                                        \
+                                                                                           \
+  template IT F16Tables::name<F16Tables::kRoundTiesToEven>(f16 a);                         \
+  template IT F16Tables::name<F16Tables::kRoundTowardPositive>(f16 a);                     \
+  template IT F16Tables::name<F16Tables::kRoundTowardNegative>(f16 a);                     \
+  template IT F16Tables::name<F16Tables::kRoundTowardZero>(f16 a);                         \
+  template IT F16Tables::name<F16Tables::kRoundTiesToAway>(f16 a);                         \
+  template IT F16Tables::name<F16Tables::kRoundTiesToEven, true>(f16 a);                   \
+  template IT F16Tables::name<F16Tables::kRoundTowardPositive, true>(f16 a);               \
+  template IT F16Tables::name<F16Tables::kRoundTowardNegative, true>(f16 a);               \
+  template IT F16Tables::name<F16Tables::kRoundTowardZero, true>(f16 a);                   \
+  template IT F16Tables::name<F16Tables::kRoundTiesToAway, true>(f16 a);
+
+F16_TABLES_TO_INT(F16ToI32, i32)
+F16_TABLES_TO_INT(F16ToI64, i64)
+F16_TABLES_TO_INT(F16ToU32, u32)
+F16_TABLES_TO_INT(F16ToU64, u64)
@@ -0,0 +1,62 @@
+#pragma once
+/**************************************************************************************************
+ * Apache License, Version 2.0
+ * Copyright (c) 2024 chciken/Niko Zurstraßen
+ **************************************************************************************************/
+
+#include <string>
+
+#include "floppy_float.h"
+#include "utils.h"
+
+// Serves the unary f16 operations from exhaustive tables: With only 65536 inputs, every result of Sqrt, Class, and
+// the conversions to f32, f64, and the integer types is precomputed per rounding mode, so that an operation becomes a
+// single load. The tables do not depend on the configuration of an instance. Inputs whose result does (NaNs and
+// invalid operations) are marked and forwarded to FloppyFloat, and so are subnormals whenever FloppyFloat would flush
+// them or report DE for them. All other operations behave like FloppyFloat.
+class F16Tables : public FloppyFloat {
+ public:
+  // The tables are generated on construction of the first instance unless an image was mapped before.
+  F16Tables();
+
+  // quiet and flush are as for FloppyFloat::Sqrt.
+  template <typename FT, RoundingMode rm, bool quiet = false, bool flush = false>
+  FT Sqrt(FT a);
+  template <typename FT>
+  FT Sqrt(FT a);
+
+  template <typename FT>
+  FfUtils::u32 Class(FT a);
+
+  FfUtils::f32 F16ToF32(FfUtils::f16 a);
+  FfUtils::f64 F16ToF64(FfUtils::f16 a);
+
+  template <RoundingMode rm, bool quiet = false>
+  FfUtils::i32 F16ToI32(FfUtils::f16 a);
+  FfUtils::i32 F16ToI32(FfUtils::f16 a);
+
+  template <RoundingMode rm, bool quiet = false>
+  FfUtils::i64 F16ToI64(FfUtils::f16 a);
+  FfUtils::i64 F16ToI64(FfUtils::f16 a);
+
+  template <RoundingMode rm, bool quiet = false>
+  FfUtils::u32 F16ToU32(FfUtils::f16 a);
+  FfUtils::u32 F16ToU32(FfUtils::f16 a);
+
+  template <RoundingMode rm, bool quiet = false>
+  FfUtils::u64 F16ToU64(FfUtils::f16 a);
+  FfUtils::u64 F16ToU64(FfUtils::f16 a);
+
+  // Writes the table image (about 3 MiB) to path.
+  static bool SaveImage(const std::string& path);
+  // Maps an image written by SaveImage read-only, so that all simulator processes share the same physical pages.
+  // Only takes effect before the first instance is constructed. Returns false if the image is not used.
+  static bool MapImage(const std::string& path);
+
+ protected:
+  const FfUtils::u32* image_;
+
+  FfUtils::u32 Lookup(FfUtils::u32 table, FfUtils::f16 a);
+  template <typename IT>
+  bool IsForwarded(FfUtils::u32 entry);
+};
@@ -5,10 +5,12 @@
 
 #include "floppy_float.h"
 
+#include <algorithm>
 #include <bit>
 #include <bitset>
 #include <cassert>
 #include <cmath>
+#include <cstring>
 #include <stdexcept>
 
 using namespace FfUtils;
@@ -50,8 +52,7 @@ constexpr auto FloppyFloat::UpMul(FT a, FT b, FT& c) {
       r = UpMulFma<FT>(a, b, c);
     } else {
       r = 0.f64;
-      RmGuard rg(this, rm);
-      c = SoftFloat::Mul(a, b);
+      c = SoftFloat::Mul<FT, rm>(a, b);
     }
     return r;
   } else {
@@ -77,8 +78,7 @@ constexpr auto FloppyFloat::UpDiv(FT a, FT b, FT& c) {
       r = UpDivFma<FT>(a, b, c);
     } else {
       r = 0.f64;
-      RmGuard rg(this, rm);
-      c = SoftFloat::Div(a, b);
+      c = SoftFloat::Div<FT, rm>(a, b);
     }
     return r;
   } else {
@@ -104,8 +104,7 @@ constexpr auto FloppyFloat::UpSqrt(FT a, FT& b) {
       r = UpSqrtFma<FT>(a, b);
     } else {
       r = 0.f64;
-      RmGuard rg(this, rm);
-      b = SoftFloat::Sqrt(a);
+      b = SoftFloat::Sqrt<FT, rm>(a);
     }
     return r;
   } else {
@@ -119,8 +118,7 @@ constexpr auto FloppyFloat::UpSqrt(FT a, FT& b) {
 template <typename FT, FloppyFloat::RoundingMode rm>
 constexpr auto FloppyFloat::UpFma(FT a, FT b, FT c, FT& d) {
   if constexpr (std::is_same_v<FT, f64>) {
-    RmGuard rg(this, rm);
-    d = SoftFloat::Fma(a, b, c);
+    d = SoftFloat::Fma<FT, rm>(a, b, c);
     return 0.f64;
   } else {
     auto da = static_cast<TwiceWidthType<FT>::type>(a);
@@ -140,6 +138,11 @@ void FloppyFloat::SetQnan<f16>(u16 val) {
   qnan16_ = std::bit_cast<f16>(val);
 }
 
+template <>
+void FloppyFloat::SetQnan<bf16>(u16 val) {
+  qnanbf16_ = std::bit_cast<bf16>(val);
+}
+
 template <>
 void FloppyFloat::SetQnan<f32>(u32 val) {
   qnan32_ = std::bit_cast<f32>(val);
@@ -150,11 +153,21 @@ void FloppyFloat::SetQnan<f64>(u64 val) {
   qnan64_ = std::bit_cast<f64>(val);
 }
 
+template <>
+void FloppyFloat::SetQnan<f128>(u128 val) {
+  qnan128_ = std::bit_cast<f128>(val);
+}
+
 template <>
 constexpr f16 FloppyFloat::GetQnan<f16>() {
   return qnan16_;
 }
 
+template <>
+constexpr bf16 FloppyFloat::GetQnan<bf16>() {
+  return qnanbf16_;
+}
+
 template <>
 constexpr f32 FloppyFloat::GetQnan<f32>() {
   return qnan32_;
@@ -165,10 +178,17 @@ constexpr f64 FloppyFloat::GetQnan<f64>() {
   return qnan64_;
 }
 
+template <>
+constexpr f128 FloppyFloat::GetQnan<f128>() {
+  return qnan128_;
+}
+
 FloppyFloat::FloppyFloat() : SoftFloat() {
   SetQnan<f16>(0x7e00u);
+  SetQnan<bf16>(0x7fc0u);
   SetQnan<f32>(0x7fc00000u);
   SetQnan<f64>(0x7ff8000000000000ull);
+  SetQnan<f128>(static_cast<u128>(0x7fff800000000000ull) << 64);
   ClearFlags();
   tininess_before_rounding = false;
 }
@@ -223,7 +243,8 @@ constexpr TTO FloppyFloat::PropagateNan(TFROM a) {
   static_assert(std::is_floating_point_v<TFROM>);
   static_assert(std::is_floating_point_v<TTO>);
   using UTTO = FloatToUint<TTO>::type;
-  if (nan_propagation_scheme == kNanPropX86sse) {
+  // x86 and Arm with FPCR.DN = 0 keep the sign and the upper bits of the payload (see FPConvertNaN).
+  if (nan_propagation_scheme == kNanPropX86sse || nan_propagation_scheme == kNanPropArm64) {
     UTTO payload;
     if constexpr (NumBits<TTO>() > NumBits<TFROM>()) {
       payload = static_cast<UTTO>(GetPayload(a)) << (NumSignificandBits<TTO>() - NumSignificandBits<TFROM>());
@@ -254,6 +275,10 @@ constexpr FT FloppyFloat::PropagateNan(FT a, FT b) {
   case kNanPropArm64DefaultNan:
     result = GetQnan<FT>();
     break;
+  case kNanPropArm64:
+    // The first signaling NaN, otherwise the first NaN (see FPProcessNaNs).
+    result = SetQuietBit((IsSnan(a) || (IsNan(a) && !IsSnan(b))) ? a : b);
+    break;
   default:
     throw std::runtime_error(std::string("Unknown NaN propagation scheme"));
   }
@@ -275,6 +300,11 @@ constexpr FT FloppyFloat::PropagateNan(FT a, FT b, FT c) {
   case kNanPropArm64DefaultNan:
     result = GetQnan<FT>();
     break;
+  case kNanPropArm64:
+    // The addend c comes first (see FPMulAdd and FPProcessNaNs3). A quiet NaN addend of ∞ × 0 yields the default NaN.
+    result = (IsSnan(c) || (IsNan(c) && !IsSnan(a) && !IsSnan(b))) ? SetQuietBit(c) : PropagateNan<FT>(a, b);
+    result = (IsQnan(c) && ((IsInf(a) && IsZero(b)) || (IsZero(a) && IsInf(b)))) ? GetQnan<FT>() : result;
+    break;
   default:
     throw std::runtime_error(std::string("Unknown NaN propagation scheme"));
   }
@@ -286,6 +316,8 @@ FT GetRScaled(FT r) {
   FT r_scaled;
   if constexpr (std::is_same_v<FT, f16>) {
     r_scaled = r * 2048.0f16;  // = 2**11
+  } else if constexpr (std::is_same_v<FT, bf16>) {
+    r_scaled = r * 256.0bf16;  // = 2**8
   } else if constexpr (std::is_same_v<FT, f32>) {
     r_scaled = r * 16777216.0f32;  // 2**24
   } else if constexpr (std::is_same_v<FT, f64>) {
@@ -300,6 +332,8 @@ template <typename FT>
 constexpr FT ResidualLimit() {
   if constexpr (std::is_same_v<FT, f16>) {
     return 32.f16;  // 2**5
+  } else if constexpr (std::is_same_v<FT, bf16>) {
+    return 1329227995784915872903807060280344576.bf16;  // 2**120
   } else if constexpr (std::is_same_v<FT, f32>) {
     return 20282409603651670423947251286016.f32;  // 2**104
   } else if constexpr (std::is_same_v<FT, f64>) {
@@ -334,89 +368,539 @@ constexpr bool IsOverflow(FT a, FT b, FT c) {
   }
 }
 
+// bf16 is the upper half of an f32, so widening it is a plain shift that also preserves signaling NaNs.
+constexpr f32 WidenBF16(bf16 a) {
+  return std::bit_cast<f32>(static_cast<u32>(std::bit_cast<u16>(a)) << 16);
+}
+
+// With hardware f16 conversions, f16 ties-to-even sums stay on the native path, which skips the residual once
+// inexact is sticky. Without them, every native f16 operation is emulated and the f64 path is faster.
+#if defined(__F16C__) || defined(__ARM_FEATURE_FP16_SCALAR_ARITHMETIC)
+constexpr bool kNativeF16Sums = true;
+#else
+constexpr bool kNativeF16Sums = false;
+#endif
+
+// f16 -> f32 -> f64 maps to hardware conversions wherever f32 <-> f16 is supported natively.
+template <typename FT>
+constexpr f64 WidenToF64(FT a) {
+  if constexpr (std::is_same_v<FT, f16>) {
+    return static_cast<f64>(static_cast<f32>(a));
+  } else if constexpr (std::is_same_v<FT, bf16>) {
+    return static_cast<f64>(WidenBF16(a));
+  } else {
+    static_assert(false, "Unsupported data type");
+  }
+}
+
+// Turns the f64 sum c with residual c - exact into its round-to-odd counterpart. Rounding that once more to a format
+// with at least two significand bits less yields the same result and flags as rounding the exact sum directly.
+constexpr f64 RoundToOdd(f64 c, f64 residual) {
+  u64 uc = std::bit_cast<u64>(c);
+  if (residual != 0. && !(uc & 1ull)) {
+    // Move the magnitude toward the exact value.
+    if (std::signbit(residual) == std::signbit(c))
+      uc -= 1ull;
+    else
+      uc += 1ull;
+  }
+  return std::bit_cast<f64>(uc);
+}
+
+template <FloppyFloat::RoundingMode rm, typename UT>
+constexpr UT RshiftRound(bool sign, UT mant, i32 shift) {
+  const UT mask = (static_cast<UT>(1) << shift) - 1;
+  const UT half = static_cast<UT>(1) << (shift - 1);
+  UT addend;
+  if constexpr (rm == FloppyFloat::kRoundTiesToEven || rm == FloppyFloat::kRoundTiesToAway) {
+    addend = half;
+  } else if constexpr (rm == FloppyFloat::kRoundTowardZero) {
+    addend = 0;
+  } else if constexpr (rm == FloppyFloat::kRoundTowardNegative) {
+    addend = sign ? mask : 0;
+  } else if constexpr (rm == FloppyFloat::kRoundTowardPositive) {
+    addend = !sign ? mask : 0;
+  } else {
+    static_assert(false, "Using unsupported rounding mode");
+  }
+  UT result = (mant + addend) >> shift;
+  if constexpr (rm == FloppyFloat::kRoundTiesToEven) {
+    if ((mant & mask) == half)
+      result &= ~static_cast<UT>(1);
+  }
+  return result;
+}
+
+// Rounds the f64 result of an f16 or bf16 operation to FT with integer arithmetic only.
+// Sums and differences of f16 values and products of f16 or bf16 values are exact in f64; inexact bf16 sums and
+// differences are passed in rounded to odd. Quotients and square roots are correctly rounded and can never lie
+// within an f64 ulp of an FT rounding boundary, so the f64 bits alone determine result and flags.
+template <typename FT, FloppyFloat::RoundingMode rm>
+constexpr FT FloppyFloat::RoundF64(f64 a) {
+  constexpr i32 kShift = NumSignificandBits<f64>() - NumSignificandBits<FT>();
+  constexpr i32 kMinNormalExp = Bias<f64>() - Bias<FT>() + 1;
+  constexpr u32 kInf = static_cast<u32>(MaxExponent<FT>()) << NumSignificandBits<FT>();
+
+  const u64 ua = std::bit_cast<u64>(a);
+  const bool sign = ua >> (NumBits<f64>() - 1);
+  const i32 exp = static_cast<i32>((ua >> NumSignificandBits<f64>()) & MaxExponent<f64>());
+  if (exp == 0)  // Zero; f16 and bf16 operands cannot produce f64 subnormals.
+    return sign ? -static_cast<FT>(0.) : static_cast<FT>(0.);
+
+  const u64 mant = (ua & ((1ull << NumSignificandBits<f64>()) - 1ull)) | (1ull << NumSignificandBits<f64>());
+  u32 result;
+  bool rnd_bits;
+  if (exp >= kMinNormalExp) [[likely]] {
+    // The rounded significand carries into the exponent field just like in SoftFloat's RoundPack.
+    rnd_bits = mant & ((1ull << kShift) - 1ull);
+    result = static_cast<u32>(RshiftRound<rm>(sign, mant, kShift));
+    result += static_cast<u32>(exp - kMinNormalExp) << NumSignificandBits<FT>();
+  } else {
+    const i32 shift = std::min(kMinNormalExp + kShift - exp, NumSignificandBits<f64>() + 2);
+    rnd_bits = mant & ((1ull << shift) - 1ull);
+    result = static_cast<u32>(RshiftRound<rm>(sign, mant, shift));
+    // Tininess after rounding is decided by rounding with an unbounded exponent range.
+    if (rnd_bits && (tininess_before_rounding || exp < kMinNormalExp - 1 ||
+                     RshiftRound<rm>(sign, mant, kShift) < (2ull << NumSignificandBits<FT>())))
+      underflow = true;
+  }
+
+  if (rnd_bits)
+    inexact = true;
+
+  if (result >= kInf) [[unlikely]] {
+    overflow = true;
+    inexact = true;
+    return RoundInf<FT, rm>(sign ? -nl<FT>::infinity() : nl<FT>::infinity());
+  }
+
+  return std::bit_cast<FT>(static_cast<u16>(result | (static_cast<u32>(sign) << (NumBits<FT>() - 1))));
+}
+
+// Infinite f64 results of f16 and bf16 operations are exact since finite operands cannot overflow f64.
+template <typename FT>
+constexpr FT FloppyFloat::InfOrNanF64(f64 c, FT a, FT b) {
+  if (IsInf(c))
+    return static_cast<FT>(c);
+  if (IsSnan(a) || IsSnan(b))
+    invalid = true;
+  if (IsNan(a) || IsNan(b))
+    return PropagateNan<FT>(a, b);
+  invalid = true;
+  return GetQnan<FT>();
+}
+
+// Right shift that ORs all shifted-out bits into the lsb.
+constexpr u128 RshiftSticky(u128 a, i32 shift) {
+  if (shift == 0)
+    return a;
+  if (shift >= NumBits<u128>())
+    return a != 0;
+  return (a >> shift) | ((a << (NumBits<u128>() - shift)) != 0);
+}
+
+// RshiftSticky for the 256-bit value hi:lo.
+constexpr void RshiftSticky256(u128& hi, u128& lo, i32 shift) {
+  if (shift == 0)
+    return;
+  if (shift >= NumBits<u128>()) {
+    lo = RshiftSticky(hi, shift - NumBits<u128>()) | (lo != 0);
+    hi = 0;
+    return;
+  }
+  lo = (lo >> shift) | (hi << (NumBits<u128>() - shift)) | ((lo << (NumBits<u128>() - shift)) != 0);
+  hi >>= shift;
+}
+
+constexpr void Lshift256(u128& hi, u128& lo, i32 shift) {
+  if (shift == 0)
+    return;
+  if (shift >= NumBits<u128>()) {
+    hi = lo << (shift - NumBits<u128>());
+    lo = 0;
+    return;
+  }
+  hi = (hi << shift) | (lo >> (NumBits<u128>() - shift));
+  lo <<= shift;
+}
+
+// Rounds a significand with the hidden bit at position 126 and packs it. The caller guarantees a normal result that
+// cannot overflow, i.e., 0 < exp < MaxExponent - 1. A carry out of the significand increments the exponent.
+template <FloppyFloat::RoundingMode rm>
+constexpr f128 RoundPackF128(bool sign, i32 exp, u128 mant) {
+  u128 result = static_cast<u128>(sign) << (NumBits<f128>() - 1);
+  result += static_cast<u128>(exp - 1) << NumSignificandBits<f128>();
+  result += RshiftRound<rm>(sign, mant, NumRoundBits<f128>());
+  return std::bit_cast<f128>(result);
+}
+
+// Divides nh:nl by d with Knuth's algorithm D on 64-bit digits, so each quotient digit costs one 128-by-64-bit
+// division. With a two-digit divisor the estimate correction is exact. Requires the msb of d to be set and nh < d.
+constexpr u128 DivRem256By128(u128 nh, u128 nl, u128 d, bool& sticky) {
+  const u64 d1 = static_cast<u64>(d >> 64);
+  const u64 d0 = static_cast<u64>(d);
+  u128 r = nh;
+  u128 q = 0;
+  for (const u64 digit : {static_cast<u64>(nl >> 64), static_cast<u64>(nl)}) {
+    u128 qhat = (r >> 64) >= d1 ? ~0ull : r / d1;
+    u128 rhat = r - qhat * d1;
+    while (!(rhat >> 64) && qhat * d0 > ((rhat << 64) | digit)) {
+      qhat--;
+      rhat += d1;
+    }
+    r = ((r << 64) | digit) - qhat * d;  // The true remainder is smaller than d, so the wrap-around is harmless.
+    q = (q << 64) | qhat;
+  }
+  sticky = r != 0;
+  return q;
+}
+
+// The binary128 fast paths operate on the integer significands of normal operands whose results are normal.
+// Everything else (zeros, subnormals, infinities, NaNs, underflow, and overflow) is handed to SoftFloat.
+constexpr bool IsNormalExpF128(i32 exp) {
+  return static_cast<u32>(exp - 1) < static_cast<u32>(MaxExponent<f128>() - 1);
+}
+
+constexpr bool IsSafeResultExpF128(i32 exp) {
+  return exp > 0 && exp < MaxExponent<f128>() - 1;
+}
+
+constexpr u128 ImplicitSignificandF128(u128 u) {
+  constexpr u128 kHidden = static_cast<u128>(1) << NumSignificandBits<f128>();
+  return (u & (kHidden - 1)) | kHidden;
+}
+
+template <FloppyFloat::RoundingMode rm>
+f128 FloppyFloat::AddF128(f128 a, f128 b, bool subtract) {
+  u128 ua = std::bit_cast<u128>(a);
+  u128 ub = std::bit_cast<u128>(b) ^ (static_cast<u128>(subtract) << (NumBits<f128>() - 1));
+  i32 a_exp = GetExponent(a);
+  i32 b_exp = GetExponent(b);
+  if (!IsNormalExpF128(a_exp) || !IsNormalExpF128(b_exp)) [[unlikely]]
+    return subtract ? SoftFloat::Sub<f128, rm>(a, b) : SoftFloat::Add<f128, rm>(a, b);
+
+  if ((ua << 1) < (ub << 1)) {
+    std::swap(ua, ub);
+    std::swap(a_exp, b_exp);
+  }
+
+  const bool sign = ua >> (NumBits<f128>() - 1);
+  const bool b_sign = ub >> (NumBits<f128>() - 1);
+  u128 a_mant = ImplicitSignificandF128(ua) << (NumRoundBits<f128>() - 1);
+  u128 b_mant = RshiftSticky(ImplicitSignificandF128(ub) << (NumRoundBits<f128>() - 1), a_exp - b_exp);
+
+  if (sign == b_sign) {
+    a_mant += b_mant;
+  } else {
+    a_mant -= b_mant;
+    if (a_mant == 0)  // See: IEEE 754-2019: 6.3 The sign bit
+      return rm == kRoundTowardNegative ? -static_cast<f128>(0.) : static_cast<f128>(0.);
+  }
+
+  const i32 shift = std::countl_zero(a_mant) - 1;
+  a_mant <<= shift;
+  const i32 exp = a_exp + 1 - shift;
+  if (!IsSafeResultExpF128(exp)) [[unlikely]]
+    return subtract ? SoftFloat::Sub<f128, rm>(a, b) : SoftFloat::Add<f128, rm>(a, b);
+
+  if (a_mant & RoundMask<f128>())
+    inexact = true;
+  return RoundPackF128<rm>(sign, exp, a_mant);
+}
+
+template <FloppyFloat::RoundingMode rm>
+f128 FloppyFloat::MulF128(f128 a, f128 b) {
+  const u128 ua = std::bit_cast<u128>(a);
+  const u128 ub = std::bit_cast<u128>(b);
+  const i32 a_exp = GetExponent(a);
+  const i32 b_exp = GetExponent(b);
+  if (!IsNormalExpF128(a_exp) || !IsNormalExpF128(b_exp)) [[unlikely]]
+    return SoftFloat::Mul<f128, rm>(a, b);
+
+  const bool sign = (ua ^ ub) >> (NumBits<f128>() - 1);
+  auto [lo, hi] = Umul<u128>(ImplicitSignificandF128(ua) << NumRoundBits<f128>(),
+                             ImplicitSignificandF128(ub) << (NumRoundBits<f128>() + 1));
+  i32 exp = a_exp + b_exp - Bias<f128>() + 1;
+  if (!(hi >> NumImantBits<f128>())) {
+    hi = (hi << 1) | (lo >> (NumBits<u128>() - 1));
+    lo <<= 1;
+    exp--;
+  }
+
+  if (!IsSafeResultExpF128(exp)) [[unlikely]]
+    return SoftFloat::Mul<f128, rm>(a, b);
+
+  const u128 mant = hi | (lo != 0);
+  if (mant & RoundMask<f128>())
+    inexact = true;
+  return RoundPackF128<rm>(sign, exp, mant);
+}
+
+template <FloppyFloat::RoundingMode rm>
+f128 FloppyFloat::DivF128(f128 a, f128 b) {
+  const u128 ua = std::bit_cast<u128>(a);
+  const u128 ub = std::bit_cast<u128>(b);
+  const i32 a_exp = GetExponent(a);
+  const i32 b_exp = GetExponent(b);
+  if (!IsNormalExpF128(a_exp) || !IsNormalExpF128(b_exp)) [[unlikely]]
+    return SoftFloat::Div<f128, rm>(a, b);
+
+  // Quotient of a_mant * 2^126 / b_mant with the divisor normalized to a set msb.
+  constexpr i32 kNorm = NumBits<u128>() - 1 - NumSignificandBits<f128>();
+  const bool sign = (ua ^ ub) >> (NumBits<f128>() - 1);
+  bool sticky;
+  u128 mant = DivRem256By128(ImplicitSignificandF128(ua) << (NumImantBits<f128>() + kNorm - NumBits<u128>()), 0,
+                             ImplicitSignificandF128(ub) << kNorm, sticky);
+  mant |= sticky;
+  const i32 shift = std::countl_zero(mant) - 1;
+  mant <<= shift;
+  const i32 exp = a_exp - b_exp + Bias<f128>() - shift;
+  if (!IsSafeResultExpF128(exp)) [[unlikely]]
+    return SoftFloat::Div<f128, rm>(a, b);
+
+  if (mant & RoundMask<f128>())
+    inexact = true;
+  return RoundPackF128<rm>(sign, exp, mant);
+}
+
+template <FloppyFloat::RoundingMode rm>
+f128 FloppyFloat::SqrtF128(f128 a) {
+  const u128 ua = std::bit_cast<u128>(a);
+  i32 exp = GetExponent(a);
+  if (std::signbit(a) || !IsNormalExpF128(exp)) [[unlikely]]
+    return SoftFloat::Sqrt<f128, rm>(a);
+
+  // The root of n = a_mant * 2^142 (2^143 for odd exponents) has its msb at bit 127.
+  exp -= Bias<f128>();
+  u128 a_mant = ImplicitSignificandF128(ua);
+  if (exp & 1) {
+    exp--;
+    a_mant <<= 1;
+  }
+  const u128 nh = a_mant << (NumBits<u128>() - 2 - NumSignificandBits<f128>());
+
+  // Start above the root with the f64 estimate plus a margin well beyond its error, so that the integer Newton
+  // iterations descend monotonically. Two iterations leave the root at most one too large.
+  constexpr u64 kMargin = 1ull << 16;
+  const f64 estimate = std::sqrt(static_cast<f64>(static_cast<u64>(a_mant >> 50))) * 4294967296.0f64;  // 2**32
+  u64 s_hi = static_cast<u64>(std::min(estimate, 18446744073709549568.0f64));  // Largest f64 below 2**64.
+  s_hi = s_hi > ~0ull - kMargin ? ~0ull : s_hi + kMargin;
+  u128 s = (static_cast<u128>(s_hi) << 64) | ~0ull;
+  bool sticky;
+  for (int i = 0; i < 2; ++i) {
+    const u128 q = DivRem256By128(nh, 0, s, sticky);
+    s = (s >> 1) + (q >> 1) + (s & q & 1);
+  }
+
+  std::pair<u128, u128> sq = Umul<u128>(s, s);
+  if (sq.second > nh || (sq.second == nh && sq.first != 0)) {
+    s--;
+    sq = Umul<u128>(s, s);
+  }
+  sticky = sq.second != nh || sq.first != 0;
+
+  const u128 mant = (s >> 1) | (s & 1) | sticky;
+  exp = (exp >> 1) + Bias<f128>();
+  if (mant & RoundMask<f128>())
+    inexact = true;
+  return RoundPackF128<rm>(false, exp, mant);
+}
+
+template <FloppyFloat::RoundingMode rm>
+f128 FloppyFloat::FmaF128(f128 a, f128 b, f128 c) {
+  const u128 ua = std::bit_cast<u128>(a);
+  const u128 ub = std::bit_cast<u128>(b);
+  const u128 uc = std::bit_cast<u128>(c);
+  const i32 a_exp = GetExponent(a);
+  const i32 b_exp = GetExponent(b);
+  const i32 c_exp = GetExponent(c);
+  if (!IsNormalExpF128(a_exp) || !IsNormalExpF128(b_exp)) [[unlikely]]
+    return SoftFloat::Fma<f128, rm>(a, b, c);
+  if (!IsNormalExpF128(c_exp)) [[unlikely]] {
+    if (!(uc << 1))  // Adding zero to the nonzero product rounds just like the product.
+      return MulF128<rm>(a, b);
+    return SoftFloat::Fma<f128, rm>(a, b, c);
+  }
+
+  // The exact product p_hi:p_lo as in MulF128 and the addend c_hi:c_lo have their msb at bit 126 of the upper half,
+  // which leaves room for the carry of the sum.
+  auto [p_lo, p_hi] = Umul<u128>(ImplicitSignificandF128(ua) << NumRoundBits<f128>(),
+                                 ImplicitSignificandF128(ub) << (NumRoundBits<f128>() + 1));
+  i32 exp = a_exp + b_exp - Bias<f128>() + 1;
+  if (!(p_hi >> NumImantBits<f128>())) {
+    p_hi = (p_hi << 1) | (p_lo >> (NumBits<u128>() - 1));
+    p_lo <<= 1;
+    exp--;
+  }
+  u128 c_hi = ImplicitSignificandF128(uc) << NumRoundBits<f128>();
+  u128 c_lo = 0;
+  if (exp >= c_exp) {
+    RshiftSticky256(c_hi, c_lo, exp - c_exp);
+  } else {
+    RshiftSticky256(p_hi, p_lo, c_exp - exp);
+    exp = c_exp;
+  }
+
+  bool sign = (ua ^ ub) >> (NumBits<f128>() - 1);
+  const bool c_sign = uc >> (NumBits<f128>() - 1);
+  u128 hi, lo;
+  if (sign == c_sign) {
+    lo = p_lo + c_lo;
+    hi = p_hi + c_hi + (lo < p_lo);
+  } else {
+    if (p_hi < c_hi || (p_hi == c_hi && p_lo < c_lo)) {
+      std::swap(p_hi, c_hi);
+      std::swap(p_lo, c_lo);
+      sign = c_sign;
+    }
+    lo = p_lo - c_lo;
+    hi = p_hi - c_hi - (p_lo < c_lo);
+    if (!hi && !lo)  // See: IEEE 754-2019: 6.3 The sign bit
+      return rm == kRoundTowardNegative ? -static_cast<f128>(0.) : static_cast<f128>(0.);
+  }
+
+  // Bits only fall out of the 256-bit window if the exponents are far apart. Then the larger operand dominates, the
+  // cancellation is at most one bit, and the sticky bit stays far below the rounding bits.
+  const i32 shift = (hi ? std::countl_zero(hi) : NumBits<u128>() + std::countl_zero(lo)) - 1;
+  if (shift < 0)
+    RshiftSticky256(hi, lo, 1);
+  else
+    Lshift256(hi, lo, shift);
+  exp -= shift;
+  if (!IsSafeResultExpF128(exp)) [[unlikely]]
+    return SoftFloat::Fma<f128, rm>(a, b, c);
+
+  const u128 mant = hi | (lo != 0);
+  if (mant & RoundMask<f128>())
+    inexact = true;
+  return RoundPackF128<rm>(sign, exp, mant);
+}
+
+// Products and quotients of normal numbers whose exponents put their magnitude below 2^(emin - 1). Their rounded
+// results are below the smallest normal number 2^emin no matter the rounding mode, so they are tiny before and after
+// rounding.
+template <typename FT>
+constexpr bool IsTinyProduct(FT a, FT b) {
+  const i32 ea = static_cast<i32>(GetExponent(a));
+  const i32 eb = static_cast<i32>(GetExponent(b));
+  return ea != 0 && eb != 0 && ea + eb + 1 < Bias<FT>();
+}
+
+template <typename FT>
+constexpr bool IsTinyQuotient(FT a, FT b) {
+  const i32 ea = static_cast<i32>(GetExponent(a));
+  const i32 eb = static_cast<i32>(GetExponent(b));
+  return ea != 0 && eb != MaxExponent<FT>() && ea - eb + Bias<FT>() < 0;
+}
+
 template <typename FT>
 FT FloppyFloat::Add(FT a, FT b) {
   switch (rounding_mode) {
   case kRoundTiesToEven:
-    return Add<FT, kRoundTiesToEven>(a, b);
+    return Add<FT, kRoundTiesToEven, false, true>(a, b);
   case kRoundTiesToAway:
-    return Add<FT, kRoundTiesToAway>(a, b);
+    return Add<FT, kRoundTiesToAway, false, true>(a, b);
   case kRoundTowardPositive:
-    return Add<FT, kRoundTowardPositive>(a, b);
+    return Add<FT, kRoundTowardPositive, false, true>(a, b);
   case kRoundTowardNegative:
-    return Add<FT, kRoundTowardNegative>(a, b);
+    return Add<FT, kRoundTowardNegative, false, true>(a, b);
   case kRoundTowardZero:
-    return Add<FT, kRoundTowardZero>(a, b);
+    return Add<FT, kRoundTowardZero, false, true>(a, b);
   default:
     throw std::runtime_error(std::string("Unknown rounding mode"));
   }
 }
 
 template f16 FloppyFloat::Add<f16>(f16 a, f16 b);
+template bf16 FloppyFloat::Add<bf16>(bf16 a, bf16 b);
 template f32 FloppyFloat::Add<f32>(f32 a, f32 b);
 template f64 FloppyFloat::Add<f64>(f64 a, f64 b);
+template f128 FloppyFloat::Add<f128>(f128 a, f128 b);
 
-template <typename FT, FloppyFloat::RoundingMode rm>
+template <typename FT, FloppyFloat::RoundingMode rm, bool quiet, bool flush>
 FT FloppyFloat::Add(FT a, FT b) {
-  FT c = a + b;
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  if constexpr (flush) {
+    if (ChecksDenormals<FT>(a, b))
+      return FlushDenormals<FT>([this](FT x, FT y) { return Add<FT, rm>(x, y); }, [](FT, FT) { return false; }, a, b);
+  }
+  if constexpr (std::is_same_v<FT, f128>) {
+    return AddF128<rm>(a, b, false);
+  } else if constexpr ((std::is_same_v<FT, f16> && !(kNativeF16Sums && rm == kRoundTiesToEven)) ||
+                       std::is_same_v<FT, bf16>) {
+    const f64 wa = WidenToF64(a);
+    const f64 wb = WidenToF64(b);
+    f64 c = wa + wb;
+    if (IsInfOrNan(c)) [[unlikely]]
+      return InfOrNanF64(c, a, b);
+    if constexpr (std::is_same_v<FT, bf16>)
+      c = RoundToOdd(c, TwoSum(wa, wb, c));
+    if constexpr (rm == kRoundTowardNegative) {
+      if (IsPosZero(c) && (IsNeg(a) || IsNeg(b)))
+        c = -c;
+    }
+    return RoundF64<FT, rm>(c);
+  } else {
+    FT c = a + b;
 
-  if (IsInfOrNan(c)) [[unlikely]] {
-    if (IsInf(c)) {
-      if (!IsInf(a) && !IsInf(b)) {
-        c = RoundInf<FT, rm>(c);
-        overflow = IsOverflow<FT, rm>(a, b, c);
-        inexact = true;
+    if (IsInfOrNan(c)) [[unlikely]] {
+      if (IsInf(c)) {
+        if (!IsInf(a) && !IsInf(b)) {
+          c = RoundInf<FT, rm>(c);
+          overflow = IsOverflow<FT, rm>(a, b, c);
+          inexact = true;
+        }
+        return c;
       }
-      return c;
-    }
-    if (IsInf(a) && IsInf(b)) {
-      invalid = true;
-      return GetQnan<FT>();
+      if (IsInf(a) && IsInf(b)) {
+        invalid = true;
+        return GetQnan<FT>();
+      }
+      if (IsSnan(a) || IsSnan(b))
+        invalid = true;
+      if (IsNan(a) || IsNan(b))
+        return PropagateNan<FT>(a, b);
     }
-    if (IsSnan(a) || IsSnan(b))
-      invalid = true;
-    if (IsNan(a) || IsNan(b))
-      return PropagateNan<FT>(a, b);
-  }
 
-  // See: IEEE 754-2019: 6.3 The sign bit
-  if constexpr (rm == kRoundTowardNegative) {
-    if (IsPosZero(c)) {
-      if (IsNeg(a) || IsNeg(b))
-        c = -c;
+    // See: IEEE 754-2019: 6.3 The sign bit
+    if constexpr (rm == kRoundTowardNegative) {
+      if (IsPosZero(c)) {
+        if (IsNeg(a) || IsNeg(b))
+          c = -c;
+      }
     }
-  }
 
-  if constexpr (rm == kRoundTiesToEven) {
-    if (!inexact) [[unlikely]] {
+    if constexpr (rm == kRoundTiesToEven) {
+      if (!quiet && !inexact) [[unlikely]] {
+        FT r = FastTwoSum<FT>(a, b, c);
+        if (!IsZero(r))
+          inexact = true;
+      }
+    } else {
       FT r = FastTwoSum<FT>(a, b, c);
-      if (!IsZero(r))
+      if (!IsZero(r)) {
         inexact = true;
-    }
-  } else {
-    FT r = FastTwoSum<FT>(a, b, c);
-    if (!IsZero(r)) {
-      inexact = true;
-      if constexpr (rm == kRoundTiesToAway) {
-        FT cc = ClearSignificand<FT>(c);
-        FT r_scaled = GetRScaled<FT>(r);
-
-        if (-cc == r_scaled) [[unlikely]] {
-          if (r < 0. && c > 0.) {
-            c = NextUpNoNegZero(c);
-            overflow = IsInf(c) ? true : overflow;
-          } else if (r > 0. && c < 0.) {
-            c = NextDownNoPosZero(c);
-            overflow = IsInf(c) ? true : overflow;
+        if constexpr (rm == kRoundTiesToAway) {
+          FT cc = ClearSignificand<FT>(c);
+          FT r_scaled = GetRScaled<FT>(r);
+
+          if (-cc == r_scaled) [[unlikely]] {
+            if (r < 0. && c > 0.) {
+              c = NextUpNoNegZero(c);
+              overflow = IsInf(c) ? true : overflow;
+            } else if (r > 0. && c < 0.) {
+              c = NextDownNoPosZero(c);
+              overflow = IsInf(c) ? true : overflow;
+            }
           }
+        } else {
+          c = RoundResult<FT, FT, rm>(r, c);
         }
-      } else {
-        c = RoundResult<FT, FT, rm>(r, c);
       }
     }
-  }
 
-  return c;
+    return c;
+  }
 }
 
 template f16 FloppyFloat::Add<f16, FloppyFloat::kRoundTiesToEven>(f16 a, f16 b);
@@ -424,6 +908,11 @@ template f16 FloppyFloat::Add<f16, FloppyFloat::kRoundTowardPositive>(f16 a, f16
 template f16 FloppyFloat::Add<f16, FloppyFloat::kRoundTowardNegative>(f16 a, f16 b);
 template f16 FloppyFloat::Add<f16, FloppyFloat::kRoundTowardZero>(f16 a, f16 b);
 template f16 FloppyFloat::Add<f16, FloppyFloat::kRoundTiesToAway>(f16 a, f16 b);
+template bf16 FloppyFloat::Add<bf16, FloppyFloat::kRoundTiesToEven>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Add<bf16, FloppyFloat::kRoundTowardPositive>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Add<bf16, FloppyFloat::kRoundTowardNegative>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Add<bf16, FloppyFloat::kRoundTowardZero>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Add<bf16, FloppyFloat::kRoundTiesToAway>(bf16 a, bf16 b);
 
 template f32 FloppyFloat::Add<f32, FloppyFloat::kRoundTiesToEven>(f32 a, f32 b);
 template f32 FloppyFloat::Add<f32, FloppyFloat::kRoundTowardPositive>(f32 a, f32 b);
@@ -437,89 +926,207 @@ template f64 FloppyFloat::Add<f64, FloppyFloat::kRoundTowardNegative>(f64 a, f64
 template f64 FloppyFloat::Add<f64, FloppyFloat::kRoundTowardZero>(f64 a, f64 b);
 template f64 FloppyFloat::Add<f64, FloppyFloat::kRoundTiesToAway>(f64 a, f64 b);
 
+template f128 FloppyFloat::Add<f128, FloppyFloat::kRoundTiesToEven>(f128 a, f128 b);
+template f128 FloppyFloat::Add<f128, FloppyFloat::kRoundTowardPositive>(f128 a, f128 b);
+template f128 FloppyFloat::Add<f128, FloppyFloat::kRoundTowardNegative>(f128 a, f128 b);
+template f128 FloppyFloat::Add<f128, FloppyFloat::kRoundTowardZero>(f128 a, f128 b);
+template f128 FloppyFloat::Add<f128, FloppyFloat::kRoundTiesToAway>(f128 a, f128 b);
+
+template f16 FloppyFloat::Add<f16, FloppyFloat::kRoundTiesToEven, true>(f16 a, f16 b);
+template f16 FloppyFloat::Add<f16, FloppyFloat::kRoundTowardPositive, true>(f16 a, f16 b);
+template f16 FloppyFloat::Add<f16, FloppyFloat::kRoundTowardNegative, true>(f16 a, f16 b);
+template f16 FloppyFloat::Add<f16, FloppyFloat::kRoundTowardZero, true>(f16 a, f16 b);
+template f16 FloppyFloat::Add<f16, FloppyFloat::kRoundTiesToAway, true>(f16 a, f16 b);
+template bf16 FloppyFloat::Add<bf16, FloppyFloat::kRoundTiesToEven, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Add<bf16, FloppyFloat::kRoundTowardPositive, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Add<bf16, FloppyFloat::kRoundTowardNegative, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Add<bf16, FloppyFloat::kRoundTowardZero, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Add<bf16, FloppyFloat::kRoundTiesToAway, true>(bf16 a, bf16 b);
+
+template f32 FloppyFloat::Add<f32, FloppyFloat::kRoundTiesToEven, true>(f32 a, f32 b);
+template f32 FloppyFloat::Add<f32, FloppyFloat::kRoundTowardPositive, true>(f32 a, f32 b);
+template f32 FloppyFloat::Add<f32, FloppyFloat::kRoundTowardNegative, true>(f32 a, f32 b);
+template f32 FloppyFloat::Add<f32, FloppyFloat::kRoundTowardZero, true>(f32 a, f32 b);
+template f32 FloppyFloat::Add<f32, FloppyFloat::kRoundTiesToAway, true>(f32 a, f32 b);
+
+template f64 FloppyFloat::Add<f64, FloppyFloat::kRoundTiesToEven, true>(f64 a, f64 b);
+template f64 FloppyFloat::Add<f64, FloppyFloat::kRoundTowardPositive, true>(f64 a, f64 b);
+template f64 FloppyFloat::Add<f64, FloppyFloat::kRoundTowardNegative, true>(f64 a, f64 b);
+template f64 FloppyFloat::Add<f64, FloppyFloat::kRoundTowardZero, true>(f64 a, f64 b);
+template f64 FloppyFloat::Add<f64, FloppyFloat::kRoundTiesToAway, true>(f64 a, f64 b);
+
+template f128 FloppyFloat::Add<f128, FloppyFloat::kRoundTiesToEven, true>(f128 a, f128 b);
+template f128 FloppyFloat::Add<f128, FloppyFloat::kRoundTowardPositive, true>(f128 a, f128 b);
+template f128 FloppyFloat::Add<f128, FloppyFloat::kRoundTowardNegative, true>(f128 a, f128 b);
+template f128 FloppyFloat::Add<f128, FloppyFloat::kRoundTowardZero, true>(f128 a, f128 b);
+template f128 FloppyFloat::Add<f128, FloppyFloat::kRoundTiesToAway, true>(f128 a, f128 b);
+
+template f16 FloppyFloat::Add<f16, FloppyFloat::kRoundTiesToEven, false, true>(f16 a, f16 b);
+template f16 FloppyFloat::Add<f16, FloppyFloat::kRoundTowardPositive, false, true>(f16 a, f16 b);
+template f16 FloppyFloat::Add<f16, FloppyFloat::kRoundTowardNegative, false, true>(f16 a, f16 b);
+template f16 FloppyFloat::Add<f16, FloppyFloat::kRoundTowardZero, false, true>(f16 a, f16 b);
+template f16 FloppyFloat::Add<f16, FloppyFloat::kRoundTiesToAway, false, true>(f16 a, f16 b);
+template bf16 FloppyFloat::Add<bf16, FloppyFloat::kRoundTiesToEven, false, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Add<bf16, FloppyFloat::kRoundTowardPositive, false, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Add<bf16, FloppyFloat::kRoundTowardNegative, false, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Add<bf16, FloppyFloat::kRoundTowardZero, false, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Add<bf16, FloppyFloat::kRoundTiesToAway, false, true>(bf16 a, bf16 b);
+
+template f32 FloppyFloat::Add<f32, FloppyFloat::kRoundTiesToEven, false, true>(f32 a, f32 b);
+template f32 FloppyFloat::Add<f32, FloppyFloat::kRoundTowardPositive, false, true>(f32 a, f32 b);
+template f32 FloppyFloat::Add<f32, FloppyFloat::kRoundTowardNegative, false, true>(f32 a, f32 b);
+template f32 FloppyFloat::Add<f32, FloppyFloat::kRoundTowardZero, false, true>(f32 a, f32 b);
+template f32 FloppyFloat::Add<f32, FloppyFloat::kRoundTiesToAway, false, true>(f32 a, f32 b);
+
+template f64 FloppyFloat::Add<f64, FloppyFloat::kRoundTiesToEven, false, true>(f64 a, f64 b);
+template f64 FloppyFloat::Add<f64, FloppyFloat::kRoundTowardPositive, false, true>(f64 a, f64 b);
+template f64 FloppyFloat::Add<f64, FloppyFloat::kRoundTowardNegative, false, true>(f64 a, f64 b);
+template f64 FloppyFloat::Add<f64, FloppyFloat::kRoundTowardZero, false, true>(f64 a, f64 b);
+template f64 FloppyFloat::Add<f64, FloppyFloat::kRoundTiesToAway, false, true>(f64 a, f64 b);
+
+template f128 FloppyFloat::Add<f128, FloppyFloat::kRoundTiesToEven, false, true>(f128 a, f128 b);
+template f128 FloppyFloat::Add<f128, FloppyFloat::kRoundTowardPositive, false, true>(f128 a, f128 b);
+template f128 FloppyFloat::Add<f128, FloppyFloat::kRoundTowardNegative, false, true>(f128 a, f128 b);
+template f128 FloppyFloat::Add<f128, FloppyFloat::kRoundTowardZero, false, true>(f128 a, f128 b);
+template f128 FloppyFloat::Add<f128, FloppyFloat::kRoundTiesToAway, false, true>(f128 a, f128 b);
+
+template f16 FloppyFloat::Add<f16, FloppyFloat::kRoundTiesToEven, true, true>(f16 a, f16 b);
+template f16 FloppyFloat::Add<f16, FloppyFloat::kRoundTowardPositive, true, true>(f16 a, f16 b);
+template f16 FloppyFloat::Add<f16, FloppyFloat::kRoundTowardNegative, true, true>(f16 a, f16 b);
+template f16 FloppyFloat::Add<f16, FloppyFloat::kRoundTowardZero, true, true>(f16 a, f16 b);
+template f16 FloppyFloat::Add<f16, FloppyFloat::kRoundTiesToAway, true, true>(f16 a, f16 b);
+template bf16 FloppyFloat::Add<bf16, FloppyFloat::kRoundTiesToEven, true, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Add<bf16, FloppyFloat::kRoundTowardPositive, true, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Add<bf16, FloppyFloat::kRoundTowardNegative, true, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Add<bf16, FloppyFloat::kRoundTowardZero, true, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Add<bf16, FloppyFloat::kRoundTiesToAway, true, true>(bf16 a, bf16 b);
+
+template f32 FloppyFloat::Add<f32, FloppyFloat::kRoundTiesToEven, true, true>(f32 a, f32 b);
+template f32 FloppyFloat::Add<f32, FloppyFloat::kRoundTowardPositive, true, true>(f32 a, f32 b);
+template f32 FloppyFloat::Add<f32, FloppyFloat::kRoundTowardNegative, true, true>(f32 a, f32 b);
+template f32 FloppyFloat::Add<f32, FloppyFloat::kRoundTowardZero, true, true>(f32 a, f32 b);
+template f32 FloppyFloat::Add<f32, FloppyFloat::kRoundTiesToAway, true, true>(f32 a, f32 b);
+
+template f64 FloppyFloat::Add<f64, FloppyFloat::kRoundTiesToEven, true, true>(f64 a, f64 b);
+template f64 FloppyFloat::Add<f64, FloppyFloat::kRoundTowardPositive, true, true>(f64 a, f64 b);
+template f64 FloppyFloat::Add<f64, FloppyFloat::kRoundTowardNegative, true, true>(f64 a, f64 b);
+template f64 FloppyFloat::Add<f64, FloppyFloat::kRoundTowardZero, true, true>(f64 a, f64 b);
+template f64 FloppyFloat::Add<f64, FloppyFloat::kRoundTiesToAway, true, true>(f64 a, f64 b);
+
+template f128 FloppyFloat::Add<f128, FloppyFloat::kRoundTiesToEven, true, true>(f128 a, f128 b);
+template f128 FloppyFloat::Add<f128, FloppyFloat::kRoundTowardPositive, true, true>(f128 a, f128 b);
+template f128 FloppyFloat::Add<f128, FloppyFloat::kRoundTowardNegative, true, true>(f128 a, f128 b);
+template f128 FloppyFloat::Add<f128, FloppyFloat::kRoundTowardZero, true, true>(f128 a, f128 b);
+template f128 FloppyFloat::Add<f128, FloppyFloat::kRoundTiesToAway, true, true>(f128 a, f128 b);
+
 template <typename FT>
 FT FloppyFloat::Sub(FT a, FT b) {
   switch (rounding_mode) {
   case kRoundTiesToEven:
-    return Sub<FT, kRoundTiesToEven>(a, b);
+    return Sub<FT, kRoundTiesToEven, false, true>(a, b);
   case kRoundTiesToAway:
-    return Sub<FT, kRoundTiesToAway>(a, b);
+    return Sub<FT, kRoundTiesToAway, false, true>(a, b);
   case kRoundTowardPositive:
-    return Sub<FT, kRoundTowardPositive>(a, b);
+    return Sub<FT, kRoundTowardPositive, false, true>(a, b);
   case kRoundTowardNegative:
-    return Sub<FT, kRoundTowardNegative>(a, b);
+    return Sub<FT, kRoundTowardNegative, false, true>(a, b);
   case kRoundTowardZero:
-    return Sub<FT, kRoundTowardZero>(a, b);
+    return Sub<FT, kRoundTowardZero, false, true>(a, b);
   default:
     throw std::runtime_error(std::string("Unknown rounding mode"));
   }
 }
 
 template f16 FloppyFloat::Sub<f16>(f16 a, f16 b);
+template bf16 FloppyFloat::Sub<bf16>(bf16 a, bf16 b);
 template f32 FloppyFloat::Sub<f32>(f32 a, f32 b);
 template f64 FloppyFloat::Sub<f64>(f64 a, f64 b);
+template f128 FloppyFloat::Sub<f128>(f128 a, f128 b);
 
-template <typename FT, FloppyFloat::RoundingMode rm>
+template <typename FT, FloppyFloat::RoundingMode rm, bool quiet, bool flush>
 FT FloppyFloat::Sub(FT a, FT b) {
-  FT c = a - b;
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  if constexpr (flush) {
+    if (ChecksDenormals<FT>(a, b))
+      return FlushDenormals<FT>([this](FT x, FT y) { return Sub<FT, rm>(x, y); }, [](FT, FT) { return false; }, a, b);
+  }
+  if constexpr (std::is_same_v<FT, f128>) {
+    return AddF128<rm>(a, b, true);
+  } else if constexpr ((std::is_same_v<FT, f16> && !(kNativeF16Sums && rm == kRoundTiesToEven)) ||
+                       std::is_same_v<FT, bf16>) {
+    const f64 wa = WidenToF64(a);
+    const f64 wb = WidenToF64(b);
+    f64 c = wa - wb;
+    if (IsInfOrNan(c)) [[unlikely]]
+      return InfOrNanF64(c, a, b);
+    if constexpr (std::is_same_v<FT, bf16>)
+      c = RoundToOdd(c, TwoSum(wa, -wb, c));
+    if constexpr (rm == kRoundTowardNegative) {
+      if (IsPosZero(c) && (IsNeg(a) || IsPos(b)))
+        c = -c;
+    }
+    return RoundF64<FT, rm>(c);
+  } else {
+    FT c = a - b;
 
-  if (IsInfOrNan(c)) [[unlikely]] {
-    if (IsInf(c)) {
-      if (!IsInf(a) && !IsInf(b)) {
-        c = RoundInf<FT, rm>(c);
-        overflow = IsOverflow<FT, rm>(a, -b, c);
-        inexact = true;
+    if (IsInfOrNan(c)) [[unlikely]] {
+      if (IsInf(c)) {
+        if (!IsInf(a) && !IsInf(b)) {
+          c = RoundInf<FT, rm>(c);
+          overflow = IsOverflow<FT, rm>(a, -b, c);
+          inexact = true;
+        }
+        return c;
       }
-      return c;
-    }
-    if (IsInf(a) && IsInf(b)) {
-      invalid = true;
-      return GetQnan<FT>();
+      if (IsInf(a) && IsInf(b)) {
+        invalid = true;
+        return GetQnan<FT>();
+      }
+      if (IsSnan(a) || IsSnan(b))
+        invalid = true;
+      if (IsNan(a) || IsNan(b))
+        return PropagateNan<FT>(a, b);
     }
-    if (IsSnan(a) || IsSnan(b))
-      invalid = true;
-    if (IsNan(a) || IsNan(b))
-      return PropagateNan<FT>(a, b);
-  }
 
-  // See: IEEE 754-2019: 6.3 The sign bit
-  if constexpr (rm == kRoundTowardNegative) {
-    if (IsPosZero(c)) {
-      if (IsNeg(a) || IsPos(b))
-        c = -c;
+    // See: IEEE 754-2019: 6.3 The sign bit
+    if constexpr (rm == kRoundTowardNegative) {
+      if (IsPosZero(c)) {
+        if (IsNeg(a) || IsPos(b))
+          c = -c;
+      }
     }
-  }
 
-  if constexpr (rm == kRoundTiesToEven) {
-    if (!inexact) [[unlikely]] {
-      FT r = FastTwoSum<FT>(a, -b, c);
-      if (!IsZero(r))
+    if constexpr (rm == kRoundTiesToEven) {
+      if (!quiet && !inexact) [[unlikely]] {
+        FT r = FastTwoSum<FT>(a, -b, c);
+        if (!IsZero(r))
+          inexact = true;
+      }
+    } else {
+      FT r = FastTwoSum(a, -b, c);
+      if (!IsZero(r)) {
         inexact = true;
-    }
-  } else {
-    FT r = FastTwoSum(a, -b, c);
-    if (!IsZero(r)) {
-      inexact = true;
-      if constexpr (rm == kRoundTiesToAway) {
-        FT cc = ClearSignificand<FT>(c);
-        FT r_scaled = GetRScaled<FT>(r);
-
-        if (-cc == r_scaled) [[unlikely]] {
-          if (r < 0. && c > 0.) {
-            c = NextUpNoNegZero(c);
-            overflow = IsInf(c) ? true : overflow;
-          } else if (r > 0. && c < 0.) {
-            c = NextDownNoPosZero(c);
-            overflow = IsInf(c) ? true : overflow;
+        if constexpr (rm == kRoundTiesToAway) {
+          FT cc = ClearSignificand<FT>(c);
+          FT r_scaled = GetRScaled<FT>(r);
+
+          if (-cc == r_scaled) [[unlikely]] {
+            if (r < 0. && c > 0.) {
+              c = NextUpNoNegZero(c);
+              overflow = IsInf(c) ? true : overflow;
+            } else if (r > 0. && c < 0.) {
+              c = NextDownNoPosZero(c);
+              overflow = IsInf(c) ? true : overflow;
+            }
           }
+        } else {
+          c = RoundResult<FT, FT, rm>(r, c);
         }
-      } else {
-        c = RoundResult<FT, FT, rm>(r, c);
       }
     }
-  }
 
-  return c;
+    return c;
+  }
 }
 
 template f16 FloppyFloat::Sub<f16, FloppyFloat::kRoundTiesToEven>(f16 a, f16 b);
@@ -527,6 +1134,11 @@ template f16 FloppyFloat::Sub<f16, FloppyFloat::kRoundTowardPositive>(f16 a, f16
 template f16 FloppyFloat::Sub<f16, FloppyFloat::kRoundTowardNegative>(f16 a, f16 b);
 template f16 FloppyFloat::Sub<f16, FloppyFloat::kRoundTowardZero>(f16 a, f16 b);
 template f16 FloppyFloat::Sub<f16, FloppyFloat::kRoundTiesToAway>(f16 a, f16 b);
+template bf16 FloppyFloat::Sub<bf16, FloppyFloat::kRoundTiesToEven>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Sub<bf16, FloppyFloat::kRoundTowardPositive>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Sub<bf16, FloppyFloat::kRoundTowardNegative>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Sub<bf16, FloppyFloat::kRoundTowardZero>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Sub<bf16, FloppyFloat::kRoundTiesToAway>(bf16 a, bf16 b);
 
 template f32 FloppyFloat::Sub<f32, FloppyFloat::kRoundTiesToEven>(f32 a, f32 b);
 template f32 FloppyFloat::Sub<f32, FloppyFloat::kRoundTowardPositive>(f32 a, f32 b);
@@ -540,87 +1152,192 @@ template f64 FloppyFloat::Sub<f64, FloppyFloat::kRoundTowardNegative>(f64 a, f64
 template f64 FloppyFloat::Sub<f64, FloppyFloat::kRoundTowardZero>(f64 a, f64 b);
 template f64 FloppyFloat::Sub<f64, FloppyFloat::kRoundTiesToAway>(f64 a, f64 b);
 
+template f128 FloppyFloat::Sub<f128, FloppyFloat::kRoundTiesToEven>(f128 a, f128 b);
+template f128 FloppyFloat::Sub<f128, FloppyFloat::kRoundTowardPositive>(f128 a, f128 b);
+template f128 FloppyFloat::Sub<f128, FloppyFloat::kRoundTowardNegative>(f128 a, f128 b);
+template f128 FloppyFloat::Sub<f128, FloppyFloat::kRoundTowardZero>(f128 a, f128 b);
+template f128 FloppyFloat::Sub<f128, FloppyFloat::kRoundTiesToAway>(f128 a, f128 b);
+
+template f16 FloppyFloat::Sub<f16, FloppyFloat::kRoundTiesToEven, true>(f16 a, f16 b);
+template f16 FloppyFloat::Sub<f16, FloppyFloat::kRoundTowardPositive, true>(f16 a, f16 b);
+template f16 FloppyFloat::Sub<f16, FloppyFloat::kRoundTowardNegative, true>(f16 a, f16 b);
+template f16 FloppyFloat::Sub<f16, FloppyFloat::kRoundTowardZero, true>(f16 a, f16 b);
+template f16 FloppyFloat::Sub<f16, FloppyFloat::kRoundTiesToAway, true>(f16 a, f16 b);
+template bf16 FloppyFloat::Sub<bf16, FloppyFloat::kRoundTiesToEven, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Sub<bf16, FloppyFloat::kRoundTowardPositive, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Sub<bf16, FloppyFloat::kRoundTowardNegative, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Sub<bf16, FloppyFloat::kRoundTowardZero, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Sub<bf16, FloppyFloat::kRoundTiesToAway, true>(bf16 a, bf16 b);
+
+template f32 FloppyFloat::Sub<f32, FloppyFloat::kRoundTiesToEven, true>(f32 a, f32 b);
+template f32 FloppyFloat::Sub<f32, FloppyFloat::kRoundTowardPositive, true>(f32 a, f32 b);
+template f32 FloppyFloat::Sub<f32, FloppyFloat::kRoundTowardNegative, true>(f32 a, f32 b);
+template f32 FloppyFloat::Sub<f32, FloppyFloat::kRoundTowardZero, true>(f32 a, f32 b);
+template f32 FloppyFloat::Sub<f32, FloppyFloat::kRoundTiesToAway, true>(f32 a, f32 b);
+
+template f64 FloppyFloat::Sub<f64, FloppyFloat::kRoundTiesToEven, true>(f64 a, f64 b);
+template f64 FloppyFloat::Sub<f64, FloppyFloat::kRoundTowardPositive, true>(f64 a, f64 b);
+template f64 FloppyFloat::Sub<f64, FloppyFloat::kRoundTowardNegative, true>(f64 a, f64 b);
+template f64 FloppyFloat::Sub<f64, FloppyFloat::kRoundTowardZero, true>(f64 a, f64 b);
+template f64 FloppyFloat::Sub<f64, FloppyFloat::kRoundTiesToAway, true>(f64 a, f64 b);
+
+template f128 FloppyFloat::Sub<f128, FloppyFloat::kRoundTiesToEven, true>(f128 a, f128 b);
+template f128 FloppyFloat::Sub<f128, FloppyFloat::kRoundTowardPositive, true>(f128 a, f128 b);
+template f128 FloppyFloat::Sub<f128, FloppyFloat::kRoundTowardNegative, true>(f128 a, f128 b);
+template f128 FloppyFloat::Sub<f128, FloppyFloat::kRoundTowardZero, true>(f128 a, f128 b);
+template f128 FloppyFloat::Sub<f128, FloppyFloat::kRoundTiesToAway, true>(f128 a, f128 b);
+
+template f16 FloppyFloat::Sub<f16, FloppyFloat::kRoundTiesToEven, false, true>(f16 a, f16 b);
+template f16 FloppyFloat::Sub<f16, FloppyFloat::kRoundTowardPositive, false, true>(f16 a, f16 b);
+template f16 FloppyFloat::Sub<f16, FloppyFloat::kRoundTowardNegative, false, true>(f16 a, f16 b);
+template f16 FloppyFloat::Sub<f16, FloppyFloat::kRoundTowardZero, false, true>(f16 a, f16 b);
+template f16 FloppyFloat::Sub<f16, FloppyFloat::kRoundTiesToAway, false, true>(f16 a, f16 b);
+template bf16 FloppyFloat::Sub<bf16, FloppyFloat::kRoundTiesToEven, false, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Sub<bf16, FloppyFloat::kRoundTowardPositive, false, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Sub<bf16, FloppyFloat::kRoundTowardNegative, false, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Sub<bf16, FloppyFloat::kRoundTowardZero, false, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Sub<bf16, FloppyFloat::kRoundTiesToAway, false, true>(bf16 a, bf16 b);
+
+template f32 FloppyFloat::Sub<f32, FloppyFloat::kRoundTiesToEven, false, true>(f32 a, f32 b);
+template f32 FloppyFloat::Sub<f32, FloppyFloat::kRoundTowardPositive, false, true>(f32 a, f32 b);
+template f32 FloppyFloat::Sub<f32, FloppyFloat::kRoundTowardNegative, false, true>(f32 a, f32 b);
+template f32 FloppyFloat::Sub<f32, FloppyFloat::kRoundTowardZero, false, true>(f32 a, f32 b);
+template f32 FloppyFloat::Sub<f32, FloppyFloat::kRoundTiesToAway, false, true>(f32 a, f32 b);
+
+template f64 FloppyFloat::Sub<f64, FloppyFloat::kRoundTiesToEven, false, true>(f64 a, f64 b);
+template f64 FloppyFloat::Sub<f64, FloppyFloat::kRoundTowardPositive, false, true>(f64 a, f64 b);
+template f64 FloppyFloat::Sub<f64, FloppyFloat::kRoundTowardNegative, false, true>(f64 a, f64 b);
+template f64 FloppyFloat::Sub<f64, FloppyFloat::kRoundTowardZero, false, true>(f64 a, f64 b);
+template f64 FloppyFloat::Sub<f64, FloppyFloat::kRoundTiesToAway, false, true>(f64 a, f64 b);
+
+template f128 FloppyFloat::Sub<f128, FloppyFloat::kRoundTiesToEven, false, true>(f128 a, f128 b);
+template f128 FloppyFloat::Sub<f128, FloppyFloat::kRoundTowardPositive, false, true>(f128 a, f128 b);
+template f128 FloppyFloat::Sub<f128, FloppyFloat::kRoundTowardNegative, false, true>(f128 a, f128 b);
+template f128 FloppyFloat::Sub<f128, FloppyFloat::kRoundTowardZero, false, true>(f128 a, f128 b);
+template f128 FloppyFloat::Sub<f128, FloppyFloat::kRoundTiesToAway, false, true>(f128 a, f128 b);
+
+template f16 FloppyFloat::Sub<f16, FloppyFloat::kRoundTiesToEven, true, true>(f16 a, f16 b);
+template f16 FloppyFloat::Sub<f16, FloppyFloat::kRoundTowardPositive, true, true>(f16 a, f16 b);
+template f16 FloppyFloat::Sub<f16, FloppyFloat::kRoundTowardNegative, true, true>(f16 a, f16 b);
+template f16 FloppyFloat::Sub<f16, FloppyFloat::kRoundTowardZero, true, true>(f16 a, f16 b);
+template f16 FloppyFloat::Sub<f16, FloppyFloat::kRoundTiesToAway, true, true>(f16 a, f16 b);
+template bf16 FloppyFloat::Sub<bf16, FloppyFloat::kRoundTiesToEven, true, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Sub<bf16, FloppyFloat::kRoundTowardPositive, true, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Sub<bf16, FloppyFloat::kRoundTowardNegative, true, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Sub<bf16, FloppyFloat::kRoundTowardZero, true, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Sub<bf16, FloppyFloat::kRoundTiesToAway, true, true>(bf16 a, bf16 b);
+
+template f32 FloppyFloat::Sub<f32, FloppyFloat::kRoundTiesToEven, true, true>(f32 a, f32 b);
+template f32 FloppyFloat::Sub<f32, FloppyFloat::kRoundTowardPositive, true, true>(f32 a, f32 b);
+template f32 FloppyFloat::Sub<f32, FloppyFloat::kRoundTowardNegative, true, true>(f32 a, f32 b);
+template f32 FloppyFloat::Sub<f32, FloppyFloat::kRoundTowardZero, true, true>(f32 a, f32 b);
+template f32 FloppyFloat::Sub<f32, FloppyFloat::kRoundTiesToAway, true, true>(f32 a, f32 b);
+
+template f64 FloppyFloat::Sub<f64, FloppyFloat::kRoundTiesToEven, true, true>(f64 a, f64 b);
+template f64 FloppyFloat::Sub<f64, FloppyFloat::kRoundTowardPositive, true, true>(f64 a, f64 b);
+template f64 FloppyFloat::Sub<f64, FloppyFloat::kRoundTowardNegative, true, true>(f64 a, f64 b);
+template f64 FloppyFloat::Sub<f64, FloppyFloat::kRoundTowardZero, true, true>(f64 a, f64 b);
+template f64 FloppyFloat::Sub<f64, FloppyFloat::kRoundTiesToAway, true, true>(f64 a, f64 b);
+
+template f128 FloppyFloat::Sub<f128, FloppyFloat::kRoundTiesToEven, true, true>(f128 a, f128 b);
+template f128 FloppyFloat::Sub<f128, FloppyFloat::kRoundTowardPositive, true, true>(f128 a, f128 b);
+template f128 FloppyFloat::Sub<f128, FloppyFloat::kRoundTowardNegative, true, true>(f128 a, f128 b);
+template f128 FloppyFloat::Sub<f128, FloppyFloat::kRoundTowardZero, true, true>(f128 a, f128 b);
+template f128 FloppyFloat::Sub<f128, FloppyFloat::kRoundTiesToAway, true, true>(f128 a, f128 b);
+
 template <typename FT>
 FT FloppyFloat::Mul(FT a, FT b) {
   switch (rounding_mode) {
   case kRoundTiesToEven:
-    return Mul<FT, kRoundTiesToEven>(a, b);
+    return Mul<FT, kRoundTiesToEven, false, true>(a, b);
   case kRoundTiesToAway:
-    return Mul<FT, kRoundTiesToAway>(a, b);
+    return Mul<FT, kRoundTiesToAway, false, true>(a, b);
   case kRoundTowardPositive:
-    return Mul<FT, kRoundTowardPositive>(a, b);
+    return Mul<FT, kRoundTowardPositive, false, true>(a, b);
   case kRoundTowardNegative:
-    return Mul<FT, kRoundTowardNegative>(a, b);
+    return Mul<FT, kRoundTowardNegative, false, true>(a, b);
   case kRoundTowardZero:
-    return Mul<FT, kRoundTowardZero>(a, b);
+    return Mul<FT, kRoundTowardZero, false, true>(a, b);
   default:
     throw std::runtime_error(std::string("Unknown rounding mode"));
   }
 }
 
 template f16 FloppyFloat::Mul<f16>(f16 a, f16 b);
+template bf16 FloppyFloat::Mul<bf16>(bf16 a, bf16 b);
 template f32 FloppyFloat::Mul<f32>(f32 a, f32 b);
 template f64 FloppyFloat::Mul<f64>(f64 a, f64 b);
+template f128 FloppyFloat::Mul<f128>(f128 a, f128 b);
 
-template <typename FT, FloppyFloat::RoundingMode rm>
+template <typename FT, FloppyFloat::RoundingMode rm, bool quiet, bool flush>
 FT FloppyFloat::Mul(FT a, FT b) {
-  if constexpr (rm == kRoundTiesToAway) {
-    RmGuard rg(this, rm);
-    return SoftFloat::Mul<FT>(a, b);
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  if constexpr (flush) {
+    if (ChecksDenormals<FT>(a, b))
+      return FlushDenormals<FT>([this](FT x, FT y) { return Mul<FT, rm>(x, y); }, IsTinyProduct<FT>, a, b);
   }
+  if constexpr (std::is_same_v<FT, f128>) {
+    return MulF128<rm>(a, b);
+  } else if constexpr (std::is_same_v<FT, f16> || std::is_same_v<FT, bf16>) {
+    f64 c = WidenToF64(a) * WidenToF64(b);
+    if (IsInfOrNan(c)) [[unlikely]]
+      return InfOrNanF64(c, a, b);
+    return RoundF64<FT, rm>(c);
+  } else {
+    if constexpr (rm == kRoundTiesToAway) {
+      return SoftFloat::Mul<FT, rm>(a, b);
+    }
 
-  FT c = a * b;
+    FT c = a * b;
 
-  if (IsInfOrNan(c)) [[unlikely]] {
-    if (IsInf(c)) {
-      if (!IsInf(a) && !IsInf(b)) {
-        if constexpr (rm == FloppyFloat::kRoundTiesToEven) {
-          overflow = true;
-          inexact = true;
-        } else {
-          RmGuard rg(this, rm);
-          c = SoftFloat::Mul<FT>(a, b);
+    if (IsInfOrNan(c)) [[unlikely]] {
+      if (IsInf(c)) {
+        if (!IsInf(a) && !IsInf(b)) {
+          if constexpr (rm == FloppyFloat::kRoundTiesToEven) {
+            overflow = true;
+            inexact = true;
+          } else {
+            c = SoftFloat::Mul<FT, rm>(a, b);
+          }
         }
+        return c;
       }
-      return c;
-    }
-    if (IsSnan(a) || IsSnan(b))
+      if (IsSnan(a) || IsSnan(b))
+        invalid = true;
+      if (IsNan(a) || IsNan(b))
+        return PropagateNan<FT>(a, b);
       invalid = true;
-    if (IsNan(a) || IsNan(b))
-      return PropagateNan<FT>(a, b);
-    invalid = true;
-    return GetQnan<FT>();
-  }
+      return GetQnan<FT>();
+    }
 
-  if constexpr (rm == kRoundTiesToEven) {
-    if (!inexact) [[unlikely]] {
+    if constexpr (rm == kRoundTiesToEven) {
+      if (!quiet && !inexact) [[unlikely]] {
+        auto r = UpMul<FT, rm>(a, b, c);
+        if (!IsZero(r))
+          inexact = true;
+      }
+      if (!quiet && !underflow) {
+        if (MayResultFromUnderflow(c)) [[unlikely]] {
+          c = SoftFloat::Mul<FT, rm>(a, b);
+        }
+      }
+    } else {
       auto r = UpMul<FT, rm>(a, b, c);
-      if (!IsZero(r))
+      if (!IsZero(r)) {
         inexact = true;
-    }
-    if (!underflow) {
-      if (MayResultFromUnderflow(c)) [[unlikely]] {
-        RmGuard rg(this, rm);
-        c = SoftFloat::Mul<FT>(a, b);
-      }
-    }
-  } else {
-    auto r = UpMul<FT, rm>(a, b, c);
-    if (!IsZero(r)) {
-      inexact = true;
-      c = RoundResult<FT, typename TwiceWidthType<FT>::type, rm>(r, c);
-      if (!underflow && MayResultFromUnderflow(c)) [[unlikely]] {
-        if (IsTiny(c)) [[likely]] {
-          if (!IsZero(r))
-            underflow = true;
-        } else {
-          RmGuard rg(this, rm);
-          c = SoftFloat::Mul<FT>(a, b);
+        c = RoundResult<FT, typename TwiceWidthType<FT>::type, rm>(r, c);
+        if (!quiet && !underflow && MayResultFromUnderflow(c)) [[unlikely]] {
+          if (IsTiny(c)) [[likely]] {
+            if (!IsZero(r))
+              underflow = true;
+          } else {
+            c = SoftFloat::Mul<FT, rm>(a, b);
+          }
         }
       }
     }
+    return c;
   }
-  return c;
 }
 
 template f16 FloppyFloat::Mul<f16, FloppyFloat::kRoundTiesToEven>(f16 a, f16 b);
@@ -628,6 +1345,11 @@ template f16 FloppyFloat::Mul<f16, FloppyFloat::kRoundTowardPositive>(f16 a, f16
 template f16 FloppyFloat::Mul<f16, FloppyFloat::kRoundTowardNegative>(f16 a, f16 b);
 template f16 FloppyFloat::Mul<f16, FloppyFloat::kRoundTowardZero>(f16 a, f16 b);
 template f16 FloppyFloat::Mul<f16, FloppyFloat::kRoundTiesToAway>(f16 a, f16 b);
+template bf16 FloppyFloat::Mul<bf16, FloppyFloat::kRoundTiesToEven>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Mul<bf16, FloppyFloat::kRoundTowardPositive>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Mul<bf16, FloppyFloat::kRoundTowardNegative>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Mul<bf16, FloppyFloat::kRoundTowardZero>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Mul<bf16, FloppyFloat::kRoundTiesToAway>(bf16 a, bf16 b);
 
 template f32 FloppyFloat::Mul<f32, FloppyFloat::kRoundTiesToEven>(f32 a, f32 b);
 template f32 FloppyFloat::Mul<f32, FloppyFloat::kRoundTowardPositive>(f32 a, f32 b);
@@ -641,95 +1363,203 @@ template f64 FloppyFloat::Mul<f64, FloppyFloat::kRoundTowardNegative>(f64 a, f64
 template f64 FloppyFloat::Mul<f64, FloppyFloat::kRoundTowardZero>(f64 a, f64 b);
 template f64 FloppyFloat::Mul<f64, FloppyFloat::kRoundTiesToAway>(f64 a, f64 b);
 
+template f128 FloppyFloat::Mul<f128, FloppyFloat::kRoundTiesToEven>(f128 a, f128 b);
+template f128 FloppyFloat::Mul<f128, FloppyFloat::kRoundTowardPositive>(f128 a, f128 b);
+template f128 FloppyFloat::Mul<f128, FloppyFloat::kRoundTowardNegative>(f128 a, f128 b);
+template f128 FloppyFloat::Mul<f128, FloppyFloat::kRoundTowardZero>(f128 a, f128 b);
+template f128 FloppyFloat::Mul<f128, FloppyFloat::kRoundTiesToAway>(f128 a, f128 b);
+
+template f16 FloppyFloat::Mul<f16, FloppyFloat::kRoundTiesToEven, true>(f16 a, f16 b);
+template f16 FloppyFloat::Mul<f16, FloppyFloat::kRoundTowardPositive, true>(f16 a, f16 b);
+template f16 FloppyFloat::Mul<f16, FloppyFloat::kRoundTowardNegative, true>(f16 a, f16 b);
+template f16 FloppyFloat::Mul<f16, FloppyFloat::kRoundTowardZero, true>(f16 a, f16 b);
+template f16 FloppyFloat::Mul<f16, FloppyFloat::kRoundTiesToAway, true>(f16 a, f16 b);
+template bf16 FloppyFloat::Mul<bf16, FloppyFloat::kRoundTiesToEven, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Mul<bf16, FloppyFloat::kRoundTowardPositive, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Mul<bf16, FloppyFloat::kRoundTowardNegative, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Mul<bf16, FloppyFloat::kRoundTowardZero, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Mul<bf16, FloppyFloat::kRoundTiesToAway, true>(bf16 a, bf16 b);
+
+template f32 FloppyFloat::Mul<f32, FloppyFloat::kRoundTiesToEven, true>(f32 a, f32 b);
+template f32 FloppyFloat::Mul<f32, FloppyFloat::kRoundTowardPositive, true>(f32 a, f32 b);
+template f32 FloppyFloat::Mul<f32, FloppyFloat::kRoundTowardNegative, true>(f32 a, f32 b);
+template f32 FloppyFloat::Mul<f32, FloppyFloat::kRoundTowardZero, true>(f32 a, f32 b);
+template f32 FloppyFloat::Mul<f32, FloppyFloat::kRoundTiesToAway, true>(f32 a, f32 b);
+
+template f64 FloppyFloat::Mul<f64, FloppyFloat::kRoundTiesToEven, true>(f64 a, f64 b);
+template f64 FloppyFloat::Mul<f64, FloppyFloat::kRoundTowardPositive, true>(f64 a, f64 b);
+template f64 FloppyFloat::Mul<f64, FloppyFloat::kRoundTowardNegative, true>(f64 a, f64 b);
+template f64 FloppyFloat::Mul<f64, FloppyFloat::kRoundTowardZero, true>(f64 a, f64 b);
+template f64 FloppyFloat::Mul<f64, FloppyFloat::kRoundTiesToAway, true>(f64 a, f64 b);
+
+template f128 FloppyFloat::Mul<f128, FloppyFloat::kRoundTiesToEven, true>(f128 a, f128 b);
+template f128 FloppyFloat::Mul<f128, FloppyFloat::kRoundTowardPositive, true>(f128 a, f128 b);
+template f128 FloppyFloat::Mul<f128, FloppyFloat::kRoundTowardNegative, true>(f128 a, f128 b);
+template f128 FloppyFloat::Mul<f128, FloppyFloat::kRoundTowardZero, true>(f128 a, f128 b);
+template f128 FloppyFloat::Mul<f128, FloppyFloat::kRoundTiesToAway, true>(f128 a, f128 b);
+
+template f16 FloppyFloat::Mul<f16, FloppyFloat::kRoundTiesToEven, false, true>(f16 a, f16 b);
+template f16 FloppyFloat::Mul<f16, FloppyFloat::kRoundTowardPositive, false, true>(f16 a, f16 b);
+template f16 FloppyFloat::Mul<f16, FloppyFloat::kRoundTowardNegative, false, true>(f16 a, f16 b);
+template f16 FloppyFloat::Mul<f16, FloppyFloat::kRoundTowardZero, false, true>(f16 a, f16 b);
+template f16 FloppyFloat::Mul<f16, FloppyFloat::kRoundTiesToAway, false, true>(f16 a, f16 b);
+template bf16 FloppyFloat::Mul<bf16, FloppyFloat::kRoundTiesToEven, false, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Mul<bf16, FloppyFloat::kRoundTowardPositive, false, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Mul<bf16, FloppyFloat::kRoundTowardNegative, false, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Mul<bf16, FloppyFloat::kRoundTowardZero, false, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Mul<bf16, FloppyFloat::kRoundTiesToAway, false, true>(bf16 a, bf16 b);
+
+template f32 FloppyFloat::Mul<f32, FloppyFloat::kRoundTiesToEven, false, true>(f32 a, f32 b);
+template f32 FloppyFloat::Mul<f32, FloppyFloat::kRoundTowardPositive, false, true>(f32 a, f32 b);
+template f32 FloppyFloat::Mul<f32, FloppyFloat::kRoundTowardNegative, false, true>(f32 a, f32 b);
+template f32 FloppyFloat::Mul<f32, FloppyFloat::kRoundTowardZero, false, true>(f32 a, f32 b);
+template f32 FloppyFloat::Mul<f32, FloppyFloat::kRoundTiesToAway, false, true>(f32 a, f32 b);
+
+template f64 FloppyFloat::Mul<f64, FloppyFloat::kRoundTiesToEven, false, true>(f64 a, f64 b);
+template f64 FloppyFloat::Mul<f64, FloppyFloat::kRoundTowardPositive, false, true>(f64 a, f64 b);
+template f64 FloppyFloat::Mul<f64, FloppyFloat::kRoundTowardNegative, false, true>(f64 a, f64 b);
+template f64 FloppyFloat::Mul<f64, FloppyFloat::kRoundTowardZero, false, true>(f64 a, f64 b);
+template f64 FloppyFloat::Mul<f64, FloppyFloat::kRoundTiesToAway, false, true>(f64 a, f64 b);
+
+template f128 FloppyFloat::Mul<f128, FloppyFloat::kRoundTiesToEven, false, true>(f128 a, f128 b);
+template f128 FloppyFloat::Mul<f128, FloppyFloat::kRoundTowardPositive, false, true>(f128 a, f128 b);
+template f128 FloppyFloat::Mul<f128, FloppyFloat::kRoundTowardNegative, false, true>(f128 a, f128 b);
+template f128 FloppyFloat::Mul<f128, FloppyFloat::kRoundTowardZero, false, true>(f128 a, f128 b);
+template f128 FloppyFloat::Mul<f128, FloppyFloat::kRoundTiesToAway, false, true>(f128 a, f128 b);
+
+template f16 FloppyFloat::Mul<f16, FloppyFloat::kRoundTiesToEven, true, true>(f16 a, f16 b);
+template f16 FloppyFloat::Mul<f16, FloppyFloat::kRoundTowardPositive, true, true>(f16 a, f16 b);
+template f16 FloppyFloat::Mul<f16, FloppyFloat::kRoundTowardNegative, true, true>(f16 a, f16 b);
+template f16 FloppyFloat::Mul<f16, FloppyFloat::kRoundTowardZero, true, true>(f16 a, f16 b);
+template f16 FloppyFloat::Mul<f16, FloppyFloat::kRoundTiesToAway, true, true>(f16 a, f16 b);
+template bf16 FloppyFloat::Mul<bf16, FloppyFloat::kRoundTiesToEven, true, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Mul<bf16, FloppyFloat::kRoundTowardPositive, true, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Mul<bf16, FloppyFloat::kRoundTowardNegative, true, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Mul<bf16, FloppyFloat::kRoundTowardZero, true, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Mul<bf16, FloppyFloat::kRoundTiesToAway, true, true>(bf16 a, bf16 b);
+
+template f32 FloppyFloat::Mul<f32, FloppyFloat::kRoundTiesToEven, true, true>(f32 a, f32 b);
+template f32 FloppyFloat::Mul<f32, FloppyFloat::kRoundTowardPositive, true, true>(f32 a, f32 b);
+template f32 FloppyFloat::Mul<f32, FloppyFloat::kRoundTowardNegative, true, true>(f32 a, f32 b);
+template f32 FloppyFloat::Mul<f32, FloppyFloat::kRoundTowardZero, true, true>(f32 a, f32 b);
+template f32 FloppyFloat::Mul<f32, FloppyFloat::kRoundTiesToAway, true, true>(f32 a, f32 b);
+
+template f64 FloppyFloat::Mul<f64, FloppyFloat::kRoundTiesToEven, true, true>(f64 a, f64 b);
+template f64 FloppyFloat::Mul<f64, FloppyFloat::kRoundTowardPositive, true, true>(f64 a, f64 b);
+template f64 FloppyFloat::Mul<f64, FloppyFloat::kRoundTowardNegative, true, true>(f64 a, f64 b);
+template f64 FloppyFloat::Mul<f64, FloppyFloat::kRoundTowardZero, true, true>(f64 a, f64 b);
+template f64 FloppyFloat::Mul<f64, FloppyFloat::kRoundTiesToAway, true, true>(f64 a, f64 b);
+
+template f128 FloppyFloat::Mul<f128, FloppyFloat::kRoundTiesToEven, true, true>(f128 a, f128 b);
+template f128 FloppyFloat::Mul<f128, FloppyFloat::kRoundTowardPositive, true, true>(f128 a, f128 b);
+template f128 FloppyFloat::Mul<f128, FloppyFloat::kRoundTowardNegative, true, true>(f128 a, f128 b);
+template f128 FloppyFloat::Mul<f128, FloppyFloat::kRoundTowardZero, true, true>(f128 a, f128 b);
+template f128 FloppyFloat::Mul<f128, FloppyFloat::kRoundTiesToAway, true, true>(f128 a, f128 b);
+
 template <typename FT>
 FT FloppyFloat::Div(FT a, FT b) {
   switch (rounding_mode) {
   case kRoundTiesToEven:
-    return Div<FT, kRoundTiesToEven>(a, b);
+    return Div<FT, kRoundTiesToEven, false, true>(a, b);
   case kRoundTiesToAway:
-    return Div<FT, kRoundTiesToAway>(a, b);
+    return Div<FT, kRoundTiesToAway, false, true>(a, b);
   case kRoundTowardPositive:
-    return Div<FT, kRoundTowardPositive>(a, b);
+    return Div<FT, kRoundTowardPositive, false, true>(a, b);
   case kRoundTowardNegative:
-    return Div<FT, kRoundTowardNegative>(a, b);
+    return Div<FT, kRoundTowardNegative, false, true>(a, b);
   case kRoundTowardZero:
-    return Div<FT, kRoundTowardZero>(a, b);
+    return Div<FT, kRoundTowardZero, false, true>(a, b);
   default:
     throw std::runtime_error(std::string("Unknown rounding mode"));
   }
 }
 
 template f16 FloppyFloat::Div<f16>(f16 a, f16 b);
+template bf16 FloppyFloat::Div<bf16>(bf16 a, bf16 b);
 template f32 FloppyFloat::Div<f32>(f32 a, f32 b);
 template f64 FloppyFloat::Div<f64>(f64 a, f64 b);
+template f128 FloppyFloat::Div<f128>(f128 a, f128 b);
 
-template <typename FT, FloppyFloat::RoundingMode rm>
+template <typename FT, FloppyFloat::RoundingMode rm, bool quiet, bool flush>
 FT FloppyFloat::Div(FT a, FT b) {
-  if constexpr (rm == kRoundTiesToAway) {
-    RmGuard rg(this, rm);
-    return SoftFloat::Div<FT>(a, b);
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  if constexpr (flush) {
+    if (ChecksDenormals<FT>(a, b))
+      return FlushDenormals<FT>([this](FT x, FT y) { return Div<FT, rm>(x, y); }, IsTinyQuotient<FT>, a, b);
   }
+  if constexpr (std::is_same_v<FT, f128>) {
+    return DivF128<rm>(a, b);
+  } else if constexpr (std::is_same_v<FT, f16> || std::is_same_v<FT, bf16>) {
+    f64 c = WidenToF64(a) / WidenToF64(b);
+    if (IsInfOrNan(c)) [[unlikely]] {
+      if (IsInf(c) && !IsInf(a))
+        division_by_zero = true;
+      return InfOrNanF64(c, a, b);
+    }
+    return RoundF64<FT, rm>(c);
+  } else {
+    if constexpr (rm == kRoundTiesToAway) {
+      return SoftFloat::Div<FT, rm>(a, b);
+    }
 
-  FT c = a / b;
+    FT c = a / b;
 
-  if (IsInfOrNan(c)) [[unlikely]] {
-    if (IsInf(c)) {
-      if (!IsInf(a) && IsZero(b)) {
-        division_by_zero = true;
+    if (IsInfOrNan(c)) [[unlikely]] {
+      if (IsInf(c)) {
+        if (!IsInf(a) && IsZero(b)) {
+          division_by_zero = true;
+          return c;
+        }
+        if (!IsInf(a) && !(IsInf(b))) {
+          if constexpr (rm == FloppyFloat::kRoundTiesToEven) {
+            overflow = true;
+            inexact = true;
+          } else {
+            c = SoftFloat::Div<FT, rm>(a, b);
+          }
+        }
         return c;
       }
-      if (!IsInf(a) && !(IsInf(b))) {
-        if constexpr (rm == FloppyFloat::kRoundTiesToEven) {
-          overflow = true;
+      if (IsSnan(a) || IsSnan(b))
+        invalid = true;
+      if (IsNan(a) || IsNan(b))
+        return PropagateNan<FT>(a, b);
+      invalid = true;
+      return GetQnan<FT>();
+    }
+
+    if (IsInf(b)) [[unlikely]]
+      return c;
+
+    if constexpr (rm == kRoundTiesToEven) {
+      if (!quiet && !inexact) [[unlikely]] {
+        auto r = UpDiv<FT, rm>(a, b, c);
+        if (!IsZero(r))
           inexact = true;
-        } else {
-          RmGuard rg(this, rm);
-          c = SoftFloat::Div<FT>(a, b);
+      }
+      if (!quiet && !underflow) {
+        if (MayResultFromUnderflow(c)) [[unlikely]] {
+          c = SoftFloat::Div<FT, rm>(a, b);
         }
       }
-      return c;
-    }
-    if (IsSnan(a) || IsSnan(b))
-      invalid = true;
-    if (IsNan(a) || IsNan(b))
-      return PropagateNan<FT>(a, b);
-    invalid = true;
-    return GetQnan<FT>();
-  }
-
-  if (IsInf(b)) [[unlikely]]
-    return c;
-
-  if constexpr (rm == kRoundTiesToEven) {
-    if (!inexact) [[unlikely]] {
+    } else {
       auto r = UpDiv<FT, rm>(a, b, c);
-      if (!IsZero(r))
+      if (!IsZero(r)) {
         inexact = true;
-    }
-    if (!underflow) {
-      if (MayResultFromUnderflow(c)) [[unlikely]] {
-        RmGuard rg(this, rm);
-        c = SoftFloat::Div<FT>(a, b);
-      }
-    }
-  } else {
-    auto r = UpDiv<FT, rm>(a, b, c);
-    if (!IsZero(r)) {
-      inexact = true;
-      c = RoundResult<FT, typename TwiceWidthType<FT>::type, rm>(r, c);
-      if (!underflow &&  MayResultFromUnderflow(c)) [[unlikely]] {
-        if (IsTiny(c)) [[likely]] {
-          if (!IsZero(r))
-            underflow = true;
-        } else {
-          RmGuard rg(this, rm);
-          c = SoftFloat::Div<FT>(a, b);
+        c = RoundResult<FT, typename TwiceWidthType<FT>::type, rm>(r, c);
+        if (!quiet && !underflow && MayResultFromUnderflow(c)) [[unlikely]] {
+          if (IsTiny(c)) [[likely]] {
+            if (!IsZero(r))
+              underflow = true;
+          } else {
+            c = SoftFloat::Div<FT, rm>(a, b);
+          }
         }
       }
     }
-  }
 
-  return c;
+    return c;
+  }
 }
 
 template f16 FloppyFloat::Div<f16, FloppyFloat::kRoundTiesToEven>(f16 a, f16 b);
@@ -737,6 +1567,11 @@ template f16 FloppyFloat::Div<f16, FloppyFloat::kRoundTowardPositive>(f16 a, f16
 template f16 FloppyFloat::Div<f16, FloppyFloat::kRoundTowardNegative>(f16 a, f16 b);
 template f16 FloppyFloat::Div<f16, FloppyFloat::kRoundTowardZero>(f16 a, f16 b);
 template f16 FloppyFloat::Div<f16, FloppyFloat::kRoundTiesToAway>(f16 a, f16 b);
+template bf16 FloppyFloat::Div<bf16, FloppyFloat::kRoundTiesToEven>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Div<bf16, FloppyFloat::kRoundTowardPositive>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Div<bf16, FloppyFloat::kRoundTowardNegative>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Div<bf16, FloppyFloat::kRoundTowardZero>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Div<bf16, FloppyFloat::kRoundTiesToAway>(bf16 a, bf16 b);
 
 template f32 FloppyFloat::Div<f32, FloppyFloat::kRoundTiesToEven>(f32 a, f32 b);
 template f32 FloppyFloat::Div<f32, FloppyFloat::kRoundTowardPositive>(f32 a, f32 b);
@@ -750,65 +1585,173 @@ template f64 FloppyFloat::Div<f64, FloppyFloat::kRoundTowardNegative>(f64 a, f64
 template f64 FloppyFloat::Div<f64, FloppyFloat::kRoundTowardZero>(f64 a, f64 b);
 template f64 FloppyFloat::Div<f64, FloppyFloat::kRoundTiesToAway>(f64 a, f64 b);
 
+template f128 FloppyFloat::Div<f128, FloppyFloat::kRoundTiesToEven>(f128 a, f128 b);
+template f128 FloppyFloat::Div<f128, FloppyFloat::kRoundTowardPositive>(f128 a, f128 b);
+template f128 FloppyFloat::Div<f128, FloppyFloat::kRoundTowardNegative>(f128 a, f128 b);
+template f128 FloppyFloat::Div<f128, FloppyFloat::kRoundTowardZero>(f128 a, f128 b);
+template f128 FloppyFloat::Div<f128, FloppyFloat::kRoundTiesToAway>(f128 a, f128 b);
+
+template f16 FloppyFloat::Div<f16, FloppyFloat::kRoundTiesToEven, true>(f16 a, f16 b);
+template f16 FloppyFloat::Div<f16, FloppyFloat::kRoundTowardPositive, true>(f16 a, f16 b);
+template f16 FloppyFloat::Div<f16, FloppyFloat::kRoundTowardNegative, true>(f16 a, f16 b);
+template f16 FloppyFloat::Div<f16, FloppyFloat::kRoundTowardZero, true>(f16 a, f16 b);
+template f16 FloppyFloat::Div<f16, FloppyFloat::kRoundTiesToAway, true>(f16 a, f16 b);
+template bf16 FloppyFloat::Div<bf16, FloppyFloat::kRoundTiesToEven, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Div<bf16, FloppyFloat::kRoundTowardPositive, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Div<bf16, FloppyFloat::kRoundTowardNegative, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Div<bf16, FloppyFloat::kRoundTowardZero, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Div<bf16, FloppyFloat::kRoundTiesToAway, true>(bf16 a, bf16 b);
+
+template f32 FloppyFloat::Div<f32, FloppyFloat::kRoundTiesToEven, true>(f32 a, f32 b);
+template f32 FloppyFloat::Div<f32, FloppyFloat::kRoundTowardPositive, true>(f32 a, f32 b);
+template f32 FloppyFloat::Div<f32, FloppyFloat::kRoundTowardNegative, true>(f32 a, f32 b);
+template f32 FloppyFloat::Div<f32, FloppyFloat::kRoundTowardZero, true>(f32 a, f32 b);
+template f32 FloppyFloat::Div<f32, FloppyFloat::kRoundTiesToAway, true>(f32 a, f32 b);
+
+template f64 FloppyFloat::Div<f64, FloppyFloat::kRoundTiesToEven, true>(f64 a, f64 b);
+template f64 FloppyFloat::Div<f64, FloppyFloat::kRoundTowardPositive, true>(f64 a, f64 b);
+template f64 FloppyFloat::Div<f64, FloppyFloat::kRoundTowardNegative, true>(f64 a, f64 b);
+template f64 FloppyFloat::Div<f64, FloppyFloat::kRoundTowardZero, true>(f64 a, f64 b);
+template f64 FloppyFloat::Div<f64, FloppyFloat::kRoundTiesToAway, true>(f64 a, f64 b);
+
+template f128 FloppyFloat::Div<f128, FloppyFloat::kRoundTiesToEven, true>(f128 a, f128 b);
+template f128 FloppyFloat::Div<f128, FloppyFloat::kRoundTowardPositive, true>(f128 a, f128 b);
+template f128 FloppyFloat::Div<f128, FloppyFloat::kRoundTowardNegative, true>(f128 a, f128 b);
+template f128 FloppyFloat::Div<f128, FloppyFloat::kRoundTowardZero, true>(f128 a, f128 b);
+template f128 FloppyFloat::Div<f128, FloppyFloat::kRoundTiesToAway, true>(f128 a, f128 b);
+
+template f16 FloppyFloat::Div<f16, FloppyFloat::kRoundTiesToEven, false, true>(f16 a, f16 b);
+template f16 FloppyFloat::Div<f16, FloppyFloat::kRoundTowardPositive, false, true>(f16 a, f16 b);
+template f16 FloppyFloat::Div<f16, FloppyFloat::kRoundTowardNegative, false, true>(f16 a, f16 b);
+template f16 FloppyFloat::Div<f16, FloppyFloat::kRoundTowardZero, false, true>(f16 a, f16 b);
+template f16 FloppyFloat::Div<f16, FloppyFloat::kRoundTiesToAway, false, true>(f16 a, f16 b);
+template bf16 FloppyFloat::Div<bf16, FloppyFloat::kRoundTiesToEven, false, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Div<bf16, FloppyFloat::kRoundTowardPositive, false, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Div<bf16, FloppyFloat::kRoundTowardNegative, false, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Div<bf16, FloppyFloat::kRoundTowardZero, false, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Div<bf16, FloppyFloat::kRoundTiesToAway, false, true>(bf16 a, bf16 b);
+
+template f32 FloppyFloat::Div<f32, FloppyFloat::kRoundTiesToEven, false, true>(f32 a, f32 b);
+template f32 FloppyFloat::Div<f32, FloppyFloat::kRoundTowardPositive, false, true>(f32 a, f32 b);
+template f32 FloppyFloat::Div<f32, FloppyFloat::kRoundTowardNegative, false, true>(f32 a, f32 b);
+template f32 FloppyFloat::Div<f32, FloppyFloat::kRoundTowardZero, false, true>(f32 a, f32 b);
+template f32 FloppyFloat::Div<f32, FloppyFloat::kRoundTiesToAway, false, true>(f32 a, f32 b);
+
+template f64 FloppyFloat::Div<f64, FloppyFloat::kRoundTiesToEven, false, true>(f64 a, f64 b);
+template f64 FloppyFloat::Div<f64, FloppyFloat::kRoundTowardPositive, false, true>(f64 a, f64 b);
+template f64 FloppyFloat::Div<f64, FloppyFloat::kRoundTowardNegative, false, true>(f64 a, f64 b);
+template f64 FloppyFloat::Div<f64, FloppyFloat::kRoundTowardZero, false, true>(f64 a, f64 b);
+template f64 FloppyFloat::Div<f64, FloppyFloat::kRoundTiesToAway, false, true>(f64 a, f64 b);
+
+template f128 FloppyFloat::Div<f128, FloppyFloat::kRoundTiesToEven, false, true>(f128 a, f128 b);
+template f128 FloppyFloat::Div<f128, FloppyFloat::kRoundTowardPositive, false, true>(f128 a, f128 b);
+template f128 FloppyFloat::Div<f128, FloppyFloat::kRoundTowardNegative, false, true>(f128 a, f128 b);
+template f128 FloppyFloat::Div<f128, FloppyFloat::kRoundTowardZero, false, true>(f128 a, f128 b);
+template f128 FloppyFloat::Div<f128, FloppyFloat::kRoundTiesToAway, false, true>(f128 a, f128 b);
+
+template f16 FloppyFloat::Div<f16, FloppyFloat::kRoundTiesToEven, true, true>(f16 a, f16 b);
+template f16 FloppyFloat::Div<f16, FloppyFloat::kRoundTowardPositive, true, true>(f16 a, f16 b);
+template f16 FloppyFloat::Div<f16, FloppyFloat::kRoundTowardNegative, true, true>(f16 a, f16 b);
+template f16 FloppyFloat::Div<f16, FloppyFloat::kRoundTowardZero, true, true>(f16 a, f16 b);
+template f16 FloppyFloat::Div<f16, FloppyFloat::kRoundTiesToAway, true, true>(f16 a, f16 b);
+template bf16 FloppyFloat::Div<bf16, FloppyFloat::kRoundTiesToEven, true, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Div<bf16, FloppyFloat::kRoundTowardPositive, true, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Div<bf16, FloppyFloat::kRoundTowardNegative, true, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Div<bf16, FloppyFloat::kRoundTowardZero, true, true>(bf16 a, bf16 b);
+template bf16 FloppyFloat::Div<bf16, FloppyFloat::kRoundTiesToAway, true, true>(bf16 a, bf16 b);
+
+template f32 FloppyFloat::Div<f32, FloppyFloat::kRoundTiesToEven, true, true>(f32 a, f32 b);
+template f32 FloppyFloat::Div<f32, FloppyFloat::kRoundTowardPositive, true, true>(f32 a, f32 b);
+template f32 FloppyFloat::Div<f32, FloppyFloat::kRoundTowardNegative, true, true>(f32 a, f32 b);
+template f32 FloppyFloat::Div<f32, FloppyFloat::kRoundTowardZero, true, true>(f32 a, f32 b);
+template f32 FloppyFloat::Div<f32, FloppyFloat::kRoundTiesToAway, true, true>(f32 a, f32 b);
+
+template f64 FloppyFloat::Div<f64, FloppyFloat::kRoundTiesToEven, true, true>(f64 a, f64 b);
+template f64 FloppyFloat::Div<f64, FloppyFloat::kRoundTowardPositive, true, true>(f64 a, f64 b);
+template f64 FloppyFloat::Div<f64, FloppyFloat::kRoundTowardNegative, true, true>(f64 a, f64 b);
+template f64 FloppyFloat::Div<f64, FloppyFloat::kRoundTowardZero, true, true>(f64 a, f64 b);
+template f64 FloppyFloat::Div<f64, FloppyFloat::kRoundTiesToAway, true, true>(f64 a, f64 b);
+
+template f128 FloppyFloat::Div<f128, FloppyFloat::kRoundTiesToEven, true, true>(f128 a, f128 b);
+template f128 FloppyFloat::Div<f128, FloppyFloat::kRoundTowardPositive, true, true>(f128 a, f128 b);
+template f128 FloppyFloat::Div<f128, FloppyFloat::kRoundTowardNegative, true, true>(f128 a, f128 b);
+template f128 FloppyFloat::Div<f128, FloppyFloat::kRoundTowardZero, true, true>(f128 a, f128 b);
+template f128 FloppyFloat::Div<f128, FloppyFloat::kRoundTiesToAway, true, true>(f128 a, f128 b);
+
 template <typename FT>
 FT FloppyFloat::Sqrt(FT a) {
   switch (rounding_mode) {
   case kRoundTiesToEven:
-    return Sqrt<FT, kRoundTiesToEven>(a);
+    return Sqrt<FT, kRoundTiesToEven, false, true>(a);
   case kRoundTiesToAway:
-    return Sqrt<FT, kRoundTiesToAway>(a);
+    return Sqrt<FT, kRoundTiesToAway, false, true>(a);
   case kRoundTowardPositive:
-    return Sqrt<FT, kRoundTowardPositive>(a);
+    return Sqrt<FT, kRoundTowardPositive, false, true>(a);
   case kRoundTowardNegative:
-    return Sqrt<FT, kRoundTowardNegative>(a);
+    return Sqrt<FT, kRoundTowardNegative, false, true>(a);
   case kRoundTowardZero:
-    return Sqrt<FT, kRoundTowardZero>(a);
+    return Sqrt<FT, kRoundTowardZero, false, true>(a);
   default:
     throw std::runtime_error(std::string("Unknown rounding mode"));
   }
 }
 
 template f16 FloppyFloat::Sqrt<f16>(f16 a);
+template bf16 FloppyFloat::Sqrt<bf16>(bf16 a);
 template f32 FloppyFloat::Sqrt<f32>(f32 a);
 template f64 FloppyFloat::Sqrt<f64>(f64 a);
+template f128 FloppyFloat::Sqrt<f128>(f128 a);
 
-template <typename FT, FloppyFloat::RoundingMode rm>
+template <typename FT, FloppyFloat::RoundingMode rm, bool quiet, bool flush>
 FT FloppyFloat::Sqrt(FT a) {
-  if constexpr (rm == kRoundTiesToAway) {
-    RmGuard rg(this, rm);
-    return SoftFloat::Sqrt(a);
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  if constexpr (flush) {
+    if (ChecksDenormals<FT>(a))
+      return FlushDenormals<FT>([this](FT x) { return Sqrt<FT, rm>(x); }, [](FT) { return false; }, a);
   }
+  if constexpr (std::is_same_v<FT, f128>) {
+    return SqrtF128<rm>(a);
+  } else if constexpr (std::is_same_v<FT, f16> || std::is_same_v<FT, bf16>) {
+    f64 b = std::sqrt(WidenToF64(a));
+    if (IsInfOrNan(b)) [[unlikely]]
+      return InfOrNanF64(b, a, a);
+    return RoundF64<FT, rm>(b);
+  } else {
+    if constexpr (rm == kRoundTiesToAway) {
+      return SoftFloat::Sqrt<FT, rm>(a);
+    }
 
-  FT b = std::sqrt(a);
+    FT b = std::sqrt(a);
 
-  if (IsNan(b)) [[unlikely]] {
-    if (IsSnan(a))
+    if (IsNan(b)) [[unlikely]] {
+      if (IsSnan(a))
+        invalid = true;
+      if (IsNan(a))
+        return PropagateNan<FT>(a, a);
       invalid = true;
-    if (IsNan(a))
-      return PropagateNan<FT>(a, a);
-    invalid = true;
-    return GetQnan<FT>();
-  }
+      return GetQnan<FT>();
+    }
 
-  if constexpr (rm == kRoundTiesToEven) {
-    if (!inexact) [[unlikely]] {
+    if constexpr (rm == kRoundTiesToEven) {
+      if (!quiet && !inexact) [[unlikely]] {
+        if (IsInf(a)) [[unlikely]]
+          return b;
+        auto r = UpSqrt<FT, rm>(a, b);
+        if (!IsZero(r))
+          inexact = true;
+      }
+    } else {
       if (IsInf(a)) [[unlikely]]
         return b;
       auto r = UpSqrt<FT, rm>(a, b);
-      if (!IsZero(r))
+      if (!IsZero(r)) {
         inexact = true;
+        b = RoundResult<FT, typename TwiceWidthType<FT>::type, rm>(r, b);
+      }
     }
-  } else {
-    if (IsInf(a)) [[unlikely]]
-      return b;
-    auto r = UpSqrt<FT, rm>(a, b);
-    if (!IsZero(r)) {
-      inexact = true;
-      b = RoundResult<FT, typename TwiceWidthType<FT>::type, rm>(r, b);
-    }
-  }
 
-  return b;
+    return b;
+  }
 }
 
 template f16 FloppyFloat::Sqrt<f16, FloppyFloat::kRoundTiesToEven>(f16 a);
@@ -816,6 +1759,11 @@ template f16 FloppyFloat::Sqrt<f16, FloppyFloat::kRoundTowardPositive>(f16 a);
 template f16 FloppyFloat::Sqrt<f16, FloppyFloat::kRoundTowardNegative>(f16 a);
 template f16 FloppyFloat::Sqrt<f16, FloppyFloat::kRoundTowardZero>(f16 a);
 template f16 FloppyFloat::Sqrt<f16, FloppyFloat::kRoundTiesToAway>(f16 a);
+template bf16 FloppyFloat::Sqrt<bf16, FloppyFloat::kRoundTiesToEven>(bf16 a);
+template bf16 FloppyFloat::Sqrt<bf16, FloppyFloat::kRoundTowardPositive>(bf16 a);
+template bf16 FloppyFloat::Sqrt<bf16, FloppyFloat::kRoundTowardNegative>(bf16 a);
+template bf16 FloppyFloat::Sqrt<bf16, FloppyFloat::kRoundTowardZero>(bf16 a);
+template bf16 FloppyFloat::Sqrt<bf16, FloppyFloat::kRoundTiesToAway>(bf16 a);
 
 template f32 FloppyFloat::Sqrt<f32, FloppyFloat::kRoundTiesToEven>(f32 a);
 template f32 FloppyFloat::Sqrt<f32, FloppyFloat::kRoundTowardPositive>(f32 a);
@@ -829,98 +1777,197 @@ template f64 FloppyFloat::Sqrt<f64, FloppyFloat::kRoundTowardNegative>(f64 a);
 template f64 FloppyFloat::Sqrt<f64, FloppyFloat::kRoundTowardZero>(f64 a);
 template f64 FloppyFloat::Sqrt<f64, FloppyFloat::kRoundTiesToAway>(f64 a);
 
+template f128 FloppyFloat::Sqrt<f128, FloppyFloat::kRoundTiesToEven>(f128 a);
+template f128 FloppyFloat::Sqrt<f128, FloppyFloat::kRoundTowardPositive>(f128 a);
+template f128 FloppyFloat::Sqrt<f128, FloppyFloat::kRoundTowardNegative>(f128 a);
+template f128 FloppyFloat::Sqrt<f128, FloppyFloat::kRoundTowardZero>(f128 a);
+template f128 FloppyFloat::Sqrt<f128, FloppyFloat::kRoundTiesToAway>(f128 a);
+
+template f16 FloppyFloat::Sqrt<f16, FloppyFloat::kRoundTiesToEven, true>(f16 a);
+template f16 FloppyFloat::Sqrt<f16, FloppyFloat::kRoundTowardPositive, true>(f16 a);
+template f16 FloppyFloat::Sqrt<f16, FloppyFloat::kRoundTowardNegative, true>(f16 a);
+template f16 FloppyFloat::Sqrt<f16, FloppyFloat::kRoundTowardZero, true>(f16 a);
+template f16 FloppyFloat::Sqrt<f16, FloppyFloat::kRoundTiesToAway, true>(f16 a);
+template bf16 FloppyFloat::Sqrt<bf16, FloppyFloat::kRoundTiesToEven, true>(bf16 a);
+template bf16 FloppyFloat::Sqrt<bf16, FloppyFloat::kRoundTowardPositive, true>(bf16 a);
+template bf16 FloppyFloat::Sqrt<bf16, FloppyFloat::kRoundTowardNegative, true>(bf16 a);
+template bf16 FloppyFloat::Sqrt<bf16, FloppyFloat::kRoundTowardZero, true>(bf16 a);
+template bf16 FloppyFloat::Sqrt<bf16, FloppyFloat::kRoundTiesToAway, true>(bf16 a);
+
+template f32 FloppyFloat::Sqrt<f32, FloppyFloat::kRoundTiesToEven, true>(f32 a);
+template f32 FloppyFloat::Sqrt<f32, FloppyFloat::kRoundTowardPositive, true>(f32 a);
+template f32 FloppyFloat::Sqrt<f32, FloppyFloat::kRoundTowardNegative, true>(f32 a);
+template f32 FloppyFloat::Sqrt<f32, FloppyFloat::kRoundTowardZero, true>(f32 a);
+template f32 FloppyFloat::Sqrt<f32, FloppyFloat::kRoundTiesToAway, true>(f32 a);
+
+template f64 FloppyFloat::Sqrt<f64, FloppyFloat::kRoundTiesToEven, true>(f64 a);
+template f64 FloppyFloat::Sqrt<f64, FloppyFloat::kRoundTowardPositive, true>(f64 a);
+template f64 FloppyFloat::Sqrt<f64, FloppyFloat::kRoundTowardNegative, true>(f64 a);
+template f64 FloppyFloat::Sqrt<f64, FloppyFloat::kRoundTowardZero, true>(f64 a);
+template f64 FloppyFloat::Sqrt<f64, FloppyFloat::kRoundTiesToAway, true>(f64 a);
+
+template f128 FloppyFloat::Sqrt<f128, FloppyFloat::kRoundTiesToEven, true>(f128 a);
+template f128 FloppyFloat::Sqrt<f128, FloppyFloat::kRoundTowardPositive, true>(f128 a);
+template f128 FloppyFloat::Sqrt<f128, FloppyFloat::kRoundTowardNegative, true>(f128 a);
+template f128 FloppyFloat::Sqrt<f128, FloppyFloat::kRoundTowardZero, true>(f128 a);
+template f128 FloppyFloat::Sqrt<f128, FloppyFloat::kRoundTiesToAway, true>(f128 a);
+
+template f16 FloppyFloat::Sqrt<f16, FloppyFloat::kRoundTiesToEven, false, true>(f16 a);
+template f16 FloppyFloat::Sqrt<f16, FloppyFloat::kRoundTowardPositive, false, true>(f16 a);
+template f16 FloppyFloat::Sqrt<f16, FloppyFloat::kRoundTowardNegative, false, true>(f16 a);
+template f16 FloppyFloat::Sqrt<f16, FloppyFloat::kRoundTowardZero, false, true>(f16 a);
+template f16 FloppyFloat::Sqrt<f16, FloppyFloat::kRoundTiesToAway, false, true>(f16 a);
+template bf16 FloppyFloat::Sqrt<bf16, FloppyFloat::kRoundTiesToEven, false, true>(bf16 a);
+template bf16 FloppyFloat::Sqrt<bf16, FloppyFloat::kRoundTowardPositive, false, true>(bf16 a);
+template bf16 FloppyFloat::Sqrt<bf16, FloppyFloat::kRoundTowardNegative, false, true>(bf16 a);
+template bf16 FloppyFloat::Sqrt<bf16, FloppyFloat::kRoundTowardZero, false, true>(bf16 a);
+template bf16 FloppyFloat::Sqrt<bf16, FloppyFloat::kRoundTiesToAway, false, true>(bf16 a);
+
+template f32 FloppyFloat::Sqrt<f32, FloppyFloat::kRoundTiesToEven, false, true>(f32 a);
+template f32 FloppyFloat::Sqrt<f32, FloppyFloat::kRoundTowardPositive, false, true>(f32 a);
+template f32 FloppyFloat::Sqrt<f32, FloppyFloat::kRoundTowardNegative, false, true>(f32 a);
+template f32 FloppyFloat::Sqrt<f32, FloppyFloat::kRoundTowardZero, false, true>(f32 a);
+template f32 FloppyFloat::Sqrt<f32, FloppyFloat::kRoundTiesToAway, false, true>(f32 a);
+
+template f64 FloppyFloat::Sqrt<f64, FloppyFloat::kRoundTiesToEven, false, true>(f64 a);
+template f64 FloppyFloat::Sqrt<f64, FloppyFloat::kRoundTowardPositive, false, true>(f64 a);
+template f64 FloppyFloat::Sqrt<f64, FloppyFloat::kRoundTowardNegative, false, true>(f64 a);
+template f64 FloppyFloat::Sqrt<f64, FloppyFloat::kRoundTowardZero, false, true>(f64 a);
+template f64 FloppyFloat::Sqrt<f64, FloppyFloat::kRoundTiesToAway, false, true>(f64 a);
+
+template f128 FloppyFloat::Sqrt<f128, FloppyFloat::kRoundTiesToEven, false, true>(f128 a);
+template f128 FloppyFloat::Sqrt<f128, FloppyFloat::kRoundTowardPositive, false, true>(f128 a);
+template f128 FloppyFloat::Sqrt<f128, FloppyFloat::kRoundTowardNegative, false, true>(f128 a);
+template f128 FloppyFloat::Sqrt<f128, FloppyFloat::kRoundTowardZero, false, true>(f128 a);
+template f128 FloppyFloat::Sqrt<f128, FloppyFloat::kRoundTiesToAway, false, true>(f128 a);
+
+template f16 FloppyFloat::Sqrt<f16, FloppyFloat::kRoundTiesToEven, true, true>(f16 a);
+template f16 FloppyFloat::Sqrt<f16, FloppyFloat::kRoundTowardPositive, true, true>(f16 a);
+template f16 FloppyFloat::Sqrt<f16, FloppyFloat::kRoundTowardNegative, true, true>(f16 a);
+template f16 FloppyFloat::Sqrt<f16, FloppyFloat::kRoundTowardZero, true, true>(f16 a);
+template f16 FloppyFloat::Sqrt<f16, FloppyFloat::kRoundTiesToAway, true, true>(f16 a);
+template bf16 FloppyFloat::Sqrt<bf16, FloppyFloat::kRoundTiesToEven, true, true>(bf16 a);
+template bf16 FloppyFloat::Sqrt<bf16, FloppyFloat::kRoundTowardPositive, true, true>(bf16 a);
+template bf16 FloppyFloat::Sqrt<bf16, FloppyFloat::kRoundTowardNegative, true, true>(bf16 a);
+template bf16 FloppyFloat::Sqrt<bf16, FloppyFloat::kRoundTowardZero, true, true>(bf16 a);
+template bf16 FloppyFloat::Sqrt<bf16, FloppyFloat::kRoundTiesToAway, true, true>(bf16 a);
+
+template f32 FloppyFloat::Sqrt<f32, FloppyFloat::kRoundTiesToEven, true, true>(f32 a);
+template f32 FloppyFloat::Sqrt<f32, FloppyFloat::kRoundTowardPositive, true, true>(f32 a);
+template f32 FloppyFloat::Sqrt<f32, FloppyFloat::kRoundTowardNegative, true, true>(f32 a);
+template f32 FloppyFloat::Sqrt<f32, FloppyFloat::kRoundTowardZero, true, true>(f32 a);
+template f32 FloppyFloat::Sqrt<f32, FloppyFloat::kRoundTiesToAway, true, true>(f32 a);
+
+template f64 FloppyFloat::Sqrt<f64, FloppyFloat::kRoundTiesToEven, true, true>(f64 a);
+template f64 FloppyFloat::Sqrt<f64, FloppyFloat::kRoundTowardPositive, true, true>(f64 a);
+template f64 FloppyFloat::Sqrt<f64, FloppyFloat::kRoundTowardNegative, true, true>(f64 a);
+template f64 FloppyFloat::Sqrt<f64, FloppyFloat::kRoundTowardZero, true, true>(f64 a);
+template f64 FloppyFloat::Sqrt<f64, FloppyFloat::kRoundTiesToAway, true, true>(f64 a);
+
+template f128 FloppyFloat::Sqrt<f128, FloppyFloat::kRoundTiesToEven, true, true>(f128 a);
+template f128 FloppyFloat::Sqrt<f128, FloppyFloat::kRoundTowardPositive, true, true>(f128 a);
+template f128 FloppyFloat::Sqrt<f128, FloppyFloat::kRoundTowardNegative, true, true>(f128 a);
+template f128 FloppyFloat::Sqrt<f128, FloppyFloat::kRoundTowardZero, true, true>(f128 a);
+template f128 FloppyFloat::Sqrt<f128, FloppyFloat::kRoundTiesToAway, true, true>(f128 a);
+
 template <typename FT>
 FT FloppyFloat::Fma(FT a, FT b, FT c) {
   switch (rounding_mode) {
   case kRoundTiesToEven:
-    return Fma<FT, kRoundTiesToEven>(a, b, c);
+    return Fma<FT, kRoundTiesToEven, false, true>(a, b, c);
   case kRoundTiesToAway:
-    return Fma<FT, kRoundTiesToAway>(a, b, c);
+    return Fma<FT, kRoundTiesToAway, false, true>(a, b, c);
   case kRoundTowardPositive:
-    return Fma<FT, kRoundTowardPositive>(a, b, c);
+    return Fma<FT, kRoundTowardPositive, false, true>(a, b, c);
   case kRoundTowardNegative:
-    return Fma<FT, kRoundTowardNegative>(a, b, c);
+    return Fma<FT, kRoundTowardNegative, false, true>(a, b, c);
   case kRoundTowardZero:
-    return Fma<FT, kRoundTowardZero>(a, b, c);
+    return Fma<FT, kRoundTowardZero, false, true>(a, b, c);
   default:
     throw std::runtime_error(std::string("Unknown rounding mode"));
   }
 }
 
 template f16 FloppyFloat::Fma<f16>(f16 a, f16 b, f16 c);
+template bf16 FloppyFloat::Fma<bf16>(bf16 a, bf16 b, bf16 c);
 template f32 FloppyFloat::Fma<f32>(f32 a, f32 b, f32 c);
 template f64 FloppyFloat::Fma<f64>(f64 a, f64 b, f64 c);
+template f128 FloppyFloat::Fma<f128>(f128 a, f128 b, f128 c);
 
-template <typename FT, FloppyFloat::RoundingMode rm>
+template <typename FT, FloppyFloat::RoundingMode rm, bool quiet, bool flush>
 FT FloppyFloat::Fma(FT a, FT b, FT c) {
-  if constexpr (std::is_same_v<FT, f16> || (rm == kRoundTiesToAway)) {
-    // TODO: Remove once the f16 FMA issue of the standard library is solved.
-    RmGuard rg(this, rm);
-    return SoftFloat::Fma<FT>(a, b, c);
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  if constexpr (flush) {
+    if (ChecksDenormals<FT>(a, b, c))
+      return FlushDenormals<FT>([this](FT x, FT y, FT z) { return Fma<FT, rm>(x, y, z); },
+                                [](FT, FT, FT) { return false; }, a, b, c);
   }
-
-  FT d = std::fma(a, b, c);
-
-  if (IsInfOrNan(d)) [[unlikely]] {
-    if (IsInf(d)) {
-      if (!IsInf(a) && !IsInf(b) && !IsInf(c)) {
-        if constexpr (rm == FloppyFloat::kRoundTiesToEven) {
-          overflow = true;
-          inexact = true;
-        } else {
-          RmGuard rg(this, rm);
-          d = SoftFloat::Fma(a, b, c);
+  if constexpr (std::is_same_v<FT, f128>) {
+    return FmaF128<rm>(a, b, c);
+  } else if constexpr (std::is_same_v<FT, f16> || std::is_same_v<FT, bf16> || (rm == kRoundTiesToAway)) {
+    // TODO: Remove once the f16 FMA issue of the standard library is solved.
+    return SoftFloat::Fma<FT, rm>(a, b, c);
+  } else {
+    FT d = std::fma(a, b, c);
+
+    if (IsInfOrNan(d)) [[unlikely]] {
+      if (IsInf(d)) {
+        if (!IsInf(a) && !IsInf(b) && !IsInf(c)) {
+          if constexpr (rm == FloppyFloat::kRoundTiesToEven) {
+            overflow = true;
+            inexact = true;
+          } else {
+            d = SoftFloat::Fma<FT, rm>(a, b, c);
+          }
         }
+        return d;
       }
-      return d;
-    }
-    if ((IsZero(a) && IsInf(b)) || (IsZero(b) && IsInf(a)))
-      invalid = invalid_fma ? true : invalid;
-    if (IsSnan(a) || IsSnan(b) || IsSnan(c))
+      if ((IsZero(a) && IsInf(b)) || (IsZero(b) && IsInf(a)))
+        invalid = invalid_fma ? true : invalid;
+      if (IsSnan(a) || IsSnan(b) || IsSnan(c))
+        invalid = true;
+      if (IsNan(a) || IsNan(b) || IsNan(c))
+        return PropagateNan<FT>(a, b, c);
       invalid = true;
-    if (IsNan(a) || IsNan(b) || IsNan(c))
-      return PropagateNan<FT>(a, b, c);
-    invalid = true;
-    return GetQnan<FT>();
-  }
+      return GetQnan<FT>();
+    }
 
-  if constexpr (rm == kRoundTowardNegative) {
-    if (IsZero(d) && !std::signbit(d)) [[unlikely]] {
-      if ((std::signbit(a) != std::signbit(b)) || std::signbit(c))
-        d = -d;
+    if constexpr (rm == kRoundTowardNegative) {
+      if (IsZero(d) && !std::signbit(d)) [[unlikely]] {
+        if ((std::signbit(a) != std::signbit(b)) || std::signbit(c))
+          d = -d;
+      }
     }
-  }
 
-  if constexpr (rm == kRoundTiesToEven) {
-    if (!inexact) [[unlikely]] {
+    if constexpr (rm == kRoundTiesToEven) {
+      if (!quiet && !inexact) [[unlikely]] {
+        auto r = UpFma<FT, rm>(a, b, c, d);
+        if (!IsZero(r))
+          inexact = true;
+      }
+      if (!quiet && !underflow) {
+        if (MayResultFromUnderflow(d)) [[unlikely]] {
+          d = SoftFloat::Fma<FT, rm>(a, b, c);
+        }
+      }
+    } else {
       auto r = UpFma<FT, rm>(a, b, c, d);
-      if (!IsZero(r))
+      if (!IsZero(r)) {
         inexact = true;
-    }
-    if (!underflow) {
-      if (MayResultFromUnderflow(d)) [[unlikely]] {
-        RmGuard rg(this, rm);
-        d = SoftFloat::Fma(a, b, c);
-      }
-    }
-  } else {
-    auto r = UpFma<FT, rm>(a, b, c, d);
-    if (!IsZero(r)) {
-      inexact = true;
-      d = RoundResult<FT, typename TwiceWidthType<FT>::type, rm>(r, d);
-      if (!underflow && MayResultFromUnderflow(d)) [[unlikely]] {
-        if (IsTiny(d)) [[likely]] {
-          if (!IsZero(r))
-            underflow = true;
-        } else {
-          RmGuard rg(this, rm);
-          d = SoftFloat::Fma<FT>(a, b, c);
+        d = RoundResult<FT, typename TwiceWidthType<FT>::type, rm>(r, d);
+        if (!quiet && !underflow && MayResultFromUnderflow(d)) [[unlikely]] {
+          if (IsTiny(d)) [[likely]] {
+            if (!IsZero(r))
+              underflow = true;
+          } else {
+            d = SoftFloat::Fma<FT, rm>(a, b, c);
+          }
         }
       }
     }
-  }
 
-  return d;
+    return d;
+  }
 }
 
 template f16 FloppyFloat::Fma<f16, FloppyFloat::kRoundTiesToEven>(f16 a, f16 b, f16 c);
@@ -928,6 +1975,11 @@ template f16 FloppyFloat::Fma<f16, FloppyFloat::kRoundTowardPositive>(f16 a, f16
 template f16 FloppyFloat::Fma<f16, FloppyFloat::kRoundTowardNegative>(f16 a, f16 b, f16 c);
 template f16 FloppyFloat::Fma<f16, FloppyFloat::kRoundTowardZero>(f16 a, f16 b, f16 c);
 template f16 FloppyFloat::Fma<f16, FloppyFloat::kRoundTiesToAway>(f16 a, f16 b, f16 c);
+template bf16 FloppyFloat::Fma<bf16, FloppyFloat::kRoundTiesToEven>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fma<bf16, FloppyFloat::kRoundTowardPositive>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fma<bf16, FloppyFloat::kRoundTowardNegative>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fma<bf16, FloppyFloat::kRoundTowardZero>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fma<bf16, FloppyFloat::kRoundTiesToAway>(bf16 a, bf16 b, bf16 c);
 
 template f32 FloppyFloat::Fma<f32, FloppyFloat::kRoundTiesToEven>(f32 a, f32 b, f32 c);
 template f32 FloppyFloat::Fma<f32, FloppyFloat::kRoundTowardPositive>(f32 a, f32 b, f32 c);
@@ -941,8 +1993,570 @@ template f64 FloppyFloat::Fma<f64, FloppyFloat::kRoundTowardNegative>(f64 a, f64
 template f64 FloppyFloat::Fma<f64, FloppyFloat::kRoundTowardZero>(f64 a, f64 b, f64 c);
 template f64 FloppyFloat::Fma<f64, FloppyFloat::kRoundTiesToAway>(f64 a, f64 b, f64 c);
 
+template f128 FloppyFloat::Fma<f128, FloppyFloat::kRoundTiesToEven>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fma<f128, FloppyFloat::kRoundTowardPositive>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fma<f128, FloppyFloat::kRoundTowardNegative>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fma<f128, FloppyFloat::kRoundTowardZero>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fma<f128, FloppyFloat::kRoundTiesToAway>(f128 a, f128 b, f128 c);
+
+template f16 FloppyFloat::Fma<f16, FloppyFloat::kRoundTiesToEven, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fma<f16, FloppyFloat::kRoundTowardPositive, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fma<f16, FloppyFloat::kRoundTowardNegative, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fma<f16, FloppyFloat::kRoundTowardZero, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fma<f16, FloppyFloat::kRoundTiesToAway, true>(f16 a, f16 b, f16 c);
+template bf16 FloppyFloat::Fma<bf16, FloppyFloat::kRoundTiesToEven, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fma<bf16, FloppyFloat::kRoundTowardPositive, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fma<bf16, FloppyFloat::kRoundTowardNegative, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fma<bf16, FloppyFloat::kRoundTowardZero, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fma<bf16, FloppyFloat::kRoundTiesToAway, true>(bf16 a, bf16 b, bf16 c);
+
+template f32 FloppyFloat::Fma<f32, FloppyFloat::kRoundTiesToEven, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fma<f32, FloppyFloat::kRoundTowardPositive, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fma<f32, FloppyFloat::kRoundTowardNegative, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fma<f32, FloppyFloat::kRoundTowardZero, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fma<f32, FloppyFloat::kRoundTiesToAway, true>(f32 a, f32 b, f32 c);
+
+template f64 FloppyFloat::Fma<f64, FloppyFloat::kRoundTiesToEven, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fma<f64, FloppyFloat::kRoundTowardPositive, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fma<f64, FloppyFloat::kRoundTowardNegative, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fma<f64, FloppyFloat::kRoundTowardZero, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fma<f64, FloppyFloat::kRoundTiesToAway, true>(f64 a, f64 b, f64 c);
+
+template f128 FloppyFloat::Fma<f128, FloppyFloat::kRoundTiesToEven, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fma<f128, FloppyFloat::kRoundTowardPositive, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fma<f128, FloppyFloat::kRoundTowardNegative, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fma<f128, FloppyFloat::kRoundTowardZero, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fma<f128, FloppyFloat::kRoundTiesToAway, true>(f128 a, f128 b, f128 c);
+
+template f16 FloppyFloat::Fma<f16, FloppyFloat::kRoundTiesToEven, false, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fma<f16, FloppyFloat::kRoundTowardPositive, false, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fma<f16, FloppyFloat::kRoundTowardNegative, false, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fma<f16, FloppyFloat::kRoundTowardZero, false, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fma<f16, FloppyFloat::kRoundTiesToAway, false, true>(f16 a, f16 b, f16 c);
+template bf16 FloppyFloat::Fma<bf16, FloppyFloat::kRoundTiesToEven, false, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fma<bf16, FloppyFloat::kRoundTowardPositive, false, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fma<bf16, FloppyFloat::kRoundTowardNegative, false, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fma<bf16, FloppyFloat::kRoundTowardZero, false, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fma<bf16, FloppyFloat::kRoundTiesToAway, false, true>(bf16 a, bf16 b, bf16 c);
+
+template f32 FloppyFloat::Fma<f32, FloppyFloat::kRoundTiesToEven, false, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fma<f32, FloppyFloat::kRoundTowardPositive, false, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fma<f32, FloppyFloat::kRoundTowardNegative, false, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fma<f32, FloppyFloat::kRoundTowardZero, false, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fma<f32, FloppyFloat::kRoundTiesToAway, false, true>(f32 a, f32 b, f32 c);
+
+template f64 FloppyFloat::Fma<f64, FloppyFloat::kRoundTiesToEven, false, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fma<f64, FloppyFloat::kRoundTowardPositive, false, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fma<f64, FloppyFloat::kRoundTowardNegative, false, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fma<f64, FloppyFloat::kRoundTowardZero, false, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fma<f64, FloppyFloat::kRoundTiesToAway, false, true>(f64 a, f64 b, f64 c);
+
+template f128 FloppyFloat::Fma<f128, FloppyFloat::kRoundTiesToEven, false, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fma<f128, FloppyFloat::kRoundTowardPositive, false, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fma<f128, FloppyFloat::kRoundTowardNegative, false, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fma<f128, FloppyFloat::kRoundTowardZero, false, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fma<f128, FloppyFloat::kRoundTiesToAway, false, true>(f128 a, f128 b, f128 c);
+
+template f16 FloppyFloat::Fma<f16, FloppyFloat::kRoundTiesToEven, true, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fma<f16, FloppyFloat::kRoundTowardPositive, true, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fma<f16, FloppyFloat::kRoundTowardNegative, true, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fma<f16, FloppyFloat::kRoundTowardZero, true, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fma<f16, FloppyFloat::kRoundTiesToAway, true, true>(f16 a, f16 b, f16 c);
+template bf16 FloppyFloat::Fma<bf16, FloppyFloat::kRoundTiesToEven, true, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fma<bf16, FloppyFloat::kRoundTowardPositive, true, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fma<bf16, FloppyFloat::kRoundTowardNegative, true, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fma<bf16, FloppyFloat::kRoundTowardZero, true, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fma<bf16, FloppyFloat::kRoundTiesToAway, true, true>(bf16 a, bf16 b, bf16 c);
+
+template f32 FloppyFloat::Fma<f32, FloppyFloat::kRoundTiesToEven, true, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fma<f32, FloppyFloat::kRoundTowardPositive, true, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fma<f32, FloppyFloat::kRoundTowardNegative, true, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fma<f32, FloppyFloat::kRoundTowardZero, true, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fma<f32, FloppyFloat::kRoundTiesToAway, true, true>(f32 a, f32 b, f32 c);
+
+template f64 FloppyFloat::Fma<f64, FloppyFloat::kRoundTiesToEven, true, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fma<f64, FloppyFloat::kRoundTowardPositive, true, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fma<f64, FloppyFloat::kRoundTowardNegative, true, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fma<f64, FloppyFloat::kRoundTowardZero, true, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fma<f64, FloppyFloat::kRoundTiesToAway, true, true>(f64 a, f64 b, f64 c);
+
+template f128 FloppyFloat::Fma<f128, FloppyFloat::kRoundTiesToEven, true, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fma<f128, FloppyFloat::kRoundTowardPositive, true, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fma<f128, FloppyFloat::kRoundTowardNegative, true, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fma<f128, FloppyFloat::kRoundTowardZero, true, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fma<f128, FloppyFloat::kRoundTiesToAway, true, true>(f128 a, f128 b, f128 c);
+
+// The negations are folded into the operands of Fma, which costs no more than the sign handling of the callers. Only
+// NaN results need another look: x86 propagates the NaN operands as they are, whereas Arm negates them first.
+template <typename FT, FloppyFloat::RoundingMode rm, bool quiet, bool flush>
+FT FloppyFloat::Fms(FT a, FT b, FT c) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  if constexpr (flush)
+    FlushInputs(a, b, c);  // The NaN propagation below must see the flushed operands.
+  const FT d = Fma<FT, rm, quiet, flush>(a, b, Negate(c));
+  if (IsNan(d) && nan_propagation_scheme == kNanPropX86sse) [[unlikely]]
+    return PropagateNan<FT>(a, b, c);
+  return d;
+}
+
+template f16 FloppyFloat::Fms<f16, FloppyFloat::kRoundTiesToEven>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fms<f16, FloppyFloat::kRoundTowardPositive>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fms<f16, FloppyFloat::kRoundTowardNegative>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fms<f16, FloppyFloat::kRoundTowardZero>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fms<f16, FloppyFloat::kRoundTiesToAway>(f16 a, f16 b, f16 c);
+
+template bf16 FloppyFloat::Fms<bf16, FloppyFloat::kRoundTiesToEven>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fms<bf16, FloppyFloat::kRoundTowardPositive>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fms<bf16, FloppyFloat::kRoundTowardNegative>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fms<bf16, FloppyFloat::kRoundTowardZero>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fms<bf16, FloppyFloat::kRoundTiesToAway>(bf16 a, bf16 b, bf16 c);
+
+template f32 FloppyFloat::Fms<f32, FloppyFloat::kRoundTiesToEven>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fms<f32, FloppyFloat::kRoundTowardPositive>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fms<f32, FloppyFloat::kRoundTowardNegative>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fms<f32, FloppyFloat::kRoundTowardZero>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fms<f32, FloppyFloat::kRoundTiesToAway>(f32 a, f32 b, f32 c);
+
+template f64 FloppyFloat::Fms<f64, FloppyFloat::kRoundTiesToEven>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fms<f64, FloppyFloat::kRoundTowardPositive>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fms<f64, FloppyFloat::kRoundTowardNegative>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fms<f64, FloppyFloat::kRoundTowardZero>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fms<f64, FloppyFloat::kRoundTiesToAway>(f64 a, f64 b, f64 c);
+
+template f128 FloppyFloat::Fms<f128, FloppyFloat::kRoundTiesToEven>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fms<f128, FloppyFloat::kRoundTowardPositive>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fms<f128, FloppyFloat::kRoundTowardNegative>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fms<f128, FloppyFloat::kRoundTowardZero>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fms<f128, FloppyFloat::kRoundTiesToAway>(f128 a, f128 b, f128 c);
+
+template f16 FloppyFloat::Fms<f16, FloppyFloat::kRoundTiesToEven, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fms<f16, FloppyFloat::kRoundTowardPositive, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fms<f16, FloppyFloat::kRoundTowardNegative, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fms<f16, FloppyFloat::kRoundTowardZero, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fms<f16, FloppyFloat::kRoundTiesToAway, true>(f16 a, f16 b, f16 c);
+
+template bf16 FloppyFloat::Fms<bf16, FloppyFloat::kRoundTiesToEven, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fms<bf16, FloppyFloat::kRoundTowardPositive, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fms<bf16, FloppyFloat::kRoundTowardNegative, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fms<bf16, FloppyFloat::kRoundTowardZero, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fms<bf16, FloppyFloat::kRoundTiesToAway, true>(bf16 a, bf16 b, bf16 c);
+
+template f32 FloppyFloat::Fms<f32, FloppyFloat::kRoundTiesToEven, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fms<f32, FloppyFloat::kRoundTowardPositive, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fms<f32, FloppyFloat::kRoundTowardNegative, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fms<f32, FloppyFloat::kRoundTowardZero, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fms<f32, FloppyFloat::kRoundTiesToAway, true>(f32 a, f32 b, f32 c);
+
+template f64 FloppyFloat::Fms<f64, FloppyFloat::kRoundTiesToEven, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fms<f64, FloppyFloat::kRoundTowardPositive, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fms<f64, FloppyFloat::kRoundTowardNegative, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fms<f64, FloppyFloat::kRoundTowardZero, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fms<f64, FloppyFloat::kRoundTiesToAway, true>(f64 a, f64 b, f64 c);
+
+template f128 FloppyFloat::Fms<f128, FloppyFloat::kRoundTiesToEven, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fms<f128, FloppyFloat::kRoundTowardPositive, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fms<f128, FloppyFloat::kRoundTowardNegative, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fms<f128, FloppyFloat::kRoundTowardZero, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fms<f128, FloppyFloat::kRoundTiesToAway, true>(f128 a, f128 b, f128 c);
+
+template f16 FloppyFloat::Fms<f16, FloppyFloat::kRoundTiesToEven, false, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fms<f16, FloppyFloat::kRoundTowardPositive, false, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fms<f16, FloppyFloat::kRoundTowardNegative, false, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fms<f16, FloppyFloat::kRoundTowardZero, false, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fms<f16, FloppyFloat::kRoundTiesToAway, false, true>(f16 a, f16 b, f16 c);
+
+template bf16 FloppyFloat::Fms<bf16, FloppyFloat::kRoundTiesToEven, false, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fms<bf16, FloppyFloat::kRoundTowardPositive, false, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fms<bf16, FloppyFloat::kRoundTowardNegative, false, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fms<bf16, FloppyFloat::kRoundTowardZero, false, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fms<bf16, FloppyFloat::kRoundTiesToAway, false, true>(bf16 a, bf16 b, bf16 c);
+
+template f32 FloppyFloat::Fms<f32, FloppyFloat::kRoundTiesToEven, false, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fms<f32, FloppyFloat::kRoundTowardPositive, false, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fms<f32, FloppyFloat::kRoundTowardNegative, false, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fms<f32, FloppyFloat::kRoundTowardZero, false, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fms<f32, FloppyFloat::kRoundTiesToAway, false, true>(f32 a, f32 b, f32 c);
+
+template f64 FloppyFloat::Fms<f64, FloppyFloat::kRoundTiesToEven, false, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fms<f64, FloppyFloat::kRoundTowardPositive, false, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fms<f64, FloppyFloat::kRoundTowardNegative, false, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fms<f64, FloppyFloat::kRoundTowardZero, false, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fms<f64, FloppyFloat::kRoundTiesToAway, false, true>(f64 a, f64 b, f64 c);
+
+template f128 FloppyFloat::Fms<f128, FloppyFloat::kRoundTiesToEven, false, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fms<f128, FloppyFloat::kRoundTowardPositive, false, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fms<f128, FloppyFloat::kRoundTowardNegative, false, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fms<f128, FloppyFloat::kRoundTowardZero, false, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fms<f128, FloppyFloat::kRoundTiesToAway, false, true>(f128 a, f128 b, f128 c);
+
+template f16 FloppyFloat::Fms<f16, FloppyFloat::kRoundTiesToEven, true, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fms<f16, FloppyFloat::kRoundTowardPositive, true, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fms<f16, FloppyFloat::kRoundTowardNegative, true, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fms<f16, FloppyFloat::kRoundTowardZero, true, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fms<f16, FloppyFloat::kRoundTiesToAway, true, true>(f16 a, f16 b, f16 c);
+
+template bf16 FloppyFloat::Fms<bf16, FloppyFloat::kRoundTiesToEven, true, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fms<bf16, FloppyFloat::kRoundTowardPositive, true, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fms<bf16, FloppyFloat::kRoundTowardNegative, true, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fms<bf16, FloppyFloat::kRoundTowardZero, true, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fms<bf16, FloppyFloat::kRoundTiesToAway, true, true>(bf16 a, bf16 b, bf16 c);
+
+template f32 FloppyFloat::Fms<f32, FloppyFloat::kRoundTiesToEven, true, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fms<f32, FloppyFloat::kRoundTowardPositive, true, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fms<f32, FloppyFloat::kRoundTowardNegative, true, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fms<f32, FloppyFloat::kRoundTowardZero, true, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fms<f32, FloppyFloat::kRoundTiesToAway, true, true>(f32 a, f32 b, f32 c);
+
+template f64 FloppyFloat::Fms<f64, FloppyFloat::kRoundTiesToEven, true, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fms<f64, FloppyFloat::kRoundTowardPositive, true, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fms<f64, FloppyFloat::kRoundTowardNegative, true, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fms<f64, FloppyFloat::kRoundTowardZero, true, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fms<f64, FloppyFloat::kRoundTiesToAway, true, true>(f64 a, f64 b, f64 c);
+
+template f128 FloppyFloat::Fms<f128, FloppyFloat::kRoundTiesToEven, true, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fms<f128, FloppyFloat::kRoundTowardPositive, true, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fms<f128, FloppyFloat::kRoundTowardNegative, true, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fms<f128, FloppyFloat::kRoundTowardZero, true, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fms<f128, FloppyFloat::kRoundTiesToAway, true, true>(f128 a, f128 b, f128 c);
+
+template <typename FT>
+FT FloppyFloat::Fms(FT a, FT b, FT c) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return Fms<FT, kRoundTiesToEven, false, true>(a, b, c);
+  case kRoundTiesToAway:
+    return Fms<FT, kRoundTiesToAway, false, true>(a, b, c);
+  case kRoundTowardPositive:
+    return Fms<FT, kRoundTowardPositive, false, true>(a, b, c);
+  case kRoundTowardNegative:
+    return Fms<FT, kRoundTowardNegative, false, true>(a, b, c);
+  case kRoundTowardZero:
+    return Fms<FT, kRoundTowardZero, false, true>(a, b, c);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template f16 FloppyFloat::Fms<f16>(f16 a, f16 b, f16 c);
+template bf16 FloppyFloat::Fms<bf16>(bf16 a, bf16 b, bf16 c);
+template f32 FloppyFloat::Fms<f32>(f32 a, f32 b, f32 c);
+template f64 FloppyFloat::Fms<f64>(f64 a, f64 b, f64 c);
+template f128 FloppyFloat::Fms<f128>(f128 a, f128 b, f128 c);
+
+template <typename FT, FloppyFloat::RoundingMode rm, bool quiet, bool flush>
+FT FloppyFloat::Fnma(FT a, FT b, FT c) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  if constexpr (flush)
+    FlushInputs(a, b, c);
+  const FT d = Fma<FT, rm, quiet, flush>(Negate(a), b, c);
+  if (IsNan(d) && nan_propagation_scheme == kNanPropX86sse) [[unlikely]]
+    return PropagateNan<FT>(a, b, c);
+  return d;
+}
+
+template f16 FloppyFloat::Fnma<f16, FloppyFloat::kRoundTiesToEven>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnma<f16, FloppyFloat::kRoundTowardPositive>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnma<f16, FloppyFloat::kRoundTowardNegative>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnma<f16, FloppyFloat::kRoundTowardZero>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnma<f16, FloppyFloat::kRoundTiesToAway>(f16 a, f16 b, f16 c);
+
+template bf16 FloppyFloat::Fnma<bf16, FloppyFloat::kRoundTiesToEven>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnma<bf16, FloppyFloat::kRoundTowardPositive>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnma<bf16, FloppyFloat::kRoundTowardNegative>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnma<bf16, FloppyFloat::kRoundTowardZero>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnma<bf16, FloppyFloat::kRoundTiesToAway>(bf16 a, bf16 b, bf16 c);
+
+template f32 FloppyFloat::Fnma<f32, FloppyFloat::kRoundTiesToEven>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnma<f32, FloppyFloat::kRoundTowardPositive>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnma<f32, FloppyFloat::kRoundTowardNegative>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnma<f32, FloppyFloat::kRoundTowardZero>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnma<f32, FloppyFloat::kRoundTiesToAway>(f32 a, f32 b, f32 c);
+
+template f64 FloppyFloat::Fnma<f64, FloppyFloat::kRoundTiesToEven>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnma<f64, FloppyFloat::kRoundTowardPositive>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnma<f64, FloppyFloat::kRoundTowardNegative>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnma<f64, FloppyFloat::kRoundTowardZero>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnma<f64, FloppyFloat::kRoundTiesToAway>(f64 a, f64 b, f64 c);
+
+template f128 FloppyFloat::Fnma<f128, FloppyFloat::kRoundTiesToEven>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnma<f128, FloppyFloat::kRoundTowardPositive>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnma<f128, FloppyFloat::kRoundTowardNegative>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnma<f128, FloppyFloat::kRoundTowardZero>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnma<f128, FloppyFloat::kRoundTiesToAway>(f128 a, f128 b, f128 c);
+
+template f16 FloppyFloat::Fnma<f16, FloppyFloat::kRoundTiesToEven, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnma<f16, FloppyFloat::kRoundTowardPositive, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnma<f16, FloppyFloat::kRoundTowardNegative, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnma<f16, FloppyFloat::kRoundTowardZero, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnma<f16, FloppyFloat::kRoundTiesToAway, true>(f16 a, f16 b, f16 c);
+
+template bf16 FloppyFloat::Fnma<bf16, FloppyFloat::kRoundTiesToEven, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnma<bf16, FloppyFloat::kRoundTowardPositive, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnma<bf16, FloppyFloat::kRoundTowardNegative, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnma<bf16, FloppyFloat::kRoundTowardZero, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnma<bf16, FloppyFloat::kRoundTiesToAway, true>(bf16 a, bf16 b, bf16 c);
+
+template f32 FloppyFloat::Fnma<f32, FloppyFloat::kRoundTiesToEven, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnma<f32, FloppyFloat::kRoundTowardPositive, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnma<f32, FloppyFloat::kRoundTowardNegative, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnma<f32, FloppyFloat::kRoundTowardZero, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnma<f32, FloppyFloat::kRoundTiesToAway, true>(f32 a, f32 b, f32 c);
+
+template f64 FloppyFloat::Fnma<f64, FloppyFloat::kRoundTiesToEven, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnma<f64, FloppyFloat::kRoundTowardPositive, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnma<f64, FloppyFloat::kRoundTowardNegative, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnma<f64, FloppyFloat::kRoundTowardZero, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnma<f64, FloppyFloat::kRoundTiesToAway, true>(f64 a, f64 b, f64 c);
+
+template f128 FloppyFloat::Fnma<f128, FloppyFloat::kRoundTiesToEven, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnma<f128, FloppyFloat::kRoundTowardPositive, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnma<f128, FloppyFloat::kRoundTowardNegative, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnma<f128, FloppyFloat::kRoundTowardZero, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnma<f128, FloppyFloat::kRoundTiesToAway, true>(f128 a, f128 b, f128 c);
+
+template f16 FloppyFloat::Fnma<f16, FloppyFloat::kRoundTiesToEven, false, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnma<f16, FloppyFloat::kRoundTowardPositive, false, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnma<f16, FloppyFloat::kRoundTowardNegative, false, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnma<f16, FloppyFloat::kRoundTowardZero, false, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnma<f16, FloppyFloat::kRoundTiesToAway, false, true>(f16 a, f16 b, f16 c);
+
+template bf16 FloppyFloat::Fnma<bf16, FloppyFloat::kRoundTiesToEven, false, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnma<bf16, FloppyFloat::kRoundTowardPositive, false, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnma<bf16, FloppyFloat::kRoundTowardNegative, false, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnma<bf16, FloppyFloat::kRoundTowardZero, false, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnma<bf16, FloppyFloat::kRoundTiesToAway, false, true>(bf16 a, bf16 b, bf16 c);
+
+template f32 FloppyFloat::Fnma<f32, FloppyFloat::kRoundTiesToEven, false, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnma<f32, FloppyFloat::kRoundTowardPositive, false, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnma<f32, FloppyFloat::kRoundTowardNegative, false, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnma<f32, FloppyFloat::kRoundTowardZero, false, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnma<f32, FloppyFloat::kRoundTiesToAway, false, true>(f32 a, f32 b, f32 c);
+
+template f64 FloppyFloat::Fnma<f64, FloppyFloat::kRoundTiesToEven, false, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnma<f64, FloppyFloat::kRoundTowardPositive, false, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnma<f64, FloppyFloat::kRoundTowardNegative, false, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnma<f64, FloppyFloat::kRoundTowardZero, false, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnma<f64, FloppyFloat::kRoundTiesToAway, false, true>(f64 a, f64 b, f64 c);
+
+template f128 FloppyFloat::Fnma<f128, FloppyFloat::kRoundTiesToEven, false, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnma<f128, FloppyFloat::kRoundTowardPositive, false, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnma<f128, FloppyFloat::kRoundTowardNegative, false, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnma<f128, FloppyFloat::kRoundTowardZero, false, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnma<f128, FloppyFloat::kRoundTiesToAway, false, true>(f128 a, f128 b, f128 c);
+
+template f16 FloppyFloat::Fnma<f16, FloppyFloat::kRoundTiesToEven, true, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnma<f16, FloppyFloat::kRoundTowardPositive, true, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnma<f16, FloppyFloat::kRoundTowardNegative, true, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnma<f16, FloppyFloat::kRoundTowardZero, true, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnma<f16, FloppyFloat::kRoundTiesToAway, true, true>(f16 a, f16 b, f16 c);
+
+template bf16 FloppyFloat::Fnma<bf16, FloppyFloat::kRoundTiesToEven, true, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnma<bf16, FloppyFloat::kRoundTowardPositive, true, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnma<bf16, FloppyFloat::kRoundTowardNegative, true, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnma<bf16, FloppyFloat::kRoundTowardZero, true, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnma<bf16, FloppyFloat::kRoundTiesToAway, true, true>(bf16 a, bf16 b, bf16 c);
+
+template f32 FloppyFloat::Fnma<f32, FloppyFloat::kRoundTiesToEven, true, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnma<f32, FloppyFloat::kRoundTowardPositive, true, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnma<f32, FloppyFloat::kRoundTowardNegative, true, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnma<f32, FloppyFloat::kRoundTowardZero, true, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnma<f32, FloppyFloat::kRoundTiesToAway, true, true>(f32 a, f32 b, f32 c);
+
+template f64 FloppyFloat::Fnma<f64, FloppyFloat::kRoundTiesToEven, true, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnma<f64, FloppyFloat::kRoundTowardPositive, true, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnma<f64, FloppyFloat::kRoundTowardNegative, true, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnma<f64, FloppyFloat::kRoundTowardZero, true, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnma<f64, FloppyFloat::kRoundTiesToAway, true, true>(f64 a, f64 b, f64 c);
+
+template f128 FloppyFloat::Fnma<f128, FloppyFloat::kRoundTiesToEven, true, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnma<f128, FloppyFloat::kRoundTowardPositive, true, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnma<f128, FloppyFloat::kRoundTowardNegative, true, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnma<f128, FloppyFloat::kRoundTowardZero, true, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnma<f128, FloppyFloat::kRoundTiesToAway, true, true>(f128 a, f128 b, f128 c);
+
+template <typename FT>
+FT FloppyFloat::Fnma(FT a, FT b, FT c) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return Fnma<FT, kRoundTiesToEven, false, true>(a, b, c);
+  case kRoundTiesToAway:
+    return Fnma<FT, kRoundTiesToAway, false, true>(a, b, c);
+  case kRoundTowardPositive:
+    return Fnma<FT, kRoundTowardPositive, false, true>(a, b, c);
+  case kRoundTowardNegative:
+    return Fnma<FT, kRoundTowardNegative, false, true>(a, b, c);
+  case kRoundTowardZero:
+    return Fnma<FT, kRoundTowardZero, false, true>(a, b, c);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template f16 FloppyFloat::Fnma<f16>(f16 a, f16 b, f16 c);
+template bf16 FloppyFloat::Fnma<bf16>(bf16 a, bf16 b, bf16 c);
+template f32 FloppyFloat::Fnma<f32>(f32 a, f32 b, f32 c);
+template f64 FloppyFloat::Fnma<f64>(f64 a, f64 b, f64 c);
+template f128 FloppyFloat::Fnma<f128>(f128 a, f128 b, f128 c);
+
+template <typename FT, FloppyFloat::RoundingMode rm, bool quiet, bool flush>
+FT FloppyFloat::Fnms(FT a, FT b, FT c) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  if constexpr (flush)
+    FlushInputs(a, b, c);
+  const FT d = Fma<FT, rm, quiet, flush>(Negate(a), b, Negate(c));
+  if (IsNan(d) && nan_propagation_scheme == kNanPropX86sse) [[unlikely]]
+    return PropagateNan<FT>(a, b, c);
+  return d;
+}
+
+template f16 FloppyFloat::Fnms<f16, FloppyFloat::kRoundTiesToEven>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnms<f16, FloppyFloat::kRoundTowardPositive>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnms<f16, FloppyFloat::kRoundTowardNegative>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnms<f16, FloppyFloat::kRoundTowardZero>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnms<f16, FloppyFloat::kRoundTiesToAway>(f16 a, f16 b, f16 c);
+
+template bf16 FloppyFloat::Fnms<bf16, FloppyFloat::kRoundTiesToEven>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnms<bf16, FloppyFloat::kRoundTowardPositive>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnms<bf16, FloppyFloat::kRoundTowardNegative>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnms<bf16, FloppyFloat::kRoundTowardZero>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnms<bf16, FloppyFloat::kRoundTiesToAway>(bf16 a, bf16 b, bf16 c);
+
+template f32 FloppyFloat::Fnms<f32, FloppyFloat::kRoundTiesToEven>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnms<f32, FloppyFloat::kRoundTowardPositive>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnms<f32, FloppyFloat::kRoundTowardNegative>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnms<f32, FloppyFloat::kRoundTowardZero>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnms<f32, FloppyFloat::kRoundTiesToAway>(f32 a, f32 b, f32 c);
+
+template f64 FloppyFloat::Fnms<f64, FloppyFloat::kRoundTiesToEven>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnms<f64, FloppyFloat::kRoundTowardPositive>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnms<f64, FloppyFloat::kRoundTowardNegative>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnms<f64, FloppyFloat::kRoundTowardZero>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnms<f64, FloppyFloat::kRoundTiesToAway>(f64 a, f64 b, f64 c);
+
+template f128 FloppyFloat::Fnms<f128, FloppyFloat::kRoundTiesToEven>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnms<f128, FloppyFloat::kRoundTowardPositive>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnms<f128, FloppyFloat::kRoundTowardNegative>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnms<f128, FloppyFloat::kRoundTowardZero>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnms<f128, FloppyFloat::kRoundTiesToAway>(f128 a, f128 b, f128 c);
+
+template f16 FloppyFloat::Fnms<f16, FloppyFloat::kRoundTiesToEven, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnms<f16, FloppyFloat::kRoundTowardPositive, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnms<f16, FloppyFloat::kRoundTowardNegative, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnms<f16, FloppyFloat::kRoundTowardZero, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnms<f16, FloppyFloat::kRoundTiesToAway, true>(f16 a, f16 b, f16 c);
+
+template bf16 FloppyFloat::Fnms<bf16, FloppyFloat::kRoundTiesToEven, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnms<bf16, FloppyFloat::kRoundTowardPositive, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnms<bf16, FloppyFloat::kRoundTowardNegative, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnms<bf16, FloppyFloat::kRoundTowardZero, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnms<bf16, FloppyFloat::kRoundTiesToAway, true>(bf16 a, bf16 b, bf16 c);
+
+template f32 FloppyFloat::Fnms<f32, FloppyFloat::kRoundTiesToEven, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnms<f32, FloppyFloat::kRoundTowardPositive, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnms<f32, FloppyFloat::kRoundTowardNegative, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnms<f32, FloppyFloat::kRoundTowardZero, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnms<f32, FloppyFloat::kRoundTiesToAway, true>(f32 a, f32 b, f32 c);
+
+template f64 FloppyFloat::Fnms<f64, FloppyFloat::kRoundTiesToEven, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnms<f64, FloppyFloat::kRoundTowardPositive, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnms<f64, FloppyFloat::kRoundTowardNegative, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnms<f64, FloppyFloat::kRoundTowardZero, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnms<f64, FloppyFloat::kRoundTiesToAway, true>(f64 a, f64 b, f64 c);
+
+template f128 FloppyFloat::Fnms<f128, FloppyFloat::kRoundTiesToEven, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnms<f128, FloppyFloat::kRoundTowardPositive, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnms<f128, FloppyFloat::kRoundTowardNegative, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnms<f128, FloppyFloat::kRoundTowardZero, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnms<f128, FloppyFloat::kRoundTiesToAway, true>(f128 a, f128 b, f128 c);
+
+template f16 FloppyFloat::Fnms<f16, FloppyFloat::kRoundTiesToEven, false, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnms<f16, FloppyFloat::kRoundTowardPositive, false, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnms<f16, FloppyFloat::kRoundTowardNegative, false, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnms<f16, FloppyFloat::kRoundTowardZero, false, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnms<f16, FloppyFloat::kRoundTiesToAway, false, true>(f16 a, f16 b, f16 c);
+
+template bf16 FloppyFloat::Fnms<bf16, FloppyFloat::kRoundTiesToEven, false, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnms<bf16, FloppyFloat::kRoundTowardPositive, false, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnms<bf16, FloppyFloat::kRoundTowardNegative, false, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnms<bf16, FloppyFloat::kRoundTowardZero, false, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnms<bf16, FloppyFloat::kRoundTiesToAway, false, true>(bf16 a, bf16 b, bf16 c);
+
+template f32 FloppyFloat::Fnms<f32, FloppyFloat::kRoundTiesToEven, false, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnms<f32, FloppyFloat::kRoundTowardPositive, false, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnms<f32, FloppyFloat::kRoundTowardNegative, false, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnms<f32, FloppyFloat::kRoundTowardZero, false, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnms<f32, FloppyFloat::kRoundTiesToAway, false, true>(f32 a, f32 b, f32 c);
+
+template f64 FloppyFloat::Fnms<f64, FloppyFloat::kRoundTiesToEven, false, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnms<f64, FloppyFloat::kRoundTowardPositive, false, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnms<f64, FloppyFloat::kRoundTowardNegative, false, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnms<f64, FloppyFloat::kRoundTowardZero, false, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnms<f64, FloppyFloat::kRoundTiesToAway, false, true>(f64 a, f64 b, f64 c);
+
+template f128 FloppyFloat::Fnms<f128, FloppyFloat::kRoundTiesToEven, false, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnms<f128, FloppyFloat::kRoundTowardPositive, false, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnms<f128, FloppyFloat::kRoundTowardNegative, false, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnms<f128, FloppyFloat::kRoundTowardZero, false, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnms<f128, FloppyFloat::kRoundTiesToAway, false, true>(f128 a, f128 b, f128 c);
+
+template f16 FloppyFloat::Fnms<f16, FloppyFloat::kRoundTiesToEven, true, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnms<f16, FloppyFloat::kRoundTowardPositive, true, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnms<f16, FloppyFloat::kRoundTowardNegative, true, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnms<f16, FloppyFloat::kRoundTowardZero, true, true>(f16 a, f16 b, f16 c);
+template f16 FloppyFloat::Fnms<f16, FloppyFloat::kRoundTiesToAway, true, true>(f16 a, f16 b, f16 c);
+
+template bf16 FloppyFloat::Fnms<bf16, FloppyFloat::kRoundTiesToEven, true, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnms<bf16, FloppyFloat::kRoundTowardPositive, true, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnms<bf16, FloppyFloat::kRoundTowardNegative, true, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnms<bf16, FloppyFloat::kRoundTowardZero, true, true>(bf16 a, bf16 b, bf16 c);
+template bf16 FloppyFloat::Fnms<bf16, FloppyFloat::kRoundTiesToAway, true, true>(bf16 a, bf16 b, bf16 c);
+
+template f32 FloppyFloat::Fnms<f32, FloppyFloat::kRoundTiesToEven, true, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnms<f32, FloppyFloat::kRoundTowardPositive, true, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnms<f32, FloppyFloat::kRoundTowardNegative, true, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnms<f32, FloppyFloat::kRoundTowardZero, true, true>(f32 a, f32 b, f32 c);
+template f32 FloppyFloat::Fnms<f32, FloppyFloat::kRoundTiesToAway, true, true>(f32 a, f32 b, f32 c);
+
+template f64 FloppyFloat::Fnms<f64, FloppyFloat::kRoundTiesToEven, true, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnms<f64, FloppyFloat::kRoundTowardPositive, true, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnms<f64, FloppyFloat::kRoundTowardNegative, true, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnms<f64, FloppyFloat::kRoundTowardZero, true, true>(f64 a, f64 b, f64 c);
+template f64 FloppyFloat::Fnms<f64, FloppyFloat::kRoundTiesToAway, true, true>(f64 a, f64 b, f64 c);
+
+template f128 FloppyFloat::Fnms<f128, FloppyFloat::kRoundTiesToEven, true, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnms<f128, FloppyFloat::kRoundTowardPositive, true, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnms<f128, FloppyFloat::kRoundTowardNegative, true, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnms<f128, FloppyFloat::kRoundTowardZero, true, true>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fnms<f128, FloppyFloat::kRoundTiesToAway, true, true>(f128 a, f128 b, f128 c);
+
 template <typename FT>
+FT FloppyFloat::Fnms(FT a, FT b, FT c) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return Fnms<FT, kRoundTiesToEven, false, true>(a, b, c);
+  case kRoundTiesToAway:
+    return Fnms<FT, kRoundTiesToAway, false, true>(a, b, c);
+  case kRoundTowardPositive:
+    return Fnms<FT, kRoundTowardPositive, false, true>(a, b, c);
+  case kRoundTowardNegative:
+    return Fnms<FT, kRoundTowardNegative, false, true>(a, b, c);
+  case kRoundTowardZero:
+    return Fnms<FT, kRoundTowardZero, false, true>(a, b, c);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template f16 FloppyFloat::Fnms<f16>(f16 a, f16 b, f16 c);
+template bf16 FloppyFloat::Fnms<bf16>(bf16 a, bf16 b, bf16 c);
+template f32 FloppyFloat::Fnms<f32>(f32 a, f32 b, f32 c);
+template f64 FloppyFloat::Fnms<f64>(f64 a, f64 b, f64 c);
+template f128 FloppyFloat::Fnms<f128>(f128 a, f128 b, f128 c);
+
+template <typename FT, bool quiet>
 bool FloppyFloat::EqQuiet(FT a, FT b) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  FlushInputs(a, b);
   if (IsNan(a) || IsNan(b)) [[unlikely]] {
     if (IsSnan(a) || IsSnan(b))
       invalid = true;
@@ -956,8 +2570,14 @@ template bool FloppyFloat::EqQuiet<f16>(f16 a, f16 b);
 template bool FloppyFloat::EqQuiet<f32>(f32 a, f32 b);
 template bool FloppyFloat::EqQuiet<f64>(f64 a, f64 b);
 
-template <typename FT>
+template bool FloppyFloat::EqQuiet<f16, true>(f16 a, f16 b);
+template bool FloppyFloat::EqQuiet<f32, true>(f32 a, f32 b);
+template bool FloppyFloat::EqQuiet<f64, true>(f64 a, f64 b);
+
+template <typename FT, bool quiet>
 bool FloppyFloat::EqSignaling(FT a, FT b) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  FlushInputs(a, b);
   if (IsNan(a) || IsNan(b)) [[unlikely]] {
     invalid = true;
     return false;
@@ -970,8 +2590,14 @@ template bool FloppyFloat::EqSignaling<f16>(f16 a, f16 b);
 template bool FloppyFloat::EqSignaling<f32>(f32 a, f32 b);
 template bool FloppyFloat::EqSignaling<f64>(f64 a, f64 b);
 
-template <typename FT>
+template bool FloppyFloat::EqSignaling<f16, true>(f16 a, f16 b);
+template bool FloppyFloat::EqSignaling<f32, true>(f32 a, f32 b);
+template bool FloppyFloat::EqSignaling<f64, true>(f64 a, f64 b);
+
+template <typename FT, bool quiet>
 bool FloppyFloat::LeQuiet(FT a, FT b) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  FlushInputs(a, b);
   if (IsNan(a) || IsNan(b)) [[unlikely]] {
     if (IsSnan(a) || IsSnan(b))
       invalid = true;
@@ -985,8 +2611,14 @@ template bool FloppyFloat::LeQuiet<f16>(f16 a, f16 b);
 template bool FloppyFloat::LeQuiet<f32>(f32 a, f32 b);
 template bool FloppyFloat::LeQuiet<f64>(f64 a, f64 b);
 
-template <typename FT>
+template bool FloppyFloat::LeQuiet<f16, true>(f16 a, f16 b);
+template bool FloppyFloat::LeQuiet<f32, true>(f32 a, f32 b);
+template bool FloppyFloat::LeQuiet<f64, true>(f64 a, f64 b);
+
+template <typename FT, bool quiet>
 bool FloppyFloat::LeSignaling(FT a, FT b) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  FlushInputs(a, b);
   if (IsNan(a) || IsNan(b)) [[unlikely]] {
     invalid = true;
     return false;
@@ -999,8 +2631,14 @@ template bool FloppyFloat::LeSignaling<f16>(f16 a, f16 b);
 template bool FloppyFloat::LeSignaling<f32>(f32 a, f32 b);
 template bool FloppyFloat::LeSignaling<f64>(f64 a, f64 b);
 
-template <typename FT>
+template bool FloppyFloat::LeSignaling<f16, true>(f16 a, f16 b);
+template bool FloppyFloat::LeSignaling<f32, true>(f32 a, f32 b);
+template bool FloppyFloat::LeSignaling<f64, true>(f64 a, f64 b);
+
+template <typename FT, bool quiet>
 bool FloppyFloat::LtQuiet(FT a, FT b) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  FlushInputs(a, b);
   if (IsNan(a) || IsNan(b)) [[unlikely]] {
     if (IsSnan(a) || IsSnan(b))
       invalid = true;
@@ -1014,8 +2652,14 @@ template bool FloppyFloat::LtQuiet<f16>(f16 a, f16 b);
 template bool FloppyFloat::LtQuiet<f32>(f32 a, f32 b);
 template bool FloppyFloat::LtQuiet<f64>(f64 a, f64 b);
 
-template <typename FT>
+template bool FloppyFloat::LtQuiet<f16, true>(f16 a, f16 b);
+template bool FloppyFloat::LtQuiet<f32, true>(f32 a, f32 b);
+template bool FloppyFloat::LtQuiet<f64, true>(f64 a, f64 b);
+
+template <typename FT, bool quiet>
 bool FloppyFloat::LtSignaling(FT a, FT b) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  FlushInputs(a, b);
   if (IsNan(a) || IsNan(b)) [[unlikely]] {
     invalid = true;
     return false;
@@ -1028,8 +2672,14 @@ template bool FloppyFloat::LtSignaling<f16>(f16 a, f16 b);
 template bool FloppyFloat::LtSignaling<f32>(f32 a, f32 b);
 template bool FloppyFloat::LtSignaling<f64>(f64 a, f64 b);
 
-template <typename FT>
+template bool FloppyFloat::LtSignaling<f16, true>(f16 a, f16 b);
+template bool FloppyFloat::LtSignaling<f32, true>(f32 a, f32 b);
+template bool FloppyFloat::LtSignaling<f64, true>(f64 a, f64 b);
+
+template <typename FT, bool quiet>
 FT FloppyFloat::Maxx86(FT a, FT b) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  FlushInputs(a, b);
   if (IsNan(a) || IsNan(b)) [[unlikely]] {
     invalid = true;
     return b;
@@ -1045,8 +2695,14 @@ template f16 FloppyFloat::Maxx86<f16>(f16 a, f16 b);
 template f32 FloppyFloat::Maxx86<f32>(f32 a, f32 b);
 template f64 FloppyFloat::Maxx86<f64>(f64 a, f64 b);
 
-template <typename FT>
+template f16 FloppyFloat::Maxx86<f16, true>(f16 a, f16 b);
+template f32 FloppyFloat::Maxx86<f32, true>(f32 a, f32 b);
+template f64 FloppyFloat::Maxx86<f64, true>(f64 a, f64 b);
+
+template <typename FT, bool quiet>
 FT FloppyFloat::Minx86(FT a, FT b) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  FlushInputs(a, b);
   if (IsNan(a) || IsNan(b)) [[unlikely]] {
     invalid = true;
     return b;
@@ -1062,20 +2718,98 @@ template f16 FloppyFloat::Minx86<f16>(f16 a, f16 b);
 template f32 FloppyFloat::Minx86<f32>(f32 a, f32 b);
 template f64 FloppyFloat::Minx86<f64>(f64 a, f64 b);
 
+template f16 FloppyFloat::Minx86<f16, true>(f16 a, f16 b);
+template f32 FloppyFloat::Minx86<f32, true>(f32 a, f32 b);
+template f64 FloppyFloat::Minx86<f64, true>(f64 a, f64 b);
+
+// Maps an encoding to an integer whose order is the total order of the (non-NaN) floats, so that -0 < +0.
+template <typename UT>
+constexpr std::make_signed_t<UT> OrderKey(UT a) {
+  using IT = std::make_signed_t<UT>;
+  const IT i = static_cast<IT>(a);
+  return static_cast<IT>(i ^ ((i >> (NumBits<UT>() - 1)) & nl<IT>::max()));
+}
+
+// Orders by magnitude first. For equal magnitudes, the negative number is smaller.
+template <typename UT>
+constexpr UT MagnitudeKey(UT a) {
+  return static_cast<UT>(static_cast<UT>(a << 1) | (static_cast<UT>(~a) >> (NumBits<UT>() - 1)));
+}
+
+template <typename FT, typename UT>
+constexpr bool IsNanBits(UT a) {
+  return static_cast<UT>(a & ~SignMask<FT>()) > ExponentMask<FT>();
+}
+
+template <typename FT, typename UT>
+constexpr bool IsSubnormalBits(UT a) {
+  return static_cast<UT>(static_cast<UT>(a & ~SignMask<FT>()) - 1) < MaxSignificand<FT>();
+}
+
+// Selects the result of a minimum/maximum operation for operands that are not NaN.
+template <FloppyFloat::MinMaxOperation op, typename UT>
+constexpr UT SelectMinMax(UT a, UT b) {
+  constexpr bool kMax = op == FloppyFloat::kMaximum || op == FloppyFloat::kMaximumNumber ||
+                        op == FloppyFloat::kMaximumMagnitude || op == FloppyFloat::kMaximumMagnitudeNumber;
+  constexpr bool kMagnitude = op == FloppyFloat::kMaximumMagnitude || op == FloppyFloat::kMinimumMagnitude ||
+                              op == FloppyFloat::kMaximumMagnitudeNumber || op == FloppyFloat::kMinimumMagnitudeNumber;
+  bool a_first;
+  if constexpr (kMagnitude)
+    a_first = kMax ? MagnitudeKey(a) > MagnitudeKey(b) : MagnitudeKey(a) < MagnitudeKey(b);
+  else
+    a_first = kMax ? OrderKey(a) > OrderKey(b) : OrderKey(a) < OrderKey(b);
+  return a_first ? a : b;
+}
+
+template <typename FT>
+FT FloppyFloat::Maximum(FT a, FT b) {
+  FlushInputs(a, b);
+  if (IsNan(a) || IsNan(b)) [[unlikely]] {
+    if (IsSnan(a) || IsSnan(b))
+      invalid = true;
+    return PropagateNan<FT>(a, b);
+  }
+
+  using UT = FloatToUint<FT>::type;
+  return std::bit_cast<FT>(SelectMinMax<kMaximum>(std::bit_cast<UT>(a), std::bit_cast<UT>(b)));
+}
+
+template f16 FloppyFloat::Maximum<f16>(f16 a, f16 b);
+template f32 FloppyFloat::Maximum<f32>(f32 a, f32 b);
+template f64 FloppyFloat::Maximum<f64>(f64 a, f64 b);
+
+template <typename FT>
+FT FloppyFloat::Minimum(FT a, FT b) {
+  FlushInputs(a, b);
+  if (IsNan(a) || IsNan(b)) [[unlikely]] {
+    if (IsSnan(a) || IsSnan(b))
+      invalid = true;
+    return PropagateNan<FT>(a, b);
+  }
+
+  using UT = FloatToUint<FT>::type;
+  return std::bit_cast<FT>(SelectMinMax<kMinimum>(std::bit_cast<UT>(a), std::bit_cast<UT>(b)));
+}
+
+template f16 FloppyFloat::Minimum<f16>(f16 a, f16 b);
+template f32 FloppyFloat::Minimum<f32>(f32 a, f32 b);
+template f64 FloppyFloat::Minimum<f64>(f64 a, f64 b);
+
 template <typename FT>
 FT FloppyFloat::MaximumNumber(FT a, FT b) {
+  FlushInputs(a, b);
   if (IsNan(a) || IsNan(b)) [[unlikely]] {
     if (IsSnan(a) || IsSnan(b))
       invalid = true;
+    if (nan_propagation_scheme == kNanPropArm64 && (IsSnan(a) || IsSnan(b) || (IsNan(a) && IsNan(b))))
+      return PropagateNan<FT>(a, b);  // Arm FMAXNM/FMINNM only prefer numbers over quiet NaNs.
     if (IsNan(a) && IsNan(b))
       return GetQnan<FT>();
     return IsNan(a) ? b : a;
   }
 
-  if (IsZero(a) && IsZero(b))
-    return std::signbit(a) && std::signbit(b) ? (FT)-0.0f : (FT) + 0.0f;
-
-  return (a > b) ? a : b;
+  using UT = FloatToUint<FT>::type;
+  return std::bit_cast<FT>(SelectMinMax<kMaximumNumber>(std::bit_cast<UT>(a), std::bit_cast<UT>(b)));
 }
 
 template f16 FloppyFloat::MaximumNumber<f16>(f16 a, f16 b);
@@ -1084,96 +2818,1137 @@ template f64 FloppyFloat::MaximumNumber<f64>(f64 a, f64 b);
 
 template <typename FT>
 FT FloppyFloat::MinimumNumber(FT a, FT b) {
+  FlushInputs(a, b);
   if (IsNan(a) || IsNan(b)) [[unlikely]] {
     if (IsSnan(a) || IsSnan(b))
       invalid = true;
+    if (nan_propagation_scheme == kNanPropArm64 && (IsSnan(a) || IsSnan(b) || (IsNan(a) && IsNan(b))))
+      return PropagateNan<FT>(a, b);  // Arm FMAXNM/FMINNM only prefer numbers over quiet NaNs.
     if (IsNan(a) && IsNan(b))
       return GetQnan<FT>();
     return IsNan(a) ? b : a;
   }
 
-  if (IsZero(a) && IsZero(b))
-    return std::signbit(a) && std::signbit(b) ? (FT)-0.0f : (FT) + 0.0f;
-
-  return (a > b) ? a : b;
+  using UT = FloatToUint<FT>::type;
+  return std::bit_cast<FT>(SelectMinMax<kMinimumNumber>(std::bit_cast<UT>(a), std::bit_cast<UT>(b)));
 }
 
 template f16 FloppyFloat::MinimumNumber<f16>(f16 a, f16 b);
 template f32 FloppyFloat::MinimumNumber<f32>(f32 a, f32 b);
 template f64 FloppyFloat::MinimumNumber<f64>(f64 a, f64 b);
 
-f32 FloppyFloat::F16ToF32(f16 a) {
-  if (IsNan(a)) [[unlikely]] {
-    if (!GetQuietBit(a))
+template <typename FT>
+FT FloppyFloat::MaximumMagnitude(FT a, FT b) {
+  FlushInputs(a, b);
+  if (IsNan(a) || IsNan(b)) [[unlikely]] {
+    if (IsSnan(a) || IsSnan(b))
       invalid = true;
-    return PropagateNan<f16, f32>(a);
+    return PropagateNan<FT>(a, b);
   }
 
-  return static_cast<f32>(a);
+  using UT = FloatToUint<FT>::type;
+  return std::bit_cast<FT>(SelectMinMax<kMaximumMagnitude>(std::bit_cast<UT>(a), std::bit_cast<UT>(b)));
 }
 
-f64 FloppyFloat::F16ToF64(f16 a) {
-  if (IsNan(a)) [[unlikely]] {
-    if (!GetQuietBit(a))
+template f16 FloppyFloat::MaximumMagnitude<f16>(f16 a, f16 b);
+template f32 FloppyFloat::MaximumMagnitude<f32>(f32 a, f32 b);
+template f64 FloppyFloat::MaximumMagnitude<f64>(f64 a, f64 b);
+
+template <typename FT>
+FT FloppyFloat::MinimumMagnitude(FT a, FT b) {
+  FlushInputs(a, b);
+  if (IsNan(a) || IsNan(b)) [[unlikely]] {
+    if (IsSnan(a) || IsSnan(b))
       invalid = true;
-    return PropagateNan<f16, f64>(a);
+    return PropagateNan<FT>(a, b);
   }
 
-  return static_cast<f64>(a);
+  using UT = FloatToUint<FT>::type;
+  return std::bit_cast<FT>(SelectMinMax<kMinimumMagnitude>(std::bit_cast<UT>(a), std::bit_cast<UT>(b)));
 }
 
-// Assumes that "result" was calculated with "kRoundTowardZero"
-template <typename FT, typename IT, FloppyFloat::RoundingMode rm>
-constexpr IT RoundIntegerResult(FT residual, FT source, IT result) {
-  if constexpr (rm == FloppyFloat::kRoundTowardNegative) {
-    if (residual > 0)
-      result -= 1;
-  } else if constexpr (rm == FloppyFloat::kRoundTowardPositive) {
-    if (residual < 0)
-      result += 1;
-  } else {
-    if (residual) {
-      FT ia_p05 = static_cast<FT>(result) + static_cast<FT>(0.5);
-      if constexpr (rm == FloppyFloat::kRoundTiesToEven) {
-        if (ia_p05 <= source) {
-          if (ia_p05 == source) [[unlikely]] {
-            if (!(result % 2))
-              result -= 1;
-          }
-          result += 1;
-        }
-      } else if constexpr (rm == FloppyFloat::kRoundTiesToAway) {
-        if (ia_p05 <= source)
-          result += 1;
-      }
-    }
+template f16 FloppyFloat::MinimumMagnitude<f16>(f16 a, f16 b);
+template f32 FloppyFloat::MinimumMagnitude<f32>(f32 a, f32 b);
+template f64 FloppyFloat::MinimumMagnitude<f64>(f64 a, f64 b);
+
+template <typename FT>
+FT FloppyFloat::MaximumMagnitudeNumber(FT a, FT b) {
+  FlushInputs(a, b);
+  if (IsNan(a) || IsNan(b)) [[unlikely]] {
+    if (IsSnan(a) || IsSnan(b))
+      invalid = true;
+    if (IsNan(a) && IsNan(b))
+      return GetQnan<FT>();
+    return IsNan(a) ? b : a;
   }
-  return result;
+
+  using UT = FloatToUint<FT>::type;
+  return std::bit_cast<FT>(SelectMinMax<kMaximumMagnitudeNumber>(std::bit_cast<UT>(a), std::bit_cast<UT>(b)));
 }
 
-i32 FloppyFloat::F32ToI32(f32 a) {
-  switch (rounding_mode) {
-  case kRoundTiesToEven:
-    return F32ToI32<kRoundTiesToEven>(a);
-  case kRoundTiesToAway:
-    return F32ToI32<kRoundTiesToAway>(a);
-  case kRoundTowardPositive:
-    return F32ToI32<kRoundTowardPositive>(a);
-  case kRoundTowardNegative:
-    return F32ToI32<kRoundTowardNegative>(a);
-  case kRoundTowardZero:
-    return F32ToI32<kRoundTowardZero>(a);
-  default:
-    throw std::runtime_error(std::string("Unknown rounding mode"));
+template f16 FloppyFloat::MaximumMagnitudeNumber<f16>(f16 a, f16 b);
+template f32 FloppyFloat::MaximumMagnitudeNumber<f32>(f32 a, f32 b);
+template f64 FloppyFloat::MaximumMagnitudeNumber<f64>(f64 a, f64 b);
+
+template <typename FT>
+FT FloppyFloat::MinimumMagnitudeNumber(FT a, FT b) {
+  FlushInputs(a, b);
+  if (IsNan(a) || IsNan(b)) [[unlikely]] {
+    if (IsSnan(a) || IsSnan(b))
+      invalid = true;
+    if (IsNan(a) && IsNan(b))
+      return GetQnan<FT>();
+    return IsNan(a) ? b : a;
   }
+
+  using UT = FloatToUint<FT>::type;
+  return std::bit_cast<FT>(SelectMinMax<kMinimumMagnitudeNumber>(std::bit_cast<UT>(a), std::bit_cast<UT>(b)));
 }
 
-template <FloppyFloat::RoundingMode rm>
-i32 FloppyFloat::F32ToI32(f32 a) {
-  if (IsNan(a)) [[unlikely]] {
-    invalid = true;
-    return nan_limit_i32_;
-  } else if (a >= 2147483648.f32) [[unlikely]] {
+template f16 FloppyFloat::MinimumMagnitudeNumber<f16>(f16 a, f16 b);
+template f32 FloppyFloat::MinimumMagnitudeNumber<f32>(f32 a, f32 b);
+template f64 FloppyFloat::MinimumMagnitudeNumber<f64>(f64 a, f64 b);
+
+// imm8[1:0] selects minimum, maximum, minimumMagnitude, or maximumMagnitude, imm8[3:2] the sign of the result (from
+// the comparison, from a, cleared, or set), and imm8[4] the Number variants. NaN results are the first NaN quieted.
+template <typename FT, bool quiet>
+FT FloppyFloat::MinMaxAvx10(FT a, FT b, u8 imm8) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  FlushInputs(a, b);
+  const bool number = imm8 & 0x10;
+  if (IsNan(a) || IsNan(b)) [[unlikely]] {
+    if (IsSnan(a) || IsSnan(b))
+      invalid = true;
+    if (!number || (IsNan(a) && IsNan(b)))
+      return SetQuietBit(IsNan(a) ? a : b);
+    b = IsNan(b) ? a : b;
+    a = IsNan(a) ? b : a;
+  }
+
+  using UT = FloatToUint<FT>::type;
+  const UT ua = std::bit_cast<UT>(a);
+  const UT ub = std::bit_cast<UT>(b);
+  UT result;
+  switch (imm8 & 0x3) {
+  case 0:
+    result = SelectMinMax<kMinimum>(ua, ub);
+    break;
+  case 1:
+    result = SelectMinMax<kMaximum>(ua, ub);
+    break;
+  case 2:
+    result = SelectMinMax<kMinimumMagnitude>(ua, ub);
+    break;
+  default:
+    result = SelectMinMax<kMaximumMagnitude>(ua, ub);
+    break;
+  }
+
+  constexpr UT kSignMask = SignMask<FT>();
+  switch ((imm8 >> 2) & 0x3) {
+  case 0:
+    break;
+  case 1:
+    result = (result & ~kSignMask) | (ua & kSignMask);
+    break;
+  case 2:
+    result &= ~kSignMask;
+    break;
+  default:
+    result |= kSignMask;
+    break;
+  }
+  return std::bit_cast<FT>(result);
+}
+
+template f16 FloppyFloat::MinMaxAvx10<f16>(f16 a, f16 b, u8 imm8);
+template f32 FloppyFloat::MinMaxAvx10<f32>(f32 a, f32 b, u8 imm8);
+template f64 FloppyFloat::MinMaxAvx10<f64>(f64 a, f64 b, u8 imm8);
+
+template f16 FloppyFloat::MinMaxAvx10<f16, true>(f16 a, f16 b, u8 imm8);
+template f32 FloppyFloat::MinMaxAvx10<f32, true>(f32 a, f32 b, u8 imm8);
+template f64 FloppyFloat::MinMaxAvx10<f64, true>(f64 a, f64 b, u8 imm8);
+
+template <typename FT, FloppyFloat::MinMaxOperation op>
+void FloppyFloat::MinMaxBatch(FT* dst, const FT* a, const FT* b, std::size_t n) {
+  using UT = FloatToUint<FT>::type;
+  const bool check_denormals = ChecksDenormals<FT>();
+  constexpr std::size_t kBlockSize = 64;
+  for (std::size_t i = 0; i < n; i += kBlockSize) {
+    const std::size_t block_size = std::min(kBlockSize, n - i);
+    UT ua[kBlockSize], ub[kBlockSize];
+    std::memcpy(ua, a + i, block_size * sizeof(FT));
+    std::memcpy(ub, b + i, block_size * sizeof(FT));
+
+    UT nan = 0;
+    UT denormal = 0;
+    for (std::size_t j = 0; j < block_size; ++j) {
+      nan |= static_cast<UT>(IsNanBits<FT>(ua[j])) | static_cast<UT>(IsNanBits<FT>(ub[j]));
+      denormal |= static_cast<UT>(IsSubnormalBits<FT>(ua[j])) | static_cast<UT>(IsSubnormalBits<FT>(ub[j]));
+    }
+
+    if (!nan && !(denormal && check_denormals)) [[likely]] {
+      UT result[kBlockSize];
+      for (std::size_t j = 0; j < block_size; ++j)
+        result[j] = SelectMinMax<op>(ua[j], ub[j]);
+      std::memcpy(dst + i, result, block_size * sizeof(FT));
+      continue;
+    }
+
+    for (std::size_t j = 0; j < block_size; ++j) {
+      const FT fa = std::bit_cast<FT>(ua[j]);
+      const FT fb = std::bit_cast<FT>(ub[j]);
+      if constexpr (op == kMaximum)
+        dst[i + j] = Maximum(fa, fb);
+      else if constexpr (op == kMinimum)
+        dst[i + j] = Minimum(fa, fb);
+      else if constexpr (op == kMaximumNumber)
+        dst[i + j] = MaximumNumber(fa, fb);
+      else if constexpr (op == kMinimumNumber)
+        dst[i + j] = MinimumNumber(fa, fb);
+      else if constexpr (op == kMaximumMagnitude)
+        dst[i + j] = MaximumMagnitude(fa, fb);
+      else if constexpr (op == kMinimumMagnitude)
+        dst[i + j] = MinimumMagnitude(fa, fb);
+      else if constexpr (op == kMaximumMagnitudeNumber)
+        dst[i + j] = MaximumMagnitudeNumber(fa, fb);
+      else
+        dst[i + j] = MinimumMagnitudeNumber(fa, fb);
+    }
+  }
+}
+
+template <typename FT>
+void FloppyFloat::MinMaxBatch(MinMaxOperation op, FT* dst, const FT* a, const FT* b, std::size_t n) {
+  switch (op) {
+  case kMaximum:
+    return MinMaxBatch<FT, kMaximum>(dst, a, b, n);
+  case kMinimum:
+    return MinMaxBatch<FT, kMinimum>(dst, a, b, n);
+  case kMaximumNumber:
+    return MinMaxBatch<FT, kMaximumNumber>(dst, a, b, n);
+  case kMinimumNumber:
+    return MinMaxBatch<FT, kMinimumNumber>(dst, a, b, n);
+  case kMaximumMagnitude:
+    return MinMaxBatch<FT, kMaximumMagnitude>(dst, a, b, n);
+  case kMinimumMagnitude:
+    return MinMaxBatch<FT, kMinimumMagnitude>(dst, a, b, n);
+  case kMaximumMagnitudeNumber:
+    return MinMaxBatch<FT, kMaximumMagnitudeNumber>(dst, a, b, n);
+  case kMinimumMagnitudeNumber:
+    return MinMaxBatch<FT, kMinimumMagnitudeNumber>(dst, a, b, n);
+  default:
+    throw std::runtime_error(std::string("Unknown minimum/maximum operation"));
+  }
+}
+
+template void FloppyFloat::MinMaxBatch<f16>(MinMaxOperation op, f16* dst, const f16* a, const f16* b, std::size_t n);
+template void FloppyFloat::MinMaxBatch<f32>(MinMaxOperation op, f32* dst, const f32* a, const f32* b, std::size_t n);
+template void FloppyFloat::MinMaxBatch<f64>(MinMaxOperation op, f64* dst, const f64* a, const f64* b, std::size_t n);
+
+// Rounds to an integral value with the host FPU, which is exact. f16 integral values are exact in f32.
+template <FloppyFloat::RoundingMode rm, typename FT>
+constexpr FT HostRoundToIntegral(FT a) {
+  if constexpr (std::is_same_v<FT, f16>) {
+    return static_cast<f16>(HostRoundToIntegral<rm>(static_cast<f32>(a)));
+  } else {
+    using HT = std::conditional_t<std::is_same_v<FT, f32>, float, double>;
+    const HT x = static_cast<HT>(a);
+    HT result;
+    if constexpr (rm == FloppyFloat::kRoundTiesToEven) {
+      if constexpr (std::is_same_v<HT, float>)
+        result = __builtin_roundevenf(x);
+      else
+        result = __builtin_roundeven(x);
+    } else if constexpr (rm == FloppyFloat::kRoundTowardPositive) {
+      result = std::ceil(x);
+    } else if constexpr (rm == FloppyFloat::kRoundTowardNegative) {
+      result = std::floor(x);
+    } else if constexpr (rm == FloppyFloat::kRoundTowardZero) {
+      result = std::trunc(x);
+    } else {
+      result = std::round(x);
+    }
+    return static_cast<FT>(result);
+  }
+}
+
+template <typename FT, FloppyFloat::RoundingMode rm, bool exact, bool flush>
+FT FloppyFloat::RoundToIntegral(FT a) {
+  if constexpr (flush)
+    FlushInputs<false>(a);
+  if (IsNan(a)) [[unlikely]] {
+    if (IsSnan(a))
+      invalid = true;
+    return PropagateNan<FT>(a, a);
+  }
+
+  const FT result = HostRoundToIntegral<rm>(a);
+  if (exact && result != a)
+    inexact = true;
+  return result;
+}
+
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTiesToEven, false>(f16 a);
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTowardPositive, false>(f16 a);
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTowardNegative, false>(f16 a);
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTowardZero, false>(f16 a);
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTiesToAway, false>(f16 a);
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTiesToEven, false>(f32 a);
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTowardPositive, false>(f32 a);
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTowardNegative, false>(f32 a);
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTowardZero, false>(f32 a);
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTiesToAway, false>(f32 a);
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTiesToEven, false>(f64 a);
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTowardPositive, false>(f64 a);
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTowardNegative, false>(f64 a);
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTowardZero, false>(f64 a);
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTiesToAway, false>(f64 a);
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTiesToEven, true>(f16 a);
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTowardPositive, true>(f16 a);
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTowardNegative, true>(f16 a);
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTowardZero, true>(f16 a);
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTiesToAway, true>(f16 a);
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTiesToEven, true>(f32 a);
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTowardPositive, true>(f32 a);
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTowardNegative, true>(f32 a);
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTowardZero, true>(f32 a);
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTiesToAway, true>(f32 a);
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTiesToEven, true>(f64 a);
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTowardPositive, true>(f64 a);
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTowardNegative, true>(f64 a);
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTowardZero, true>(f64 a);
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTiesToAway, true>(f64 a);
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTiesToEven, false, true>(f16 a);
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTowardPositive, false, true>(f16 a);
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTowardNegative, false, true>(f16 a);
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTowardZero, false, true>(f16 a);
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTiesToAway, false, true>(f16 a);
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTiesToEven, false, true>(f32 a);
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTowardPositive, false, true>(f32 a);
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTowardNegative, false, true>(f32 a);
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTowardZero, false, true>(f32 a);
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTiesToAway, false, true>(f32 a);
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTiesToEven, false, true>(f64 a);
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTowardPositive, false, true>(f64 a);
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTowardNegative, false, true>(f64 a);
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTowardZero, false, true>(f64 a);
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTiesToAway, false, true>(f64 a);
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTiesToEven, true, true>(f16 a);
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTowardPositive, true, true>(f16 a);
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTowardNegative, true, true>(f16 a);
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTowardZero, true, true>(f16 a);
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTiesToAway, true, true>(f16 a);
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTiesToEven, true, true>(f32 a);
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTowardPositive, true, true>(f32 a);
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTowardNegative, true, true>(f32 a);
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTowardZero, true, true>(f32 a);
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTiesToAway, true, true>(f32 a);
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTiesToEven, true, true>(f64 a);
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTowardPositive, true, true>(f64 a);
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTowardNegative, true, true>(f64 a);
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTowardZero, true, true>(f64 a);
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTiesToAway, true, true>(f64 a);
+
+template <typename FT>
+FT FloppyFloat::RoundToIntegral(FT a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return RoundToIntegral<FT, kRoundTiesToEven, false, true>(a);
+  case kRoundTiesToAway:
+    return RoundToIntegral<FT, kRoundTiesToAway, false, true>(a);
+  case kRoundTowardPositive:
+    return RoundToIntegral<FT, kRoundTowardPositive, false, true>(a);
+  case kRoundTowardNegative:
+    return RoundToIntegral<FT, kRoundTowardNegative, false, true>(a);
+  case kRoundTowardZero:
+    return RoundToIntegral<FT, kRoundTowardZero, false, true>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template f16 FloppyFloat::RoundToIntegral<f16>(f16 a);
+template f32 FloppyFloat::RoundToIntegral<f32>(f32 a);
+template f64 FloppyFloat::RoundToIntegral<f64>(f64 a);
+
+template <typename FT>
+FT FloppyFloat::RoundToIntegralExact(FT a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return RoundToIntegral<FT, kRoundTiesToEven, true, true>(a);
+  case kRoundTiesToAway:
+    return RoundToIntegral<FT, kRoundTiesToAway, true, true>(a);
+  case kRoundTowardPositive:
+    return RoundToIntegral<FT, kRoundTowardPositive, true, true>(a);
+  case kRoundTowardNegative:
+    return RoundToIntegral<FT, kRoundTowardNegative, true, true>(a);
+  case kRoundTowardZero:
+    return RoundToIntegral<FT, kRoundTowardZero, true, true>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template f16 FloppyFloat::RoundToIntegralExact<f16>(f16 a);
+template f32 FloppyFloat::RoundToIntegralExact<f32>(f32 a);
+template f64 FloppyFloat::RoundToIntegralExact<f64>(f64 a);
+
+template <typename FT, typename IT, FloppyFloat::RoundingMode rm, bool flush>
+FT FloppyFloat::RoundToIntegralBounded(FT a) {
+  static_assert(std::is_same_v<FT, f32> || std::is_same_v<FT, f64>);
+  static_assert(std::is_same_v<IT, i32> || std::is_same_v<IT, i64>);
+  constexpr FT kLimit = static_cast<FT>(static_cast<f64>(1ull << (NumBits<IT>() - 1)));
+  if constexpr (flush)
+    FlushInputs<false>(a);
+
+  const FT result = HostRoundToIntegral<rm>(a);
+  if (!(result >= -kLimit && result < kLimit)) [[unlikely]] {  // Also true for NaNs.
+    invalid = true;
+    return -kLimit;
+  }
+  if (result != a)
+    inexact = true;
+  return result;
+}
+
+template f32 FloppyFloat::RoundToIntegralBounded<f32, i32, FloppyFloat::kRoundTiesToEven>(f32 a);
+template f32 FloppyFloat::RoundToIntegralBounded<f32, i32, FloppyFloat::kRoundTowardPositive>(f32 a);
+template f32 FloppyFloat::RoundToIntegralBounded<f32, i32, FloppyFloat::kRoundTowardNegative>(f32 a);
+template f32 FloppyFloat::RoundToIntegralBounded<f32, i32, FloppyFloat::kRoundTowardZero>(f32 a);
+template f32 FloppyFloat::RoundToIntegralBounded<f32, i32, FloppyFloat::kRoundTiesToAway>(f32 a);
+template f32 FloppyFloat::RoundToIntegralBounded<f32, i64, FloppyFloat::kRoundTiesToEven>(f32 a);
+template f32 FloppyFloat::RoundToIntegralBounded<f32, i64, FloppyFloat::kRoundTowardPositive>(f32 a);
+template f32 FloppyFloat::RoundToIntegralBounded<f32, i64, FloppyFloat::kRoundTowardNegative>(f32 a);
+template f32 FloppyFloat::RoundToIntegralBounded<f32, i64, FloppyFloat::kRoundTowardZero>(f32 a);
+template f32 FloppyFloat::RoundToIntegralBounded<f32, i64, FloppyFloat::kRoundTiesToAway>(f32 a);
+template f64 FloppyFloat::RoundToIntegralBounded<f64, i32, FloppyFloat::kRoundTiesToEven>(f64 a);
+template f64 FloppyFloat::RoundToIntegralBounded<f64, i32, FloppyFloat::kRoundTowardPositive>(f64 a);
+template f64 FloppyFloat::RoundToIntegralBounded<f64, i32, FloppyFloat::kRoundTowardNegative>(f64 a);
+template f64 FloppyFloat::RoundToIntegralBounded<f64, i32, FloppyFloat::kRoundTowardZero>(f64 a);
+template f64 FloppyFloat::RoundToIntegralBounded<f64, i32, FloppyFloat::kRoundTiesToAway>(f64 a);
+template f64 FloppyFloat::RoundToIntegralBounded<f64, i64, FloppyFloat::kRoundTiesToEven>(f64 a);
+template f64 FloppyFloat::RoundToIntegralBounded<f64, i64, FloppyFloat::kRoundTowardPositive>(f64 a);
+template f64 FloppyFloat::RoundToIntegralBounded<f64, i64, FloppyFloat::kRoundTowardNegative>(f64 a);
+template f64 FloppyFloat::RoundToIntegralBounded<f64, i64, FloppyFloat::kRoundTowardZero>(f64 a);
+template f64 FloppyFloat::RoundToIntegralBounded<f64, i64, FloppyFloat::kRoundTiesToAway>(f64 a);
+template f32 FloppyFloat::RoundToIntegralBounded<f32, i32, FloppyFloat::kRoundTiesToEven, true>(f32 a);
+template f32 FloppyFloat::RoundToIntegralBounded<f32, i32, FloppyFloat::kRoundTowardPositive, true>(f32 a);
+template f32 FloppyFloat::RoundToIntegralBounded<f32, i32, FloppyFloat::kRoundTowardNegative, true>(f32 a);
+template f32 FloppyFloat::RoundToIntegralBounded<f32, i32, FloppyFloat::kRoundTowardZero, true>(f32 a);
+template f32 FloppyFloat::RoundToIntegralBounded<f32, i32, FloppyFloat::kRoundTiesToAway, true>(f32 a);
+template f32 FloppyFloat::RoundToIntegralBounded<f32, i64, FloppyFloat::kRoundTiesToEven, true>(f32 a);
+template f32 FloppyFloat::RoundToIntegralBounded<f32, i64, FloppyFloat::kRoundTowardPositive, true>(f32 a);
+template f32 FloppyFloat::RoundToIntegralBounded<f32, i64, FloppyFloat::kRoundTowardNegative, true>(f32 a);
+template f32 FloppyFloat::RoundToIntegralBounded<f32, i64, FloppyFloat::kRoundTowardZero, true>(f32 a);
+template f32 FloppyFloat::RoundToIntegralBounded<f32, i64, FloppyFloat::kRoundTiesToAway, true>(f32 a);
+template f64 FloppyFloat::RoundToIntegralBounded<f64, i32, FloppyFloat::kRoundTiesToEven, true>(f64 a);
+template f64 FloppyFloat::RoundToIntegralBounded<f64, i32, FloppyFloat::kRoundTowardPositive, true>(f64 a);
+template f64 FloppyFloat::RoundToIntegralBounded<f64, i32, FloppyFloat::kRoundTowardNegative, true>(f64 a);
+template f64 FloppyFloat::RoundToIntegralBounded<f64, i32, FloppyFloat::kRoundTowardZero, true>(f64 a);
+template f64 FloppyFloat::RoundToIntegralBounded<f64, i32, FloppyFloat::kRoundTiesToAway, true>(f64 a);
+template f64 FloppyFloat::RoundToIntegralBounded<f64, i64, FloppyFloat::kRoundTiesToEven, true>(f64 a);
+template f64 FloppyFloat::RoundToIntegralBounded<f64, i64, FloppyFloat::kRoundTowardPositive, true>(f64 a);
+template f64 FloppyFloat::RoundToIntegralBounded<f64, i64, FloppyFloat::kRoundTowardNegative, true>(f64 a);
+template f64 FloppyFloat::RoundToIntegralBounded<f64, i64, FloppyFloat::kRoundTowardZero, true>(f64 a);
+template f64 FloppyFloat::RoundToIntegralBounded<f64, i64, FloppyFloat::kRoundTiesToAway, true>(f64 a);
+
+template <typename FT, typename IT>
+FT FloppyFloat::RoundToIntegralBounded(FT a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return RoundToIntegralBounded<FT, IT, kRoundTiesToEven, true>(a);
+  case kRoundTiesToAway:
+    return RoundToIntegralBounded<FT, IT, kRoundTiesToAway, true>(a);
+  case kRoundTowardPositive:
+    return RoundToIntegralBounded<FT, IT, kRoundTowardPositive, true>(a);
+  case kRoundTowardNegative:
+    return RoundToIntegralBounded<FT, IT, kRoundTowardNegative, true>(a);
+  case kRoundTowardZero:
+    return RoundToIntegralBounded<FT, IT, kRoundTowardZero, true>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template f32 FloppyFloat::RoundToIntegralBounded<f32, i32>(f32 a);
+template f32 FloppyFloat::RoundToIntegralBounded<f32, i64>(f32 a);
+template f64 FloppyFloat::RoundToIntegralBounded<f64, i32>(f64 a);
+template f64 FloppyFloat::RoundToIntegralBounded<f64, i64>(f64 a);
+
+template <typename FT>
+FT FloppyFloat::Roundx86(FT a, u8 imm8) {
+  FlushInputs<false>(a);  // ROUNDSS/ROUNDSD honor DAZ, but don't report DE.
+  if (IsNan(a)) [[unlikely]] {
+    if (IsSnan(a))
+      invalid = true;
+    return SetQuietBit(a);
+  }
+
+  constexpr RoundingMode kRoundingModes[4] = {kRoundTiesToEven, kRoundTowardNegative, kRoundTowardPositive,
+                                              kRoundTowardZero};
+  const RoundingMode rm = (imm8 & 0x4) ? rounding_mode : kRoundingModes[imm8 & 0x3];
+  FT result;
+  switch (rm) {
+  case kRoundTiesToEven:
+    result = HostRoundToIntegral<kRoundTiesToEven>(a);
+    break;
+  case kRoundTiesToAway:
+    result = HostRoundToIntegral<kRoundTiesToAway>(a);
+    break;
+  case kRoundTowardPositive:
+    result = HostRoundToIntegral<kRoundTowardPositive>(a);
+    break;
+  case kRoundTowardNegative:
+    result = HostRoundToIntegral<kRoundTowardNegative>(a);
+    break;
+  case kRoundTowardZero:
+    result = HostRoundToIntegral<kRoundTowardZero>(a);
+    break;
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+
+  if (!(imm8 & 0x8) && result != a)
+    inexact = true;
+  return result;
+}
+
+template f16 FloppyFloat::Roundx86<f16>(f16 a, u8 imm8);
+template f32 FloppyFloat::Roundx86<f32>(f32 a, u8 imm8);
+template f64 FloppyFloat::Roundx86<f64>(f64 a, u8 imm8);
+
+template <typename FT, FloppyFloat::RoundingMode rm, bool exact, bool flush>
+void FloppyFloat::RoundToIntegralBatch(FT* dst, const FT* a, std::size_t n) {
+  constexpr std::size_t kBlockSize = 64;
+  const bool flush_inputs_ft = flush && (std::is_same_v<FT, f16> ? flush_inputs_f16 : flush_inputs);
+  for (std::size_t i = 0; i < n; i += kBlockSize) {
+    const std::size_t block_size = std::min(kBlockSize, n - i);
+    FT result[kBlockSize];
+    bool nan = false;
+    bool denormal = false;
+    bool block_inexact = false;
+    for (std::size_t j = 0; j < block_size; ++j) {
+      result[j] = HostRoundToIntegral<rm>(a[i + j]);
+      nan |= IsNan(a[i + j]);
+      denormal |= IsSubnormal(a[i + j]);
+      block_inexact |= result[j] != a[i + j];
+    }
+
+    if (!nan && !(denormal && flush_inputs_ft)) [[likely]] {
+      std::memcpy(dst + i, result, block_size * sizeof(FT));
+      if (exact && block_inexact)
+        inexact = true;
+      continue;
+    }
+
+    for (std::size_t j = 0; j < block_size; ++j)
+      dst[i + j] = RoundToIntegral<FT, rm, exact, flush>(a[i + j]);
+  }
+}
+
+template void FloppyFloat::RoundToIntegralBatch<f16, FloppyFloat::kRoundTiesToEven, false>(f16* dst, const f16* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f16, FloppyFloat::kRoundTowardPositive, false>(f16* dst, const f16* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f16, FloppyFloat::kRoundTowardNegative, false>(f16* dst, const f16* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f16, FloppyFloat::kRoundTowardZero, false>(f16* dst, const f16* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f16, FloppyFloat::kRoundTiesToAway, false>(f16* dst, const f16* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f32, FloppyFloat::kRoundTiesToEven, false>(f32* dst, const f32* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f32, FloppyFloat::kRoundTowardPositive, false>(f32* dst, const f32* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f32, FloppyFloat::kRoundTowardNegative, false>(f32* dst, const f32* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f32, FloppyFloat::kRoundTowardZero, false>(f32* dst, const f32* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f32, FloppyFloat::kRoundTiesToAway, false>(f32* dst, const f32* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f64, FloppyFloat::kRoundTiesToEven, false>(f64* dst, const f64* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f64, FloppyFloat::kRoundTowardPositive, false>(f64* dst, const f64* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f64, FloppyFloat::kRoundTowardNegative, false>(f64* dst, const f64* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f64, FloppyFloat::kRoundTowardZero, false>(f64* dst, const f64* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f64, FloppyFloat::kRoundTiesToAway, false>(f64* dst, const f64* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f16, FloppyFloat::kRoundTiesToEven, true>(f16* dst, const f16* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f16, FloppyFloat::kRoundTowardPositive, true>(f16* dst, const f16* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f16, FloppyFloat::kRoundTowardNegative, true>(f16* dst, const f16* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f16, FloppyFloat::kRoundTowardZero, true>(f16* dst, const f16* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f16, FloppyFloat::kRoundTiesToAway, true>(f16* dst, const f16* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f32, FloppyFloat::kRoundTiesToEven, true>(f32* dst, const f32* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f32, FloppyFloat::kRoundTowardPositive, true>(f32* dst, const f32* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f32, FloppyFloat::kRoundTowardNegative, true>(f32* dst, const f32* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f32, FloppyFloat::kRoundTowardZero, true>(f32* dst, const f32* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f32, FloppyFloat::kRoundTiesToAway, true>(f32* dst, const f32* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f64, FloppyFloat::kRoundTiesToEven, true>(f64* dst, const f64* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f64, FloppyFloat::kRoundTowardPositive, true>(f64* dst, const f64* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f64, FloppyFloat::kRoundTowardNegative, true>(f64* dst, const f64* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f64, FloppyFloat::kRoundTowardZero, true>(f64* dst, const f64* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f64, FloppyFloat::kRoundTiesToAway, true>(f64* dst, const f64* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f16, FloppyFloat::kRoundTiesToEven, false, true>(f16* dst, const f16* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f16, FloppyFloat::kRoundTowardPositive, false, true>(f16* dst, const f16* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f16, FloppyFloat::kRoundTowardNegative, false, true>(f16* dst, const f16* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f16, FloppyFloat::kRoundTowardZero, false, true>(f16* dst, const f16* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f16, FloppyFloat::kRoundTiesToAway, false, true>(f16* dst, const f16* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f32, FloppyFloat::kRoundTiesToEven, false, true>(f32* dst, const f32* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f32, FloppyFloat::kRoundTowardPositive, false, true>(f32* dst, const f32* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f32, FloppyFloat::kRoundTowardNegative, false, true>(f32* dst, const f32* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f32, FloppyFloat::kRoundTowardZero, false, true>(f32* dst, const f32* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f32, FloppyFloat::kRoundTiesToAway, false, true>(f32* dst, const f32* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f64, FloppyFloat::kRoundTiesToEven, false, true>(f64* dst, const f64* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f64, FloppyFloat::kRoundTowardPositive, false, true>(f64* dst, const f64* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f64, FloppyFloat::kRoundTowardNegative, false, true>(f64* dst, const f64* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f64, FloppyFloat::kRoundTowardZero, false, true>(f64* dst, const f64* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f64, FloppyFloat::kRoundTiesToAway, false, true>(f64* dst, const f64* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f16, FloppyFloat::kRoundTiesToEven, true, true>(f16* dst, const f16* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f16, FloppyFloat::kRoundTowardPositive, true, true>(f16* dst, const f16* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f16, FloppyFloat::kRoundTowardNegative, true, true>(f16* dst, const f16* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f16, FloppyFloat::kRoundTowardZero, true, true>(f16* dst, const f16* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f16, FloppyFloat::kRoundTiesToAway, true, true>(f16* dst, const f16* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f32, FloppyFloat::kRoundTiesToEven, true, true>(f32* dst, const f32* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f32, FloppyFloat::kRoundTowardPositive, true, true>(f32* dst, const f32* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f32, FloppyFloat::kRoundTowardNegative, true, true>(f32* dst, const f32* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f32, FloppyFloat::kRoundTowardZero, true, true>(f32* dst, const f32* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f32, FloppyFloat::kRoundTiesToAway, true, true>(f32* dst, const f32* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f64, FloppyFloat::kRoundTiesToEven, true, true>(f64* dst, const f64* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f64, FloppyFloat::kRoundTowardPositive, true, true>(f64* dst, const f64* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f64, FloppyFloat::kRoundTowardNegative, true, true>(f64* dst, const f64* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f64, FloppyFloat::kRoundTowardZero, true, true>(f64* dst, const f64* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f64, FloppyFloat::kRoundTiesToAway, true, true>(f64* dst, const f64* a, std::size_t n);
+
+template <typename FT>
+void FloppyFloat::RoundToIntegralBatch(FT* dst, const FT* a, std::size_t n) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return RoundToIntegralBatch<FT, kRoundTiesToEven, false, true>(dst, a, n);
+  case kRoundTiesToAway:
+    return RoundToIntegralBatch<FT, kRoundTiesToAway, false, true>(dst, a, n);
+  case kRoundTowardPositive:
+    return RoundToIntegralBatch<FT, kRoundTowardPositive, false, true>(dst, a, n);
+  case kRoundTowardNegative:
+    return RoundToIntegralBatch<FT, kRoundTowardNegative, false, true>(dst, a, n);
+  case kRoundTowardZero:
+    return RoundToIntegralBatch<FT, kRoundTowardZero, false, true>(dst, a, n);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template void FloppyFloat::RoundToIntegralBatch<f16>(f16* dst, const f16* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f32>(f32* dst, const f32* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralBatch<f64>(f64* dst, const f64* a, std::size_t n);
+
+template <typename FT>
+void FloppyFloat::RoundToIntegralExactBatch(FT* dst, const FT* a, std::size_t n) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return RoundToIntegralBatch<FT, kRoundTiesToEven, true, true>(dst, a, n);
+  case kRoundTiesToAway:
+    return RoundToIntegralBatch<FT, kRoundTiesToAway, true, true>(dst, a, n);
+  case kRoundTowardPositive:
+    return RoundToIntegralBatch<FT, kRoundTowardPositive, true, true>(dst, a, n);
+  case kRoundTowardNegative:
+    return RoundToIntegralBatch<FT, kRoundTowardNegative, true, true>(dst, a, n);
+  case kRoundTowardZero:
+    return RoundToIntegralBatch<FT, kRoundTowardZero, true, true>(dst, a, n);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template void FloppyFloat::RoundToIntegralExactBatch<f16>(f16* dst, const f16* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralExactBatch<f32>(f32* dst, const f32* a, std::size_t n);
+template void FloppyFloat::RoundToIntegralExactBatch<f64>(f64* dst, const f64* a, std::size_t n);
+
+i32 FloppyFloat::F64ToI32Js(f64 a, bool& z) {
+  const i32 result = F64ToI32Modular(a);
+  z = std::bit_cast<u64>(static_cast<f64>(result)) == std::bit_cast<u64>(a);  // Exact, and not -0.
+  return result;
+}
+
+template <typename FT, FloppyFloat::RoundingMode rm, bool flush>
+FT FloppyFloat::MulxArm(FT a, FT b) {
+  if constexpr (flush) {
+    if (ChecksDenormals<FT>(a, b))
+      return FlushDenormals<FT>([this](FT x, FT y) { return MulxArm<FT, rm>(x, y); }, IsTinyProduct<FT>, a, b);
+  }
+  if ((IsInf(a) && IsZero(b)) || (IsZero(a) && IsInf(b))) [[unlikely]] {
+    return std::signbit(a) != std::signbit(b) ? static_cast<FT>(-2.f) : static_cast<FT>(2.f);
+  }
+  return Mul<FT, rm>(a, b);
+}
+
+template f16 FloppyFloat::MulxArm<f16, FloppyFloat::kRoundTiesToEven>(f16 a, f16 b);
+template f16 FloppyFloat::MulxArm<f16, FloppyFloat::kRoundTowardPositive>(f16 a, f16 b);
+template f16 FloppyFloat::MulxArm<f16, FloppyFloat::kRoundTowardNegative>(f16 a, f16 b);
+template f16 FloppyFloat::MulxArm<f16, FloppyFloat::kRoundTowardZero>(f16 a, f16 b);
+template f16 FloppyFloat::MulxArm<f16, FloppyFloat::kRoundTiesToAway>(f16 a, f16 b);
+template f32 FloppyFloat::MulxArm<f32, FloppyFloat::kRoundTiesToEven>(f32 a, f32 b);
+template f32 FloppyFloat::MulxArm<f32, FloppyFloat::kRoundTowardPositive>(f32 a, f32 b);
+template f32 FloppyFloat::MulxArm<f32, FloppyFloat::kRoundTowardNegative>(f32 a, f32 b);
+template f32 FloppyFloat::MulxArm<f32, FloppyFloat::kRoundTowardZero>(f32 a, f32 b);
+template f32 FloppyFloat::MulxArm<f32, FloppyFloat::kRoundTiesToAway>(f32 a, f32 b);
+template f64 FloppyFloat::MulxArm<f64, FloppyFloat::kRoundTiesToEven>(f64 a, f64 b);
+template f64 FloppyFloat::MulxArm<f64, FloppyFloat::kRoundTowardPositive>(f64 a, f64 b);
+template f64 FloppyFloat::MulxArm<f64, FloppyFloat::kRoundTowardNegative>(f64 a, f64 b);
+template f64 FloppyFloat::MulxArm<f64, FloppyFloat::kRoundTowardZero>(f64 a, f64 b);
+template f64 FloppyFloat::MulxArm<f64, FloppyFloat::kRoundTiesToAway>(f64 a, f64 b);
+template f16 FloppyFloat::MulxArm<f16, FloppyFloat::kRoundTiesToEven, true>(f16 a, f16 b);
+template f16 FloppyFloat::MulxArm<f16, FloppyFloat::kRoundTowardPositive, true>(f16 a, f16 b);
+template f16 FloppyFloat::MulxArm<f16, FloppyFloat::kRoundTowardNegative, true>(f16 a, f16 b);
+template f16 FloppyFloat::MulxArm<f16, FloppyFloat::kRoundTowardZero, true>(f16 a, f16 b);
+template f16 FloppyFloat::MulxArm<f16, FloppyFloat::kRoundTiesToAway, true>(f16 a, f16 b);
+template f32 FloppyFloat::MulxArm<f32, FloppyFloat::kRoundTiesToEven, true>(f32 a, f32 b);
+template f32 FloppyFloat::MulxArm<f32, FloppyFloat::kRoundTowardPositive, true>(f32 a, f32 b);
+template f32 FloppyFloat::MulxArm<f32, FloppyFloat::kRoundTowardNegative, true>(f32 a, f32 b);
+template f32 FloppyFloat::MulxArm<f32, FloppyFloat::kRoundTowardZero, true>(f32 a, f32 b);
+template f32 FloppyFloat::MulxArm<f32, FloppyFloat::kRoundTiesToAway, true>(f32 a, f32 b);
+template f64 FloppyFloat::MulxArm<f64, FloppyFloat::kRoundTiesToEven, true>(f64 a, f64 b);
+template f64 FloppyFloat::MulxArm<f64, FloppyFloat::kRoundTowardPositive, true>(f64 a, f64 b);
+template f64 FloppyFloat::MulxArm<f64, FloppyFloat::kRoundTowardNegative, true>(f64 a, f64 b);
+template f64 FloppyFloat::MulxArm<f64, FloppyFloat::kRoundTowardZero, true>(f64 a, f64 b);
+template f64 FloppyFloat::MulxArm<f64, FloppyFloat::kRoundTiesToAway, true>(f64 a, f64 b);
+
+template <typename FT>
+FT FloppyFloat::MulxArm(FT a, FT b) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return MulxArm<FT, kRoundTiesToEven, true>(a, b);
+  case kRoundTiesToAway:
+    return MulxArm<FT, kRoundTiesToAway, true>(a, b);
+  case kRoundTowardPositive:
+    return MulxArm<FT, kRoundTowardPositive, true>(a, b);
+  case kRoundTowardNegative:
+    return MulxArm<FT, kRoundTowardNegative, true>(a, b);
+  case kRoundTowardZero:
+    return MulxArm<FT, kRoundTowardZero, true>(a, b);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template f16 FloppyFloat::MulxArm<f16>(f16 a, f16 b);
+template f32 FloppyFloat::MulxArm<f32>(f32 a, f32 b);
+template f64 FloppyFloat::MulxArm<f64>(f64 a, f64 b);
+
+// Arm negates a before the NaN propagation, so that a NaN in a also changes its sign.
+template <typename FT, FloppyFloat::RoundingMode rm, bool flush>
+FT FloppyFloat::RecipStepArm(FT a, FT b) {
+  if constexpr (flush) {
+    if (ChecksDenormals<FT>(a, b))
+      return FlushDenormals<FT>([this](FT x, FT y) { return RecipStepArm<FT, rm>(x, y); },
+                                [](FT, FT) { return false; }, a, b);
+  }
+  if ((IsInf(a) && IsZero(b)) || (IsZero(a) && IsInf(b))) [[unlikely]]
+    return static_cast<FT>(2.f);
+  return Fma<FT, rm>(Negate(a), b, static_cast<FT>(2.f));
+}
+
+template f16 FloppyFloat::RecipStepArm<f16, FloppyFloat::kRoundTiesToEven>(f16 a, f16 b);
+template f16 FloppyFloat::RecipStepArm<f16, FloppyFloat::kRoundTowardPositive>(f16 a, f16 b);
+template f16 FloppyFloat::RecipStepArm<f16, FloppyFloat::kRoundTowardNegative>(f16 a, f16 b);
+template f16 FloppyFloat::RecipStepArm<f16, FloppyFloat::kRoundTowardZero>(f16 a, f16 b);
+template f16 FloppyFloat::RecipStepArm<f16, FloppyFloat::kRoundTiesToAway>(f16 a, f16 b);
+template f32 FloppyFloat::RecipStepArm<f32, FloppyFloat::kRoundTiesToEven>(f32 a, f32 b);
+template f32 FloppyFloat::RecipStepArm<f32, FloppyFloat::kRoundTowardPositive>(f32 a, f32 b);
+template f32 FloppyFloat::RecipStepArm<f32, FloppyFloat::kRoundTowardNegative>(f32 a, f32 b);
+template f32 FloppyFloat::RecipStepArm<f32, FloppyFloat::kRoundTowardZero>(f32 a, f32 b);
+template f32 FloppyFloat::RecipStepArm<f32, FloppyFloat::kRoundTiesToAway>(f32 a, f32 b);
+template f64 FloppyFloat::RecipStepArm<f64, FloppyFloat::kRoundTiesToEven>(f64 a, f64 b);
+template f64 FloppyFloat::RecipStepArm<f64, FloppyFloat::kRoundTowardPositive>(f64 a, f64 b);
+template f64 FloppyFloat::RecipStepArm<f64, FloppyFloat::kRoundTowardNegative>(f64 a, f64 b);
+template f64 FloppyFloat::RecipStepArm<f64, FloppyFloat::kRoundTowardZero>(f64 a, f64 b);
+template f64 FloppyFloat::RecipStepArm<f64, FloppyFloat::kRoundTiesToAway>(f64 a, f64 b);
+template f16 FloppyFloat::RecipStepArm<f16, FloppyFloat::kRoundTiesToEven, true>(f16 a, f16 b);
+template f16 FloppyFloat::RecipStepArm<f16, FloppyFloat::kRoundTowardPositive, true>(f16 a, f16 b);
+template f16 FloppyFloat::RecipStepArm<f16, FloppyFloat::kRoundTowardNegative, true>(f16 a, f16 b);
+template f16 FloppyFloat::RecipStepArm<f16, FloppyFloat::kRoundTowardZero, true>(f16 a, f16 b);
+template f16 FloppyFloat::RecipStepArm<f16, FloppyFloat::kRoundTiesToAway, true>(f16 a, f16 b);
+template f32 FloppyFloat::RecipStepArm<f32, FloppyFloat::kRoundTiesToEven, true>(f32 a, f32 b);
+template f32 FloppyFloat::RecipStepArm<f32, FloppyFloat::kRoundTowardPositive, true>(f32 a, f32 b);
+template f32 FloppyFloat::RecipStepArm<f32, FloppyFloat::kRoundTowardNegative, true>(f32 a, f32 b);
+template f32 FloppyFloat::RecipStepArm<f32, FloppyFloat::kRoundTowardZero, true>(f32 a, f32 b);
+template f32 FloppyFloat::RecipStepArm<f32, FloppyFloat::kRoundTiesToAway, true>(f32 a, f32 b);
+template f64 FloppyFloat::RecipStepArm<f64, FloppyFloat::kRoundTiesToEven, true>(f64 a, f64 b);
+template f64 FloppyFloat::RecipStepArm<f64, FloppyFloat::kRoundTowardPositive, true>(f64 a, f64 b);
+template f64 FloppyFloat::RecipStepArm<f64, FloppyFloat::kRoundTowardNegative, true>(f64 a, f64 b);
+template f64 FloppyFloat::RecipStepArm<f64, FloppyFloat::kRoundTowardZero, true>(f64 a, f64 b);
+template f64 FloppyFloat::RecipStepArm<f64, FloppyFloat::kRoundTiesToAway, true>(f64 a, f64 b);
+
+template <typename FT>
+FT FloppyFloat::RecipStepArm(FT a, FT b) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return RecipStepArm<FT, kRoundTiesToEven, true>(a, b);
+  case kRoundTiesToAway:
+    return RecipStepArm<FT, kRoundTiesToAway, true>(a, b);
+  case kRoundTowardPositive:
+    return RecipStepArm<FT, kRoundTowardPositive, true>(a, b);
+  case kRoundTowardNegative:
+    return RecipStepArm<FT, kRoundTowardNegative, true>(a, b);
+  case kRoundTowardZero:
+    return RecipStepArm<FT, kRoundTowardZero, true>(a, b);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template f16 FloppyFloat::RecipStepArm<f16>(f16 a, f16 b);
+template f32 FloppyFloat::RecipStepArm<f32>(f32 a, f32 b);
+template f64 FloppyFloat::RecipStepArm<f64>(f64 a, f64 b);
+
+// (3 - a * b) / 2 is computed as 1.5 - (a / 2) * b, so that the result is rounded once. Halving is exact unless the
+// operand is tiny. If both are tiny, 3 - a * b is close to 3 and halving the rounded result is exact.
+template <typename FT, FloppyFloat::RoundingMode rm, bool flush>
+FT FloppyFloat::RsqrtStepArm(FT a, FT b) {
+  if constexpr (flush) {
+    if (ChecksDenormals<FT>(a, b))
+      return FlushDenormals<FT>([this](FT x, FT y) { return RsqrtStepArm<FT, rm>(x, y); },
+                                [](FT, FT) { return false; }, a, b);
+  }
+  if ((IsInf(a) && IsZero(b)) || (IsZero(a) && IsInf(b))) [[unlikely]]
+    return static_cast<FT>(1.5f);
+
+  constexpr FT kHalvable = static_cast<FT>(2.f) * std::numeric_limits<FT>::min();
+  if (a >= kHalvable || a <= -kHalvable) [[likely]]
+    return Fma<FT, rm>(-(a * static_cast<FT>(0.5f)), b, static_cast<FT>(1.5f));
+  if (b >= kHalvable || b <= -kHalvable)
+    return Fma<FT, rm>(Negate(a), b * static_cast<FT>(0.5f), static_cast<FT>(1.5f));
+  return Fma<FT, rm>(Negate(a), b, static_cast<FT>(3.f)) * static_cast<FT>(0.5f);
+}
+
+template f16 FloppyFloat::RsqrtStepArm<f16, FloppyFloat::kRoundTiesToEven>(f16 a, f16 b);
+template f16 FloppyFloat::RsqrtStepArm<f16, FloppyFloat::kRoundTowardPositive>(f16 a, f16 b);
+template f16 FloppyFloat::RsqrtStepArm<f16, FloppyFloat::kRoundTowardNegative>(f16 a, f16 b);
+template f16 FloppyFloat::RsqrtStepArm<f16, FloppyFloat::kRoundTowardZero>(f16 a, f16 b);
+template f16 FloppyFloat::RsqrtStepArm<f16, FloppyFloat::kRoundTiesToAway>(f16 a, f16 b);
+template f32 FloppyFloat::RsqrtStepArm<f32, FloppyFloat::kRoundTiesToEven>(f32 a, f32 b);
+template f32 FloppyFloat::RsqrtStepArm<f32, FloppyFloat::kRoundTowardPositive>(f32 a, f32 b);
+template f32 FloppyFloat::RsqrtStepArm<f32, FloppyFloat::kRoundTowardNegative>(f32 a, f32 b);
+template f32 FloppyFloat::RsqrtStepArm<f32, FloppyFloat::kRoundTowardZero>(f32 a, f32 b);
+template f32 FloppyFloat::RsqrtStepArm<f32, FloppyFloat::kRoundTiesToAway>(f32 a, f32 b);
+template f64 FloppyFloat::RsqrtStepArm<f64, FloppyFloat::kRoundTiesToEven>(f64 a, f64 b);
+template f64 FloppyFloat::RsqrtStepArm<f64, FloppyFloat::kRoundTowardPositive>(f64 a, f64 b);
+template f64 FloppyFloat::RsqrtStepArm<f64, FloppyFloat::kRoundTowardNegative>(f64 a, f64 b);
+template f64 FloppyFloat::RsqrtStepArm<f64, FloppyFloat::kRoundTowardZero>(f64 a, f64 b);
+template f64 FloppyFloat::RsqrtStepArm<f64, FloppyFloat::kRoundTiesToAway>(f64 a, f64 b);
+template f16 FloppyFloat::RsqrtStepArm<f16, FloppyFloat::kRoundTiesToEven, true>(f16 a, f16 b);
+template f16 FloppyFloat::RsqrtStepArm<f16, FloppyFloat::kRoundTowardPositive, true>(f16 a, f16 b);
+template f16 FloppyFloat::RsqrtStepArm<f16, FloppyFloat::kRoundTowardNegative, true>(f16 a, f16 b);
+template f16 FloppyFloat::RsqrtStepArm<f16, FloppyFloat::kRoundTowardZero, true>(f16 a, f16 b);
+template f16 FloppyFloat::RsqrtStepArm<f16, FloppyFloat::kRoundTiesToAway, true>(f16 a, f16 b);
+template f32 FloppyFloat::RsqrtStepArm<f32, FloppyFloat::kRoundTiesToEven, true>(f32 a, f32 b);
+template f32 FloppyFloat::RsqrtStepArm<f32, FloppyFloat::kRoundTowardPositive, true>(f32 a, f32 b);
+template f32 FloppyFloat::RsqrtStepArm<f32, FloppyFloat::kRoundTowardNegative, true>(f32 a, f32 b);
+template f32 FloppyFloat::RsqrtStepArm<f32, FloppyFloat::kRoundTowardZero, true>(f32 a, f32 b);
+template f32 FloppyFloat::RsqrtStepArm<f32, FloppyFloat::kRoundTiesToAway, true>(f32 a, f32 b);
+template f64 FloppyFloat::RsqrtStepArm<f64, FloppyFloat::kRoundTiesToEven, true>(f64 a, f64 b);
+template f64 FloppyFloat::RsqrtStepArm<f64, FloppyFloat::kRoundTowardPositive, true>(f64 a, f64 b);
+template f64 FloppyFloat::RsqrtStepArm<f64, FloppyFloat::kRoundTowardNegative, true>(f64 a, f64 b);
+template f64 FloppyFloat::RsqrtStepArm<f64, FloppyFloat::kRoundTowardZero, true>(f64 a, f64 b);
+template f64 FloppyFloat::RsqrtStepArm<f64, FloppyFloat::kRoundTiesToAway, true>(f64 a, f64 b);
+
+template <typename FT>
+FT FloppyFloat::RsqrtStepArm(FT a, FT b) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return RsqrtStepArm<FT, kRoundTiesToEven, true>(a, b);
+  case kRoundTiesToAway:
+    return RsqrtStepArm<FT, kRoundTiesToAway, true>(a, b);
+  case kRoundTowardPositive:
+    return RsqrtStepArm<FT, kRoundTowardPositive, true>(a, b);
+  case kRoundTowardNegative:
+    return RsqrtStepArm<FT, kRoundTowardNegative, true>(a, b);
+  case kRoundTowardZero:
+    return RsqrtStepArm<FT, kRoundTowardZero, true>(a, b);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template f16 FloppyFloat::RsqrtStepArm<f16>(f16 a, f16 b);
+template f32 FloppyFloat::RsqrtStepArm<f32>(f32 a, f32 b);
+template f64 FloppyFloat::RsqrtStepArm<f64>(f64 a, f64 b);
+
+template <typename FT, FloppyFloat::RoundingMode rm, bool flush>
+FT FloppyFloat::AbsDiff(FT a, FT b) {
+  if constexpr (flush) {
+    if (ChecksDenormals<FT>(a, b))
+      return FlushDenormals<FT>([this](FT x, FT y) { return AbsDiff<FT, rm>(x, y); },
+                                [](FT, FT) { return false; }, a, b);
+  }
+  using UT = typename FloatToUint<FT>::type;
+  const FT difference = Sub<FT, rm>(a, b);
+  return std::bit_cast<FT>(static_cast<UT>(std::bit_cast<UT>(difference) & ~SignMask<FT>()));
+}
+
+template f16 FloppyFloat::AbsDiff<f16, FloppyFloat::kRoundTiesToEven>(f16 a, f16 b);
+template f16 FloppyFloat::AbsDiff<f16, FloppyFloat::kRoundTowardPositive>(f16 a, f16 b);
+template f16 FloppyFloat::AbsDiff<f16, FloppyFloat::kRoundTowardNegative>(f16 a, f16 b);
+template f16 FloppyFloat::AbsDiff<f16, FloppyFloat::kRoundTowardZero>(f16 a, f16 b);
+template f16 FloppyFloat::AbsDiff<f16, FloppyFloat::kRoundTiesToAway>(f16 a, f16 b);
+template f32 FloppyFloat::AbsDiff<f32, FloppyFloat::kRoundTiesToEven>(f32 a, f32 b);
+template f32 FloppyFloat::AbsDiff<f32, FloppyFloat::kRoundTowardPositive>(f32 a, f32 b);
+template f32 FloppyFloat::AbsDiff<f32, FloppyFloat::kRoundTowardNegative>(f32 a, f32 b);
+template f32 FloppyFloat::AbsDiff<f32, FloppyFloat::kRoundTowardZero>(f32 a, f32 b);
+template f32 FloppyFloat::AbsDiff<f32, FloppyFloat::kRoundTiesToAway>(f32 a, f32 b);
+template f64 FloppyFloat::AbsDiff<f64, FloppyFloat::kRoundTiesToEven>(f64 a, f64 b);
+template f64 FloppyFloat::AbsDiff<f64, FloppyFloat::kRoundTowardPositive>(f64 a, f64 b);
+template f64 FloppyFloat::AbsDiff<f64, FloppyFloat::kRoundTowardNegative>(f64 a, f64 b);
+template f64 FloppyFloat::AbsDiff<f64, FloppyFloat::kRoundTowardZero>(f64 a, f64 b);
+template f64 FloppyFloat::AbsDiff<f64, FloppyFloat::kRoundTiesToAway>(f64 a, f64 b);
+template f16 FloppyFloat::AbsDiff<f16, FloppyFloat::kRoundTiesToEven, true>(f16 a, f16 b);
+template f16 FloppyFloat::AbsDiff<f16, FloppyFloat::kRoundTowardPositive, true>(f16 a, f16 b);
+template f16 FloppyFloat::AbsDiff<f16, FloppyFloat::kRoundTowardNegative, true>(f16 a, f16 b);
+template f16 FloppyFloat::AbsDiff<f16, FloppyFloat::kRoundTowardZero, true>(f16 a, f16 b);
+template f16 FloppyFloat::AbsDiff<f16, FloppyFloat::kRoundTiesToAway, true>(f16 a, f16 b);
+template f32 FloppyFloat::AbsDiff<f32, FloppyFloat::kRoundTiesToEven, true>(f32 a, f32 b);
+template f32 FloppyFloat::AbsDiff<f32, FloppyFloat::kRoundTowardPositive, true>(f32 a, f32 b);
+template f32 FloppyFloat::AbsDiff<f32, FloppyFloat::kRoundTowardNegative, true>(f32 a, f32 b);
+template f32 FloppyFloat::AbsDiff<f32, FloppyFloat::kRoundTowardZero, true>(f32 a, f32 b);
+template f32 FloppyFloat::AbsDiff<f32, FloppyFloat::kRoundTiesToAway, true>(f32 a, f32 b);
+template f64 FloppyFloat::AbsDiff<f64, FloppyFloat::kRoundTiesToEven, true>(f64 a, f64 b);
+template f64 FloppyFloat::AbsDiff<f64, FloppyFloat::kRoundTowardPositive, true>(f64 a, f64 b);
+template f64 FloppyFloat::AbsDiff<f64, FloppyFloat::kRoundTowardNegative, true>(f64 a, f64 b);
+template f64 FloppyFloat::AbsDiff<f64, FloppyFloat::kRoundTowardZero, true>(f64 a, f64 b);
+template f64 FloppyFloat::AbsDiff<f64, FloppyFloat::kRoundTiesToAway, true>(f64 a, f64 b);
+
+template <typename FT>
+FT FloppyFloat::AbsDiff(FT a, FT b) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return AbsDiff<FT, kRoundTiesToEven, true>(a, b);
+  case kRoundTiesToAway:
+    return AbsDiff<FT, kRoundTiesToAway, true>(a, b);
+  case kRoundTowardPositive:
+    return AbsDiff<FT, kRoundTowardPositive, true>(a, b);
+  case kRoundTowardNegative:
+    return AbsDiff<FT, kRoundTowardNegative, true>(a, b);
+  case kRoundTowardZero:
+    return AbsDiff<FT, kRoundTowardZero, true>(a, b);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template f16 FloppyFloat::AbsDiff<f16>(f16 a, f16 b);
+template f32 FloppyFloat::AbsDiff<f32>(f32 a, f32 b);
+template f64 FloppyFloat::AbsDiff<f64>(f64 a, f64 b);
+
+template <typename FT, FloppyFloat::ArmOperation op, FloppyFloat::RoundingMode rm>
+void FloppyFloat::ArmBatch(FT* dst, const FT* a, const FT* b, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    if constexpr (op == kMulxArm)
+      dst[i] = MulxArm<FT, rm, true>(a[i], b[i]);
+    else if constexpr (op == kRecipStepArm)
+      dst[i] = RecipStepArm<FT, rm, true>(a[i], b[i]);
+    else if constexpr (op == kRsqrtStepArm)
+      dst[i] = RsqrtStepArm<FT, rm, true>(a[i], b[i]);
+    else
+      dst[i] = AbsDiff<FT, rm, true>(a[i], b[i]);
+  }
+}
+
+template <typename FT, FloppyFloat::ArmOperation op>
+void FloppyFloat::ArmBatch(FT* dst, const FT* a, const FT* b, std::size_t n) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return ArmBatch<FT, op, kRoundTiesToEven>(dst, a, b, n);
+  case kRoundTiesToAway:
+    return ArmBatch<FT, op, kRoundTiesToAway>(dst, a, b, n);
+  case kRoundTowardPositive:
+    return ArmBatch<FT, op, kRoundTowardPositive>(dst, a, b, n);
+  case kRoundTowardNegative:
+    return ArmBatch<FT, op, kRoundTowardNegative>(dst, a, b, n);
+  case kRoundTowardZero:
+    return ArmBatch<FT, op, kRoundTowardZero>(dst, a, b, n);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <typename FT>
+void FloppyFloat::ArmBatch(ArmOperation op, FT* dst, const FT* a, const FT* b, std::size_t n) {
+  switch (op) {
+  case kMulxArm:
+    return ArmBatch<FT, kMulxArm>(dst, a, b, n);
+  case kRecipStepArm:
+    return ArmBatch<FT, kRecipStepArm>(dst, a, b, n);
+  case kRsqrtStepArm:
+    return ArmBatch<FT, kRsqrtStepArm>(dst, a, b, n);
+  case kAbsDiff:
+    return ArmBatch<FT, kAbsDiff>(dst, a, b, n);
+  default:
+    throw std::runtime_error(std::string("Unknown Arm operation"));
+  }
+}
+
+template void FloppyFloat::ArmBatch<f16>(ArmOperation op, f16* dst, const f16* a, const f16* b, std::size_t n);
+template void FloppyFloat::ArmBatch<f32>(ArmOperation op, f32* dst, const f32* a, const f32* b, std::size_t n);
+template void FloppyFloat::ArmBatch<f64>(ArmOperation op, f64* dst, const f64* a, const f64* b, std::size_t n);
+
+// Returns the significand of a finite nonzero value with the msb at position NumSignificandBits and sets lsb_exp to
+// the exponent of its lsb.
+template <typename FT>
+constexpr u64 SplitSignificand(FT a, i32& lsb_exp) {
+  using UT = typename FloatToUint<FT>::type;
+  constexpr i32 kSigBits = NumSignificandBits<FT>();
+  const UT ua = std::bit_cast<UT>(a) & ~SignMask<FT>();
+  const i32 biased_exp = static_cast<i32>(ua >> kSigBits);
+  const u64 signif = ua & MaxSignificand<FT>();
+  if (biased_exp == 0) {
+    const i32 shift = std::countl_zero(signif) - (63 - kSigBits);
+    lsb_exp = 1 - Bias<FT>() - kSigBits - shift;
+    return signif << shift;
+  }
+  lsb_exp = biased_exp - Bias<FT>() - kSigBits;
+  return signif | (1ull << kSigBits);
+}
+
+template <typename FT>
+constexpr FT RemainderOfFinite(FT a, FT b, bool round_to_nearest, bool partial, u32& quotient, bool& incomplete) {
+  i32 a_exp, b_exp;
+  const u64 a_signif = SplitSignificand(a, a_exp);
+  const u64 b_signif = SplitSignificand(b, b_exp);
+  const SignificandRemainder r = RemainderOfSignificands(a_signif, a_exp, b_signif, b_exp, round_to_nearest, partial);
+  quotient = static_cast<u32>(r.quotient & 0x7);
+  incomplete = r.incomplete;
+  const f64 magnitude = std::ldexp(static_cast<f64>(r.rem), r.exp);  // Exact, as it is a multiple of the lsb of b.
+  return static_cast<FT>(std::signbit(a) != r.negate ? -magnitude : magnitude);
+}
+
+template <typename FT>
+FT FloppyFloat::Remainder(FT a, FT b) {
+  if (IsNan(a) || IsNan(b)) [[unlikely]] {
+    if (IsSnan(a) || IsSnan(b))
+      invalid = true;
+    return PropagateNan<FT>(a, b);
+  }
+  if (IsInf(a) || IsZero(b)) [[unlikely]] {
+    invalid = true;
+    return GetQnan<FT>();
+  }
+  if (IsInf(b) || IsZero(a)) [[unlikely]]
+    return a;
+
+  // The remainder is exact, so the host result only needs the sign of zero fixed, which is not always that of a (e.g.,
+  // in glibc). The run time of the host remainder grows with the exponent difference, though, so large differences
+  // are left to the long division in steps of 64 bits.
+  using UT = typename FloatToUint<FT>::type;
+  const i32 a_exp = static_cast<i32>((std::bit_cast<UT>(a) & ExponentMask<FT>()) >> NumSignificandBits<FT>());
+  const i32 b_exp = static_cast<i32>((std::bit_cast<UT>(b) & ExponentMask<FT>()) >> NumSignificandBits<FT>());
+  if (a_exp - b_exp <= NumSignificandBits<FT>()) [[likely]] {
+    const f64 result = std::remainder(static_cast<f64>(a), static_cast<f64>(b));
+    return result == 0. ? std::copysign(static_cast<FT>(0.f), a) : static_cast<FT>(result);
+  }
+
+  u32 quotient;
+  bool incomplete;
+  return RemainderOfFinite(a, b, true, false, quotient, incomplete);
+}
+
+template f16 FloppyFloat::Remainder<f16>(f16 a, f16 b);
+template f32 FloppyFloat::Remainder<f32>(f32 a, f32 b);
+template f64 FloppyFloat::Remainder<f64>(f64 a, f64 b);
+
+template <typename FT>
+FT FloppyFloat::PartialRemainder(FT a, FT b, bool round_to_nearest, u32& quotient, bool& incomplete) {
+  quotient = 0;
+  incomplete = false;
+  if (IsNan(a) || IsNan(b)) [[unlikely]] {
+    if (IsSnan(a) || IsSnan(b))
+      invalid = true;
+    return PropagateNan<FT>(a, b);
+  }
+  if (IsInf(a) || IsZero(b)) [[unlikely]] {
+    invalid = true;
+    return GetQnan<FT>();
+  }
+  if (IsInf(b) || IsZero(a)) [[unlikely]]
+    return a;
+  return RemainderOfFinite(a, b, round_to_nearest, true, quotient, incomplete);
+}
+
+template f16 FloppyFloat::PartialRemainder<f16>(f16 a, f16 b, bool round_to_nearest, u32& quotient, bool& incomplete);
+template f32 FloppyFloat::PartialRemainder<f32>(f32 a, f32 b, bool round_to_nearest, u32& quotient, bool& incomplete);
+template f64 FloppyFloat::PartialRemainder<f64>(f64 a, f64 b, bool round_to_nearest, u32& quotient, bool& incomplete);
+
+f32 FloppyFloat::F16ToF32(f16 a) {
+  if (IsNan(a)) [[unlikely]] {
+    if (!GetQuietBit(a))
+      invalid = true;
+    return PropagateNan<f16, f32>(a);
+  }
+
+  return static_cast<f32>(a);
+}
+
+f64 FloppyFloat::F16ToF64(f16 a) {
+  if (IsNan(a)) [[unlikely]] {
+    if (!GetQuietBit(a))
+      invalid = true;
+    return PropagateNan<f16, f64>(a);
+  }
+
+  return static_cast<f64>(a);
+}
+
+f32 FloppyFloat::BF16ToF32(bf16 a) {
+  if (IsNan(a)) [[unlikely]] {
+    if (!GetQuietBit(a))
+      invalid = true;
+    return PropagateNan<bf16, f32>(a);
+  }
+
+  return WidenBF16(a);
+}
+
+// Assumes that "result" was calculated with "kRoundTowardZero"
+template <typename FT, typename IT, FloppyFloat::RoundingMode rm>
+constexpr IT RoundIntegerResult(FT residual, FT source, IT result) {
+  if constexpr (rm == FloppyFloat::kRoundTowardNegative) {
+    if (residual > 0)
+      result -= 1;
+  } else if constexpr (rm == FloppyFloat::kRoundTowardPositive) {
+    if (residual < 0)
+      result += 1;
+  } else {
+    if (residual) {
+      FT ia_p05 = static_cast<FT>(result) + static_cast<FT>(0.5);
+      if constexpr (rm == FloppyFloat::kRoundTiesToEven) {
+        if (ia_p05 <= source) {
+          if (ia_p05 == source) [[unlikely]] {
+            if (!(result % 2))
+              result -= 1;
+          }
+          result += 1;
+        }
+      } else if constexpr (rm == FloppyFloat::kRoundTiesToAway) {
+        if (ia_p05 <= source)
+          result += 1;
+      }
+    }
+  }
+  return result;
+}
+
+i32 FloppyFloat::F32ToI32(f32 a) {
+  FlushInputs<false>(a);
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return F32ToI32<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return F32ToI32<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return F32ToI32<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return F32ToI32<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return F32ToI32<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <FloppyFloat::RoundingMode rm, bool quiet>
+i32 FloppyFloat::F32ToI32(f32 a) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  if (IsNan(a)) [[unlikely]] {
+    invalid = true;
+    return nan_limit_i32_;
+  } else if (a >= 2147483648.f32) [[unlikely]] {
     invalid = true;
     return max_limit_i32_;
   } else if (a < -2147483648.f32) [[unlikely]] {
@@ -1211,7 +3986,14 @@ template i32 FloppyFloat::F32ToI32<FloppyFloat::kRoundTowardNegative>(f32 a);
 template i32 FloppyFloat::F32ToI32<FloppyFloat::kRoundTowardPositive>(f32 a);
 template i32 FloppyFloat::F32ToI32<FloppyFloat::kRoundTowardZero>(f32 a);
 
+template i32 FloppyFloat::F32ToI32<FloppyFloat::kRoundTiesToEven, true>(f32 a);
+template i32 FloppyFloat::F32ToI32<FloppyFloat::kRoundTiesToAway, true>(f32 a);
+template i32 FloppyFloat::F32ToI32<FloppyFloat::kRoundTowardNegative, true>(f32 a);
+template i32 FloppyFloat::F32ToI32<FloppyFloat::kRoundTowardPositive, true>(f32 a);
+template i32 FloppyFloat::F32ToI32<FloppyFloat::kRoundTowardZero, true>(f32 a);
+
 i64 FloppyFloat::F32ToI64(f32 a) {
+  FlushInputs<false>(a);
   switch (rounding_mode) {
   case kRoundTiesToEven:
     return F32ToI64<kRoundTiesToEven>(a);
@@ -1228,8 +4010,9 @@ i64 FloppyFloat::F32ToI64(f32 a) {
   }
 }
 
-template <FloppyFloat::RoundingMode rm>
+template <FloppyFloat::RoundingMode rm, bool quiet>
 i64 FloppyFloat::F32ToI64(f32 a) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
   if (IsNan(a)) [[unlikely]] {
     invalid = true;
     return nan_limit_i64_;
@@ -1271,6 +4054,12 @@ template i64 FloppyFloat::F32ToI64<FloppyFloat::kRoundTowardNegative>(f32 a);
 template i64 FloppyFloat::F32ToI64<FloppyFloat::kRoundTowardZero>(f32 a);
 template i64 FloppyFloat::F32ToI64<FloppyFloat::kRoundTiesToAway>(f32 a);
 
+template i64 FloppyFloat::F32ToI64<FloppyFloat::kRoundTiesToEven, true>(f32 a);
+template i64 FloppyFloat::F32ToI64<FloppyFloat::kRoundTowardPositive, true>(f32 a);
+template i64 FloppyFloat::F32ToI64<FloppyFloat::kRoundTowardNegative, true>(f32 a);
+template i64 FloppyFloat::F32ToI64<FloppyFloat::kRoundTowardZero, true>(f32 a);
+template i64 FloppyFloat::F32ToI64<FloppyFloat::kRoundTiesToAway, true>(f32 a);
+
 template <typename FT, FloppyFloat::RoundingMode rm>
 bool ResultOutOfURange(FT a) {
   if constexpr (rm == FloppyFloat::kRoundTowardZero || rm == FloppyFloat::kRoundTowardPositive) {
@@ -1287,6 +4076,7 @@ bool ResultOutOfURange(FT a) {
 }
 
 u32 FloppyFloat::F32ToU32(f32 a) {
+  FlushInputs<false>(a);
   switch (rounding_mode) {
   case kRoundTiesToEven:
     return F32ToU32<kRoundTiesToEven>(a);
@@ -1303,8 +4093,9 @@ u32 FloppyFloat::F32ToU32(f32 a) {
   }
 }
 
-template <FloppyFloat::RoundingMode rm>
+template <FloppyFloat::RoundingMode rm, bool quiet>
 u32 FloppyFloat::F32ToU32(f32 a) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
   if (IsNan(a)) [[unlikely]] {
     invalid = true;
     return nan_limit_u32_;
@@ -1341,65 +4132,224 @@ u32 FloppyFloat::F32ToU32(f32 a) {
       ia += 1;
   }
 
-  return ia;
+  return ia;
+}
+
+template u32 FloppyFloat::F32ToU32<FloppyFloat::kRoundTiesToEven>(f32 a);
+template u32 FloppyFloat::F32ToU32<FloppyFloat::kRoundTowardPositive>(f32 a);
+template u32 FloppyFloat::F32ToU32<FloppyFloat::kRoundTowardNegative>(f32 a);
+template u32 FloppyFloat::F32ToU32<FloppyFloat::kRoundTowardZero>(f32 a);
+template u32 FloppyFloat::F32ToU32<FloppyFloat::kRoundTiesToAway>(f32 a);
+
+template u32 FloppyFloat::F32ToU32<FloppyFloat::kRoundTiesToEven, true>(f32 a);
+template u32 FloppyFloat::F32ToU32<FloppyFloat::kRoundTowardPositive, true>(f32 a);
+template u32 FloppyFloat::F32ToU32<FloppyFloat::kRoundTowardNegative, true>(f32 a);
+template u32 FloppyFloat::F32ToU32<FloppyFloat::kRoundTowardZero, true>(f32 a);
+template u32 FloppyFloat::F32ToU32<FloppyFloat::kRoundTiesToAway, true>(f32 a);
+
+u64 FloppyFloat::F32ToU64(f32 a) {
+  FlushInputs<false>(a);
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return F32ToU64<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return F32ToU64<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return F32ToU64<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return F32ToU64<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return F32ToU64<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <FloppyFloat::RoundingMode rm, bool quiet>
+u64 FloppyFloat::F32ToU64(f32 a) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  if (IsNan(a)) [[unlikely]] {
+    invalid = true;
+    return nan_limit_u64_;
+  } else if (a >= 18446744073709551616.0f32) [[unlikely]] {
+    invalid = true;
+    return max_limit_u64_;
+  } else if (a < 0.f) [[unlikely]] {
+    if (ResultOutOfURange<f32, rm>(a)) {
+      invalid = true;
+      return min_limit_u64_;
+    }
+    inexact = true;
+    return std::numeric_limits<u64>::min();
+  }
+
+  u64 ia = static_cast<u64>(a);  // C++ always truncates (i.e., rounds to zero).
+
+  f32 r = static_cast<f32>(ia) - a;
+  if (!IsZero(r))
+    inexact = true;
+
+  return RoundIntegerResult<f32, u64, rm>(r, a, ia);
+}
+
+template u64 FloppyFloat::F32ToU64<FloppyFloat::kRoundTiesToEven>(f32 a);
+template u64 FloppyFloat::F32ToU64<FloppyFloat::kRoundTowardPositive>(f32 a);
+template u64 FloppyFloat::F32ToU64<FloppyFloat::kRoundTowardNegative>(f32 a);
+template u64 FloppyFloat::F32ToU64<FloppyFloat::kRoundTowardZero>(f32 a);
+template u64 FloppyFloat::F32ToU64<FloppyFloat::kRoundTiesToAway>(f32 a);
+
+template u64 FloppyFloat::F32ToU64<FloppyFloat::kRoundTiesToEven, true>(f32 a);
+template u64 FloppyFloat::F32ToU64<FloppyFloat::kRoundTowardPositive, true>(f32 a);
+template u64 FloppyFloat::F32ToU64<FloppyFloat::kRoundTowardNegative, true>(f32 a);
+template u64 FloppyFloat::F32ToU64<FloppyFloat::kRoundTowardZero, true>(f32 a);
+template u64 FloppyFloat::F32ToU64<FloppyFloat::kRoundTiesToAway, true>(f32 a);
+
+i32 FloppyFloat::F16ToI32(f16 a) {
+  FlushInputs<false>(a);
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return F16ToI32<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return F16ToI32<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return F16ToI32<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return F16ToI32<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return F16ToI32<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <FloppyFloat::RoundingMode rm, bool quiet>
+i32 FloppyFloat::F16ToI32(f16 a) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  return F32ToI32<rm>(static_cast<f32>(a));  // Every f16 is exactly representable as f32.
+}
+
+template i32 FloppyFloat::F16ToI32<FloppyFloat::kRoundTiesToEven>(f16 a);
+template i32 FloppyFloat::F16ToI32<FloppyFloat::kRoundTowardPositive>(f16 a);
+template i32 FloppyFloat::F16ToI32<FloppyFloat::kRoundTowardNegative>(f16 a);
+template i32 FloppyFloat::F16ToI32<FloppyFloat::kRoundTowardZero>(f16 a);
+template i32 FloppyFloat::F16ToI32<FloppyFloat::kRoundTiesToAway>(f16 a);
+
+template i32 FloppyFloat::F16ToI32<FloppyFloat::kRoundTiesToEven, true>(f16 a);
+template i32 FloppyFloat::F16ToI32<FloppyFloat::kRoundTowardPositive, true>(f16 a);
+template i32 FloppyFloat::F16ToI32<FloppyFloat::kRoundTowardNegative, true>(f16 a);
+template i32 FloppyFloat::F16ToI32<FloppyFloat::kRoundTowardZero, true>(f16 a);
+template i32 FloppyFloat::F16ToI32<FloppyFloat::kRoundTiesToAway, true>(f16 a);
+
+i64 FloppyFloat::F16ToI64(f16 a) {
+  FlushInputs<false>(a);
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return F16ToI64<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return F16ToI64<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return F16ToI64<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return F16ToI64<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return F16ToI64<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <FloppyFloat::RoundingMode rm, bool quiet>
+i64 FloppyFloat::F16ToI64(f16 a) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  return F32ToI64<rm>(static_cast<f32>(a));  // Every f16 is exactly representable as f32.
+}
+
+template i64 FloppyFloat::F16ToI64<FloppyFloat::kRoundTiesToEven>(f16 a);
+template i64 FloppyFloat::F16ToI64<FloppyFloat::kRoundTowardPositive>(f16 a);
+template i64 FloppyFloat::F16ToI64<FloppyFloat::kRoundTowardNegative>(f16 a);
+template i64 FloppyFloat::F16ToI64<FloppyFloat::kRoundTowardZero>(f16 a);
+template i64 FloppyFloat::F16ToI64<FloppyFloat::kRoundTiesToAway>(f16 a);
+
+template i64 FloppyFloat::F16ToI64<FloppyFloat::kRoundTiesToEven, true>(f16 a);
+template i64 FloppyFloat::F16ToI64<FloppyFloat::kRoundTowardPositive, true>(f16 a);
+template i64 FloppyFloat::F16ToI64<FloppyFloat::kRoundTowardNegative, true>(f16 a);
+template i64 FloppyFloat::F16ToI64<FloppyFloat::kRoundTowardZero, true>(f16 a);
+template i64 FloppyFloat::F16ToI64<FloppyFloat::kRoundTiesToAway, true>(f16 a);
+
+u32 FloppyFloat::F16ToU32(f16 a) {
+  FlushInputs<false>(a);
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return F16ToU32<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return F16ToU32<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return F16ToU32<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return F16ToU32<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return F16ToU32<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <FloppyFloat::RoundingMode rm, bool quiet>
+u32 FloppyFloat::F16ToU32(f16 a) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  return F32ToU32<rm>(static_cast<f32>(a));  // Every f16 is exactly representable as f32.
 }
 
-template u32 FloppyFloat::F32ToU32<FloppyFloat::kRoundTiesToEven>(f32 a);
-template u32 FloppyFloat::F32ToU32<FloppyFloat::kRoundTowardPositive>(f32 a);
-template u32 FloppyFloat::F32ToU32<FloppyFloat::kRoundTowardNegative>(f32 a);
-template u32 FloppyFloat::F32ToU32<FloppyFloat::kRoundTowardZero>(f32 a);
-template u32 FloppyFloat::F32ToU32<FloppyFloat::kRoundTiesToAway>(f32 a);
+template u32 FloppyFloat::F16ToU32<FloppyFloat::kRoundTiesToEven>(f16 a);
+template u32 FloppyFloat::F16ToU32<FloppyFloat::kRoundTowardPositive>(f16 a);
+template u32 FloppyFloat::F16ToU32<FloppyFloat::kRoundTowardNegative>(f16 a);
+template u32 FloppyFloat::F16ToU32<FloppyFloat::kRoundTowardZero>(f16 a);
+template u32 FloppyFloat::F16ToU32<FloppyFloat::kRoundTiesToAway>(f16 a);
 
-u64 FloppyFloat::F32ToU64(f32 a) {
+template u32 FloppyFloat::F16ToU32<FloppyFloat::kRoundTiesToEven, true>(f16 a);
+template u32 FloppyFloat::F16ToU32<FloppyFloat::kRoundTowardPositive, true>(f16 a);
+template u32 FloppyFloat::F16ToU32<FloppyFloat::kRoundTowardNegative, true>(f16 a);
+template u32 FloppyFloat::F16ToU32<FloppyFloat::kRoundTowardZero, true>(f16 a);
+template u32 FloppyFloat::F16ToU32<FloppyFloat::kRoundTiesToAway, true>(f16 a);
+
+u64 FloppyFloat::F16ToU64(f16 a) {
+  FlushInputs<false>(a);
   switch (rounding_mode) {
   case kRoundTiesToEven:
-    return F32ToU64<kRoundTiesToEven>(a);
+    return F16ToU64<kRoundTiesToEven>(a);
   case kRoundTiesToAway:
-    return F32ToU64<kRoundTiesToAway>(a);
+    return F16ToU64<kRoundTiesToAway>(a);
   case kRoundTowardPositive:
-    return F32ToU64<kRoundTowardPositive>(a);
+    return F16ToU64<kRoundTowardPositive>(a);
   case kRoundTowardNegative:
-    return F32ToU64<kRoundTowardNegative>(a);
+    return F16ToU64<kRoundTowardNegative>(a);
   case kRoundTowardZero:
-    return F32ToU64<kRoundTowardZero>(a);
+    return F16ToU64<kRoundTowardZero>(a);
   default:
     throw std::runtime_error(std::string("Unknown rounding mode"));
   }
 }
 
-template <FloppyFloat::RoundingMode rm>
-u64 FloppyFloat::F32ToU64(f32 a) {
-  if (IsNan(a)) [[unlikely]] {
-    invalid = true;
-    return nan_limit_u64_;
-  } else if (a >= 18446744073709551616.0f32) [[unlikely]] {
-    invalid = true;
-    return max_limit_u64_;
-  } else if (a < 0.f) [[unlikely]] {
-    if (ResultOutOfURange<f32, rm>(a)) {
-      invalid = true;
-      return min_limit_u64_;
-    }
-    inexact = true;
-    return std::numeric_limits<u64>::min();
-  }
-
-  u64 ia = static_cast<u64>(a);  // C++ always truncates (i.e., rounds to zero).
-
-  f32 r = static_cast<f32>(ia) - a;
-  if (!IsZero(r))
-    inexact = true;
-
-  return RoundIntegerResult<f32, u64, rm>(r, a, ia);
+template <FloppyFloat::RoundingMode rm, bool quiet>
+u64 FloppyFloat::F16ToU64(f16 a) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  return F32ToU64<rm>(static_cast<f32>(a));  // Every f16 is exactly representable as f32.
 }
 
-template u64 FloppyFloat::F32ToU64<FloppyFloat::kRoundTiesToEven>(f32 a);
-template u64 FloppyFloat::F32ToU64<FloppyFloat::kRoundTowardPositive>(f32 a);
-template u64 FloppyFloat::F32ToU64<FloppyFloat::kRoundTowardNegative>(f32 a);
-template u64 FloppyFloat::F32ToU64<FloppyFloat::kRoundTowardZero>(f32 a);
-template u64 FloppyFloat::F32ToU64<FloppyFloat::kRoundTiesToAway>(f32 a);
+template u64 FloppyFloat::F16ToU64<FloppyFloat::kRoundTiesToEven>(f16 a);
+template u64 FloppyFloat::F16ToU64<FloppyFloat::kRoundTowardPositive>(f16 a);
+template u64 FloppyFloat::F16ToU64<FloppyFloat::kRoundTowardNegative>(f16 a);
+template u64 FloppyFloat::F16ToU64<FloppyFloat::kRoundTowardZero>(f16 a);
+template u64 FloppyFloat::F16ToU64<FloppyFloat::kRoundTiesToAway>(f16 a);
+
+template u64 FloppyFloat::F16ToU64<FloppyFloat::kRoundTiesToEven, true>(f16 a);
+template u64 FloppyFloat::F16ToU64<FloppyFloat::kRoundTowardPositive, true>(f16 a);
+template u64 FloppyFloat::F16ToU64<FloppyFloat::kRoundTowardNegative, true>(f16 a);
+template u64 FloppyFloat::F16ToU64<FloppyFloat::kRoundTowardZero, true>(f16 a);
+template u64 FloppyFloat::F16ToU64<FloppyFloat::kRoundTiesToAway, true>(f16 a);
 
 f64 FloppyFloat::F32ToF64(f32 a) {
+  FlushInputs(a);
   if (IsNan(a)) [[unlikely]] {
     if (!GetQuietBit(a))
       invalid = true;
@@ -1409,78 +4359,163 @@ f64 FloppyFloat::F32ToF64(f32 a) {
   return static_cast<f64>(a);
 }
 
-f16 FloppyFloat::F32ToF16(f32 a) {
-  switch (rounding_mode) {
-  case kRoundTiesToEven:
-    return F32ToF16<kRoundTiesToEven>(a);
-  case kRoundTiesToAway:
-    return F32ToF16<kRoundTiesToAway>(a);
-  case kRoundTowardPositive:
-    return F32ToF16<kRoundTowardPositive>(a);
-  case kRoundTowardNegative:
-    return F32ToF16<kRoundTowardNegative>(a);
-  case kRoundTowardZero:
-    return F32ToF16<kRoundTowardZero>(a);
-  default:
-    throw std::runtime_error(std::string("Unknown rounding mode"));
+f128 FloppyFloat::F32ToF128(f32 a) {
+  if (IsNan(a)) [[unlikely]] {
+    if (!GetQuietBit(a))
+      invalid = true;
+    return PropagateNan<f32, f128>(a);
   }
+
+  return static_cast<f128>(a);
 }
 
-template <FloppyFloat::RoundingMode rm>
-f16 FloppyFloat::F32ToF16(f32 a) {
+template <typename TFROM, typename TTO, FloppyFloat::RoundingMode rm>
+constexpr TTO FloppyFloat::RoundNarrowResult(TFROM a, TFROM residual, TTO result) {
   if constexpr (rm == kRoundTiesToAway) {
-    return SoftFloat::F32ToF16(a);
+    if (residual != static_cast<TFROM>(0.) && std::signbit(a) != std::signbit(residual)) {  // Rounded towards zero.
+      TTO away = std::signbit(a) ? NextDownNoPosZero(result) : NextUpNoNegZero(result);
+      if (static_cast<TFROM>(away) - a == -residual)  // Tie.
+        result = away;
+    }
+    return result;
+  } else {
+    return RoundResult<TTO, TFROM, rm>(residual, result);
   }
+}
+
+template <typename TFROM, typename TTO, FloppyFloat::RoundingMode rm>
+TTO FloppyFloat::FToF(TFROM a) {
+  static_assert(NumBits<TFROM>() > NumBits<TTO>());
 
   if (IsNan(a)) [[unlikely]] {
     if (!GetQuietBit(a))
       invalid = true;
-    return PropagateNan<f32, f16>(a);
+    return PropagateNan<TFROM, TTO>(a);
   }
 
-  f16 result = static_cast<f16>(a);
-
-  if (IsInfOrNan(result)) [[unlikely]] {
-    if (IsNan(result)) {
-      if (!GetQuietBit(a))
-        invalid = true;
-      return GetQnan<f16>();
-    } else {  // Infinity case.
-      if (!IsInf(a)) {
-        overflow = true;
+  if constexpr (std::is_same_v<TFROM, f128>) {
+    // Without host binary128 arithmetic, the significand is rounded as an integer. Results that become subnormal or
+    // may overflow are left to SoftFloat.
+    using UTTO = FloatToUint<TTO>::type;
+    constexpr i32 kShift = NumSignificandBits<f128>() - NumSignificandBits<TTO>();
+    const i32 exp = GetExponent(a) - Bias<f128>() + Bias<TTO>();
+    if (exp > 0 && exp < MaxExponent<TTO>() - 1) [[likely]] {
+      const bool sign = std::bit_cast<u128>(a) >> (NumBits<f128>() - 1);
+      const u128 mant = ImplicitSignificandF128(std::bit_cast<u128>(a));
+      if (mant & ((static_cast<u128>(1) << kShift) - 1))
         inexact = true;
-        result = RoundInf<f16, rm>(result);
-      }
+      UTTO result = static_cast<UTTO>(sign) << (NumBits<TTO>() - 1);
+      result += static_cast<UTTO>(exp - 1) << NumSignificandBits<TTO>();
+      result += static_cast<UTTO>(RshiftRound<rm>(sign, mant, kShift));
+      return std::bit_cast<TTO>(result);
+    }
+    return SoftFloat::FToF<TFROM, TTO, rm>(a);
+  }
+
+  TTO result = static_cast<TTO>(a);
+
+  if (IsInf(result)) [[unlikely]] {
+    if (IsInf(a))
       return result;
+    // Everything at or above 2^(emax+1) overflows regardless of the rounding mode.
+    constexpr TFROM overflow_limit = FloatFrom3Tuple<TFROM>(0, Bias<TFROM>() + Bias<TTO>() + 1, 0);
+    if (std::abs(a) >= overflow_limit || rm == kRoundTiesToEven || rm == kRoundTiesToAway) {
+      overflow = true;
+      inexact = true;
+      return RoundInf<TTO, rm>(result);
     }
+    result = std::signbit(a) ? nl<TTO>::lowest() : nl<TTO>::max();
   }
 
-  f32 residual = static_cast<f32>(result) - a;
-  if (residual != 0.f32)
-    inexact = true;
+  // The narrowed value lies within a factor of two of the source, so the residual is exact.
+  TFROM residual = static_cast<TFROM>(result) - a;
+  if (residual == static_cast<TFROM>(0.))
+    return result;
 
-  result = RoundResult<f16, f32, rm>(residual, result);
+  inexact = true;
+  result = RoundNarrowResult<TFROM, TTO, rm>(a, residual, result);
 
-  if (!underflow) {
-    if (std::abs(result) <= nl<f16>::min()) [[unlikely]] {
-      if (std::abs(result) == nl<f16>::min()) {
-        result = SoftFloat::F32ToF16(a);
-      } else {
-        if (residual != 0.f32)
-          underflow = true;
-      }
+  if (std::abs(a) < static_cast<TFROM>(nl<TTO>::min())) [[unlikely]] {
+    if (tininess_before_rounding || IsTiny(result)) {
+      underflow = true;
+    } else {
+      // The result was rounded up to the smallest normal number. Tininess after rounding is defined with an
+      // unbounded exponent range, so redo the rounding with the source scaled into the normal range.
+      TFROM a2 = a * static_cast<TFROM>(2.);
+      TTO result2 = static_cast<TTO>(a2);
+      result2 = RoundNarrowResult<TFROM, TTO, rm>(a2, static_cast<TFROM>(result2) - a2, result2);
+      if (std::abs(result2) < static_cast<TTO>(2.) * nl<TTO>::min())
+        underflow = true;
     }
   }
 
   return result;
 }
 
+f16 FloppyFloat::F32ToF16(f32 a) {
+  FlushInputs(a);  // Neither x86 nor Arm flush half-precision results of conversions.
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return F32ToF16<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return F32ToF16<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return F32ToF16<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return F32ToF16<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return F32ToF16<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <FloppyFloat::RoundingMode rm, bool quiet>
+f16 FloppyFloat::F32ToF16(f32 a) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  return FToF<f32, f16, rm>(a);
+}
+
 template f16 FloppyFloat::F32ToF16<FloppyFloat::kRoundTiesToEven>(f32 a);
 template f16 FloppyFloat::F32ToF16<FloppyFloat::kRoundTowardPositive>(f32 a);
 template f16 FloppyFloat::F32ToF16<FloppyFloat::kRoundTowardNegative>(f32 a);
 template f16 FloppyFloat::F32ToF16<FloppyFloat::kRoundTowardZero>(f32 a);
 template f16 FloppyFloat::F32ToF16<FloppyFloat::kRoundTiesToAway>(f32 a);
 
+template f16 FloppyFloat::F32ToF16<FloppyFloat::kRoundTiesToEven, true>(f32 a);
+template f16 FloppyFloat::F32ToF16<FloppyFloat::kRoundTowardPositive, true>(f32 a);
+template f16 FloppyFloat::F32ToF16<FloppyFloat::kRoundTowardNegative, true>(f32 a);
+template f16 FloppyFloat::F32ToF16<FloppyFloat::kRoundTowardZero, true>(f32 a);
+template f16 FloppyFloat::F32ToF16<FloppyFloat::kRoundTiesToAway, true>(f32 a);
+
+bf16 FloppyFloat::F32ToBF16(f32 a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return F32ToBF16<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return F32ToBF16<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return F32ToBF16<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return F32ToBF16<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return F32ToBF16<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <FloppyFloat::RoundingMode rm>
+bf16 FloppyFloat::F32ToBF16(f32 a) {
+  return FToF<f32, bf16, rm>(a);
+}
+
+template bf16 FloppyFloat::F32ToBF16<FloppyFloat::kRoundTiesToEven>(f32 a);
+template bf16 FloppyFloat::F32ToBF16<FloppyFloat::kRoundTowardPositive>(f32 a);
+template bf16 FloppyFloat::F32ToBF16<FloppyFloat::kRoundTowardNegative>(f32 a);
+template bf16 FloppyFloat::F32ToBF16<FloppyFloat::kRoundTowardZero>(f32 a);
+template bf16 FloppyFloat::F32ToBF16<FloppyFloat::kRoundTiesToAway>(f32 a);
+
 template <FloppyFloat::RoundingMode rm>
 constexpr f64 F64ToI32NegLimit() {
   if constexpr (rm == FloppyFloat::kRoundTiesToEven) {
@@ -1511,49 +4546,398 @@ constexpr f64 F64ToI32PosLimit() {
   }
 }
 
-i32 FloppyFloat::F64ToI32(f64 a) {
+i32 FloppyFloat::F64ToI32(f64 a) {
+  FlushInputs<false>(a);
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return F64ToI32<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return F64ToI32<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return F64ToI32<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return F64ToI32<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return F64ToI32<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+f16 FloppyFloat::F64ToF16(f64 a) {
+  FlushInputs(a);  // Neither x86 nor Arm flush half-precision results of conversions.
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return F64ToF16<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return F64ToF16<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return F64ToF16<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return F64ToF16<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return F64ToF16<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <FloppyFloat::RoundingMode rm, bool quiet>
+f16 FloppyFloat::F64ToF16(f64 a) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  return FToF<f64, f16, rm>(a);
+}
+
+template f16 FloppyFloat::F64ToF16<FloppyFloat::kRoundTiesToEven>(f64 a);
+template f16 FloppyFloat::F64ToF16<FloppyFloat::kRoundTowardPositive>(f64 a);
+template f16 FloppyFloat::F64ToF16<FloppyFloat::kRoundTowardNegative>(f64 a);
+template f16 FloppyFloat::F64ToF16<FloppyFloat::kRoundTowardZero>(f64 a);
+template f16 FloppyFloat::F64ToF16<FloppyFloat::kRoundTiesToAway>(f64 a);
+
+template f16 FloppyFloat::F64ToF16<FloppyFloat::kRoundTiesToEven, true>(f64 a);
+template f16 FloppyFloat::F64ToF16<FloppyFloat::kRoundTowardPositive, true>(f64 a);
+template f16 FloppyFloat::F64ToF16<FloppyFloat::kRoundTowardNegative, true>(f64 a);
+template f16 FloppyFloat::F64ToF16<FloppyFloat::kRoundTowardZero, true>(f64 a);
+template f16 FloppyFloat::F64ToF16<FloppyFloat::kRoundTiesToAway, true>(f64 a);
+
+f32 FloppyFloat::F64ToF32(f64 a) {
+  if (ChecksDenormals<f64>()) {
+    return FlushDenormals<f32>(
+        [this](f64 x) {
+          f32 result;
+          FLOPPY_FLOAT_FUNC_1(result, rounding_mode, F64ToF32, x)
+          return result;
+        },
+        [](f64) { return false; }, a);
+  }
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return F64ToF32<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return F64ToF32<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return F64ToF32<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return F64ToF32<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return F64ToF32<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <FloppyFloat::RoundingMode rm, bool quiet>
+f32 FloppyFloat::F64ToF32(f64 a) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  return FToF<f64, f32, rm>(a);
+}
+
+template f32 FloppyFloat::F64ToF32<FloppyFloat::kRoundTiesToEven>(f64 a);
+template f32 FloppyFloat::F64ToF32<FloppyFloat::kRoundTowardPositive>(f64 a);
+template f32 FloppyFloat::F64ToF32<FloppyFloat::kRoundTowardNegative>(f64 a);
+template f32 FloppyFloat::F64ToF32<FloppyFloat::kRoundTowardZero>(f64 a);
+template f32 FloppyFloat::F64ToF32<FloppyFloat::kRoundTiesToAway>(f64 a);
+
+template f32 FloppyFloat::F64ToF32<FloppyFloat::kRoundTiesToEven, true>(f64 a);
+template f32 FloppyFloat::F64ToF32<FloppyFloat::kRoundTowardPositive, true>(f64 a);
+template f32 FloppyFloat::F64ToF32<FloppyFloat::kRoundTowardNegative, true>(f64 a);
+template f32 FloppyFloat::F64ToF32<FloppyFloat::kRoundTowardZero, true>(f64 a);
+template f32 FloppyFloat::F64ToF32<FloppyFloat::kRoundTiesToAway, true>(f64 a);
+
+f128 FloppyFloat::F64ToF128(f64 a) {
+  if (IsNan(a)) [[unlikely]] {
+    if (!GetQuietBit(a))
+      invalid = true;
+    return PropagateNan<f64, f128>(a);
+  }
+
+  return static_cast<f128>(a);
+}
+
+f32 FloppyFloat::F128ToF32(f128 a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return F128ToF32<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return F128ToF32<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return F128ToF32<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return F128ToF32<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return F128ToF32<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <FloppyFloat::RoundingMode rm>
+f32 FloppyFloat::F128ToF32(f128 a) {
+  return FToF<f128, f32, rm>(a);
+}
+
+template f32 FloppyFloat::F128ToF32<FloppyFloat::kRoundTiesToEven>(f128 a);
+template f32 FloppyFloat::F128ToF32<FloppyFloat::kRoundTowardPositive>(f128 a);
+template f32 FloppyFloat::F128ToF32<FloppyFloat::kRoundTowardNegative>(f128 a);
+template f32 FloppyFloat::F128ToF32<FloppyFloat::kRoundTowardZero>(f128 a);
+template f32 FloppyFloat::F128ToF32<FloppyFloat::kRoundTiesToAway>(f128 a);
+
+f64 FloppyFloat::F128ToF64(f128 a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return F128ToF64<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return F128ToF64<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return F128ToF64<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return F128ToF64<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return F128ToF64<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <FloppyFloat::RoundingMode rm>
+f64 FloppyFloat::F128ToF64(f128 a) {
+  return FToF<f128, f64, rm>(a);
+}
+
+template f64 FloppyFloat::F128ToF64<FloppyFloat::kRoundTiesToEven>(f128 a);
+template f64 FloppyFloat::F128ToF64<FloppyFloat::kRoundTowardPositive>(f128 a);
+template f64 FloppyFloat::F128ToF64<FloppyFloat::kRoundTowardNegative>(f128 a);
+template f64 FloppyFloat::F128ToF64<FloppyFloat::kRoundTowardZero>(f128 a);
+template f64 FloppyFloat::F128ToF64<FloppyFloat::kRoundTiesToAway>(f128 a);
+
+// Finite values whose rounded magnitude fits into IT are rounded as integers. Everything else is left to SoftFloat.
+template <typename IT, FloppyFloat::RoundingMode rm>
+IT FloppyFloat::F128ToInt(f128 a) {
+  using UT = std::make_unsigned_t<IT>;
+  const auto soft_float = [this](f128 x) {
+    if constexpr (std::is_same_v<IT, i32>)
+      return SoftFloat::F128ToI32<rm>(x);
+    else if constexpr (std::is_same_v<IT, i64>)
+      return SoftFloat::F128ToI64<rm>(x);
+    else if constexpr (std::is_same_v<IT, u32>)
+      return SoftFloat::F128ToU32<rm>(x);
+    else
+      return SoftFloat::F128ToU64<rm>(x);
+  };
+  const u128 ua = std::bit_cast<u128>(a);
+  const i32 exp = GetExponent(a);
+  if (exp >= Bias<f128>() + NumBits<IT>()) [[unlikely]]
+    return soft_float(a);
+
+  const bool sign = ua >> (NumBits<f128>() - 1);
+  const u128 mant = exp ? ImplicitSignificandF128(ua) : GetSignificand(a);
+  // Shifting by more than the width of the significand just keeps the sticky bit, so shifts are capped at 127.
+  const i32 shift = std::min(Bias<f128>() + NumSignificandBits<f128>() - std::max(exp, 1), NumBits<u128>() - 1);
+  const u128 magnitude = RshiftRound<rm>(sign, mant, shift);
+  const u128 limit = std::is_signed_v<IT> ? (static_cast<u128>(1) << (NumBits<IT>() - 1)) - !sign
+                                          : (sign ? 0 : static_cast<u128>(std::numeric_limits<UT>::max()));
+  if (magnitude > limit) [[unlikely]]
+    return soft_float(a);
+
+  if (mant & ((static_cast<u128>(1) << shift) - 1))
+    inexact = true;
+  const UT result = static_cast<UT>(magnitude);
+  return static_cast<IT>(sign ? -result : result);
+}
+
+i32 FloppyFloat::F128ToI32(f128 a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return F128ToI32<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return F128ToI32<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return F128ToI32<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return F128ToI32<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return F128ToI32<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <FloppyFloat::RoundingMode rm>
+i32 FloppyFloat::F128ToI32(f128 a) {
+  return F128ToInt<i32, rm>(a);
+}
+
+template i32 FloppyFloat::F128ToI32<FloppyFloat::kRoundTiesToEven>(f128 a);
+template i32 FloppyFloat::F128ToI32<FloppyFloat::kRoundTowardPositive>(f128 a);
+template i32 FloppyFloat::F128ToI32<FloppyFloat::kRoundTowardNegative>(f128 a);
+template i32 FloppyFloat::F128ToI32<FloppyFloat::kRoundTowardZero>(f128 a);
+template i32 FloppyFloat::F128ToI32<FloppyFloat::kRoundTiesToAway>(f128 a);
+
+i64 FloppyFloat::F128ToI64(f128 a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return F128ToI64<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return F128ToI64<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return F128ToI64<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return F128ToI64<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return F128ToI64<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <FloppyFloat::RoundingMode rm>
+i64 FloppyFloat::F128ToI64(f128 a) {
+  return F128ToInt<i64, rm>(a);
+}
+
+template i64 FloppyFloat::F128ToI64<FloppyFloat::kRoundTiesToEven>(f128 a);
+template i64 FloppyFloat::F128ToI64<FloppyFloat::kRoundTowardPositive>(f128 a);
+template i64 FloppyFloat::F128ToI64<FloppyFloat::kRoundTowardNegative>(f128 a);
+template i64 FloppyFloat::F128ToI64<FloppyFloat::kRoundTowardZero>(f128 a);
+template i64 FloppyFloat::F128ToI64<FloppyFloat::kRoundTiesToAway>(f128 a);
+
+u32 FloppyFloat::F128ToU32(f128 a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return F128ToU32<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return F128ToU32<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return F128ToU32<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return F128ToU32<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return F128ToU32<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <FloppyFloat::RoundingMode rm>
+u32 FloppyFloat::F128ToU32(f128 a) {
+  return F128ToInt<u32, rm>(a);
+}
+
+template u32 FloppyFloat::F128ToU32<FloppyFloat::kRoundTiesToEven>(f128 a);
+template u32 FloppyFloat::F128ToU32<FloppyFloat::kRoundTowardPositive>(f128 a);
+template u32 FloppyFloat::F128ToU32<FloppyFloat::kRoundTowardNegative>(f128 a);
+template u32 FloppyFloat::F128ToU32<FloppyFloat::kRoundTowardZero>(f128 a);
+template u32 FloppyFloat::F128ToU32<FloppyFloat::kRoundTiesToAway>(f128 a);
+
+u64 FloppyFloat::F128ToU64(f128 a) {
   switch (rounding_mode) {
   case kRoundTiesToEven:
-    return F64ToI32<kRoundTiesToEven>(a);
+    return F128ToU64<kRoundTiesToEven>(a);
   case kRoundTiesToAway:
-    return F64ToI32<kRoundTiesToAway>(a);
+    return F128ToU64<kRoundTiesToAway>(a);
   case kRoundTowardPositive:
-    return F64ToI32<kRoundTowardPositive>(a);
+    return F128ToU64<kRoundTowardPositive>(a);
   case kRoundTowardNegative:
-    return F64ToI32<kRoundTowardNegative>(a);
+    return F128ToU64<kRoundTowardNegative>(a);
   case kRoundTowardZero:
-    return F64ToI32<kRoundTowardZero>(a);
+    return F128ToU64<kRoundTowardZero>(a);
   default:
     throw std::runtime_error(std::string("Unknown rounding mode"));
   }
 }
 
 template <FloppyFloat::RoundingMode rm>
-f16 FloppyFloat::F64ToF16(f64 a) {
-  RmGuard(this, rm);
-  return SoftFloat::F64ToF16(a);
+u64 FloppyFloat::F128ToU64(f128 a) {
+  return F128ToInt<u64, rm>(a);
 }
 
-template f16 FloppyFloat::F64ToF16<FloppyFloat::kRoundTiesToEven>(f64 a);
-template f16 FloppyFloat::F64ToF16<FloppyFloat::kRoundTowardPositive>(f64 a);
-template f16 FloppyFloat::F64ToF16<FloppyFloat::kRoundTowardNegative>(f64 a);
-template f16 FloppyFloat::F64ToF16<FloppyFloat::kRoundTowardZero>(f64 a);
-template f16 FloppyFloat::F64ToF16<FloppyFloat::kRoundTiesToAway>(f64 a);
+template u64 FloppyFloat::F128ToU64<FloppyFloat::kRoundTiesToEven>(f128 a);
+template u64 FloppyFloat::F128ToU64<FloppyFloat::kRoundTowardPositive>(f128 a);
+template u64 FloppyFloat::F128ToU64<FloppyFloat::kRoundTowardNegative>(f128 a);
+template u64 FloppyFloat::F128ToU64<FloppyFloat::kRoundTowardZero>(f128 a);
+template u64 FloppyFloat::F128ToU64<FloppyFloat::kRoundTiesToAway>(f128 a);
+
+// Integers of up to 64 bits are exact in f128, so the result is just the packed integer.
+template <typename IT>
+constexpr f128 IntToF128(IT a) {
+  using UT = std::make_unsigned_t<IT>;
+  bool sign = false;
+  if constexpr (std::is_signed_v<IT>)
+    sign = a < 0;
+  const UT magnitude = sign ? -static_cast<UT>(a) : static_cast<UT>(a);
+  u128 result = static_cast<u128>(sign) << (NumBits<f128>() - 1);
+  if (magnitude) {
+    const i32 msb = NumBits<UT>() - 1 - std::countl_zero(magnitude);
+    // The hidden bit carries into the exponent field, hence the - 1.
+    result += static_cast<u128>(Bias<f128>() + msb - 1) << NumSignificandBits<f128>();
+    result += static_cast<u128>(magnitude) << (NumSignificandBits<f128>() - msb);
+  }
+  return std::bit_cast<f128>(result);
+}
+
+f128 FloppyFloat::I32ToF128(i32 a) {
+  return IntToF128(a);
+}
 
 template <FloppyFloat::RoundingMode rm>
-f32 FloppyFloat::F64ToF32(f64 a) {
-  RmGuard(this, rm);
-  return SoftFloat::F64ToF32(a);
+f128 FloppyFloat::I32ToF128(i32 a) {
+  return IntToF128(a);
 }
 
-template f32 FloppyFloat::F64ToF32<FloppyFloat::kRoundTiesToEven>(f64 a);
-template f32 FloppyFloat::F64ToF32<FloppyFloat::kRoundTowardPositive>(f64 a);
-template f32 FloppyFloat::F64ToF32<FloppyFloat::kRoundTowardNegative>(f64 a);
-template f32 FloppyFloat::F64ToF32<FloppyFloat::kRoundTowardZero>(f64 a);
-template f32 FloppyFloat::F64ToF32<FloppyFloat::kRoundTiesToAway>(f64 a);
+template f128 FloppyFloat::I32ToF128<FloppyFloat::kRoundTiesToEven>(i32 a);
+template f128 FloppyFloat::I32ToF128<FloppyFloat::kRoundTowardPositive>(i32 a);
+template f128 FloppyFloat::I32ToF128<FloppyFloat::kRoundTowardNegative>(i32 a);
+template f128 FloppyFloat::I32ToF128<FloppyFloat::kRoundTowardZero>(i32 a);
+template f128 FloppyFloat::I32ToF128<FloppyFloat::kRoundTiesToAway>(i32 a);
+
+f128 FloppyFloat::U32ToF128(u32 a) {
+  return IntToF128(a);
+}
+
+template <FloppyFloat::RoundingMode rm>
+f128 FloppyFloat::U32ToF128(u32 a) {
+  return IntToF128(a);
+}
+
+template f128 FloppyFloat::U32ToF128<FloppyFloat::kRoundTiesToEven>(u32 a);
+template f128 FloppyFloat::U32ToF128<FloppyFloat::kRoundTowardPositive>(u32 a);
+template f128 FloppyFloat::U32ToF128<FloppyFloat::kRoundTowardNegative>(u32 a);
+template f128 FloppyFloat::U32ToF128<FloppyFloat::kRoundTowardZero>(u32 a);
+template f128 FloppyFloat::U32ToF128<FloppyFloat::kRoundTiesToAway>(u32 a);
+
+f128 FloppyFloat::I64ToF128(i64 a) {
+  return IntToF128(a);
+}
+
+template <FloppyFloat::RoundingMode rm>
+f128 FloppyFloat::I64ToF128(i64 a) {
+  return IntToF128(a);
+}
+
+template f128 FloppyFloat::I64ToF128<FloppyFloat::kRoundTiesToEven>(i64 a);
+template f128 FloppyFloat::I64ToF128<FloppyFloat::kRoundTowardPositive>(i64 a);
+template f128 FloppyFloat::I64ToF128<FloppyFloat::kRoundTowardNegative>(i64 a);
+template f128 FloppyFloat::I64ToF128<FloppyFloat::kRoundTowardZero>(i64 a);
+template f128 FloppyFloat::I64ToF128<FloppyFloat::kRoundTiesToAway>(i64 a);
+
+f128 FloppyFloat::U64ToF128(u64 a) {
+  return IntToF128(a);
+}
 
 template <FloppyFloat::RoundingMode rm>
+f128 FloppyFloat::U64ToF128(u64 a) {
+  return IntToF128(a);
+}
+
+template f128 FloppyFloat::U64ToF128<FloppyFloat::kRoundTiesToEven>(u64 a);
+template f128 FloppyFloat::U64ToF128<FloppyFloat::kRoundTowardPositive>(u64 a);
+template f128 FloppyFloat::U64ToF128<FloppyFloat::kRoundTowardNegative>(u64 a);
+template f128 FloppyFloat::U64ToF128<FloppyFloat::kRoundTowardZero>(u64 a);
+template f128 FloppyFloat::U64ToF128<FloppyFloat::kRoundTiesToAway>(u64 a);
+
+template <FloppyFloat::RoundingMode rm, bool quiet>
 i32 FloppyFloat::F64ToI32(f64 a) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
   if (IsNan(a)) [[unlikely]] {
     invalid = true;
     return nan_limit_i32_;
@@ -1595,7 +4979,40 @@ template i32 FloppyFloat::F64ToI32<FloppyFloat::kRoundTowardNegative>(f64 a);
 template i32 FloppyFloat::F64ToI32<FloppyFloat::kRoundTowardZero>(f64 a);
 template i32 FloppyFloat::F64ToI32<FloppyFloat::kRoundTiesToAway>(f64 a);
 
+template i32 FloppyFloat::F64ToI32<FloppyFloat::kRoundTiesToEven, true>(f64 a);
+template i32 FloppyFloat::F64ToI32<FloppyFloat::kRoundTowardPositive, true>(f64 a);
+template i32 FloppyFloat::F64ToI32<FloppyFloat::kRoundTowardNegative, true>(f64 a);
+template i32 FloppyFloat::F64ToI32<FloppyFloat::kRoundTowardZero, true>(f64 a);
+template i32 FloppyFloat::F64ToI32<FloppyFloat::kRoundTiesToAway, true>(f64 a);
+
+i32 FloppyFloat::F64ToI32Modular(f64 a) {
+  if (a > -2147483649. && a < 2147483648.) [[likely]] {  // The truncated result fits, use the FPU.
+    const i32 ia = static_cast<i32>(a);
+    if (static_cast<f64>(ia) != a)
+      inexact = true;
+    return ia;
+  }
+
+  invalid = true;
+  if (IsNan(a) || IsInf(a)) [[unlikely]]
+    return 0;
+
+  // |a| >= 2^31, so that a = mant * 2^exp with exp > -22.
+  const u64 ua = std::bit_cast<u64>(a);
+  const i32 exp = static_cast<i32>((ua >> 52) & 0x7ff) - 1075;
+  const u64 mant = (ua & 0xfffffffffffffull) | (1ull << 52);
+  u32 result = 0;
+  if (exp < 0)
+    result = static_cast<u32>(mant >> -exp);
+  else if (exp < 32)
+    result = static_cast<u32>(mant << exp);
+  if (ua >> 63)
+    result = -result;
+  return static_cast<i32>(result);
+}
+
 i64 FloppyFloat::F64ToI64(f64 a) {
+  FlushInputs<false>(a);
   switch (rounding_mode) {
   case kRoundTiesToEven:
     return F64ToI64<kRoundTiesToEven>(a);
@@ -1612,8 +5029,9 @@ i64 FloppyFloat::F64ToI64(f64 a) {
   }
 }
 
-template <FloppyFloat::RoundingMode rm>
+template <FloppyFloat::RoundingMode rm, bool quiet>
 i64 FloppyFloat::F64ToI64(f64 a) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
   if (IsNan(a)) [[unlikely]] {
     invalid = true;
     return nan_limit_i64_;
@@ -1655,6 +5073,12 @@ template i64 FloppyFloat::F64ToI64<FloppyFloat::kRoundTowardNegative>(f64 a);
 template i64 FloppyFloat::F64ToI64<FloppyFloat::kRoundTowardZero>(f64 a);
 template i64 FloppyFloat::F64ToI64<FloppyFloat::kRoundTiesToAway>(f64 a);
 
+template i64 FloppyFloat::F64ToI64<FloppyFloat::kRoundTiesToEven, true>(f64 a);
+template i64 FloppyFloat::F64ToI64<FloppyFloat::kRoundTowardPositive, true>(f64 a);
+template i64 FloppyFloat::F64ToI64<FloppyFloat::kRoundTowardNegative, true>(f64 a);
+template i64 FloppyFloat::F64ToI64<FloppyFloat::kRoundTowardZero, true>(f64 a);
+template i64 FloppyFloat::F64ToI64<FloppyFloat::kRoundTiesToAway, true>(f64 a);
+
 template <FloppyFloat::RoundingMode rm>
 constexpr f64 F64ToU32NegLimit() {
   if constexpr (rm == FloppyFloat::kRoundTiesToEven) {
@@ -1686,6 +5110,7 @@ constexpr f64 F64ToU32PosLimit() {
 }
 
 u32 FloppyFloat::F64ToU32(f64 a) {
+  FlushInputs<false>(a);
   switch (rounding_mode) {
   case kRoundTiesToEven:
     return F64ToU32<kRoundTiesToEven>(a);
@@ -1702,8 +5127,9 @@ u32 FloppyFloat::F64ToU32(f64 a) {
   }
 }
 
-template <FloppyFloat::RoundingMode rm>
+template <FloppyFloat::RoundingMode rm, bool quiet>
 u32 FloppyFloat::F64ToU32(f64 a) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
   if (IsNan(a)) [[unlikely]] {
     invalid = true;
     return nan_limit_u32_;
@@ -1738,6 +5164,12 @@ template u32 FloppyFloat::F64ToU32<FloppyFloat::kRoundTowardNegative>(f64 a);
 template u32 FloppyFloat::F64ToU32<FloppyFloat::kRoundTowardZero>(f64 a);
 template u32 FloppyFloat::F64ToU32<FloppyFloat::kRoundTiesToAway>(f64 a);
 
+template u32 FloppyFloat::F64ToU32<FloppyFloat::kRoundTiesToEven, true>(f64 a);
+template u32 FloppyFloat::F64ToU32<FloppyFloat::kRoundTowardPositive, true>(f64 a);
+template u32 FloppyFloat::F64ToU32<FloppyFloat::kRoundTowardNegative, true>(f64 a);
+template u32 FloppyFloat::F64ToU32<FloppyFloat::kRoundTowardZero, true>(f64 a);
+template u32 FloppyFloat::F64ToU32<FloppyFloat::kRoundTiesToAway, true>(f64 a);
+
 template <FloppyFloat::RoundingMode rm>
 constexpr f64 F64ToU64PosLimit() {
   if constexpr (rm == FloppyFloat::kRoundTiesToEven) {
@@ -1753,321 +5185,951 @@ constexpr f64 F64ToU64PosLimit() {
   }
 }
 
-u64 FloppyFloat::F64ToU64(f64 a) {
+u64 FloppyFloat::F64ToU64(f64 a) {
+  FlushInputs<false>(a);
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return F64ToU64<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return F64ToU64<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return F64ToU64<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return F64ToU64<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return F64ToU64<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <FloppyFloat::RoundingMode rm, bool quiet>
+u64 FloppyFloat::F64ToU64(f64 a) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  if (IsNan(a)) [[unlikely]] {
+    invalid = true;
+    return nan_limit_u64_;
+  } else if (a >= 18446744073709551616.f64) [[unlikely]] {
+    invalid = true;
+    return max_limit_u64_;
+  } else if (a < 0.f64) [[unlikely]] {
+    if (a < F64ToU32NegLimit<rm>()) {
+      invalid = true;
+      return min_limit_u64_;
+    }
+    inexact = true;
+    return std::numeric_limits<u64>::min();
+  }
+
+  u64 ia;
+  ia = static_cast<u64>(a);  // C++ always truncates (i.e., rounds to zero).
+
+  f64 r = static_cast<f64>(ia) - a;
+  if (!IsZero(r))
+    inexact = true;
+
+  return RoundIntegerResult<f64, u64, rm>(r, a, ia);
+}
+
+template u64 FloppyFloat::F64ToU64<FloppyFloat::kRoundTiesToEven>(f64 a);
+template u64 FloppyFloat::F64ToU64<FloppyFloat::kRoundTowardPositive>(f64 a);
+template u64 FloppyFloat::F64ToU64<FloppyFloat::kRoundTowardNegative>(f64 a);
+template u64 FloppyFloat::F64ToU64<FloppyFloat::kRoundTowardZero>(f64 a);
+template u64 FloppyFloat::F64ToU64<FloppyFloat::kRoundTiesToAway>(f64 a);
+
+template u64 FloppyFloat::F64ToU64<FloppyFloat::kRoundTiesToEven, true>(f64 a);
+template u64 FloppyFloat::F64ToU64<FloppyFloat::kRoundTowardPositive, true>(f64 a);
+template u64 FloppyFloat::F64ToU64<FloppyFloat::kRoundTowardNegative, true>(f64 a);
+template u64 FloppyFloat::F64ToU64<FloppyFloat::kRoundTowardZero, true>(f64 a);
+template u64 FloppyFloat::F64ToU64<FloppyFloat::kRoundTiesToAway, true>(f64 a);
+
+// Assumes that "result" was calculated with "kRoundTiesToEven" from an integer with the magnitude "ua".
+template <typename FT, typename UT, FloppyFloat::RoundingMode rm>
+constexpr FT FloppyFloat::RoundIToFResult(bool sign, UT ua, FT result) {
+  constexpr UT significand_last_bit = static_cast<UT>(1) << (NumBits<UT>() - NumSignificandBits<FT>() - 1);
+  constexpr UT guard_bit = significand_last_bit >> 1;
+
+  if (ua <= static_cast<UT>(1) << (NumSignificandBits<FT>() + 1))
+    return result;  // Exactly representable.
+
+  UT shifted_ua = ua << std::countl_zero(ua);
+  UT r = shifted_ua & (significand_last_bit - 1);
+  if (r == 0)
+    return result;
+
+  inexact = true;
+  if constexpr (rm == kRoundTiesToEven)
+    return result;
+
+  bool odd = shifted_ua & significand_last_bit;
+  bool rounded_up = (r > guard_bit) || ((r == guard_bit) && odd);  // Magnitude was rounded up.
+  if constexpr (rm == kRoundTowardPositive) {
+    if (sign == rounded_up)
+      result = NextUpNoNegZero(result);
+  } else if constexpr (rm == kRoundTowardNegative) {
+    if (sign != rounded_up)
+      result = NextDownNoPosZero(result);
+  } else if constexpr (rm == kRoundTowardZero) {
+    if (rounded_up)
+      result = sign ? NextUpNoNegZero(result) : NextDownNoPosZero(result);
+  } else if constexpr (rm == kRoundTiesToAway) {
+    if ((r == guard_bit) && !odd)
+      result = sign ? NextDownNoPosZero(result) : NextUpNoNegZero(result);
+  }
+
+  return result;
+}
+
+f16 FloppyFloat::I32ToF16(i32 a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return I32ToF16<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return I32ToF16<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return I32ToF16<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return I32ToF16<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return I32ToF16<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <FloppyFloat::RoundingMode rm, bool quiet>
+f16 FloppyFloat::I32ToF16(i32 a) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  u32 ua = a < 0 ? -static_cast<u32>(a) : static_cast<u32>(a);
+  if (ua >= 65536u) [[unlikely]] {
+    overflow = true;
+    inexact = true;
+    return RoundInf<f16, rm>(a < 0 ? -nl<f16>::infinity() : nl<f16>::infinity());
+  }
+
+  // Integers below 2^16 are exactly representable as f32, so there is only a single rounding step.
+  f16 af = static_cast<f16>(static_cast<f32>(a));
+  af = RoundIToFResult<f16, u32, rm>(a < 0, ua, af);
+  if (IsInf(af)) [[unlikely]]
+    overflow = true;
+
+  return af;
+}
+
+template f16 FloppyFloat::I32ToF16<FloppyFloat::kRoundTiesToEven>(i32 a);
+template f16 FloppyFloat::I32ToF16<FloppyFloat::kRoundTowardPositive>(i32 a);
+template f16 FloppyFloat::I32ToF16<FloppyFloat::kRoundTowardNegative>(i32 a);
+template f16 FloppyFloat::I32ToF16<FloppyFloat::kRoundTowardZero>(i32 a);
+template f16 FloppyFloat::I32ToF16<FloppyFloat::kRoundTiesToAway>(i32 a);
+
+template f16 FloppyFloat::I32ToF16<FloppyFloat::kRoundTiesToEven, true>(i32 a);
+template f16 FloppyFloat::I32ToF16<FloppyFloat::kRoundTowardPositive, true>(i32 a);
+template f16 FloppyFloat::I32ToF16<FloppyFloat::kRoundTowardNegative, true>(i32 a);
+template f16 FloppyFloat::I32ToF16<FloppyFloat::kRoundTowardZero, true>(i32 a);
+template f16 FloppyFloat::I32ToF16<FloppyFloat::kRoundTiesToAway, true>(i32 a);
+
+f32 FloppyFloat::I32ToF32(i32 a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return I32ToF32<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return I32ToF32<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return I32ToF32<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return I32ToF32<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return I32ToF32<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <FloppyFloat::RoundingMode rm, bool quiet>
+f32 FloppyFloat::I32ToF32(i32 a) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  f32 af = static_cast<f32>(a);
+  return RoundIToFResult<f32, u32, rm>(a < 0, a < 0 ? -static_cast<u32>(a) : static_cast<u32>(a), af);
+}
+
+template f32 FloppyFloat::I32ToF32<FloppyFloat::kRoundTiesToEven>(i32 a);
+template f32 FloppyFloat::I32ToF32<FloppyFloat::kRoundTowardPositive>(i32 a);
+template f32 FloppyFloat::I32ToF32<FloppyFloat::kRoundTowardNegative>(i32 a);
+template f32 FloppyFloat::I32ToF32<FloppyFloat::kRoundTowardZero>(i32 a);
+template f32 FloppyFloat::I32ToF32<FloppyFloat::kRoundTiesToAway>(i32 a);
+
+template f32 FloppyFloat::I32ToF32<FloppyFloat::kRoundTiesToEven, true>(i32 a);
+template f32 FloppyFloat::I32ToF32<FloppyFloat::kRoundTowardPositive, true>(i32 a);
+template f32 FloppyFloat::I32ToF32<FloppyFloat::kRoundTowardNegative, true>(i32 a);
+template f32 FloppyFloat::I32ToF32<FloppyFloat::kRoundTowardZero, true>(i32 a);
+template f32 FloppyFloat::I32ToF32<FloppyFloat::kRoundTiesToAway, true>(i32 a);
+
+f64 FloppyFloat::I32ToF64(i32 a) {
+  return static_cast<f64>(a);
+}
+
+f16 FloppyFloat::U32ToF16(u32 a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return U32ToF16<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return U32ToF16<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return U32ToF16<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return U32ToF16<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return U32ToF16<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <FloppyFloat::RoundingMode rm, bool quiet>
+f16 FloppyFloat::U32ToF16(u32 a) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  if (a >= 65536u) [[unlikely]] {
+    overflow = true;
+    inexact = true;
+    return RoundInf<f16, rm>(nl<f16>::infinity());
+  }
+
+  // Integers below 2^16 are exactly representable as f32, so there is only a single rounding step.
+  f16 af = static_cast<f16>(static_cast<f32>(a));
+  af = RoundIToFResult<f16, u32, rm>(false, a, af);
+  if (IsInf(af)) [[unlikely]]
+    overflow = true;
+
+  return af;
+}
+
+template f16 FloppyFloat::U32ToF16<FloppyFloat::kRoundTiesToEven>(u32 a);
+template f16 FloppyFloat::U32ToF16<FloppyFloat::kRoundTowardPositive>(u32 a);
+template f16 FloppyFloat::U32ToF16<FloppyFloat::kRoundTowardNegative>(u32 a);
+template f16 FloppyFloat::U32ToF16<FloppyFloat::kRoundTowardZero>(u32 a);
+template f16 FloppyFloat::U32ToF16<FloppyFloat::kRoundTiesToAway>(u32 a);
+
+template f16 FloppyFloat::U32ToF16<FloppyFloat::kRoundTiesToEven, true>(u32 a);
+template f16 FloppyFloat::U32ToF16<FloppyFloat::kRoundTowardPositive, true>(u32 a);
+template f16 FloppyFloat::U32ToF16<FloppyFloat::kRoundTowardNegative, true>(u32 a);
+template f16 FloppyFloat::U32ToF16<FloppyFloat::kRoundTowardZero, true>(u32 a);
+template f16 FloppyFloat::U32ToF16<FloppyFloat::kRoundTiesToAway, true>(u32 a);
+
+f32 FloppyFloat::U32ToF32(u32 a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return U32ToF32<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return U32ToF32<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return U32ToF32<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return U32ToF32<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return U32ToF32<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <FloppyFloat::RoundingMode rm, bool quiet>
+f32 FloppyFloat::U32ToF32(u32 a) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  f32 af = static_cast<f32>(a);
+  return RoundIToFResult<f32, u32, rm>(false, a, af);
+}
+
+template f32 FloppyFloat::U32ToF32<FloppyFloat::kRoundTiesToEven>(u32 a);
+template f32 FloppyFloat::U32ToF32<FloppyFloat::kRoundTowardPositive>(u32 a);
+template f32 FloppyFloat::U32ToF32<FloppyFloat::kRoundTowardNegative>(u32 a);
+template f32 FloppyFloat::U32ToF32<FloppyFloat::kRoundTowardZero>(u32 a);
+template f32 FloppyFloat::U32ToF32<FloppyFloat::kRoundTiesToAway>(u32 a);
+
+template f32 FloppyFloat::U32ToF32<FloppyFloat::kRoundTiesToEven, true>(u32 a);
+template f32 FloppyFloat::U32ToF32<FloppyFloat::kRoundTowardPositive, true>(u32 a);
+template f32 FloppyFloat::U32ToF32<FloppyFloat::kRoundTowardNegative, true>(u32 a);
+template f32 FloppyFloat::U32ToF32<FloppyFloat::kRoundTowardZero, true>(u32 a);
+template f32 FloppyFloat::U32ToF32<FloppyFloat::kRoundTiesToAway, true>(u32 a);
+
+f16 FloppyFloat::I64ToF16(i64 a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return I64ToF16<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return I64ToF16<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return I64ToF16<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return I64ToF16<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return I64ToF16<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <FloppyFloat::RoundingMode rm, bool quiet>
+f16 FloppyFloat::I64ToF16(i64 a) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  u64 ua = a < 0 ? -static_cast<u64>(a) : static_cast<u64>(a);
+  if (ua >= 65536u) [[unlikely]] {
+    overflow = true;
+    inexact = true;
+    return RoundInf<f16, rm>(a < 0 ? -nl<f16>::infinity() : nl<f16>::infinity());
+  }
+
+  // Integers below 2^16 are exactly representable as f32, so there is only a single rounding step.
+  f16 af = static_cast<f16>(static_cast<f32>(a));
+  af = RoundIToFResult<f16, u32, rm>(a < 0, static_cast<u32>(ua), af);
+  if (IsInf(af)) [[unlikely]]
+    overflow = true;
+
+  return af;
+}
+
+template f16 FloppyFloat::I64ToF16<FloppyFloat::kRoundTiesToEven>(i64 a);
+template f16 FloppyFloat::I64ToF16<FloppyFloat::kRoundTowardPositive>(i64 a);
+template f16 FloppyFloat::I64ToF16<FloppyFloat::kRoundTowardNegative>(i64 a);
+template f16 FloppyFloat::I64ToF16<FloppyFloat::kRoundTowardZero>(i64 a);
+template f16 FloppyFloat::I64ToF16<FloppyFloat::kRoundTiesToAway>(i64 a);
+
+template f16 FloppyFloat::I64ToF16<FloppyFloat::kRoundTiesToEven, true>(i64 a);
+template f16 FloppyFloat::I64ToF16<FloppyFloat::kRoundTowardPositive, true>(i64 a);
+template f16 FloppyFloat::I64ToF16<FloppyFloat::kRoundTowardNegative, true>(i64 a);
+template f16 FloppyFloat::I64ToF16<FloppyFloat::kRoundTowardZero, true>(i64 a);
+template f16 FloppyFloat::I64ToF16<FloppyFloat::kRoundTiesToAway, true>(i64 a);
+
+f32 FloppyFloat::I64ToF32(i64 a) {
   switch (rounding_mode) {
   case kRoundTiesToEven:
-    return F64ToU64<kRoundTiesToEven>(a);
+    return I64ToF32<kRoundTiesToEven>(a);
   case kRoundTiesToAway:
-    return F64ToU64<kRoundTiesToAway>(a);
+    return I64ToF32<kRoundTiesToAway>(a);
   case kRoundTowardPositive:
-    return F64ToU64<kRoundTowardPositive>(a);
+    return I64ToF32<kRoundTowardPositive>(a);
   case kRoundTowardNegative:
-    return F64ToU64<kRoundTowardNegative>(a);
+    return I64ToF32<kRoundTowardNegative>(a);
   case kRoundTowardZero:
-    return F64ToU64<kRoundTowardZero>(a);
+    return I64ToF32<kRoundTowardZero>(a);
   default:
     throw std::runtime_error(std::string("Unknown rounding mode"));
   }
 }
 
-template <FloppyFloat::RoundingMode rm>
-u64 FloppyFloat::F64ToU64(f64 a) {
-  if (IsNan(a)) [[unlikely]] {
-    invalid = true;
-    return nan_limit_u64_;
-  } else if (a > 18446744073709551616.f64) [[unlikely]] {
-    invalid = true;
-    return max_limit_u64_;
-  } else if (a < 0.f64) [[unlikely]] {
-    if (a < F64ToU32NegLimit<rm>()) {
-      invalid = true;
-      return min_limit_u64_;
-    }
-    inexact = true;
-    return std::numeric_limits<u64>::min();
-  }
+template <FloppyFloat::RoundingMode rm, bool quiet>
+f32 FloppyFloat::I64ToF32(i64 a) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  f32 af = static_cast<f32>(a);
+  return RoundIToFResult<f32, u64, rm>(a < 0, a < 0 ? -static_cast<u64>(a) : static_cast<u64>(a), af);
+}
 
-  u64 ia;
-  ia = static_cast<u64>(a);  // C++ always truncates (i.e., rounds to zero).
+template f32 FloppyFloat::I64ToF32<FloppyFloat::kRoundTiesToEven>(i64 a);
+template f32 FloppyFloat::I64ToF32<FloppyFloat::kRoundTowardPositive>(i64 a);
+template f32 FloppyFloat::I64ToF32<FloppyFloat::kRoundTowardNegative>(i64 a);
+template f32 FloppyFloat::I64ToF32<FloppyFloat::kRoundTowardZero>(i64 a);
+template f32 FloppyFloat::I64ToF32<FloppyFloat::kRoundTiesToAway>(i64 a);
 
-  f64 r = static_cast<f64>(ia) - a;
-  if (!IsZero(r))
-    inexact = true;
+template f32 FloppyFloat::I64ToF32<FloppyFloat::kRoundTiesToEven, true>(i64 a);
+template f32 FloppyFloat::I64ToF32<FloppyFloat::kRoundTowardPositive, true>(i64 a);
+template f32 FloppyFloat::I64ToF32<FloppyFloat::kRoundTowardNegative, true>(i64 a);
+template f32 FloppyFloat::I64ToF32<FloppyFloat::kRoundTowardZero, true>(i64 a);
+template f32 FloppyFloat::I64ToF32<FloppyFloat::kRoundTiesToAway, true>(i64 a);
 
-  return RoundIntegerResult<f64, u64, rm>(r, a, ia);
+f64 FloppyFloat::I64ToF64(i64 a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return I64ToF64<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return I64ToF64<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return I64ToF64<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return I64ToF64<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return I64ToF64<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
 }
 
-template u64 FloppyFloat::F64ToU64<FloppyFloat::kRoundTiesToEven>(f64 a);
-template u64 FloppyFloat::F64ToU64<FloppyFloat::kRoundTowardPositive>(f64 a);
-template u64 FloppyFloat::F64ToU64<FloppyFloat::kRoundTowardNegative>(f64 a);
-template u64 FloppyFloat::F64ToU64<FloppyFloat::kRoundTowardZero>(f64 a);
-template u64 FloppyFloat::F64ToU64<FloppyFloat::kRoundTiesToAway>(f64 a);
+template <FloppyFloat::RoundingMode rm, bool quiet>
+f64 FloppyFloat::I64ToF64(i64 a) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  f64 af = static_cast<f64>(a);
+  return RoundIToFResult<f64, u64, rm>(a < 0, a < 0 ? -static_cast<u64>(a) : static_cast<u64>(a), af);
+}
 
-f16 FloppyFloat::I32ToF16(i32 a) {
+template f64 FloppyFloat::I64ToF64<FloppyFloat::kRoundTiesToEven>(i64 a);
+template f64 FloppyFloat::I64ToF64<FloppyFloat::kRoundTowardPositive>(i64 a);
+template f64 FloppyFloat::I64ToF64<FloppyFloat::kRoundTowardNegative>(i64 a);
+template f64 FloppyFloat::I64ToF64<FloppyFloat::kRoundTowardZero>(i64 a);
+template f64 FloppyFloat::I64ToF64<FloppyFloat::kRoundTiesToAway>(i64 a);
+
+template f64 FloppyFloat::I64ToF64<FloppyFloat::kRoundTiesToEven, true>(i64 a);
+template f64 FloppyFloat::I64ToF64<FloppyFloat::kRoundTowardPositive, true>(i64 a);
+template f64 FloppyFloat::I64ToF64<FloppyFloat::kRoundTowardNegative, true>(i64 a);
+template f64 FloppyFloat::I64ToF64<FloppyFloat::kRoundTowardZero, true>(i64 a);
+template f64 FloppyFloat::I64ToF64<FloppyFloat::kRoundTiesToAway, true>(i64 a);
+
+f16 FloppyFloat::U64ToF16(u64 a) {
   switch (rounding_mode) {
   case kRoundTiesToEven:
-    return I32ToF16<kRoundTiesToEven>(a);
+    return U64ToF16<kRoundTiesToEven>(a);
   case kRoundTiesToAway:
-    return I32ToF16<kRoundTiesToAway>(a);
+    return U64ToF16<kRoundTiesToAway>(a);
   case kRoundTowardPositive:
-    return I32ToF16<kRoundTowardPositive>(a);
+    return U64ToF16<kRoundTowardPositive>(a);
   case kRoundTowardNegative:
-    return I32ToF16<kRoundTowardNegative>(a);
+    return U64ToF16<kRoundTowardNegative>(a);
   case kRoundTowardZero:
-    return I32ToF16<kRoundTowardZero>(a);
+    return U64ToF16<kRoundTowardZero>(a);
   default:
     throw std::runtime_error(std::string("Unknown rounding mode"));
   }
 }
 
-template <FloppyFloat::RoundingMode rm>
-f16 FloppyFloat::I32ToF16(i32 a) {
-  f16 af = static_cast<f16>(a);
-  u32 ua = std::abs(a);
-  u32 shifted_ua = ua << std::countl_zero(ua);
-  u32 r = shifted_ua & 0x1fffffu;
-
-  if (IsInf(af)) [[unlikely]] {
+template <FloppyFloat::RoundingMode rm, bool quiet>
+f16 FloppyFloat::U64ToF16(u64 a) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  if (a >= 65536u) [[unlikely]] {
     overflow = true;
     inexact = true;
-    return RoundInf<f16, rm>(af);
+    return RoundInf<f16, rm>(nl<f16>::infinity());
   }
 
-  if (r != 0) {
-    inexact = true;
-    [[maybe_unused]] bool even;
-    if constexpr (rm != kRoundTiesToEven)
-      even = shifted_ua & 0x100u;
-    if constexpr (rm == kRoundTowardPositive) {
-      if (a > 0) {
-        if ((r < 1048576) || ((r == 1048576) && !even))
-          af = NextUpNoNegZero(af);
-      } else {
-        if ((r > 1048576) || ((r == 1048576) && even))
-          af = NextUpNoNegZero(af);
-      }
-    } else if constexpr (rm == kRoundTowardNegative) {
-      if (a > 0) {
-        if ((r > 1048576) || ((r == 1048576) && even))
-          af = NextDownNoPosZero(af);
-      } else {
-        if ((r < 1048576) || ((r == 1048576) && !even))
-          af = NextDownNoPosZero(af);
-      }
-    } else if constexpr (rm == kRoundTowardZero) {
-      if ((r > 1048576) || ((r == 1048576) && even)) {
-        if (a > 0) {
-          af = NextDownNoPosZero(af);
-        } else {
-          af = NextUpNoNegZero(af);
-        }
-      }
-    } else if constexpr (rm == kRoundTiesToAway) {
-      if ((a > 0) && (r == 1048576) && !even)
-        af = NextUpNoNegZero(af);
-      if ((a < 0) && (r == 1048576) && even)
-        af = NextDownNoPosZero(af);
-    }
-  }
+  // Integers below 2^16 are exactly representable as f32, so there is only a single rounding step.
+  f16 af = static_cast<f16>(static_cast<f32>(a));
+  af = RoundIToFResult<f16, u32, rm>(false, static_cast<u32>(a), af);
+  if (IsInf(af)) [[unlikely]]
+    overflow = true;
 
   return af;
 }
 
-template f16 FloppyFloat::I32ToF16<FloppyFloat::kRoundTiesToEven>(i32 a);
-template f16 FloppyFloat::I32ToF16<FloppyFloat::kRoundTowardPositive>(i32 a);
-template f16 FloppyFloat::I32ToF16<FloppyFloat::kRoundTowardNegative>(i32 a);
-template f16 FloppyFloat::I32ToF16<FloppyFloat::kRoundTowardZero>(i32 a);
-template f16 FloppyFloat::I32ToF16<FloppyFloat::kRoundTiesToAway>(i32 a);
+template f16 FloppyFloat::U64ToF16<FloppyFloat::kRoundTiesToEven>(u64 a);
+template f16 FloppyFloat::U64ToF16<FloppyFloat::kRoundTowardPositive>(u64 a);
+template f16 FloppyFloat::U64ToF16<FloppyFloat::kRoundTowardNegative>(u64 a);
+template f16 FloppyFloat::U64ToF16<FloppyFloat::kRoundTowardZero>(u64 a);
+template f16 FloppyFloat::U64ToF16<FloppyFloat::kRoundTiesToAway>(u64 a);
 
-f32 FloppyFloat::I32ToF32(i32 a) {
+template f16 FloppyFloat::U64ToF16<FloppyFloat::kRoundTiesToEven, true>(u64 a);
+template f16 FloppyFloat::U64ToF16<FloppyFloat::kRoundTowardPositive, true>(u64 a);
+template f16 FloppyFloat::U64ToF16<FloppyFloat::kRoundTowardNegative, true>(u64 a);
+template f16 FloppyFloat::U64ToF16<FloppyFloat::kRoundTowardZero, true>(u64 a);
+template f16 FloppyFloat::U64ToF16<FloppyFloat::kRoundTiesToAway, true>(u64 a);
+
+f32 FloppyFloat::U64ToF32(u64 a) {
   switch (rounding_mode) {
   case kRoundTiesToEven:
-    return I32ToF32<kRoundTiesToEven>(a);
+    return U64ToF32<kRoundTiesToEven>(a);
   case kRoundTiesToAway:
-    return I32ToF32<kRoundTiesToAway>(a);
+    return U64ToF32<kRoundTiesToAway>(a);
   case kRoundTowardPositive:
-    return I32ToF32<kRoundTowardPositive>(a);
+    return U64ToF32<kRoundTowardPositive>(a);
   case kRoundTowardNegative:
-    return I32ToF32<kRoundTowardNegative>(a);
+    return U64ToF32<kRoundTowardNegative>(a);
   case kRoundTowardZero:
-    return I32ToF32<kRoundTowardZero>(a);
+    return U64ToF32<kRoundTowardZero>(a);
   default:
     throw std::runtime_error(std::string("Unknown rounding mode"));
   }
 }
 
-template <FloppyFloat::RoundingMode rm>
-f32 FloppyFloat::I32ToF32(i32 a) {
+template <FloppyFloat::RoundingMode rm, bool quiet>
+f32 FloppyFloat::U64ToF32(u64 a) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
   f32 af = static_cast<f32>(a);
-  u32 ua = std::abs(a);
-  u32 shifted_ua = ua << std::countl_zero(ua);
-  u32 r = shifted_ua & 0xffu;
+  return RoundIToFResult<f32, u64, rm>(false, a, af);
+}
 
-  if (r != 0) {
-    inexact = true;
-    if constexpr (rm == kRoundTiesToEven) {
-      return af;
-    }
-    bool even = shifted_ua & 0x100u;
-    if constexpr (rm == kRoundTowardPositive) {
-      if (a > 0) {
-        if ((r < 128) || ((r == 128) && !even))
-          af = NextUpNoNegZero(af);
-      } else {
-        if ((r > 128) || ((r == 128) && even))
-          af = NextUpNoNegZero(af);
-      }
-    } else if constexpr (rm == kRoundTowardNegative) {
-      if (a > 0) {
-        if ((r > 128) || ((r == 128) && even))
-          af = NextDownNoPosZero(af);
-      } else {
-        if ((r < 128) || ((r == 128) && !even))
-          af = NextDownNoPosZero(af);
-      }
-    } else if constexpr (rm == kRoundTowardZero) {
-      if ((r > 128) || ((r == 128) && even)) {
-        if (a > 0) {
-          af = NextDownNoPosZero(af);
-        } else {
-          af = NextUpNoNegZero(af);
-        }
-      }
-    } else if constexpr (rm == kRoundTiesToAway) {
-      if ((a > 0) && (r == 128) && !even)
-        af = NextUpNoNegZero(af);
-      if ((a < 0) && (r == 128) && even)
-        af = NextDownNoPosZero(af);
-    }
+template f32 FloppyFloat::U64ToF32<FloppyFloat::kRoundTiesToEven>(u64 a);
+template f32 FloppyFloat::U64ToF32<FloppyFloat::kRoundTowardPositive>(u64 a);
+template f32 FloppyFloat::U64ToF32<FloppyFloat::kRoundTowardNegative>(u64 a);
+template f32 FloppyFloat::U64ToF32<FloppyFloat::kRoundTowardZero>(u64 a);
+template f32 FloppyFloat::U64ToF32<FloppyFloat::kRoundTiesToAway>(u64 a);
+
+template f32 FloppyFloat::U64ToF32<FloppyFloat::kRoundTiesToEven, true>(u64 a);
+template f32 FloppyFloat::U64ToF32<FloppyFloat::kRoundTowardPositive, true>(u64 a);
+template f32 FloppyFloat::U64ToF32<FloppyFloat::kRoundTowardNegative, true>(u64 a);
+template f32 FloppyFloat::U64ToF32<FloppyFloat::kRoundTowardZero, true>(u64 a);
+template f32 FloppyFloat::U64ToF32<FloppyFloat::kRoundTiesToAway, true>(u64 a);
+
+f64 FloppyFloat::U64ToF64(u64 a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return U64ToF64<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return U64ToF64<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return U64ToF64<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return U64ToF64<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return U64ToF64<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
   }
+}
 
-  return af;
+template <FloppyFloat::RoundingMode rm, bool quiet>
+f64 FloppyFloat::U64ToF64(u64 a) {
+  [[maybe_unused]] FlagGuard<quiet> guard(*this);
+  f64 af = static_cast<f64>(a);
+  return RoundIToFResult<f64, u64, rm>(false, a, af);
 }
 
-template f32 FloppyFloat::I32ToF32<FloppyFloat::kRoundTiesToEven>(i32 a);
-template f32 FloppyFloat::I32ToF32<FloppyFloat::kRoundTowardPositive>(i32 a);
-template f32 FloppyFloat::I32ToF32<FloppyFloat::kRoundTowardNegative>(i32 a);
-template f32 FloppyFloat::I32ToF32<FloppyFloat::kRoundTowardZero>(i32 a);
-template f32 FloppyFloat::I32ToF32<FloppyFloat::kRoundTiesToAway>(i32 a);
+template f64 FloppyFloat::U64ToF64<FloppyFloat::kRoundTiesToEven>(u64 a);
+template f64 FloppyFloat::U64ToF64<FloppyFloat::kRoundTowardPositive>(u64 a);
+template f64 FloppyFloat::U64ToF64<FloppyFloat::kRoundTowardNegative>(u64 a);
+template f64 FloppyFloat::U64ToF64<FloppyFloat::kRoundTowardZero>(u64 a);
+template f64 FloppyFloat::U64ToF64<FloppyFloat::kRoundTiesToAway>(u64 a);
 
-f64 FloppyFloat::I32ToF64(i32 a) {
+template f64 FloppyFloat::U64ToF64<FloppyFloat::kRoundTiesToEven, true>(u64 a);
+template f64 FloppyFloat::U64ToF64<FloppyFloat::kRoundTowardPositive, true>(u64 a);
+template f64 FloppyFloat::U64ToF64<FloppyFloat::kRoundTowardNegative, true>(u64 a);
+template f64 FloppyFloat::U64ToF64<FloppyFloat::kRoundTowardZero, true>(u64 a);
+template f64 FloppyFloat::U64ToF64<FloppyFloat::kRoundTiesToAway, true>(u64 a);
+
+f64 FloppyFloat::U32ToF64(u32 a) {
   return static_cast<f64>(a);
 }
 
-f32 FloppyFloat::U32ToF32(u32 a) {
+// 2^exp for exponents within the normal range of FT.
+template <typename FT>
+constexpr FT Pow2(i32 exp) {
+  using UT = typename FloatToUint<FT>::type;
+  return std::bit_cast<FT>(static_cast<UT>(static_cast<UT>(exp + Bias<FT>()) << NumSignificandBits<FT>()));
+}
+
+// The type in which a * 2^fbits is exact for any a of FT and fbits up to 64. f64 may overflow, but then so does IT.
+template <typename FT>
+using FixedScaleType = std::conditional_t<std::is_same_v<FT, f16>, f32, f64>;
+
+// Converts an integer to f64, rounding to odd if it has more than 53 significant bits. Rounding the result to a
+// narrower format is then a single rounding (see RoundToOdd).
+template <typename IT>
+constexpr f64 IToF64RoundToOdd(IT a) {
+  if constexpr (NumBits<IT>() <= 32) {
+    return static_cast<f64>(a);
+  } else {
+    using UT = std::make_unsigned_t<IT>;
+    const bool sign = a < 0;
+    UT ua = sign ? -static_cast<UT>(a) : static_cast<UT>(a);
+    const i32 shift = NumBits<IT>() - std::countl_zero(ua) - 53;
+    if (shift > 0) {
+      const UT mask = (static_cast<UT>(1) << shift) - 1;
+      ua = (ua & ~mask) | (static_cast<UT>((ua & mask) != 0) << shift);
+    }
+    const f64 result = static_cast<f64>(ua);
+    return sign ? -result : result;
+  }
+}
+
+template <typename FT, typename IT, FloppyFloat::RoundingMode rm>
+IT FloppyFloat::FToI(FT a) {
+  static_assert(std::is_same_v<FT, f32> || std::is_same_v<FT, f64>);
+  if constexpr (std::is_same_v<FT, f32>) {
+    if constexpr (std::is_same_v<IT, i32>)
+      return F32ToI32<rm>(a);
+    else if constexpr (std::is_same_v<IT, i64>)
+      return F32ToI64<rm>(a);
+    else if constexpr (std::is_same_v<IT, u32>)
+      return F32ToU32<rm>(a);
+    else
+      return F32ToU64<rm>(a);
+  } else {
+    if constexpr (std::is_same_v<IT, i32>)
+      return F64ToI32<rm>(a);
+    else if constexpr (std::is_same_v<IT, i64>)
+      return F64ToI64<rm>(a);
+    else if constexpr (std::is_same_v<IT, u32>)
+      return F64ToU32<rm>(a);
+    else
+      return F64ToU64<rm>(a);
+  }
+}
+
+template <typename FT, typename IT, FloppyFloat::RoundingMode rm>
+FT FloppyFloat::IToF(IT a) {
+  static_assert(std::is_same_v<FT, f32> || std::is_same_v<FT, f64>);
+  if constexpr (std::is_same_v<FT, f32>) {
+    if constexpr (std::is_same_v<IT, i32>)
+      return I32ToF32<rm>(a);
+    else if constexpr (std::is_same_v<IT, i64>)
+      return I64ToF32<rm>(a);
+    else if constexpr (std::is_same_v<IT, u32>)
+      return U32ToF32<rm>(a);
+    else
+      return U64ToF32<rm>(a);
+  } else {
+    if constexpr (std::is_same_v<IT, i32>)
+      return I32ToF64(a);
+    else if constexpr (std::is_same_v<IT, i64>)
+      return I64ToF64<rm>(a);
+    else if constexpr (std::is_same_v<IT, u32>)
+      return U32ToF64(a);
+    else
+      return U64ToF64<rm>(a);
+  }
+}
+
+template <typename FT, typename IT, FloppyFloat::RoundingMode rm>
+IT FloppyFloat::FToFixed(FT a, u32 fbits) {
+  if (fbits > static_cast<u32>(NumBits<IT>())) [[unlikely]]
+    throw std::runtime_error(std::string("Invalid number of fractional bits"));
+  // The scaling is exact, so the integer conversion is the only rounding. It also provides the limits of the ISA.
+  using ST = FixedScaleType<FT>;
+  return FToI<ST, IT, rm>(static_cast<ST>(a) * Pow2<ST>(static_cast<i32>(fbits)));
+}
+
+template i32 FloppyFloat::FToFixed<f16, i32, FloppyFloat::kRoundTiesToEven>(f16 a, u32 fbits);
+template i32 FloppyFloat::FToFixed<f16, i32, FloppyFloat::kRoundTowardPositive>(f16 a, u32 fbits);
+template i32 FloppyFloat::FToFixed<f16, i32, FloppyFloat::kRoundTowardNegative>(f16 a, u32 fbits);
+template i32 FloppyFloat::FToFixed<f16, i32, FloppyFloat::kRoundTowardZero>(f16 a, u32 fbits);
+template i32 FloppyFloat::FToFixed<f16, i32, FloppyFloat::kRoundTiesToAway>(f16 a, u32 fbits);
+template i64 FloppyFloat::FToFixed<f16, i64, FloppyFloat::kRoundTiesToEven>(f16 a, u32 fbits);
+template i64 FloppyFloat::FToFixed<f16, i64, FloppyFloat::kRoundTowardPositive>(f16 a, u32 fbits);
+template i64 FloppyFloat::FToFixed<f16, i64, FloppyFloat::kRoundTowardNegative>(f16 a, u32 fbits);
+template i64 FloppyFloat::FToFixed<f16, i64, FloppyFloat::kRoundTowardZero>(f16 a, u32 fbits);
+template i64 FloppyFloat::FToFixed<f16, i64, FloppyFloat::kRoundTiesToAway>(f16 a, u32 fbits);
+template u32 FloppyFloat::FToFixed<f16, u32, FloppyFloat::kRoundTiesToEven>(f16 a, u32 fbits);
+template u32 FloppyFloat::FToFixed<f16, u32, FloppyFloat::kRoundTowardPositive>(f16 a, u32 fbits);
+template u32 FloppyFloat::FToFixed<f16, u32, FloppyFloat::kRoundTowardNegative>(f16 a, u32 fbits);
+template u32 FloppyFloat::FToFixed<f16, u32, FloppyFloat::kRoundTowardZero>(f16 a, u32 fbits);
+template u32 FloppyFloat::FToFixed<f16, u32, FloppyFloat::kRoundTiesToAway>(f16 a, u32 fbits);
+template u64 FloppyFloat::FToFixed<f16, u64, FloppyFloat::kRoundTiesToEven>(f16 a, u32 fbits);
+template u64 FloppyFloat::FToFixed<f16, u64, FloppyFloat::kRoundTowardPositive>(f16 a, u32 fbits);
+template u64 FloppyFloat::FToFixed<f16, u64, FloppyFloat::kRoundTowardNegative>(f16 a, u32 fbits);
+template u64 FloppyFloat::FToFixed<f16, u64, FloppyFloat::kRoundTowardZero>(f16 a, u32 fbits);
+template u64 FloppyFloat::FToFixed<f16, u64, FloppyFloat::kRoundTiesToAway>(f16 a, u32 fbits);
+template i32 FloppyFloat::FToFixed<f32, i32, FloppyFloat::kRoundTiesToEven>(f32 a, u32 fbits);
+template i32 FloppyFloat::FToFixed<f32, i32, FloppyFloat::kRoundTowardPositive>(f32 a, u32 fbits);
+template i32 FloppyFloat::FToFixed<f32, i32, FloppyFloat::kRoundTowardNegative>(f32 a, u32 fbits);
+template i32 FloppyFloat::FToFixed<f32, i32, FloppyFloat::kRoundTowardZero>(f32 a, u32 fbits);
+template i32 FloppyFloat::FToFixed<f32, i32, FloppyFloat::kRoundTiesToAway>(f32 a, u32 fbits);
+template i64 FloppyFloat::FToFixed<f32, i64, FloppyFloat::kRoundTiesToEven>(f32 a, u32 fbits);
+template i64 FloppyFloat::FToFixed<f32, i64, FloppyFloat::kRoundTowardPositive>(f32 a, u32 fbits);
+template i64 FloppyFloat::FToFixed<f32, i64, FloppyFloat::kRoundTowardNegative>(f32 a, u32 fbits);
+template i64 FloppyFloat::FToFixed<f32, i64, FloppyFloat::kRoundTowardZero>(f32 a, u32 fbits);
+template i64 FloppyFloat::FToFixed<f32, i64, FloppyFloat::kRoundTiesToAway>(f32 a, u32 fbits);
+template u32 FloppyFloat::FToFixed<f32, u32, FloppyFloat::kRoundTiesToEven>(f32 a, u32 fbits);
+template u32 FloppyFloat::FToFixed<f32, u32, FloppyFloat::kRoundTowardPositive>(f32 a, u32 fbits);
+template u32 FloppyFloat::FToFixed<f32, u32, FloppyFloat::kRoundTowardNegative>(f32 a, u32 fbits);
+template u32 FloppyFloat::FToFixed<f32, u32, FloppyFloat::kRoundTowardZero>(f32 a, u32 fbits);
+template u32 FloppyFloat::FToFixed<f32, u32, FloppyFloat::kRoundTiesToAway>(f32 a, u32 fbits);
+template u64 FloppyFloat::FToFixed<f32, u64, FloppyFloat::kRoundTiesToEven>(f32 a, u32 fbits);
+template u64 FloppyFloat::FToFixed<f32, u64, FloppyFloat::kRoundTowardPositive>(f32 a, u32 fbits);
+template u64 FloppyFloat::FToFixed<f32, u64, FloppyFloat::kRoundTowardNegative>(f32 a, u32 fbits);
+template u64 FloppyFloat::FToFixed<f32, u64, FloppyFloat::kRoundTowardZero>(f32 a, u32 fbits);
+template u64 FloppyFloat::FToFixed<f32, u64, FloppyFloat::kRoundTiesToAway>(f32 a, u32 fbits);
+template i32 FloppyFloat::FToFixed<f64, i32, FloppyFloat::kRoundTiesToEven>(f64 a, u32 fbits);
+template i32 FloppyFloat::FToFixed<f64, i32, FloppyFloat::kRoundTowardPositive>(f64 a, u32 fbits);
+template i32 FloppyFloat::FToFixed<f64, i32, FloppyFloat::kRoundTowardNegative>(f64 a, u32 fbits);
+template i32 FloppyFloat::FToFixed<f64, i32, FloppyFloat::kRoundTowardZero>(f64 a, u32 fbits);
+template i32 FloppyFloat::FToFixed<f64, i32, FloppyFloat::kRoundTiesToAway>(f64 a, u32 fbits);
+template i64 FloppyFloat::FToFixed<f64, i64, FloppyFloat::kRoundTiesToEven>(f64 a, u32 fbits);
+template i64 FloppyFloat::FToFixed<f64, i64, FloppyFloat::kRoundTowardPositive>(f64 a, u32 fbits);
+template i64 FloppyFloat::FToFixed<f64, i64, FloppyFloat::kRoundTowardNegative>(f64 a, u32 fbits);
+template i64 FloppyFloat::FToFixed<f64, i64, FloppyFloat::kRoundTowardZero>(f64 a, u32 fbits);
+template i64 FloppyFloat::FToFixed<f64, i64, FloppyFloat::kRoundTiesToAway>(f64 a, u32 fbits);
+template u32 FloppyFloat::FToFixed<f64, u32, FloppyFloat::kRoundTiesToEven>(f64 a, u32 fbits);
+template u32 FloppyFloat::FToFixed<f64, u32, FloppyFloat::kRoundTowardPositive>(f64 a, u32 fbits);
+template u32 FloppyFloat::FToFixed<f64, u32, FloppyFloat::kRoundTowardNegative>(f64 a, u32 fbits);
+template u32 FloppyFloat::FToFixed<f64, u32, FloppyFloat::kRoundTowardZero>(f64 a, u32 fbits);
+template u32 FloppyFloat::FToFixed<f64, u32, FloppyFloat::kRoundTiesToAway>(f64 a, u32 fbits);
+template u64 FloppyFloat::FToFixed<f64, u64, FloppyFloat::kRoundTiesToEven>(f64 a, u32 fbits);
+template u64 FloppyFloat::FToFixed<f64, u64, FloppyFloat::kRoundTowardPositive>(f64 a, u32 fbits);
+template u64 FloppyFloat::FToFixed<f64, u64, FloppyFloat::kRoundTowardNegative>(f64 a, u32 fbits);
+template u64 FloppyFloat::FToFixed<f64, u64, FloppyFloat::kRoundTowardZero>(f64 a, u32 fbits);
+template u64 FloppyFloat::FToFixed<f64, u64, FloppyFloat::kRoundTiesToAway>(f64 a, u32 fbits);
+
+template <typename FT, typename IT>
+IT FloppyFloat::FToFixed(FT a, u32 fbits) {
+  FlushInputs<false>(a);
   switch (rounding_mode) {
   case kRoundTiesToEven:
-    return U32ToF32<kRoundTiesToEven>(a);
+    return FToFixed<FT, IT, kRoundTiesToEven>(a, fbits);
   case kRoundTiesToAway:
-    return U32ToF32<kRoundTiesToAway>(a);
+    return FToFixed<FT, IT, kRoundTiesToAway>(a, fbits);
   case kRoundTowardPositive:
-    return U32ToF32<kRoundTowardPositive>(a);
+    return FToFixed<FT, IT, kRoundTowardPositive>(a, fbits);
   case kRoundTowardNegative:
-    return U32ToF32<kRoundTowardNegative>(a);
+    return FToFixed<FT, IT, kRoundTowardNegative>(a, fbits);
   case kRoundTowardZero:
-    return U32ToF32<kRoundTowardZero>(a);
+    return FToFixed<FT, IT, kRoundTowardZero>(a, fbits);
   default:
     throw std::runtime_error(std::string("Unknown rounding mode"));
   }
 }
 
-template <FloppyFloat::RoundingMode rm>
-f32 FloppyFloat::U32ToF32(u32 a) {
-  constexpr u32 guard_bit{0x80u};
-  constexpr u32 significand_last_bit{0x100u};
-
-  f32 af = static_cast<f32>(a);
-  u32 shifted_ua = a << std::countl_zero(a);
-  u32 r = shifted_ua & (significand_last_bit - 1u);  // Get the last 32-24=8 bits.
+template i32 FloppyFloat::FToFixed<f16, i32>(f16 a, u32 fbits);
+template i64 FloppyFloat::FToFixed<f16, i64>(f16 a, u32 fbits);
+template u32 FloppyFloat::FToFixed<f16, u32>(f16 a, u32 fbits);
+template u64 FloppyFloat::FToFixed<f16, u64>(f16 a, u32 fbits);
+template i32 FloppyFloat::FToFixed<f32, i32>(f32 a, u32 fbits);
+template i64 FloppyFloat::FToFixed<f32, i64>(f32 a, u32 fbits);
+template u32 FloppyFloat::FToFixed<f32, u32>(f32 a, u32 fbits);
+template u64 FloppyFloat::FToFixed<f32, u64>(f32 a, u32 fbits);
+template i32 FloppyFloat::FToFixed<f64, i32>(f64 a, u32 fbits);
+template i64 FloppyFloat::FToFixed<f64, i64>(f64 a, u32 fbits);
+template u32 FloppyFloat::FToFixed<f64, u32>(f64 a, u32 fbits);
+template u64 FloppyFloat::FToFixed<f64, u64>(f64 a, u32 fbits);
 
-  if (r != 0) {
-    inexact = true;
-    [[maybe_unused]] bool even;
-    if constexpr (rm != kRoundTiesToEven)
-      even = shifted_ua & 0x100u;
-    if constexpr (rm == kRoundTowardPositive) {
-      if ((r < guard_bit) || ((r == guard_bit) && !even))
-        af = NextUpNoNegZero(af);
-    } else if constexpr (rm == kRoundTowardNegative) {
-      if ((r > guard_bit) || ((r == guard_bit) && even))
-        af = NextDownNoPosZero(af);
-    } else if constexpr (rm == kRoundTowardZero) {
-      if ((r > guard_bit) || ((r == guard_bit) && even))
-        af = NextDownNoPosZero(af);
-    } else if constexpr (rm == kRoundTiesToAway) {
-      if ((r == guard_bit) && !even)
-        af = NextUpNoNegZero(af);
-    }
+template <typename FT, typename IT, FloppyFloat::RoundingMode rm>
+FT FloppyFloat::FixedToF(IT a, u32 fbits) {
+  if (fbits > static_cast<u32>(NumBits<IT>())) [[unlikely]]
+    throw std::runtime_error(std::string("Invalid number of fractional bits"));
+  if constexpr (std::is_same_v<FT, f16>) {
+    // The result may be subnormal, so that scaling after the conversion would round twice. In f64, the scaling is
+    // exact and the conversion to f16 is the only rounding.
+    return F64ToF16<rm>(IToF64RoundToOdd(a) * Pow2<f64>(-static_cast<i32>(fbits)));
+  } else {
+    // The smallest nonzero magnitude is 2^-64, so that the scaling after the rounded conversion is exact.
+    return IToF<FT, IT, rm>(a) * Pow2<FT>(-static_cast<i32>(fbits));
   }
-
-  return af;
 }
 
-template f32 FloppyFloat::U32ToF32<FloppyFloat::kRoundTiesToEven>(u32 a);
-template f32 FloppyFloat::U32ToF32<FloppyFloat::kRoundTowardPositive>(u32 a);
-template f32 FloppyFloat::U32ToF32<FloppyFloat::kRoundTowardNegative>(u32 a);
-template f32 FloppyFloat::U32ToF32<FloppyFloat::kRoundTowardZero>(u32 a);
-template f32 FloppyFloat::U32ToF32<FloppyFloat::kRoundTiesToAway>(u32 a);
-
-f32 FloppyFloat::U64ToF32(u64 a) {
+template f16 FloppyFloat::FixedToF<f16, i32, FloppyFloat::kRoundTiesToEven>(i32 a, u32 fbits);
+template f16 FloppyFloat::FixedToF<f16, i32, FloppyFloat::kRoundTowardPositive>(i32 a, u32 fbits);
+template f16 FloppyFloat::FixedToF<f16, i32, FloppyFloat::kRoundTowardNegative>(i32 a, u32 fbits);
+template f16 FloppyFloat::FixedToF<f16, i32, FloppyFloat::kRoundTowardZero>(i32 a, u32 fbits);
+template f16 FloppyFloat::FixedToF<f16, i32, FloppyFloat::kRoundTiesToAway>(i32 a, u32 fbits);
+template f16 FloppyFloat::FixedToF<f16, i64, FloppyFloat::kRoundTiesToEven>(i64 a, u32 fbits);
+template f16 FloppyFloat::FixedToF<f16, i64, FloppyFloat::kRoundTowardPositive>(i64 a, u32 fbits);
+template f16 FloppyFloat::FixedToF<f16, i64, FloppyFloat::kRoundTowardNegative>(i64 a, u32 fbits);
+template f16 FloppyFloat::FixedToF<f16, i64, FloppyFloat::kRoundTowardZero>(i64 a, u32 fbits);
+template f16 FloppyFloat::FixedToF<f16, i64, FloppyFloat::kRoundTiesToAway>(i64 a, u32 fbits);
+template f16 FloppyFloat::FixedToF<f16, u32, FloppyFloat::kRoundTiesToEven>(u32 a, u32 fbits);
+template f16 FloppyFloat::FixedToF<f16, u32, FloppyFloat::kRoundTowardPositive>(u32 a, u32 fbits);
+template f16 FloppyFloat::FixedToF<f16, u32, FloppyFloat::kRoundTowardNegative>(u32 a, u32 fbits);
+template f16 FloppyFloat::FixedToF<f16, u32, FloppyFloat::kRoundTowardZero>(u32 a, u32 fbits);
+template f16 FloppyFloat::FixedToF<f16, u32, FloppyFloat::kRoundTiesToAway>(u32 a, u32 fbits);
+template f16 FloppyFloat::FixedToF<f16, u64, FloppyFloat::kRoundTiesToEven>(u64 a, u32 fbits);
+template f16 FloppyFloat::FixedToF<f16, u64, FloppyFloat::kRoundTowardPositive>(u64 a, u32 fbits);
+template f16 FloppyFloat::FixedToF<f16, u64, FloppyFloat::kRoundTowardNegative>(u64 a, u32 fbits);
+template f16 FloppyFloat::FixedToF<f16, u64, FloppyFloat::kRoundTowardZero>(u64 a, u32 fbits);
+template f16 FloppyFloat::FixedToF<f16, u64, FloppyFloat::kRoundTiesToAway>(u64 a, u32 fbits);
+template f32 FloppyFloat::FixedToF<f32, i32, FloppyFloat::kRoundTiesToEven>(i32 a, u32 fbits);
+template f32 FloppyFloat::FixedToF<f32, i32, FloppyFloat::kRoundTowardPositive>(i32 a, u32 fbits);
+template f32 FloppyFloat::FixedToF<f32, i32, FloppyFloat::kRoundTowardNegative>(i32 a, u32 fbits);
+template f32 FloppyFloat::FixedToF<f32, i32, FloppyFloat::kRoundTowardZero>(i32 a, u32 fbits);
+template f32 FloppyFloat::FixedToF<f32, i32, FloppyFloat::kRoundTiesToAway>(i32 a, u32 fbits);
+template f32 FloppyFloat::FixedToF<f32, i64, FloppyFloat::kRoundTiesToEven>(i64 a, u32 fbits);
+template f32 FloppyFloat::FixedToF<f32, i64, FloppyFloat::kRoundTowardPositive>(i64 a, u32 fbits);
+template f32 FloppyFloat::FixedToF<f32, i64, FloppyFloat::kRoundTowardNegative>(i64 a, u32 fbits);
+template f32 FloppyFloat::FixedToF<f32, i64, FloppyFloat::kRoundTowardZero>(i64 a, u32 fbits);
+template f32 FloppyFloat::FixedToF<f32, i64, FloppyFloat::kRoundTiesToAway>(i64 a, u32 fbits);
+template f32 FloppyFloat::FixedToF<f32, u32, FloppyFloat::kRoundTiesToEven>(u32 a, u32 fbits);
+template f32 FloppyFloat::FixedToF<f32, u32, FloppyFloat::kRoundTowardPositive>(u32 a, u32 fbits);
+template f32 FloppyFloat::FixedToF<f32, u32, FloppyFloat::kRoundTowardNegative>(u32 a, u32 fbits);
+template f32 FloppyFloat::FixedToF<f32, u32, FloppyFloat::kRoundTowardZero>(u32 a, u32 fbits);
+template f32 FloppyFloat::FixedToF<f32, u32, FloppyFloat::kRoundTiesToAway>(u32 a, u32 fbits);
+template f32 FloppyFloat::FixedToF<f32, u64, FloppyFloat::kRoundTiesToEven>(u64 a, u32 fbits);
+template f32 FloppyFloat::FixedToF<f32, u64, FloppyFloat::kRoundTowardPositive>(u64 a, u32 fbits);
+template f32 FloppyFloat::FixedToF<f32, u64, FloppyFloat::kRoundTowardNegative>(u64 a, u32 fbits);
+template f32 FloppyFloat::FixedToF<f32, u64, FloppyFloat::kRoundTowardZero>(u64 a, u32 fbits);
+template f32 FloppyFloat::FixedToF<f32, u64, FloppyFloat::kRoundTiesToAway>(u64 a, u32 fbits);
+template f64 FloppyFloat::FixedToF<f64, i32, FloppyFloat::kRoundTiesToEven>(i32 a, u32 fbits);
+template f64 FloppyFloat::FixedToF<f64, i32, FloppyFloat::kRoundTowardPositive>(i32 a, u32 fbits);
+template f64 FloppyFloat::FixedToF<f64, i32, FloppyFloat::kRoundTowardNegative>(i32 a, u32 fbits);
+template f64 FloppyFloat::FixedToF<f64, i32, FloppyFloat::kRoundTowardZero>(i32 a, u32 fbits);
+template f64 FloppyFloat::FixedToF<f64, i32, FloppyFloat::kRoundTiesToAway>(i32 a, u32 fbits);
+template f64 FloppyFloat::FixedToF<f64, i64, FloppyFloat::kRoundTiesToEven>(i64 a, u32 fbits);
+template f64 FloppyFloat::FixedToF<f64, i64, FloppyFloat::kRoundTowardPositive>(i64 a, u32 fbits);
+template f64 FloppyFloat::FixedToF<f64, i64, FloppyFloat::kRoundTowardNegative>(i64 a, u32 fbits);
+template f64 FloppyFloat::FixedToF<f64, i64, FloppyFloat::kRoundTowardZero>(i64 a, u32 fbits);
+template f64 FloppyFloat::FixedToF<f64, i64, FloppyFloat::kRoundTiesToAway>(i64 a, u32 fbits);
+template f64 FloppyFloat::FixedToF<f64, u32, FloppyFloat::kRoundTiesToEven>(u32 a, u32 fbits);
+template f64 FloppyFloat::FixedToF<f64, u32, FloppyFloat::kRoundTowardPositive>(u32 a, u32 fbits);
+template f64 FloppyFloat::FixedToF<f64, u32, FloppyFloat::kRoundTowardNegative>(u32 a, u32 fbits);
+template f64 FloppyFloat::FixedToF<f64, u32, FloppyFloat::kRoundTowardZero>(u32 a, u32 fbits);
+template f64 FloppyFloat::FixedToF<f64, u32, FloppyFloat::kRoundTiesToAway>(u32 a, u32 fbits);
+template f64 FloppyFloat::FixedToF<f64, u64, FloppyFloat::kRoundTiesToEven>(u64 a, u32 fbits);
+template f64 FloppyFloat::FixedToF<f64, u64, FloppyFloat::kRoundTowardPositive>(u64 a, u32 fbits);
+template f64 FloppyFloat::FixedToF<f64, u64, FloppyFloat::kRoundTowardNegative>(u64 a, u32 fbits);
+template f64 FloppyFloat::FixedToF<f64, u64, FloppyFloat::kRoundTowardZero>(u64 a, u32 fbits);
+template f64 FloppyFloat::FixedToF<f64, u64, FloppyFloat::kRoundTiesToAway>(u64 a, u32 fbits);
+
+template <typename FT, typename IT>
+FT FloppyFloat::FixedToF(IT a, u32 fbits) {
   switch (rounding_mode) {
   case kRoundTiesToEven:
-    return U64ToF32<kRoundTiesToEven>(a);
+    return FixedToF<FT, IT, kRoundTiesToEven>(a, fbits);
   case kRoundTiesToAway:
-    return U64ToF32<kRoundTiesToAway>(a);
+    return FixedToF<FT, IT, kRoundTiesToAway>(a, fbits);
   case kRoundTowardPositive:
-    return U64ToF32<kRoundTowardPositive>(a);
+    return FixedToF<FT, IT, kRoundTowardPositive>(a, fbits);
   case kRoundTowardNegative:
-    return U64ToF32<kRoundTowardNegative>(a);
+    return FixedToF<FT, IT, kRoundTowardNegative>(a, fbits);
   case kRoundTowardZero:
-    return U64ToF32<kRoundTowardZero>(a);
+    return FixedToF<FT, IT, kRoundTowardZero>(a, fbits);
   default:
     throw std::runtime_error(std::string("Unknown rounding mode"));
   }
 }
 
-template <FloppyFloat::RoundingMode rm>
-f32 FloppyFloat::U64ToF32(u64 a) {
-  constexpr u64 guard_bit{0x8000000000ull};
-  constexpr u64 significand_last_bit{0x10000000000ull};
+template f16 FloppyFloat::FixedToF<f16, i32>(i32 a, u32 fbits);
+template f16 FloppyFloat::FixedToF<f16, i64>(i64 a, u32 fbits);
+template f16 FloppyFloat::FixedToF<f16, u32>(u32 a, u32 fbits);
+template f16 FloppyFloat::FixedToF<f16, u64>(u64 a, u32 fbits);
+template f32 FloppyFloat::FixedToF<f32, i32>(i32 a, u32 fbits);
+template f32 FloppyFloat::FixedToF<f32, i64>(i64 a, u32 fbits);
+template f32 FloppyFloat::FixedToF<f32, u32>(u32 a, u32 fbits);
+template f32 FloppyFloat::FixedToF<f32, u64>(u64 a, u32 fbits);
+template f64 FloppyFloat::FixedToF<f64, i32>(i32 a, u32 fbits);
+template f64 FloppyFloat::FixedToF<f64, i64>(i64 a, u32 fbits);
+template f64 FloppyFloat::FixedToF<f64, u32>(u32 a, u32 fbits);
+template f64 FloppyFloat::FixedToF<f64, u64>(u64 a, u32 fbits);
 
-  f32 af = static_cast<f32>(a);
-  u64 shifted_ua = a << std::countl_zero(a);
-  u64 r = shifted_ua & (significand_last_bit - 1ull);  // Get the last 64-24=40 bits.
+template <typename FT, typename IT, FloppyFloat::RoundingMode rm>
+void FloppyFloat::FToFixedBatch(IT* dst, const FT* a, u32 fbits, std::size_t n) {
+  if (fbits > static_cast<u32>(NumBits<IT>())) [[unlikely]]
+    throw std::runtime_error(std::string("Invalid number of fractional bits"));
+  using ST = FixedScaleType<FT>;
+  constexpr ST kLow = std::is_signed_v<IT> ? -Pow2<ST>(NumBits<IT>() - 1) : static_cast<ST>(0);
+  constexpr ST kHigh = Pow2<ST>(std::is_signed_v<IT> ? NumBits<IT>() - 1 : NumBits<IT>());
+  const ST scale = Pow2<ST>(static_cast<i32>(fbits));
+  const bool flush = std::is_same_v<FT, f16> ? flush_inputs_f16 : flush_inputs;
+  constexpr std::size_t kBlockSize = 64;
+  for (std::size_t i = 0; i < n; i += kBlockSize) {
+    const std::size_t block_size = std::min(kBlockSize, n - i);
+    IT result[kBlockSize];
+    bool out_of_range = false;
+    bool block_inexact = false;
+    bool denormal = false;
+    for (std::size_t j = 0; j < block_size; ++j) {
+      denormal |= IsSubnormal(a[i + j]);
+      const ST scaled = static_cast<ST>(a[i + j]) * scale;
+      const ST rounded = HostRoundToIntegral<rm>(scaled);
+      const bool in_range = rounded >= kLow && rounded < kHigh;  // False for NaNs.
+      out_of_range |= !in_range;
+      result[j] = static_cast<IT>(in_range ? rounded : static_cast<ST>(0));
+      block_inexact |= rounded != scaled;
+    }
 
-  if (r != 0) {
-    inexact = true;
-    [[maybe_unused]] bool even;
-    if constexpr (rm != kRoundTiesToEven)
-      even = shifted_ua & significand_last_bit;
-    if constexpr (rm == kRoundTowardPositive) {
-      if ((r < guard_bit) || ((r == guard_bit) && !even))
-        af = NextUpNoNegZero(af);
-    } else if constexpr (rm == kRoundTowardNegative) {
-      if ((r > guard_bit) || ((r == guard_bit) && even))
-        af = NextDownNoPosZero(af);
-    } else if constexpr (rm == kRoundTowardZero) {
-      if ((r > guard_bit) || ((r == guard_bit) && even))
-        af = NextDownNoPosZero(af);
-    } else if constexpr (rm == kRoundTiesToAway) {
-      if ((r == guard_bit) && !even)
-        af = NextUpNoNegZero(af);
+    if (!out_of_range && !(denormal && flush)) [[likely]] {
+      std::memcpy(dst + i, result, block_size * sizeof(IT));
+      if (block_inexact)
+        inexact = true;
+      continue;
+    }
+
+    for (std::size_t j = 0; j < block_size; ++j) {
+      FT x = a[i + j];
+      FlushInputs<false>(x);
+      dst[i + j] = FToFixed<FT, IT, rm>(x, fbits);
     }
   }
+}
 
-  return af;
+template <typename FT, typename IT>
+void FloppyFloat::FToFixedBatch(IT* dst, const FT* a, u32 fbits, std::size_t n) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return FToFixedBatch<FT, IT, kRoundTiesToEven>(dst, a, fbits, n);
+  case kRoundTiesToAway:
+    return FToFixedBatch<FT, IT, kRoundTiesToAway>(dst, a, fbits, n);
+  case kRoundTowardPositive:
+    return FToFixedBatch<FT, IT, kRoundTowardPositive>(dst, a, fbits, n);
+  case kRoundTowardNegative:
+    return FToFixedBatch<FT, IT, kRoundTowardNegative>(dst, a, fbits, n);
+  case kRoundTowardZero:
+    return FToFixedBatch<FT, IT, kRoundTowardZero>(dst, a, fbits, n);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
 }
 
-template f32 FloppyFloat::U64ToF32<FloppyFloat::kRoundTiesToEven>(u64 a);
-template f32 FloppyFloat::U64ToF32<FloppyFloat::kRoundTowardPositive>(u64 a);
-template f32 FloppyFloat::U64ToF32<FloppyFloat::kRoundTowardNegative>(u64 a);
-template f32 FloppyFloat::U64ToF32<FloppyFloat::kRoundTowardZero>(u64 a);
-template f32 FloppyFloat::U64ToF32<FloppyFloat::kRoundTiesToAway>(u64 a);
+template void FloppyFloat::FToFixedBatch<f16, i32>(i32* dst, const f16* a, u32 fbits, std::size_t n);
+template void FloppyFloat::FToFixedBatch<f16, i64>(i64* dst, const f16* a, u32 fbits, std::size_t n);
+template void FloppyFloat::FToFixedBatch<f16, u32>(u32* dst, const f16* a, u32 fbits, std::size_t n);
+template void FloppyFloat::FToFixedBatch<f16, u64>(u64* dst, const f16* a, u32 fbits, std::size_t n);
+template void FloppyFloat::FToFixedBatch<f32, i32>(i32* dst, const f32* a, u32 fbits, std::size_t n);
+template void FloppyFloat::FToFixedBatch<f32, i64>(i64* dst, const f32* a, u32 fbits, std::size_t n);
+template void FloppyFloat::FToFixedBatch<f32, u32>(u32* dst, const f32* a, u32 fbits, std::size_t n);
+template void FloppyFloat::FToFixedBatch<f32, u64>(u64* dst, const f32* a, u32 fbits, std::size_t n);
+template void FloppyFloat::FToFixedBatch<f64, i32>(i32* dst, const f64* a, u32 fbits, std::size_t n);
+template void FloppyFloat::FToFixedBatch<f64, i64>(i64* dst, const f64* a, u32 fbits, std::size_t n);
+template void FloppyFloat::FToFixedBatch<f64, u32>(u32* dst, const f64* a, u32 fbits, std::size_t n);
+template void FloppyFloat::FToFixedBatch<f64, u64>(u64* dst, const f64* a, u32 fbits, std::size_t n);
 
-f64 FloppyFloat::U32ToF64(u32 a) {
-  return static_cast<f64>(a);
+template <typename FT, typename IT, FloppyFloat::RoundingMode rm>
+void FloppyFloat::FixedToFBatch(FT* dst, const IT* a, u32 fbits, std::size_t n) {
+  if (fbits > static_cast<u32>(NumBits<IT>())) [[unlikely]]
+    throw std::runtime_error(std::string("Invalid number of fractional bits"));
+  if constexpr (std::is_same_v<FT, f16>) {
+    for (std::size_t i = 0; i < n; ++i)
+      dst[i] = FixedToF<FT, IT, rm>(a[i], fbits);
+  } else {
+    // Integers up to 2^(p + 1) convert exactly with the host FPU. With 32-bit integers, f64 detects whether the
+    // conversion to f32 rounded, so that rounding to nearest even needs no fallback at all.
+    constexpr bool kDetectsInexact = rm == kRoundTiesToEven && NumBits<IT>() <= 32;
+    constexpr u64 kExact = 1ull << (NumSignificandBits<FT>() + 1);
+    const FT scale = Pow2<FT>(-static_cast<i32>(fbits));
+    constexpr std::size_t kBlockSize = 64;
+    for (std::size_t i = 0; i < n; i += kBlockSize) {
+      const std::size_t block_size = std::min(kBlockSize, n - i);
+      FT result[kBlockSize];
+      bool inexact_or_large = false;
+      for (std::size_t j = 0; j < block_size; ++j) {
+        const IT x = a[i + j];
+        const FT converted = static_cast<FT>(x);
+        if constexpr (kDetectsInexact)
+          inexact_or_large |= static_cast<f64>(converted) != static_cast<f64>(x);
+        else if constexpr (std::is_signed_v<IT>)
+          inexact_or_large |= x < -static_cast<i64>(kExact) || x > static_cast<i64>(kExact);
+        else
+          inexact_or_large |= static_cast<u64>(x) > kExact;
+        result[j] = converted * scale;
+      }
+
+      if (!inexact_or_large) [[likely]] {
+        std::memcpy(dst + i, result, block_size * sizeof(FT));
+        continue;
+      }
+      if constexpr (kDetectsInexact) {
+        std::memcpy(dst + i, result, block_size * sizeof(FT));
+        inexact = true;
+        continue;
+      }
+
+      for (std::size_t j = 0; j < block_size; ++j)
+        dst[i + j] = FixedToF<FT, IT, rm>(a[i + j], fbits);
+    }
+  }
+}
+
+template <typename FT, typename IT>
+void FloppyFloat::FixedToFBatch(FT* dst, const IT* a, u32 fbits, std::size_t n) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return FixedToFBatch<FT, IT, kRoundTiesToEven>(dst, a, fbits, n);
+  case kRoundTiesToAway:
+    return FixedToFBatch<FT, IT, kRoundTiesToAway>(dst, a, fbits, n);
+  case kRoundTowardPositive:
+    return FixedToFBatch<FT, IT, kRoundTowardPositive>(dst, a, fbits, n);
+  case kRoundTowardNegative:
+    return FixedToFBatch<FT, IT, kRoundTowardNegative>(dst, a, fbits, n);
+  case kRoundTowardZero:
+    return FixedToFBatch<FT, IT, kRoundTowardZero>(dst, a, fbits, n);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
 }
 
+template void FloppyFloat::FixedToFBatch<f16, i32>(f16* dst, const i32* a, u32 fbits, std::size_t n);
+template void FloppyFloat::FixedToFBatch<f16, i64>(f16* dst, const i64* a, u32 fbits, std::size_t n);
+template void FloppyFloat::FixedToFBatch<f16, u32>(f16* dst, const u32* a, u32 fbits, std::size_t n);
+template void FloppyFloat::FixedToFBatch<f16, u64>(f16* dst, const u64* a, u32 fbits, std::size_t n);
+template void FloppyFloat::FixedToFBatch<f32, i32>(f32* dst, const i32* a, u32 fbits, std::size_t n);
+template void FloppyFloat::FixedToFBatch<f32, i64>(f32* dst, const i64* a, u32 fbits, std::size_t n);
+template void FloppyFloat::FixedToFBatch<f32, u32>(f32* dst, const u32* a, u32 fbits, std::size_t n);
+template void FloppyFloat::FixedToFBatch<f32, u64>(f32* dst, const u64* a, u32 fbits, std::size_t n);
+template void FloppyFloat::FixedToFBatch<f64, i32>(f64* dst, const i32* a, u32 fbits, std::size_t n);
+template void FloppyFloat::FixedToFBatch<f64, i64>(f64* dst, const i64* a, u32 fbits, std::size_t n);
+template void FloppyFloat::FixedToFBatch<f64, u32>(f64* dst, const u32* a, u32 fbits, std::size_t n);
+template void FloppyFloat::FixedToFBatch<f64, u64>(f64* dst, const u64* a, u32 fbits, std::size_t n);
+
 template <typename FT>
 u32 FloppyFloat::Class(FT a) {
   bool sign = std::signbit(a);
@@ -2087,3 +6149,105 @@ u32 FloppyFloat::Class(FT a) {
          | (IsSnan(a)) << 8                     // Signaling NaN
          | (IsNan(a) && !IsSnan(a)) << 9;       // Quiet NaN
 }
+
+template u32 FloppyFloat::Class<f16>(f16 a);
+template u32 FloppyFloat::Class<f32>(f32 a);
+template u32 FloppyFloat::Class<f64>(f64 a);
+
+void FloppyFloat::DotBf16x86(f32* acc, const bf16* a, const bf16* b, size_t n) {
+  // vdpbf16ps neither consults nor updates MXCSR. It always rounds to nearest even, treats denormal inputs as zero,
+  // and flushes denormal results to zero. A private FPU keeps the flags of this one untouched. It is set up once per
+  // thread, and only its underflow flag is ever read.
+  static thread_local FloppyFloat fpu = [] {
+    FloppyFloat x86;
+    x86.SetupToX86();
+    return x86;
+  }();
+  for (size_t i = 0; i < n; ++i) {
+    f32 d = FlushToZero(acc[i]);
+    for (size_t j : {2 * i + 1, 2 * i}) {  // The odd pair is accumulated first.
+      fpu.underflow = false;
+      d = fpu.Fma<f32, kRoundTiesToEven>(FlushToZero(WidenBF16(a[j])), FlushToZero(WidenBF16(b[j])), d);
+      if (fpu.underflow || IsSubnormal(d))  // x86 detects tininess after rounding.
+        d = std::copysign(0.f32, d);
+    }
+    acc[i] = d;
+  }
+}
+
+// Rounds the f64 result of a bfdot step with residual c - exact to f32 like Arm's BFRound: round to odd, results
+// below 2^-126 flush to zero, and overflows become infinities.
+constexpr f32 RoundBfDotArm(f64 c, f64 residual) {
+  constexpr i32 kShift = NumSignificandBits<f64>() - NumSignificandBits<f32>();
+  c = RoundToOdd(c, residual);
+  if (std::abs(c) < static_cast<f64>(nl<f32>::min()))
+    return std::signbit(c) ? -0.f32 : 0.f32;
+  u64 uc = std::bit_cast<u64>(c);
+  if (uc & ((1ull << kShift) - 1ull))
+    uc = (uc & ~((1ull << kShift) - 1ull)) | (1ull << kShift);
+  c = std::bit_cast<f64>(uc);
+  if (std::abs(c) >= 340282366920938463463374607431768211456.f64)  // 2**128
+    return std::signbit(c) ? -nl<f32>::infinity() : nl<f32>::infinity();
+  return static_cast<f32>(c);
+}
+
+// Arm's BFMul: Inputs are flushed to zero, NaNs become the default NaN.
+constexpr f32 MulBfDotArm(f32 a, f32 b) {
+  f64 c = static_cast<f64>(FlushToZero(a)) * static_cast<f64>(FlushToZero(b));
+  if (IsNan(c))
+    return std::bit_cast<f32>(0x7fc00000u);
+  if (IsInf(c) || IsZero(c))
+    return static_cast<f32>(c);
+  return RoundBfDotArm(c, 0.);  // Products of bf16 values are exact in f64.
+}
+
+// Arm's BFAdd: Like BFMul, but exact zero sums of operands with different signs are always +0.
+constexpr f32 AddBfDotArm(f32 a, f32 b) {
+  const f64 wa = static_cast<f64>(FlushToZero(a));
+  const f64 wb = static_cast<f64>(FlushToZero(b));
+  f64 c = wa + wb;
+  if (IsNan(c))
+    return std::bit_cast<f32>(0x7fc00000u);
+  if (IsInf(c) || IsZero(c))
+    return static_cast<f32>(c);
+  return RoundBfDotArm(c, TwoSum(wa, wb, c));
+}
+
+void FloppyFloat::DotBf16Arm(f32* acc, const bf16* a, const bf16* b, size_t n) {
+  // Without FEAT_EBF16, bfdot ignores FPCR and never raises exceptions.
+  for (size_t i = 0; i < n; ++i) {
+    f32 sum = AddBfDotArm(MulBfDotArm(WidenBF16(a[2 * i]), WidenBF16(b[2 * i])),
+                          MulBfDotArm(WidenBF16(a[2 * i + 1]), WidenBF16(b[2 * i + 1])));
+    acc[i] = AddBfDotArm(acc[i], sum);
+  }
+}
+
+void FloppyFloat::WmaccBf16Riscv(f32* acc, const bf16* a, const bf16* b, size_t n) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return WmaccBf16Riscv<kRoundTiesToEven>(acc, a, b, n);
+  case kRoundTiesToAway:
+    return WmaccBf16Riscv<kRoundTiesToAway>(acc, a, b, n);
+  case kRoundTowardPositive:
+    return WmaccBf16Riscv<kRoundTowardPositive>(acc, a, b, n);
+  case kRoundTowardNegative:
+    return WmaccBf16Riscv<kRoundTowardNegative>(acc, a, b, n);
+  case kRoundTowardZero:
+    return WmaccBf16Riscv<kRoundTowardZero>(acc, a, b, n);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <FloppyFloat::RoundingMode rm>
+void FloppyFloat::WmaccBf16Riscv(f32* acc, const bf16* a, const bf16* b, size_t n) {
+  // vfwmaccbf16 is a widening f32 FMA per element; widening bf16 is exact and keeps signaling NaNs signaling.
+  for (size_t i = 0; i < n; ++i)
+    acc[i] = Fma<f32, rm>(WidenBF16(a[i]), WidenBF16(b[i]), acc[i]);
+}
+
+template void FloppyFloat::WmaccBf16Riscv<FloppyFloat::kRoundTiesToEven>(f32* acc, const bf16* a, const bf16* b, size_t n);
+template void FloppyFloat::WmaccBf16Riscv<FloppyFloat::kRoundTowardPositive>(f32* acc, const bf16* a, const bf16* b, size_t n);
+template void FloppyFloat::WmaccBf16Riscv<FloppyFloat::kRoundTowardNegative>(f32* acc, const bf16* a, const bf16* b, size_t n);
+template void FloppyFloat::WmaccBf16Riscv<FloppyFloat::kRoundTowardZero>(f32* acc, const bf16* a, const bf16* b, size_t n);
+template void FloppyFloat::WmaccBf16Riscv<FloppyFloat::kRoundTiesToAway>(f32* acc, const bf16* a, const bf16* b, size_t n);
@@ -7,8 +7,15 @@
  * Based on: https://www.chciken.com/simulation/2023/11/12/fast-floating-point-simulation.html
  **************************************************************************************************/
 
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
 #include "soft_float.h"
 #include "utils.h"
+
 class FloppyFloat : public SoftFloat {
  public:
   FloppyFloat();
@@ -18,128 +25,435 @@ class FloppyFloat : public SoftFloat {
   template <typename FT>
   constexpr FT GetQnan();
 
-  template <typename FT, RoundingMode rm>
+  // The variants with a static rounding mode serve RISC-V's static rm and AVX-512's embedded rounding. With quiet set,
+  // they leave the flags untouched and skip the work that only detects them (AVX-512 {er}, which implies {sae}). With
+  // flush set, they honor Vfpu::flush_inputs and flush_outputs and raise input_denormal like the variants with a
+  // dynamic rounding mode, which always do.
+  template <typename FT, RoundingMode rm, bool quiet = false, bool flush = false>
   FT Add(FT a, FT b);
   template <typename FT>
   FT Add(FT a, FT b);
 
-  template <typename FT, RoundingMode rm>
+  template <typename FT, RoundingMode rm, bool quiet = false, bool flush = false>
   FT Sub(FT a, FT b);
   template <typename FT>
   FT Sub(FT a, FT b);
 
-  template <typename FT, RoundingMode rm>
+  template <typename FT, RoundingMode rm, bool quiet = false, bool flush = false>
   FT Mul(FT a, FT b);
   template <typename FT>
   FT Mul(FT a, FT b);
 
-  template <typename FT, RoundingMode rm>
+  template <typename FT, RoundingMode rm, bool quiet = false, bool flush = false>
   FT Div(FT a, FT b);
   template <typename FT>
   FT Div(FT a, FT b);
 
-  template <typename FT, RoundingMode rm>
+  template <typename FT, RoundingMode rm, bool quiet = false, bool flush = false>
   FT Sqrt(FT a);
   template <typename FT>
   FT Sqrt(FT a);
 
-  template <typename FT, RoundingMode rm>
+  template <typename FT, RoundingMode rm, bool quiet = false, bool flush = false>
   FT Fma(FT a, FT b, FT c);
   template <typename FT>
   FT Fma(FT a, FT b, FT c);
 
+  // Negated fused multiply-adds with a single rounding: Fms = a * b - c, Fnma = -(a * b) + c, Fnms = -(a * b) - c.
+  // These are RISC-V fmsub/fnmsub/fnmadd, x86 vfmsub/vfnmadd/vfnmsub, and Arm FNMSUB/FMSUB/FNMADD (with the addend
+  // as c). NaN operands are propagated without the negation on x86 (kNanPropX86sse) and negated on Arm. quiet and
+  // flush are as for Fma.
+  template <typename FT, RoundingMode rm, bool quiet = false, bool flush = false>
+  FT Fms(FT a, FT b, FT c);
   template <typename FT>
-  bool EqQuiet(FT a, FT b);
-  template <typename FT>
-  bool LeQuiet(FT a, FT b);
+  FT Fms(FT a, FT b, FT c);
+  template <typename FT, RoundingMode rm, bool quiet = false, bool flush = false>
+  FT Fnma(FT a, FT b, FT c);
   template <typename FT>
-  bool LtQuiet(FT a, FT b);
+  FT Fnma(FT a, FT b, FT c);
+  template <typename FT, RoundingMode rm, bool quiet = false, bool flush = false>
+  FT Fnms(FT a, FT b, FT c);
   template <typename FT>
+  FT Fnms(FT a, FT b, FT c);
+
+  // With quiet set, the compares and the x86 minimum/maximum operations (including MinMaxAvx10) leave the flags
+  // untouched, as AVX-512 {sae} does for vcmpss/vcmpsd, vmaxss/vminss, and vminmaxss.
+  template <typename FT, bool quiet = false>
+  bool EqQuiet(FT a, FT b);
+  template <typename FT, bool quiet = false>
+  bool LeQuiet(FT a, FT b);  // RISC-V Zfa (see "fleq").
+  template <typename FT, bool quiet = false>
+  bool LtQuiet(FT a, FT b);  // RISC-V Zfa (see "fltq").
+  template <typename FT, bool quiet = false>
   bool EqSignaling(FT a, FT b);
-  template <typename FT>
+  template <typename FT, bool quiet = false>
   bool LeSignaling(FT a, FT b);
-  template <typename FT>
+  template <typename FT, bool quiet = false>
   bool LtSignaling(FT a, FT b);
 
-  template <typename FT>
+  template <typename FT, bool quiet = false>
   FT Maxx86(FT a, FT b);  // x86 legacy maximum (see "maxss/maxsd");
-  template <typename FT>
+  template <typename FT, bool quiet = false>
   FT Minx86(FT a, FT b);  // x86 legacy minimum (see "minss/minsd");
+  // See IEEE 754-2019: 9.6 Minimum and maximum operations.
+  template <typename FT>
+  FT Maximum(FT a, FT b);  // RISC-V Zfa (see "fmaxm"), ARM64 FMAX.
+  template <typename FT>
+  FT Minimum(FT a, FT b);  // RISC-V Zfa (see "fminm"), ARM64 FMIN.
   template <typename FT>
   FT MaximumNumber(FT a, FT b);
   template <typename FT>
   FT MinimumNumber(FT a, FT b);
+  template <typename FT>
+  FT MaximumMagnitude(FT a, FT b);
+  template <typename FT>
+  FT MinimumMagnitude(FT a, FT b);
+  template <typename FT>
+  FT MaximumMagnitudeNumber(FT a, FT b);
+  template <typename FT>
+  FT MinimumMagnitudeNumber(FT a, FT b);
+  template <typename FT, bool quiet = false>
+  FT MinMaxAvx10(FT a, FT b, FfUtils::u8 imm8);  // AVX10.2 (see "vminmaxss/vminmaxsd/vminmaxsh").
+
+  enum MinMaxOperation {
+    kMaximum,
+    kMinimum,
+    kMaximumNumber,
+    kMinimumNumber,
+    kMaximumMagnitude,
+    kMinimumMagnitude,
+    kMaximumMagnitudeNumber,
+    kMinimumMagnitudeNumber
+  };
+
+  // Applies a minimum/maximum operation to whole arrays. dst may alias a or b. There is no hand-written SIMD code:
+  // blocks without NaNs go through a branchless scalar integer loop that GCC auto-vectorizes at -O3. With plain SSE2
+  // this pays off only for f32; f64 needs 64-bit integer compares (SSE4.2 or AVX2) to beat the scalar calls.
+  template <typename FT, MinMaxOperation op>
+  void MinMaxBatch(FT* dst, const FT* a, const FT* b, std::size_t n);
+  template <typename FT>
+  void MinMaxBatch(MinMaxOperation op, FT* dst, const FT* a, const FT* b, std::size_t n);
+
+  // See IEEE 754-2019: 5.3.1 roundToIntegral and roundToIntegralExact (exact also raises inexact). Like the arithmetic
+  // operations, the static variants only flush subnormal operands with flush set. Neither x86 nor Arm report DE for
+  // rounding, but Arm raises IDC for operands flushed by FPCR.FZ.
+  template <typename FT, RoundingMode rm, bool exact = false, bool flush = false>
+  FT RoundToIntegral(FT a);  // RISC-V Zfa (see "fround/froundnx"), ARM64 FRINTx.
+  template <typename FT>
+  FT RoundToIntegral(FT a);
+  template <typename FT>
+  FT RoundToIntegralExact(FT a);
+
+  // ARM64 FRINT32Z/FRINT32X/FRINT64Z/FRINT64X: Results outside the range of IT, infinities, and NaNs become the most
+  // negative number of IT and raise invalid.
+  template <typename FT, typename IT, RoundingMode rm, bool flush = false>
+  FT RoundToIntegralBounded(FT a);
+  template <typename FT, typename IT>
+  FT RoundToIntegralBounded(FT a);
+
+  // x86 rounding with imm8 control (see "roundss/roundsd/vrndscalesh"): imm8[1:0] selects the rounding mode, imm8[2]
+  // the dynamic rounding mode instead, and imm8[3] suppresses inexact.
+  template <typename FT>
+  FT Roundx86(FT a, FfUtils::u8 imm8);
+
+  template <typename FT, RoundingMode rm, bool exact = false, bool flush = false>
+  void RoundToIntegralBatch(FT* dst, const FT* a, std::size_t n);
+  template <typename FT>
+  void RoundToIntegralBatch(FT* dst, const FT* a, std::size_t n);
+  template <typename FT>
+  void RoundToIntegralExactBatch(FT* dst, const FT* a, std::size_t n);
+
+  // Arm A64 (see "fmulx"): Like Mul, but 0 * inf is 2 with the sign of the product instead of invalid. As for Mul, the
+  // static variants of this and the following Arm operations only flush subnormals with flush set.
+  template <typename FT, RoundingMode rm, bool flush = false>
+  FT MulxArm(FT a, FT b);
+  template <typename FT>
+  FT MulxArm(FT a, FT b);
+
+  // Arm A64 (see "frecps/frsqrts"): The Newton-Raphson steps 2 - a * b and (3 - a * b) / 2 with a single rounding.
+  // 0 * inf yields 2 and 1.5, respectively, instead of invalid.
+  template <typename FT, RoundingMode rm, bool flush = false>
+  FT RecipStepArm(FT a, FT b);
+  template <typename FT>
+  FT RecipStepArm(FT a, FT b);
+  template <typename FT, RoundingMode rm, bool flush = false>
+  FT RsqrtStepArm(FT a, FT b);
+  template <typename FT>
+  FT RsqrtStepArm(FT a, FT b);
+
+  // Arm A64 (see "fabd"): |a - b| with a single rounding.
+  template <typename FT, RoundingMode rm, bool flush = false>
+  FT AbsDiff(FT a, FT b);
+  template <typename FT>
+  FT AbsDiff(FT a, FT b);
+
+  enum ArmOperation { kMulxArm, kRecipStepArm, kRsqrtStepArm, kAbsDiff };
+
+  // Applies an Arm operation to whole arrays, dispatching the rounding mode once. dst may alias a or b.
+  template <typename FT>
+  void ArmBatch(ArmOperation op, FT* dst, const FT* a, const FT* b, std::size_t n);
+
+  // See IEEE 754-2019: 5.3.1 remainder. a - b * n with n the integer nearest to a / b (ties to even). The result is
+  // always exact, so there is no rounding mode.
+  template <typename FT>
+  FT Remainder(FT a, FT b);
+
+  // x87 partial remainder (see "fprem/fprem1") for f16, f32, and f64: a - b * q with q = a / b rounded toward zero, or
+  // to nearest for FPREM1. quotient receives the three least significant bits of q. If the exponents differ by 64 or
+  // more, a is only partially reduced and incomplete is set, so that the operation must be repeated (see
+  // RemainderOfSignificands).
+  template <typename FT>
+  FT PartialRemainder(FT a, FT b, bool round_to_nearest, FfUtils::u32& quotient, bool& incomplete);
 
   template <typename FT>
   FfUtils::u32 Class(FT a);
 
+  // RISC-V Zfa (see "fli.h/fli.s/fli.d"): Returns one of the 32 constants selected by the rs1 field. Index 1 is the
+  // smallest normal number and index 31 the canonical NaN.
+  template <typename FT>
+  static constexpr FT Fli(FfUtils::u32 index);
+
+  // RISC-V Zfa on RV32 (see "fmvh.x.d/fmvp.d.x") and RV64 with Q (see "fmvh.x.q/fmvp.q.x"): Moves the upper half of a
+  // value to an integer register, or builds a value from two integer registers.
+  static constexpr FfUtils::u32 MoveHigh(FfUtils::f64 a);
+  static constexpr FfUtils::u64 MoveHigh(FfUtils::f128 a);
+  static constexpr FfUtils::f64 MovePairToF64(FfUtils::u32 low, FfUtils::u32 high);
+  static constexpr FfUtils::f128 MovePairToF128(FfUtils::u64 low, FfUtils::u64 high);
+
   FfUtils::f32 F16ToF32(FfUtils::f16 a);
   FfUtils::f64 F16ToF64(FfUtils::f16 a);
+  FfUtils::f32 BF16ToF32(FfUtils::bf16 a);
 
-  template <RoundingMode rm>
+  // The conversions with a static rounding mode between f16, f32, f64, and the integer types take quiet like the
+  // arithmetic operations, which models AVX-512 {er} (e.g., vcvtsd2ss, vcvtss2si, vcvtsi2ss, and their f16 forms).
+  template <RoundingMode rm, bool quiet = false>
+  FfUtils::i32 F16ToI32(FfUtils::f16 a);
+  FfUtils::i32 F16ToI32(FfUtils::f16 a);
+
+  template <RoundingMode rm, bool quiet = false>
+  FfUtils::i64 F16ToI64(FfUtils::f16 a);
+  FfUtils::i64 F16ToI64(FfUtils::f16 a);
+
+  template <RoundingMode rm, bool quiet = false>
+  FfUtils::u32 F16ToU32(FfUtils::f16 a);
+  FfUtils::u32 F16ToU32(FfUtils::f16 a);
+
+  template <RoundingMode rm, bool quiet = false>
+  FfUtils::u64 F16ToU64(FfUtils::f16 a);
+  FfUtils::u64 F16ToU64(FfUtils::f16 a);
+
+  template <RoundingMode rm, bool quiet = false>
   FfUtils::i32 F32ToI32(FfUtils::f32 a);
   FfUtils::i32 F32ToI32(FfUtils::f32 a);
 
-  template <RoundingMode rm>
+  template <RoundingMode rm, bool quiet = false>
   FfUtils::i64 F32ToI64(FfUtils::f32 a);
   FfUtils::i64 F32ToI64(FfUtils::f32 a);
 
-  template <RoundingMode rm>
+  template <RoundingMode rm, bool quiet = false>
   FfUtils::u32 F32ToU32(FfUtils::f32 a);
   FfUtils::u32 F32ToU32(FfUtils::f32 a);
 
-  template <RoundingMode rm>
+  template <RoundingMode rm, bool quiet = false>
   FfUtils::u64 F32ToU64(FfUtils::f32 a);
   FfUtils::u64 F32ToU64(FfUtils::f32 a);
 
-  template <RoundingMode rm>
+  template <RoundingMode rm, bool quiet = false>
   FfUtils::f16 F32ToF16(FfUtils::f32 a);
   FfUtils::f16 F32ToF16(FfUtils::f32 a);
 
+  template <RoundingMode rm>
+  FfUtils::bf16 F32ToBF16(FfUtils::f32 a);
+  FfUtils::bf16 F32ToBF16(FfUtils::f32 a);
+
   FfUtils::f64 F32ToF64(FfUtils::f32 a);
+  FfUtils::f128 F32ToF128(FfUtils::f32 a);
 
-  template <RoundingMode rm>
+  template <RoundingMode rm, bool quiet = false>
   FfUtils::f16 F64ToF16(FfUtils::f64 a);
-  template <RoundingMode rm>
+  FfUtils::f16 F64ToF16(FfUtils::f64 a);
+
+  template <RoundingMode rm, bool quiet = false>
+  FfUtils::f32 F64ToF32(FfUtils::f64 a);
   FfUtils::f32 F64ToF32(FfUtils::f64 a);
 
-  template <RoundingMode rm>
+  template <RoundingMode rm, bool quiet = false>
   FfUtils::i32 F64ToI32(FfUtils::f64 a);
   FfUtils::i32 F64ToI32(FfUtils::f64 a);
 
-  template <RoundingMode rm>
+  // RISC-V Zfa (see "fcvtmod.w.d"): Rounds toward zero and returns the integer modulo 2^32. Results outside the range
+  // of i32 raise invalid instead of inexact, infinities and NaNs become 0.
+  FfUtils::i32 F64ToI32Modular(FfUtils::f64 a);
+  // Arm A64 (see "fjcvtzs"): Like F64ToI32Modular, z is set if the conversion is exact and a is not -0.
+  FfUtils::i32 F64ToI32Js(FfUtils::f64 a, bool& z);
+
+  template <RoundingMode rm, bool quiet = false>
   FfUtils::i64 F64ToI64(FfUtils::f64 a);
   FfUtils::i64 F64ToI64(FfUtils::f64 a);
 
-  template <RoundingMode rm>
+  template <RoundingMode rm, bool quiet = false>
   FfUtils::u32 F64ToU32(FfUtils::f64 a);
   FfUtils::u32 F64ToU32(FfUtils::f64 a);
 
-  template <RoundingMode rm>
+  template <RoundingMode rm, bool quiet = false>
   FfUtils::u64 F64ToU64(FfUtils::f64 a);
   FfUtils::u64 F64ToU64(FfUtils::f64 a);
 
+  FfUtils::f128 F64ToF128(FfUtils::f64 a);
+
+  template <RoundingMode rm>
+  FfUtils::f32 F128ToF32(FfUtils::f128 a);
+  FfUtils::f32 F128ToF32(FfUtils::f128 a);
+
+  template <RoundingMode rm>
+  FfUtils::f64 F128ToF64(FfUtils::f128 a);
+  FfUtils::f64 F128ToF64(FfUtils::f128 a);
+
+  template <RoundingMode rm>
+  FfUtils::i32 F128ToI32(FfUtils::f128 a);
+  FfUtils::i32 F128ToI32(FfUtils::f128 a);
+  template <RoundingMode rm>
+  FfUtils::i64 F128ToI64(FfUtils::f128 a);
+  FfUtils::i64 F128ToI64(FfUtils::f128 a);
+  template <RoundingMode rm>
+  FfUtils::u32 F128ToU32(FfUtils::f128 a);
+  FfUtils::u32 F128ToU32(FfUtils::f128 a);
+  template <RoundingMode rm>
+  FfUtils::u64 F128ToU64(FfUtils::f128 a);
+  FfUtils::u64 F128ToU64(FfUtils::f128 a);
+
+  // Integers always fit into the significand of f128, so the rounding mode does not matter.
+  template <RoundingMode rm>
+  FfUtils::f128 I32ToF128(FfUtils::i32 a);
+  FfUtils::f128 I32ToF128(FfUtils::i32 a);
   template <RoundingMode rm>
+  FfUtils::f128 U32ToF128(FfUtils::u32 a);
+  FfUtils::f128 U32ToF128(FfUtils::u32 a);
+  template <RoundingMode rm>
+  FfUtils::f128 I64ToF128(FfUtils::i64 a);
+  FfUtils::f128 I64ToF128(FfUtils::i64 a);
+  template <RoundingMode rm>
+  FfUtils::f128 U64ToF128(FfUtils::u64 a);
+  FfUtils::f128 U64ToF128(FfUtils::u64 a);
+
+  template <RoundingMode rm, bool quiet = false>
   FfUtils::f16 I32ToF16(FfUtils::i32 a);
   FfUtils::f16 I32ToF16(FfUtils::i32 a);
-  template <RoundingMode rm>
+  template <RoundingMode rm, bool quiet = false>
   FfUtils::f32 I32ToF32(FfUtils::i32 a);
   FfUtils::f32 I32ToF32(FfUtils::i32 a);
   FfUtils::f64 I32ToF64(FfUtils::i32 a);
 
-  template <RoundingMode rm>
+  template <RoundingMode rm, bool quiet = false>
+  FfUtils::f16 U32ToF16(FfUtils::u32 a);
+  FfUtils::f16 U32ToF16(FfUtils::u32 a);
+  template <RoundingMode rm, bool quiet = false>
   FfUtils::f32 U32ToF32(FfUtils::u32 a);
   FfUtils::f32 U32ToF32(FfUtils::u32 a);
   FfUtils::f64 U32ToF64(FfUtils::u32 a);
 
-  template <RoundingMode rm>
+  template <RoundingMode rm, bool quiet = false>
+  FfUtils::f16 I64ToF16(FfUtils::i64 a);
+  FfUtils::f16 I64ToF16(FfUtils::i64 a);
+  template <RoundingMode rm, bool quiet = false>
+  FfUtils::f32 I64ToF32(FfUtils::i64 a);
+  FfUtils::f32 I64ToF32(FfUtils::i64 a);
+  template <RoundingMode rm, bool quiet = false>
+  FfUtils::f64 I64ToF64(FfUtils::i64 a);
+  FfUtils::f64 I64ToF64(FfUtils::i64 a);
+
+  template <RoundingMode rm, bool quiet = false>
+  FfUtils::f16 U64ToF16(FfUtils::u64 a);
+  FfUtils::f16 U64ToF16(FfUtils::u64 a);
+  template <RoundingMode rm, bool quiet = false>
   FfUtils::f32 U64ToF32(FfUtils::u64 a);
   FfUtils::f32 U64ToF32(FfUtils::u64 a);
+  template <RoundingMode rm, bool quiet = false>
+  FfUtils::f64 U64ToF64(FfUtils::u64 a);
+  FfUtils::f64 U64ToF64(FfUtils::u64 a);
+
+  // Fixed-point conversions (see Arm "fcvtzs/fcvtzu/scvtf/ucvtf" with #fbits) for f16, f32, and f64 and i32, i64, u32,
+  // and u64. A fixed-point number with fbits fractional bits (0 to the bits of IT) is the integer a * 2^fbits, so
+  // FToFixed rounds a * 2^fbits to IT and FixedToF rounds a / 2^fbits to FT, each with a single rounding. Results
+  // outside the range of IT are handled as by the integer conversions.
+  template <typename FT, typename IT, RoundingMode rm>
+  IT FToFixed(FT a, FfUtils::u32 fbits);
+  template <typename FT, typename IT>
+  IT FToFixed(FT a, FfUtils::u32 fbits);
+  template <typename FT, typename IT, RoundingMode rm>
+  FT FixedToF(IT a, FfUtils::u32 fbits);
+  template <typename FT, typename IT>
+  FT FixedToF(IT a, FfUtils::u32 fbits);
+
+  // Converts whole arrays, dispatching the rounding mode once. The flags accumulate.
+  template <typename FT, typename IT>
+  void FToFixedBatch(IT* dst, const FT* a, FfUtils::u32 fbits, std::size_t n);
+  template <typename FT, typename IT>
+  void FixedToFBatch(FT* dst, const IT* a, FfUtils::u32 fbits, std::size_t n);
+
+  // bf16 dot products that reproduce the intermediate rounding of the respective instruction. Each f32 lane of acc
+  // accumulates the products of a bf16 pair (x86, Arm) or a single bf16 product (RISC-V) from a and b.
+  void DotBf16x86(FfUtils::f32* acc, const FfUtils::bf16* a, const FfUtils::bf16* b, size_t n);  // See "vdpbf16ps".
+  void DotBf16Arm(FfUtils::f32* acc, const FfUtils::bf16* a, const FfUtils::bf16* b, size_t n);  // See "bfdot".
+  template <RoundingMode rm>
+  void WmaccBf16Riscv(FfUtils::f32* acc, const FfUtils::bf16* a, const FfUtils::bf16* b, size_t n);
+  void WmaccBf16Riscv(FfUtils::f32* acc, const FfUtils::bf16* a, const FfUtils::bf16* b, size_t n);
 
  protected:
   template <typename FT, typename TFT, RoundingMode rm>
   constexpr FT RoundResult(TFT residual, FT result);
 
+  template <typename FT, typename UT, RoundingMode rm>
+  constexpr FT RoundIToFResult(bool sign, UT ua, FT result);
+
+  template <typename TFROM, typename TTO, RoundingMode rm>
+  constexpr TTO RoundNarrowResult(TFROM a, TFROM residual, TTO result);
+
+  template <typename TFROM, typename TTO, RoundingMode rm>
+  TTO FToF(TFROM a);
+
+  template <typename FT>
+  constexpr bool ChecksDenormals();
+  template <typename FT, typename... Args>
+  constexpr bool ChecksDenormals(Args... args);
+  template <bool denormal_flag = true, typename... Args>
+  constexpr void FlushInputs(Args&... args);
+  template <typename FT, typename OP, typename TINY, typename... Args>
+  FT FlushDenormals(OP op, TINY is_tiny, Args... args);
+
+  template <typename FT, RoundingMode rm>
+  constexpr FT RoundF64(FfUtils::f64 a);
+  template <typename FT>
+  constexpr FT InfOrNanF64(FfUtils::f64 c, FT a, FT b);
+
+  template <RoundingMode rm>
+  FfUtils::f128 AddF128(FfUtils::f128 a, FfUtils::f128 b, bool subtract);
+  template <RoundingMode rm>
+  FfUtils::f128 MulF128(FfUtils::f128 a, FfUtils::f128 b);
+  template <RoundingMode rm>
+  FfUtils::f128 DivF128(FfUtils::f128 a, FfUtils::f128 b);
+  template <RoundingMode rm>
+  FfUtils::f128 SqrtF128(FfUtils::f128 a);
+  template <RoundingMode rm>
+  FfUtils::f128 FmaF128(FfUtils::f128 a, FfUtils::f128 b, FfUtils::f128 c);
+  template <typename IT, RoundingMode rm>
+  IT F128ToInt(FfUtils::f128 a);
+
+  template <typename FT, ArmOperation op, RoundingMode rm>
+  void ArmBatch(FT* dst, const FT* a, const FT* b, std::size_t n);
+  template <typename FT, ArmOperation op>
+  void ArmBatch(FT* dst, const FT* a, const FT* b, std::size_t n);
+
+  template <typename FT, typename IT, RoundingMode rm>
+  IT FToI(FT a);
+  template <typename FT, typename IT, RoundingMode rm>
+  FT IToF(IT a);
+
+  template <typename FT, typename IT, RoundingMode rm>
+  void FToFixedBatch(IT* dst, const FT* a, FfUtils::u32 fbits, std::size_t n);
+  template <typename FT, typename IT, RoundingMode rm>
+  void FixedToFBatch(FT* dst, const IT* a, FfUtils::u32 fbits, std::size_t n);
+
   template <typename TFROM, typename TTO>
   constexpr TTO PropagateNan(TFROM a);
 
@@ -157,6 +471,149 @@ class FloppyFloat : public SoftFloat {
   constexpr auto UpSqrt(FT a, FT& b);
   template <typename FT, FloppyFloat::RoundingMode rm>
   constexpr auto UpFma(FT a, FT b, FT c, FT& d);
+};
+
+template <typename FT>
+constexpr FT FloppyFloat::Fli(FfUtils::u32 index) {
+  constexpr FfUtils::f64 kValues[32] = {
+      -1.,     0.,     0x1p-16, 0x1p-15, 0x1p-8, 0x1p-7, 0.0625, 0.125, 0.25,    0.3125,  0.375,
+      0.4375,  0.5,    0.625,   0.75,    0.875,  1.,     1.25,   1.5,   1.75,    2.,      2.5,
+      3.,      4.,     8.,      16.,     128.,   256.,   0x1p15, 0x1p16, 0.,     0.};
+  index &= 31;
+  if (index == 1)
+    return std::numeric_limits<FT>::min();
+  if (index == 30 || (index == 29 && std::numeric_limits<FT>::max_exponent <= 16))  // 2^16 overflows in f16.
+    return std::numeric_limits<FT>::infinity();
+  if (index == 31)
+    return std::numeric_limits<FT>::quiet_NaN();
+  return static_cast<FT>(kValues[index]);
+}
+
+constexpr FfUtils::u32 FloppyFloat::MoveHigh(FfUtils::f64 a) {
+  return static_cast<FfUtils::u32>(std::bit_cast<FfUtils::u64>(a) >> 32);
+}
+
+constexpr FfUtils::u64 FloppyFloat::MoveHigh(FfUtils::f128 a) {
+  return static_cast<FfUtils::u64>(std::bit_cast<FfUtils::u128>(a) >> 64);
+}
+
+constexpr FfUtils::f64 FloppyFloat::MovePairToF64(FfUtils::u32 low, FfUtils::u32 high) {
+  return std::bit_cast<FfUtils::f64>((static_cast<FfUtils::u64>(high) << 32) | low);
+}
+
+constexpr FfUtils::f128 FloppyFloat::MovePairToF128(FfUtils::u64 low, FfUtils::u64 high) {
+  return std::bit_cast<FfUtils::f128>((static_cast<FfUtils::u128>(high) << 64) | low);
+}
+
+// Whether subnormal operands of FT need a look before an operation: either they or the results are flushed to zero,
+// or x86 raises DE for them. Only f16, f32, and f64 have DAZ/FTZ and DE semantics, f128 and bf16 never flush.
+template <typename FT>
+constexpr bool FloppyFloat::ChecksDenormals() {
+  const bool x86 = nan_propagation_scheme == kNanPropX86sse;
+  if constexpr (std::is_same_v<FT, FfUtils::f16>)
+    return flush_inputs_f16 || flush_outputs_f16 || x86;
+  else if constexpr (std::is_same_v<FT, FfUtils::f32> || std::is_same_v<FT, FfUtils::f64>)
+    return flush_inputs || flush_outputs || x86;
+  else
+    return false;
+}
+
+// The same for an operation on args: Without flushed results, only subnormal operands need a look. Testing the
+// operands first (without branches) keeps the x86 default, which reports DE, as fast as the other setups.
+template <typename FT, typename... Args>
+constexpr bool FloppyFloat::ChecksDenormals(Args... args) {
+  const bool flush_results = std::is_same_v<FT, FfUtils::f16> ? flush_outputs_f16 : flush_outputs;
+  return ((FfUtils::IsSubnormal(args) | ...) || flush_results) && ChecksDenormals<FT>();
+}
+
+// Treats subnormal operands as zero with flush_inputs and updates input_denormal. Arm raises IDC for operands flushed
+// by FPCR.FZ, but not by FPCR.FIZ. x86 raises DE for subnormal operands unless DAZ flushes them or a NaN operand takes
+// precedence. The conversions to integers pass denormal_flag = false, as they never raise DE.
+template <bool denormal_flag, typename... Args>
+constexpr void FloppyFloat::FlushInputs(Args&... args) {
+  using FT = std::common_type_t<Args...>;
+  if constexpr (!std::is_same_v<FT, FfUtils::f16> && !std::is_same_v<FT, FfUtils::f32> &&
+                !std::is_same_v<FT, FfUtils::f64>)
+    return;
+  if (!(FfUtils::IsSubnormal(args) || ...)) [[likely]]
+    return;
+  const bool is_f16 = std::is_same_v<FT, FfUtils::f16>;
+  const bool x86 = nan_propagation_scheme == kNanPropX86sse;
+  if (is_f16 ? flush_inputs_f16 : flush_inputs) {
+    input_denormal |= !x86 && (is_f16 ? flush_outputs_f16 : flush_outputs);
+    ((args = FfUtils::FlushToZero(args)), ...);
+  } else if (denormal_flag && x86 && !(FfUtils::IsNan(args) || ...)) {
+    input_denormal = true;
+  }
+}
+
+// Runs op with subnormal operands treated as zero and replaces a tiny result of type FT with zero. Results that is_tiny
+// can tell from the operands alone are flushed without running op, which spares the host from computing subnormals.
+// For all others, op tells tininess itself: it raises underflow for an inexact tiny result, so with the flag cleared
+// beforehand, a raised flag or a subnormal (exact) result is tiny.
+template <typename FT, typename OP, typename TINY, typename... Args>
+FT FloppyFloat::FlushDenormals(OP op, TINY is_tiny, Args... args) {
+  FlushInputs(args...);
+  if (!(std::is_same_v<FT, FfUtils::f16> ? flush_outputs_f16 : flush_outputs))
+    return op(args...);
+
+  const bool x86 = nan_propagation_scheme == kNanPropX86sse;
+  if (is_tiny(args...)) [[unlikely]] {
+    underflow = true;
+    inexact = inexact || x86;
+    const bool sign = (FfUtils::IsNeg(args) != ...);  // The sign of a product or quotient.
+    return sign ? -static_cast<FT>(0.) : static_cast<FT>(0.);
+  }
+
+  const bool prev_underflow = underflow;
+  const bool prev_inexact = inexact;
+  underflow = false;
+  const FT result = op(args...);
+  if (underflow || FfUtils::IsSubnormal(result)) [[unlikely]] {
+    underflow = true;
+    inexact = prev_inexact || x86;  // x86 raises PE for a flushed result, Arm doesn't raise IXC.
+    return std::copysign(static_cast<FT>(0.), result);
+  }
+  underflow = prev_underflow;
+  return result;
+}
+
+// Saves the flags and restores them when leaving the scope, so that the quiet variants of the operations (see
+// FloppyFloat::Add and Avx512) can share the paths that compute the result together with the flags. Empty if quiet is
+// false.
+template <bool quiet>
+class FlagGuard {
+ public:
+  explicit FlagGuard(Vfpu&) {}
+};
 
-  //constexpr FfUtils::f64 PropagateNan(FfUtils::f32 a);
-};
\ No newline at end of file
+template <>
+class FlagGuard<true> {
+ public:
+  explicit FlagGuard(Vfpu& fpu)
+      : fpu_(fpu),
+        invalid_(fpu.invalid),
+        division_by_zero_(fpu.division_by_zero),
+        overflow_(fpu.overflow),
+        underflow_(fpu.underflow),
+        inexact_(fpu.inexact),
+        input_denormal_(fpu.input_denormal) {}
+
+  ~FlagGuard() {
+    fpu_.invalid = invalid_;
+    fpu_.division_by_zero = division_by_zero_;
+    fpu_.overflow = overflow_;
+    fpu_.underflow = underflow_;
+    fpu_.inexact = inexact_;
+    fpu_.input_denormal = input_denormal_;
+  }
+
+ private:
+  Vfpu& fpu_;
+  const bool invalid_;
+  const bool division_by_zero_;
+  const bool overflow_;
+  const bool underflow_;
+  const bool inexact_;
+  const bool input_denormal_;
+};
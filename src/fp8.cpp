@@ -0,0 +1,466 @@
+/**************************************************************************************************
+ * Apache License, Version 2.0
+ * Copyright (c) 2024 chciken/Niko Zurstraßen
+ **************************************************************************************************/
+
+#include "fp8.h"
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "narrow_float.h"
+
+using namespace FfUtils;
+
+namespace {
+
+constexpr u32 kNumRoundingModes = 5;
+constexpr u32 kTableSize = 1u << 16;
+constexpr u32 kNumTables = Fp8::kNumOperations * kNumRoundingModes * 4;
+
+// Image layout of a table: A header of four u32 words (magic, version, key, table size) followed by the entries and
+// one entry of padding, which allows 32-bit gathers of the last entry.
+constexpr u32 kHeaderSize = 8;  // In u16 entries.
+constexpr u32 kMagic = 0x46503854;  // "FP8T"
+constexpr u32 kVersion = 1;
+constexpr std::size_t kImageSize = (kHeaderSize + kTableSize + 1) * sizeof(u16);
+
+// Converts a wider format to FP8. Signaling NaNs raise invalid, all NaNs become the default NaN.
+template <typename FT8, typename FT>
+u32 ConvertToF8(FT a, Vfpu::RoundingMode rm, bool saturate, bool tininess_before_rounding) {
+  if (IsNan(a))
+    return (IsSnan(a) ? kNarrowFlagInvalid : 0) | NarrowFormat<FT8>::kQnan;
+  return RoundToNarrow<FT8>(static_cast<f64>(a), rm, saturate, tininess_before_rounding);
+}
+
+template <typename FT8>
+u32 BinaryEntry(Fp8::Operation op, u8 a, u8 b, Vfpu::RoundingMode rm, bool saturate, bool tininess_before_rounding) {
+  using F = NarrowFormat<FT8>;
+  const f64 fa = NarrowToF64<FT8>(a);
+  const f64 fb = NarrowToF64<FT8>(b);
+  const bool any_nan = std::isnan(fa) || std::isnan(fb);
+  const u32 snan_flag = (IsSnanNarrow<FT8>(a) || IsSnanNarrow<FT8>(b)) ? kNarrowFlagInvalid : 0;
+
+  switch (op) {
+    case Fp8::kAdd:
+    case Fp8::kSub:
+    case Fp8::kMul:
+    case Fp8::kDiv: {
+      if (any_nan)
+        return snan_flag | F::kQnan;
+      f64 result;
+      u32 flags = 0;
+      if (op == Fp8::kAdd) {
+        result = fa + fb;
+      } else if (op == Fp8::kSub) {
+        result = fa - fb;
+      } else if (op == Fp8::kMul) {
+        result = fa * fb;
+      } else {
+        if (fb == 0.0 && fa != 0.0 && !std::isinf(fa))
+          flags = kNarrowFlagDivisionByZero;
+        // Double rounding is innocuous here since f64 has more than 2p + 2 bits of precision.
+        result = fa / fb;
+      }
+      if (std::isnan(result))
+        return kNarrowFlagInvalid | F::kQnan;
+      // Exact zero results of additions with operands of different signs (see IEEE 754-2019, 6.3).
+      if (result == 0.0 && op <= Fp8::kSub && std::signbit(fa) != (std::signbit(fb) ^ (op == Fp8::kSub)))
+        result = rm == Vfpu::kRoundTowardNegative ? -0.0 : 0.0;
+      return flags | RoundToNarrow<FT8>(result, rm, saturate, tininess_before_rounding);
+    }
+    case Fp8::kMaximumNumber:
+    case Fp8::kMinimumNumber: {
+      if (std::isnan(fa) && std::isnan(fb))
+        return snan_flag | F::kQnan;
+      if (std::isnan(fa))
+        return snan_flag | b;
+      if (std::isnan(fb))
+        return snan_flag | a;
+      const bool a_first = (op == Fp8::kMaximumNumber) ? (fa > fb || (fa == fb && !std::signbit(fa)))
+                                                       : (fa < fb || (fa == fb && std::signbit(fa)));
+      return a_first ? a : b;
+    }
+    case Fp8::kEqQuiet:
+      return snan_flag | (fa == fb);
+    case Fp8::kLeQuiet:
+      return snan_flag | (fa <= fb);
+    case Fp8::kLtQuiet:
+      return snan_flag | (fa < fb);
+    case Fp8::kLeSignaling:
+      return (any_nan ? kNarrowFlagInvalid : 0) | (fa <= fb);
+    case Fp8::kLtSignaling:
+      return (any_nan ? kNarrowFlagInvalid : 0) | (fa < fb);
+    default:
+      return 0;
+  }
+}
+
+constexpr bool DependsOnRounding(Fp8::Operation op) {
+  return op <= Fp8::kDiv || op >= Fp8::kF16ToF8;
+}
+
+u32 TableIndex(Fp8::Operation op, Vfpu::RoundingMode rm, bool saturate, bool tininess_before_rounding) {
+  if (!DependsOnRounding(op)) {
+    rm = Vfpu::kRoundTiesToEven;
+    saturate = false;
+    tininess_before_rounding = false;
+  }
+  return ((static_cast<u32>(op) * kNumRoundingModes + static_cast<u32>(rm)) * 2 + saturate) * 2 +
+         tininess_before_rounding;
+}
+
+// Identifies format and configuration of a table in the image header.
+template <typename FT8>
+constexpr std::array<u32, 4> ImageHeader(u32 index) {
+  return {kMagic, kVersion, index << 1 | std::is_same_v<FT8, e5m2>, kTableSize};
+}
+
+template <typename FT8>
+std::unique_ptr<u16[]> GenerateImage(Fp8::Operation op, Vfpu::RoundingMode rm, bool saturate,
+                                     bool tininess_before_rounding) {
+  auto image = std::make_unique<u16[]>(kImageSize / sizeof(u16));
+  const std::array<u32, 4> header = ImageHeader<FT8>(TableIndex(op, rm, saturate, tininess_before_rounding));
+  std::memcpy(image.get(), header.data(), sizeof(header));
+  u16* table = image.get() + kHeaderSize;
+  for (u32 i = 0; i < kTableSize; ++i) {
+    u32 entry;
+    if (op == Fp8::kF16ToF8)
+      entry = ConvertToF8<FT8>(std::bit_cast<f16>(static_cast<u16>(i)), rm, saturate, tininess_before_rounding);
+    else if (op == Fp8::kBF16ToF8)
+      entry = ConvertToF8<FT8>(std::bit_cast<bf16>(static_cast<u16>(i)), rm, saturate, tininess_before_rounding);
+    else
+      entry = BinaryEntry<FT8>(op, static_cast<u8>(i >> 8), static_cast<u8>(i), rm, saturate,
+                               tininess_before_rounding);
+    table[i] = static_cast<u16>(entry);
+  }
+  table[kTableSize] = 0;
+  return image;
+}
+
+template <typename FT8>
+std::once_flag& ImageOnce(u32 index) {
+  static std::array<std::once_flag, kNumTables> once;
+  return once[index];
+}
+
+template <typename FT8>
+const u16*& Image(u32 index) {
+  static std::array<const u16*, kNumTables> images{};
+  return images[index];
+}
+
+template <typename FT8>
+const u16* GetImage(Fp8::Operation op, Vfpu::RoundingMode rm, bool saturate, bool tininess_before_rounding) {
+  const u32 index = TableIndex(op, rm, saturate, tininess_before_rounding);
+  std::call_once(ImageOnce<FT8>(index), [&] {
+    Image<FT8>(index) = GenerateImage<FT8>(op, rm, saturate, tininess_before_rounding).release();
+  });
+  return Image<FT8>(index);
+}
+
+template <typename FT8>
+const u16* GetTable(Fp8::Operation op, Vfpu::RoundingMode rm, bool saturate, bool tininess_before_rounding) {
+  return GetImage<FT8>(op, rm, saturate, tininess_before_rounding) + kHeaderSize;
+}
+
+template <typename FT8>
+const std::array<f32, 256>& F8ToF32Table() {
+  static const std::array<f32, 256> table = [] {
+    std::array<f32, 256> result;
+    for (u32 i = 0; i < 256; ++i) {
+      if (IsNanNarrow<FT8>(static_cast<u8>(i))) {
+        // Keep sign and payload, and quiet signaling NaNs.
+        const u32 payload = (i & ((1u << NarrowFormat<FT8>::kManBits) - 1)) << (23 - NarrowFormat<FT8>::kManBits);
+        result[i] = std::bit_cast<f32>(((i >> 7) << 31) | 0x7fc00000u | payload);
+      } else {
+        result[i] = static_cast<f32>(NarrowToF64<FT8>(static_cast<u8>(i)));
+      }
+    }
+    return result;
+  }();
+  return table;
+}
+
+}  // namespace
+
+Fp8::Fp8() : Vfpu() {}
+
+void Fp8::RaiseFlags(u32 flags) {
+  RaiseNarrowFlags(*this, flags);
+}
+
+template <typename FT8>
+const u16* Fp8::Table(Operation op, RoundingMode rm) {
+  return GetTable<FT8>(op, rm, saturate, tininess_before_rounding);
+}
+
+template <typename FT8>
+const u16* Fp8::Table(Operation op) {
+  return GetTable<FT8>(op, rounding_mode, saturate, tininess_before_rounding);
+}
+
+template <typename FT8>
+bool Fp8::SaveImage(Operation op, RoundingMode rm, const std::string& path) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char*>(GetImage<FT8>(op, rm, saturate, tininess_before_rounding)), kImageSize);
+  return static_cast<bool>(file);
+}
+
+template <typename FT8>
+bool Fp8::MapImage(Operation op, RoundingMode rm, const std::string& path) {
+#if defined(__unix__) || defined(__APPLE__)
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat st;
+  void* mapped = MAP_FAILED;
+  if (fstat(fd, &st) == 0 && static_cast<std::size_t>(st.st_size) == kImageSize)
+    mapped = mmap(nullptr, kImageSize, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapped == MAP_FAILED)
+    return false;
+
+  const u32 index = TableIndex(op, rm, saturate, tininess_before_rounding);
+  std::array<u32, 4> header;
+  std::memcpy(header.data(), mapped, sizeof(header));
+  bool used = false;
+  if (header == ImageHeader<FT8>(index)) {
+    std::call_once(ImageOnce<FT8>(index), [&] {
+      Image<FT8>(index) = static_cast<const u16*>(mapped);
+      used = true;
+    });
+  }
+  if (!used)
+    munmap(mapped, kImageSize);
+  return used;
+#else
+  (void)op;
+  (void)rm;
+  (void)path;
+  return false;
+#endif
+}
+
+template <typename FT8>
+u16 Fp8::Lookup(Operation op, RoundingMode rm, u32 index) {
+  const u16 entry = Table<FT8>(op, rm)[index];
+  if (entry >> 8)
+    RaiseFlags(entry);
+  return entry;
+}
+
+#define FP8_BINARY_OP(name, op)                                                     \
+  template <typename FT8, Vfpu::RoundingMode rm>                                    \
+  FT8 Fp8::name(FT8 a, FT8 b) {                                                     \
+    return FT8{static_cast<u8>(Lookup<FT8>(op, rm, (a.v << 8) | b.v))};             \
+  }                                                                                 \
+                                                                                    \
+  template <typename FT8>                                                           \
+  FT8 Fp8::name(FT8 a, FT8 b) {                                                     \
+    return FT8{static_cast<u8>(Lookup<FT8>(op, rounding_mode, (a.v << 8) | b.v))};  \
+  }
+
+FP8_BINARY_OP(Add, kAdd)
+FP8_BINARY_OP(Sub, kSub)
+FP8_BINARY_OP(Mul, kMul)
+FP8_BINARY_OP(Div, kDiv)
+
+template <typename FT8>
+FT8 Fp8::MaximumNumber(FT8 a, FT8 b) {
+  return FT8{static_cast<u8>(Lookup<FT8>(kMaximumNumber, rounding_mode, (a.v << 8) | b.v))};
+}
+
+template <typename FT8>
+FT8 Fp8::MinimumNumber(FT8 a, FT8 b) {
+  return FT8{static_cast<u8>(Lookup<FT8>(kMinimumNumber, rounding_mode, (a.v << 8) | b.v))};
+}
+
+#define FP8_COMPARE_OP(name, op)                                           \
+  template <typename FT8>                                                  \
+  bool Fp8::name(FT8 a, FT8 b) {                                           \
+    return Lookup<FT8>(op, rounding_mode, (a.v << 8) | b.v) & 1;           \
+  }
+
+FP8_COMPARE_OP(EqQuiet, kEqQuiet)
+FP8_COMPARE_OP(LeQuiet, kLeQuiet)
+FP8_COMPARE_OP(LtQuiet, kLtQuiet)
+FP8_COMPARE_OP(LeSignaling, kLeSignaling)
+FP8_COMPARE_OP(LtSignaling, kLtSignaling)
+
+template <typename FT8, Vfpu::RoundingMode rm>
+FT8 Fp8::F16ToF8(f16 a) {
+  return FT8{static_cast<u8>(Lookup<FT8>(kF16ToF8, rm, std::bit_cast<u16>(a)))};
+}
+
+template <typename FT8>
+FT8 Fp8::F16ToF8(f16 a) {
+  return FT8{static_cast<u8>(Lookup<FT8>(kF16ToF8, rounding_mode, std::bit_cast<u16>(a)))};
+}
+
+template <typename FT8, Vfpu::RoundingMode rm>
+FT8 Fp8::BF16ToF8(bf16 a) {
+  return FT8{static_cast<u8>(Lookup<FT8>(kBF16ToF8, rm, std::bit_cast<u16>(a)))};
+}
+
+template <typename FT8>
+FT8 Fp8::BF16ToF8(bf16 a) {
+  return FT8{static_cast<u8>(Lookup<FT8>(kBF16ToF8, rounding_mode, std::bit_cast<u16>(a)))};
+}
+
+template <typename FT8, Vfpu::RoundingMode rm>
+FT8 Fp8::F32ToF8(f32 a) {
+  // A table for all f32 encodings would be too large, so f32 is rounded directly.
+  const u32 entry = ConvertToF8<FT8>(a, rm, saturate, tininess_before_rounding);
+  RaiseFlags(entry);
+  return FT8{static_cast<u8>(entry)};
+}
+
+template <typename FT8>
+FT8 Fp8::F32ToF8(f32 a) {
+  const u32 entry = ConvertToF8<FT8>(a, rounding_mode, saturate, tininess_before_rounding);
+  RaiseFlags(entry);
+  return FT8{static_cast<u8>(entry)};
+}
+
+template <typename FT8>
+f32 Fp8::F8ToF32(FT8 a) {
+  invalid |= IsSnanNarrow<FT8>(a.v);
+  return F8ToF32Table<FT8>()[a.v];
+}
+
+template <typename FT8>
+f16 Fp8::F8ToF16(FT8 a) {
+  const f32 result = F8ToF32(a);
+  if (IsNan(result)) {
+    const u32 bits = std::bit_cast<u32>(result);
+    return std::bit_cast<f16>(static_cast<u16>(((bits >> 16) & 0x8000u) | ((bits >> 13) & 0x7fffu)));
+  }
+  return static_cast<f16>(result);
+}
+
+template <typename FT8>
+bf16 Fp8::F8ToBF16(FT8 a) {
+  // FP8 significands have at most 3 bits, so the upper half of the f32 is exact.
+  return std::bit_cast<bf16>(static_cast<u16>(std::bit_cast<u32>(F8ToF32(a)) >> 16));
+}
+
+template <typename FT8>
+void Fp8::Batch(Operation op, u8* dst, const FT8* a, const FT8* b, std::size_t n) {
+  static_assert(sizeof(FT8) == 1);
+  const u16* table = Table<FT8>(op);
+  u32 flags = 0;
+  std::size_t i = 0;
+#if defined(__AVX2__)
+  // Eight lanes per iteration: Each 32-bit gather fetches the entry (and its successor, which is masked out).
+  const __m256i kPickLowBytes =
+      _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 4, 8, 12, -1, -1, -1, -1, -1, -1,
+                       -1, -1, -1, -1, -1, -1);
+  __m256i acc = _mm256_setzero_si256();
+  for (; i + 8 <= n; i += 8) {
+    const __m256i va = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(a + i)));
+    const __m256i vb = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(b + i)));
+    const __m256i index = _mm256_or_si256(_mm256_slli_epi32(va, 8), vb);
+    const __m256i entries = _mm256_i32gather_epi32(reinterpret_cast<const int*>(table), index, 2);
+    acc = _mm256_or_si256(acc, entries);
+    const __m256i bytes = _mm256_shuffle_epi8(entries, kPickLowBytes);
+    const u32 lo = static_cast<u32>(_mm256_extract_epi32(bytes, 0));
+    const u32 hi = static_cast<u32>(_mm256_extract_epi32(bytes, 4));
+    std::memcpy(dst + i, &lo, 4);
+    std::memcpy(dst + i + 4, &hi, 4);
+  }
+  alignas(32) u32 lanes[8];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+  for (u32 lane : lanes)
+    flags |= lane & 0xff00u;
+#endif
+  for (; i < n; ++i) {
+    const u16 entry = table[(a[i].v << 8) | b[i].v];
+    dst[i] = static_cast<u8>(entry);
+    flags |= entry;
+  }
+  RaiseFlags(flags);
+}
+
+template <typename FT8>
+void Fp8::F8ToF32(f32* dst, const FT8* a, std::size_t n) {
+  static_assert(sizeof(FT8) == 1);
+  const f32* table = F8ToF32Table<FT8>().data();
+  bool snan = false;
+  std::size_t i = 0;
+#if defined(__AVX2__)
+  __m256i snan_acc = _mm256_setzero_si256();
+  for (; i + 8 <= n; i += 8) {
+    const __m256i index = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(a + i)));
+    _mm256_storeu_ps(dst + i, _mm256_i32gather_ps(table, index, 4));
+    if constexpr (NarrowFormat<FT8>::kHasInf) {
+      const __m256i magnitude = _mm256_and_si256(index, _mm256_set1_epi32(0x7f));
+      snan_acc = _mm256_or_si256(snan_acc, _mm256_cmpeq_epi32(magnitude, _mm256_set1_epi32(0x7d)));
+    }
+  }
+  snan = !_mm256_testz_si256(snan_acc, snan_acc);
+#endif
+  for (; i < n; ++i) {
+    snan |= IsSnanNarrow<FT8>(a[i].v);
+    dst[i] = table[a[i].v];
+  }
+  invalid |= snan;
+}
+
+#define FP8_INSTANTIATE_RM(FT8, rm)                   \
+  template FT8 Fp8::Add<FT8, Vfpu::rm>(FT8, FT8);     \
+  template FT8 Fp8::Sub<FT8, Vfpu::rm>(FT8, FT8);     \
+  template FT8 Fp8::Mul<FT8, Vfpu::rm>(FT8, FT8);     \
+  template FT8 Fp8::Div<FT8, Vfpu::rm>(FT8, FT8);     \
+  template FT8 Fp8::F16ToF8<FT8, Vfpu::rm>(f16);      \
+  template FT8 Fp8::BF16ToF8<FT8, Vfpu::rm>(bf16);    \
+  template FT8 Fp8::F32ToF8<FT8, Vfpu::rm>(f32);
+
+#define FP8_INSTANTIATE(FT8)                                                            \
+  FP8_INSTANTIATE_RM(FT8, kRoundTiesToEven)                                             \
+  FP8_INSTANTIATE_RM(FT8, kRoundTowardPositive)                                         \
+  FP8_INSTANTIATE_RM(FT8, kRoundTowardNegative)                                         \
+  FP8_INSTANTIATE_RM(FT8, kRoundTowardZero)                                             \
+  FP8_INSTANTIATE_RM(FT8, kRoundTiesToAway)                                             \
+  template FT8 Fp8::Add<FT8>(FT8, FT8);                                                 \
+  template FT8 Fp8::Sub<FT8>(FT8, FT8);                                                 \
+  template FT8 Fp8::Mul<FT8>(FT8, FT8);                                                 \
+  template FT8 Fp8::Div<FT8>(FT8, FT8);                                                 \
+  template FT8 Fp8::MaximumNumber<FT8>(FT8, FT8);                                       \
+  template FT8 Fp8::MinimumNumber<FT8>(FT8, FT8);                                       \
+  template bool Fp8::EqQuiet<FT8>(FT8, FT8);                                            \
+  template bool Fp8::LeQuiet<FT8>(FT8, FT8);                                            \
+  template bool Fp8::LtQuiet<FT8>(FT8, FT8);                                            \
+  template bool Fp8::LeSignaling<FT8>(FT8, FT8);                                        \
+  template bool Fp8::LtSignaling<FT8>(FT8, FT8);                                        \
+  template FT8 Fp8::F16ToF8<FT8>(f16);                                                  \
+  template FT8 Fp8::BF16ToF8<FT8>(bf16);                                                \
+  template FT8 Fp8::F32ToF8<FT8>(f32);                                                  \
+  template f16 Fp8::F8ToF16<FT8>(FT8);                                                  \
+  template bf16 Fp8::F8ToBF16<FT8>(FT8);                                                \
+  template f32 Fp8::F8ToF32<FT8>(FT8);                                                  \
+  template void Fp8::Batch<FT8>(Operation, u8*, const FT8*, const FT8*, std::size_t);   \
+  template void Fp8::F8ToF32<FT8>(f32*, const FT8*, std::size_t);                       \
+  template const u16* Fp8::Table<FT8>(Operation);                                       \
+  template const u16* Fp8::Table<FT8>(Operation, RoundingMode);                         \
+  template bool Fp8::SaveImage<FT8>(Operation, RoundingMode, const std::string&);       \
+  template bool Fp8::MapImage<FT8>(Operation, RoundingMode, const std::string&);
+
+FP8_INSTANTIATE(e4m3)
+FP8_INSTANTIATE(e5m2)
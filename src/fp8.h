@@ -0,0 +1,130 @@
+#pragma once
+/**************************************************************************************************
+ * Apache License, Version 2.0
+ * Copyright (c) 2024 chciken/Niko Zurstraßen
+ **************************************************************************************************/
+
+#include <cstddef>
+#include <string>
+
+#include "utils.h"
+#include "vfpu.h"
+
+// Simulates the OCP 8-bit floating point formats E4M3 and E5M2. With only 256 encodings per operand, every binary
+// operation is a single lookup into a table of 65536 entries, which is generated on first use for the current
+// configuration (rounding mode, saturation, tininess detection) and then shared by all instances.
+class Fp8 : public Vfpu {
+ public:
+  // OCP saturation mode: Overflows and infinities become the largest finite number of the same sign. Otherwise, they
+  // become infinity (E5M2) or NaN (E4M3). Rounding toward zero always saturates overflows.
+  bool saturate = false;
+
+  enum Operation {
+    kAdd,
+    kSub,
+    kMul,
+    kDiv,
+    kMaximumNumber,
+    kMinimumNumber,
+    kEqQuiet,
+    kLeQuiet,
+    kLtQuiet,
+    kLeSignaling,
+    kLtSignaling,
+    kF16ToF8,   // Unary, indexed by the f16 encoding.
+    kBF16ToF8,  // Unary, indexed by the bf16 encoding.
+    kNumOperations
+  };
+
+  Fp8();
+
+  template <typename FT8, RoundingMode rm>
+  FT8 Add(FT8 a, FT8 b);
+  template <typename FT8>
+  FT8 Add(FT8 a, FT8 b);
+
+  template <typename FT8, RoundingMode rm>
+  FT8 Sub(FT8 a, FT8 b);
+  template <typename FT8>
+  FT8 Sub(FT8 a, FT8 b);
+
+  template <typename FT8, RoundingMode rm>
+  FT8 Mul(FT8 a, FT8 b);
+  template <typename FT8>
+  FT8 Mul(FT8 a, FT8 b);
+
+  template <typename FT8, RoundingMode rm>
+  FT8 Div(FT8 a, FT8 b);
+  template <typename FT8>
+  FT8 Div(FT8 a, FT8 b);
+
+  // See IEEE 754-2019: 9.6 Minimum and maximum operations.
+  template <typename FT8>
+  FT8 MaximumNumber(FT8 a, FT8 b);
+  template <typename FT8>
+  FT8 MinimumNumber(FT8 a, FT8 b);
+
+  template <typename FT8>
+  bool EqQuiet(FT8 a, FT8 b);
+  template <typename FT8>
+  bool LeQuiet(FT8 a, FT8 b);
+  template <typename FT8>
+  bool LtQuiet(FT8 a, FT8 b);
+  template <typename FT8>
+  bool LeSignaling(FT8 a, FT8 b);
+  template <typename FT8>
+  bool LtSignaling(FT8 a, FT8 b);
+
+  template <typename FT8, RoundingMode rm>
+  FT8 F16ToF8(FfUtils::f16 a);
+  template <typename FT8>
+  FT8 F16ToF8(FfUtils::f16 a);
+
+  template <typename FT8, RoundingMode rm>
+  FT8 BF16ToF8(FfUtils::bf16 a);
+  template <typename FT8>
+  FT8 BF16ToF8(FfUtils::bf16 a);
+
+  template <typename FT8, RoundingMode rm>
+  FT8 F32ToF8(FfUtils::f32 a);
+  template <typename FT8>
+  FT8 F32ToF8(FfUtils::f32 a);
+
+  // Widening conversions are exact. Only signaling NaNs (E5M2) raise invalid.
+  template <typename FT8>
+  FfUtils::f16 F8ToF16(FT8 a);
+  template <typename FT8>
+  FfUtils::bf16 F8ToBF16(FT8 a);
+  template <typename FT8>
+  FfUtils::f32 F8ToF32(FT8 a);
+
+  // Batch versions with the dynamic rounding mode. The flags accumulate over all n elements. Binary operations write
+  // the result encodings to dst, comparisons write 0 or 1.
+  template <typename FT8>
+  void Batch(Operation op, FfUtils::u8* dst, const FT8* a, const FT8* b, std::size_t n);
+  template <typename FT8>
+  void F8ToF32(FfUtils::f32* dst, const FT8* a, std::size_t n);
+
+  // Returns the table of op for the current configuration. Entry (a << 8) | b (or the 16-bit source encoding for
+  // conversions) holds the result in the low byte and the flags in the high byte: invalid (bit 8), division by zero
+  // (bit 9), overflow (bit 10), underflow (bit 11), inexact (bit 12). Tables are position independent and can be
+  // saved to and mapped from a file (see SaveImage).
+  template <typename FT8>
+  const FfUtils::u16* Table(Operation op);
+  template <typename FT8>
+  const FfUtils::u16* Table(Operation op, RoundingMode rm);
+
+  // Writes the image of the table of op for rm and the current configuration (about 128 KiB) to path.
+  template <typename FT8>
+  bool SaveImage(Operation op, RoundingMode rm, const std::string& path);
+  // Maps an image written by SaveImage read-only, so that all simulator processes share the same physical pages. The
+  // image must match op, rm, and the current configuration, and only takes effect before the table is first used.
+  // Returns false if the image is not used.
+  template <typename FT8>
+  bool MapImage(Operation op, RoundingMode rm, const std::string& path);
+
+ protected:
+  template <typename FT8>
+  FfUtils::u16 Lookup(Operation op, RoundingMode rm, FfUtils::u32 index);
+  void RaiseFlags(FfUtils::u32 flags);
+};
@@ -0,0 +1,744 @@
+#pragma once
+/**************************************************************************************************
+ * Apache License, Version 2.0
+ * Copyright (c) 2024 chciken/Niko Zurstraßen
+ **************************************************************************************************/
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "utils.h"
+#include "vfpu.h"
+
+// Arithmetic for the generic formats Ieee<E, M>. Every operation has an integer implementation in the spirit of
+// SoftFloat, which works for any width. Formats with E <= 9 and M <= 25 (e.g., TF32, E3M2, or 24-bit DSP formats) also
+// take a FloppyFloat-style fast path: The operation is computed in f64, where products are exact and residuals of the
+// other operations are exact, turned into round-to-odd, and rounded once to the target format. Since the formats are
+// open-ended, the definitions live in this header.
+class IeeeFloat : public Vfpu {
+ public:
+  // If false, all operations use the integer implementation, e.g., to cross-check the fast path.
+  bool fast_path = true;
+
+  IeeeFloat() : Vfpu() {}
+
+  template <typename FT>
+  static constexpr bool HasFastPath() {
+    return FT::kExpBits <= 9 && FT::kManBits <= 25;
+  }
+
+  template <typename FT, RoundingMode rm>
+  FT Add(FT a, FT b);
+  template <typename FT>
+  FT Add(FT a, FT b);
+
+  template <typename FT, RoundingMode rm>
+  FT Sub(FT a, FT b);
+  template <typename FT>
+  FT Sub(FT a, FT b);
+
+  template <typename FT, RoundingMode rm>
+  FT Mul(FT a, FT b);
+  template <typename FT>
+  FT Mul(FT a, FT b);
+
+  template <typename FT, RoundingMode rm>
+  FT Div(FT a, FT b);
+  template <typename FT>
+  FT Div(FT a, FT b);
+
+  template <typename FT, RoundingMode rm>
+  FT Sqrt(FT a);
+  template <typename FT>
+  FT Sqrt(FT a);
+
+  template <typename FT, RoundingMode rm>
+  FT Fma(FT a, FT b, FT c);
+  template <typename FT>
+  FT Fma(FT a, FT b, FT c);
+
+  template <typename FT, RoundingMode rm>
+  FT F64ToIeee(FfUtils::f64 a);
+  template <typename FT>
+  FT F64ToIeee(FfUtils::f64 a);
+
+  // Exact for formats with E <= 11 and M <= 52. Wider formats are rounded to nearest.
+  template <typename FT>
+  FfUtils::f64 IeeeToF64(FT a);
+
+ protected:
+  template <typename FT>
+  static constexpr typename FT::UT SignBit() {
+    return static_cast<typename FT::UT>(1) << (FT::kExpBits + FT::kManBits);
+  }
+  template <typename FT>
+  static constexpr typename FT::UT InfBits() {
+    return static_cast<typename FT::UT>((1ull << FT::kExpBits) - 1) << FT::kManBits;
+  }
+  template <typename FT>
+  static constexpr typename FT::UT QuietBit() {
+    return static_cast<typename FT::UT>(1) << (FT::kManBits - 1);
+  }
+  template <typename FT>
+  static constexpr FfUtils::i32 Emin() {
+    return 1 - FT::kBias;
+  }
+
+  template <typename FT>
+  static constexpr bool Sign(FT a) {
+    return a.v & SignBit<FT>();
+  }
+  template <typename FT>
+  static constexpr typename FT::UT Magnitude(FT a) {
+    return a.v & (SignBit<FT>() - 1);
+  }
+  template <typename FT>
+  static constexpr bool IsNan(FT a) {
+    return Magnitude(a) > InfBits<FT>();
+  }
+  template <typename FT>
+  static constexpr bool IsSnan(FT a) {
+    return IsNan(a) && !(a.v & QuietBit<FT>());
+  }
+  template <typename FT>
+  static constexpr bool IsInf(FT a) {
+    return Magnitude(a) == InfBits<FT>();
+  }
+  template <typename FT>
+  static constexpr bool IsZero(FT a) {
+    return Magnitude(a) == 0;
+  }
+  template <typename FT>
+  static constexpr FT Pack(bool sign, typename FT::UT magnitude) {
+    return FT{static_cast<typename FT::UT>((sign ? SignBit<FT>() : 0) | magnitude)};
+  }
+
+  // Splits a finite a into a = (-1)^sign * sig * 2^exp.
+  template <typename FT>
+  static constexpr void Unpack(FT a, bool& sign, FfUtils::i32& exp, FfUtils::u64& sig);
+  template <typename FT>
+  static FfUtils::f64 ToF64Fast(FT a);
+
+  template <typename FT>
+  FT DefaultNan();
+  template <typename FT>
+  FT PropagateNan(FT a, FT b);
+  template <typename FT>
+  FT PropagateNan(FT a, FT b, FT c);
+
+  // Rounds (-1)^sign * sig * 2^exp (sig != 0) to FT and raises the flags. Bits below the rounding position may be
+  // jammed into bit 0 of sig.
+  template <typename FT, RoundingMode rm>
+  FT RoundPack(bool sign, FfUtils::i32 exp, FfUtils::u128 sig);
+  // Rounds the round-to-odd f64 value a to FT. Common cases never leave the integer pipeline.
+  template <typename FT, RoundingMode rm>
+  FT RoundF64(FfUtils::f64 a);
+  template <typename FT, RoundingMode rm>
+  FT AddExact(bool a_sign, FfUtils::i32 a_exp, FfUtils::u128 a_sig, bool b_sign, FfUtils::i32 b_exp,
+              FfUtils::u128 b_sig);
+  template <typename FT, RoundingMode rm>
+  FT ExactZeroSum(bool a_sign, bool b_sign);
+
+  template <typename FT, RoundingMode rm>
+  FT SoftAdd(FT a, FT b);
+  template <typename FT, RoundingMode rm>
+  FT SoftMul(FT a, FT b);
+  template <typename FT, RoundingMode rm>
+  FT SoftDiv(FT a, FT b);
+  template <typename FT, RoundingMode rm>
+  FT SoftSqrt(FT a);
+  template <typename FT, RoundingMode rm>
+  FT SoftFma(FT a, FT b, FT c);
+};
+
+namespace IeeeFloatInternal {
+
+// Turns the f64 result c with residual c - exact into its round-to-odd counterpart (see RoundToOdd of FloppyFloat).
+constexpr FfUtils::f64 RoundToOdd(FfUtils::f64 c, FfUtils::f64 residual) {
+  FfUtils::u64 uc = std::bit_cast<FfUtils::u64>(c);
+  if (residual != 0. && !(uc & 1ull)) {
+    if (std::signbit(residual) == std::signbit(c))
+      uc -= 1ull;
+    else
+      uc += 1ull;
+  }
+  return std::bit_cast<FfUtils::f64>(uc);
+}
+
+// Residual c - (a + b) of the f64 sum c = a + b (2Sum).
+constexpr FfUtils::f64 SumResidual(FfUtils::f64 a, FfUtils::f64 b, FfUtils::f64 c) {
+  const FfUtils::f64 ad = c - b;
+  const FfUtils::f64 bd = c - ad;
+  return (ad - a) + (bd - b);
+}
+
+constexpr FfUtils::i32 Msb(FfUtils::u128 a) {
+  return 127 - std::countl_zero(a);
+}
+
+// Shifts right and jams the shifted out bits into bit 0.
+constexpr FfUtils::u128 ShiftRightJam(FfUtils::u128 a, FfUtils::i32 d) {
+  if (d <= 0)
+    return a;
+  if (d >= 128)
+    return a != 0;
+  return (a >> d) | ((a & ((static_cast<FfUtils::u128>(1) << d) - 1)) != 0);
+}
+
+// Digit-by-digit square root. Returns floor(sqrt(a)) and whether the remainder is non-zero.
+constexpr FfUtils::u128 Isqrt(FfUtils::u128 a, bool& inexact) {
+  FfUtils::u128 root = 0;
+  FfUtils::u128 rem = 0;
+  for (int i = 63; i >= 0; --i) {
+    rem = (rem << 2) | ((a >> (2 * i)) & 3);
+    const FfUtils::u128 trial = (root << 2) | 1;
+    root <<= 1;
+    if (rem >= trial) {
+      rem -= trial;
+      root |= 1;
+    }
+  }
+  inexact = rem != 0;
+  return root;
+}
+
+}  // namespace IeeeFloatInternal
+
+template <typename FT>
+constexpr void IeeeFloat::Unpack(FT a, bool& sign, FfUtils::i32& exp, FfUtils::u64& sig) {
+  const FfUtils::u64 mag = Magnitude(a);
+  const FfUtils::i32 biased = static_cast<FfUtils::i32>(mag >> FT::kManBits);
+  sign = Sign(a);
+  sig = mag & ((1ull << FT::kManBits) - 1);
+  if (biased == 0) {
+    exp = Emin<FT>() - FT::kManBits;
+  } else {
+    exp = biased - FT::kBias - FT::kManBits;
+    sig |= 1ull << FT::kManBits;
+  }
+}
+
+// Exact for finite inputs of formats with a fast path.
+template <typename FT>
+FfUtils::f64 IeeeFloat::ToF64Fast(FT a) {
+  constexpr FfUtils::f64 kSubnormalScale =
+      std::bit_cast<FfUtils::f64>(static_cast<FfUtils::u64>(1023 + Emin<FT>() - FT::kManBits) << 52);
+  const FfUtils::u64 mag = Magnitude(a);
+  const FfUtils::u64 sign = static_cast<FfUtils::u64>(Sign(a)) << 63;
+  if (mag >> FT::kManBits) [[likely]]
+    return std::bit_cast<FfUtils::f64>(sign | ((mag << (52 - FT::kManBits)) + (static_cast<FfUtils::u64>(1023 - FT::kBias) << 52)));
+  const FfUtils::f64 r = static_cast<FfUtils::f64>(mag) * kSubnormalScale;
+  return sign ? -r : r;
+}
+
+// Takes the sign of the configured f32 default NaN.
+template <typename FT>
+FT IeeeFloat::DefaultNan() {
+  return Pack<FT>(std::signbit(qnan32_), InfBits<FT>() | QuietBit<FT>());
+}
+
+template <typename FT>
+FT IeeeFloat::PropagateNan(FT a, FT b) {
+  switch (nan_propagation_scheme) {
+  case kNanPropX86sse:
+    return FT{static_cast<typename FT::UT>((IsNan(a) ? a.v : b.v) | QuietBit<FT>())};
+  case kNanPropArm64:  // The first signaling NaN, otherwise the first NaN.
+    return FT{static_cast<typename FT::UT>(((IsSnan(a) || (IsNan(a) && !IsSnan(b))) ? a.v : b.v) | QuietBit<FT>())};
+  case kNanPropRiscv:
+  case kNanPropArm64DefaultNan:
+    return DefaultNan<FT>();
+  default:
+    throw std::runtime_error(std::string("Unknown NaN propagation scheme"));
+  }
+}
+
+template <typename FT>
+FT IeeeFloat::PropagateNan(FT a, FT b, FT c) {
+  switch (nan_propagation_scheme) {
+  case kNanPropX86sse:
+    if (IsNan(a) || IsNan(b))
+      return PropagateNan(a, b);
+    if ((IsInf(a) && IsZero(b)) || (IsZero(a) && IsInf(b)))
+      return DefaultNan<FT>();
+    return PropagateNan(c, c);
+  case kNanPropArm64:  // The addend comes first.
+    if (IsSnan(c) || (IsNan(c) && !IsSnan(a) && !IsSnan(b)))
+      return !IsSnan(c) && ((IsInf(a) && IsZero(b)) || (IsZero(a) && IsInf(b))) ? DefaultNan<FT>() : PropagateNan(c, c);
+    return PropagateNan(a, b);
+  case kNanPropRiscv:
+  case kNanPropArm64DefaultNan:
+    return DefaultNan<FT>();
+  default:
+    throw std::runtime_error(std::string("Unknown NaN propagation scheme"));
+  }
+}
+
+template <typename FT, Vfpu::RoundingMode rm>
+FT IeeeFloat::RoundPack(bool sign, FfUtils::i32 exp, FfUtils::u128 sig) {
+  using namespace IeeeFloatInternal;
+  using UT = typename FT::UT;
+  constexpr FfUtils::i32 kM = FT::kManBits;
+
+  // Normalize to sig in [2^125, 2^126), so that at least 63 bits are dropped.
+  const FfUtils::i32 msb = Msb(sig);
+  if (msb < 125) {
+    sig <<= 125 - msb;
+    exp -= 125 - msb;
+  } else {
+    sig = ShiftRightJam(sig, msb - 125);
+    exp += msb - 125;
+  }
+  const FfUtils::i32 x = exp + 125;  // Binade of the value.
+  const FfUtils::i32 quantum = std::max(x, Emin<FT>()) - kM;
+
+  auto round = [sign](FfUtils::u128 s, FfUtils::i32 shift, bool& inexact) -> FfUtils::u128 {
+    FfUtils::u128 n = 0;
+    bool round_bit = false;
+    bool sticky = true;
+    if (shift <= 126) {
+      n = s >> shift;
+      round_bit = (s >> (shift - 1)) & 1;
+      sticky = (s & ((static_cast<FfUtils::u128>(1) << (shift - 1)) - 1)) != 0;
+    }
+    inexact = round_bit || sticky;
+    bool up;
+    if constexpr (rm == kRoundTiesToEven)
+      up = round_bit && (sticky || (n & 1));
+    else if constexpr (rm == kRoundTiesToAway)
+      up = round_bit;
+    else if constexpr (rm == kRoundTowardPositive)
+      up = inexact && !sign;
+    else if constexpr (rm == kRoundTowardNegative)
+      up = inexact && sign;
+    else
+      up = false;
+    return n + up;
+  };
+
+  bool is_inexact;
+  FfUtils::u128 n = round(sig, quantum - exp, is_inexact);
+
+  bool tiny = x < Emin<FT>();
+  if (tiny && !tininess_before_rounding && x == Emin<FT>() - 1) {
+    bool unused;
+    tiny = round(sig, 125 - kM, unused) != (static_cast<FfUtils::u128>(2) << kM);
+  }
+  if (is_inexact) {
+    inexact = true;
+    if (tiny)
+      underflow = true;
+  }
+
+  if (n < (static_cast<FfUtils::u128>(1) << kM))
+    return Pack<FT>(sign, static_cast<UT>(n));
+  FfUtils::i64 biased = static_cast<FfUtils::i64>(quantum) + kM + FT::kBias;
+  if (n == (static_cast<FfUtils::u128>(2) << kM)) {
+    n >>= 1;
+    ++biased;
+  }
+  if (biased >= (1ll << FT::kExpBits) - 1) {
+    overflow = true;
+    inexact = true;
+    const bool to_inf = rm == kRoundTiesToEven || rm == kRoundTiesToAway || (rm == kRoundTowardPositive && !sign) ||
+                        (rm == kRoundTowardNegative && sign);
+    return Pack<FT>(sign, to_inf ? InfBits<FT>() : static_cast<UT>(InfBits<FT>() - 1));
+  }
+  const UT man = static_cast<UT>(n) & static_cast<UT>((static_cast<UT>(1) << kM) - 1);
+  return Pack<FT>(sign, static_cast<UT>((static_cast<UT>(biased) << kM) | man));
+}
+
+template <typename FT, Vfpu::RoundingMode rm>
+FT IeeeFloat::RoundF64(FfUtils::f64 a) {
+  using UT = typename FT::UT;
+  constexpr FfUtils::i32 kShift = 52 - FT::kManBits;
+  const FfUtils::u64 bits = std::bit_cast<FfUtils::u64>(a);
+  const bool sign = bits >> 63;
+  const FfUtils::u64 mag = bits & ~(1ull << 63);
+  if (mag == 0)
+    return Pack<FT>(sign, 0);
+
+  const FfUtils::i32 x = static_cast<FfUtils::i32>(mag >> 52) - 1023;
+  if (x >= Emin<FT>() && x <= FT::kBias) [[likely]] {
+    constexpr FfUtils::u64 kMask = (1ull << kShift) - 1;
+    constexpr FfUtils::u64 kHalf = 1ull << (kShift - 1);
+    FfUtils::u64 addend;
+    if constexpr (rm == kRoundTiesToEven)
+      addend = kHalf - 1 + ((mag >> kShift) & 1);
+    else if constexpr (rm == kRoundTiesToAway)
+      addend = kHalf;
+    else if constexpr (rm == kRoundTowardPositive)
+      addend = sign ? 0 : kMask;
+    else if constexpr (rm == kRoundTowardNegative)
+      addend = sign ? kMask : 0;
+    else
+      addend = 0;
+    const FfUtils::u64 r = ((mag + addend) >> kShift) - (static_cast<FfUtils::u64>(1023 - FT::kBias) << FT::kManBits);
+    if (r < InfBits<FT>()) [[likely]] {  // Carries into the exponent are fine as long as there is no overflow.
+      if (mag & kMask)
+        inexact = true;
+      return Pack<FT>(sign, static_cast<UT>(r));
+    }
+  }
+
+  if (x == -1023)
+    return RoundPack<FT, rm>(sign, -1074, mag);
+  return RoundPack<FT, rm>(sign, x - 52, (mag & ((1ull << 52) - 1)) | (1ull << 52));
+}
+
+template <typename FT, Vfpu::RoundingMode rm>
+FT IeeeFloat::ExactZeroSum(bool a_sign, bool b_sign) {
+  return Pack<FT>(a_sign == b_sign ? a_sign : rm == kRoundTowardNegative, 0);
+}
+
+// Adds two non-zero values with sig < 2^124. Normalized to bit 125, the smaller addend loses at most jammed bits, and
+// then the sum keeps more than 120 significant bits.
+template <typename FT, Vfpu::RoundingMode rm>
+FT IeeeFloat::AddExact(bool a_sign, FfUtils::i32 a_exp, FfUtils::u128 a_sig, bool b_sign, FfUtils::i32 b_exp,
+                       FfUtils::u128 b_sig) {
+  using namespace IeeeFloatInternal;
+  a_exp -= 125 - Msb(a_sig);
+  a_sig <<= 125 - Msb(a_sig);
+  b_exp -= 125 - Msb(b_sig);
+  b_sig <<= 125 - Msb(b_sig);
+  if (a_exp < b_exp || (a_exp == b_exp && a_sig < b_sig)) {
+    std::swap(a_sign, b_sign);
+    std::swap(a_exp, b_exp);
+    std::swap(a_sig, b_sig);
+  }
+  b_sig = ShiftRightJam(b_sig, a_exp - b_exp);
+  const FfUtils::u128 sig = (a_sign == b_sign) ? a_sig + b_sig : a_sig - b_sig;
+  if (sig == 0)
+    return ExactZeroSum<FT, rm>(a_sign, b_sign);
+  return RoundPack<FT, rm>(a_sign, a_exp, sig);
+}
+
+template <typename FT, Vfpu::RoundingMode rm>
+FT IeeeFloat::SoftAdd(FT a, FT b) {
+  if (IsNan(a) || IsNan(b)) [[unlikely]] {
+    if (IsSnan(a) || IsSnan(b))
+      invalid = true;
+    return PropagateNan(a, b);
+  }
+  if (IsInf(a) || IsInf(b)) [[unlikely]] {
+    if (IsInf(a) && IsInf(b) && Sign(a) != Sign(b)) {
+      invalid = true;
+      return DefaultNan<FT>();
+    }
+    return IsInf(a) ? a : b;
+  }
+  if (IsZero(a) || IsZero(b))
+    return (IsZero(a) && IsZero(b)) ? ExactZeroSum<FT, rm>(Sign(a), Sign(b)) : (IsZero(a) ? b : a);
+
+  bool a_sign, b_sign;
+  FfUtils::i32 a_exp, b_exp;
+  FfUtils::u64 a_sig, b_sig;
+  Unpack(a, a_sign, a_exp, a_sig);
+  Unpack(b, b_sign, b_exp, b_sig);
+  return AddExact<FT, rm>(a_sign, a_exp, a_sig, b_sign, b_exp, b_sig);
+}
+
+template <typename FT, Vfpu::RoundingMode rm>
+FT IeeeFloat::Add(FT a, FT b) {
+  if constexpr (HasFastPath<FT>()) {
+    if (fast_path && Magnitude(a) < InfBits<FT>() && Magnitude(b) < InfBits<FT>()) [[likely]] {
+      const FfUtils::f64 fa = ToF64Fast(a);
+      const FfUtils::f64 fb = ToF64Fast(b);
+      const FfUtils::f64 c = fa + fb;
+      if (c == 0.)
+        return ExactZeroSum<FT, rm>(Sign(a), Sign(b));
+      return RoundF64<FT, rm>(IeeeFloatInternal::RoundToOdd(c, IeeeFloatInternal::SumResidual(fa, fb, c)));
+    }
+  }
+  return SoftAdd<FT, rm>(a, b);
+}
+
+template <typename FT>
+FT IeeeFloat::Add(FT a, FT b) {
+  FT result;
+  FLOPPY_FLOAT_FUNC_2(result, rounding_mode, Add, FT, a, b)
+  return result;
+}
+
+template <typename FT, Vfpu::RoundingMode rm>
+FT IeeeFloat::Sub(FT a, FT b) {
+  if (IsNan(a) || IsNan(b)) [[unlikely]] {
+    if (IsSnan(a) || IsSnan(b))
+      invalid = true;
+    return PropagateNan(a, b);
+  }
+  return Add<FT, rm>(a, FT{static_cast<typename FT::UT>(b.v ^ SignBit<FT>())});
+}
+
+template <typename FT>
+FT IeeeFloat::Sub(FT a, FT b) {
+  FT result;
+  FLOPPY_FLOAT_FUNC_2(result, rounding_mode, Sub, FT, a, b)
+  return result;
+}
+
+template <typename FT, Vfpu::RoundingMode rm>
+FT IeeeFloat::SoftMul(FT a, FT b) {
+  if (IsNan(a) || IsNan(b)) [[unlikely]] {
+    if (IsSnan(a) || IsSnan(b))
+      invalid = true;
+    return PropagateNan(a, b);
+  }
+  const bool sign = Sign(a) != Sign(b);
+  if (IsInf(a) || IsInf(b)) [[unlikely]] {
+    if (IsZero(a) || IsZero(b)) {
+      invalid = true;
+      return DefaultNan<FT>();
+    }
+    return Pack<FT>(sign, InfBits<FT>());
+  }
+  if (IsZero(a) || IsZero(b))
+    return Pack<FT>(sign, 0);
+
+  bool unused;
+  FfUtils::i32 a_exp, b_exp;
+  FfUtils::u64 a_sig, b_sig;
+  Unpack(a, unused, a_exp, a_sig);
+  Unpack(b, unused, b_exp, b_sig);
+  return RoundPack<FT, rm>(sign, a_exp + b_exp, static_cast<FfUtils::u128>(a_sig) * b_sig);
+}
+
+template <typename FT, Vfpu::RoundingMode rm>
+FT IeeeFloat::Mul(FT a, FT b) {
+  if constexpr (HasFastPath<FT>()) {
+    if (fast_path && Magnitude(a) < InfBits<FT>() && Magnitude(b) < InfBits<FT>()) [[likely]]
+      return RoundF64<FT, rm>(ToF64Fast(a) * ToF64Fast(b));  // Exact.
+  }
+  return SoftMul<FT, rm>(a, b);
+}
+
+template <typename FT>
+FT IeeeFloat::Mul(FT a, FT b) {
+  FT result;
+  FLOPPY_FLOAT_FUNC_2(result, rounding_mode, Mul, FT, a, b)
+  return result;
+}
+
+template <typename FT, Vfpu::RoundingMode rm>
+FT IeeeFloat::SoftDiv(FT a, FT b) {
+  if (IsNan(a) || IsNan(b)) [[unlikely]] {
+    if (IsSnan(a) || IsSnan(b))
+      invalid = true;
+    return PropagateNan(a, b);
+  }
+  const bool sign = Sign(a) != Sign(b);
+  if (IsInf(a)) [[unlikely]] {
+    if (IsInf(b)) {
+      invalid = true;
+      return DefaultNan<FT>();
+    }
+    return Pack<FT>(sign, InfBits<FT>());
+  }
+  if (IsInf(b)) [[unlikely]]
+    return Pack<FT>(sign, 0);
+  if (IsZero(b)) [[unlikely]] {
+    if (IsZero(a)) {
+      invalid = true;
+      return DefaultNan<FT>();
+    }
+    division_by_zero = true;
+    return Pack<FT>(sign, InfBits<FT>());
+  }
+  if (IsZero(a))
+    return Pack<FT>(sign, 0);
+
+  bool unused;
+  FfUtils::i32 a_exp, b_exp;
+  FfUtils::u64 a_sig, b_sig;
+  Unpack(a, unused, a_exp, a_sig);
+  Unpack(b, unused, b_exp, b_sig);
+  const FfUtils::i32 a_shift = std::countl_zero(a_sig);
+  const FfUtils::i32 b_shift = std::countl_zero(b_sig);
+  const FfUtils::u128 num = static_cast<FfUtils::u128>(a_sig << a_shift) << 64;
+  const FfUtils::u64 den = b_sig << b_shift;
+  const FfUtils::u128 quotient = num / den;  // At least 64 significant bits.
+  const bool rest = (num % den) != 0;
+  return RoundPack<FT, rm>(sign, (a_exp - a_shift) - (b_exp - b_shift) - 64, quotient | rest);
+}
+
+template <typename FT, Vfpu::RoundingMode rm>
+FT IeeeFloat::Div(FT a, FT b) {
+  if constexpr (HasFastPath<FT>()) {
+    if (fast_path && Magnitude(a) < InfBits<FT>() && Magnitude(b) < InfBits<FT>() && !IsZero(b)) [[likely]] {
+      const FfUtils::f64 fa = ToF64Fast(a);
+      const FfUtils::f64 fb = ToF64Fast(b);
+      const FfUtils::f64 c = fa / fb;
+      const FfUtils::f64 rem = std::fma(c, fb, -fa);  // Exact, and (c - exact) * fb.
+      return RoundF64<FT, rm>(IeeeFloatInternal::RoundToOdd(c, std::signbit(fb) ? -rem : rem));
+    }
+  }
+  return SoftDiv<FT, rm>(a, b);
+}
+
+template <typename FT>
+FT IeeeFloat::Div(FT a, FT b) {
+  FT result;
+  FLOPPY_FLOAT_FUNC_2(result, rounding_mode, Div, FT, a, b)
+  return result;
+}
+
+template <typename FT, Vfpu::RoundingMode rm>
+FT IeeeFloat::SoftSqrt(FT a) {
+  if (IsNan(a)) [[unlikely]] {
+    if (IsSnan(a))
+      invalid = true;
+    return PropagateNan(a, a);
+  }
+  if (IsZero(a))
+    return a;
+  if (Sign(a)) [[unlikely]] {
+    invalid = true;
+    return DefaultNan<FT>();
+  }
+  if (IsInf(a)) [[unlikely]]
+    return a;
+
+  bool unused;
+  FfUtils::i32 exp;
+  FfUtils::u64 sig;
+  Unpack(a, unused, exp, sig);
+  // Scale the radicand to 127 or 128 bits with an even exponent, so that the root has 64 bits.
+  FfUtils::i32 shift = 126 - (63 - std::countl_zero(sig));
+  if ((exp - shift) & 1)
+    ++shift;
+  bool rest;
+  const FfUtils::u128 root = IeeeFloatInternal::Isqrt(static_cast<FfUtils::u128>(sig) << shift, rest);
+  return RoundPack<FT, rm>(false, (exp - shift) / 2, root | rest);
+}
+
+template <typename FT, Vfpu::RoundingMode rm>
+FT IeeeFloat::Sqrt(FT a) {
+  if constexpr (HasFastPath<FT>()) {
+    if (fast_path && !Sign(a) && Magnitude(a) < InfBits<FT>() && !IsZero(a)) [[likely]] {
+      const FfUtils::f64 fa = ToF64Fast(a);
+      const FfUtils::f64 c = std::sqrt(fa);
+      return RoundF64<FT, rm>(IeeeFloatInternal::RoundToOdd(c, std::fma(c, c, -fa)));
+    }
+  }
+  return SoftSqrt<FT, rm>(a);
+}
+
+template <typename FT>
+FT IeeeFloat::Sqrt(FT a) {
+  FT result;
+  FLOPPY_FLOAT_FUNC_2(result, rounding_mode, Sqrt, FT, a)
+  return result;
+}
+
+template <typename FT, Vfpu::RoundingMode rm>
+FT IeeeFloat::SoftFma(FT a, FT b, FT c) {
+  if (IsNan(a) || IsNan(b) || IsNan(c)) [[unlikely]] {
+    const bool inf_times_zero = (IsInf(a) && IsZero(b)) || (IsZero(a) && IsInf(b));
+    if (IsSnan(a) || IsSnan(b) || IsSnan(c) || (invalid_fma && inf_times_zero))
+      invalid = true;
+    return PropagateNan(a, b, c);
+  }
+  const bool p_sign = Sign(a) != Sign(b);
+  if (IsInf(a) || IsInf(b)) [[unlikely]] {
+    if (IsZero(a) || IsZero(b) || (IsInf(c) && Sign(c) != p_sign)) {
+      invalid = true;
+      return DefaultNan<FT>();
+    }
+    return Pack<FT>(p_sign, InfBits<FT>());
+  }
+  if (IsInf(c)) [[unlikely]]
+    return c;
+  if (IsZero(a) || IsZero(b))
+    return IsZero(c) ? ExactZeroSum<FT, rm>(p_sign, Sign(c)) : c;
+
+  bool unused, c_sign;
+  FfUtils::i32 a_exp, b_exp, c_exp;
+  FfUtils::u64 a_sig, b_sig, c_sig;
+  Unpack(a, unused, a_exp, a_sig);
+  Unpack(b, unused, b_exp, b_sig);
+  const FfUtils::u128 p_sig = static_cast<FfUtils::u128>(a_sig) * b_sig;
+  if (IsZero(c))
+    return RoundPack<FT, rm>(p_sign, a_exp + b_exp, p_sig);
+  Unpack(c, c_sign, c_exp, c_sig);
+  return AddExact<FT, rm>(p_sign, a_exp + b_exp, p_sig, c_sign, c_exp, c_sig);
+}
+
+template <typename FT, Vfpu::RoundingMode rm>
+FT IeeeFloat::Fma(FT a, FT b, FT c) {
+  if constexpr (HasFastPath<FT>()) {
+    if (fast_path && Magnitude(a) < InfBits<FT>() && Magnitude(b) < InfBits<FT>() && Magnitude(c) < InfBits<FT>())
+        [[likely]] {
+      const FfUtils::f64 p = ToF64Fast(a) * ToF64Fast(b);  // Exact.
+      const FfUtils::f64 fc = ToF64Fast(c);
+      const FfUtils::f64 r = p + fc;
+      if (r == 0.)
+        return ExactZeroSum<FT, rm>(Sign(a) != Sign(b), Sign(c));
+      return RoundF64<FT, rm>(IeeeFloatInternal::RoundToOdd(r, IeeeFloatInternal::SumResidual(p, fc, r)));
+    }
+  }
+  return SoftFma<FT, rm>(a, b, c);
+}
+
+template <typename FT>
+FT IeeeFloat::Fma(FT a, FT b, FT c) {
+  FT result;
+  FLOPPY_FLOAT_FUNC_2(result, rounding_mode, Fma, FT, a, b, c)
+  return result;
+}
+
+template <typename FT, Vfpu::RoundingMode rm>
+FT IeeeFloat::F64ToIeee(FfUtils::f64 a) {
+  const FfUtils::u64 bits = std::bit_cast<FfUtils::u64>(a);
+  const bool sign = std::signbit(a);
+  if (std::isnan(a)) [[unlikely]] {
+    if (!(bits & (1ull << 51)))
+      invalid = true;
+    if (nan_propagation_scheme != kNanPropX86sse && nan_propagation_scheme != kNanPropArm64)
+      return DefaultNan<FT>();
+    const FfUtils::u64 payload = (bits & ((1ull << 52) - 1)) >> std::max(52 - FT::kManBits, 0)
+                                                              << std::max(FT::kManBits - 52, 0);
+    return Pack<FT>(sign, static_cast<typename FT::UT>(InfBits<FT>() | QuietBit<FT>() | payload));
+  }
+  if (std::isinf(a)) [[unlikely]]
+    return Pack<FT>(sign, InfBits<FT>());
+  if (a == 0.)
+    return Pack<FT>(sign, 0);
+
+  const FfUtils::i32 biased = static_cast<FfUtils::i32>((bits >> 52) & 0x7ff);
+  const FfUtils::u64 man = bits & ((1ull << 52) - 1);
+  if (biased == 0)
+    return RoundPack<FT, rm>(sign, -1074, man);
+  return RoundPack<FT, rm>(sign, biased - 1075, man | (1ull << 52));
+}
+
+template <typename FT>
+FT IeeeFloat::F64ToIeee(FfUtils::f64 a) {
+  FT result;
+  FLOPPY_FLOAT_FUNC_2(result, rounding_mode, F64ToIeee, FT, a)
+  return result;
+}
+
+template <typename FT>
+FfUtils::f64 IeeeFloat::IeeeToF64(FT a) {
+  const bool sign = Sign(a);
+  if (IsNan(a)) [[unlikely]] {
+    if (IsSnan(a))
+      invalid = true;
+    if (nan_propagation_scheme != kNanPropX86sse && nan_propagation_scheme != kNanPropArm64)
+      return qnan64_;
+    const FfUtils::u64 payload = static_cast<FfUtils::u64>(Magnitude(a) & ((static_cast<typename FT::UT>(1) << FT::kManBits) - 1));
+    const FfUtils::u64 man = FT::kManBits <= 52 ? payload << (52 - FT::kManBits) : payload >> (FT::kManBits - 52);
+    return std::bit_cast<FfUtils::f64>((static_cast<FfUtils::u64>(sign) << 63) | 0x7ff8000000000000ull | man);
+  }
+  if (IsInf(a)) [[unlikely]]
+    return sign ? -std::numeric_limits<FfUtils::f64>::infinity() : std::numeric_limits<FfUtils::f64>::infinity();
+
+  FfUtils::i32 exp;
+  FfUtils::u64 sig;
+  bool unused;
+  Unpack(a, unused, exp, sig);
+  const FfUtils::f64 r = std::ldexp(static_cast<FfUtils::f64>(sig), exp);
+  return sign ? -r : r;
+}
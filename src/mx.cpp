@@ -0,0 +1,303 @@
+/**************************************************************************************************
+ * Apache License, Version 2.0
+ * Copyright (c) 2024 chciken/Niko Zurstraßen
+ **************************************************************************************************/
+
+#include "mx.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "narrow_float.h"
+
+using namespace FfUtils;
+
+namespace {
+
+constexpr u8 kScaleNan = 0xff;
+constexpr i32 kScaleBias = 127;
+
+enum ElementKind : u8 { kFinite, kInf, kNan, kSnan };
+
+// Besides its value, each element is also available as a signed integer multiple of the smallest subnormal.
+struct MxElement {
+  f64 value;
+  i64 fixed;
+  ElementKind kind;
+};
+
+template <typename FT>
+constexpr i32 FixedLsb() {
+  return 1 - NarrowFormat<FT>::kBias - NarrowFormat<FT>::kManBits;
+}
+
+template <typename FT>
+constexpr i32 FixedBits() {
+  using F = NarrowFormat<FT>;
+  return F::kManBits + 1 + (F::kMax >> F::kManBits) - 1;
+}
+
+template <typename FT>
+const std::array<MxElement, 256>& ElementTable() {
+  static const std::array<MxElement, 256> table = [] {
+    using F = NarrowFormat<FT>;
+    std::array<MxElement, 256> result;
+    for (u32 i = 0; i < 256; ++i) {
+      const u8 a = static_cast<u8>(i & ((2u << NarrowSignShift<FT>()) - 1));
+      const i32 exp = (a >> F::kManBits) & ((1 << F::kExpBits) - 1);
+      const i64 man = a & ((1 << F::kManBits) - 1);
+      const i64 fixed = exp == 0 ? man : (man | (1 << F::kManBits)) << (exp - 1);
+      ElementKind kind = kFinite;
+      if (IsSnanNarrow<FT>(a))
+        kind = kSnan;
+      else if (IsNanNarrow<FT>(a))
+        kind = kNan;
+      else if (IsInfNarrow<FT>(a))
+        kind = kInf;
+      result[i] = {NarrowToF64<FT>(a), ((a >> NarrowSignShift<FT>()) & 1) ? -fixed : fixed, kind};
+    }
+    return result;
+  }();
+  return table;
+}
+
+}  // namespace
+
+Mx::Mx() : FloppyFloat() {}
+
+template <typename FT, Vfpu::RoundingMode rm>
+void Mx::Quantize(MxBlock<FT>* dst, const f32* src, std::size_t num_blocks) {
+  constexpr std::size_t kSize = MxBlock<FT>::kSize;
+  u32 flags = 0;
+  for (std::size_t k = 0; k < num_blocks; ++k) {
+    const f32* v = src + k * kSize;
+    MxBlock<FT>& block = dst[k];
+
+    f64 max = 0.0;
+    bool non_finite = false;
+    for (std::size_t i = 0; i < kSize; ++i) {
+      const f64 magnitude = std::fabs(static_cast<f64>(v[i]));
+      if (std::isfinite(magnitude))
+        max = std::max(max, magnitude);
+      else
+        non_finite = true;
+    }
+
+    if (non_finite) [[unlikely]] {
+      for (std::size_t i = 0; i < kSize; ++i)
+        invalid |= IsSnan(v[i]);
+      if constexpr (!NarrowFormat<FT>::kHasNan) {
+        block.scale.v = kScaleNan;
+        for (std::size_t i = 0; i < kSize; ++i)
+          block.elements[i].v = 0;
+        continue;
+      }
+    }
+
+    const i32 shared_exp = max == 0.0 ? -kScaleBias
+                                      : std::clamp(std::ilogb(max) - NarrowEmax<FT>(), -kScaleBias, kScaleBias);
+    block.scale.v = static_cast<u8>(shared_exp + kScaleBias);
+    const f64 inv_scale = std::ldexp(1.0, -shared_exp);
+    for (std::size_t i = 0; i < kSize; ++i) {
+      const f64 a = static_cast<f64>(v[i]);
+      if constexpr (NarrowFormat<FT>::kHasNan) {
+        if (std::isnan(a)) [[unlikely]] {
+          block.elements[i].v = NarrowFormat<FT>::kQnan;
+          continue;
+        }
+      }
+      // Finite elements are clamped, infinities stay infinities if the format allows.
+      const u32 entry = RoundToNarrow<FT, rm>(a * inv_scale, !std::isinf(a), tininess_before_rounding);
+      block.elements[i].v = static_cast<u8>(entry);
+      flags |= entry;
+    }
+  }
+  RaiseNarrowFlags(*this, flags);
+}
+
+template <typename FT>
+void Mx::Quantize(MxBlock<FT>* dst, const f32* src, std::size_t num_blocks) {
+  switch (rounding_mode) {
+    case kRoundTiesToEven:
+      return Quantize<FT, kRoundTiesToEven>(dst, src, num_blocks);
+    case kRoundTiesToAway:
+      return Quantize<FT, kRoundTiesToAway>(dst, src, num_blocks);
+    case kRoundTowardPositive:
+      return Quantize<FT, kRoundTowardPositive>(dst, src, num_blocks);
+    case kRoundTowardNegative:
+      return Quantize<FT, kRoundTowardNegative>(dst, src, num_blocks);
+    case kRoundTowardZero:
+      return Quantize<FT, kRoundTowardZero>(dst, src, num_blocks);
+    default:
+      throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <typename FT, Vfpu::RoundingMode rm>
+void Mx::Dequantize(f32* dst, const MxBlock<FT>* src, std::size_t num_blocks) {
+  constexpr std::size_t kSize = MxBlock<FT>::kSize;
+  const auto& table = ElementTable<FT>();
+  for (std::size_t k = 0; k < num_blocks; ++k) {
+    const MxBlock<FT>& block = src[k];
+    f32* v = dst + k * kSize;
+    if (block.scale.v == kScaleNan) [[unlikely]] {
+      std::fill(v, v + kSize, qnan32_);
+      continue;
+    }
+    // Scaling by a power of two is exact in f64, so the only rounding happens in the conversion to f32.
+    const f64 scale = std::ldexp(1.0, block.scale.v - kScaleBias);
+    for (std::size_t i = 0; i < kSize; ++i) {
+      const MxElement& element = table[block.elements[i].v];
+      if (element.kind >= kNan) [[unlikely]] {
+        invalid |= element.kind == kSnan;
+        v[i] = qnan32_;
+      } else {
+        v[i] = F64ToF32<rm>(element.value * scale);
+      }
+    }
+  }
+}
+
+template <typename FT>
+void Mx::Dequantize(f32* dst, const MxBlock<FT>* src, std::size_t num_blocks) {
+  switch (rounding_mode) {
+    case kRoundTiesToEven:
+      return Dequantize<FT, kRoundTiesToEven>(dst, src, num_blocks);
+    case kRoundTiesToAway:
+      return Dequantize<FT, kRoundTiesToAway>(dst, src, num_blocks);
+    case kRoundTowardPositive:
+      return Dequantize<FT, kRoundTowardPositive>(dst, src, num_blocks);
+    case kRoundTowardNegative:
+      return Dequantize<FT, kRoundTowardNegative>(dst, src, num_blocks);
+    case kRoundTowardZero:
+      return Dequantize<FT, kRoundTowardZero>(dst, src, num_blocks);
+    default:
+      throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+// Blocks with infinities or NaNs always yield infinity or NaN, so the scales do not matter.
+template <typename FTA, typename FTB>
+f32 Mx::DotBlockSpecial(const MxBlock<FTA>& a, const MxBlock<FTB>& b) {
+  const auto& table_a = ElementTable<FTA>();
+  const auto& table_b = ElementTable<FTB>();
+  f64 sum = 0.0;
+  bool nan = false;
+  for (std::size_t i = 0; i < MxBlock<FTA>::kSize; ++i) {
+    const MxElement& ea = table_a[a.elements[i].v];
+    const MxElement& eb = table_b[b.elements[i].v];
+    if (ea.kind >= kNan || eb.kind >= kNan) {
+      nan = true;
+      invalid |= ea.kind == kSnan || eb.kind == kSnan;
+    } else {
+      sum += ea.value * eb.value;
+    }
+  }
+  if (std::isnan(sum)) {  // ∞ × 0 or ∞ - ∞
+    invalid = true;
+    return qnan32_;
+  }
+  return nan ? qnan32_ : static_cast<f32>(sum);
+}
+
+template <typename FTA, typename FTB, Vfpu::RoundingMode rm>
+f32 Mx::DotBlock(const MxBlock<FTA>& a, const MxBlock<FTB>& b) {
+  static_assert(MxBlock<FTA>::kSize == MxBlock<FTB>::kSize);
+  // The sum of 32 products needs 5 bits on top of the product.
+  using Acc = std::conditional_t<FixedBits<FTA>() + FixedBits<FTB>() + 5 < 63, i64, i128>;
+  using UAcc = std::make_unsigned_t<Acc>;
+
+  if (a.scale.v == kScaleNan || b.scale.v == kScaleNan) [[unlikely]]
+    return qnan32_;
+
+  const auto& table_a = ElementTable<FTA>();
+  const auto& table_b = ElementTable<FTB>();
+  Acc sum = 0;
+  u32 kinds = 0;
+  for (std::size_t i = 0; i < MxBlock<FTA>::kSize; ++i) {
+    const MxElement& ea = table_a[a.elements[i].v];
+    const MxElement& eb = table_b[b.elements[i].v];
+    kinds |= ea.kind | eb.kind;
+    sum += static_cast<Acc>(ea.fixed) * static_cast<Acc>(eb.fixed);
+  }
+  if (kinds) [[unlikely]]
+    return DotBlockSpecial(a, b);
+  if (sum == 0) [[unlikely]] {
+    // As for IEEE sums, the zero is -0 if all products are -0, +0 if all are +0, and otherwise depends on rm.
+    bool all_positive = true;
+    bool all_negative = true;
+    for (std::size_t i = 0; i < MxBlock<FTA>::kSize; ++i) {
+      const MxElement& ea = table_a[a.elements[i].v];
+      const MxElement& eb = table_b[b.elements[i].v];
+      const bool zero = ea.fixed == 0 || eb.fixed == 0;
+      const bool negative = std::signbit(ea.value) != std::signbit(eb.value);
+      all_positive &= zero && !negative;
+      all_negative &= zero && negative;
+    }
+    if (all_positive || all_negative)
+      return all_negative ? -0.0f32 : 0.0f32;
+    return rm == kRoundTowardNegative ? -0.0f32 : 0.0f32;
+  }
+
+  // Reduce the exact sum to 53 bits with round to odd, so that the final rounding to f32 is still correct.
+  const bool sign = sum < 0;
+  const UAcc magnitude = sign ? -static_cast<UAcc>(sum) : static_cast<UAcc>(sum);
+  const i32 shift = std::max(0, static_cast<i32>(std::bit_width(magnitude)) - 53);
+  u64 significand = static_cast<u64>(magnitude >> shift);
+  if (magnitude & ((static_cast<UAcc>(1) << shift) - 1))
+    significand |= 1;
+  const i32 exp = shift + FixedLsb<FTA>() + FixedLsb<FTB>() + a.scale.v + b.scale.v - 2 * kScaleBias;
+  const f64 result = std::ldexp(static_cast<f64>(significand), exp);
+  return F64ToF32<rm>(sign ? -result : result);
+}
+
+template <typename FTA, typename FTB, Vfpu::RoundingMode rm>
+f32 Mx::Dot(const MxBlock<FTA>* a, const MxBlock<FTB>* b, std::size_t num_blocks) {
+  if (num_blocks == 0)
+    return 0.0f32;
+  f32 result = DotBlock<FTA, FTB, rm>(a[0], b[0]);
+  for (std::size_t k = 1; k < num_blocks; ++k)
+    result = Add<f32, rm>(result, DotBlock<FTA, FTB, rm>(a[k], b[k]));
+  return result;
+}
+
+template <typename FTA, typename FTB>
+f32 Mx::Dot(const MxBlock<FTA>* a, const MxBlock<FTB>* b, std::size_t num_blocks) {
+  switch (rounding_mode) {
+    case kRoundTiesToEven:
+      return Dot<FTA, FTB, kRoundTiesToEven>(a, b, num_blocks);
+    case kRoundTiesToAway:
+      return Dot<FTA, FTB, kRoundTiesToAway>(a, b, num_blocks);
+    case kRoundTowardPositive:
+      return Dot<FTA, FTB, kRoundTowardPositive>(a, b, num_blocks);
+    case kRoundTowardNegative:
+      return Dot<FTA, FTB, kRoundTowardNegative>(a, b, num_blocks);
+    case kRoundTowardZero:
+      return Dot<FTA, FTB, kRoundTowardZero>(a, b, num_blocks);
+    default:
+      throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+#define MX_INSTANTIATE_DOT(FTA, FTB) \
+  template f32 Mx::Dot<FTA, FTB>(const MxBlock<FTA>*, const MxBlock<FTB>*, std::size_t);
+
+#define MX_INSTANTIATE(FT)                                                     \
+  template void Mx::Quantize<FT>(MxBlock<FT>*, const f32*, std::size_t);       \
+  template void Mx::Dequantize<FT>(f32*, const MxBlock<FT>*, std::size_t);     \
+  MX_INSTANTIATE_DOT(FT, e5m2)                                                 \
+  MX_INSTANTIATE_DOT(FT, e4m3)                                                 \
+  MX_INSTANTIATE_DOT(FT, e3m2)                                                 \
+  MX_INSTANTIATE_DOT(FT, e2m3)                                                 \
+  MX_INSTANTIATE_DOT(FT, e2m1)
+
+MX_INSTANTIATE(e5m2)
+MX_INSTANTIATE(e4m3)
+MX_INSTANTIATE(e3m2)
+MX_INSTANTIATE(e2m3)
+MX_INSTANTIATE(e2m1)
@@ -0,0 +1,53 @@
+#pragma once
+/**************************************************************************************************
+ * Apache License, Version 2.0
+ * Copyright (c) 2024 chciken/Niko Zurstraßen
+ **************************************************************************************************/
+
+#include <cstddef>
+
+#include "floppy_float.h"
+#include "utils.h"
+
+// A block of an OCP Microscaling format: kSize elements that share one E8M0 scale. Elements are stored one per byte.
+template <typename FT>
+struct MxBlock {
+  static constexpr std::size_t kSize = 32;
+  FfUtils::e8m0 scale;
+  FT elements[kSize];
+};
+
+// Simulates the OCP Microscaling (MX) formats MXFP8 (e5m2, e4m3), MXFP6 (e3m2, e2m3), and MXFP4 (e2m1) (see OCP
+// Microscaling Formats (MX) Specification v1.0). All operations work on whole blocks and use the dynamic rounding mode.
+class Mx : public FloppyFloat {
+ public:
+  Mx();
+
+  // See MX specification 6.3 "Conversion from scalar floats to MX". The scale is derived from the largest finite
+  // magnitude of a block, and elements are clamped to the largest finite element. Infinities and NaNs become element
+  // infinities and NaNs. If the element format has neither, the whole block gets a NaN scale. src holds
+  // num_blocks * MxBlock<FT>::kSize values.
+  template <typename FT>
+  void Quantize(MxBlock<FT>* dst, const FfUtils::f32* src, std::size_t num_blocks);
+
+  template <typename FT>
+  void Dequantize(FfUtils::f32* dst, const MxBlock<FT>* src, std::size_t num_blocks);
+
+  // See MX specification 6.4 "Dot product of two MX-compliant vectors". The products of a block are summed up
+  // exactly, scaled, and rounded to f32 once. The block results are accumulated in f32 in order.
+  template <typename FTA, typename FTB>
+  FfUtils::f32 Dot(const MxBlock<FTA>* a, const MxBlock<FTB>* b, std::size_t num_blocks);
+
+ protected:
+  template <typename FT, RoundingMode rm>
+  void Quantize(MxBlock<FT>* dst, const FfUtils::f32* src, std::size_t num_blocks);
+  template <typename FT, RoundingMode rm>
+  void Dequantize(FfUtils::f32* dst, const MxBlock<FT>* src, std::size_t num_blocks);
+  template <typename FTA, typename FTB, RoundingMode rm>
+  FfUtils::f32 Dot(const MxBlock<FTA>* a, const MxBlock<FTB>* b, std::size_t num_blocks);
+
+  template <typename FTA, typename FTB, RoundingMode rm>
+  FfUtils::f32 DotBlock(const MxBlock<FTA>& a, const MxBlock<FTB>& b);
+  template <typename FTA, typename FTB>
+  FfUtils::f32 DotBlockSpecial(const MxBlock<FTA>& a, const MxBlock<FTB>& b);
+};
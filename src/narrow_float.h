@@ -0,0 +1,272 @@
+#pragma once
+/**************************************************************************************************
+ * Apache License, Version 2.0
+ * Copyright (c) 2024 chciken/Niko Zurstraßen
+ **************************************************************************************************/
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+#include "utils.h"
+#include "vfpu.h"
+
+// Helpers for the formats narrower than f16, which have no native type. Rounding results are packed together with
+// the exception flags: The low byte holds the encoding, the high byte the flags.
+namespace FfUtils {
+
+constexpr u32 kNarrowFlagInvalid = 1u << 8;
+constexpr u32 kNarrowFlagDivisionByZero = 1u << 9;
+constexpr u32 kNarrowFlagOverflow = 1u << 10;
+constexpr u32 kNarrowFlagUnderflow = 1u << 11;
+constexpr u32 kNarrowFlagInexact = 1u << 12;
+
+inline void RaiseNarrowFlags(Vfpu& fpu, u32 flags) {
+  fpu.invalid |= static_cast<bool>(flags & kNarrowFlagInvalid);
+  fpu.division_by_zero |= static_cast<bool>(flags & kNarrowFlagDivisionByZero);
+  fpu.overflow |= static_cast<bool>(flags & kNarrowFlagOverflow);
+  fpu.underflow |= static_cast<bool>(flags & kNarrowFlagUnderflow);
+  fpu.inexact |= static_cast<bool>(flags & kNarrowFlagInexact);
+}
+
+template <typename FT>
+struct NarrowFormat;
+
+template <>
+struct NarrowFormat<e4m3> {
+  static constexpr i32 kExpBits = 4;
+  static constexpr i32 kManBits = 3;
+  static constexpr i32 kBias = 7;
+  static constexpr bool kHasInf = false;
+  static constexpr bool kHasNan = true;
+  static constexpr u8 kMax = 0x7e;  // 448
+  static constexpr u8 kQnan = 0x7f;
+};
+
+template <>
+struct NarrowFormat<e5m2> {
+  static constexpr i32 kExpBits = 5;
+  static constexpr i32 kManBits = 2;
+  static constexpr i32 kBias = 15;
+  static constexpr bool kHasInf = true;
+  static constexpr bool kHasNan = true;
+  static constexpr u8 kMax = 0x7b;  // 57344
+  static constexpr u8 kQnan = 0x7e;
+};
+
+template <>
+struct NarrowFormat<e3m2> {
+  static constexpr i32 kExpBits = 3;
+  static constexpr i32 kManBits = 2;
+  static constexpr i32 kBias = 3;
+  static constexpr bool kHasInf = false;
+  static constexpr bool kHasNan = false;
+  static constexpr u8 kMax = 0x1f;  // 28
+  static constexpr u8 kQnan = 0;
+};
+
+template <>
+struct NarrowFormat<e2m3> {
+  static constexpr i32 kExpBits = 2;
+  static constexpr i32 kManBits = 3;
+  static constexpr i32 kBias = 1;
+  static constexpr bool kHasInf = false;
+  static constexpr bool kHasNan = false;
+  static constexpr u8 kMax = 0x1f;  // 7.5
+  static constexpr u8 kQnan = 0;
+};
+
+template <>
+struct NarrowFormat<e2m1> {
+  static constexpr i32 kExpBits = 2;
+  static constexpr i32 kManBits = 1;
+  static constexpr i32 kBias = 1;
+  static constexpr bool kHasInf = false;
+  static constexpr bool kHasNan = false;
+  static constexpr u8 kMax = 0x7;  // 6
+  static constexpr u8 kQnan = 0;
+};
+
+template <typename FT>
+constexpr i32 NarrowSignShift() {
+  return NarrowFormat<FT>::kExpBits + NarrowFormat<FT>::kManBits;
+}
+
+template <typename FT>
+constexpr u32 NarrowMagnitude(u8 a) {
+  return a & ((1u << NarrowSignShift<FT>()) - 1);
+}
+
+// Exponent of the largest finite number.
+template <typename FT>
+constexpr i32 NarrowEmax() {
+  return (NarrowFormat<FT>::kMax >> NarrowFormat<FT>::kManBits) - NarrowFormat<FT>::kBias;
+}
+
+template <typename FT>
+constexpr bool IsInfNarrow(u8 a) {
+  if constexpr (NarrowFormat<FT>::kHasInf)
+    return NarrowMagnitude<FT>(a) == NarrowFormat<FT>::kMax + 1u;
+  else
+    return false;
+}
+
+template <typename FT>
+constexpr bool IsNanNarrow(u8 a) {
+  if constexpr (NarrowFormat<FT>::kHasInf)
+    return NarrowMagnitude<FT>(a) > NarrowFormat<FT>::kMax + 1u;
+  else if constexpr (NarrowFormat<FT>::kHasNan)
+    return NarrowMagnitude<FT>(a) == NarrowFormat<FT>::kQnan;
+  else
+    return false;
+}
+
+// Only E5M2 has signaling NaNs, which follow the IEEE 754 convention of a cleared quiet bit.
+template <typename FT>
+constexpr bool IsSnanNarrow(u8 a) {
+  if constexpr (NarrowFormat<FT>::kHasInf)
+    return IsNanNarrow<FT>(a) && !(a & (1u << (NarrowFormat<FT>::kManBits - 1)));
+  else
+    return false;
+}
+
+// Every narrow number is exactly representable as f64.
+template <typename FT>
+f64 NarrowToF64(u8 a) {
+  using F = NarrowFormat<FT>;
+  const bool sign = (a >> NarrowSignShift<FT>()) & 1;
+  const i32 exp = (a >> F::kManBits) & ((1 << F::kExpBits) - 1);
+  const i32 man = a & ((1 << F::kManBits) - 1);
+  f64 result;
+  if (IsNanNarrow<FT>(a))
+    result = std::numeric_limits<f64>::quiet_NaN();
+  else if (IsInfNarrow<FT>(a))
+    result = std::numeric_limits<f64>::infinity();
+  else if (exp == 0)
+    result = std::ldexp(static_cast<f64>(man), 1 - F::kBias - F::kManBits);
+  else
+    result = std::ldexp(static_cast<f64>(man | (1 << F::kManBits)), exp - F::kBias - F::kManBits);
+  return sign ? -result : result;
+}
+
+// Rounds the significand sig (< 2^53) right by shift bits.
+template <Vfpu::RoundingMode rm>
+constexpr u64 RoundShiftNarrow(u64 sig, i32 shift, bool sign, bool& inexact) {
+  if (shift >= 64) {
+    inexact = sig != 0;
+    return inexact && ((rm == Vfpu::kRoundTowardPositive && !sign) || (rm == Vfpu::kRoundTowardNegative && sign));
+  }
+  const u64 trunc = sig >> shift;
+  const u64 rest = sig & ((1ull << shift) - 1);
+  const u64 half = 1ull << (shift - 1);
+  inexact = rest != 0;
+  bool up;
+  switch (rm) {
+    case Vfpu::kRoundTiesToEven:
+      up = rest > half || (rest == half && (trunc & 1));
+      break;
+    case Vfpu::kRoundTiesToAway:
+      up = rest >= half;
+      break;
+    case Vfpu::kRoundTowardPositive:
+      up = inexact && !sign;
+      break;
+    case Vfpu::kRoundTowardNegative:
+      up = inexact && sign;
+      break;
+    default:
+      up = false;
+      break;
+  }
+  return trunc + up;
+}
+
+// Rounds a (which is not NaN) to a narrow format and returns the encoding plus flags. With saturate set, overflows and
+// infinities become the largest finite number. Otherwise, they become infinity or, for formats without infinities,
+// NaN. Rounding toward zero always saturates overflows. Formats without NaNs always saturate.
+template <typename FT, Vfpu::RoundingMode rm>
+u32 RoundToNarrow(f64 a, bool saturate, bool tininess_before_rounding) {
+  using F = NarrowFormat<FT>;
+  constexpr i32 kEmin = 1 - F::kBias;
+  const bool sign = std::signbit(a);
+  const u32 sign_bit = static_cast<u32>(sign) << NarrowSignShift<FT>();
+  const bool toward_zero = rm == Vfpu::kRoundTowardZero || (rm == Vfpu::kRoundTowardPositive && sign) ||
+                           (rm == Vfpu::kRoundTowardNegative && !sign);
+  saturate = saturate || !F::kHasNan;
+
+  if (std::isinf(a)) {
+    if (saturate)
+      return sign_bit | F::kMax;
+    return F::kHasInf ? (sign_bit | (F::kMax + 1u)) : F::kQnan;
+  }
+  if (a == 0.0)
+    return sign_bit;
+
+  const u64 bits = std::bit_cast<u64>(a);
+  i32 exp = static_cast<i32>((bits >> 52) & 0x7ff);
+  u64 sig = bits & 0xfffffffffffffull;
+  if (exp == 0) {
+    const i32 lz = std::countl_zero(sig) - 11;
+    sig <<= lz;
+    exp = 1 - lz;
+  } else {
+    sig |= 1ull << 52;
+  }
+  exp -= 1023;
+
+  bool inexact;
+  const i32 quantum = std::max(exp, kEmin) - F::kManBits;
+  u64 n = RoundShiftNarrow<rm>(sig, quantum - (exp - 52), sign, inexact);
+
+  bool tiny = exp < kEmin;
+  if (tiny && !tininess_before_rounding && exp == kEmin - 1) {
+    bool unused;
+    tiny = RoundShiftNarrow<rm>(sig, 52 - F::kManBits, sign, unused) != (2ull << F::kManBits);
+  }
+
+  u32 flags = 0;
+  if (inexact) {
+    flags |= kNarrowFlagInexact;
+    if (tiny)
+      flags |= kNarrowFlagUnderflow;
+  }
+
+  if (exp > NarrowEmax<FT>() + 1) {
+    n = ~0ull;  // Far out of range.
+  } else if (n < (1ull << F::kManBits)) {
+    return flags | sign_bit | static_cast<u32>(n);
+  } else {
+    i32 biased_exp = quantum + F::kManBits + F::kBias;
+    if (n == (2ull << F::kManBits)) {
+      n >>= 1;
+      ++biased_exp;
+    }
+    n = (static_cast<u64>(biased_exp) << F::kManBits) | (n - (1ull << F::kManBits));
+  }
+  if (n > F::kMax) {
+    flags = kNarrowFlagOverflow | kNarrowFlagInexact;
+    if (saturate || toward_zero)
+      return flags | sign_bit | F::kMax;
+    return flags | (F::kHasInf ? (sign_bit | (F::kMax + 1u)) : F::kQnan);
+  }
+  return flags | sign_bit | static_cast<u32>(n);
+}
+
+template <typename FT>
+u32 RoundToNarrow(f64 a, Vfpu::RoundingMode rm, bool saturate, bool tininess_before_rounding) {
+  switch (rm) {
+    case Vfpu::kRoundTiesToEven:
+      return RoundToNarrow<FT, Vfpu::kRoundTiesToEven>(a, saturate, tininess_before_rounding);
+    case Vfpu::kRoundTiesToAway:
+      return RoundToNarrow<FT, Vfpu::kRoundTiesToAway>(a, saturate, tininess_before_rounding);
+    case Vfpu::kRoundTowardPositive:
+      return RoundToNarrow<FT, Vfpu::kRoundTowardPositive>(a, saturate, tininess_before_rounding);
+    case Vfpu::kRoundTowardNegative:
+      return RoundToNarrow<FT, Vfpu::kRoundTowardNegative>(a, saturate, tininess_before_rounding);
+    default:
+      return RoundToNarrow<FT, Vfpu::kRoundTowardZero>(a, saturate, tininess_before_rounding);
+  }
+}
+
+}  // namespace FfUtils
@@ -16,13 +16,13 @@ constexpr UT SoftFloat::NormalizeSubnormal(i32& exp, UT mant) {
   return mant << shift;
 }
 
-template <typename FT, typename UT>
+template <typename FT, Vfpu::RoundingMode rm, typename UT>
 constexpr FT SoftFloat::Normalize(u32 a_sign, i32 a_exp, UT a_mant) {
   int shift = std::countl_zero(a_mant) - (NumBits<FT>() - 1 - NumImantBits<FT>());
-  return RoundPack<FT>(a_sign, a_exp - shift, (UT)(a_mant << shift));
+  return RoundPack<FT, rm>(a_sign, a_exp - shift, (UT)(a_mant << shift));
 }
 
-template <typename FT, typename UT>
+template <typename FT, Vfpu::RoundingMode rm, typename UT>
 constexpr FT SoftFloat::Normalize(u32 a_sign, i32 a_exp, UT a_mant1, UT a_mant0) {
   int l = a_mant1 ? std::countl_zero(a_mant1) : NumBits<FT>() + std::countl_zero(a_mant0);
   int shift = l - (NumBits<FT>() - 1 - NumImantBits<FT>());
@@ -36,7 +36,7 @@ constexpr FT SoftFloat::Normalize(u32 a_sign, i32 a_exp, UT a_mant1, UT a_mant0)
     a_mant1 = a_mant0 << (shift - NumBits<FT>());
   }
 
-  return RoundPack<FT>(a_sign, a_exp - shift, a_mant1);
+  return RoundPack<FT, rm>(a_sign, a_exp - shift, a_mant1);
 }
 
 template <typename UT>
@@ -47,19 +47,10 @@ constexpr UT RshiftRnd(UT a, int d) {
   if (d >= NumBits<UT>())
     return !!a;
 
-  UT mask = (1ull << d) - 1ull;
+  UT mask = (static_cast<UT>(1) << d) - 1;
   return (a >> d) | !!(a & mask);
 }
 
-template <typename UT>
-constexpr std::pair<UT, UT> Umul(UT a, UT b) {
-  static_assert(std::is_integral_v<UT>);
-  auto ta = static_cast<typename TwiceWidthType<UT>::type>(a);
-  auto tb = static_cast<typename TwiceWidthType<UT>::type>(b);
-  auto r = ta * tb;
-  return std::make_pair(r, r >> NumBits<UT>());
-}
-
 template <typename UT>
 constexpr std::pair<UT, UT> DivRem(UT ah, UT al, UT b) {
   static_assert(std::is_integral_v<UT>);
@@ -68,6 +59,23 @@ constexpr std::pair<UT, UT> DivRem(UT ah, UT al, UT b) {
   return std::make_pair(a / b, a % b);
 }
 
+// Restoring long division of ah:al by b. Requires ah < b so the quotient fits into 128 bits.
+template <>
+constexpr std::pair<u128, u128> DivRem(u128 ah, u128 al, u128 b) {
+  u128 q = 0;
+  u128 r = ah;
+  for (int i = 127; i >= 0; --i) {
+    bool carry = r >> 127;
+    r = (r << 1) | ((al >> i) & 1);
+    q <<= 1;
+    if (carry || r >= b) {
+      r -= b;
+      q |= 1;
+    }
+  }
+  return std::make_pair(q, r);
+}
+
 template <typename UT>
 constexpr bool Usqrt(UT& root, UT ah, UT al) {
   static_assert(std::is_integral_v<UT>);
@@ -92,31 +100,50 @@ constexpr bool Usqrt(UT& root, UT ah, UT al) {
   return (a - s * s) != 0;
 }
 
-template <typename FT, typename UT>
-constexpr FT SoftFloat::RoundPack(bool a_sign, i32 a_exp, UT a_mant) {
-  u32 addend, rnd_bits;
-  switch (rounding_mode) {
-  case kRoundTiesToEven:
-    [[fallthrough]];
-  case kRoundTiesToAway:
-    addend = 1u << (NumRoundBits<FT>() - 1);
-    break;
-  case kRoundTowardZero:
-    addend = 0;
-    break;
-  default:
-  case kRoundTowardNegative:
-    addend = a_sign ? RoundMask<FT>() : 0;
-    break;
-  case kRoundTowardPositive:
-    addend = !a_sign ? RoundMask<FT>() : 0;
-    break;
+// Digit-by-digit square root of ah:al, consuming two radicand bits per step. The invariant rem <= 2 * s keeps the
+// partial remainder within 128 bits as long as the root does not exceed 127 bits.
+template <>
+constexpr bool Usqrt(u128& root, u128 ah, u128 al) {
+  u128 s = 0;
+  u128 rem = 0;
+  for (int i = 127; i >= 0; --i) {
+    u32 d = i >= 64 ? static_cast<u32>(ah >> (2 * i - 128)) & 3u : static_cast<u32>(al >> (2 * i)) & 3u;
+    if (rem > s || (rem == s && d != 0)) {
+      rem = ((rem - s - 1) << 2) + d + 3;
+      s = (s << 1) | 1;
+    } else {
+      rem = (rem << 2) | d;
+      s <<= 1;
+    }
   }
+  root = s;
+  return rem != 0;
+}
+
+template <Vfpu::RoundingMode rm>
+constexpr u32 RoundAddend(bool a_sign, u32 half, u32 mask) {
+  if constexpr (rm == Vfpu::kRoundTiesToEven || rm == Vfpu::kRoundTiesToAway) {
+    return half;
+  } else if constexpr (rm == Vfpu::kRoundTowardZero) {
+    return 0;
+  } else if constexpr (rm == Vfpu::kRoundTowardNegative) {
+    return a_sign ? mask : 0;
+  } else if constexpr (rm == Vfpu::kRoundTowardPositive) {
+    return !a_sign ? mask : 0;
+  } else {
+    static_assert(false, "Using unsupported rounding mode");
+  }
+}
+
+template <typename FT, Vfpu::RoundingMode rm, typename UT>
+constexpr FT SoftFloat::RoundPack(bool a_sign, i32 a_exp, UT a_mant) {
+  u32 addend = RoundAddend<rm>(a_sign, 1u << (NumRoundBits<FT>() - 1), RoundMask<FT>());
+  u32 rnd_bits;
 
   if (a_exp > 0) {
     rnd_bits = a_mant & RoundMask<FT>();
   } else {
-    bool subnormal = a_exp < 0 || (a_mant + addend) < (1ull << (NumBits<FT>() - 1));
+    bool subnormal = a_exp < 0 || (a_mant + addend) < (static_cast<UT>(1) << (NumBits<FT>() - 1));
     subnormal = tininess_before_rounding ? true : subnormal;
     a_mant = RshiftRnd<UT>(a_mant, 1 - a_exp);
     rnd_bits = a_mant & RoundMask<FT>();
@@ -129,8 +156,10 @@ constexpr FT SoftFloat::RoundPack(bool a_sign, i32 a_exp, UT a_mant) {
     inexact = true;
 
   a_mant = (a_mant + addend) >> NumRoundBits<FT>();
-  if (rounding_mode == kRoundTiesToEven && rnd_bits == 1 << (NumRoundBits<FT>() - 1))
-    a_mant &= ~1;
+  if constexpr (rm == kRoundTiesToEven) {
+    if (rnd_bits == 1 << (NumRoundBits<FT>() - 1))
+      a_mant &= ~1;
+  }
 
   a_exp += a_mant >> (NumSignificandBits<FT>() + 1);
   if (a_mant <= MaxSignificand<FT>()) {
@@ -145,7 +174,7 @@ constexpr FT SoftFloat::RoundPack(bool a_sign, i32 a_exp, UT a_mant) {
   return FloatFrom3Tuple<FT>(a_sign, a_exp, a_mant);
 }
 
-template <typename FT>
+template <typename FT, Vfpu::RoundingMode rm>
 FT SoftFloat::Add(FT a, FT b) {
   using UT = FloatToUint<FT>::type;
 
@@ -191,18 +220,57 @@ FT SoftFloat::Add(FT a, FT b) {
   else {
     a_mant -= b_mant;
     if (a_mant == 0)
-      a_sign = (rounding_mode == kRoundTowardNegative);
+      a_sign = (rm == kRoundTowardNegative);
   }
 
   a_exp += NumRoundBits<FT>() - 3;
-  return Normalize<FT>(a_sign, a_exp, a_mant);
+  return Normalize<FT, rm>(a_sign, a_exp, a_mant);
+}
+
+template f16 SoftFloat::Add<f16, SoftFloat::kRoundTiesToEven>(f16 a, f16 b);
+template f16 SoftFloat::Add<f16, SoftFloat::kRoundTowardPositive>(f16 a, f16 b);
+template f16 SoftFloat::Add<f16, SoftFloat::kRoundTowardNegative>(f16 a, f16 b);
+template f16 SoftFloat::Add<f16, SoftFloat::kRoundTowardZero>(f16 a, f16 b);
+template f16 SoftFloat::Add<f16, SoftFloat::kRoundTiesToAway>(f16 a, f16 b);
+
+template bf16 SoftFloat::Add<bf16, SoftFloat::kRoundTiesToEven>(bf16 a, bf16 b);
+template bf16 SoftFloat::Add<bf16, SoftFloat::kRoundTowardPositive>(bf16 a, bf16 b);
+template bf16 SoftFloat::Add<bf16, SoftFloat::kRoundTowardNegative>(bf16 a, bf16 b);
+template bf16 SoftFloat::Add<bf16, SoftFloat::kRoundTowardZero>(bf16 a, bf16 b);
+template bf16 SoftFloat::Add<bf16, SoftFloat::kRoundTiesToAway>(bf16 a, bf16 b);
+
+template f32 SoftFloat::Add<f32, SoftFloat::kRoundTiesToEven>(f32 a, f32 b);
+template f32 SoftFloat::Add<f32, SoftFloat::kRoundTowardPositive>(f32 a, f32 b);
+template f32 SoftFloat::Add<f32, SoftFloat::kRoundTowardNegative>(f32 a, f32 b);
+template f32 SoftFloat::Add<f32, SoftFloat::kRoundTowardZero>(f32 a, f32 b);
+template f32 SoftFloat::Add<f32, SoftFloat::kRoundTiesToAway>(f32 a, f32 b);
+
+template f64 SoftFloat::Add<f64, SoftFloat::kRoundTiesToEven>(f64 a, f64 b);
+template f64 SoftFloat::Add<f64, SoftFloat::kRoundTowardPositive>(f64 a, f64 b);
+template f64 SoftFloat::Add<f64, SoftFloat::kRoundTowardNegative>(f64 a, f64 b);
+template f64 SoftFloat::Add<f64, SoftFloat::kRoundTowardZero>(f64 a, f64 b);
+template f64 SoftFloat::Add<f64, SoftFloat::kRoundTiesToAway>(f64 a, f64 b);
+
+template f128 SoftFloat::Add<f128, SoftFloat::kRoundTiesToEven>(f128 a, f128 b);
+template f128 SoftFloat::Add<f128, SoftFloat::kRoundTowardPositive>(f128 a, f128 b);
+template f128 SoftFloat::Add<f128, SoftFloat::kRoundTowardNegative>(f128 a, f128 b);
+template f128 SoftFloat::Add<f128, SoftFloat::kRoundTowardZero>(f128 a, f128 b);
+template f128 SoftFloat::Add<f128, SoftFloat::kRoundTiesToAway>(f128 a, f128 b);
+
+template <typename FT>
+FT SoftFloat::Add(FT a, FT b) {
+  FT result;
+  FLOPPY_FLOAT_FUNC_2(result, rounding_mode, Add, FT, a, b)
+  return result;
 }
 
 template f16 SoftFloat::Add<f16>(f16 a, f16 b);
+template bf16 SoftFloat::Add<bf16>(bf16 a, bf16 b);
 template f32 SoftFloat::Add<f32>(f32 a, f32 b);
 template f64 SoftFloat::Add<f64>(f64 a, f64 b);
+template f128 SoftFloat::Add<f128>(f128 a, f128 b);
 
-template <typename FT>
+template <typename FT, Vfpu::RoundingMode rm>
 FT SoftFloat::Sub(FT a, FT b) {
   using UT = FloatToUint<FT>::type;
 
@@ -255,19 +323,58 @@ FT SoftFloat::Sub(FT a, FT b) {
   else {
     a_mant -= b_mant;
     if (a_mant == 0)
-      a_sign = (rounding_mode == kRoundTowardNegative);
+      a_sign = (rm == kRoundTowardNegative);
   }
 
   a_exp += NumRoundBits<FT>() - 3;
-  return Normalize<FT>(a_sign, a_exp, a_mant);
+  return Normalize<FT, rm>(a_sign, a_exp, a_mant);
+}
+
+template f16 SoftFloat::Sub<f16, SoftFloat::kRoundTiesToEven>(f16 a, f16 b);
+template f16 SoftFloat::Sub<f16, SoftFloat::kRoundTowardPositive>(f16 a, f16 b);
+template f16 SoftFloat::Sub<f16, SoftFloat::kRoundTowardNegative>(f16 a, f16 b);
+template f16 SoftFloat::Sub<f16, SoftFloat::kRoundTowardZero>(f16 a, f16 b);
+template f16 SoftFloat::Sub<f16, SoftFloat::kRoundTiesToAway>(f16 a, f16 b);
+
+template bf16 SoftFloat::Sub<bf16, SoftFloat::kRoundTiesToEven>(bf16 a, bf16 b);
+template bf16 SoftFloat::Sub<bf16, SoftFloat::kRoundTowardPositive>(bf16 a, bf16 b);
+template bf16 SoftFloat::Sub<bf16, SoftFloat::kRoundTowardNegative>(bf16 a, bf16 b);
+template bf16 SoftFloat::Sub<bf16, SoftFloat::kRoundTowardZero>(bf16 a, bf16 b);
+template bf16 SoftFloat::Sub<bf16, SoftFloat::kRoundTiesToAway>(bf16 a, bf16 b);
+
+template f32 SoftFloat::Sub<f32, SoftFloat::kRoundTiesToEven>(f32 a, f32 b);
+template f32 SoftFloat::Sub<f32, SoftFloat::kRoundTowardPositive>(f32 a, f32 b);
+template f32 SoftFloat::Sub<f32, SoftFloat::kRoundTowardNegative>(f32 a, f32 b);
+template f32 SoftFloat::Sub<f32, SoftFloat::kRoundTowardZero>(f32 a, f32 b);
+template f32 SoftFloat::Sub<f32, SoftFloat::kRoundTiesToAway>(f32 a, f32 b);
+
+template f64 SoftFloat::Sub<f64, SoftFloat::kRoundTiesToEven>(f64 a, f64 b);
+template f64 SoftFloat::Sub<f64, SoftFloat::kRoundTowardPositive>(f64 a, f64 b);
+template f64 SoftFloat::Sub<f64, SoftFloat::kRoundTowardNegative>(f64 a, f64 b);
+template f64 SoftFloat::Sub<f64, SoftFloat::kRoundTowardZero>(f64 a, f64 b);
+template f64 SoftFloat::Sub<f64, SoftFloat::kRoundTiesToAway>(f64 a, f64 b);
+
+template f128 SoftFloat::Sub<f128, SoftFloat::kRoundTiesToEven>(f128 a, f128 b);
+template f128 SoftFloat::Sub<f128, SoftFloat::kRoundTowardPositive>(f128 a, f128 b);
+template f128 SoftFloat::Sub<f128, SoftFloat::kRoundTowardNegative>(f128 a, f128 b);
+template f128 SoftFloat::Sub<f128, SoftFloat::kRoundTowardZero>(f128 a, f128 b);
+template f128 SoftFloat::Sub<f128, SoftFloat::kRoundTiesToAway>(f128 a, f128 b);
+
+template <typename FT>
+FT SoftFloat::Sub(FT a, FT b) {
+  FT result;
+  FLOPPY_FLOAT_FUNC_2(result, rounding_mode, Sub, FT, a, b)
+  return result;
 }
 
 template f16 SoftFloat::Sub<f16>(f16 a, f16 b);
+template bf16 SoftFloat::Sub<bf16>(bf16 a, bf16 b);
 template f32 SoftFloat::Sub<f32>(f32 a, f32 b);
 template f64 SoftFloat::Sub<f64>(f64 a, f64 b);
+template f128 SoftFloat::Sub<f128>(f128 a, f128 b);
 
-template <typename FT>
-inline FT SoftFloat::Mul(FT a, FT b) {
+template <typename FT, Vfpu::RoundingMode rm>
+FT SoftFloat::Mul(FT a, FT b) {
   using UT = FloatToUint<FT>::type;
 
   if (IsNan(a) || IsNan(b)) [[unlikely]] {
@@ -321,14 +428,53 @@ inline FT SoftFloat::Mul(FT a, FT b) {
   auto [lo, hi] = Umul((UT)(a_mant << NumRoundBits<FT>()), (UT)(b_mant << (NumRoundBits<FT>() + 1)));
 
   UT r_mant = hi | !!lo;
-  return Normalize<FT>(r_sign, r_exp, r_mant);
+  return Normalize<FT, rm>(r_sign, r_exp, r_mant);
+}
+
+template f16 SoftFloat::Mul<f16, SoftFloat::kRoundTiesToEven>(f16 a, f16 b);
+template f16 SoftFloat::Mul<f16, SoftFloat::kRoundTowardPositive>(f16 a, f16 b);
+template f16 SoftFloat::Mul<f16, SoftFloat::kRoundTowardNegative>(f16 a, f16 b);
+template f16 SoftFloat::Mul<f16, SoftFloat::kRoundTowardZero>(f16 a, f16 b);
+template f16 SoftFloat::Mul<f16, SoftFloat::kRoundTiesToAway>(f16 a, f16 b);
+
+template bf16 SoftFloat::Mul<bf16, SoftFloat::kRoundTiesToEven>(bf16 a, bf16 b);
+template bf16 SoftFloat::Mul<bf16, SoftFloat::kRoundTowardPositive>(bf16 a, bf16 b);
+template bf16 SoftFloat::Mul<bf16, SoftFloat::kRoundTowardNegative>(bf16 a, bf16 b);
+template bf16 SoftFloat::Mul<bf16, SoftFloat::kRoundTowardZero>(bf16 a, bf16 b);
+template bf16 SoftFloat::Mul<bf16, SoftFloat::kRoundTiesToAway>(bf16 a, bf16 b);
+
+template f32 SoftFloat::Mul<f32, SoftFloat::kRoundTiesToEven>(f32 a, f32 b);
+template f32 SoftFloat::Mul<f32, SoftFloat::kRoundTowardPositive>(f32 a, f32 b);
+template f32 SoftFloat::Mul<f32, SoftFloat::kRoundTowardNegative>(f32 a, f32 b);
+template f32 SoftFloat::Mul<f32, SoftFloat::kRoundTowardZero>(f32 a, f32 b);
+template f32 SoftFloat::Mul<f32, SoftFloat::kRoundTiesToAway>(f32 a, f32 b);
+
+template f64 SoftFloat::Mul<f64, SoftFloat::kRoundTiesToEven>(f64 a, f64 b);
+template f64 SoftFloat::Mul<f64, SoftFloat::kRoundTowardPositive>(f64 a, f64 b);
+template f64 SoftFloat::Mul<f64, SoftFloat::kRoundTowardNegative>(f64 a, f64 b);
+template f64 SoftFloat::Mul<f64, SoftFloat::kRoundTowardZero>(f64 a, f64 b);
+template f64 SoftFloat::Mul<f64, SoftFloat::kRoundTiesToAway>(f64 a, f64 b);
+
+template f128 SoftFloat::Mul<f128, SoftFloat::kRoundTiesToEven>(f128 a, f128 b);
+template f128 SoftFloat::Mul<f128, SoftFloat::kRoundTowardPositive>(f128 a, f128 b);
+template f128 SoftFloat::Mul<f128, SoftFloat::kRoundTowardNegative>(f128 a, f128 b);
+template f128 SoftFloat::Mul<f128, SoftFloat::kRoundTowardZero>(f128 a, f128 b);
+template f128 SoftFloat::Mul<f128, SoftFloat::kRoundTiesToAway>(f128 a, f128 b);
+
+template <typename FT>
+FT SoftFloat::Mul(FT a, FT b) {
+  FT result;
+  FLOPPY_FLOAT_FUNC_2(result, rounding_mode, Mul, FT, a, b)
+  return result;
 }
 
 template f16 SoftFloat::Mul<f16>(f16 a, f16 b);
+template bf16 SoftFloat::Mul<bf16>(bf16 a, bf16 b);
 template f32 SoftFloat::Mul<f32>(f32 a, f32 b);
 template f64 SoftFloat::Mul<f64>(f64 a, f64 b);
+template f128 SoftFloat::Mul<f128>(f128 a, f128 b);
 
-template <typename FT>
+template <typename FT, Vfpu::RoundingMode rm>
 FT SoftFloat::Div(FT a, FT b) {
   using UT = FloatToUint<FT>::type;
 
@@ -395,14 +541,53 @@ FT SoftFloat::Div(FT a, FT b) {
   if (r != 0)
     r_mant |= 1;
 
-  return Normalize<FT>(r_sign, r_exp, r_mant);
+  return Normalize<FT, rm>(r_sign, r_exp, r_mant);
+}
+
+template f16 SoftFloat::Div<f16, SoftFloat::kRoundTiesToEven>(f16 a, f16 b);
+template f16 SoftFloat::Div<f16, SoftFloat::kRoundTowardPositive>(f16 a, f16 b);
+template f16 SoftFloat::Div<f16, SoftFloat::kRoundTowardNegative>(f16 a, f16 b);
+template f16 SoftFloat::Div<f16, SoftFloat::kRoundTowardZero>(f16 a, f16 b);
+template f16 SoftFloat::Div<f16, SoftFloat::kRoundTiesToAway>(f16 a, f16 b);
+
+template bf16 SoftFloat::Div<bf16, SoftFloat::kRoundTiesToEven>(bf16 a, bf16 b);
+template bf16 SoftFloat::Div<bf16, SoftFloat::kRoundTowardPositive>(bf16 a, bf16 b);
+template bf16 SoftFloat::Div<bf16, SoftFloat::kRoundTowardNegative>(bf16 a, bf16 b);
+template bf16 SoftFloat::Div<bf16, SoftFloat::kRoundTowardZero>(bf16 a, bf16 b);
+template bf16 SoftFloat::Div<bf16, SoftFloat::kRoundTiesToAway>(bf16 a, bf16 b);
+
+template f32 SoftFloat::Div<f32, SoftFloat::kRoundTiesToEven>(f32 a, f32 b);
+template f32 SoftFloat::Div<f32, SoftFloat::kRoundTowardPositive>(f32 a, f32 b);
+template f32 SoftFloat::Div<f32, SoftFloat::kRoundTowardNegative>(f32 a, f32 b);
+template f32 SoftFloat::Div<f32, SoftFloat::kRoundTowardZero>(f32 a, f32 b);
+template f32 SoftFloat::Div<f32, SoftFloat::kRoundTiesToAway>(f32 a, f32 b);
+
+template f64 SoftFloat::Div<f64, SoftFloat::kRoundTiesToEven>(f64 a, f64 b);
+template f64 SoftFloat::Div<f64, SoftFloat::kRoundTowardPositive>(f64 a, f64 b);
+template f64 SoftFloat::Div<f64, SoftFloat::kRoundTowardNegative>(f64 a, f64 b);
+template f64 SoftFloat::Div<f64, SoftFloat::kRoundTowardZero>(f64 a, f64 b);
+template f64 SoftFloat::Div<f64, SoftFloat::kRoundTiesToAway>(f64 a, f64 b);
+
+template f128 SoftFloat::Div<f128, SoftFloat::kRoundTiesToEven>(f128 a, f128 b);
+template f128 SoftFloat::Div<f128, SoftFloat::kRoundTowardPositive>(f128 a, f128 b);
+template f128 SoftFloat::Div<f128, SoftFloat::kRoundTowardNegative>(f128 a, f128 b);
+template f128 SoftFloat::Div<f128, SoftFloat::kRoundTowardZero>(f128 a, f128 b);
+template f128 SoftFloat::Div<f128, SoftFloat::kRoundTiesToAway>(f128 a, f128 b);
+
+template <typename FT>
+FT SoftFloat::Div(FT a, FT b) {
+  FT result;
+  FLOPPY_FLOAT_FUNC_2(result, rounding_mode, Div, FT, a, b)
+  return result;
 }
 
 template f16 SoftFloat::Div<f16>(f16 a, f16 b);
+template bf16 SoftFloat::Div<bf16>(bf16 a, bf16 b);
 template f32 SoftFloat::Div<f32>(f32 a, f32 b);
 template f64 SoftFloat::Div<f64>(f64 a, f64 b);
+template f128 SoftFloat::Div<f128>(f128 a, f128 b);
 
-template <typename FT>
+template <typename FT, Vfpu::RoundingMode rm>
 FT SoftFloat::Sqrt(FT a) {
   using UT = FloatToUint<FT>::type;
 
@@ -457,14 +642,53 @@ FT SoftFloat::Sqrt(FT a) {
   if (Usqrt<UT>(a_mant, a_mant, 0))
     a_mant |= 1;
 
-  return Normalize<FT>(a_sign, a_exp, a_mant);
+  return Normalize<FT, rm>(a_sign, a_exp, a_mant);
+}
+
+template f16 SoftFloat::Sqrt<f16, SoftFloat::kRoundTiesToEven>(f16 a);
+template f16 SoftFloat::Sqrt<f16, SoftFloat::kRoundTowardPositive>(f16 a);
+template f16 SoftFloat::Sqrt<f16, SoftFloat::kRoundTowardNegative>(f16 a);
+template f16 SoftFloat::Sqrt<f16, SoftFloat::kRoundTowardZero>(f16 a);
+template f16 SoftFloat::Sqrt<f16, SoftFloat::kRoundTiesToAway>(f16 a);
+
+template bf16 SoftFloat::Sqrt<bf16, SoftFloat::kRoundTiesToEven>(bf16 a);
+template bf16 SoftFloat::Sqrt<bf16, SoftFloat::kRoundTowardPositive>(bf16 a);
+template bf16 SoftFloat::Sqrt<bf16, SoftFloat::kRoundTowardNegative>(bf16 a);
+template bf16 SoftFloat::Sqrt<bf16, SoftFloat::kRoundTowardZero>(bf16 a);
+template bf16 SoftFloat::Sqrt<bf16, SoftFloat::kRoundTiesToAway>(bf16 a);
+
+template f32 SoftFloat::Sqrt<f32, SoftFloat::kRoundTiesToEven>(f32 a);
+template f32 SoftFloat::Sqrt<f32, SoftFloat::kRoundTowardPositive>(f32 a);
+template f32 SoftFloat::Sqrt<f32, SoftFloat::kRoundTowardNegative>(f32 a);
+template f32 SoftFloat::Sqrt<f32, SoftFloat::kRoundTowardZero>(f32 a);
+template f32 SoftFloat::Sqrt<f32, SoftFloat::kRoundTiesToAway>(f32 a);
+
+template f64 SoftFloat::Sqrt<f64, SoftFloat::kRoundTiesToEven>(f64 a);
+template f64 SoftFloat::Sqrt<f64, SoftFloat::kRoundTowardPositive>(f64 a);
+template f64 SoftFloat::Sqrt<f64, SoftFloat::kRoundTowardNegative>(f64 a);
+template f64 SoftFloat::Sqrt<f64, SoftFloat::kRoundTowardZero>(f64 a);
+template f64 SoftFloat::Sqrt<f64, SoftFloat::kRoundTiesToAway>(f64 a);
+
+template f128 SoftFloat::Sqrt<f128, SoftFloat::kRoundTiesToEven>(f128 a);
+template f128 SoftFloat::Sqrt<f128, SoftFloat::kRoundTowardPositive>(f128 a);
+template f128 SoftFloat::Sqrt<f128, SoftFloat::kRoundTowardNegative>(f128 a);
+template f128 SoftFloat::Sqrt<f128, SoftFloat::kRoundTowardZero>(f128 a);
+template f128 SoftFloat::Sqrt<f128, SoftFloat::kRoundTiesToAway>(f128 a);
+
+template <typename FT>
+FT SoftFloat::Sqrt(FT a) {
+  FT result;
+  FLOPPY_FLOAT_FUNC_2(result, rounding_mode, Sqrt, FT, a)
+  return result;
 }
 
 template f16 SoftFloat::Sqrt<f16>(f16 a);
+template bf16 SoftFloat::Sqrt<bf16>(bf16 a);
 template f32 SoftFloat::Sqrt<f32>(f32 a);
 template f64 SoftFloat::Sqrt<f64>(f64 a);
+template f128 SoftFloat::Sqrt<f128>(f128 a);
 
-template <typename FT>
+template <typename FT, Vfpu::RoundingMode rm>
 FT SoftFloat::Fma(FT a, FT b, FT c) {
   using UT = FloatToUint<FT>::type;
 
@@ -506,7 +730,7 @@ FT SoftFloat::Fma(FT a, FT b, FT c) {
         return c;
 
       if (c_sign != r_sign)
-        r_sign = (rounding_mode == kRoundTowardNegative);
+        r_sign = (rm == kRoundTowardNegative);
       return FloatFrom3Tuple<FT>(r_sign, 0, 0);
     }
 
@@ -521,7 +745,7 @@ FT SoftFloat::Fma(FT a, FT b, FT c) {
         return c;
 
       if (c_sign != r_sign)
-        r_sign = (rounding_mode == kRoundTowardNegative);
+        r_sign = (rm == kRoundTowardNegative);
       return FloatFrom3Tuple<FT>(r_sign, 0, 0);
     }
 
@@ -533,7 +757,7 @@ FT SoftFloat::Fma(FT a, FT b, FT c) {
   i32 r_exp = a_exp + b_exp - (1 << (NumExponentBits<FT>() - 1)) + 3;
   auto [r_mant0, r_mant1] = Umul<UT>(a_mant << NumRoundBits<FT>(), b_mant << NumRoundBits<FT>());
 
-  if (r_mant1 < (1ull << (NumBits<FT>() - 3))) {
+  if (r_mant1 < (static_cast<UT>(1) << (NumBits<FT>() - 3))) {
     r_mant1 = (r_mant1 << 1) | (r_mant0 >> (NumBits<FT>() - 1));
     r_mant0 <<= 1;
     r_exp--;
@@ -542,7 +766,7 @@ FT SoftFloat::Fma(FT a, FT b, FT c) {
   if (c_exp == 0) {
     if (c_mant == 0) {
       r_mant1 |= (r_mant0 != 0);
-      return Normalize<FT>(r_sign, r_exp, r_mant1);
+      return Normalize<FT, rm>(r_sign, r_exp, r_mant1);
     }
     c_mant = NormalizeSubnormal<FT>(c_exp, c_mant);
   } else {
@@ -580,7 +804,7 @@ FT SoftFloat::Fma(FT a, FT b, FT c) {
     c_mant0 = c_mant1 | (c_mant0 != 0);
     c_mant1 = 0;
   } else if (shift != 0) {
-    UT mask = (1ull << shift) - 1;
+    UT mask = (static_cast<UT>(1) << shift) - 1;
     c_mant0 = (c_mant1 << (NumBits<FT>() - shift)) | (c_mant0 >> shift) | ((c_mant0 & mask) != 0);
     c_mant1 = c_mant1 >> shift;
   }
@@ -593,66 +817,329 @@ FT SoftFloat::Fma(FT a, FT b, FT c) {
     r_mant0 -= c_mant0;
     r_mant1 = r_mant1 - c_mant1 - (r_mant0 > tmp);
     if ((r_mant0 | r_mant1) == 0) {
-      r_sign = (rounding_mode == kRoundTowardNegative);
+      r_sign = (rm == kRoundTowardNegative);
     }
   }
 
-  return Normalize<FT>(r_sign, r_exp, r_mant1, r_mant0);
+  return Normalize<FT, rm>(r_sign, r_exp, r_mant1, r_mant0);
+}
+
+template f16 SoftFloat::Fma<f16, SoftFloat::kRoundTiesToEven>(f16 a, f16 b, f16 c);
+template f16 SoftFloat::Fma<f16, SoftFloat::kRoundTowardPositive>(f16 a, f16 b, f16 c);
+template f16 SoftFloat::Fma<f16, SoftFloat::kRoundTowardNegative>(f16 a, f16 b, f16 c);
+template f16 SoftFloat::Fma<f16, SoftFloat::kRoundTowardZero>(f16 a, f16 b, f16 c);
+template f16 SoftFloat::Fma<f16, SoftFloat::kRoundTiesToAway>(f16 a, f16 b, f16 c);
+
+template bf16 SoftFloat::Fma<bf16, SoftFloat::kRoundTiesToEven>(bf16 a, bf16 b, bf16 c);
+template bf16 SoftFloat::Fma<bf16, SoftFloat::kRoundTowardPositive>(bf16 a, bf16 b, bf16 c);
+template bf16 SoftFloat::Fma<bf16, SoftFloat::kRoundTowardNegative>(bf16 a, bf16 b, bf16 c);
+template bf16 SoftFloat::Fma<bf16, SoftFloat::kRoundTowardZero>(bf16 a, bf16 b, bf16 c);
+template bf16 SoftFloat::Fma<bf16, SoftFloat::kRoundTiesToAway>(bf16 a, bf16 b, bf16 c);
+
+template f32 SoftFloat::Fma<f32, SoftFloat::kRoundTiesToEven>(f32 a, f32 b, f32 c);
+template f32 SoftFloat::Fma<f32, SoftFloat::kRoundTowardPositive>(f32 a, f32 b, f32 c);
+template f32 SoftFloat::Fma<f32, SoftFloat::kRoundTowardNegative>(f32 a, f32 b, f32 c);
+template f32 SoftFloat::Fma<f32, SoftFloat::kRoundTowardZero>(f32 a, f32 b, f32 c);
+template f32 SoftFloat::Fma<f32, SoftFloat::kRoundTiesToAway>(f32 a, f32 b, f32 c);
+
+template f64 SoftFloat::Fma<f64, SoftFloat::kRoundTiesToEven>(f64 a, f64 b, f64 c);
+template f64 SoftFloat::Fma<f64, SoftFloat::kRoundTowardPositive>(f64 a, f64 b, f64 c);
+template f64 SoftFloat::Fma<f64, SoftFloat::kRoundTowardNegative>(f64 a, f64 b, f64 c);
+template f64 SoftFloat::Fma<f64, SoftFloat::kRoundTowardZero>(f64 a, f64 b, f64 c);
+template f64 SoftFloat::Fma<f64, SoftFloat::kRoundTiesToAway>(f64 a, f64 b, f64 c);
+
+template f128 SoftFloat::Fma<f128, SoftFloat::kRoundTiesToEven>(f128 a, f128 b, f128 c);
+template f128 SoftFloat::Fma<f128, SoftFloat::kRoundTowardPositive>(f128 a, f128 b, f128 c);
+template f128 SoftFloat::Fma<f128, SoftFloat::kRoundTowardNegative>(f128 a, f128 b, f128 c);
+template f128 SoftFloat::Fma<f128, SoftFloat::kRoundTowardZero>(f128 a, f128 b, f128 c);
+template f128 SoftFloat::Fma<f128, SoftFloat::kRoundTiesToAway>(f128 a, f128 b, f128 c);
+
+template <typename FT>
+FT SoftFloat::Fma(FT a, FT b, FT c) {
+  FT result;
+  FLOPPY_FLOAT_FUNC_2(result, rounding_mode, Fma, FT, a, b, c)
+  return result;
 }
 
 template f16 SoftFloat::Fma<f16>(f16 a, f16 b, f16 c);
+template bf16 SoftFloat::Fma<bf16>(bf16 a, bf16 b, bf16 c);
 template f32 SoftFloat::Fma<f32>(f32 a, f32 b, f32 c);
 template f64 SoftFloat::Fma<f64>(f64 a, f64 b, f64 c);
+template f128 SoftFloat::Fma<f128>(f128 a, f128 b, f128 c);
+
+template <Vfpu::RoundingMode rm>
+f16 SoftFloat::I32ToF16(i32 a) {
+  return IToF<i32, f16, rm>(a);
+}
+
+template f16 SoftFloat::I32ToF16<SoftFloat::kRoundTiesToEven>(i32 a);
+template f16 SoftFloat::I32ToF16<SoftFloat::kRoundTowardPositive>(i32 a);
+template f16 SoftFloat::I32ToF16<SoftFloat::kRoundTowardNegative>(i32 a);
+template f16 SoftFloat::I32ToF16<SoftFloat::kRoundTowardZero>(i32 a);
+template f16 SoftFloat::I32ToF16<SoftFloat::kRoundTiesToAway>(i32 a);
 
 f16 SoftFloat::I32ToF16(i32 a) {
-  return IToF<i32, f16>(a);
+  f16 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, I32ToF16, a)
+  return result;
 }
 
+template <Vfpu::RoundingMode rm>
+f32 SoftFloat::I32ToF32(i32 a) {
+  return IToF<i32, f32, rm>(a);
+}
+
+template f32 SoftFloat::I32ToF32<SoftFloat::kRoundTiesToEven>(i32 a);
+template f32 SoftFloat::I32ToF32<SoftFloat::kRoundTowardPositive>(i32 a);
+template f32 SoftFloat::I32ToF32<SoftFloat::kRoundTowardNegative>(i32 a);
+template f32 SoftFloat::I32ToF32<SoftFloat::kRoundTowardZero>(i32 a);
+template f32 SoftFloat::I32ToF32<SoftFloat::kRoundTiesToAway>(i32 a);
+
 f32 SoftFloat::I32ToF32(i32 a) {
-  return IToF<i32, f32>(a);
+  f32 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, I32ToF32, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
+f64 SoftFloat::I32ToF64(i32 a) {
+  return IToF<i32, f64, rm>(a);
 }
 
+template f64 SoftFloat::I32ToF64<SoftFloat::kRoundTiesToEven>(i32 a);
+template f64 SoftFloat::I32ToF64<SoftFloat::kRoundTowardPositive>(i32 a);
+template f64 SoftFloat::I32ToF64<SoftFloat::kRoundTowardNegative>(i32 a);
+template f64 SoftFloat::I32ToF64<SoftFloat::kRoundTowardZero>(i32 a);
+template f64 SoftFloat::I32ToF64<SoftFloat::kRoundTiesToAway>(i32 a);
+
 f64 SoftFloat::I32ToF64(i32 a) {
-  return IToF<i32, f64>(a);
+  f64 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, I32ToF64, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
+f128 SoftFloat::I32ToF128(i32 a) {
+  return IToF<i32, f128, rm>(a);
+}
+
+template f128 SoftFloat::I32ToF128<SoftFloat::kRoundTiesToEven>(i32 a);
+template f128 SoftFloat::I32ToF128<SoftFloat::kRoundTowardPositive>(i32 a);
+template f128 SoftFloat::I32ToF128<SoftFloat::kRoundTowardNegative>(i32 a);
+template f128 SoftFloat::I32ToF128<SoftFloat::kRoundTowardZero>(i32 a);
+template f128 SoftFloat::I32ToF128<SoftFloat::kRoundTiesToAway>(i32 a);
+
+f128 SoftFloat::I32ToF128(i32 a) {
+  f128 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, I32ToF128, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
+f16 SoftFloat::U32ToF16(u32 a) {
+  return IToF<u32, f16, rm>(a);
 }
 
+template f16 SoftFloat::U32ToF16<SoftFloat::kRoundTiesToEven>(u32 a);
+template f16 SoftFloat::U32ToF16<SoftFloat::kRoundTowardPositive>(u32 a);
+template f16 SoftFloat::U32ToF16<SoftFloat::kRoundTowardNegative>(u32 a);
+template f16 SoftFloat::U32ToF16<SoftFloat::kRoundTowardZero>(u32 a);
+template f16 SoftFloat::U32ToF16<SoftFloat::kRoundTiesToAway>(u32 a);
+
 f16 SoftFloat::U32ToF16(u32 a) {
-  return IToF<u32, f16>(a);
+  f16 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, U32ToF16, a)
+  return result;
 }
 
+template <Vfpu::RoundingMode rm>
 f32 SoftFloat::U32ToF32(u32 a) {
-  return IToF<u32, f32>(a);
+  return IToF<u32, f32, rm>(a);
+}
+
+template f32 SoftFloat::U32ToF32<SoftFloat::kRoundTiesToEven>(u32 a);
+template f32 SoftFloat::U32ToF32<SoftFloat::kRoundTowardPositive>(u32 a);
+template f32 SoftFloat::U32ToF32<SoftFloat::kRoundTowardNegative>(u32 a);
+template f32 SoftFloat::U32ToF32<SoftFloat::kRoundTowardZero>(u32 a);
+template f32 SoftFloat::U32ToF32<SoftFloat::kRoundTiesToAway>(u32 a);
+
+f32 SoftFloat::U32ToF32(u32 a) {
+  f32 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, U32ToF32, a)
+  return result;
 }
 
+template <Vfpu::RoundingMode rm>
 f64 SoftFloat::U32ToF64(u32 a) {
-  return IToF<u32, f64>(a);
+  return IToF<u32, f64, rm>(a);
 }
 
+template f64 SoftFloat::U32ToF64<SoftFloat::kRoundTiesToEven>(u32 a);
+template f64 SoftFloat::U32ToF64<SoftFloat::kRoundTowardPositive>(u32 a);
+template f64 SoftFloat::U32ToF64<SoftFloat::kRoundTowardNegative>(u32 a);
+template f64 SoftFloat::U32ToF64<SoftFloat::kRoundTowardZero>(u32 a);
+template f64 SoftFloat::U32ToF64<SoftFloat::kRoundTiesToAway>(u32 a);
+
+f64 SoftFloat::U32ToF64(u32 a) {
+  f64 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, U32ToF64, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
+f128 SoftFloat::U32ToF128(u32 a) {
+  return IToF<u32, f128, rm>(a);
+}
+
+template f128 SoftFloat::U32ToF128<SoftFloat::kRoundTiesToEven>(u32 a);
+template f128 SoftFloat::U32ToF128<SoftFloat::kRoundTowardPositive>(u32 a);
+template f128 SoftFloat::U32ToF128<SoftFloat::kRoundTowardNegative>(u32 a);
+template f128 SoftFloat::U32ToF128<SoftFloat::kRoundTowardZero>(u32 a);
+template f128 SoftFloat::U32ToF128<SoftFloat::kRoundTiesToAway>(u32 a);
+
+f128 SoftFloat::U32ToF128(u32 a) {
+  f128 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, U32ToF128, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
 f16 SoftFloat::I64ToF16(i64 a) {
-  return IToF<i64, f16>(a);
+  return IToF<i64, f16, rm>(a);
 }
 
+template f16 SoftFloat::I64ToF16<SoftFloat::kRoundTiesToEven>(i64 a);
+template f16 SoftFloat::I64ToF16<SoftFloat::kRoundTowardPositive>(i64 a);
+template f16 SoftFloat::I64ToF16<SoftFloat::kRoundTowardNegative>(i64 a);
+template f16 SoftFloat::I64ToF16<SoftFloat::kRoundTowardZero>(i64 a);
+template f16 SoftFloat::I64ToF16<SoftFloat::kRoundTiesToAway>(i64 a);
+
+f16 SoftFloat::I64ToF16(i64 a) {
+  f16 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, I64ToF16, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
 f32 SoftFloat::I64ToF32(i64 a) {
-  return IToF<i64, f32>(a);
+  return IToF<i64, f32, rm>(a);
 }
 
+template f32 SoftFloat::I64ToF32<SoftFloat::kRoundTiesToEven>(i64 a);
+template f32 SoftFloat::I64ToF32<SoftFloat::kRoundTowardPositive>(i64 a);
+template f32 SoftFloat::I64ToF32<SoftFloat::kRoundTowardNegative>(i64 a);
+template f32 SoftFloat::I64ToF32<SoftFloat::kRoundTowardZero>(i64 a);
+template f32 SoftFloat::I64ToF32<SoftFloat::kRoundTiesToAway>(i64 a);
+
+f32 SoftFloat::I64ToF32(i64 a) {
+  f32 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, I64ToF32, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
 f64 SoftFloat::I64ToF64(i64 a) {
-  return IToF<i64, f64>(a);
+  return IToF<i64, f64, rm>(a);
 }
 
+template f64 SoftFloat::I64ToF64<SoftFloat::kRoundTiesToEven>(i64 a);
+template f64 SoftFloat::I64ToF64<SoftFloat::kRoundTowardPositive>(i64 a);
+template f64 SoftFloat::I64ToF64<SoftFloat::kRoundTowardNegative>(i64 a);
+template f64 SoftFloat::I64ToF64<SoftFloat::kRoundTowardZero>(i64 a);
+template f64 SoftFloat::I64ToF64<SoftFloat::kRoundTiesToAway>(i64 a);
+
+f64 SoftFloat::I64ToF64(i64 a) {
+  f64 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, I64ToF64, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
+f128 SoftFloat::I64ToF128(i64 a) {
+  return IToF<i64, f128, rm>(a);
+}
+
+template f128 SoftFloat::I64ToF128<SoftFloat::kRoundTiesToEven>(i64 a);
+template f128 SoftFloat::I64ToF128<SoftFloat::kRoundTowardPositive>(i64 a);
+template f128 SoftFloat::I64ToF128<SoftFloat::kRoundTowardNegative>(i64 a);
+template f128 SoftFloat::I64ToF128<SoftFloat::kRoundTowardZero>(i64 a);
+template f128 SoftFloat::I64ToF128<SoftFloat::kRoundTiesToAway>(i64 a);
+
+f128 SoftFloat::I64ToF128(i64 a) {
+  f128 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, I64ToF128, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
 f16 SoftFloat::U64ToF16(u64 a) {
-  return IToF<u64, f16>(a);
+  return IToF<u64, f16, rm>(a);
 }
 
+template f16 SoftFloat::U64ToF16<SoftFloat::kRoundTiesToEven>(u64 a);
+template f16 SoftFloat::U64ToF16<SoftFloat::kRoundTowardPositive>(u64 a);
+template f16 SoftFloat::U64ToF16<SoftFloat::kRoundTowardNegative>(u64 a);
+template f16 SoftFloat::U64ToF16<SoftFloat::kRoundTowardZero>(u64 a);
+template f16 SoftFloat::U64ToF16<SoftFloat::kRoundTiesToAway>(u64 a);
+
+f16 SoftFloat::U64ToF16(u64 a) {
+  f16 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, U64ToF16, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
 f32 SoftFloat::U64ToF32(u64 a) {
-  return IToF<u64, f32>(a);
+  return IToF<u64, f32, rm>(a);
+}
+
+template f32 SoftFloat::U64ToF32<SoftFloat::kRoundTiesToEven>(u64 a);
+template f32 SoftFloat::U64ToF32<SoftFloat::kRoundTowardPositive>(u64 a);
+template f32 SoftFloat::U64ToF32<SoftFloat::kRoundTowardNegative>(u64 a);
+template f32 SoftFloat::U64ToF32<SoftFloat::kRoundTowardZero>(u64 a);
+template f32 SoftFloat::U64ToF32<SoftFloat::kRoundTiesToAway>(u64 a);
+
+f32 SoftFloat::U64ToF32(u64 a) {
+  f32 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, U64ToF32, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
+f64 SoftFloat::U64ToF64(u64 a) {
+  return IToF<u64, f64, rm>(a);
 }
 
+template f64 SoftFloat::U64ToF64<SoftFloat::kRoundTiesToEven>(u64 a);
+template f64 SoftFloat::U64ToF64<SoftFloat::kRoundTowardPositive>(u64 a);
+template f64 SoftFloat::U64ToF64<SoftFloat::kRoundTowardNegative>(u64 a);
+template f64 SoftFloat::U64ToF64<SoftFloat::kRoundTowardZero>(u64 a);
+template f64 SoftFloat::U64ToF64<SoftFloat::kRoundTiesToAway>(u64 a);
+
 f64 SoftFloat::U64ToF64(u64 a) {
-  return IToF<u64, f64>(a);
+  f64 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, U64ToF64, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
+f128 SoftFloat::U64ToF128(u64 a) {
+  return IToF<u64, f128, rm>(a);
+}
+
+template f128 SoftFloat::U64ToF128<SoftFloat::kRoundTiesToEven>(u64 a);
+template f128 SoftFloat::U64ToF128<SoftFloat::kRoundTowardPositive>(u64 a);
+template f128 SoftFloat::U64ToF128<SoftFloat::kRoundTowardNegative>(u64 a);
+template f128 SoftFloat::U64ToF128<SoftFloat::kRoundTowardZero>(u64 a);
+template f128 SoftFloat::U64ToF128<SoftFloat::kRoundTiesToAway>(u64 a);
+
+f128 SoftFloat::U64ToF128(u64 a) {
+  f128 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, U64ToF128, a)
+  return result;
 }
 
-template <typename TFROM, typename TTO>
+template <typename TFROM, typename TTO, Vfpu::RoundingMode rm>
 TTO SoftFloat::FToF(TFROM a) {
   static_assert(std::is_floating_point_v<TFROM>);
   static_assert(std::is_floating_point_v<TTO>);
@@ -677,21 +1164,17 @@ TTO SoftFloat::FToF(TFROM a) {
   if (a_exp == 0) {
     if (a_mant == 0)
       return FloatFrom3Tuple<TTO>(a_sign, 0, 0);
-    NormalizeSubnormal<TTO>(a_exp, a_mant);
+    a_mant = NormalizeSubnormal<TFROM>(a_exp, a_mant);
   } else {
     a_mant |= static_cast<UTFROM>(1) << NumSignificandBits<TFROM>();
   }
 
   a_exp = a_exp - Bias<TFROM>() + Bias<TTO>();
   a_mant = RshiftRnd<UTFROM>(a_mant, NumSignificandBits<TFROM>() - (NumBits<TTO>() - 2));
-  return Normalize<TTO>(a_sign, a_exp, static_cast<UTTO>(a_mant));
+  return Normalize<TTO, rm>(a_sign, a_exp, static_cast<UTTO>(a_mant));
 }
 
-template f16 SoftFloat::FToF<f32, f16>(f32 a);
-template f16 SoftFloat::FToF<f64, f16>(f64 a);
-template f32 SoftFloat::FToF<f64, f32>(f64 a);
-
-template <typename TFROM, typename TTO>
+template <typename TFROM, typename TTO, Vfpu::RoundingMode rm>
 TTO SoftFloat::FToI(TFROM a) {
   static_assert(std::is_floating_point_v<TFROM>);
   static_assert(std::is_integral_v<TTO>);
@@ -739,33 +1222,16 @@ TTO SoftFloat::FToI(TFROM a) {
     }
 
   } else {
-    u32 addend = 0;
     a_mant = RshiftRnd<UTFROM>(a_mant, -a_exp);
-
-    switch (rounding_mode) {
-    case kRoundTiesToEven:
-      [[fallthrough]];
-    case kRoundTiesToAway:
-      addend = 1 << (NumRoundBits<TFROM>() - 1);
-      break;
-    case kRoundTowardZero:
-      addend = 0;
-      break;
-    case kRoundTowardNegative:
-      addend = a_sign ? (1 << NumRoundBits<TFROM>()) - 1 : 0;
-      break;
-    case kRoundTowardPositive:
-      addend = !a_sign ? (1 << NumRoundBits<TFROM>()) - 1 : 0;
-      break;
-    default:
-      break;
-    }
+    u32 addend = RoundAddend<rm>(a_sign, 1 << (NumRoundBits<TFROM>() - 1), (1 << NumRoundBits<TFROM>()) - 1);
 
     auto rnd_bits = a_mant & ((1 << NumRoundBits<TFROM>()) - 1);
     a_mant = (a_mant + addend) >> NumRoundBits<TFROM>();
 
-    if (rounding_mode == kRoundTiesToEven && rnd_bits == 1 << (NumRoundBits<TFROM>() - 1))
-      a_mant &= ~1;
+    if constexpr (rm == kRoundTiesToEven) {
+      if (rnd_bits == 1 << (NumRoundBits<TFROM>() - 1))
+        a_mant &= ~1;
+    }
 
     if (a_mant > r_max) {
       invalid = true;
@@ -783,20 +1249,7 @@ TTO SoftFloat::FToI(TFROM a) {
   return r;
 }
 
-template i32 SoftFloat::FToI<f16, i32>(f16 a);
-template i64 SoftFloat::FToI<f16, i64>(f16 a);
-template u32 SoftFloat::FToI<f16, u32>(f16 a);
-template u64 SoftFloat::FToI<f16, u64>(f16 a);
-template i32 SoftFloat::FToI<f32, i32>(f32 a);
-template i64 SoftFloat::FToI<f32, i64>(f32 a);
-template u32 SoftFloat::FToI<f32, u32>(f32 a);
-template u64 SoftFloat::FToI<f32, u64>(f32 a);
-template i32 SoftFloat::FToI<f64, i32>(f64 a);
-template i64 SoftFloat::FToI<f64, i64>(f64 a);
-template u32 SoftFloat::FToI<f64, u32>(f64 a);
-template u64 SoftFloat::FToI<f64, u64>(f64 a);
-
-template <typename TFROM, typename TTO>
+template <typename TFROM, typename TTO, Vfpu::RoundingMode rm>
 TTO SoftFloat::IToF(TFROM a) {
   using UTTO = FloatToUint<TTO>::type;
   typedef typename std::make_unsigned<TFROM>::type UT;
@@ -823,71 +1276,381 @@ TTO SoftFloat::IToF(TFROM a) {
     a_exp += l;
   }
   a_mant = r;
-  return Normalize<TTO>(a_sign, a_exp, static_cast<UTTO>(a_mant));
+  return Normalize<TTO, rm>(a_sign, a_exp, static_cast<UTTO>(a_mant));
 }
 
-template f16 SoftFloat::IToF<i32, f16>(i32 a);
-template f32 SoftFloat::IToF<i32, f32>(i32 a);
-template f64 SoftFloat::IToF<i32, f64>(i32 a);
+template <Vfpu::RoundingMode rm>
+i32 SoftFloat::F16ToI32(f16 a) {
+  return FToI<f16, i32, rm>(a);
+}
+
+template i32 SoftFloat::F16ToI32<SoftFloat::kRoundTiesToEven>(f16 a);
+template i32 SoftFloat::F16ToI32<SoftFloat::kRoundTowardPositive>(f16 a);
+template i32 SoftFloat::F16ToI32<SoftFloat::kRoundTowardNegative>(f16 a);
+template i32 SoftFloat::F16ToI32<SoftFloat::kRoundTowardZero>(f16 a);
+template i32 SoftFloat::F16ToI32<SoftFloat::kRoundTiesToAway>(f16 a);
 
 i32 SoftFloat::F16ToI32(f16 a) {
-  return FToI<f16, i32>(a);
+  i32 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, F16ToI32, a)
+  return result;
 }
 
+template <Vfpu::RoundingMode rm>
 i64 SoftFloat::F16ToI64(f16 a) {
-  return FToI<f16, i64>(a);
+  return FToI<f16, i64, rm>(a);
 }
 
+template i64 SoftFloat::F16ToI64<SoftFloat::kRoundTiesToEven>(f16 a);
+template i64 SoftFloat::F16ToI64<SoftFloat::kRoundTowardPositive>(f16 a);
+template i64 SoftFloat::F16ToI64<SoftFloat::kRoundTowardNegative>(f16 a);
+template i64 SoftFloat::F16ToI64<SoftFloat::kRoundTowardZero>(f16 a);
+template i64 SoftFloat::F16ToI64<SoftFloat::kRoundTiesToAway>(f16 a);
+
+i64 SoftFloat::F16ToI64(f16 a) {
+  i64 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, F16ToI64, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
 u32 SoftFloat::F16ToU32(f16 a) {
-  return FToI<f16, u32>(a);
+  return FToI<f16, u32, rm>(a);
 }
 
+template u32 SoftFloat::F16ToU32<SoftFloat::kRoundTiesToEven>(f16 a);
+template u32 SoftFloat::F16ToU32<SoftFloat::kRoundTowardPositive>(f16 a);
+template u32 SoftFloat::F16ToU32<SoftFloat::kRoundTowardNegative>(f16 a);
+template u32 SoftFloat::F16ToU32<SoftFloat::kRoundTowardZero>(f16 a);
+template u32 SoftFloat::F16ToU32<SoftFloat::kRoundTiesToAway>(f16 a);
+
+u32 SoftFloat::F16ToU32(f16 a) {
+  u32 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, F16ToU32, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
+u64 SoftFloat::F16ToU64(f16 a) {
+  return FToI<f16, u64, rm>(a);
+}
+
+template u64 SoftFloat::F16ToU64<SoftFloat::kRoundTiesToEven>(f16 a);
+template u64 SoftFloat::F16ToU64<SoftFloat::kRoundTowardPositive>(f16 a);
+template u64 SoftFloat::F16ToU64<SoftFloat::kRoundTowardNegative>(f16 a);
+template u64 SoftFloat::F16ToU64<SoftFloat::kRoundTowardZero>(f16 a);
+template u64 SoftFloat::F16ToU64<SoftFloat::kRoundTiesToAway>(f16 a);
+
 u64 SoftFloat::F16ToU64(f16 a) {
-  return FToI<f16, u64>(a);
+  u64 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, F16ToU64, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
+i32 SoftFloat::F32ToI32(f32 a) {
+  return FToI<f32, i32, rm>(a);
 }
 
+template i32 SoftFloat::F32ToI32<SoftFloat::kRoundTiesToEven>(f32 a);
+template i32 SoftFloat::F32ToI32<SoftFloat::kRoundTowardPositive>(f32 a);
+template i32 SoftFloat::F32ToI32<SoftFloat::kRoundTowardNegative>(f32 a);
+template i32 SoftFloat::F32ToI32<SoftFloat::kRoundTowardZero>(f32 a);
+template i32 SoftFloat::F32ToI32<SoftFloat::kRoundTiesToAway>(f32 a);
+
 i32 SoftFloat::F32ToI32(f32 a) {
-  return FToI<f32, i32>(a);
+  i32 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, F32ToI32, a)
+  return result;
 }
 
+template <Vfpu::RoundingMode rm>
 i64 SoftFloat::F32ToI64(f32 a) {
-  return FToI<f32, i64>(a);
+  return FToI<f32, i64, rm>(a);
 }
 
+template i64 SoftFloat::F32ToI64<SoftFloat::kRoundTiesToEven>(f32 a);
+template i64 SoftFloat::F32ToI64<SoftFloat::kRoundTowardPositive>(f32 a);
+template i64 SoftFloat::F32ToI64<SoftFloat::kRoundTowardNegative>(f32 a);
+template i64 SoftFloat::F32ToI64<SoftFloat::kRoundTowardZero>(f32 a);
+template i64 SoftFloat::F32ToI64<SoftFloat::kRoundTiesToAway>(f32 a);
+
+i64 SoftFloat::F32ToI64(f32 a) {
+  i64 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, F32ToI64, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
 u32 SoftFloat::F32ToU32(f32 a) {
-  return FToI<f32, u32>(a);
+  return FToI<f32, u32, rm>(a);
 }
 
+template u32 SoftFloat::F32ToU32<SoftFloat::kRoundTiesToEven>(f32 a);
+template u32 SoftFloat::F32ToU32<SoftFloat::kRoundTowardPositive>(f32 a);
+template u32 SoftFloat::F32ToU32<SoftFloat::kRoundTowardNegative>(f32 a);
+template u32 SoftFloat::F32ToU32<SoftFloat::kRoundTowardZero>(f32 a);
+template u32 SoftFloat::F32ToU32<SoftFloat::kRoundTiesToAway>(f32 a);
+
+u32 SoftFloat::F32ToU32(f32 a) {
+  u32 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, F32ToU32, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
 u64 SoftFloat::F32ToU64(f32 a) {
-  return FToI<f32, u64>(a);
+  return FToI<f32, u64, rm>(a);
 }
 
+template u64 SoftFloat::F32ToU64<SoftFloat::kRoundTiesToEven>(f32 a);
+template u64 SoftFloat::F32ToU64<SoftFloat::kRoundTowardPositive>(f32 a);
+template u64 SoftFloat::F32ToU64<SoftFloat::kRoundTowardNegative>(f32 a);
+template u64 SoftFloat::F32ToU64<SoftFloat::kRoundTowardZero>(f32 a);
+template u64 SoftFloat::F32ToU64<SoftFloat::kRoundTiesToAway>(f32 a);
+
+u64 SoftFloat::F32ToU64(f32 a) {
+  u64 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, F32ToU64, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
 i32 SoftFloat::F64ToI32(f64 a) {
-  return FToI<f64, i32>(a);
+  return FToI<f64, i32, rm>(a);
 }
 
+template i32 SoftFloat::F64ToI32<SoftFloat::kRoundTiesToEven>(f64 a);
+template i32 SoftFloat::F64ToI32<SoftFloat::kRoundTowardPositive>(f64 a);
+template i32 SoftFloat::F64ToI32<SoftFloat::kRoundTowardNegative>(f64 a);
+template i32 SoftFloat::F64ToI32<SoftFloat::kRoundTowardZero>(f64 a);
+template i32 SoftFloat::F64ToI32<SoftFloat::kRoundTiesToAway>(f64 a);
+
+i32 SoftFloat::F64ToI32(f64 a) {
+  i32 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, F64ToI32, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
 i64 SoftFloat::F64ToI64(f64 a) {
-  return FToI<f64, i64>(a);
+  return FToI<f64, i64, rm>(a);
 }
 
+template i64 SoftFloat::F64ToI64<SoftFloat::kRoundTiesToEven>(f64 a);
+template i64 SoftFloat::F64ToI64<SoftFloat::kRoundTowardPositive>(f64 a);
+template i64 SoftFloat::F64ToI64<SoftFloat::kRoundTowardNegative>(f64 a);
+template i64 SoftFloat::F64ToI64<SoftFloat::kRoundTowardZero>(f64 a);
+template i64 SoftFloat::F64ToI64<SoftFloat::kRoundTiesToAway>(f64 a);
+
+i64 SoftFloat::F64ToI64(f64 a) {
+  i64 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, F64ToI64, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
+u32 SoftFloat::F64ToU32(f64 a) {
+  return FToI<f64, u32, rm>(a);
+}
+
+template u32 SoftFloat::F64ToU32<SoftFloat::kRoundTiesToEven>(f64 a);
+template u32 SoftFloat::F64ToU32<SoftFloat::kRoundTowardPositive>(f64 a);
+template u32 SoftFloat::F64ToU32<SoftFloat::kRoundTowardNegative>(f64 a);
+template u32 SoftFloat::F64ToU32<SoftFloat::kRoundTowardZero>(f64 a);
+template u32 SoftFloat::F64ToU32<SoftFloat::kRoundTiesToAway>(f64 a);
+
 u32 SoftFloat::F64ToU32(f64 a) {
-  return FToI<f64, u32>(a);
+  u32 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, F64ToU32, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
+u64 SoftFloat::F64ToU64(f64 a) {
+  return FToI<f64, u64, rm>(a);
 }
 
+template u64 SoftFloat::F64ToU64<SoftFloat::kRoundTiesToEven>(f64 a);
+template u64 SoftFloat::F64ToU64<SoftFloat::kRoundTowardPositive>(f64 a);
+template u64 SoftFloat::F64ToU64<SoftFloat::kRoundTowardNegative>(f64 a);
+template u64 SoftFloat::F64ToU64<SoftFloat::kRoundTowardZero>(f64 a);
+template u64 SoftFloat::F64ToU64<SoftFloat::kRoundTiesToAway>(f64 a);
+
 u64 SoftFloat::F64ToU64(f64 a) {
-  return FToI<f64, u64>(a);
+  u64 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, F64ToU64, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
+i32 SoftFloat::F128ToI32(f128 a) {
+  return FToI<f128, i32, rm>(a);
+}
+
+template i32 SoftFloat::F128ToI32<SoftFloat::kRoundTiesToEven>(f128 a);
+template i32 SoftFloat::F128ToI32<SoftFloat::kRoundTowardPositive>(f128 a);
+template i32 SoftFloat::F128ToI32<SoftFloat::kRoundTowardNegative>(f128 a);
+template i32 SoftFloat::F128ToI32<SoftFloat::kRoundTowardZero>(f128 a);
+template i32 SoftFloat::F128ToI32<SoftFloat::kRoundTiesToAway>(f128 a);
+
+i32 SoftFloat::F128ToI32(f128 a) {
+  i32 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, F128ToI32, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
+i64 SoftFloat::F128ToI64(f128 a) {
+  return FToI<f128, i64, rm>(a);
+}
+
+template i64 SoftFloat::F128ToI64<SoftFloat::kRoundTiesToEven>(f128 a);
+template i64 SoftFloat::F128ToI64<SoftFloat::kRoundTowardPositive>(f128 a);
+template i64 SoftFloat::F128ToI64<SoftFloat::kRoundTowardNegative>(f128 a);
+template i64 SoftFloat::F128ToI64<SoftFloat::kRoundTowardZero>(f128 a);
+template i64 SoftFloat::F128ToI64<SoftFloat::kRoundTiesToAway>(f128 a);
+
+i64 SoftFloat::F128ToI64(f128 a) {
+  i64 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, F128ToI64, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
+u32 SoftFloat::F128ToU32(f128 a) {
+  return FToI<f128, u32, rm>(a);
+}
+
+template u32 SoftFloat::F128ToU32<SoftFloat::kRoundTiesToEven>(f128 a);
+template u32 SoftFloat::F128ToU32<SoftFloat::kRoundTowardPositive>(f128 a);
+template u32 SoftFloat::F128ToU32<SoftFloat::kRoundTowardNegative>(f128 a);
+template u32 SoftFloat::F128ToU32<SoftFloat::kRoundTowardZero>(f128 a);
+template u32 SoftFloat::F128ToU32<SoftFloat::kRoundTiesToAway>(f128 a);
+
+u32 SoftFloat::F128ToU32(f128 a) {
+  u32 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, F128ToU32, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
+u64 SoftFloat::F128ToU64(f128 a) {
+  return FToI<f128, u64, rm>(a);
+}
+
+template u64 SoftFloat::F128ToU64<SoftFloat::kRoundTiesToEven>(f128 a);
+template u64 SoftFloat::F128ToU64<SoftFloat::kRoundTowardPositive>(f128 a);
+template u64 SoftFloat::F128ToU64<SoftFloat::kRoundTowardNegative>(f128 a);
+template u64 SoftFloat::F128ToU64<SoftFloat::kRoundTowardZero>(f128 a);
+template u64 SoftFloat::F128ToU64<SoftFloat::kRoundTiesToAway>(f128 a);
+
+u64 SoftFloat::F128ToU64(f128 a) {
+  u64 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, F128ToU64, a)
+  return result;
 }
 
+template <Vfpu::RoundingMode rm>
 f16 SoftFloat::F32ToF16(f32 a) {
-  return FToF<f32, f16>(a);
+  return FToF<f32, f16, rm>(a);
 }
 
+template f16 SoftFloat::F32ToF16<SoftFloat::kRoundTiesToEven>(f32 a);
+template f16 SoftFloat::F32ToF16<SoftFloat::kRoundTowardPositive>(f32 a);
+template f16 SoftFloat::F32ToF16<SoftFloat::kRoundTowardNegative>(f32 a);
+template f16 SoftFloat::F32ToF16<SoftFloat::kRoundTowardZero>(f32 a);
+template f16 SoftFloat::F32ToF16<SoftFloat::kRoundTiesToAway>(f32 a);
+
+f16 SoftFloat::F32ToF16(f32 a) {
+  f16 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, F32ToF16, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
+bf16 SoftFloat::F32ToBF16(f32 a) {
+  return FToF<f32, bf16, rm>(a);
+}
+
+template bf16 SoftFloat::F32ToBF16<SoftFloat::kRoundTiesToEven>(f32 a);
+template bf16 SoftFloat::F32ToBF16<SoftFloat::kRoundTowardPositive>(f32 a);
+template bf16 SoftFloat::F32ToBF16<SoftFloat::kRoundTowardNegative>(f32 a);
+template bf16 SoftFloat::F32ToBF16<SoftFloat::kRoundTowardZero>(f32 a);
+template bf16 SoftFloat::F32ToBF16<SoftFloat::kRoundTiesToAway>(f32 a);
+
+bf16 SoftFloat::F32ToBF16(f32 a) {
+  bf16 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, F32ToBF16, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
 f16 SoftFloat::F64ToF16(f64 a) {
-  return FToF<f64, f16>(a);
+  return FToF<f64, f16, rm>(a);
 }
 
+template f16 SoftFloat::F64ToF16<SoftFloat::kRoundTiesToEven>(f64 a);
+template f16 SoftFloat::F64ToF16<SoftFloat::kRoundTowardPositive>(f64 a);
+template f16 SoftFloat::F64ToF16<SoftFloat::kRoundTowardNegative>(f64 a);
+template f16 SoftFloat::F64ToF16<SoftFloat::kRoundTowardZero>(f64 a);
+template f16 SoftFloat::F64ToF16<SoftFloat::kRoundTiesToAway>(f64 a);
+
+f16 SoftFloat::F64ToF16(f64 a) {
+  f16 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, F64ToF16, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
 f32 SoftFloat::F64ToF32(f64 a) {
-  return FToF<f64, f32>(a);
+  return FToF<f64, f32, rm>(a);
+}
+
+template f32 SoftFloat::F64ToF32<SoftFloat::kRoundTiesToEven>(f64 a);
+template f32 SoftFloat::F64ToF32<SoftFloat::kRoundTowardPositive>(f64 a);
+template f32 SoftFloat::F64ToF32<SoftFloat::kRoundTowardNegative>(f64 a);
+template f32 SoftFloat::F64ToF32<SoftFloat::kRoundTowardZero>(f64 a);
+template f32 SoftFloat::F64ToF32<SoftFloat::kRoundTiesToAway>(f64 a);
+
+f32 SoftFloat::F64ToF32(f64 a) {
+  f32 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, F64ToF32, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
+f32 SoftFloat::F128ToF32(f128 a) {
+  return FToF<f128, f32, rm>(a);
+}
+
+template f32 SoftFloat::F128ToF32<SoftFloat::kRoundTiesToEven>(f128 a);
+template f32 SoftFloat::F128ToF32<SoftFloat::kRoundTowardPositive>(f128 a);
+template f32 SoftFloat::F128ToF32<SoftFloat::kRoundTowardNegative>(f128 a);
+template f32 SoftFloat::F128ToF32<SoftFloat::kRoundTowardZero>(f128 a);
+template f32 SoftFloat::F128ToF32<SoftFloat::kRoundTiesToAway>(f128 a);
+
+f32 SoftFloat::F128ToF32(f128 a) {
+  f32 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, F128ToF32, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
+f64 SoftFloat::F128ToF64(f128 a) {
+  return FToF<f128, f64, rm>(a);
+}
+
+template f64 SoftFloat::F128ToF64<SoftFloat::kRoundTiesToEven>(f128 a);
+template f64 SoftFloat::F128ToF64<SoftFloat::kRoundTowardPositive>(f128 a);
+template f64 SoftFloat::F128ToF64<SoftFloat::kRoundTowardNegative>(f128 a);
+template f64 SoftFloat::F128ToF64<SoftFloat::kRoundTowardZero>(f128 a);
+template f64 SoftFloat::F128ToF64<SoftFloat::kRoundTiesToAway>(f128 a);
+
+f64 SoftFloat::F128ToF64(f128 a) {
+  f64 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, F128ToF64, a)
+  return result;
 }
 
 template<typename TFROM, typename TTO>
@@ -895,7 +1658,8 @@ constexpr TTO SoftFloat::PropagateNan(TFROM a) {
   static_assert(std::is_floating_point_v<TFROM>);
   static_assert(std::is_floating_point_v<TTO>);
   using UTTO = FloatToUint<TTO>::type;
-  if (nan_propagation_scheme == kNanPropX86sse) {
+  // x86 and Arm with FPCR.DN = 0 keep the sign and the upper bits of the payload (see FPConvertNaN).
+  if (nan_propagation_scheme == kNanPropX86sse || nan_propagation_scheme == kNanPropArm64) {
     UTTO payload;
     if constexpr (NumBits<TTO>() > NumBits<TFROM>()) {
       payload = static_cast<UTTO>(GetPayload(a)) << (NumSignificandBits<TTO>() - NumSignificandBits<TFROM>());
@@ -926,6 +1690,10 @@ constexpr FT SoftFloat::PropagateNan(FT a, FT b) {
   case kNanPropArm64DefaultNan:
     result = GetQnan<FT>();
     break;
+  case kNanPropArm64:
+    // The first signaling NaN, otherwise the first NaN (see FPProcessNaNs).
+    result = SetQuietBit((IsSnan(a) || (IsNan(a) && !IsSnan(b))) ? a : b);
+    break;
   default:
     throw std::runtime_error(std::string("Unknown NaN propagation scheme"));
   }
@@ -947,6 +1715,11 @@ constexpr FT SoftFloat::PropagateNan(FT a, FT b, FT c) {
   case kNanPropArm64DefaultNan:
     result = GetQnan<FT>();
     break;
+  case kNanPropArm64:
+    // The addend c comes first (see FPMulAdd and FPProcessNaNs3). A quiet NaN addend of ∞ × 0 yields the default NaN.
+    result = (IsSnan(c) || (IsNan(c) && !IsSnan(a) && !IsSnan(b))) ? SetQuietBit(c) : PropagateNan<FT>(a, b);
+    result = (IsQnan(c) && ((IsInf(a) && IsZero(b)) || (IsZero(a) && IsInf(b)))) ? GetQnan<FT>() : result;
+    break;
   default:
     throw std::runtime_error(std::string("Unknown NaN propagation scheme"));
   }
@@ -6,6 +6,7 @@
 #include <limits>
 #include <stdfloat>
 #include <type_traits>
+#include <utility>
 
 #define FLOPPY_FLOAT_FUNC_1(result, rounding_mode, func, ...)       \
   switch (rounding_mode) {                                          \
@@ -52,6 +53,7 @@
 namespace FfUtils {
 
 using f16 = std::float16_t;
+using bf16 = std::bfloat16_t;
 using f32 = std::float32_t;
 using f64 = std::float64_t;
 using f128 = std::float128_t;
@@ -68,6 +70,65 @@ using u32 = uint32_t;
 using u64 = uint64_t;
 using u128 = __uint128_t;
 
+// x87 double extended precision format (see Intel SDM Vol. 1, 4.2.2 "Floating-Point Data Types"). Unlike in the IEEE
+// 754 interchange formats, the integer bit of the significand is explicit. The layout matches long double on x86-64.
+struct f80 {
+  u64 signif;
+  u16 sign_exp;
+  constexpr bool operator==(const f80&) const = default;
+};
+
+// OCP 8-bit floating point formats (see OCP 8-bit Floating Point Specification (OFP8), Revision 1.0). E5M2 follows the
+// IEEE 754 conventions, whereas E4M3 has no infinities and only a single NaN encoding per sign.
+struct e4m3 {
+  u8 v;
+  constexpr bool operator==(const e4m3&) const = default;
+};
+
+struct e5m2 {
+  u8 v;
+  constexpr bool operator==(const e5m2&) const = default;
+};
+
+// Element and scale formats of the OCP Microscaling formats (see OCP Microscaling Formats (MX) Specification v1.0).
+// FP6 (E3M2, E2M3) and FP4 (E2M1) have neither infinities nor NaNs and occupy the low bits of v. E8M0 is an unsigned
+// power of two 2^(v - 127) with 0xff encoding NaN.
+struct e3m2 {
+  u8 v;
+  constexpr bool operator==(const e3m2&) const = default;
+};
+
+struct e2m3 {
+  u8 v;
+  constexpr bool operator==(const e2m3&) const = default;
+};
+
+struct e2m1 {
+  u8 v;
+  constexpr bool operator==(const e2m1&) const = default;
+};
+
+struct e8m0 {
+  u8 v;
+  constexpr bool operator==(const e8m0&) const = default;
+};
+
+// Generic IEEE 754 binary format with E exponent bits and M trailing significand bits, e.g., Ieee<8, 10> for TF32 or
+// Ieee<8, 15> for a 24-bit DSP format. The encoding occupies the low 1 + E + M bits of v. See IeeeFloat.
+template <int E, int M>
+struct Ieee {
+  static_assert(E >= 2 && E <= 15 && M >= 1 && 1 + E + M <= 64, "Unsupported format");
+  using UT = std::conditional_t<(1 + E + M <= 8), u8,
+                                std::conditional_t<(1 + E + M <= 16), u16, std::conditional_t<(1 + E + M <= 32), u32, u64>>>;
+  static constexpr int kExpBits = E;
+  static constexpr int kManBits = M;
+  static constexpr int kBias = (1 << (E - 1)) - 1;
+  UT v;
+  constexpr bool operator==(const Ieee&) const = default;
+};
+
+using tf32 = Ieee<8, 10>;
+
 template <typename T>
 using nl = std::numeric_limits<T>;
 
@@ -79,6 +140,11 @@ struct TwiceWidthType<f16> {
   using type = f32;
 };
 
+template <>
+struct TwiceWidthType<bf16> {
+  using type = f32;
+};
+
 template <>
 struct TwiceWidthType<f32> {
   using type = f64;
@@ -112,6 +178,10 @@ struct FloatToUint<f16> {
   using type = u16;
 };
 template <>
+struct FloatToUint<bf16> {
+  using type = u16;
+};
+template <>
 struct FloatToUint<f32> {
   using type = u32;
 };
@@ -119,6 +189,10 @@ template <>
 struct FloatToUint<f64> {
   using type = u64;
 };
+template <>
+struct FloatToUint<f128> {
+  using type = u128;
+};
 
 template <typename T>
 struct FloatToInt;
@@ -128,6 +202,10 @@ struct FloatToInt<f16> {
   using type = i16;
 };
 template <>
+struct FloatToInt<bf16> {
+  using type = i16;
+};
+template <>
 struct FloatToInt<f32> {
   using type = i32;
 };
@@ -135,6 +213,10 @@ template <>
 struct FloatToInt<f64> {
   using type = i64;
 };
+template <>
+struct FloatToInt<f128> {
+  using type = i128;
+};
 
 template <typename T>
 struct UintToFloat;
@@ -160,6 +242,11 @@ struct QuietBit<f16> {
   static constexpr u16 u = 0x0200u;
 };
 
+template <>
+struct QuietBit<bf16> {
+  static constexpr u16 u = 0x0040u;
+};
+
 template <>
 struct QuietBit<f32> {
   static constexpr u32 u = 0x00400000u;
@@ -170,23 +257,32 @@ struct QuietBit<f64> {
   static constexpr u64 u = 0x0008000000000000ull;
 };
 
+template <>
+struct QuietBit<f128> {
+  static constexpr u128 u = static_cast<u128>(0x0000800000000000ull) << 64;
+};
+
 template <typename FT>
 constexpr int Bias() {
   static_assert(std::is_floating_point<FT>::value);
   if constexpr (std::is_same_v<FT, f16>) {
     return 15;
+  } else if constexpr (std::is_same_v<FT, bf16>) {
+    return 127;
   } else if constexpr (std::is_same_v<FT, f32>) {
     return 127;
   } else if constexpr (std::is_same_v<FT, f64>) {
     return 1023;
+  } else if constexpr (std::is_same_v<FT, f128>) {
+    return 16383;
   } else {
-    static_assert(false, "Type needs to be f16, f32, or f64");
+    static_assert(false, "Type needs to be f16, bf16, f32, f64, or f128");
   }
 }
 
 template <typename T>
 constexpr int NumBits() {
-  if constexpr (std::is_same_v<T, f16> || std::is_same_v<T, u16> || std::is_same_v<T, i16>) {
+  if constexpr (std::is_same_v<T, f16> || std::is_same_v<T, bf16> || std::is_same_v<T, u16> || std::is_same_v<T, i16>) {
     return 16;
   } else if constexpr (std::is_same_v<T, f32> || std::is_same_v<T, u32> || std::is_same_v<T, i32>) {
     return 32;
@@ -204,12 +300,16 @@ constexpr int NumSignificandBits() {
   static_assert(std::is_floating_point<FT>::value);
   if constexpr (std::is_same<FT, f16>::value) {
     return 10;
+  } else if constexpr (std::is_same<FT, bf16>::value) {
+    return 7;
   } else if constexpr (std::is_same<FT, f32>::value) {
     return 23;
   } else if constexpr (std::is_same<FT, f64>::value) {
     return 52;
+  } else if constexpr (std::is_same<FT, f128>::value) {
+    return 112;
   } else {
-    static_assert(false, "Type needs to be f16, f32, or f64");
+    static_assert(false, "Type needs to be f16, bf16, f32, f64, or f128");
   }
 }
 
@@ -218,12 +318,16 @@ constexpr int NumImantBits() {
   static_assert(std::is_floating_point<FT>::value);
   if constexpr (std::is_same<FT, f16>::value) {
     return 14;
+  } else if constexpr (std::is_same<FT, bf16>::value) {
+    return 14;
   } else if constexpr (std::is_same<FT, f32>::value) {
     return 30;
   } else if constexpr (std::is_same<FT, f64>::value) {
     return 62;
+  } else if constexpr (std::is_same<FT, f128>::value) {
+    return 126;
   } else {
-    static_assert(false, "Type needs to be f16, f32, or f64");
+    static_assert(false, "Type needs to be f16, bf16, f32, f64, or f128");
   }
 }
 
@@ -232,12 +336,16 @@ constexpr int NumExponentBits() {
   static_assert(std::is_floating_point<FT>::value);
   if constexpr (std::is_same<FT, f16>::value) {
     return 5;
+  } else if constexpr (std::is_same<FT, bf16>::value) {
+    return 8;
   } else if constexpr (std::is_same<FT, f32>::value) {
     return 8;
   } else if constexpr (std::is_same<FT, f64>::value) {
     return 11;
+  } else if constexpr (std::is_same<FT, f128>::value) {
+    return 15;
   } else {
-    static_assert(false, "Type needs to be f16, f32, or f64");
+    static_assert(false, "Type needs to be f16, bf16, f32, f64, or f128");
   }
 }
 
@@ -246,12 +354,16 @@ constexpr i32 MaxExponent() {
   static_assert(std::is_floating_point<FT>::value);
   if constexpr (std::is_same<FT, f16>::value) {
     return 31;
+  } else if constexpr (std::is_same<FT, bf16>::value) {
+    return 255;
   } else if constexpr (std::is_same<FT, f32>::value) {
     return 255;
   } else if constexpr (std::is_same<FT, f64>::value) {
     return 2047;
+  } else if constexpr (std::is_same<FT, f128>::value) {
+    return 32767;
   } else {
-    static_assert(false, "Type needs to be f16, f32, or f64");
+    static_assert(false, "Type needs to be f16, bf16, f32, f64, or f128");
   }
 }
 
@@ -273,12 +385,16 @@ constexpr FT ClearSignificand(FT a) {
   auto u = std::bit_cast<typename FloatToUint<FT>::type>(a);
   if constexpr (std::is_same_v<FT, f16>) {
     u &= 0xfc00u;
+  } else if constexpr (std::is_same_v<FT, bf16>) {
+    u &= 0xff80u;
   } else if constexpr (std::is_same_v<FT, f32>) {
     u &= 0xff800000u;
   } else if constexpr (std::is_same_v<FT, f64>) {
     u &= 0xfff0000000000000ull;
+  } else if constexpr (std::is_same_v<FT, f128>) {
+    u &= static_cast<u128>(0xffff000000000000ull) << 64;
   } else {
-    static_assert(false, "Type needs to be f16, f32, or f64");
+    static_assert(false, "Type needs to be f16, bf16, f32, f64, or f128");
   }
   return std::bit_cast<FT>(u);
 }
@@ -289,18 +405,22 @@ constexpr FT CreateQnanWithPayload(typename FloatToUint<FT>::type payload) {
   UT u;
   if constexpr (std::is_same<FT, f16>::value) {
     u = 0x7e00u;
+  } else if constexpr (std::is_same<FT, bf16>::value) {
+    u = 0x7fc0u;
   } else if constexpr (std::is_same<FT, f32>::value) {
     u = 0x7fc00000u;
   } else if constexpr (std::is_same<FT, f64>::value) {
     u = 0x7ff8000000000000ull;
+  } else if constexpr (std::is_same<FT, f128>::value) {
+    u = static_cast<u128>(0x7fff800000000000ull) << 64;
   } else {
-    static_assert(false, "Type needs to be f16, f32, or f64");
+    static_assert(false, "Type needs to be f16, bf16, f32, f64, or f128");
   }
   return std::bit_cast<FT>((UT)(u | payload));
 }
 
 template <typename FT>
-constexpr auto FloatFrom3Tuple(bool sign, u32 exponent, u64 significand) {
+constexpr auto FloatFrom3Tuple(bool sign, u32 exponent, typename FloatToUint<FT>::type significand) {
   static_assert(std::is_floating_point<FT>::value);
   using UT = typename FloatToUint<FT>::type;
   UT u = 0;
@@ -308,6 +428,10 @@ constexpr auto FloatFrom3Tuple(bool sign, u32 exponent, u64 significand) {
     u |= static_cast<UT>(sign) << 15;
     u |= static_cast<UT>(exponent) << NumSignificandBits<FT>();
     u |= static_cast<UT>(significand) & 0x3ffu;
+  } else if constexpr (std::is_same<FT, bf16>::value) {
+    u |= static_cast<UT>(sign) << 15;
+    u |= static_cast<UT>(exponent) << NumSignificandBits<FT>();
+    u |= static_cast<UT>(significand) & 0x7fu;
   } else if constexpr (std::is_same<FT, f32>::value) {
     u |= static_cast<UT>(sign) << 31;
     u |= static_cast<UT>(exponent) << NumSignificandBits<FT>();
@@ -316,8 +440,12 @@ constexpr auto FloatFrom3Tuple(bool sign, u32 exponent, u64 significand) {
     u |= static_cast<UT>(sign) << 63;
     u |= static_cast<UT>(exponent) << NumSignificandBits<FT>();
     u |= static_cast<UT>(significand) & 0xfffffffffffffull;
+  } else if constexpr (std::is_same<FT, f128>::value) {
+    u |= static_cast<UT>(sign) << 127;
+    u |= static_cast<UT>(exponent) << NumSignificandBits<FT>();
+    u |= static_cast<UT>(significand) & ((static_cast<u128>(1) << 112) - 1);
   } else {
-    static_assert(false, "Type needs to be f16, f32, or f64");
+    static_assert(false, "Type needs to be f16, bf16, f32, f64, or f128");
   }
   return std::bit_cast<FT>(u);
 }
@@ -329,12 +457,16 @@ constexpr auto GetSignificand(FT a) {
   UT u = std::bit_cast<typename FloatToUint<FT>::type>(a);
   if constexpr (std::is_same_v<FT, f16>) {
     u &= 0x3ffu;
+  } else if constexpr (std::is_same_v<FT, bf16>) {
+    u &= 0x7fu;
   } else if constexpr (std::is_same_v<FT, f32>) {
     u &= 0x007fffffu;
   } else if constexpr (std::is_same_v<FT, f64>) {
     u &= 0xfffffffffffffull;
+  } else if constexpr (std::is_same_v<FT, f128>) {
+    u &= (static_cast<u128>(1) << 112) - 1;
   } else {
-    static_assert(false, "Type needs to be f16, f32, or f64");
+    static_assert(false, "Type needs to be f16, bf16, f32, f64, or f128");
   }
   return u;
 }
@@ -345,12 +477,16 @@ constexpr auto GetPayload(FT a) {
   UT u;
   if constexpr (std::is_same_v<FT, f16>) {
     u = std::bit_cast<UT>(a) & 0x1ffu;
+  } else if constexpr (std::is_same_v<FT, bf16>) {
+    u = std::bit_cast<UT>(a) & 0x3fu;
   } else if constexpr (std::is_same_v<FT, f32>) {
     u = std::bit_cast<UT>(a) & 0x3fffffu;
   } else if constexpr (std::is_same_v<FT, f64>) {
     u = std::bit_cast<UT>(a) & 0xfffffffffffffull;
+  } else if constexpr (std::is_same_v<FT, f128>) {
+    u = std::bit_cast<UT>(a) & ((static_cast<u128>(1) << 111) - 1);
   } else {
-    static_assert(false, "Type needs to be f16, f32, or f64");
+    static_assert(false, "Type needs to be f16, bf16, f32, f64, or f128");
   }
   return u;
 }
@@ -368,12 +504,16 @@ constexpr auto GetExponent(FT a) {
   UT u = std::bit_cast<typename FloatToUint<FT>::type>(a);
   if constexpr (std::is_same_v<FT, f16>) {
     u = (u >> NumSignificandBits<FT>()) & 0x1fu;
+  } else if constexpr (std::is_same_v<FT, bf16>) {
+    u = (u >> NumSignificandBits<FT>()) & 0xffu;
   } else if constexpr (std::is_same_v<FT, f32>) {
     u = (u >> NumSignificandBits<FT>()) & 0xffu;
   } else if constexpr (std::is_same_v<FT, f64>) {
     u = (u >> NumSignificandBits<FT>()) & 0x7ffull;
+  } else if constexpr (std::is_same_v<FT, f128>) {
+    u = (u >> NumSignificandBits<FT>()) & 0x7fffu;
   } else {
-    static_assert(false, "Type needs to be f16, f32, or f64");
+    static_assert(false, "Type needs to be f16, bf16, f32, f64, or f128");
   }
   return u;
 }
@@ -458,6 +598,12 @@ constexpr bool MayResultFromUnderflow(FT a) {
   return std::abs(a) <= nl<FT>::min();
 }
 
+template <typename FT>
+constexpr bool IsZero(FT a) {
+  static_assert(std::is_floating_point<FT>::value);
+  return (a == -a);
+}
+
 template <typename FT>
 constexpr bool IsSubnormal(FT a) {
   static_assert(std::is_floating_point<FT>::value);
@@ -465,9 +611,9 @@ constexpr bool IsSubnormal(FT a) {
 }
 
 template <typename FT>
-constexpr bool IsZero(FT a) {
+constexpr FT FlushToZero(FT a) {
   static_assert(std::is_floating_point<FT>::value);
-  return (a == -a);
+  return IsSubnormal(a) ? std::copysign(static_cast<FT>(0.), a) : a;
 }
 
 template <typename FT>
@@ -485,9 +631,10 @@ constexpr FT NextUpNoNegZero(FT a) {
 }
 
 template <typename FT>
-constexpr u64 MaxSignificand() {
+constexpr auto MaxSignificand() {
   static_assert(std::is_floating_point<FT>::value);
-  return (1ull << NumSignificandBits<FT>()) - 1ull;
+  using UT = typename FloatToUint<FT>::type;
+  return static_cast<UT>((static_cast<UT>(1) << NumSignificandBits<FT>()) - 1);
 }
 
 template <typename FT>
@@ -503,12 +650,16 @@ constexpr auto ExponentMask() {
   UT u;
   if constexpr (std::is_same_v<FT, f16>) {
     u = 0x7c00u;
+  } else if constexpr (std::is_same_v<FT, bf16>) {
+    u = 0x7f80u;
   } else if constexpr (std::is_same_v<FT, f32>) {
     u = 0x7f800000u;
   } else if constexpr (std::is_same_v<FT, f64>) {
     u = 0x7ff0000000000000ull;
+  } else if constexpr (std::is_same_v<FT, f128>) {
+    u = static_cast<u128>(0x7fff000000000000ull) << 64;
   } else {
-    static_assert("Type needs to be f16, f32, or f64");
+    static_assert("Type needs to be f16, bf16, f32, f64, or f128");
   }
   return u;
 };
@@ -520,14 +671,105 @@ constexpr auto SignMask() {
   UT u;
   if constexpr (std::is_same_v<FT, f16>) {
     u = 1u << 15;
+  } else if constexpr (std::is_same_v<FT, bf16>) {
+    u = 1u << 15;
   } else if constexpr (std::is_same_v<FT, f32>) {
     u = 1u << 31;
   } else if constexpr (std::is_same_v<FT, f64>) {
     u = 1ull << 63;
+  } else if constexpr (std::is_same_v<FT, f128>) {
+    u = static_cast<u128>(1) << 127;
   } else {
-    static_assert("Type needs to be f16, f32, or f64");
+    static_assert("Type needs to be f16, bf16, f32, f64, or f128");
   }
   return u;
 }
 
+// Flips the sign bit. Unlike the host's unary minus, which computes f16 in f32 on some targets, this keeps signaling
+// NaNs signaling.
+template <typename FT>
+constexpr FT Negate(FT a) {
+  using UT = typename FloatToUint<FT>::type;
+  return std::bit_cast<FT>(static_cast<UT>(std::bit_cast<UT>(a) ^ SignMask<FT>()));
+}
+
+template <typename UT>
+constexpr std::pair<UT, UT> Umul(UT a, UT b) {
+  static_assert(std::is_integral_v<UT>);
+  auto ta = static_cast<typename TwiceWidthType<UT>::type>(a);
+  auto tb = static_cast<typename TwiceWidthType<UT>::type>(b);
+  auto r = ta * tb;
+  return std::make_pair(r, r >> NumBits<UT>());
+}
+
+// There is no native 256-bit type, so the 128-bit product is assembled from 64-bit limbs.
+template <>
+constexpr std::pair<u128, u128> Umul(u128 a, u128 b) {
+  u128 a0 = static_cast<u64>(a), a1 = a >> 64;
+  u128 b0 = static_cast<u64>(b), b1 = b >> 64;
+  u128 p00 = a0 * b0;
+  u128 p01 = a0 * b1;
+  u128 p10 = a1 * b0;
+  u128 mid = (p00 >> 64) + static_cast<u64>(p01) + static_cast<u64>(p10);
+  u128 lo = (mid << 64) | static_cast<u64>(p00);
+  u128 hi = a1 * b1 + (p01 >> 64) + (p10 >> 64) + (mid >> 64);
+  return std::make_pair(lo, hi);
+}
+
+// Result of RemainderOfSignificands: The magnitude of the remainder is rem * 2^exp. negate is set if the remainder has
+// the opposite sign of the dividend. quotient holds the low 64 bits of the magnitude of the quotient.
+struct SignificandRemainder {
+  u64 rem;
+  i32 exp;
+  bool negate;
+  u64 quotient;
+  bool incomplete;
+};
+
+// Remainder of a_signif * 2^a_exp by b_signif * 2^b_exp by long division in steps of 64 bits. The significands must be
+// nonzero with their msb at the same position. The quotient is rounded toward zero, or to nearest (ties to even) with
+// round_to_nearest. If partial is set and the exponents differ by 64 or more, only a multiple of b_signif * 2^(D - N)
+// with D the exponent difference and N = 32 + D mod 32 is subtracted and incomplete is set (see "fprem").
+constexpr SignificandRemainder RemainderOfSignificands(u64 a_signif, i32 a_exp, u64 b_signif, i32 b_exp,
+                                                       bool round_to_nearest, bool partial) {
+  SignificandRemainder r{a_signif, a_exp, false, 0, false};
+  i32 exp_diff = a_exp - b_exp;
+  if (exp_diff < 0) {
+    // |a| < |b|: The quotient is 0, or 1 if rounded to nearest and |a| > |b| / 2.
+    if (round_to_nearest && exp_diff == -1 && a_signif > b_signif) {
+      r.rem = b_signif - (a_signif - b_signif);
+      r.negate = true;
+      r.quotient = 1;
+    }
+    return r;
+  }
+
+  r.exp = b_exp;
+  if (partial && exp_diff >= 64) {
+    const i32 n = 32 + exp_diff % 32;
+    r.exp += exp_diff - n;
+    r.incomplete = true;
+    exp_diff = n;
+  }
+  r.quotient = a_signif >= b_signif;
+  r.rem = a_signif - (r.quotient ? b_signif : 0);
+  while (exp_diff > 0) {
+    const i32 step = exp_diff < 64 ? exp_diff : 64;
+    const u128 num = static_cast<u128>(r.rem) << step;
+    r.quotient = (step < 64 ? r.quotient << step : 0) + static_cast<u64>(num / b_signif);
+    r.rem = static_cast<u64>(num % b_signif);
+    exp_diff -= step;
+  }
+
+  if (round_to_nearest && !r.incomplete) {
+    const u64 excess = b_signif - r.rem;
+    if (r.rem > excess || (r.rem == excess && (r.quotient & 1))) {
+      r.rem = excess;
+      r.negate = true;
+      r.quotient += 1;
+    }
+  }
+  return r;
+}
+
 };  // namespace FfUtils
\ No newline at end of file
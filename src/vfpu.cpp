@@ -15,6 +15,11 @@ void Vfpu::SetQnan<f16>(u16 val) {
   qnan16_ = std::bit_cast<f16>(val);
 }
 
+template <>
+void Vfpu::SetQnan<bf16>(u16 val) {
+  qnanbf16_ = std::bit_cast<bf16>(val);
+}
+
 template <>
 void Vfpu::SetQnan<f32>(u32 val) {
   qnan32_ = std::bit_cast<f32>(val);
@@ -25,11 +30,21 @@ void Vfpu::SetQnan<f64>(u64 val) {
   qnan64_ = std::bit_cast<f64>(val);
 }
 
+template <>
+void Vfpu::SetQnan<f128>(u128 val) {
+  qnan128_ = std::bit_cast<f128>(val);
+}
+
 template <>
 f16 Vfpu::GetQnan<f16>() {
   return qnan16_;
 }
 
+template <>
+bf16 Vfpu::GetQnan<bf16>() {
+  return qnanbf16_;
+}
+
 template <>
 f32 Vfpu::GetQnan<f32>() {
   return qnan32_;
@@ -40,6 +55,11 @@ f64 Vfpu::GetQnan<f64>() {
   return qnan64_;
 }
 
+template <>
+f128 Vfpu::GetQnan<f128>() {
+  return qnan128_;
+}
+
 template <typename T>
 T Vfpu::MaxLimit() {
   if constexpr (std::is_same_v<T, i32>) {
@@ -102,8 +122,10 @@ template u64 Vfpu::NanLimit<u64>();
 
 Vfpu::Vfpu() {
   SetQnan<f16>(0x7e00u);
+  SetQnan<bf16>(0x7fc0u);
   SetQnan<f32>(0x7fc00000u);
   SetQnan<f64>(0x7ff8000000000000ull);
+  SetQnan<f128>(static_cast<u128>(0x7fff800000000000ull) << 64);
   ClearFlags();
   tininess_before_rounding = false;
   rounding_mode = kRoundTiesToEven;
@@ -115,12 +137,15 @@ void Vfpu::ClearFlags() {
   overflow = false;
   underflow = false;
   inexact = false;
+  input_denormal = false;
 }
 
 void Vfpu::SetupToArm() {
   SetQnan<f16>(0x7e00u);
+  SetQnan<bf16>(0x7fc0u);
   SetQnan<f32>(0x7fc00000u);
   SetQnan<f64>(0x7ff8000000000000ull);
+  SetQnan<f128>(static_cast<u128>(0x7fff800000000000ull) << 64);
   tininess_before_rounding = true;
   invalid_fma = true;
   nan_propagation_scheme = kNanPropArm64DefaultNan;  // Shares the same NaN propagation as ARM.
@@ -144,8 +169,10 @@ void Vfpu::SetupToArm() {
 
 void Vfpu::SetupToRiscv() {
   SetQnan<f16>(0x7e00u);
+  SetQnan<bf16>(0x7fc0u);
   SetQnan<f32>(0x7fc00000u);
   SetQnan<f64>(0x7ff8000000000000ull);
+  SetQnan<f128>(static_cast<u128>(0x7fff800000000000ull) << 64);
   tininess_before_rounding = false;
   invalid_fma = true;
   nan_propagation_scheme = kNanPropRiscv;
@@ -169,8 +196,10 @@ void Vfpu::SetupToRiscv() {
 
 void Vfpu::SetupToX86() {
   SetQnan<f16>(0xfe00u);
+  SetQnan<bf16>(0xffc0u);
   SetQnan<f32>(0xffc00000u);
   SetQnan<f64>(0xfff8000000000000ull);
+  SetQnan<f128>(static_cast<u128>(0xffff800000000000ull) << 64);
   tininess_before_rounding = false;
   invalid_fma = false;
   nan_propagation_scheme = kNanPropX86sse;
@@ -191,12 +220,3 @@ void Vfpu::SetupToX86() {
   max_limit_u64_ = std::numeric_limits<u64>::max();
   min_limit_u64_ = std::numeric_limits<u64>::max();
 }
-
-Vfpu::RmGuard::RmGuard(Vfpu* vfpu, RoundingMode rm) : vfpu(vfpu) {
-  old_rm = vfpu->rounding_mode;
-  vfpu->rounding_mode = rm;
-}
-
-Vfpu::RmGuard::~RmGuard() {
-  vfpu->rounding_mode = old_rm;
-}
\ No newline at end of file
@@ -8,6 +8,7 @@
 
 class Vfpu {
   static_assert(std::numeric_limits<FfUtils::f16>::is_iec559);
+  static_assert(std::numeric_limits<FfUtils::bf16>::is_iec559);
   static_assert(std::numeric_limits<FfUtils::f32>::is_iec559);
   static_assert(std::numeric_limits<FfUtils::f64>::is_iec559);
   static_assert(std::numeric_limits<FfUtils::f128>::is_iec559);
@@ -28,6 +29,7 @@ class Vfpu {
   bool overflow;
   bool underflow;
   bool inexact;
+  bool input_denormal;  // Arm FPSR.IDC or x86 MXCSR.DE (see flush_inputs).
 
   // kNanPropArm64DefaultNan => FPCR.DN = 1
   // kNanPropArm64 => FPCR.DN = 0
@@ -35,6 +37,15 @@ class Vfpu {
   bool tininess_before_rounding = false;
   bool invalid_fma = true;  // If true, FMA raises invalid for "∞ × 0 + qNaN". See IEE 754 ("7.2 Invalid operation").
 
+  // Subnormal operands are treated as zero with flush_inputs (x86 MXCSR.DAZ, Arm FPCR.FZ or FPCR.FIZ), and tiny results
+  // are replaced with zero with flush_outputs (x86 MXCSR.FTZ, Arm FPCR.FZ). Half precision has its own controls (Arm
+  // FPCR.FZ16). The flags follow x86 if nan_propagation_scheme is kNanPropX86sse and Arm (FPCR.AH = 0) otherwise: x86
+  // raises DE for every subnormal operand that is not flushed, Arm raises IDC for operands flushed by FPCR.FZ.
+  bool flush_inputs = false;
+  bool flush_outputs = false;
+  bool flush_inputs_f16 = false;
+  bool flush_outputs_f16 = false;
+
   Vfpu();
 
   void ClearFlags();
@@ -50,8 +61,10 @@ class Vfpu {
 
  protected:
   FfUtils::f16 qnan16_;
+  FfUtils::bf16 qnanbf16_;
   FfUtils::f32 qnan32_;
   FfUtils::f64 qnan64_;
+  FfUtils::f128 qnan128_;
 
   template <typename T>
   T MaxLimit();
@@ -72,11 +85,4 @@ class Vfpu {
   FfUtils::u64 nan_limit_u64_;
   FfUtils::u64 max_limit_u64_;
   FfUtils::u64 min_limit_u64_;
-
-  struct RmGuard {
-    RoundingMode old_rm;
-    Vfpu* vfpu;
-    RmGuard(Vfpu* vfpu, RoundingMode rm);
-    ~RmGuard();
-  };
 };
\ No newline at end of file
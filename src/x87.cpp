@@ -0,0 +1,995 @@
+/**************************************************************************************************
+ * Apache License, Version 2.0
+ * Copyright (c) 2024 chciken/Niko Zurstraßen
+ **************************************************************************************************/
+
+#include "x87.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+using namespace FfUtils;
+
+namespace {
+
+constexpr i32 kBiasF80 = 16383;
+constexpr i32 kMaxExpF80 = 0x7fff;
+constexpr u64 kIntegerBit = 0x8000000000000000ull;
+constexpr u64 kQuietBit = 0x4000000000000000ull;
+
+// Real indefinite (see Intel SDM Vol. 1, 4.8.3.7 "QNaN Floating-Point Indefinite").
+constexpr f80 kIndefinite{0xc000000000000000ull, 0xffff};
+
+constexpr bool SignF80(f80 a) {
+  return a.sign_exp >> 15;
+}
+
+constexpr i32 ExpF80(f80 a) {
+  return a.sign_exp & kMaxExpF80;
+}
+
+constexpr f80 PackF80(bool sign, i32 exp, u64 signif) {
+  return f80{signif, static_cast<u16>((static_cast<u32>(sign) << 15) | static_cast<u32>(exp))};
+}
+
+constexpr bool IsZeroF80(f80 a) {
+  return ExpF80(a) == 0 && a.signif == 0;
+}
+
+constexpr bool IsInfF80(f80 a) {
+  return ExpF80(a) == kMaxExpF80 && a.signif == kIntegerBit;
+}
+
+constexpr bool IsNanF80(f80 a) {
+  return ExpF80(a) == kMaxExpF80 && (a.signif & kIntegerBit) && (a.signif << 1);
+}
+
+constexpr bool IsSnanF80(f80 a) {
+  return IsNanF80(a) && !(a.signif & kQuietBit);
+}
+
+// Denormals and pseudo-denormals (see Intel SDM Vol. 1, 8.2.2 "Unsupported Double Extended-Precision Floating-Point
+// Encodings and Pseudo-Denormals"). Both are interpreted with an exponent of 1.
+constexpr bool IsDenormalF80(f80 a) {
+  return ExpF80(a) == 0 && a.signif != 0;
+}
+
+// Pseudo-NaNs, pseudo-infinities, and unnormals are not generated by the x87 FPU since the 387 and cause an invalid
+// operation when used as an operand.
+constexpr bool IsUnsupportedF80(f80 a) {
+  return ExpF80(a) != 0 && !(a.signif & kIntegerBit);
+}
+
+// Right shift that ORs all shifted-out bits into the lsb.
+constexpr u128 RshiftSticky(u128 a, i32 shift) {
+  if (shift == 0)
+    return a;
+  if (shift >= NumBits<u128>())
+    return a != 0;
+  return (a >> shift) | ((a << (NumBits<u128>() - shift)) != 0);
+}
+
+// Returns the significand with the integer bit at position 63 and adjusts the exponent accordingly.
+constexpr u64 NormalizeF80(f80 a, i32& exp) {
+  exp = ExpF80(a);
+  if (exp == 0) {
+    const i32 shift = std::countl_zero(a.signif);
+    exp = 1 - shift;
+    return a.signif << shift;
+  }
+  return a.signif;
+}
+
+constexpr f80 NextUpMagnitude(f80 a) {
+  if (a.signif == ~0ull)
+    return PackF80(SignF80(a), ExpF80(a) + 1, kIntegerBit);
+  return PackF80(SignF80(a), ExpF80(a), a.signif + 1);
+}
+
+constexpr f80 NextDownMagnitude(f80 a) {
+  if (a.signif == kIntegerBit)
+    return PackF80(SignF80(a), ExpF80(a) - 1, ~0ull);
+  return PackF80(SignF80(a), ExpF80(a), a.signif - 1);
+}
+
+#if defined(__x86_64__)
+static_assert(sizeof(long double) == sizeof(f80));
+static_assert(std::numeric_limits<long double>::digits == 64);
+
+// Operands and results within this exponent range neither overflow nor underflow in any step of the error-free
+// transformations below, so the host results and residuals are exact.
+constexpr bool IsFastPathF80(f80 a) {
+  return ExpF80(a) >= 0x0100 && ExpF80(a) <= 0x7eff && (a.signif & kIntegerBit);
+}
+
+// Dekker's TwoProduct with a Veltkamp split into two 32-bit halves. Returns the exact residual a * b - p.
+inline long double TwoProduct(long double a, long double b, long double p) {
+  constexpr long double kSplitter = 4294967297.0L;  // 2^32 + 1
+  const long double ta = kSplitter * a;
+  const long double ah = ta - (ta - a);
+  const long double al = a - ah;
+  const long double tb = kSplitter * b;
+  const long double bh = tb - (tb - b);
+  const long double bl = b - bh;
+  return (((ah * bh - p) + ah * bl) + al * bh) + al * bl;
+}
+
+// Returns -1, 0, or 1 if the exact value r + e is below, at, or above r.
+constexpr int Direction(long double e) {
+  return (e > 0.0L) - (e < 0.0L);
+}
+#endif
+
+}  // namespace
+
+X87::X87() : SoftFloat() {
+  SetupToX86();
+  rounding_mode = kRoundTiesToEven;
+  precision_control = kPrecisionExtended;
+  exception_masks_ = 0x3f;
+  top_ = 0;
+  for (int i = 0; i < 8; ++i) {
+    regs_[i] = f80{0, 0};
+    empty_[i] = true;
+  }
+  c0 = c1 = c2 = c3 = false;
+  ClearFlags();
+}
+
+void X87::ClearFlags() {
+  Vfpu::ClearFlags();
+  denormal = false;
+  stack_fault = false;
+}
+
+u16 X87::GetControlWord() {
+  u16 rc;
+  switch (rounding_mode) {
+  case kRoundTowardNegative:
+    rc = 1;
+    break;
+  case kRoundTowardPositive:
+    rc = 2;
+    break;
+  case kRoundTowardZero:
+    rc = 3;
+    break;
+  default:  // The x87 FPU has no encoding for kRoundTiesToAway.
+    rc = 0;
+    break;
+  }
+  return exception_masks_ | 0x40 | (static_cast<u16>(precision_control) << 8) | (rc << 10);
+}
+
+void X87::SetControlWord(u16 cw) {
+  static constexpr RoundingMode kRc[4] = {kRoundTiesToEven, kRoundTowardNegative, kRoundTowardPositive,
+                                          kRoundTowardZero};
+  exception_masks_ = cw & 0x3f;
+  // The reserved precision control encoding 01b is treated as double extended precision.
+  const u16 pc = (cw >> 8) & 3;
+  precision_control = pc == 1 ? kPrecisionExtended : static_cast<PrecisionControl>(pc);
+  rounding_mode = kRc[(cw >> 10) & 3];
+}
+
+u16 X87::GetStatusWord() {
+  u16 sw = static_cast<u16>(invalid) | static_cast<u16>(denormal) << 1 | static_cast<u16>(division_by_zero) << 2 |
+           static_cast<u16>(overflow) << 3 | static_cast<u16>(underflow) << 4 | static_cast<u16>(inexact) << 5;
+  const bool es = (sw & ~exception_masks_ & 0x3f) != 0;
+  sw |= static_cast<u16>(stack_fault) << 6 | static_cast<u16>(es) << 7 | static_cast<u16>(c0) << 8 |
+        static_cast<u16>(c1) << 9 | static_cast<u16>(c2) << 10 | static_cast<u16>(top_) << 11 |
+        static_cast<u16>(c3) << 14 | static_cast<u16>(es) << 15;
+  return sw;
+}
+
+u16 X87::GetTagWord() {
+  u16 tw = 0;
+  for (int i = 0; i < 8; ++i) {
+    u16 tag;
+    if (empty_[i])
+      tag = 3;
+    else if (IsZeroF80(regs_[i]))
+      tag = 1;
+    else if (ExpF80(regs_[i]) == 0 || ExpF80(regs_[i]) == kMaxExpF80 || IsUnsupportedF80(regs_[i]))
+      tag = 2;
+    else
+      tag = 0;
+    tw |= tag << (2 * i);
+  }
+  return tw;
+}
+
+i32 X87::Precision() {
+  switch (precision_control) {
+  case kPrecisionSingle:
+    return 24;
+  case kPrecisionDouble:
+    return 53;
+  default:
+    return 64;
+  }
+}
+
+// See Intel SDM Vol. 1, 4.7.3 "Operand Precedence" and Table 4-7.
+f80 X87::PropagateNanF80(f80 a, f80 b) {
+  const bool a_nan = IsNanF80(a);
+  const bool b_nan = IsNanF80(b);
+  const bool a_snan = IsSnanF80(a);
+  const bool b_snan = IsSnanF80(b);
+  if (a_snan || b_snan)
+    invalid = true;
+
+  f80 result;
+  if (!b_nan) {
+    result = a;
+  } else if (!a_nan) {
+    result = b;
+  } else if (a_snan != b_snan) {
+    result = a_snan ? b : a;
+  } else {
+    const u64 a_mag = a.signif & ~kIntegerBit;
+    const u64 b_mag = b.signif & ~kIntegerBit;
+    if (a_mag != b_mag)
+      result = a_mag > b_mag ? a : b;
+    else
+      result = SignF80(a) ? b : a;
+  }
+  result.signif |= kQuietBit;
+  return result;
+}
+
+f80 X87::PropagateNanF80(f80 a) {
+  if (IsSnanF80(a))
+    invalid = true;
+  a.signif |= kQuietBit;
+  return a;
+}
+
+// Rounds a significand with the integer bit at position 126 and a sticky lsb to the precision selected by the
+// precision control field. The exponent range is always that of the double extended precision format. The integer bit
+// is at position 126 to avoid an overflow of the significand when rounding.
+template <Vfpu::RoundingMode rm>
+f80 X87::RoundPackF80(bool sign, i32 exp, u128 mant) {
+  if (mant == 0)
+    return PackF80(sign, 0, 0);
+
+  const i32 round_bits = 127 - Precision();
+  const u128 round_mask = (static_cast<u128>(1) << round_bits) - 1;
+  const u128 half = static_cast<u128>(1) << (round_bits - 1);
+  u128 increment;
+  if constexpr (rm == kRoundTiesToEven || rm == kRoundTiesToAway)
+    increment = half;
+  else if constexpr (rm == kRoundTowardPositive)
+    increment = sign ? 0 : round_mask;
+  else if constexpr (rm == kRoundTowardNegative)
+    increment = sign ? round_mask : 0;
+  else
+    increment = 0;
+
+  bool tiny = false;
+  if (exp <= 0) {
+    tiny = tininess_before_rounding || exp < 0 || mant + increment < (static_cast<u128>(1) << (NumBits<u128>() - 1));
+    mant = RshiftSticky(mant, 1 - exp);
+    exp = 0;
+  } else if (exp >= kMaxExpF80 - 1) {
+    if (exp >= kMaxExpF80 || mant + increment >= (static_cast<u128>(1) << (NumBits<u128>() - 1))) {
+      overflow = true;
+      inexact = true;
+      if (rm == kRoundTiesToEven || rm == kRoundTiesToAway || increment == round_mask) {
+        c1 = true;
+        return PackF80(sign, kMaxExpF80, kIntegerBit);
+      }
+      c1 = false;
+      return PackF80(sign, kMaxExpF80 - 1, ~0ull << (64 - Precision()));
+    }
+  }
+
+  const u128 rest = mant & round_mask;
+  u128 signif = (mant + increment) >> round_bits;
+  if (rm == kRoundTiesToEven && rest == half)
+    signif &= ~static_cast<u128>(1);
+  c1 = signif > (mant >> round_bits);
+  if (rest) {
+    inexact = true;
+    underflow |= tiny;
+  }
+
+  if (exp == 0) {
+    // Denormal result. A carry into the integer bit yields the smallest normal number.
+    exp = static_cast<i32>(signif >> (Precision() - 1));
+  } else if (signif >> Precision()) {
+    signif >>= 1;
+    exp += 1;
+  }
+  return PackF80(sign, exp, static_cast<u64>(signif) << (64 - Precision()));
+}
+
+template <Vfpu::RoundingMode rm>
+f80 X87::AddSoft(f80 a, f80 b, bool subtract) {
+  const bool a_sign = SignF80(a);
+  const bool b_sign = SignF80(b) ^ subtract;
+  if (IsInfF80(a) || IsInfF80(b)) {
+    if (IsInfF80(a) && IsInfF80(b) && a_sign != b_sign) {
+      invalid = true;
+      return kIndefinite;
+    }
+    denormal |= IsDenormalF80(a) || IsDenormalF80(b);
+    return IsInfF80(a) ? a : PackF80(b_sign, kMaxExpF80, kIntegerBit);
+  }
+
+  denormal |= IsDenormalF80(a) || IsDenormalF80(b);
+  if (IsZeroF80(a) && IsZeroF80(b)) {
+    // See: IEEE 754-2019: 6.3 The sign bit
+    const bool sign = a_sign == b_sign ? a_sign : rm == kRoundTowardNegative;
+    return PackF80(sign, 0, 0);
+  }
+
+  i32 a_exp, b_exp;
+  u128 a_mant = static_cast<u128>(NormalizeF80(a, a_exp)) << 62;
+  u128 b_mant = static_cast<u128>(NormalizeF80(b, b_exp)) << 62;
+  bool sign = a_sign;
+  if (IsZeroF80(a)) {
+    return RoundPackF80<rm>(b_sign, b_exp, b_mant << 1);
+  } else if (IsZeroF80(b)) {
+    return RoundPackF80<rm>(a_sign, a_exp, a_mant << 1);
+  }
+
+  if (a_exp < b_exp || (a_exp == b_exp && a_mant < b_mant)) {
+    std::swap(a_exp, b_exp);
+    std::swap(a_mant, b_mant);
+    sign = b_sign;
+  }
+  b_mant = RshiftSticky(b_mant, a_exp - b_exp);
+
+  if (a_sign == b_sign) {
+    a_mant += b_mant;
+  } else {
+    a_mant -= b_mant;
+    if (a_mant == 0)  // See: IEEE 754-2019: 6.3 The sign bit
+      return PackF80(rm == kRoundTowardNegative, 0, 0);
+  }
+
+  const i32 shift = std::countl_zero(a_mant) - 1;
+  return RoundPackF80<rm>(sign, a_exp + 1 - shift, a_mant << shift);
+}
+
+template <Vfpu::RoundingMode rm>
+f80 X87::MulSoft(f80 a, f80 b) {
+  const bool sign = SignF80(a) ^ SignF80(b);
+  if (IsInfF80(a) || IsInfF80(b)) {
+    if (IsZeroF80(a) || IsZeroF80(b)) {
+      invalid = true;
+      return kIndefinite;
+    }
+    denormal |= IsDenormalF80(a) || IsDenormalF80(b);
+    return PackF80(sign, kMaxExpF80, kIntegerBit);
+  }
+
+  denormal |= IsDenormalF80(a) || IsDenormalF80(b);
+  if (IsZeroF80(a) || IsZeroF80(b))
+    return PackF80(sign, 0, 0);
+
+  i32 a_exp, b_exp;
+  const u64 a_signif = NormalizeF80(a, a_exp);
+  const u64 b_signif = NormalizeF80(b, b_exp);
+  u128 mant = static_cast<u128>(a_signif) * b_signif;
+  i32 exp = a_exp + b_exp - kBiasF80;
+  if (mant >> (NumBits<u128>() - 1)) {
+    mant = (mant >> 1) | (mant & 1);
+    exp += 1;
+  }
+  return RoundPackF80<rm>(sign, exp, mant);
+}
+
+template <Vfpu::RoundingMode rm>
+f80 X87::DivSoft(f80 a, f80 b) {
+  const bool sign = SignF80(a) ^ SignF80(b);
+  if (IsInfF80(a)) {
+    if (IsInfF80(b)) {
+      invalid = true;
+      return kIndefinite;
+    }
+    denormal |= IsDenormalF80(b);
+    return PackF80(sign, kMaxExpF80, kIntegerBit);
+  }
+  if (IsZeroF80(b)) {
+    if (IsZeroF80(a)) {
+      invalid = true;
+      return kIndefinite;
+    }
+    division_by_zero = true;
+    return PackF80(sign, kMaxExpF80, kIntegerBit);
+  }
+
+  denormal |= IsDenormalF80(a) || IsDenormalF80(b);
+  if (IsInfF80(b) || IsZeroF80(a))
+    return PackF80(sign, 0, 0);
+
+  i32 a_exp, b_exp;
+  const u64 a_signif = NormalizeF80(a, a_exp);
+  const u64 b_signif = NormalizeF80(b, b_exp);
+  i32 exp = a_exp - b_exp + kBiasF80;
+  u128 num;
+  if (a_signif < b_signif) {
+    num = static_cast<u128>(a_signif) << 64;
+    exp -= 1;
+  } else {
+    num = static_cast<u128>(a_signif) << 63;
+  }
+
+  // Long division in two steps of 64 bits each yields a 128-bit quotient with the msb at position 127.
+  const u128 q1 = num / b_signif;
+  const u128 r1 = num % b_signif;
+  const u128 q2 = (r1 << 64) / b_signif;
+  const u128 r2 = (r1 << 64) % b_signif;
+  const u128 quot = (q1 << 64) | q2;
+  const u128 mant = (quot >> 1) | (quot & 1) | (r2 != 0);
+  return RoundPackF80<rm>(sign, exp, mant);
+}
+
+template <Vfpu::RoundingMode rm>
+f80 X87::SqrtSoft(f80 a) {
+  if (IsZeroF80(a))
+    return a;
+  if (SignF80(a)) {
+    invalid = true;
+    return kIndefinite;
+  }
+  if (IsInfF80(a))
+    return a;
+
+  denormal |= IsDenormalF80(a);
+  i32 a_exp;
+  const u64 a_signif = NormalizeF80(a, a_exp);
+  const i32 exp = a_exp - kBiasF80;
+  // Radicand with an even exponent: a = rad * 2^(exp - 127) or a = rad * 2^(exp - 126).
+  const u128 rad = static_cast<u128>(a_signif) << ((exp & 1) ? 64 : 63);
+  const i32 rad_exp = exp - ((exp & 1) ? 127 : 126);
+
+  // The binary64 root is accurate to about 53 bits. One correction step with the exact remainder and a final
+  // adjustment yield the 64-bit integer square root.
+  constexpr f64 kMaxRoot = 18446744073709549568.0;  // Largest binary64 number below 2^64.
+  u64 root = static_cast<u64>(std::min(std::sqrt(static_cast<f64>(rad)), kMaxRoot));
+  const i128 diff = static_cast<i128>(rad - static_cast<u128>(root) * root);
+  root += static_cast<i64>(static_cast<f64>(diff) / (2 * static_cast<f64>(root)));
+  while (static_cast<u128>(root) * root > rad)
+    root -= 1;
+  while (root != ~0ull && static_cast<u128>(root + 1) * (root + 1) <= rad)
+    root += 1;
+
+  // The square root of rad lies in [root, root + 1) and cannot be a midpoint, so the remainder determines the guard bit
+  // and the sticky bit.
+  const u128 rem = rad - static_cast<u128>(root) * root;
+  const u128 mant = static_cast<u128>(root) << 63 | static_cast<u128>(rem > root) << 62 | (rem != 0);
+  return RoundPackF80<rm>(false, rad_exp / 2 + kBiasF80 + 63, mant);
+}
+
+// Corrects a round-to-nearest host result to the rounding mode rm. The direction is the sign of the exact residual,
+// i.e., whether the exact result lies below (-1) or above (1) the host result.
+template <Vfpu::RoundingMode rm>
+f80 X87::RoundHostResult(f80 result, int direction) {
+  if (direction == 0) {
+    c1 = false;
+    return result;
+  }
+
+  inexact = true;
+  const bool sign = SignF80(result);
+  const bool rounded_away = sign ? direction > 0 : direction < 0;
+  if constexpr (rm == kRoundTiesToEven) {
+    c1 = rounded_away;
+    return result;
+  } else {
+    bool want_away;
+    if constexpr (rm == kRoundTowardPositive)
+      want_away = !sign;
+    else if constexpr (rm == kRoundTowardNegative)
+      want_away = sign;
+    else
+      want_away = false;
+    c1 = want_away;
+    if (want_away && !rounded_away)
+      return NextUpMagnitude(result);
+    if (!want_away && rounded_away)
+      return NextDownMagnitude(result);
+    return result;
+  }
+}
+
+template <Vfpu::RoundingMode rm>
+f80 X87::Add(f80 a, f80 b) {
+#if defined(__x86_64__)
+  if constexpr (rm != kRoundTiesToAway) {
+    if (precision_control == kPrecisionExtended && IsFastPathF80(a) && IsFastPathF80(b)) {
+      const long double la = std::bit_cast<long double>(a);
+      const long double lb = std::bit_cast<long double>(b);
+      const long double lr = la + lb;
+      const f80 result = std::bit_cast<f80>(lr);
+      if (IsFastPathF80(result)) [[likely]] {
+        const long double bd = lr - la;
+        const long double e = (la - (lr - bd)) + (lb - bd);
+        return RoundHostResult<rm>(result, Direction(e));
+      }
+    }
+  }
+#endif
+  c1 = false;
+  if (IsUnsupportedF80(a) || IsUnsupportedF80(b)) [[unlikely]] {
+    invalid = true;
+    return kIndefinite;
+  }
+  if (IsNanF80(a) || IsNanF80(b))
+    return PropagateNanF80(a, b);
+  return AddSoft<rm>(a, b, false);
+}
+
+template f80 X87::Add<X87::kRoundTiesToEven>(f80 a, f80 b);
+template f80 X87::Add<X87::kRoundTowardPositive>(f80 a, f80 b);
+template f80 X87::Add<X87::kRoundTowardNegative>(f80 a, f80 b);
+template f80 X87::Add<X87::kRoundTowardZero>(f80 a, f80 b);
+template f80 X87::Add<X87::kRoundTiesToAway>(f80 a, f80 b);
+
+f80 X87::Add(f80 a, f80 b) {
+  f80 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, Add, a, b)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
+f80 X87::Sub(f80 a, f80 b) {
+#if defined(__x86_64__)
+  if constexpr (rm != kRoundTiesToAway) {
+    if (precision_control == kPrecisionExtended && IsFastPathF80(a) && IsFastPathF80(b)) {
+      const long double la = std::bit_cast<long double>(a);
+      const long double lb = -std::bit_cast<long double>(b);
+      const long double lr = la + lb;
+      const f80 result = std::bit_cast<f80>(lr);
+      if (IsFastPathF80(result)) [[likely]] {
+        const long double bd = lr - la;
+        const long double e = (la - (lr - bd)) + (lb - bd);
+        return RoundHostResult<rm>(result, Direction(e));
+      }
+    }
+  }
+#endif
+  c1 = false;
+  if (IsUnsupportedF80(a) || IsUnsupportedF80(b)) [[unlikely]] {
+    invalid = true;
+    return kIndefinite;
+  }
+  if (IsNanF80(a) || IsNanF80(b))
+    return PropagateNanF80(a, b);
+  return AddSoft<rm>(a, b, true);
+}
+
+template f80 X87::Sub<X87::kRoundTiesToEven>(f80 a, f80 b);
+template f80 X87::Sub<X87::kRoundTowardPositive>(f80 a, f80 b);
+template f80 X87::Sub<X87::kRoundTowardNegative>(f80 a, f80 b);
+template f80 X87::Sub<X87::kRoundTowardZero>(f80 a, f80 b);
+template f80 X87::Sub<X87::kRoundTiesToAway>(f80 a, f80 b);
+
+f80 X87::Sub(f80 a, f80 b) {
+  f80 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, Sub, a, b)
+  return result;
+}
+
+// The 64 x 64-bit integer product is as fast as an error-free transformation on the host, so there is no fast path.
+template <Vfpu::RoundingMode rm>
+f80 X87::Mul(f80 a, f80 b) {
+  c1 = false;
+  if (IsUnsupportedF80(a) || IsUnsupportedF80(b)) [[unlikely]] {
+    invalid = true;
+    return kIndefinite;
+  }
+  if (IsNanF80(a) || IsNanF80(b))
+    return PropagateNanF80(a, b);
+  return MulSoft<rm>(a, b);
+}
+
+template f80 X87::Mul<X87::kRoundTiesToEven>(f80 a, f80 b);
+template f80 X87::Mul<X87::kRoundTowardPositive>(f80 a, f80 b);
+template f80 X87::Mul<X87::kRoundTowardNegative>(f80 a, f80 b);
+template f80 X87::Mul<X87::kRoundTowardZero>(f80 a, f80 b);
+template f80 X87::Mul<X87::kRoundTiesToAway>(f80 a, f80 b);
+
+f80 X87::Mul(f80 a, f80 b) {
+  f80 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, Mul, a, b)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
+f80 X87::Div(f80 a, f80 b) {
+#if defined(__x86_64__)
+  if constexpr (rm != kRoundTiesToAway) {
+    if (precision_control == kPrecisionExtended && IsFastPathF80(a) && IsFastPathF80(b)) {
+      const long double la = std::bit_cast<long double>(a);
+      const long double lb = std::bit_cast<long double>(b);
+      const long double lr = la / lb;
+      const f80 result = std::bit_cast<f80>(lr);
+      if (IsFastPathF80(result)) [[likely]] {
+        // The quotient is exact if a - q * b = 0, and too small if the remainder has the sign of b.
+        const long double p = lr * lb;
+        const long double rem = (la - p) - TwoProduct(lr, lb, p);
+        return RoundHostResult<rm>(result, SignF80(b) ? -Direction(rem) : Direction(rem));
+      }
+    }
+  }
+#endif
+  c1 = false;
+  if (IsUnsupportedF80(a) || IsUnsupportedF80(b)) [[unlikely]] {
+    invalid = true;
+    return kIndefinite;
+  }
+  if (IsNanF80(a) || IsNanF80(b))
+    return PropagateNanF80(a, b);
+  return DivSoft<rm>(a, b);
+}
+
+template f80 X87::Div<X87::kRoundTiesToEven>(f80 a, f80 b);
+template f80 X87::Div<X87::kRoundTowardPositive>(f80 a, f80 b);
+template f80 X87::Div<X87::kRoundTowardNegative>(f80 a, f80 b);
+template f80 X87::Div<X87::kRoundTowardZero>(f80 a, f80 b);
+template f80 X87::Div<X87::kRoundTiesToAway>(f80 a, f80 b);
+
+f80 X87::Div(f80 a, f80 b) {
+  f80 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, Div, a, b)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
+f80 X87::Sqrt(f80 a) {
+#if defined(__x86_64__)
+  if constexpr (rm != kRoundTiesToAway) {
+    if (precision_control == kPrecisionExtended && IsFastPathF80(a) && !SignF80(a)) {
+      const long double la = std::bit_cast<long double>(a);
+      const long double lr = __builtin_sqrtl(la);
+      // The root is exact if r * r - a = 0, and too large if the residual is positive.
+      const long double p = lr * lr;
+      const long double res = (p - la) + TwoProduct(lr, lr, p);
+      return RoundHostResult<rm>(std::bit_cast<f80>(lr), -Direction(res));
+    }
+  }
+#endif
+  c1 = false;
+  if (IsUnsupportedF80(a)) [[unlikely]] {
+    invalid = true;
+    return kIndefinite;
+  }
+  if (IsNanF80(a))
+    return PropagateNanF80(a);
+  return SqrtSoft<rm>(a);
+}
+
+template f80 X87::Sqrt<X87::kRoundTiesToEven>(f80 a);
+template f80 X87::Sqrt<X87::kRoundTowardPositive>(f80 a);
+template f80 X87::Sqrt<X87::kRoundTowardNegative>(f80 a);
+template f80 X87::Sqrt<X87::kRoundTowardZero>(f80 a);
+template f80 X87::Sqrt<X87::kRoundTiesToAway>(f80 a);
+
+f80 X87::Sqrt(f80 a) {
+  f80 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, Sqrt, a)
+  return result;
+}
+
+f80 X87::PartialRemainder(f80 a, f80 b, bool round_to_nearest) {
+  c2 = false;
+  if (IsUnsupportedF80(a) || IsUnsupportedF80(b)) [[unlikely]] {
+    invalid = true;
+    return kIndefinite;
+  }
+  if (IsNanF80(a) || IsNanF80(b))
+    return PropagateNanF80(a, b);
+  if (IsInfF80(a) || IsZeroF80(b)) {
+    invalid = true;
+    return kIndefinite;
+  }
+
+  denormal |= IsDenormalF80(a) || IsDenormalF80(b);
+  c0 = c1 = c3 = false;
+  if (IsInfF80(b) || IsZeroF80(a))
+    return a;
+
+  i32 a_exp, b_exp;
+  const u64 a_signif = NormalizeF80(a, a_exp);
+  const u64 b_signif = NormalizeF80(b, b_exp);
+  const SignificandRemainder r = RemainderOfSignificands(a_signif, a_exp, b_signif, b_exp, round_to_nearest, true);
+  c2 = r.incomplete;
+  if (!r.incomplete) {
+    c0 = r.quotient & 4;
+    c3 = r.quotient & 2;
+    c1 = r.quotient & 1;
+  }
+
+  // The remainder is a multiple of the lsb of the smaller operand, so it is representable and the shifts are exact.
+  const bool sign = SignF80(a) != r.negate;
+  if (r.rem == 0)
+    return PackF80(SignF80(a), 0, 0);
+  const i32 shift = std::countl_zero(r.rem);
+  if (r.exp - shift >= 1)
+    return PackF80(sign, r.exp - shift, r.rem << shift);
+  return PackF80(sign, 0, r.exp >= 1 ? r.rem << (r.exp - 1) : r.rem >> (1 - r.exp));
+}
+
+f80 X87::F32ToF80(f32 a) {
+  const u32 ua = std::bit_cast<u32>(a);
+  const bool sign = ua >> 31;
+  const i32 exp = (ua >> 23) & 0xff;
+  const u64 mant = ua & 0x7fffff;
+  if (exp == 0xff) {
+    if (mant == 0)
+      return PackF80(sign, kMaxExpF80, kIntegerBit);
+    invalid |= !(mant & 0x400000);
+    return PackF80(sign, kMaxExpF80, kIntegerBit | kQuietBit | (mant << 40));
+  }
+  if (exp == 0) {
+    if (mant == 0)
+      return PackF80(sign, 0, 0);
+    denormal = true;
+    const i32 shift = std::countl_zero(mant);
+    return PackF80(sign, kBiasF80 + 63 - 149 - shift, mant << shift);
+  }
+  return PackF80(sign, exp - 127 + kBiasF80, kIntegerBit | (mant << 40));
+}
+
+f80 X87::F64ToF80(f64 a) {
+  const u64 ua = std::bit_cast<u64>(a);
+  const bool sign = ua >> 63;
+  const i32 exp = (ua >> 52) & 0x7ff;
+  const u64 mant = ua & 0xfffffffffffffull;
+  if (exp == 0x7ff) {
+    if (mant == 0)
+      return PackF80(sign, kMaxExpF80, kIntegerBit);
+    invalid |= !(mant & 0x8000000000000ull);
+    return PackF80(sign, kMaxExpF80, kIntegerBit | kQuietBit | (mant << 11));
+  }
+  if (exp == 0) {
+    if (mant == 0)
+      return PackF80(sign, 0, 0);
+    denormal = true;
+    const i32 shift = std::countl_zero(mant);
+    return PackF80(sign, kBiasF80 + 63 - 1074 - shift, mant << shift);
+  }
+  return PackF80(sign, exp - 1023 + kBiasF80, kIntegerBit | (mant << 11));
+}
+
+f80 X87::I16ToF80(i16 a) {
+  return I64ToF80(a);
+}
+
+f80 X87::I32ToF80(i32 a) {
+  return I64ToF80(a);
+}
+
+f80 X87::I64ToF80(i64 a) {
+  if (a == 0)
+    return PackF80(false, 0, 0);
+  const bool sign = a < 0;
+  const u64 mag = sign ? -static_cast<u64>(a) : static_cast<u64>(a);
+  const i32 shift = std::countl_zero(mag);
+  return PackF80(sign, kBiasF80 + 63 - shift, mag << shift);
+}
+
+// The binary128 format has the same exponent range as the double extended precision format and a wider significand.
+// Hence, the conversion is exact and the narrowing conversions can use the binary128 implementations.
+f128 X87::F80ToF128(f80 a) {
+  const u128 sign = static_cast<u128>(SignF80(a)) << 127;
+  i32 exp = ExpF80(a);
+  if (exp == 0 && (a.signif & kIntegerBit))
+    exp = 1;  // Pseudo-denormal.
+  return std::bit_cast<f128>(sign | static_cast<u128>(exp) << 112 | static_cast<u128>(a.signif & ~kIntegerBit) << 49);
+}
+
+template <Vfpu::RoundingMode rm>
+f32 X87::F80ToF32(f80 a) {
+  if (IsUnsupportedF80(a)) [[unlikely]] {
+    invalid = true;
+    return GetQnan<f32>();
+  }
+  return F128ToF32<rm>(F80ToF128(a));
+}
+
+template f32 X87::F80ToF32<X87::kRoundTiesToEven>(f80 a);
+template f32 X87::F80ToF32<X87::kRoundTowardPositive>(f80 a);
+template f32 X87::F80ToF32<X87::kRoundTowardNegative>(f80 a);
+template f32 X87::F80ToF32<X87::kRoundTowardZero>(f80 a);
+template f32 X87::F80ToF32<X87::kRoundTiesToAway>(f80 a);
+
+f32 X87::F80ToF32(f80 a) {
+  f32 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, F80ToF32, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
+f64 X87::F80ToF64(f80 a) {
+  if (IsUnsupportedF80(a)) [[unlikely]] {
+    invalid = true;
+    return GetQnan<f64>();
+  }
+  return F128ToF64<rm>(F80ToF128(a));
+}
+
+template f64 X87::F80ToF64<X87::kRoundTiesToEven>(f80 a);
+template f64 X87::F80ToF64<X87::kRoundTowardPositive>(f80 a);
+template f64 X87::F80ToF64<X87::kRoundTowardNegative>(f80 a);
+template f64 X87::F80ToF64<X87::kRoundTowardZero>(f80 a);
+template f64 X87::F80ToF64<X87::kRoundTiesToAway>(f80 a);
+
+f64 X87::F80ToF64(f80 a) {
+  f64 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, F80ToF64, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
+i16 X87::F80ToI16(f80 a) {
+  const bool old_inexact = inexact;
+  const i32 result = F80ToI32<rm>(a);
+  if (result < nl<i16>::min() || result > nl<i16>::max()) {
+    invalid = true;
+    inexact = old_inexact;
+    return nl<i16>::min();  // Integer indefinite.
+  }
+  return static_cast<i16>(result);
+}
+
+template i16 X87::F80ToI16<X87::kRoundTiesToEven>(f80 a);
+template i16 X87::F80ToI16<X87::kRoundTowardPositive>(f80 a);
+template i16 X87::F80ToI16<X87::kRoundTowardNegative>(f80 a);
+template i16 X87::F80ToI16<X87::kRoundTowardZero>(f80 a);
+template i16 X87::F80ToI16<X87::kRoundTiesToAway>(f80 a);
+
+i16 X87::F80ToI16(f80 a) {
+  i16 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, F80ToI16, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
+i32 X87::F80ToI32(f80 a) {
+  if (IsUnsupportedF80(a)) [[unlikely]] {
+    invalid = true;
+    return nan_limit_i32_;
+  }
+  return F128ToI32<rm>(F80ToF128(a));
+}
+
+template i32 X87::F80ToI32<X87::kRoundTiesToEven>(f80 a);
+template i32 X87::F80ToI32<X87::kRoundTowardPositive>(f80 a);
+template i32 X87::F80ToI32<X87::kRoundTowardNegative>(f80 a);
+template i32 X87::F80ToI32<X87::kRoundTowardZero>(f80 a);
+template i32 X87::F80ToI32<X87::kRoundTiesToAway>(f80 a);
+
+i32 X87::F80ToI32(f80 a) {
+  i32 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, F80ToI32, a)
+  return result;
+}
+
+template <Vfpu::RoundingMode rm>
+i64 X87::F80ToI64(f80 a) {
+  if (IsUnsupportedF80(a)) [[unlikely]] {
+    invalid = true;
+    return nan_limit_i64_;
+  }
+  return F128ToI64<rm>(F80ToF128(a));
+}
+
+template i64 X87::F80ToI64<X87::kRoundTiesToEven>(f80 a);
+template i64 X87::F80ToI64<X87::kRoundTowardPositive>(f80 a);
+template i64 X87::F80ToI64<X87::kRoundTowardNegative>(f80 a);
+template i64 X87::F80ToI64<X87::kRoundTowardZero>(f80 a);
+template i64 X87::F80ToI64<X87::kRoundTiesToAway>(f80 a);
+
+i64 X87::F80ToI64(f80 a) {
+  i64 result;
+  FLOPPY_FLOAT_FUNC_1(result, rounding_mode, F80ToI64, a)
+  return result;
+}
+
+f80 X87::StackUnderflow() {
+  invalid = true;
+  stack_fault = true;
+  c1 = false;
+  return kIndefinite;
+}
+
+void X87::Push(f80 a) {
+  top_ = (top_ - 1) & 7;
+  if (!empty_[top_]) {
+    invalid = true;
+    stack_fault = true;
+    c1 = true;
+    a = kIndefinite;
+  }
+  regs_[top_] = a;
+  empty_[top_] = false;
+}
+
+f80 X87::Pop() {
+  const f80 result = St(0);
+  empty_[top_] = true;
+  top_ = (top_ + 1) & 7;
+  return result;
+}
+
+f80 X87::St(int i) {
+  const u32 reg = (top_ + i) & 7;
+  if (empty_[reg])
+    return StackUnderflow();
+  return regs_[reg];
+}
+
+void X87::SetSt(int i, f80 a) {
+  const u32 reg = (top_ + i) & 7;
+  regs_[reg] = a;
+  empty_[reg] = false;
+}
+
+bool X87::IsEmpty(int i) {
+  return empty_[(top_ + i) & 7];
+}
+
+void X87::Fxch(int i) {
+  const f80 a = St(0);
+  const f80 b = St(i);
+  SetSt(0, b);
+  SetSt(i, a);
+}
+
+void X87::Fadd(int i, int j) {
+  if (IsEmpty(i) || IsEmpty(j))
+    SetSt(i, StackUnderflow());
+  else
+    SetSt(i, Add(St(i), St(j)));
+}
+
+void X87::Fsub(int i, int j) {
+  if (IsEmpty(i) || IsEmpty(j))
+    SetSt(i, StackUnderflow());
+  else
+    SetSt(i, Sub(St(i), St(j)));
+}
+
+void X87::Fmul(int i, int j) {
+  if (IsEmpty(i) || IsEmpty(j))
+    SetSt(i, StackUnderflow());
+  else
+    SetSt(i, Mul(St(i), St(j)));
+}
+
+void X87::Fdiv(int i, int j) {
+  if (IsEmpty(i) || IsEmpty(j))
+    SetSt(i, StackUnderflow());
+  else
+    SetSt(i, Div(St(i), St(j)));
+}
+
+void X87::Fsqrt() {
+  if (IsEmpty(0))
+    SetSt(0, StackUnderflow());
+  else
+    SetSt(0, Sqrt(St(0)));
+}
+
+void X87::Fprem() {
+  if (IsEmpty(0) || IsEmpty(1))
+    SetSt(0, StackUnderflow());
+  else
+    SetSt(0, PartialRemainder(St(0), St(1), false));
+}
+
+void X87::Fprem1() {
+  if (IsEmpty(0) || IsEmpty(1))
+    SetSt(0, StackUnderflow());
+  else
+    SetSt(0, PartialRemainder(St(0), St(1), true));
+}
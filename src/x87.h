@@ -0,0 +1,119 @@
+#pragma once
+/**************************************************************************************************
+ * Apache License, Version 2.0
+ * Copyright (c) 2024 chciken/Niko Zurstraßen
+ **************************************************************************************************/
+
+#include "soft_float.h"
+#include "utils.h"
+
+// Simulates the x87 FPU: double extended precision arithmetic, precision control, and the register stack.
+// Exceptions are always handled as if masked, i.e., operations deliver the masked response and only set flags.
+class X87 : public SoftFloat {
+ public:
+  // See Intel SDM Vol. 1, 8.1.5.2 "Precision Control Field".
+  enum PrecisionControl { kPrecisionSingle = 0, kPrecisionDouble = 2, kPrecisionExtended = 3 } precision_control;
+
+  // Status word bits that are not covered by the exception flags of Vfpu.
+  bool denormal;     // DE: An operand was denormal.
+  bool stack_fault;  // SF: The invalid operation was caused by a stack overflow (C1 = 1) or underflow (C1 = 0).
+  bool c0, c1, c2, c3;
+
+  X87();
+
+  void ClearFlags();  // See "fclex".
+
+  FfUtils::u16 GetControlWord();  // See "fnstcw".
+  void SetControlWord(FfUtils::u16 cw);  // See "fldcw".
+  FfUtils::u16 GetStatusWord();  // See "fnstsw".
+  FfUtils::u16 GetTagWord();
+
+  template <RoundingMode rm>
+  FfUtils::f80 Add(FfUtils::f80 a, FfUtils::f80 b);
+  FfUtils::f80 Add(FfUtils::f80 a, FfUtils::f80 b);
+
+  template <RoundingMode rm>
+  FfUtils::f80 Sub(FfUtils::f80 a, FfUtils::f80 b);
+  FfUtils::f80 Sub(FfUtils::f80 a, FfUtils::f80 b);
+
+  template <RoundingMode rm>
+  FfUtils::f80 Mul(FfUtils::f80 a, FfUtils::f80 b);
+  FfUtils::f80 Mul(FfUtils::f80 a, FfUtils::f80 b);
+
+  template <RoundingMode rm>
+  FfUtils::f80 Div(FfUtils::f80 a, FfUtils::f80 b);
+  FfUtils::f80 Div(FfUtils::f80 a, FfUtils::f80 b);
+
+  template <RoundingMode rm>
+  FfUtils::f80 Sqrt(FfUtils::f80 a);
+  FfUtils::f80 Sqrt(FfUtils::f80 a);
+
+  // Partial remainder (see "fprem/fprem1"): a - b * q with q = a / b rounded toward zero, or to nearest for FPREM1.
+  // The result is exact. C0, C3, and C1 receive the three least significant bits of q. If the exponents differ by 64
+  // or more, a is only partially reduced and C2 is set, so that the instruction must be repeated.
+  FfUtils::f80 PartialRemainder(FfUtils::f80 a, FfUtils::f80 b, bool round_to_nearest);
+
+  FfUtils::f80 F32ToF80(FfUtils::f32 a);  // See "fld m32fp".
+  FfUtils::f80 F64ToF80(FfUtils::f64 a);  // See "fld m64fp".
+  FfUtils::f80 I16ToF80(FfUtils::i16 a);  // See "fild m16int".
+  FfUtils::f80 I32ToF80(FfUtils::i32 a);  // See "fild m32int".
+  FfUtils::f80 I64ToF80(FfUtils::i64 a);  // See "fild m64int".
+
+  template <RoundingMode rm>
+  FfUtils::f32 F80ToF32(FfUtils::f80 a);  // See "fst m32fp".
+  FfUtils::f32 F80ToF32(FfUtils::f80 a);
+  template <RoundingMode rm>
+  FfUtils::f64 F80ToF64(FfUtils::f80 a);  // See "fst m64fp".
+  FfUtils::f64 F80ToF64(FfUtils::f80 a);
+  template <RoundingMode rm>
+  FfUtils::i16 F80ToI16(FfUtils::f80 a);  // See "fist m16int".
+  FfUtils::i16 F80ToI16(FfUtils::f80 a);
+  template <RoundingMode rm>
+  FfUtils::i32 F80ToI32(FfUtils::f80 a);  // See "fist m32int".
+  FfUtils::i32 F80ToI32(FfUtils::f80 a);
+  template <RoundingMode rm>
+  FfUtils::i64 F80ToI64(FfUtils::f80 a);  // See "fistp m64int".
+  FfUtils::i64 F80ToI64(FfUtils::f80 a);
+
+  // Register stack (see Intel SDM Vol. 1, 8.1.2 "x87 FPU Data Registers"). Accessing an empty register is a stack
+  // underflow, pushing onto a full stack a stack overflow. Both deliver the real indefinite.
+  void Push(FfUtils::f80 a);  // See "fld".
+  FfUtils::f80 Pop();  // See "fstp".
+  FfUtils::f80 St(int i);
+  void SetSt(int i, FfUtils::f80 a);
+  bool IsEmpty(int i);
+  void Fxch(int i);
+  void Fadd(int i, int j);  // ST(i) = ST(i) + ST(j)
+  void Fsub(int i, int j);  // ST(i) = ST(i) - ST(j)
+  void Fmul(int i, int j);  // ST(i) = ST(i) * ST(j)
+  void Fdiv(int i, int j);  // ST(i) = ST(i) / ST(j)
+  void Fsqrt();  // ST(0) = sqrt(ST(0))
+  void Fprem();  // ST(0) = ST(0) - ST(1) * trunc(ST(0) / ST(1))
+  void Fprem1();  // ST(0) = ST(0) - ST(1) * round(ST(0) / ST(1))
+
+ protected:
+  FfUtils::f80 regs_[8];
+  bool empty_[8];
+  FfUtils::u32 top_;
+  FfUtils::u16 exception_masks_;
+
+  FfUtils::i32 Precision();
+  FfUtils::f80 StackUnderflow();
+
+  template <RoundingMode rm>
+  FfUtils::f80 RoundPackF80(bool sign, FfUtils::i32 exp, FfUtils::u128 mant);
+  template <RoundingMode rm>
+  FfUtils::f80 AddSoft(FfUtils::f80 a, FfUtils::f80 b, bool subtract);
+  template <RoundingMode rm>
+  FfUtils::f80 MulSoft(FfUtils::f80 a, FfUtils::f80 b);
+  template <RoundingMode rm>
+  FfUtils::f80 DivSoft(FfUtils::f80 a, FfUtils::f80 b);
+  template <RoundingMode rm>
+  FfUtils::f80 SqrtSoft(FfUtils::f80 a);
+  template <RoundingMode rm>
+  FfUtils::f80 RoundHostResult(FfUtils::f80 result, int direction);
+
+  FfUtils::f80 PropagateNanF80(FfUtils::f80 a);
+  FfUtils::f80 PropagateNanF80(FfUtils::f80 a, FfUtils::f80 b);
+  FfUtils::f128 F80ToF128(FfUtils::f80 a);
+};
@@ -0,0 +1,73 @@
+#pragma once
+/*******************************************************************************
+ * Apache License, Version 2.0
+ * Copyright (c) 2024 chciken/Niko Zurstraßen
+ ******************************************************************************/
+
+#include <bit>
+
+#include "utils.h"
+#include "vfpu.h"
+
+extern "C" {
+#include "softfloat.h"
+}
+
+// Maps the FloppyFloat types to the Berkeley SoftFloat types and adapts the reference results to the simulated ISA.
+template <typename T>
+struct FFloatToSFloat;
+
+template <>
+struct FFloatToSFloat<FfUtils::f16> {
+  using type = float16_t;
+};
+template <>
+struct FFloatToSFloat<FfUtils::f32> {
+  using type = float32_t;
+};
+template <>
+struct FFloatToSFloat<FfUtils::f64> {
+  using type = float64_t;
+};
+template <>
+struct FFloatToSFloat<FfUtils::f128> {
+  using type = float128_t;
+};
+
+#if defined(ARCH_ARM) && defined(ARM_PROPAGATE_NAN)
+constexpr Vfpu::NanPropagationSchemes kArmNanPropagation = Vfpu::kNanPropArm64;  // FPCR.DN = 0, see ARM-VFPv2.
+#else
+constexpr Vfpu::NanPropagationSchemes kArmNanPropagation = Vfpu::kNanPropArm64DefaultNan;
+#endif
+
+// Berkeley SoftFloat propagates the NaNs of a fused multiply-add in the order a, b, c. Arm with FPCR.DN = 0 takes the
+// first signaling NaN, otherwise the first NaN, in the order c, a, b (see FPMulAdd).
+template <typename FT, typename SFT = FFloatToSFloat<FT>::type>
+SFT MulAddRef(SFT a, SFT b, SFT c, SFT (*mul_add)(SFT, SFT, SFT)) {
+  using namespace FfUtils;
+  const SFT result = mul_add(a, b, c);
+#if defined(ARCH_ARM)
+  if (kArmNanPropagation == Vfpu::kNanPropArm64) {
+    const FT fa = std::bit_cast<FT>(a);
+    const FT fb = std::bit_cast<FT>(b);
+    const FT fc = std::bit_cast<FT>(c);
+    const bool inf_times_zero = (IsInf(fa) && IsZero(fb)) || (IsZero(fa) && IsInf(fb));
+    if (IsSnan(fc) || (IsQnan(fc) && !IsSnan(fa) && !IsSnan(fb) && !inf_times_zero))
+      return std::bit_cast<SFT>(SetQuietBit(fc));
+  }
+#endif
+  return result;
+}
+
+inline float16_t f16_mulAddRef(float16_t a, float16_t b, float16_t c) {
+  return MulAddRef<FfUtils::f16>(a, b, c, ::f16_mulAdd);
+}
+inline float32_t f32_mulAddRef(float32_t a, float32_t b, float32_t c) {
+  return MulAddRef<FfUtils::f32>(a, b, c, ::f32_mulAdd);
+}
+inline float64_t f64_mulAddRef(float64_t a, float64_t b, float64_t c) {
+  return MulAddRef<FfUtils::f64>(a, b, c, ::f64_mulAdd);
+}
+inline float128_t f128_mulAddRef(float128_t a, float128_t b, float128_t c) {
+  return MulAddRef<FfUtils::f128>(a, b, c, ::f128_mulAdd);
+}
@@ -16,8 +16,17 @@
 #include <tuple>
 #include <vector>
 
+#include "avx512.h"
+#include "complex_float.h"
+#include "dot_product.h"
+#include "estimator.h"
+#include "f16_tables.h"
 #include "floppy_float.h"
+#include "fp8.h"
+#include "ieee_float.h"
+#include "mx.h"
 #include "utils.h"
+#include "x87.h"
 
 extern "C" {
 #include "softfloat.h"
@@ -51,6 +60,26 @@ class FloatRng {
   std::vector<FT> values_;
 };
 
+template <typename IT>
+class IntRng {
+ public:
+  IntRng(int seed) : index_(0), engine_(seed), dist_(0, NumBits<IT>() - 1), values_() {
+    for (size_t i = 0; i < size_; ++i)
+      values_.push_back(static_cast<IT>(engine_() >> dist_(engine_)));
+  }
+
+  constexpr IT Gen() { return values_[index_++ % size_]; }
+
+  void Reset() {}
+
+ private:
+  size_t index_;
+  static constexpr size_t size_ = 1024;
+  std::mt19937_64 engine_;
+  std::uniform_int_distribution<int> dist_;
+  std::vector<IT> values_;
+};
+
 std::vector<std::tuple<std::string, f64>> result_vec;
 
 #define PERF_TEST_FF_0(func, ftype, ...)                                                      \
@@ -119,20 +148,549 @@ std::vector<std::tuple<std::string, f64>> result_vec;
     ::softfloat_roundingMode = rm;                                                            \
     FloatRng<ftype> float_rng(kRngSeed);                                                      \
     [[maybe_unused]] sftype a, b, c;                                                          \
-    a.v = std::bit_cast<typename FloatToUint<ftype>::type>(float_rng.Gen());                  \
-    b.v = std::bit_cast<typename FloatToUint<ftype>::type>(float_rng.Gen());                  \
-    c.v = std::bit_cast<typename FloatToUint<ftype>::type>(float_rng.Gen());                  \
+    a = std::bit_cast<sftype>(float_rng.Gen());                                               \
+    b = std::bit_cast<sftype>(float_rng.Gen());                                               \
+    c = std::bit_cast<sftype>(float_rng.Gen());                                               \
     begin = std::chrono::steady_clock::now();                                                 \
     for (size_t i = 0; i < kNumIterations; ++i) {                                             \
       [[maybe_unused]] auto result = func(__VA_ARGS__);                                       \
-      b.v = a.v;                                                                              \
-      a.v = std::bit_cast<typename FloatToUint<ftype>::type>(float_rng.Gen());                \
+      b = a;                                                                                  \
+      a = std::bit_cast<sftype>(float_rng.Gen());                                             \
     }                                                                                         \
     end = std::chrono::steady_clock::now();                                                   \
     ms_sf_float = std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count(); \
     float_rng.Reset();                                                                        \
   }
 
+#define PERF_TEST_FF_ITOF(rm, func, itype, ftype)                                             \
+  {                                                                                           \
+    ff.rounding_mode = rm;                                                                    \
+    IntRng<itype> int_rng(kRngSeed);                                                          \
+    itype a = int_rng.Gen();                                                                  \
+    begin = std::chrono::steady_clock::now();                                                 \
+    for (size_t i = 0; i < kNumIterations; ++i) {                                             \
+      [[maybe_unused]] ftype result;                                                          \
+      FLOPPY_FLOAT_FUNC_1(result, rm, func, a)                                                \
+      a = int_rng.Gen();                                                                      \
+    }                                                                                         \
+    end = std::chrono::steady_clock::now();                                                   \
+    ms_ff_float = std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count(); \
+  }
+
+#define PERF_TEST_SF_ITOF(rm, func, itype)                                                    \
+  {                                                                                           \
+    ::softfloat_roundingMode = rm;                                                            \
+    IntRng<itype> int_rng(kRngSeed);                                                          \
+    itype a = int_rng.Gen();                                                                  \
+    begin = std::chrono::steady_clock::now();                                                 \
+    for (size_t i = 0; i < kNumIterations; ++i) {                                             \
+      [[maybe_unused]] auto result = func(a);                                                 \
+      a = int_rng.Gen();                                                                      \
+    }                                                                                         \
+    end = std::chrono::steady_clock::now();                                                   \
+    ms_sf_float = std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count(); \
+  }
+
+// MX kernels on tensor-sized inputs (1M elements). The SoftFloat reference performs comparable work element by element:
+// scaling plus narrowing for Quantize, widening plus scaling for Dequantize, and a fused multiply-add for Dot.
+constexpr size_t kMxNumBlocks = 1 << 15;
+constexpr i32 kMxNumRepetitions = 20;
+
+template <typename FT>
+void PerfTestMx(const std::string& name) {
+  FloatRng<f32> float_rng(kRngSeed);
+  std::vector<f32> values(kMxNumBlocks * MxBlock<FT>::kSize);
+  std::vector<f32> dequantized(values.size());
+  for (auto& v : values)
+    v = float_rng.Gen();
+  std::vector<MxBlock<FT>> blocks(kMxNumBlocks);
+  Mx mx;
+  mx.SetupToX86();
+  ::softfloat_roundingMode = ::softfloat_round_near_even;
+  u32 sink = 0;
+
+  auto measure = [](auto&& func) {
+    auto begin = std::chrono::steady_clock::now();
+    for (i32 i = 0; i < kMxNumRepetitions; ++i)
+      func();
+    auto end = std::chrono::steady_clock::now();
+    return (f64)std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+  };
+
+  const f64 us_ff_quantize = measure([&] { mx.Quantize(blocks.data(), values.data(), kMxNumBlocks); });
+  const f64 us_sf_quantize = measure([&] {
+    const float32_t scale = std::bit_cast<float32_t>(0x3b800000u);  // 2^-8
+    for (f32 v : values)
+      sink ^= f32_to_f16(f32_mul(std::bit_cast<float32_t>(v), scale)).v;
+  });
+  result_vec.push_back({"MxQuantize" + name, us_sf_quantize / us_ff_quantize});
+
+  const f64 us_ff_dequantize = measure([&] { mx.Dequantize(dequantized.data(), blocks.data(), kMxNumBlocks); });
+  const f64 us_sf_dequantize = measure([&] {
+    const float32_t scale = std::bit_cast<float32_t>(0x43800000u);  // 2^8
+    for (const auto& block : blocks) {
+      for (const auto& element : block.elements)
+        sink ^= f32_mul(f16_to_f32(float16_t{static_cast<uint16_t>(element.v << 8)}), scale).v;
+    }
+  });
+  result_vec.push_back({"MxDequantize" + name, us_sf_dequantize / us_ff_dequantize});
+
+  const f64 us_ff_dot = measure([&] { sink ^= std::bit_cast<u32>(mx.Dot(blocks.data(), blocks.data(), kMxNumBlocks)); });
+  const f64 us_sf_dot = measure([&] {
+    float32_t acc{0};
+    for (f32 v : dequantized)
+      acc = f32_mulAdd(std::bit_cast<float32_t>(v), std::bit_cast<float32_t>(v), acc);
+    sink ^= acc.v;
+  });
+  result_vec.push_back({"MxDot" + name, us_sf_dot / us_ff_dot});
+
+  if (sink == 0x12345678u)
+    std::cout << "";
+}
+
+// Table lookups of F16Tables versus the computation plus fixups of FloppyFloat.
+template <typename Op>
+void PerfTestF16Tables(const std::string& name, Op op) {
+  FloatRng<f16> float_rng(kRngSeed);
+  F16Tables tables;
+  FloppyFloat ff;
+  u64 sink = 0;
+
+  auto measure = [&](auto& fpu) {
+    auto begin = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < kNumIterations; ++i)
+      sink += static_cast<u64>(op(fpu, float_rng.Gen()));
+    auto end = std::chrono::steady_clock::now();
+    return (f64)std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
+  };
+
+  const f64 ms_ff = measure(ff);
+  const f64 ms_tables = measure(tables);
+  result_vec.push_back({"F16Tables" + name, ms_ff / ms_tables});
+
+  if (sink == 0x12345678u)
+    std::cout << "";
+}
+
+// Fast path of IeeeFloat versus its integer implementation for a generic format.
+template <typename FT>
+void PerfTestIeee(const std::string& name) {
+  FloatRng<f32> float_rng(kRngSeed);
+  IeeeFloat fpu;
+  std::vector<FT> values(1024);
+  for (auto& v : values)
+    v = fpu.F64ToIeee<FT>(float_rng.Gen());
+  u64 sink = 0;
+
+  auto measure = [&](bool fast_path, auto op) {
+    fpu.fast_path = fast_path;
+    auto begin = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < kNumIterations; ++i)
+      sink += op(values[i % 1024], values[(i + 1) % 1024], values[(i + 2) % 1024]).v;
+    auto end = std::chrono::steady_clock::now();
+    return (f64)std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
+  };
+
+  auto add = [&](FT a, FT b, FT) { return fpu.Add(a, b); };
+  auto mul = [&](FT a, FT b, FT) { return fpu.Mul(a, b); };
+  auto div = [&](FT a, FT b, FT) { return fpu.Div(a, b); };
+  auto fma = [&](FT a, FT b, FT c) { return fpu.Fma(a, b, c); };
+  result_vec.push_back({"IeeeAdd" + name, measure(false, add) / measure(true, add)});
+  result_vec.push_back({"IeeeMul" + name, measure(false, mul) / measure(true, mul)});
+  result_vec.push_back({"IeeeDiv" + name, measure(false, div) / measure(true, div)});
+  result_vec.push_back({"IeeeFma" + name, measure(false, fma) / measure(true, fma)});
+
+  if (sink == 0x12345678u)
+    std::cout << "";
+}
+
+// Batch kernel versus a loop of scalar calls, e.g., for a ReLU (maximum with zero).
+template <typename FT>
+void PerfTestMinMaxBatch(const std::string& name) {
+  FloatRng<FT> float_rng(kRngSeed);
+  FloppyFloat ff;
+  constexpr size_t kSize = 4096;
+  std::vector<FT> values(kSize), zeros(kSize, FT(0)), result(kSize);
+  for (auto& v : values)
+    v = float_rng.Gen();
+
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumIterations / kSize; ++i)
+    for (size_t j = 0; j < kSize; ++j)
+      result[j] = ff.Maximum(values[j], zeros[j]);
+  auto end = std::chrono::steady_clock::now();
+  const f64 us_scalar = (f64)std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+
+  begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumIterations / kSize; ++i)
+    ff.MinMaxBatch(FloppyFloat::kMaximum, result.data(), values.data(), zeros.data(), kSize);
+  end = std::chrono::steady_clock::now();
+  const f64 us_batch = (f64)std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+  result_vec.push_back({"MinMaxBatch" + name, us_scalar / us_batch});
+}
+
+template <typename FT>
+void PerfTestEstimateBatch(const std::string& name) {
+  FloatRng<FT> float_rng(kRngSeed);
+  Estimator estimator;
+  constexpr size_t kSize = 4096;
+  std::vector<FT> values(kSize), result(kSize);
+  for (auto& v : values)
+    v = float_rng.Gen();
+
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumIterations / kSize; ++i)
+    for (size_t j = 0; j < kSize; ++j)
+      result[j] = estimator.RecipEstimateArm(values[j]);
+  auto end = std::chrono::steady_clock::now();
+  const f64 us_scalar = (f64)std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+
+  begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumIterations / kSize; ++i)
+    estimator.Batch(Estimator::kRecipEstimateArm, result.data(), values.data(), kSize);
+  end = std::chrono::steady_clock::now();
+  const f64 us_batch = (f64)std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+  result_vec.push_back({"EstimateBatch" + name, us_scalar / us_batch});
+}
+
+// Remainders of random operands, whose exponent differences are often too large for the host fast path.
+template <typename FT, typename SFT>
+void PerfTestRemainder(const std::string& name, SFT (*sf_rem)(SFT, SFT)) {
+  FloatRng<FT> float_rng(kRngSeed);
+  FloppyFloat fpu;
+  constexpr size_t kSize = 4096;
+  std::vector<FT> a(kSize), b(kSize);
+  for (size_t j = 0; j < kSize; ++j) {
+    a[j] = float_rng.Gen();
+    b[j] = float_rng.Gen();
+  }
+
+  FT sink = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumIterations / kSize; ++i)
+    for (size_t j = 0; j < kSize; ++j)
+      sink += fpu.Remainder(a[j], b[j]);
+  auto end = std::chrono::steady_clock::now();
+  const f64 us_ff = (f64)std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+
+  SFT sf_sink{};
+  begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumIterations / kSize; ++i)
+    for (size_t j = 0; j < kSize; ++j)
+      sf_sink = sf_rem(std::bit_cast<SFT>(a[j]), std::bit_cast<SFT>(b[j]));
+  end = std::chrono::steady_clock::now();
+  const f64 us_sf = (f64)std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+  [[maybe_unused]] volatile FT keep = sink + std::bit_cast<FT>(sf_sink);
+  result_vec.push_back({"Remainder" + name, us_sf / us_ff});
+}
+
+// Fused dot products of four terms per element against the same number of chained Berkeley FMAs.
+template <typename FT, typename SFT>
+void PerfTestDotProduct(const std::string& name, SFT (*sf_fma)(SFT, SFT, SFT)) {
+  FloatRng<FT> float_rng(kRngSeed);
+  DotProduct fpu;
+  constexpr size_t kTerms = 4;
+  constexpr size_t kCount = 1024;
+  std::vector<FT> a(kTerms * kCount), b(kTerms * kCount), result(kCount);
+  for (size_t j = 0; j < kTerms * kCount; ++j) {
+    a[j] = float_rng.Gen();
+    b[j] = float_rng.Gen();
+  }
+
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumIterations / (kTerms * kCount); ++i)
+    fpu.Batch(DotProduct::kFused, result.data(), a.data(), b.data(), kTerms, kCount);
+  auto end = std::chrono::steady_clock::now();
+  const f64 us_ff = (f64)std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+
+  begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumIterations / (kTerms * kCount); ++i) {
+    for (size_t j = 0; j < kCount; ++j) {
+      SFT acc = std::bit_cast<SFT>(result[j]);
+      for (size_t k = 0; k < kTerms; ++k)
+        acc = sf_fma(std::bit_cast<SFT>(a[j * kTerms + k]), std::bit_cast<SFT>(b[j * kTerms + k]), acc);
+      result[j] = std::bit_cast<FT>(acc);
+    }
+  }
+  end = std::chrono::steady_clock::now();
+  const f64 us_sf = (f64)std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+  result_vec.push_back({"DotProductFused" + name, us_sf / us_ff});
+}
+
+// Complex multiplications (x86 "vfmulcph") of a whole vector versus a loop of scalar calls.
+template <typename FT>
+void PerfTestComplexBatch(const std::string& name) {
+  FloatRng<FT> float_rng(kRngSeed);
+  ComplexFloat fpu;
+  fpu.SetupToX86();
+  constexpr size_t kSize = 2048;  // Complex numbers.
+  std::vector<FT> a(2 * kSize), b(2 * kSize), result(2 * kSize);
+  for (size_t j = 0; j < 2 * kSize; ++j) {
+    a[j] = float_rng.Gen();
+    b[j] = float_rng.Gen();
+  }
+
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumIterations / (2 * kSize); ++i)
+    for (size_t j = 0; j < kSize; ++j)
+      fpu.MulcX86(&result[2 * j], &a[2 * j], &b[2 * j], false);
+  auto end = std::chrono::steady_clock::now();
+  const f64 us_scalar = (f64)std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+
+  begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumIterations / (2 * kSize); ++i)
+    fpu.Batch(ComplexFloat::kMulcX86, result.data(), a.data(), b.data(), kSize);
+  end = std::chrono::steady_clock::now();
+  const f64 us_batch = (f64)std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+  result_vec.push_back({"ComplexBatch" + name, us_scalar / us_batch});
+}
+
+// Q31 conversions (Arm "fcvtzs" with #fbits) of a whole vector versus a loop of scalar calls.
+template <typename FT>
+void PerfTestFixedBatch(const std::string& name) {
+  FloppyFloat fpu;
+  fpu.SetupToArm();
+  constexpr size_t kSize = 4096;
+  constexpr u32 kFbits = 31;
+  std::mt19937 rng(kRngSeed);
+  std::uniform_real_distribution<f64> dist(-1., 1.);
+  std::vector<FT> values(kSize);
+  std::vector<i32> result(kSize);
+  for (auto& v : values)
+    v = static_cast<FT>(dist(rng));
+
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumIterations / kSize; ++i)
+    for (size_t j = 0; j < kSize; ++j)
+      result[j] = fpu.FToFixed<FT, i32>(values[j], kFbits);
+  auto end = std::chrono::steady_clock::now();
+  const f64 us_scalar = (f64)std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+
+  begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumIterations / kSize; ++i)
+    fpu.FToFixedBatch(result.data(), values.data(), kFbits, kSize);
+  end = std::chrono::steady_clock::now();
+  const f64 us_batch = (f64)std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+  result_vec.push_back({"FToFixedBatch" + name, us_scalar / us_batch});
+}
+
+// Divisions with embedded rounding (AVX-512 {er}): The quiet variant versus saving and restoring the flags.
+template <typename FT>
+void PerfTestQuiet(const std::string& name) {
+  FloppyFloat fpu;
+  fpu.SetupToX86();
+  constexpr size_t kSize = 4096;
+  std::mt19937 rng(kRngSeed);
+  std::uniform_real_distribution<f64> dist(1., 2.);
+  std::vector<FT> a(kSize), b(kSize), result(kSize);
+  for (size_t j = 0; j < kSize; ++j) {
+    a[j] = static_cast<FT>(dist(rng));
+    b[j] = static_cast<FT>(dist(rng));
+  }
+
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumIterations / kSize; ++i) {
+    for (size_t j = 0; j < kSize; ++j) {
+      const bool invalid = fpu.invalid, division_by_zero = fpu.division_by_zero, overflow = fpu.overflow;
+      const bool underflow = fpu.underflow, inexact = fpu.inexact;
+      result[j] = fpu.Div<FT, Vfpu::kRoundTiesToEven>(a[j], b[j]);
+      fpu.invalid = invalid;
+      fpu.division_by_zero = division_by_zero;
+      fpu.overflow = overflow;
+      fpu.underflow = underflow;
+      fpu.inexact = inexact;
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  const f64 us_restore = (f64)std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+
+  begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumIterations / kSize; ++i)
+    for (size_t j = 0; j < kSize; ++j)
+      result[j] = fpu.Div<FT, Vfpu::kRoundTiesToEven, true>(a[j], b[j]);
+  end = std::chrono::steady_clock::now();
+  const f64 us_quiet = (f64)std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+  result_vec.push_back({"QuietDiv" + name, us_restore / us_quiet});
+}
+
+// Flushing tiny products to zero on top of the full multiplication vs. the flush-to-zero mode.
+template <typename FT>
+void PerfTestFlush(const std::string& name) {
+  FloppyFloat fpu;
+  fpu.SetupToX86();
+  constexpr size_t kSize = 4096;
+  std::mt19937 rng(kRngSeed);
+  std::uniform_real_distribution<f64> dist(1., 2.);
+  std::vector<FT> a(kSize), b(kSize), result(kSize);
+  for (size_t j = 0; j < kSize; ++j) {
+    a[j] = static_cast<FT>(std::ldexp(dist(rng), std::numeric_limits<FT>::min_exponent / 2));
+    b[j] = static_cast<FT>(std::ldexp(dist(rng), std::numeric_limits<FT>::min_exponent / 2 - (j & 7)));
+  }
+
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumIterations / kSize; ++i) {
+    for (size_t j = 0; j < kSize; ++j) {
+      const bool underflow = fpu.underflow;
+      fpu.underflow = false;
+      result[j] = fpu.Mul<FT>(a[j], b[j]);
+      if (fpu.underflow || IsSubnormal(result[j]))
+        result[j] = std::copysign(static_cast<FT>(0.), result[j]);
+      fpu.underflow |= underflow;
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  const f64 us_full = (f64)std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+
+  fpu.flush_inputs = true;
+  fpu.flush_outputs = true;
+  begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumIterations / kSize; ++i)
+    for (size_t j = 0; j < kSize; ++j)
+      result[j] = fpu.Mul<FT>(a[j], b[j]);
+  end = std::chrono::steady_clock::now();
+  const f64 us_flush = (f64)std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+  result_vec.push_back({"FlushMul" + name, us_full / us_flush});
+}
+
+// The x86 setup looks at subnormal operands to report DE, even without DAZ and FTZ. Normal operands versus the RISC-V
+// setup, which skips the check.
+template <typename FT>
+void PerfTestDenormalCheck(const std::string& name) {
+  FloppyFloat x86;
+  FloppyFloat riscv;
+  x86.SetupToX86();
+  riscv.SetupToRiscv();
+  constexpr size_t kSize = 4096;
+  std::mt19937 rng(kRngSeed);
+  std::uniform_real_distribution<f64> dist(1., 2.);
+  std::vector<FT> a(kSize), b(kSize), result(kSize);
+  for (size_t j = 0; j < kSize; ++j) {
+    a[j] = static_cast<FT>(dist(rng));
+    b[j] = static_cast<FT>(dist(rng));
+  }
+
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumIterations / kSize; ++i)
+    for (size_t j = 0; j < kSize; ++j)
+      result[j] = riscv.Add<FT>(riscv.Mul<FT>(a[j], b[j]), b[j]);
+  auto end = std::chrono::steady_clock::now();
+  const f64 us_unchecked = (f64)std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+
+  begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumIterations / kSize; ++i)
+    for (size_t j = 0; j < kSize; ++j)
+      result[j] = x86.Add<FT>(x86.Mul<FT>(a[j], b[j]), b[j]);
+  end = std::chrono::steady_clock::now();
+  const f64 us_checked = (f64)std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+  result_vec.push_back({"DenormalCheck" + name, us_unchecked / us_checked});
+}
+
+template <typename FT>
+void PerfTestAvx512Batch(const std::string& name) {
+  FloatRng<FT> float_rng(kRngSeed);
+  Avx512 avx512;
+  avx512.SetupToX86();
+  constexpr size_t kSize = 4096;
+  constexpr u8 kImm8 = 0x1;  // Interval [1/2, 2) with the sign of the operand.
+  std::vector<FT> values(kSize), result(kSize);
+  for (auto& v : values)
+    v = float_rng.Gen();
+
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumIterations / kSize; ++i)
+    for (size_t j = 0; j < kSize; ++j)
+      result[j] = avx512.GetMant(values[j], kImm8);
+  auto end = std::chrono::steady_clock::now();
+  const f64 us_scalar = (f64)std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+
+  begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumIterations / kSize; ++i)
+    avx512.Batch(Avx512::kGetMant, result.data(), values.data(), static_cast<const FT*>(nullptr), kImm8, kSize);
+  end = std::chrono::steady_clock::now();
+  const f64 us_batch = (f64)std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+  result_vec.push_back({"GetMantBatch" + name, us_scalar / us_batch});
+}
+
+// FP8 multiplications by table lookup versus widening to f32, multiplying there (exact), and rounding back, and the
+// batch version versus a loop of scalar lookups.
+template <typename FT8>
+void PerfTestFp8(const std::string& name) {
+  std::mt19937 rng(kRngSeed);
+  Fp8 fp8;
+  FloppyFloat fpu;
+  constexpr size_t kSize = 4096;
+  std::vector<FT8> a(kSize), b(kSize), result(kSize);
+  for (size_t j = 0; j < kSize; ++j) {
+    a[j].v = static_cast<u8>(rng());
+    b[j].v = static_cast<u8>(rng());
+  }
+
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumIterations / kSize; ++i)
+    for (size_t j = 0; j < kSize; ++j)
+      result[j] = fp8.F32ToF8<FT8>(fpu.Mul<f32>(fp8.F8ToF32(a[j]), fp8.F8ToF32(b[j])));
+  auto end = std::chrono::steady_clock::now();
+  const f64 us_widen = (f64)std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+
+  begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumIterations / kSize; ++i)
+    for (size_t j = 0; j < kSize; ++j)
+      result[j] = fp8.Mul(a[j], b[j]);
+  end = std::chrono::steady_clock::now();
+  const f64 us_scalar = (f64)std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+
+  begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumIterations / kSize; ++i)
+    fp8.Batch(Fp8::kMul, reinterpret_cast<u8*>(result.data()), a.data(), b.data(), kSize);
+  end = std::chrono::steady_clock::now();
+  const f64 us_batch = (f64)std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+  result_vec.push_back({"Fp8Mul" + name, us_widen / us_scalar});
+  result_vec.push_back({"Fp8MulBatch" + name, us_scalar / us_batch});
+}
+
+// x87 arithmetic under each precision control setting against Berkeley's extF80 with the matching rounding precision.
+void PerfTestX87(const std::string& name, X87::PrecisionControl precision, uint_fast8_t sf_precision) {
+  FloatRng<f64> float_rng(kRngSeed);
+  X87 x87;
+  x87.precision_control = precision;
+  ::extF80_roundingPrecision = sf_precision;
+  constexpr size_t kSize = 4096;
+  std::vector<f80> a(kSize), b(kSize), result(kSize);
+  for (size_t j = 0; j < kSize; ++j) {
+    a[j] = x87.F64ToF80(float_rng.Gen() + 1.);
+    b[j] = x87.F64ToF80(float_rng.Gen() + 1.);
+  }
+  auto to_sf = [](f80 v) {
+    extFloat80_t r;
+    r.signif = v.signif;
+    r.signExp = v.sign_exp;
+    return r;
+  };
+  auto to_ff = [](extFloat80_t v) { return f80{v.signif, v.signExp}; };
+
+  auto measure = [&](auto op) {
+    auto begin = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < kNumIterations / kSize; ++i)
+      for (size_t j = 0; j < kSize; ++j)
+        result[j] = op(a[j], b[j]);
+    auto end = std::chrono::steady_clock::now();
+    return (f64)std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+  };
+  const std::array<std::tuple<std::string, f64, f64>, 4> ops{{
+      {"Add", measure([&](f80 x, f80 y) { return to_ff(::extF80_add(to_sf(x), to_sf(y))); }),
+       measure([&](f80 x, f80 y) { return x87.Add(x, y); })},
+      {"Mul", measure([&](f80 x, f80 y) { return to_ff(::extF80_mul(to_sf(x), to_sf(y))); }),
+       measure([&](f80 x, f80 y) { return x87.Mul(x, y); })},
+      {"Div", measure([&](f80 x, f80 y) { return to_ff(::extF80_div(to_sf(x), to_sf(y))); }),
+       measure([&](f80 x, f80 y) { return x87.Div(x, y); })},
+      {"Sqrt", measure([&](f80 x, f80) { return to_ff(::extF80_sqrt(to_sf(x))); }),
+       measure([&](f80 x, f80) { return x87.Sqrt(x); })},
+  }};
+  for (const auto& [op_name, us_sf, us_ff] : ops)
+    result_vec.push_back({"X87" + op_name + name, us_sf / us_ff});
+  ::extF80_roundingPrecision = 80;
+}
+
 int main() {
   FloppyFloat ff;
   ff.SetupToX86();
@@ -252,6 +810,18 @@ int main() {
   PERF_TEST_SF(::softfloat_round_near_maxMag, f32_sqrt, float32_t, f32, a)
   result_vec.push_back({"Sqrtf32RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
 
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToEven, ff.RoundToIntegral, f32, a)
+  PERF_TEST_SF(::softfloat_round_near_even, f32_roundToInt, float32_t, f32, a, ::softfloat_roundingMode, false)
+  result_vec.push_back({"RoundToIntegralf32", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardNegative, ff.RoundToIntegral, f32, a)
+  PERF_TEST_SF(::softfloat_round_min, f32_roundToInt, float32_t, f32, a, ::softfloat_roundingMode, false)
+  result_vec.push_back({"RoundToIntegralf32RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToAway, ff.RoundToIntegral, f32, a)
+  PERF_TEST_SF(::softfloat_round_near_maxMag, f32_roundToInt, float32_t, f32, a, ::softfloat_roundingMode, false)
+  result_vec.push_back({"RoundToIntegralf32RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
   PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToEven, ff.Fma, f32, a, b, c)
   PERF_TEST_SF(::softfloat_round_near_even, f32_mulAdd, float32_t, f32, a, b, c)
   result_vec.push_back({"Fmaf32", (f64)ms_sf_float / (f64)ms_ff_float});
@@ -496,6 +1066,166 @@ int main() {
   PERF_TEST_SF(::softfloat_round_near_maxMag, f64_mulAdd, float64_t, f64, a, b, c)
   result_vec.push_back({"Fmaf64RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
 
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToEven, ff.Add, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_near_even, f128_add, float128_t, f128, a, b)
+  result_vec.push_back({"Addf128", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardPositive, ff.Add, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_max, f128_add, float128_t, f128, a, b)
+  result_vec.push_back({"Addf128RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardNegative, ff.Add, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_min, f128_add, float128_t, f128, a, b)
+  result_vec.push_back({"Addf128RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardZero, ff.Add, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_minMag, f128_add, float128_t, f128, a, b)
+  result_vec.push_back({"Addf128RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToAway, ff.Add, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_near_maxMag, f128_add, float128_t, f128, a, b)
+  result_vec.push_back({"Addf128RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToEven, ff.Sub, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_near_even, f128_sub, float128_t, f128, a, b)
+  result_vec.push_back({"Subf128", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardPositive, ff.Sub, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_max, f128_sub, float128_t, f128, a, b)
+  result_vec.push_back({"Subf128RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardNegative, ff.Sub, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_min, f128_sub, float128_t, f128, a, b)
+  result_vec.push_back({"Subf128RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardZero, ff.Sub, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_minMag, f128_sub, float128_t, f128, a, b)
+  result_vec.push_back({"Subf128RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToAway, ff.Sub, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_near_maxMag, f128_sub, float128_t, f128, a, b)
+  result_vec.push_back({"Subf128RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToEven, ff.Mul, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_near_even, f128_mul, float128_t, f128, a, b)
+  result_vec.push_back({"Mulf128", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardPositive, ff.Mul, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_max, f128_mul, float128_t, f128, a, b)
+  result_vec.push_back({"Mulf128RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardNegative, ff.Mul, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_min, f128_mul, float128_t, f128, a, b)
+  result_vec.push_back({"Mulf128RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardZero, ff.Mul, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_minMag, f128_mul, float128_t, f128, a, b)
+  result_vec.push_back({"Mulf128RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToAway, ff.Mul, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_near_maxMag, f128_mul, float128_t, f128, a, b)
+  result_vec.push_back({"Mulf128RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToEven, ff.Div, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_near_even, f128_div, float128_t, f128, a, b)
+  result_vec.push_back({"Divf128", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardPositive, ff.Div, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_max, f128_div, float128_t, f128, a, b)
+  result_vec.push_back({"Divf128RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardNegative, ff.Div, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_min, f128_div, float128_t, f128, a, b)
+  result_vec.push_back({"Divf128RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardZero, ff.Div, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_minMag, f128_div, float128_t, f128, a, b)
+  result_vec.push_back({"Divf128RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToAway, ff.Div, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_near_maxMag, f128_div, float128_t, f128, a, b)
+  result_vec.push_back({"Divf128RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToEven, ff.Sqrt, f128, a)
+  PERF_TEST_SF(::softfloat_round_near_even, f128_sqrt, float128_t, f128, a)
+  result_vec.push_back({"Sqrtf128", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardPositive, ff.Sqrt, f128, a)
+  PERF_TEST_SF(::softfloat_round_max, f128_sqrt, float128_t, f128, a)
+  result_vec.push_back({"Sqrtf128RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardNegative, ff.Sqrt, f128, a)
+  PERF_TEST_SF(::softfloat_round_min, f128_sqrt, float128_t, f128, a)
+  result_vec.push_back({"Sqrtf128RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardZero, ff.Sqrt, f128, a)
+  PERF_TEST_SF(::softfloat_round_minMag, f128_sqrt, float128_t, f128, a)
+  result_vec.push_back({"Sqrtf128RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToAway, ff.Sqrt, f128, a)
+  PERF_TEST_SF(::softfloat_round_near_maxMag, f128_sqrt, float128_t, f128, a)
+  result_vec.push_back({"Sqrtf128RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToEven, ff.Fma, f128, a, b, c)
+  PERF_TEST_SF(::softfloat_round_near_even, f128_mulAdd, float128_t, f128, a, b, c)
+  result_vec.push_back({"Fmaf128", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardPositive, ff.Fma, f128, a, b, c)
+  PERF_TEST_SF(::softfloat_round_max, f128_mulAdd, float128_t, f128, a, b, c)
+  result_vec.push_back({"Fmaf128RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardNegative, ff.Fma, f128, a, b, c)
+  PERF_TEST_SF(::softfloat_round_min, f128_mulAdd, float128_t, f128, a, b, c)
+  result_vec.push_back({"Fmaf128RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardZero, ff.Fma, f128, a, b, c)
+  PERF_TEST_SF(::softfloat_round_minMag, f128_mulAdd, float128_t, f128, a, b, c)
+  result_vec.push_back({"Fmaf128RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToAway, ff.Fma, f128, a, b, c)
+  PERF_TEST_SF(::softfloat_round_near_maxMag, f128_mulAdd, float128_t, f128, a, b, c)
+  result_vec.push_back({"Fmaf128RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTiesToEven, ff.F128ToF32, f128, a)
+  PERF_TEST_SF(::softfloat_round_near_even, f128_to_f32, float128_t, f128, a)
+  result_vec.push_back({"F128ToF32", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTowardPositive, ff.F128ToF32, f128, a)
+  PERF_TEST_SF(::softfloat_round_max, f128_to_f32, float128_t, f128, a)
+  result_vec.push_back({"F128ToF32RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTowardNegative, ff.F128ToF32, f128, a)
+  PERF_TEST_SF(::softfloat_round_min, f128_to_f32, float128_t, f128, a)
+  result_vec.push_back({"F128ToF32RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTowardZero, ff.F128ToF32, f128, a)
+  PERF_TEST_SF(::softfloat_round_minMag, f128_to_f32, float128_t, f128, a)
+  result_vec.push_back({"F128ToF32RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTiesToAway, ff.F128ToF32, f128, a)
+  PERF_TEST_SF(::softfloat_round_near_maxMag, f128_to_f32, float128_t, f128, a)
+  result_vec.push_back({"F128ToF32RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTiesToEven, ff.F128ToF64, f128, a)
+  PERF_TEST_SF(::softfloat_round_near_even, f128_to_f64, float128_t, f128, a)
+  result_vec.push_back({"F128ToF64", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTowardPositive, ff.F128ToF64, f128, a)
+  PERF_TEST_SF(::softfloat_round_max, f128_to_f64, float128_t, f128, a)
+  result_vec.push_back({"F128ToF64RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTowardNegative, ff.F128ToF64, f128, a)
+  PERF_TEST_SF(::softfloat_round_min, f128_to_f64, float128_t, f128, a)
+  result_vec.push_back({"F128ToF64RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTowardZero, ff.F128ToF64, f128, a)
+  PERF_TEST_SF(::softfloat_round_minMag, f128_to_f64, float128_t, f128, a)
+  result_vec.push_back({"F128ToF64RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTiesToAway, ff.F128ToF64, f128, a)
+  PERF_TEST_SF(::softfloat_round_near_maxMag, f128_to_f64, float128_t, f128, a)
+  result_vec.push_back({"F128ToF64RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
   PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTiesToEven, ff.F64ToF16, f64, a)
   PERF_TEST_SF(::softfloat_round_near_even, f64_to_f16, float64_t, f64, a)
   result_vec.push_back({"F64ToF16", (f64)ms_sf_float / (f64)ms_ff_float});
@@ -616,6 +1346,407 @@ int main() {
   PERF_TEST_SF(::softfloat_round_near_maxMag, f64_to_ui64, float64_t, f64, a, ::softfloat_roundingMode, true)
   result_vec.push_back({"F64ToU64RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
 
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTiesToEven, ff.F128ToI32, f128, a)
+  PERF_TEST_SF(::softfloat_round_near_even, f128_to_i32, float128_t, f128, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F128ToI32", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTowardPositive, ff.F128ToI32, f128, a)
+  PERF_TEST_SF(::softfloat_round_max, f128_to_i32, float128_t, f128, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F128ToI32RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTowardNegative, ff.F128ToI32, f128, a)
+  PERF_TEST_SF(::softfloat_round_min, f128_to_i32, float128_t, f128, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F128ToI32RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTowardZero, ff.F128ToI32, f128, a)
+  PERF_TEST_SF(::softfloat_round_minMag, f128_to_i32, float128_t, f128, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F128ToI32RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTiesToAway, ff.F128ToI32, f128, a)
+  PERF_TEST_SF(::softfloat_round_near_maxMag, f128_to_i32, float128_t, f128, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F128ToI32RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTiesToEven, ff.F128ToI64, f128, a)
+  PERF_TEST_SF(::softfloat_round_near_even, f128_to_i64, float128_t, f128, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F128ToI64", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTowardPositive, ff.F128ToI64, f128, a)
+  PERF_TEST_SF(::softfloat_round_max, f128_to_i64, float128_t, f128, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F128ToI64RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTowardNegative, ff.F128ToI64, f128, a)
+  PERF_TEST_SF(::softfloat_round_min, f128_to_i64, float128_t, f128, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F128ToI64RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTowardZero, ff.F128ToI64, f128, a)
+  PERF_TEST_SF(::softfloat_round_minMag, f128_to_i64, float128_t, f128, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F128ToI64RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTiesToAway, ff.F128ToI64, f128, a)
+  PERF_TEST_SF(::softfloat_round_near_maxMag, f128_to_i64, float128_t, f128, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F128ToI64RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToEven, ff.Add, f16, a, b)
+  PERF_TEST_SF(::softfloat_round_near_even, f16_add, float16_t, f16, a, b)
+  result_vec.push_back({"Addf16", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardPositive, ff.Add, f16, a, b)
+  PERF_TEST_SF(::softfloat_round_max, f16_add, float16_t, f16, a, b)
+  result_vec.push_back({"Addf16RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardNegative, ff.Add, f16, a, b)
+  PERF_TEST_SF(::softfloat_round_min, f16_add, float16_t, f16, a, b)
+  result_vec.push_back({"Addf16RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardZero, ff.Add, f16, a, b)
+  PERF_TEST_SF(::softfloat_round_minMag, f16_add, float16_t, f16, a, b)
+  result_vec.push_back({"Addf16RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToAway, ff.Add, f16, a, b)
+  PERF_TEST_SF(::softfloat_round_near_maxMag, f16_add, float16_t, f16, a, b)
+  result_vec.push_back({"Addf16RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToEven, ff.Sub, f16, a, b)
+  PERF_TEST_SF(::softfloat_round_near_even, f16_sub, float16_t, f16, a, b)
+  result_vec.push_back({"Subf16", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardPositive, ff.Sub, f16, a, b)
+  PERF_TEST_SF(::softfloat_round_max, f16_sub, float16_t, f16, a, b)
+  result_vec.push_back({"Subf16RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardNegative, ff.Sub, f16, a, b)
+  PERF_TEST_SF(::softfloat_round_min, f16_sub, float16_t, f16, a, b)
+  result_vec.push_back({"Subf16RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardZero, ff.Sub, f16, a, b)
+  PERF_TEST_SF(::softfloat_round_minMag, f16_sub, float16_t, f16, a, b)
+  result_vec.push_back({"Subf16RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToAway, ff.Sub, f16, a, b)
+  PERF_TEST_SF(::softfloat_round_near_maxMag, f16_sub, float16_t, f16, a, b)
+  result_vec.push_back({"Subf16RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToEven, ff.Mul, f16, a, b)
+  PERF_TEST_SF(::softfloat_round_near_even, f16_mul, float16_t, f16, a, b)
+  result_vec.push_back({"Mulf16", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardPositive, ff.Mul, f16, a, b)
+  PERF_TEST_SF(::softfloat_round_max, f16_mul, float16_t, f16, a, b)
+  result_vec.push_back({"Mulf16RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardNegative, ff.Mul, f16, a, b)
+  PERF_TEST_SF(::softfloat_round_min, f16_mul, float16_t, f16, a, b)
+  result_vec.push_back({"Mulf16RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardZero, ff.Mul, f16, a, b)
+  PERF_TEST_SF(::softfloat_round_minMag, f16_mul, float16_t, f16, a, b)
+  result_vec.push_back({"Mulf16RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToAway, ff.Mul, f16, a, b)
+  PERF_TEST_SF(::softfloat_round_near_maxMag, f16_mul, float16_t, f16, a, b)
+  result_vec.push_back({"Mulf16RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToEven, ff.Div, f16, a, b)
+  PERF_TEST_SF(::softfloat_round_near_even, f16_div, float16_t, f16, a, b)
+  result_vec.push_back({"Divf16", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardPositive, ff.Div, f16, a, b)
+  PERF_TEST_SF(::softfloat_round_max, f16_div, float16_t, f16, a, b)
+  result_vec.push_back({"Divf16RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardNegative, ff.Div, f16, a, b)
+  PERF_TEST_SF(::softfloat_round_min, f16_div, float16_t, f16, a, b)
+  result_vec.push_back({"Divf16RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardZero, ff.Div, f16, a, b)
+  PERF_TEST_SF(::softfloat_round_minMag, f16_div, float16_t, f16, a, b)
+  result_vec.push_back({"Divf16RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToAway, ff.Div, f16, a, b)
+  PERF_TEST_SF(::softfloat_round_near_maxMag, f16_div, float16_t, f16, a, b)
+  result_vec.push_back({"Divf16RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToEven, ff.Sqrt, f16, a)
+  PERF_TEST_SF(::softfloat_round_near_even, f16_sqrt, float16_t, f16, a)
+  result_vec.push_back({"Sqrtf16", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardPositive, ff.Sqrt, f16, a)
+  PERF_TEST_SF(::softfloat_round_max, f16_sqrt, float16_t, f16, a)
+  result_vec.push_back({"Sqrtf16RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardNegative, ff.Sqrt, f16, a)
+  PERF_TEST_SF(::softfloat_round_min, f16_sqrt, float16_t, f16, a)
+  result_vec.push_back({"Sqrtf16RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardZero, ff.Sqrt, f16, a)
+  PERF_TEST_SF(::softfloat_round_minMag, f16_sqrt, float16_t, f16, a)
+  result_vec.push_back({"Sqrtf16RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToAway, ff.Sqrt, f16, a)
+  PERF_TEST_SF(::softfloat_round_near_maxMag, f16_sqrt, float16_t, f16, a)
+  result_vec.push_back({"Sqrtf16RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTiesToEven, ff.F16ToI32, f16, a)
+  PERF_TEST_SF(::softfloat_round_near_even, f16_to_i32, float16_t, f16, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F16ToI32", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTowardPositive, ff.F16ToI32, f16, a)
+  PERF_TEST_SF(::softfloat_round_max, f16_to_i32, float16_t, f16, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F16ToI32RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTowardNegative, ff.F16ToI32, f16, a)
+  PERF_TEST_SF(::softfloat_round_min, f16_to_i32, float16_t, f16, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F16ToI32RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTowardZero, ff.F16ToI32, f16, a)
+  PERF_TEST_SF(::softfloat_round_minMag, f16_to_i32, float16_t, f16, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F16ToI32RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTiesToAway, ff.F16ToI32, f16, a)
+  PERF_TEST_SF(::softfloat_round_near_maxMag, f16_to_i32, float16_t, f16, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F16ToI32RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTiesToEven, ff.F16ToI64, f16, a)
+  PERF_TEST_SF(::softfloat_round_near_even, f16_to_i64, float16_t, f16, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F16ToI64", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTowardPositive, ff.F16ToI64, f16, a)
+  PERF_TEST_SF(::softfloat_round_max, f16_to_i64, float16_t, f16, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F16ToI64RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTowardNegative, ff.F16ToI64, f16, a)
+  PERF_TEST_SF(::softfloat_round_min, f16_to_i64, float16_t, f16, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F16ToI64RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTowardZero, ff.F16ToI64, f16, a)
+  PERF_TEST_SF(::softfloat_round_minMag, f16_to_i64, float16_t, f16, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F16ToI64RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTiesToAway, ff.F16ToI64, f16, a)
+  PERF_TEST_SF(::softfloat_round_near_maxMag, f16_to_i64, float16_t, f16, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F16ToI64RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTiesToEven, ff.F16ToU32, f16, a)
+  PERF_TEST_SF(::softfloat_round_near_even, f16_to_ui32, float16_t, f16, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F16ToU32", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTowardPositive, ff.F16ToU32, f16, a)
+  PERF_TEST_SF(::softfloat_round_max, f16_to_ui32, float16_t, f16, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F16ToU32RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTowardNegative, ff.F16ToU32, f16, a)
+  PERF_TEST_SF(::softfloat_round_min, f16_to_ui32, float16_t, f16, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F16ToU32RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTowardZero, ff.F16ToU32, f16, a)
+  PERF_TEST_SF(::softfloat_round_minMag, f16_to_ui32, float16_t, f16, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F16ToU32RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTiesToAway, ff.F16ToU32, f16, a)
+  PERF_TEST_SF(::softfloat_round_near_maxMag, f16_to_ui32, float16_t, f16, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F16ToU32RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTiesToEven, ff.F16ToU64, f16, a)
+  PERF_TEST_SF(::softfloat_round_near_even, f16_to_ui64, float16_t, f16, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F16ToU64", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTowardPositive, ff.F16ToU64, f16, a)
+  PERF_TEST_SF(::softfloat_round_max, f16_to_ui64, float16_t, f16, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F16ToU64RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTowardNegative, ff.F16ToU64, f16, a)
+  PERF_TEST_SF(::softfloat_round_min, f16_to_ui64, float16_t, f16, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F16ToU64RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTowardZero, ff.F16ToU64, f16, a)
+  PERF_TEST_SF(::softfloat_round_minMag, f16_to_ui64, float16_t, f16, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F16ToU64RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTiesToAway, ff.F16ToU64, f16, a)
+  PERF_TEST_SF(::softfloat_round_near_maxMag, f16_to_ui64, float16_t, f16, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F16ToU64RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTiesToEven, ff.I64ToF16, i64, f16)
+  PERF_TEST_SF_ITOF(::softfloat_round_near_even, i64_to_f16, i64)
+  result_vec.push_back({"I64ToF16", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTowardPositive, ff.I64ToF16, i64, f16)
+  PERF_TEST_SF_ITOF(::softfloat_round_max, i64_to_f16, i64)
+  result_vec.push_back({"I64ToF16RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTowardNegative, ff.I64ToF16, i64, f16)
+  PERF_TEST_SF_ITOF(::softfloat_round_min, i64_to_f16, i64)
+  result_vec.push_back({"I64ToF16RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTowardZero, ff.I64ToF16, i64, f16)
+  PERF_TEST_SF_ITOF(::softfloat_round_minMag, i64_to_f16, i64)
+  result_vec.push_back({"I64ToF16RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTiesToAway, ff.I64ToF16, i64, f16)
+  PERF_TEST_SF_ITOF(::softfloat_round_near_maxMag, i64_to_f16, i64)
+  result_vec.push_back({"I64ToF16RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTiesToEven, ff.I64ToF32, i64, f32)
+  PERF_TEST_SF_ITOF(::softfloat_round_near_even, i64_to_f32, i64)
+  result_vec.push_back({"I64ToF32", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTowardPositive, ff.I64ToF32, i64, f32)
+  PERF_TEST_SF_ITOF(::softfloat_round_max, i64_to_f32, i64)
+  result_vec.push_back({"I64ToF32RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTowardNegative, ff.I64ToF32, i64, f32)
+  PERF_TEST_SF_ITOF(::softfloat_round_min, i64_to_f32, i64)
+  result_vec.push_back({"I64ToF32RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTowardZero, ff.I64ToF32, i64, f32)
+  PERF_TEST_SF_ITOF(::softfloat_round_minMag, i64_to_f32, i64)
+  result_vec.push_back({"I64ToF32RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTiesToAway, ff.I64ToF32, i64, f32)
+  PERF_TEST_SF_ITOF(::softfloat_round_near_maxMag, i64_to_f32, i64)
+  result_vec.push_back({"I64ToF32RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTiesToEven, ff.I64ToF64, i64, f64)
+  PERF_TEST_SF_ITOF(::softfloat_round_near_even, i64_to_f64, i64)
+  result_vec.push_back({"I64ToF64", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTowardPositive, ff.I64ToF64, i64, f64)
+  PERF_TEST_SF_ITOF(::softfloat_round_max, i64_to_f64, i64)
+  result_vec.push_back({"I64ToF64RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTowardNegative, ff.I64ToF64, i64, f64)
+  PERF_TEST_SF_ITOF(::softfloat_round_min, i64_to_f64, i64)
+  result_vec.push_back({"I64ToF64RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTowardZero, ff.I64ToF64, i64, f64)
+  PERF_TEST_SF_ITOF(::softfloat_round_minMag, i64_to_f64, i64)
+  result_vec.push_back({"I64ToF64RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTiesToAway, ff.I64ToF64, i64, f64)
+  PERF_TEST_SF_ITOF(::softfloat_round_near_maxMag, i64_to_f64, i64)
+  result_vec.push_back({"I64ToF64RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTiesToEven, ff.U32ToF16, u32, f16)
+  PERF_TEST_SF_ITOF(::softfloat_round_near_even, ui32_to_f16, u32)
+  result_vec.push_back({"U32ToF16", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTowardPositive, ff.U32ToF16, u32, f16)
+  PERF_TEST_SF_ITOF(::softfloat_round_max, ui32_to_f16, u32)
+  result_vec.push_back({"U32ToF16RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTowardNegative, ff.U32ToF16, u32, f16)
+  PERF_TEST_SF_ITOF(::softfloat_round_min, ui32_to_f16, u32)
+  result_vec.push_back({"U32ToF16RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTowardZero, ff.U32ToF16, u32, f16)
+  PERF_TEST_SF_ITOF(::softfloat_round_minMag, ui32_to_f16, u32)
+  result_vec.push_back({"U32ToF16RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTiesToAway, ff.U32ToF16, u32, f16)
+  PERF_TEST_SF_ITOF(::softfloat_round_near_maxMag, ui32_to_f16, u32)
+  result_vec.push_back({"U32ToF16RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTiesToEven, ff.U64ToF16, u64, f16)
+  PERF_TEST_SF_ITOF(::softfloat_round_near_even, ui64_to_f16, u64)
+  result_vec.push_back({"U64ToF16", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTowardPositive, ff.U64ToF16, u64, f16)
+  PERF_TEST_SF_ITOF(::softfloat_round_max, ui64_to_f16, u64)
+  result_vec.push_back({"U64ToF16RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTowardNegative, ff.U64ToF16, u64, f16)
+  PERF_TEST_SF_ITOF(::softfloat_round_min, ui64_to_f16, u64)
+  result_vec.push_back({"U64ToF16RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTowardZero, ff.U64ToF16, u64, f16)
+  PERF_TEST_SF_ITOF(::softfloat_round_minMag, ui64_to_f16, u64)
+  result_vec.push_back({"U64ToF16RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTiesToAway, ff.U64ToF16, u64, f16)
+  PERF_TEST_SF_ITOF(::softfloat_round_near_maxMag, ui64_to_f16, u64)
+  result_vec.push_back({"U64ToF16RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTiesToEven, ff.U64ToF64, u64, f64)
+  PERF_TEST_SF_ITOF(::softfloat_round_near_even, ui64_to_f64, u64)
+  result_vec.push_back({"U64ToF64", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTowardPositive, ff.U64ToF64, u64, f64)
+  PERF_TEST_SF_ITOF(::softfloat_round_max, ui64_to_f64, u64)
+  result_vec.push_back({"U64ToF64RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTowardNegative, ff.U64ToF64, u64, f64)
+  PERF_TEST_SF_ITOF(::softfloat_round_min, ui64_to_f64, u64)
+  result_vec.push_back({"U64ToF64RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTowardZero, ff.U64ToF64, u64, f64)
+  PERF_TEST_SF_ITOF(::softfloat_round_minMag, ui64_to_f64, u64)
+  result_vec.push_back({"U64ToF64RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTiesToAway, ff.U64ToF64, u64, f64)
+  PERF_TEST_SF_ITOF(::softfloat_round_near_maxMag, ui64_to_f64, u64)
+  result_vec.push_back({"U64ToF64RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  // Integers are exact in f128, so the rounding mode does not matter.
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTiesToEven, ff.I64ToF128, i64, f128)
+  PERF_TEST_SF_ITOF(::softfloat_round_near_even, i64_to_f128, i64)
+  result_vec.push_back({"I64ToF128", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_ITOF(Vfpu::RoundingMode::kRoundTiesToEven, ff.U64ToF128, u64, f128)
+  PERF_TEST_SF_ITOF(::softfloat_round_near_even, ui64_to_f128, u64)
+  result_vec.push_back({"U64ToF128", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PerfTestF16Tables("Sqrtf16", [](auto& fpu, f16 a) { return std::bit_cast<u16>(fpu.template Sqrt<f16>(a)); });
+  PerfTestF16Tables("F16ToF64", [](auto& fpu, f16 a) { return std::bit_cast<u64>(fpu.F16ToF64(a)); });
+  PerfTestF16Tables("F16ToI32", [](auto& fpu, f16 a) { return fpu.F16ToI32(a); });
+  PerfTestF16Tables("F16ToU64", [](auto& fpu, f16 a) { return fpu.F16ToU64(a); });
+
+  PerfTestMinMaxBatch<f16>("f16");
+  PerfTestMinMaxBatch<f32>("f32");
+  PerfTestMinMaxBatch<f64>("f64");
+
+  PerfTestEstimateBatch<f16>("f16");
+  PerfTestEstimateBatch<f32>("f32");
+  PerfTestEstimateBatch<f64>("f64");
+
+  PerfTestRemainder<f32, float32_t>("f32", ::f32_rem);
+  PerfTestRemainder<f64, float64_t>("f64", ::f64_rem);
+
+  PerfTestAvx512Batch<f16>("f16");
+  PerfTestAvx512Batch<f32>("f32");
+  PerfTestAvx512Batch<f64>("f64");
+
+  PerfTestDotProduct<f32, float32_t>("f32", ::f32_mulAdd);
+  PerfTestDotProduct<f64, float64_t>("f64", ::f64_mulAdd);
+
+  PerfTestComplexBatch<f16>("f16");
+  PerfTestComplexBatch<f32>("f32");
+
+  PerfTestFixedBatch<f32>("f32");
+  PerfTestFixedBatch<f64>("f64");
+
+  PerfTestQuiet<f32>("f32");
+  PerfTestQuiet<f64>("f64");
+  PerfTestFlush<f32>("f32");
+  PerfTestFlush<f64>("f64");
+  PerfTestDenormalCheck<f32>("f32");
+  PerfTestDenormalCheck<f64>("f64");
+
+  PerfTestFp8<e4m3>("e4m3");
+  PerfTestFp8<e5m2>("e5m2");
+
+  PerfTestX87("Extended", X87::kPrecisionExtended, 80);
+  PerfTestX87("Double", X87::kPrecisionDouble, 64);
+  PerfTestX87("Single", X87::kPrecisionSingle, 32);
+
+  PerfTestIeee<tf32>("tf32");
+  PerfTestIeee<Ieee<8, 15>>("e8m15");
+  PerfTestIeee<Ieee<3, 2>>("e3m2");
+  PerfTestIeee<Ieee<2, 3>>("e2m3");
+
+  PerfTestMx<e4m3>("e4m3");
+  PerfTestMx<e5m2>("e5m2");
+  PerfTestMx<e2m1>("e2m1");
+
   // std::reverse(result_vec.begin(), result_vec.end());
   for (auto t : result_vec) {
     std::cout << "(" << std::get<1>(t) << "," << std::get<0>(t) << ")" << std::endl;
@@ -5,14 +5,35 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <bit>
+#include <bitset>
+#include <cfenv>
 #include <cmath>
+#include <cstring>
+#include <fstream>
 #include <functional>
 #include <iostream>
+#include <iterator>
+#include <random>
 #include <type_traits>
+#include <vector>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
 
+#include "avx512.h"
+#include "complex_float.h"
+#include "dot_product.h"
+#include "estimator.h"
 #include "float_rng.h"
+#include "f16_tables.h"
 #include "floppy_float.h"
+#include "fp8.h"
+#include "ieee_float.h"
+#include "mx.h"
+#include "softfloat_ref.h"
+#include "x87.h"
 
 extern "C" {
 #include "softfloat.h"
@@ -33,25 +54,11 @@ std::array<std::pair<uint_fast8_t, SoftFloat::RoundingMode>, 5> rounding_modes{
      {::softfloat_round_min, SoftFloat::RoundingMode::kRoundTowardNegative},
      {::softfloat_round_minMag, SoftFloat::RoundingMode::kRoundTowardZero}}};
 
-template <typename T>
-struct FFloatToSFloat;
-
-template <>
-struct FFloatToSFloat<f16> {
-  using type = float16_t;
-};
-template <>
-struct FFloatToSFloat<f32> {
-  using type = float32_t;
-};
-template <>
-struct FFloatToSFloat<f64> {
-  using type = float64_t;
-};
-
 template <typename T>
 auto ToComparableType(T a) {
-  if constexpr (std::is_floating_point<decltype(a)>::value) {
+  if constexpr (std::is_same_v<decltype(a), f128>) {
+    return ToComparableType(std::bit_cast<float128_t>(a));
+  } else if constexpr (std::is_floating_point<decltype(a)>::value) {
     return std::bit_cast<typename FloatToUint<T>::type>(a);
   } else if constexpr (std::is_same_v<decltype(a), float16_t>) {
     return a.v;
@@ -59,6 +66,8 @@ auto ToComparableType(T a) {
     return a.v;
   } else if constexpr (std::is_same_v<decltype(a), float64_t>) {
     return a.v;
+  } else if constexpr (std::is_same_v<decltype(a), float128_t>) {
+    return std::bitset<128>(a.v[1]) << 64 | std::bitset<128>(a.v[0]);  // Unlike u128, printable by gtest.
   } else {
     return a;
   }
@@ -89,6 +98,7 @@ void DoTest(FFFUNC ff_func, SFFUNC sf_func) {
   ff.SetupToX86();
 #elif defined(ARCH_ARM)
   ff.SetupToArm();
+  ff.nan_propagation_scheme = kArmNanPropagation;
 #endif
 
   ::softfloat_exceptionFlags = 0;
@@ -96,11 +106,11 @@ void DoTest(FFFUNC ff_func, SFFUNC sf_func) {
 
   FloatRng<FT> float_rng(kRngSeed);
   FT valuefa{float_rng.Gen()};
-  typename FFloatToSFloat<FT>::type valuesfa{std::bit_cast<typename FloatToUint<FT>::type>(valuefa)};
+  auto valuesfa = std::bit_cast<typename FFloatToSFloat<FT>::type>(valuefa);
   FT valuefb{float_rng.Gen()};
-  typename FFloatToSFloat<FT>::type valuesfb{std::bit_cast<typename FloatToUint<FT>::type>(valuefb)};
+  auto valuesfb = std::bit_cast<typename FFloatToSFloat<FT>::type>(valuefb);
   FT valuefc{float_rng.Gen()};
-  typename FFloatToSFloat<FT>::type valuesfc{std::bit_cast<typename FloatToUint<FT>::type>(valuefc)};
+  auto valuesfc = std::bit_cast<typename FFloatToSFloat<FT>::type>(valuefc);
 
   for (i32 i = 0; i < kNumIterations; ++i) {
     if constexpr (num_args == 1) {
@@ -133,7 +143,7 @@ void DoTest(FFFUNC ff_func, SFFUNC sf_func) {
     valuesfb = valuesfa;
     valuefb = valuefa;
     valuefa = float_rng.Gen();
-    valuesfa.v = std::bit_cast<typename FloatToUint<FT>::type>(valuefa);
+    valuesfa = std::bit_cast<typename FFloatToSFloat<FT>::type>(valuefa);
   }
 }
 
@@ -197,6 +207,35 @@ void DoTest(FFFUNC ff_func, SFFUNC sf_func) {
     CheckResult(ToComparableType(ff.ff_op((type)4294967294u)), ToComparableType(::sf_op((type)4294967294u)), 18);     \
   }
 
+#define TEST_MACRO_ITOF64(name, ff_op, sf_op, type, rm, rm_name)                                                                \
+  TEST(TEST_SUITE_NAME, name##rm_name) {                                                                                        \
+    ::softfloat_exceptionFlags = 0;                                                                                             \
+    ff.ClearFlags();                                                                                                            \
+    ::softfloat_roundingMode = rounding_modes[rm].first;                                                                        \
+    ff.rounding_mode = rounding_modes[rm].second;                                                                               \
+    CheckResult(ToComparableType(ff.ff_op((type)65503)), ToComparableType(::sf_op((type)65503)), 0);                            \
+    CheckResult(ToComparableType(ff.ff_op((type)65504)), ToComparableType(::sf_op((type)65504)), 1);                            \
+    CheckResult(ToComparableType(ff.ff_op((type)65505)), ToComparableType(::sf_op((type)65505)), 2);                            \
+    CheckResult(ToComparableType(ff.ff_op((type)65519)), ToComparableType(::sf_op((type)65519)), 3);                            \
+    CheckResult(ToComparableType(ff.ff_op((type)65520)), ToComparableType(::sf_op((type)65520)), 4);                            \
+    CheckResult(ToComparableType(ff.ff_op((type)65535)), ToComparableType(::sf_op((type)65535)), 5);                            \
+    CheckResult(ToComparableType(ff.ff_op((type)65536)), ToComparableType(::sf_op((type)65536)), 6);                            \
+    CheckResult(ToComparableType(ff.ff_op((type)-65519)), ToComparableType(::sf_op((type)-65519)), 7);                          \
+    CheckResult(ToComparableType(ff.ff_op((type)-65520)), ToComparableType(::sf_op((type)-65520)), 8);                          \
+    CheckResult(ToComparableType(ff.ff_op((type)0x20000000000001)), ToComparableType(::sf_op((type)0x20000000000001)), 9);      \
+    CheckResult(ToComparableType(ff.ff_op((type)0x20000000000003)), ToComparableType(::sf_op((type)0x20000000000003)), 10);     \
+    CheckResult(ToComparableType(ff.ff_op((type)-0x20000000000001)), ToComparableType(::sf_op((type)-0x20000000000001)), 11);   \
+    CheckResult(ToComparableType(ff.ff_op((type)-0x20000000000003)), ToComparableType(::sf_op((type)-0x20000000000003)), 12);   \
+    CheckResult(ToComparableType(ff.ff_op((type)0x1000000000000081)), ToComparableType(::sf_op((type)0x1000000000000081)), 13); \
+    CheckResult(ToComparableType(ff.ff_op((type)0x1000000000000080)), ToComparableType(::sf_op((type)0x1000000000000080)), 14); \
+    CheckResult(ToComparableType(ff.ff_op((type)0x7fffffffffffffff)), ToComparableType(::sf_op((type)0x7fffffffffffffff)), 15); \
+    CheckResult(ToComparableType(ff.ff_op((type)0x8000000000000000)), ToComparableType(::sf_op((type)0x8000000000000000)), 16); \
+    CheckResult(ToComparableType(ff.ff_op((type)0x8000008000000001)), ToComparableType(::sf_op((type)0x8000008000000001)), 17); \
+    CheckResult(ToComparableType(ff.ff_op((type)0xffffffffffffffff)), ToComparableType(::sf_op((type)0xffffffffffffffff)), 18); \
+    CheckResult(ToComparableType(ff.ff_op((type)0xfffffffffffffc00)), ToComparableType(::sf_op((type)0xfffffffffffffc00)), 19); \
+    CheckResult(ToComparableType(ff.ff_op((type)0xfffffffffffff800)), ToComparableType(::sf_op((type)0xfffffffffffff800)), 20); \
+  }
+
 TEST_MACRO_2(Addf16, &FloppyFloat::Add<f16>, f16_add, f16, 0, RoundTiesToEven)
 TEST_MACRO_2(Addf16, &FloppyFloat::Add<f16>, f16_add, f16, 1, RoundTiesToAway)
 TEST_MACRO_2(Addf16, &FloppyFloat::Add<f16>, f16_add, f16, 2, RoundTowardPositive)
@@ -212,6 +251,11 @@ TEST_MACRO_2(Addf64, &FloppyFloat::Add<f64>, f64_add, f64, 1, RoundTiesToAway)
 TEST_MACRO_2(Addf64, &FloppyFloat::Add<f64>, f64_add, f64, 2, RoundTowardPositive)
 TEST_MACRO_2(Addf64, &FloppyFloat::Add<f64>, f64_add, f64, 3, RoundTowardNegative)
 TEST_MACRO_2(Addf64, &FloppyFloat::Add<f64>, f64_add, f64, 4, RoundTowardZero)
+TEST_MACRO_2(Addf128, &FloppyFloat::Add<f128>, f128_add, f128, 0, RoundTiesToEven)
+TEST_MACRO_2(Addf128, &FloppyFloat::Add<f128>, f128_add, f128, 1, RoundTiesToAway)
+TEST_MACRO_2(Addf128, &FloppyFloat::Add<f128>, f128_add, f128, 2, RoundTowardPositive)
+TEST_MACRO_2(Addf128, &FloppyFloat::Add<f128>, f128_add, f128, 3, RoundTowardNegative)
+TEST_MACRO_2(Addf128, &FloppyFloat::Add<f128>, f128_add, f128, 4, RoundTowardZero)
 
 TEST_MACRO_2(Subf16, &FloppyFloat::Sub<f16>, f16_sub, f16, 0, RoundTiesToEven)
 TEST_MACRO_2(Subf16, &FloppyFloat::Sub<f16>, f16_sub, f16, 1, RoundTiesToAway)
@@ -228,6 +272,11 @@ TEST_MACRO_2(Subf64, &FloppyFloat::Sub<f64>, f64_sub, f64, 1, RoundTiesToAway)
 TEST_MACRO_2(Subf64, &FloppyFloat::Sub<f64>, f64_sub, f64, 2, RoundTowardPositive)
 TEST_MACRO_2(Subf64, &FloppyFloat::Sub<f64>, f64_sub, f64, 3, RoundTowardNegative)
 TEST_MACRO_2(Subf64, &FloppyFloat::Sub<f64>, f64_sub, f64, 4, RoundTowardZero)
+TEST_MACRO_2(Subf128, &FloppyFloat::Sub<f128>, f128_sub, f128, 0, RoundTiesToEven)
+TEST_MACRO_2(Subf128, &FloppyFloat::Sub<f128>, f128_sub, f128, 1, RoundTiesToAway)
+TEST_MACRO_2(Subf128, &FloppyFloat::Sub<f128>, f128_sub, f128, 2, RoundTowardPositive)
+TEST_MACRO_2(Subf128, &FloppyFloat::Sub<f128>, f128_sub, f128, 3, RoundTowardNegative)
+TEST_MACRO_2(Subf128, &FloppyFloat::Sub<f128>, f128_sub, f128, 4, RoundTowardZero)
 
 TEST_MACRO_2(Mulf16, &FloppyFloat::Mul<f16>, f16_mul, f16, 0, RoundTiesToEven)
 TEST_MACRO_2(Mulf16, &FloppyFloat::Mul<f16>, f16_mul, f16, 1, RoundTiesToAway)
@@ -244,6 +293,11 @@ TEST_MACRO_2(Mulf64, &FloppyFloat::Mul<f64>, f64_mul, f64, 1, RoundTiesToAway)
 TEST_MACRO_2(Mulf64, &FloppyFloat::Mul<f64>, f64_mul, f64, 2, RoundTowardPositive)
 TEST_MACRO_2(Mulf64, &FloppyFloat::Mul<f64>, f64_mul, f64, 3, RoundTowardNegative)
 TEST_MACRO_2(Mulf64, &FloppyFloat::Mul<f64>, f64_mul, f64, 4, RoundTowardZero)
+TEST_MACRO_2(Mulf128, &FloppyFloat::Mul<f128>, f128_mul, f128, 0, RoundTiesToEven)
+TEST_MACRO_2(Mulf128, &FloppyFloat::Mul<f128>, f128_mul, f128, 1, RoundTiesToAway)
+TEST_MACRO_2(Mulf128, &FloppyFloat::Mul<f128>, f128_mul, f128, 2, RoundTowardPositive)
+TEST_MACRO_2(Mulf128, &FloppyFloat::Mul<f128>, f128_mul, f128, 3, RoundTowardNegative)
+TEST_MACRO_2(Mulf128, &FloppyFloat::Mul<f128>, f128_mul, f128, 4, RoundTowardZero)
 
 TEST_MACRO_2(Divf16, &FloppyFloat::Div<f16>, f16_div, f16, 0, RoundTiesToEven)
 TEST_MACRO_2(Divf16, &FloppyFloat::Div<f16>, f16_div, f16, 1, RoundTiesToAway)
@@ -260,6 +314,11 @@ TEST_MACRO_2(Divf64, &FloppyFloat::Div<f64>, f64_div, f64, 1, RoundTiesToAway)
 TEST_MACRO_2(Divf64, &FloppyFloat::Div<f64>, f64_div, f64, 2, RoundTowardPositive)
 TEST_MACRO_2(Divf64, &FloppyFloat::Div<f64>, f64_div, f64, 3, RoundTowardNegative)
 TEST_MACRO_2(Divf64, &FloppyFloat::Div<f64>, f64_div, f64, 4, RoundTowardZero)
+TEST_MACRO_2(Divf128, &FloppyFloat::Div<f128>, f128_div, f128, 0, RoundTiesToEven)
+TEST_MACRO_2(Divf128, &FloppyFloat::Div<f128>, f128_div, f128, 1, RoundTiesToAway)
+TEST_MACRO_2(Divf128, &FloppyFloat::Div<f128>, f128_div, f128, 2, RoundTowardPositive)
+TEST_MACRO_2(Divf128, &FloppyFloat::Div<f128>, f128_div, f128, 3, RoundTowardNegative)
+TEST_MACRO_2(Divf128, &FloppyFloat::Div<f128>, f128_div, f128, 4, RoundTowardZero)
 
 TEST_MACRO_1(Sqrtf16, &FloppyFloat::Sqrt<f16>, f16_sqrt, f16, 0, RoundTiesToEven)
 TEST_MACRO_1(Sqrtf16, &FloppyFloat::Sqrt<f16>, f16_sqrt, f16, 1, RoundTiesToAway)
@@ -276,22 +335,32 @@ TEST_MACRO_1(Sqrtf64, &FloppyFloat::Sqrt<f64>, f64_sqrt, f64, 1, RoundTiesToAway
 TEST_MACRO_1(Sqrtf64, &FloppyFloat::Sqrt<f64>, f64_sqrt, f64, 2, RoundTowardPositive)
 TEST_MACRO_1(Sqrtf64, &FloppyFloat::Sqrt<f64>, f64_sqrt, f64, 3, RoundTowardNegative)
 TEST_MACRO_1(Sqrtf64, &FloppyFloat::Sqrt<f64>, f64_sqrt, f64, 4, RoundTowardZero)
+TEST_MACRO_1(Sqrtf128, &FloppyFloat::Sqrt<f128>, f128_sqrt, f128, 0, RoundTiesToEven)
+TEST_MACRO_1(Sqrtf128, &FloppyFloat::Sqrt<f128>, f128_sqrt, f128, 1, RoundTiesToAway)
+TEST_MACRO_1(Sqrtf128, &FloppyFloat::Sqrt<f128>, f128_sqrt, f128, 2, RoundTowardPositive)
+TEST_MACRO_1(Sqrtf128, &FloppyFloat::Sqrt<f128>, f128_sqrt, f128, 3, RoundTowardNegative)
+TEST_MACRO_1(Sqrtf128, &FloppyFloat::Sqrt<f128>, f128_sqrt, f128, 4, RoundTowardZero)
 
-TEST_MACRO_3(Fmaf16, &FloppyFloat::Fma<f16>, f16_mulAdd, f16, 0, RoundTiesToEven)
-TEST_MACRO_3(Fmaf16, &FloppyFloat::Fma<f16>, f16_mulAdd, f16, 1, RoundTiesToAway)
-TEST_MACRO_3(Fmaf16, &FloppyFloat::Fma<f16>, f16_mulAdd, f16, 2, RoundTowardPositive)
-TEST_MACRO_3(Fmaf16, &FloppyFloat::Fma<f16>, f16_mulAdd, f16, 3, RoundTowardNegative)
-TEST_MACRO_3(Fmaf16, &FloppyFloat::Fma<f16>, f16_mulAdd, f16, 4, RoundTowardZero)
-TEST_MACRO_3(Fmaf32, &FloppyFloat::Fma<f32>, f32_mulAdd, f32, 0, RoundTiesToEven)
-TEST_MACRO_3(Fmaf32, &FloppyFloat::Fma<f32>, f32_mulAdd, f32, 1, RoundTiesToAway)
-TEST_MACRO_3(Fmaf32, &FloppyFloat::Fma<f32>, f32_mulAdd, f32, 2, RoundTowardPositive)
-TEST_MACRO_3(Fmaf32, &FloppyFloat::Fma<f32>, f32_mulAdd, f32, 3, RoundTowardNegative)
-TEST_MACRO_3(Fmaf32, &FloppyFloat::Fma<f32>, f32_mulAdd, f32, 4, RoundTowardZero)
-TEST_MACRO_3(Fmaf64, &FloppyFloat::Fma<f64>, f64_mulAdd, f64, 0, RoundTiesToEven)
-TEST_MACRO_3(Fmaf64, &FloppyFloat::Fma<f64>, f64_mulAdd, f64, 1, RoundTiesToAway)
-TEST_MACRO_3(Fmaf64, &FloppyFloat::Fma<f64>, f64_mulAdd, f64, 2, RoundTowardPositive)
-TEST_MACRO_3(Fmaf64, &FloppyFloat::Fma<f64>, f64_mulAdd, f64, 3, RoundTowardNegative)
-TEST_MACRO_3(Fmaf64, &FloppyFloat::Fma<f64>, f64_mulAdd, f64, 4, RoundTowardZero)
+TEST_MACRO_3(Fmaf16, &FloppyFloat::Fma<f16>, f16_mulAddRef, f16, 0, RoundTiesToEven)
+TEST_MACRO_3(Fmaf16, &FloppyFloat::Fma<f16>, f16_mulAddRef, f16, 1, RoundTiesToAway)
+TEST_MACRO_3(Fmaf16, &FloppyFloat::Fma<f16>, f16_mulAddRef, f16, 2, RoundTowardPositive)
+TEST_MACRO_3(Fmaf16, &FloppyFloat::Fma<f16>, f16_mulAddRef, f16, 3, RoundTowardNegative)
+TEST_MACRO_3(Fmaf16, &FloppyFloat::Fma<f16>, f16_mulAddRef, f16, 4, RoundTowardZero)
+TEST_MACRO_3(Fmaf32, &FloppyFloat::Fma<f32>, f32_mulAddRef, f32, 0, RoundTiesToEven)
+TEST_MACRO_3(Fmaf32, &FloppyFloat::Fma<f32>, f32_mulAddRef, f32, 1, RoundTiesToAway)
+TEST_MACRO_3(Fmaf32, &FloppyFloat::Fma<f32>, f32_mulAddRef, f32, 2, RoundTowardPositive)
+TEST_MACRO_3(Fmaf32, &FloppyFloat::Fma<f32>, f32_mulAddRef, f32, 3, RoundTowardNegative)
+TEST_MACRO_3(Fmaf32, &FloppyFloat::Fma<f32>, f32_mulAddRef, f32, 4, RoundTowardZero)
+TEST_MACRO_3(Fmaf64, &FloppyFloat::Fma<f64>, f64_mulAddRef, f64, 0, RoundTiesToEven)
+TEST_MACRO_3(Fmaf64, &FloppyFloat::Fma<f64>, f64_mulAddRef, f64, 1, RoundTiesToAway)
+TEST_MACRO_3(Fmaf64, &FloppyFloat::Fma<f64>, f64_mulAddRef, f64, 2, RoundTowardPositive)
+TEST_MACRO_3(Fmaf64, &FloppyFloat::Fma<f64>, f64_mulAddRef, f64, 3, RoundTowardNegative)
+TEST_MACRO_3(Fmaf64, &FloppyFloat::Fma<f64>, f64_mulAddRef, f64, 4, RoundTowardZero)
+TEST_MACRO_3(Fmaf128, &FloppyFloat::Fma<f128>, f128_mulAddRef, f128, 0, RoundTiesToEven)
+TEST_MACRO_3(Fmaf128, &FloppyFloat::Fma<f128>, f128_mulAddRef, f128, 1, RoundTiesToAway)
+TEST_MACRO_3(Fmaf128, &FloppyFloat::Fma<f128>, f128_mulAddRef, f128, 2, RoundTowardPositive)
+TEST_MACRO_3(Fmaf128, &FloppyFloat::Fma<f128>, f128_mulAddRef, f128, 3, RoundTowardNegative)
+TEST_MACRO_3(Fmaf128, &FloppyFloat::Fma<f128>, f128_mulAddRef, f128, 4, RoundTowardZero)
 
 TEST_MACRO_1(F16ToF32, static_cast<f32 (FloppyFloat::*)(f16)>(&FloppyFloat::F16ToF32), f16_to_f32, f16, 0, )
 TEST_MACRO_1(F16ToF64, static_cast<f64 (FloppyFloat::*)(f16)>(&FloppyFloat::F16ToF64), f16_to_f64, f16, 0, )
@@ -301,16 +370,28 @@ TEST_MACRO_1(F32ToF16, static_cast<f16 (FloppyFloat::*)(f32)>(&FloppyFloat::F32T
 TEST_MACRO_1(F32ToF16, static_cast<f16 (FloppyFloat::*)(f32)>(&FloppyFloat::F32ToF16), f32_to_f16, f32, 3, RoundTowardNegative)
 TEST_MACRO_1(F32ToF16, static_cast<f16 (FloppyFloat::*)(f32)>(&FloppyFloat::F32ToF16), f32_to_f16, f32, 4, RoundTowardZero)
 TEST_MACRO_1(F32ToF64, static_cast<f64 (FloppyFloat::*)(f32)>(&FloppyFloat::F32ToF64), f32_to_f64, f32, 0, )
-TEST_MACRO_1(F64ToF16, static_cast<f16 (SoftFloat::*)(f64)>(&SoftFloat::F64ToF16), f64_to_f16, f64, 0, RoundTiesToEven)
-TEST_MACRO_1(F64ToF16, static_cast<f16 (SoftFloat::*)(f64)>(&SoftFloat::F64ToF16), f64_to_f16, f64, 1, RoundTiesToAway)
-TEST_MACRO_1(F64ToF16, static_cast<f16 (SoftFloat::*)(f64)>(&SoftFloat::F64ToF16), f64_to_f16, f64, 2, RoundTowardPositive)
-TEST_MACRO_1(F64ToF16, static_cast<f16 (SoftFloat::*)(f64)>(&SoftFloat::F64ToF16), f64_to_f16, f64, 3, RoundTowardNegative)
-TEST_MACRO_1(F64ToF16, static_cast<f16 (SoftFloat::*)(f64)>(&SoftFloat::F64ToF16), f64_to_f16, f64, 4, RoundTowardZero)
-TEST_MACRO_1(F64ToF32, static_cast<f32 (SoftFloat::*)(f64)>(&SoftFloat::F64ToF32), f64_to_f32, f64, 0, RoundTiesToEven)
-TEST_MACRO_1(F64ToF32, static_cast<f32 (SoftFloat::*)(f64)>(&SoftFloat::F64ToF32), f64_to_f32, f64, 1, RoundTiesToAway)
-TEST_MACRO_1(F64ToF32, static_cast<f32 (SoftFloat::*)(f64)>(&SoftFloat::F64ToF32), f64_to_f32, f64, 2, RoundTowardPositive)
-TEST_MACRO_1(F64ToF32, static_cast<f32 (SoftFloat::*)(f64)>(&SoftFloat::F64ToF32), f64_to_f32, f64, 3, RoundTowardNegative)
-TEST_MACRO_1(F64ToF32, static_cast<f32 (SoftFloat::*)(f64)>(&SoftFloat::F64ToF32), f64_to_f32, f64, 4, RoundTowardZero)
+TEST_MACRO_1(F64ToF16, static_cast<f16 (FloppyFloat::*)(f64)>(&FloppyFloat::F64ToF16), f64_to_f16, f64, 0, RoundTiesToEven)
+TEST_MACRO_1(F64ToF16, static_cast<f16 (FloppyFloat::*)(f64)>(&FloppyFloat::F64ToF16), f64_to_f16, f64, 1, RoundTiesToAway)
+TEST_MACRO_1(F64ToF16, static_cast<f16 (FloppyFloat::*)(f64)>(&FloppyFloat::F64ToF16), f64_to_f16, f64, 2, RoundTowardPositive)
+TEST_MACRO_1(F64ToF16, static_cast<f16 (FloppyFloat::*)(f64)>(&FloppyFloat::F64ToF16), f64_to_f16, f64, 3, RoundTowardNegative)
+TEST_MACRO_1(F64ToF16, static_cast<f16 (FloppyFloat::*)(f64)>(&FloppyFloat::F64ToF16), f64_to_f16, f64, 4, RoundTowardZero)
+TEST_MACRO_1(F64ToF32, static_cast<f32 (FloppyFloat::*)(f64)>(&FloppyFloat::F64ToF32), f64_to_f32, f64, 0, RoundTiesToEven)
+TEST_MACRO_1(F64ToF32, static_cast<f32 (FloppyFloat::*)(f64)>(&FloppyFloat::F64ToF32), f64_to_f32, f64, 1, RoundTiesToAway)
+TEST_MACRO_1(F64ToF32, static_cast<f32 (FloppyFloat::*)(f64)>(&FloppyFloat::F64ToF32), f64_to_f32, f64, 2, RoundTowardPositive)
+TEST_MACRO_1(F64ToF32, static_cast<f32 (FloppyFloat::*)(f64)>(&FloppyFloat::F64ToF32), f64_to_f32, f64, 3, RoundTowardNegative)
+TEST_MACRO_1(F64ToF32, static_cast<f32 (FloppyFloat::*)(f64)>(&FloppyFloat::F64ToF32), f64_to_f32, f64, 4, RoundTowardZero)
+TEST_MACRO_1(F32ToF128, static_cast<f128 (FloppyFloat::*)(f32)>(&FloppyFloat::F32ToF128), f32_to_f128, f32, 0, )
+TEST_MACRO_1(F64ToF128, static_cast<f128 (FloppyFloat::*)(f64)>(&FloppyFloat::F64ToF128), f64_to_f128, f64, 0, )
+TEST_MACRO_1(F128ToF32, static_cast<f32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToF32), f128_to_f32, f128, 0, RoundTiesToEven)
+TEST_MACRO_1(F128ToF32, static_cast<f32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToF32), f128_to_f32, f128, 1, RoundTiesToAway)
+TEST_MACRO_1(F128ToF32, static_cast<f32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToF32), f128_to_f32, f128, 2, RoundTowardPositive)
+TEST_MACRO_1(F128ToF32, static_cast<f32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToF32), f128_to_f32, f128, 3, RoundTowardNegative)
+TEST_MACRO_1(F128ToF32, static_cast<f32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToF32), f128_to_f32, f128, 4, RoundTowardZero)
+TEST_MACRO_1(F128ToF64, static_cast<f64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToF64), f128_to_f64, f128, 0, RoundTiesToEven)
+TEST_MACRO_1(F128ToF64, static_cast<f64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToF64), f128_to_f64, f128, 1, RoundTiesToAway)
+TEST_MACRO_1(F128ToF64, static_cast<f64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToF64), f128_to_f64, f128, 2, RoundTowardPositive)
+TEST_MACRO_1(F128ToF64, static_cast<f64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToF64), f128_to_f64, f128, 3, RoundTowardNegative)
+TEST_MACRO_1(F128ToF64, static_cast<f64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToF64), f128_to_f64, f128, 4, RoundTowardZero)
 
 TEST_MACRO_FTOI(F16ToI32, static_cast<i32 (FloppyFloat::*)(f16)>(&FloppyFloat::F16ToI32), f16_to_i32, f16, 0, RoundTiesToEven)
 TEST_MACRO_FTOI(F16ToI32, static_cast<i32 (FloppyFloat::*)(f16)>(&FloppyFloat::F16ToI32), f16_to_i32, f16, 1, RoundTiesToAway)
@@ -375,6 +456,27 @@ TEST_MACRO_FTOI(F64ToU64, static_cast<u64 (FloppyFloat::*)(f64)>(&FloppyFloat::F
 TEST_MACRO_FTOI(F64ToU64, static_cast<u64 (FloppyFloat::*)(f64)>(&FloppyFloat::F64ToU64), f64_to_ui64, f64, 3, RoundTowardNegative)
 TEST_MACRO_FTOI(F64ToU64, static_cast<u64 (FloppyFloat::*)(f64)>(&FloppyFloat::F64ToU64), f64_to_ui64, f64, 4, RoundTowardZero)
 
+TEST_MACRO_FTOI(F128ToI32, static_cast<i32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToI32), f128_to_i32, f128, 0, RoundTiesToEven)
+TEST_MACRO_FTOI(F128ToI32, static_cast<i32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToI32), f128_to_i32, f128, 1, RoundTiesToAway)
+TEST_MACRO_FTOI(F128ToI32, static_cast<i32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToI32), f128_to_i32, f128, 2, RoundTowardPositive)
+TEST_MACRO_FTOI(F128ToI32, static_cast<i32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToI32), f128_to_i32, f128, 3, RoundTowardNegative)
+TEST_MACRO_FTOI(F128ToI32, static_cast<i32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToI32), f128_to_i32, f128, 4, RoundTowardZero)
+TEST_MACRO_FTOI(F128ToI64, static_cast<i64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToI64), f128_to_i64, f128, 0, RoundTiesToEven)
+TEST_MACRO_FTOI(F128ToI64, static_cast<i64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToI64), f128_to_i64, f128, 1, RoundTiesToAway)
+TEST_MACRO_FTOI(F128ToI64, static_cast<i64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToI64), f128_to_i64, f128, 2, RoundTowardPositive)
+TEST_MACRO_FTOI(F128ToI64, static_cast<i64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToI64), f128_to_i64, f128, 3, RoundTowardNegative)
+TEST_MACRO_FTOI(F128ToI64, static_cast<i64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToI64), f128_to_i64, f128, 4, RoundTowardZero)
+TEST_MACRO_FTOI(F128ToU32, static_cast<u32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToU32), f128_to_ui32, f128, 0, RoundTiesToEven)
+TEST_MACRO_FTOI(F128ToU32, static_cast<u32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToU32), f128_to_ui32, f128, 1, RoundTiesToAway)
+TEST_MACRO_FTOI(F128ToU32, static_cast<u32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToU32), f128_to_ui32, f128, 2, RoundTowardPositive)
+TEST_MACRO_FTOI(F128ToU32, static_cast<u32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToU32), f128_to_ui32, f128, 3, RoundTowardNegative)
+TEST_MACRO_FTOI(F128ToU32, static_cast<u32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToU32), f128_to_ui32, f128, 4, RoundTowardZero)
+TEST_MACRO_FTOI(F128ToU64, static_cast<u64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToU64), f128_to_ui64, f128, 0, RoundTiesToEven)
+TEST_MACRO_FTOI(F128ToU64, static_cast<u64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToU64), f128_to_ui64, f128, 1, RoundTiesToAway)
+TEST_MACRO_FTOI(F128ToU64, static_cast<u64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToU64), f128_to_ui64, f128, 2, RoundTowardPositive)
+TEST_MACRO_FTOI(F128ToU64, static_cast<u64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToU64), f128_to_ui64, f128, 3, RoundTowardNegative)
+TEST_MACRO_FTOI(F128ToU64, static_cast<u64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToU64), f128_to_ui64, f128, 4, RoundTowardZero)
+
 TEST_MACRO_2(EqQuietf16, &FloppyFloat::EqQuiet<f16>, f16_eq, f16, 0, )
 TEST_MACRO_2(EqQuietf32, &FloppyFloat::EqQuiet<f32>, f32_eq, f32, 0, )
 TEST_MACRO_2(EqQuietf64, &FloppyFloat::EqQuiet<f64>, f64_eq, f64, 0, )
@@ -411,6 +513,11 @@ TEST_MACRO_ITOF(I32ToF64, I32ToF64, i32_to_f64, i32, 1, RoundTiesToAway)
 TEST_MACRO_ITOF(I32ToF64, I32ToF64, i32_to_f64, i32, 2, RoundTowardPositive)
 TEST_MACRO_ITOF(I32ToF64, I32ToF64, i32_to_f64, i32, 3, RoundTowardNegative)
 TEST_MACRO_ITOF(I32ToF64, I32ToF64, i32_to_f64, i32, 4, RoundTowardZero)
+TEST_MACRO_ITOF(I32ToF128, I32ToF128, i32_to_f128, i32, 0, RoundTiesToEven)
+TEST_MACRO_ITOF(I32ToF128, I32ToF128, i32_to_f128, i32, 1, RoundTiesToAway)
+TEST_MACRO_ITOF(I32ToF128, I32ToF128, i32_to_f128, i32, 2, RoundTowardPositive)
+TEST_MACRO_ITOF(I32ToF128, I32ToF128, i32_to_f128, i32, 3, RoundTowardNegative)
+TEST_MACRO_ITOF(I32ToF128, I32ToF128, i32_to_f128, i32, 4, RoundTowardZero)
 
 TEST_MACRO_ITOF(U32ToF16, U32ToF16, ui32_to_f16, u32, 0, RoundTiesToEven)
 TEST_MACRO_ITOF(U32ToF16, U32ToF16, ui32_to_f16, u32, 1, RoundTiesToAway)
@@ -427,6 +534,11 @@ TEST_MACRO_ITOF(U32ToF64, U32ToF64, ui32_to_f64, u32, 1, RoundTiesToAway)
 TEST_MACRO_ITOF(U32ToF64, U32ToF64, ui32_to_f64, u32, 2, RoundTowardPositive)
 TEST_MACRO_ITOF(U32ToF64, U32ToF64, ui32_to_f64, u32, 3, RoundTowardNegative)
 TEST_MACRO_ITOF(U32ToF64, U32ToF64, ui32_to_f64, u32, 4, RoundTowardZero)
+TEST_MACRO_ITOF(U32ToF128, U32ToF128, ui32_to_f128, u32, 0, RoundTiesToEven)
+TEST_MACRO_ITOF(U32ToF128, U32ToF128, ui32_to_f128, u32, 1, RoundTiesToAway)
+TEST_MACRO_ITOF(U32ToF128, U32ToF128, ui32_to_f128, u32, 2, RoundTowardPositive)
+TEST_MACRO_ITOF(U32ToF128, U32ToF128, ui32_to_f128, u32, 3, RoundTowardNegative)
+TEST_MACRO_ITOF(U32ToF128, U32ToF128, ui32_to_f128, u32, 4, RoundTowardZero)
 
 TEST_MACRO_ITOF(I64ToF16, I64ToF16, i64_to_f16, i64, 0, RoundTiesToEven)
 TEST_MACRO_ITOF(I64ToF16, I64ToF16, i64_to_f16, i64, 1, RoundTiesToAway)
@@ -443,6 +555,11 @@ TEST_MACRO_ITOF(I64ToF64, I64ToF64, i64_to_f64, i64, 1, RoundTiesToAway)
 TEST_MACRO_ITOF(I64ToF64, I64ToF64, i64_to_f64, i64, 2, RoundTowardPositive)
 TEST_MACRO_ITOF(I64ToF64, I64ToF64, i64_to_f64, i64, 3, RoundTowardNegative)
 TEST_MACRO_ITOF(I64ToF64, I64ToF64, i64_to_f64, i64, 4, RoundTowardZero)
+TEST_MACRO_ITOF(I64ToF128, I64ToF128, i64_to_f128, i64, 0, RoundTiesToEven)
+TEST_MACRO_ITOF(I64ToF128, I64ToF128, i64_to_f128, i64, 1, RoundTiesToAway)
+TEST_MACRO_ITOF(I64ToF128, I64ToF128, i64_to_f128, i64, 2, RoundTowardPositive)
+TEST_MACRO_ITOF(I64ToF128, I64ToF128, i64_to_f128, i64, 3, RoundTowardNegative)
+TEST_MACRO_ITOF(I64ToF128, I64ToF128, i64_to_f128, i64, 4, RoundTowardZero)
 
 TEST_MACRO_ITOF(U64ToF16, U64ToF16, ui64_to_f16, u64, 0, RoundTiesToEven)
 TEST_MACRO_ITOF(U64ToF16, U64ToF16, ui64_to_f16, u64, 1, RoundTiesToAway)
@@ -459,6 +576,3213 @@ TEST_MACRO_ITOF(U64ToF64, U64ToF64, ui64_to_f64, u64, 1, RoundTiesToAway)
 TEST_MACRO_ITOF(U64ToF64, U64ToF64, ui64_to_f64, u64, 2, RoundTowardPositive)
 TEST_MACRO_ITOF(U64ToF64, U64ToF64, ui64_to_f64, u64, 3, RoundTowardNegative)
 TEST_MACRO_ITOF(U64ToF64, U64ToF64, ui64_to_f64, u64, 4, RoundTowardZero)
+TEST_MACRO_ITOF(U64ToF128, U64ToF128, ui64_to_f128, u64, 0, RoundTiesToEven)
+TEST_MACRO_ITOF(U64ToF128, U64ToF128, ui64_to_f128, u64, 1, RoundTiesToAway)
+TEST_MACRO_ITOF(U64ToF128, U64ToF128, ui64_to_f128, u64, 2, RoundTowardPositive)
+TEST_MACRO_ITOF(U64ToF128, U64ToF128, ui64_to_f128, u64, 3, RoundTowardNegative)
+TEST_MACRO_ITOF(U64ToF128, U64ToF128, ui64_to_f128, u64, 4, RoundTowardZero)
+
+TEST_MACRO_ITOF64(I64ToF16Large, I64ToF16, i64_to_f16, i64, 0, RoundTiesToEven)
+TEST_MACRO_ITOF64(I64ToF16Large, I64ToF16, i64_to_f16, i64, 1, RoundTiesToAway)
+TEST_MACRO_ITOF64(I64ToF16Large, I64ToF16, i64_to_f16, i64, 2, RoundTowardPositive)
+TEST_MACRO_ITOF64(I64ToF16Large, I64ToF16, i64_to_f16, i64, 3, RoundTowardNegative)
+TEST_MACRO_ITOF64(I64ToF16Large, I64ToF16, i64_to_f16, i64, 4, RoundTowardZero)
+TEST_MACRO_ITOF64(I64ToF32Large, I64ToF32, i64_to_f32, i64, 0, RoundTiesToEven)
+TEST_MACRO_ITOF64(I64ToF32Large, I64ToF32, i64_to_f32, i64, 1, RoundTiesToAway)
+TEST_MACRO_ITOF64(I64ToF32Large, I64ToF32, i64_to_f32, i64, 2, RoundTowardPositive)
+TEST_MACRO_ITOF64(I64ToF32Large, I64ToF32, i64_to_f32, i64, 3, RoundTowardNegative)
+TEST_MACRO_ITOF64(I64ToF32Large, I64ToF32, i64_to_f32, i64, 4, RoundTowardZero)
+TEST_MACRO_ITOF64(I64ToF64Large, I64ToF64, i64_to_f64, i64, 0, RoundTiesToEven)
+TEST_MACRO_ITOF64(I64ToF64Large, I64ToF64, i64_to_f64, i64, 1, RoundTiesToAway)
+TEST_MACRO_ITOF64(I64ToF64Large, I64ToF64, i64_to_f64, i64, 2, RoundTowardPositive)
+TEST_MACRO_ITOF64(I64ToF64Large, I64ToF64, i64_to_f64, i64, 3, RoundTowardNegative)
+TEST_MACRO_ITOF64(I64ToF64Large, I64ToF64, i64_to_f64, i64, 4, RoundTowardZero)
+TEST_MACRO_ITOF64(I64ToF128Large, I64ToF128, i64_to_f128, i64, 0, RoundTiesToEven)
+TEST_MACRO_ITOF64(I64ToF128Large, I64ToF128, i64_to_f128, i64, 1, RoundTiesToAway)
+TEST_MACRO_ITOF64(I64ToF128Large, I64ToF128, i64_to_f128, i64, 2, RoundTowardPositive)
+TEST_MACRO_ITOF64(I64ToF128Large, I64ToF128, i64_to_f128, i64, 3, RoundTowardNegative)
+TEST_MACRO_ITOF64(I64ToF128Large, I64ToF128, i64_to_f128, i64, 4, RoundTowardZero)
+TEST_MACRO_ITOF64(U64ToF16Large, U64ToF16, ui64_to_f16, u64, 0, RoundTiesToEven)
+TEST_MACRO_ITOF64(U64ToF16Large, U64ToF16, ui64_to_f16, u64, 1, RoundTiesToAway)
+TEST_MACRO_ITOF64(U64ToF16Large, U64ToF16, ui64_to_f16, u64, 2, RoundTowardPositive)
+TEST_MACRO_ITOF64(U64ToF16Large, U64ToF16, ui64_to_f16, u64, 3, RoundTowardNegative)
+TEST_MACRO_ITOF64(U64ToF16Large, U64ToF16, ui64_to_f16, u64, 4, RoundTowardZero)
+TEST_MACRO_ITOF64(U64ToF32Large, U64ToF32, ui64_to_f32, u64, 0, RoundTiesToEven)
+TEST_MACRO_ITOF64(U64ToF32Large, U64ToF32, ui64_to_f32, u64, 1, RoundTiesToAway)
+TEST_MACRO_ITOF64(U64ToF32Large, U64ToF32, ui64_to_f32, u64, 2, RoundTowardPositive)
+TEST_MACRO_ITOF64(U64ToF32Large, U64ToF32, ui64_to_f32, u64, 3, RoundTowardNegative)
+TEST_MACRO_ITOF64(U64ToF32Large, U64ToF32, ui64_to_f32, u64, 4, RoundTowardZero)
+TEST_MACRO_ITOF64(U64ToF64Large, U64ToF64, ui64_to_f64, u64, 0, RoundTiesToEven)
+TEST_MACRO_ITOF64(U64ToF64Large, U64ToF64, ui64_to_f64, u64, 1, RoundTiesToAway)
+TEST_MACRO_ITOF64(U64ToF64Large, U64ToF64, ui64_to_f64, u64, 2, RoundTowardPositive)
+TEST_MACRO_ITOF64(U64ToF64Large, U64ToF64, ui64_to_f64, u64, 3, RoundTowardNegative)
+TEST_MACRO_ITOF64(U64ToF64Large, U64ToF64, ui64_to_f64, u64, 4, RoundTowardZero)
+TEST_MACRO_ITOF64(U64ToF128Large, U64ToF128, ui64_to_f128, u64, 0, RoundTiesToEven)
+TEST_MACRO_ITOF64(U64ToF128Large, U64ToF128, ui64_to_f128, u64, 1, RoundTiesToAway)
+TEST_MACRO_ITOF64(U64ToF128Large, U64ToF128, ui64_to_f128, u64, 2, RoundTowardPositive)
+TEST_MACRO_ITOF64(U64ToF128Large, U64ToF128, ui64_to_f128, u64, 3, RoundTowardNegative)
+TEST_MACRO_ITOF64(U64ToF128Large, U64ToF128, ui64_to_f128, u64, 4, RoundTowardZero)
+
+TEST_MACRO_FTOI(RoundToIntegralExactf16, &FloppyFloat::RoundToIntegralExact<f16>, f16_roundToInt, f16, 0, RoundTiesToEven)
+TEST_MACRO_FTOI(RoundToIntegralExactf16, &FloppyFloat::RoundToIntegralExact<f16>, f16_roundToInt, f16, 1, RoundTiesToAway)
+TEST_MACRO_FTOI(RoundToIntegralExactf16, &FloppyFloat::RoundToIntegralExact<f16>, f16_roundToInt, f16, 2, RoundTowardPositive)
+TEST_MACRO_FTOI(RoundToIntegralExactf16, &FloppyFloat::RoundToIntegralExact<f16>, f16_roundToInt, f16, 3, RoundTowardNegative)
+TEST_MACRO_FTOI(RoundToIntegralExactf16, &FloppyFloat::RoundToIntegralExact<f16>, f16_roundToInt, f16, 4, RoundTowardZero)
+TEST_MACRO_FTOI(RoundToIntegralExactf32, &FloppyFloat::RoundToIntegralExact<f32>, f32_roundToInt, f32, 0, RoundTiesToEven)
+TEST_MACRO_FTOI(RoundToIntegralExactf32, &FloppyFloat::RoundToIntegralExact<f32>, f32_roundToInt, f32, 1, RoundTiesToAway)
+TEST_MACRO_FTOI(RoundToIntegralExactf32, &FloppyFloat::RoundToIntegralExact<f32>, f32_roundToInt, f32, 2, RoundTowardPositive)
+TEST_MACRO_FTOI(RoundToIntegralExactf32, &FloppyFloat::RoundToIntegralExact<f32>, f32_roundToInt, f32, 3, RoundTowardNegative)
+TEST_MACRO_FTOI(RoundToIntegralExactf32, &FloppyFloat::RoundToIntegralExact<f32>, f32_roundToInt, f32, 4, RoundTowardZero)
+TEST_MACRO_FTOI(RoundToIntegralExactf64, &FloppyFloat::RoundToIntegralExact<f64>, f64_roundToInt, f64, 0, RoundTiesToEven)
+TEST_MACRO_FTOI(RoundToIntegralExactf64, &FloppyFloat::RoundToIntegralExact<f64>, f64_roundToInt, f64, 1, RoundTiesToAway)
+TEST_MACRO_FTOI(RoundToIntegralExactf64, &FloppyFloat::RoundToIntegralExact<f64>, f64_roundToInt, f64, 2, RoundTowardPositive)
+TEST_MACRO_FTOI(RoundToIntegralExactf64, &FloppyFloat::RoundToIntegralExact<f64>, f64_roundToInt, f64, 3, RoundTowardNegative)
+TEST_MACRO_FTOI(RoundToIntegralExactf64, &FloppyFloat::RoundToIntegralExact<f64>, f64_roundToInt, f64, 4, RoundTowardZero)
+
+// Berkeley SoftFloat has no bfloat16, so the bf16 paths of FloppyFloat are checked against SoftFloat.
+SoftFloat sf;
+
+template <typename FT, typename FFFUNC, typename SFFUNC>
+void DoTestSoftFloat(FFFUNC ff_func, SFFUNC sf_func) {
+#if defined(ARCH_RISCV)
+  ff.SetupToRiscv();
+  sf.SetupToRiscv();
+#elif defined(ARCH_X86)
+  ff.SetupToX86();
+  sf.SetupToX86();
+#elif defined(ARCH_ARM)
+  ff.SetupToArm();
+  ff.nan_propagation_scheme = kArmNanPropagation;
+  sf.SetupToArm();
+  sf.nan_propagation_scheme = kArmNanPropagation;
+#endif
+
+  FloatRng<FT> float_rng(kRngSeed);
+  FT valuea{float_rng.Gen()};
+  FT valueb{float_rng.Gen()};
+  FT valuec{float_rng.Gen()};
+
+  for (i32 i = 0; i < kNumIterations; ++i) {
+    ff.ClearFlags();
+    sf.ClearFlags();
+    auto ff_result_u = ToComparableType(ff_func(valuea, valueb, valuec));  // Surplus arguments are discarded.
+    auto sf_result_u = ToComparableType(sf_func(valuea, valueb, valuec));
+    ASSERT_EQ(ff_result_u, sf_result_u) << "Iteration: " << i;
+    ASSERT_EQ(ff.invalid, sf.invalid) << "Iteration: " << i;
+    ASSERT_EQ(ff.division_by_zero, sf.division_by_zero) << "Iteration: " << i;
+    ASSERT_EQ(ff.overflow, sf.overflow) << "Iteration: " << i;
+    ASSERT_EQ(ff.underflow, sf.underflow) << "Iteration: " << i;
+    ASSERT_EQ(ff.inexact, sf.inexact) << "Iteration: " << i;
+
+    valuec = valueb;
+    valueb = valuea;
+    valuea = float_rng.Gen();
+  }
+}
+
+#define TEST_MACRO_SF_BASE(name, ff_op, sf_op, type, rm, rm_name, ...) \
+  TEST(TEST_SUITE_NAME, name##rm_name) {                                \
+    ff.rounding_mode = rounding_modes[rm].second;                       \
+    sf.rounding_mode = rounding_modes[rm].second;                       \
+    auto ff_func = std::bind(ff_op, &ff, __VA_ARGS__);                  \
+    auto sf_func = std::bind(sf_op, &sf, __VA_ARGS__);                  \
+    DoTestSoftFloat<type>(ff_func, sf_func);                            \
+  }
+
+#define TEST_MACRO_SF_1(name, ff_op, sf_op, type, rm, rm_name) TEST_MACRO_SF_BASE(name, ff_op, sf_op, type, rm, rm_name, _1)
+#define TEST_MACRO_SF_2(name, ff_op, sf_op, type, rm, rm_name) TEST_MACRO_SF_BASE(name, ff_op, sf_op, type, rm, rm_name, _1, _2)
+#define TEST_MACRO_SF_3(name, ff_op, sf_op, type, rm, rm_name) TEST_MACRO_SF_BASE(name, ff_op, sf_op, type, rm, rm_name, _1, _2, _3)
+
+TEST_MACRO_SF_2(Addbf16, &FloppyFloat::Add<bf16>, &SoftFloat::Add<bf16>, bf16, 0, RoundTiesToEven)
+TEST_MACRO_SF_2(Addbf16, &FloppyFloat::Add<bf16>, &SoftFloat::Add<bf16>, bf16, 1, RoundTiesToAway)
+TEST_MACRO_SF_2(Addbf16, &FloppyFloat::Add<bf16>, &SoftFloat::Add<bf16>, bf16, 2, RoundTowardPositive)
+TEST_MACRO_SF_2(Addbf16, &FloppyFloat::Add<bf16>, &SoftFloat::Add<bf16>, bf16, 3, RoundTowardNegative)
+TEST_MACRO_SF_2(Addbf16, &FloppyFloat::Add<bf16>, &SoftFloat::Add<bf16>, bf16, 4, RoundTowardZero)
+
+TEST_MACRO_SF_2(Subbf16, &FloppyFloat::Sub<bf16>, &SoftFloat::Sub<bf16>, bf16, 0, RoundTiesToEven)
+TEST_MACRO_SF_2(Subbf16, &FloppyFloat::Sub<bf16>, &SoftFloat::Sub<bf16>, bf16, 1, RoundTiesToAway)
+TEST_MACRO_SF_2(Subbf16, &FloppyFloat::Sub<bf16>, &SoftFloat::Sub<bf16>, bf16, 2, RoundTowardPositive)
+TEST_MACRO_SF_2(Subbf16, &FloppyFloat::Sub<bf16>, &SoftFloat::Sub<bf16>, bf16, 3, RoundTowardNegative)
+TEST_MACRO_SF_2(Subbf16, &FloppyFloat::Sub<bf16>, &SoftFloat::Sub<bf16>, bf16, 4, RoundTowardZero)
+
+TEST_MACRO_SF_2(Mulbf16, &FloppyFloat::Mul<bf16>, &SoftFloat::Mul<bf16>, bf16, 0, RoundTiesToEven)
+TEST_MACRO_SF_2(Mulbf16, &FloppyFloat::Mul<bf16>, &SoftFloat::Mul<bf16>, bf16, 1, RoundTiesToAway)
+TEST_MACRO_SF_2(Mulbf16, &FloppyFloat::Mul<bf16>, &SoftFloat::Mul<bf16>, bf16, 2, RoundTowardPositive)
+TEST_MACRO_SF_2(Mulbf16, &FloppyFloat::Mul<bf16>, &SoftFloat::Mul<bf16>, bf16, 3, RoundTowardNegative)
+TEST_MACRO_SF_2(Mulbf16, &FloppyFloat::Mul<bf16>, &SoftFloat::Mul<bf16>, bf16, 4, RoundTowardZero)
+
+TEST_MACRO_SF_2(Divbf16, &FloppyFloat::Div<bf16>, &SoftFloat::Div<bf16>, bf16, 0, RoundTiesToEven)
+TEST_MACRO_SF_2(Divbf16, &FloppyFloat::Div<bf16>, &SoftFloat::Div<bf16>, bf16, 1, RoundTiesToAway)
+TEST_MACRO_SF_2(Divbf16, &FloppyFloat::Div<bf16>, &SoftFloat::Div<bf16>, bf16, 2, RoundTowardPositive)
+TEST_MACRO_SF_2(Divbf16, &FloppyFloat::Div<bf16>, &SoftFloat::Div<bf16>, bf16, 3, RoundTowardNegative)
+TEST_MACRO_SF_2(Divbf16, &FloppyFloat::Div<bf16>, &SoftFloat::Div<bf16>, bf16, 4, RoundTowardZero)
+
+TEST_MACRO_SF_1(Sqrtbf16, &FloppyFloat::Sqrt<bf16>, &SoftFloat::Sqrt<bf16>, bf16, 0, RoundTiesToEven)
+TEST_MACRO_SF_1(Sqrtbf16, &FloppyFloat::Sqrt<bf16>, &SoftFloat::Sqrt<bf16>, bf16, 1, RoundTiesToAway)
+TEST_MACRO_SF_1(Sqrtbf16, &FloppyFloat::Sqrt<bf16>, &SoftFloat::Sqrt<bf16>, bf16, 2, RoundTowardPositive)
+TEST_MACRO_SF_1(Sqrtbf16, &FloppyFloat::Sqrt<bf16>, &SoftFloat::Sqrt<bf16>, bf16, 3, RoundTowardNegative)
+TEST_MACRO_SF_1(Sqrtbf16, &FloppyFloat::Sqrt<bf16>, &SoftFloat::Sqrt<bf16>, bf16, 4, RoundTowardZero)
+
+TEST_MACRO_SF_3(Fmabf16, &FloppyFloat::Fma<bf16>, &SoftFloat::Fma<bf16>, bf16, 0, RoundTiesToEven)
+TEST_MACRO_SF_3(Fmabf16, &FloppyFloat::Fma<bf16>, &SoftFloat::Fma<bf16>, bf16, 1, RoundTiesToAway)
+TEST_MACRO_SF_3(Fmabf16, &FloppyFloat::Fma<bf16>, &SoftFloat::Fma<bf16>, bf16, 2, RoundTowardPositive)
+TEST_MACRO_SF_3(Fmabf16, &FloppyFloat::Fma<bf16>, &SoftFloat::Fma<bf16>, bf16, 3, RoundTowardNegative)
+TEST_MACRO_SF_3(Fmabf16, &FloppyFloat::Fma<bf16>, &SoftFloat::Fma<bf16>, bf16, 4, RoundTowardZero)
+
+TEST(TEST_SUITE_NAME, F32ToBF16) {
+  for (auto [sf_rm, rm] : rounding_modes) {
+    ff.rounding_mode = rm;
+    sf.rounding_mode = rm;
+    DoTestSoftFloat<f32>([](f32 a, f32, f32) { return ff.F32ToBF16(a); },
+                         [](f32 a, f32, f32) { return sf.F32ToBF16(a); });
+  }
+}
+
+TEST(TEST_SUITE_NAME, DotBf16x86) {
+  auto bf = [](u16 u) { return std::bit_cast<bf16>(u); };
+  ff.ClearFlags();
+
+  f32 acc[3] = {1.f32, 0.f32, 1.f32};
+  const bf16 a[6] = {bf(0x3f80), bf(0x4000), bf(0x0d80), bf(0x0000), bf(0x3f80), bf(0x0001)};  // 1, 2, 2^-100, 0, ...
+  const bf16 b[6] = {bf(0x4040), bf(0x4080), bf(0x3080), bf(0x0000), bf(0x3080), bf(0x7f00)};  // 3, 4, 2^-30, 0, ...
+  ff.DotBf16x86(acc, a, b, 3);
+  ASSERT_EQ(std::bit_cast<u32>(acc[0]), 0x41400000u);  // 1 + 2 * 4 + 1 * 3 = 12
+  ASSERT_EQ(std::bit_cast<u32>(acc[1]), 0x00000000u);  // 2^-130 is flushed to zero.
+  ASSERT_EQ(std::bit_cast<u32>(acc[2]), 0x3f800000u);  // Rounds to nearest even; the denormal input is zero.
+  ASSERT_FALSE(ff.inexact || ff.underflow);
+
+  // Golden vectors recorded from vdpbf16ps on an AVX512-BF16 host: {acc, a[0], a[1], b[0], b[1], result}.
+  constexpr std::array<std::array<u32, 6>, 12> kGolden{{
+      {0x3f800000u, 0x3f80u, 0x3f80u, 0x3380u, 0x3380u, 0x3f800000u},  // Two ties to even, one step at a time.
+      {0x3f800001u, 0x3f80u, 0x3f80u, 0x3300u, 0x3300u, 0x3f800001u},  // Not fused: Each 2^-25 rounds away.
+      {0x7f7fffffu, 0x7f7fu, 0x7f7fu, 0x4000u, 0x3f80u, 0x7f800000u},  // Overflow.
+      {0x80000000u, 0x8000u, 0x0000u, 0x0000u, 0x8000u, 0x80000000u},  // -0 + -0 + -0.
+      {0x3f800000u, 0x7f81u, 0x3f80u, 0x3f80u, 0x3f80u, 0x7fc10000u},  // sNaN is quieted.
+      {0x7fc00001u, 0x3f80u, 0x3f80u, 0xb380u, 0x3380u, 0x7fc00001u},  // The accumulator's NaN payload is kept.
+      {0x3f800000u, 0x3f81u, 0x3f81u, 0x3f81u, 0xbf81u, 0x3f800000u},  // Exact cancellation.
+      {0x00800000u, 0x8080u, 0x0000u, 0x3f00u, 0x0000u, 0x00000000u},  // 2^-127 is flushed to zero.
+      {0xff800000u, 0x7f80u, 0x3f80u, 0x3f80u, 0x3f80u, 0xffc00000u},  // -inf + inf is the default NaN.
+      {0x3f800000u, 0x3f80u, 0x7f80u, 0x0000u, 0x3f80u, 0x7f800000u},  // The even product 1 * 0 is fine.
+      {0x80800000u, 0x0080u, 0x3f80u, 0xbf00u, 0x0000u, 0x80c00000u},  // A subnormal product is not flushed.
+      {0x42280000u, 0x40a0u, 0xc0c0u, 0x40e0u, 0x4100u, 0x41e80000u},  // 42 - 6 * 8 + 5 * 7 = 29
+  }};
+  for (const auto& g : kGolden) {
+    f32 golden_acc = std::bit_cast<f32>(g[0]);
+    const bf16 golden_a[2] = {bf(static_cast<u16>(g[1])), bf(static_cast<u16>(g[2]))};
+    const bf16 golden_b[2] = {bf(static_cast<u16>(g[3])), bf(static_cast<u16>(g[4]))};
+    ff.DotBf16x86(&golden_acc, golden_a, golden_b, 1);
+    ASSERT_EQ(std::bit_cast<u32>(golden_acc), g[5]);
+  }
+  ASSERT_FALSE(ff.invalid || ff.overflow || ff.inexact || ff.underflow);
+}
+
+TEST(TEST_SUITE_NAME, DotBf16Arm) {
+  auto bf = [](u16 u) { return std::bit_cast<bf16>(u); };
+  ff.ClearFlags();
+
+  f32 acc[3] = {1.f32, 0.f32, 1.f32};
+  const bf16 a[6] = {bf(0x3f80), bf(0x0000), bf(0x0d80), bf(0x0000), bf(0x7f81), bf(0x3f80)};  // 1, 0, 2^-100, 0, sNaN, 1
+  const bf16 b[6] = {bf(0x3080), bf(0x0000), bf(0x3080), bf(0x0000), bf(0x3f80), bf(0x3f80)};  // 2^-30, 0, 2^-30, 0, 1, 1
+  ff.DotBf16Arm(acc, a, b, 3);
+  ASSERT_EQ(std::bit_cast<u32>(acc[0]), 0x3f800001u);  // 1 + 2^-30 rounds to odd.
+  ASSERT_EQ(std::bit_cast<u32>(acc[1]), 0x00000000u);  // 2^-130 is flushed to zero.
+  ASSERT_EQ(std::bit_cast<u32>(acc[2]), 0x7fc00000u);  // Default NaN.
+  ASSERT_FALSE(ff.invalid || ff.inexact || ff.underflow);
+}
+
+TEST(TEST_SUITE_NAME, WmaccBf16Riscv) {
+  auto bf = [](u16 u) { return std::bit_cast<bf16>(u); };
+  ff.SetupToRiscv();
+
+  const bf16 a[2] = {bf(0x3f80), bf(0x3f80)};  // 1, 1
+  const bf16 b[2] = {bf(0x3080), bf(0x3080)};  // 2^-30, 2^-30
+  f32 acc[2] = {1.f32, 1.f32};
+  ff.ClearFlags();
+  ff.WmaccBf16Riscv<SoftFloat::kRoundTiesToEven>(acc, a, b, 2);
+  ASSERT_EQ(std::bit_cast<u32>(acc[0]), 0x3f800000u);
+  ASSERT_TRUE(ff.inexact);
+  ff.WmaccBf16Riscv<SoftFloat::kRoundTowardPositive>(acc, a, b, 2);
+  ASSERT_EQ(std::bit_cast<u32>(acc[1]), 0x3f800001u);
+}
+
+TEST(TEST_SUITE_NAME, Fp8F16ToE5M2) {
+  // E5M2 is f16 with the lower 8 bits cut off, which gives a simple reference for all finite non-overflowing values.
+  Fp8 fp8;
+  for (u32 i = 0; i < 0x10000; ++i) {
+    const u16 u = static_cast<u16>(i);
+    if ((u & 0x7fff) > 0x7b7f)
+      continue;
+    const f16 a = std::bit_cast<f16>(u);
+    ASSERT_EQ((fp8.F16ToF8<e5m2, Vfpu::kRoundTowardZero>(a).v), u >> 8);
+    ASSERT_EQ((fp8.F16ToF8<e5m2, Vfpu::kRoundTiesToEven>(a).v), (u + 0x7f + ((u >> 8) & 1)) >> 8);
+    ASSERT_EQ(std::bit_cast<u16>(fp8.F8ToF16(e5m2{static_cast<u8>(u >> 8)})), u & 0xff00);
+  }
+}
+
+// Sums and products of E4M3 numbers as well as products of E5M2 numbers are exact in f32, so rounding the f32 result
+// once must give the same result and flags as the FP8 operation.
+template <typename FT8>
+void DoTestFp8Exact(Fp8::Operation op, std::function<f32(f32, f32)> f32_op) {
+  for (auto [sf_rm, rm] : rounding_modes) {
+    for (bool saturate : {false, true}) {
+      Fp8 fp8, ref;
+      fp8.rounding_mode = ref.rounding_mode = ff.rounding_mode = rm;
+      fp8.saturate = ref.saturate = saturate;
+      for (u32 i = 0; i < 0x10000; ++i) {
+        const FT8 a{static_cast<u8>(i >> 8)}, b{static_cast<u8>(i)};
+        fp8.ClearFlags();
+        ref.ClearFlags();
+        ff.ClearFlags();
+        FT8 result;
+        if (op == Fp8::kAdd)
+          result = fp8.Add(a, b);
+        else if (op == Fp8::kSub)
+          result = fp8.Sub(a, b);
+        else
+          result = fp8.Mul(a, b);
+        const FT8 expected = ref.F32ToF8<FT8>(f32_op(ref.F8ToF32(a), ref.F8ToF32(b)));
+        ASSERT_EQ(result.v, expected.v) << std::hex << i;
+        ASSERT_EQ(fp8.invalid, ref.invalid || ff.invalid) << std::hex << i;
+        ASSERT_EQ(fp8.overflow, ref.overflow) << std::hex << i;
+        ASSERT_EQ(fp8.underflow, ref.underflow) << std::hex << i;
+        ASSERT_EQ(fp8.inexact, ref.inexact) << std::hex << i;
+      }
+    }
+  }
+}
+
+TEST(TEST_SUITE_NAME, Fp8Arithmetic) {
+  ff.SetupToRiscv();
+  DoTestFp8Exact<e4m3>(Fp8::kAdd, [](f32 a, f32 b) { return ff.Add(a, b); });
+  DoTestFp8Exact<e4m3>(Fp8::kSub, [](f32 a, f32 b) { return ff.Sub(a, b); });
+  DoTestFp8Exact<e4m3>(Fp8::kMul, [](f32 a, f32 b) { return ff.Mul(a, b); });
+  DoTestFp8Exact<e5m2>(Fp8::kMul, [](f32 a, f32 b) { return ff.Mul(a, b); });
+}
+
+TEST(TEST_SUITE_NAME, Fp8SpecialCases) {
+  Fp8 fp8;
+  ASSERT_EQ(fp8.F32ToF8<e4m3>(448.f32).v, 0x7e);
+  ASSERT_EQ(fp8.F32ToF8<e4m3>(464.f32).v, 0x7e);  // Ties to even.
+  ASSERT_TRUE(fp8.inexact && !fp8.overflow);
+  ASSERT_EQ(fp8.F32ToF8<e4m3>(-465.f32).v, 0x7f);  // E4M3 overflows to NaN...
+  ASSERT_TRUE(fp8.overflow);
+  ASSERT_EQ((fp8.F32ToF8<e4m3, Vfpu::kRoundTowardZero>(-1000.f32).v), 0xfe);  // ...unless rounding toward zero.
+  ASSERT_EQ(fp8.F32ToF8<e5m2>(std::numeric_limits<f32>::infinity()).v, 0x7c);
+  ASSERT_EQ(fp8.F32ToF8<e4m3>(std::bit_cast<f32>(0x3b000000u)).v, 0x01);  // 2^-9
+  ASSERT_EQ(fp8.F32ToF8<e4m3>(std::bit_cast<f32>(0x3a000000u)).v, 0x00);  // 2^-11 rounds to zero.
+
+  fp8.saturate = true;
+  ASSERT_EQ(fp8.F32ToF8<e4m3>(-465.f32).v, 0xfe);
+  ASSERT_EQ(fp8.F32ToF8<e5m2>(-std::numeric_limits<f32>::infinity()).v, 0xfb);
+  ASSERT_EQ(fp8.Mul(e5m2{0x7b}, e5m2{0x7b}).v, 0x7b);
+  fp8.saturate = false;
+
+  fp8.ClearFlags();
+  ASSERT_EQ(fp8.Div(e5m2{0xbc}, e5m2{0x00}).v, 0xfc);  // -1 / 0 = -inf
+  ASSERT_TRUE(fp8.division_by_zero && !fp8.invalid);
+  ASSERT_EQ(fp8.Div(e4m3{0x00}, e4m3{0x00}).v, 0x7f);
+  ASSERT_TRUE(fp8.invalid);
+
+  fp8.ClearFlags();
+  ASSERT_EQ(fp8.MaximumNumber(e4m3{0x7f}, e4m3{0x38}).v, 0x38);
+  ASSERT_EQ(fp8.MaximumNumber(e4m3{0x80}, e4m3{0x00}).v, 0x00);
+  ASSERT_EQ(fp8.MinimumNumber(e4m3{0x00}, e4m3{0x80}).v, 0x80);
+  ASSERT_FALSE(fp8.LtQuiet(e4m3{0x7f}, e4m3{0x38}));
+  ASSERT_FALSE(fp8.invalid);
+  ASSERT_FALSE(fp8.LtSignaling(e4m3{0x7f}, e4m3{0x38}));
+  ASSERT_TRUE(fp8.invalid);
+  fp8.ClearFlags();
+  ASSERT_TRUE(fp8.EqQuiet(e5m2{0x80}, e5m2{0x00}));
+  ASSERT_FALSE(fp8.EqQuiet(e5m2{0x7d}, e5m2{0x7d}));  // Signaling NaN.
+  ASSERT_TRUE(fp8.invalid);
+
+  fp8.ClearFlags();
+  ASSERT_EQ(std::bit_cast<u32>(fp8.F8ToF32(e4m3{0xfe})), std::bit_cast<u32>(-448.f32));
+  ASSERT_EQ(std::bit_cast<u16>(fp8.F8ToBF16(e4m3{0x01})), 0x3b00);  // 2^-9
+  ASSERT_FALSE(fp8.invalid);
+  ASSERT_EQ(std::bit_cast<u32>(fp8.F8ToF32(e5m2{0x7d})), 0x7fe00000u);
+  ASSERT_TRUE(fp8.invalid);
+}
+
+template <typename FT8>
+void DoTestFp8Batch() {
+  std::mt19937 rng(kRngSeed);
+  for (auto [sf_rm, rm] : rounding_modes) {
+    for (i32 op = Fp8::kAdd; op < Fp8::kF16ToF8; ++op) {
+      constexpr std::size_t kSize = 1001;
+      std::array<FT8, kSize> a, b;
+      std::array<u8, kSize> result;
+      for (std::size_t i = 0; i < kSize; ++i) {
+        a[i].v = static_cast<u8>(rng());
+        b[i].v = static_cast<u8>(rng());
+      }
+      a[0].v = b[0].v = 0xff;  // The last table entry. The AVX2 kernel gathers it together with the padding.
+      Fp8 batch, scalar;
+      batch.rounding_mode = scalar.rounding_mode = rm;
+      batch.Batch<FT8>(static_cast<Fp8::Operation>(op), result.data(), a.data(), b.data(), kSize);
+      const u16* table = scalar.Table<FT8>(static_cast<Fp8::Operation>(op));
+      u32 flags = 0;
+      for (std::size_t i = 0; i < kSize; ++i) {
+        const u16 entry = table[(a[i].v << 8) | b[i].v];
+        ASSERT_EQ(result[i], entry & 0xff);
+        flags |= entry >> 8;
+      }
+      ASSERT_EQ(batch.invalid, static_cast<bool>(flags & 1));
+      ASSERT_EQ(batch.division_by_zero, static_cast<bool>(flags & 2));
+      ASSERT_EQ(batch.overflow, static_cast<bool>(flags & 4));
+      ASSERT_EQ(batch.underflow, static_cast<bool>(flags & 8));
+      ASSERT_EQ(batch.inexact, static_cast<bool>(flags & 16));
+    }
+  }
+
+  std::array<FT8, 259> a;
+  std::array<f32, 259> result;
+  for (std::size_t i = 0; i < a.size(); ++i)
+    a[i].v = static_cast<u8>(i);
+  Fp8 batch, scalar;
+  batch.F8ToF32(result.data(), a.data(), a.size());
+  for (std::size_t i = 0; i < a.size(); ++i)
+    ASSERT_EQ(std::bit_cast<u32>(result[i]), std::bit_cast<u32>(scalar.F8ToF32(a[i])));
+  ASSERT_EQ(batch.invalid, scalar.invalid);
+}
+
+TEST(TEST_SUITE_NAME, Fp8Batch) {
+  DoTestFp8Batch<e4m3>();
+  DoTestFp8Batch<e5m2>();
+}
+
+TEST(TEST_SUITE_NAME, Fp8Image) {
+  const std::string path = testing::TempDir() + "fp8_table.bin";
+  Fp8 fp8;
+  fp8.saturate = true;
+  ASSERT_TRUE(fp8.SaveImage<e5m2>(Fp8::kMul, Fp8::kRoundTowardZero, path));
+  std::ifstream file(path, std::ios::binary);
+  std::vector<char> image((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  ASSERT_EQ(image.size(), 16 + (0x10000 + 1) * sizeof(u16));  // Header, entries, and padding.
+  ASSERT_EQ(std::memcmp(image.data() + 16, fp8.Table<e5m2>(Fp8::kMul, Fp8::kRoundTowardZero), 0x10000 * sizeof(u16)),
+            0);
+  EXPECT_FALSE(fp8.MapImage<e5m2>(Fp8::kMul, Fp8::kRoundTowardZero, path));  // The generated table is in use.
+  EXPECT_FALSE(fp8.MapImage<e5m2>(Fp8::kMul, Fp8::kRoundTowardPositive, path));  // Another configuration.
+  EXPECT_FALSE(fp8.MapImage<e4m3>(Fp8::kMul, Fp8::kRoundTowardZero, path));  // Another format.
+  std::remove(path.c_str());
+}
+
+template <typename FT>
+MxBlock<FT> GenMxBlock(std::mt19937& rng, u8 element_mask) {
+  MxBlock<FT> block;
+  block.scale.v = static_cast<u8>(127 + static_cast<i32>(rng() % 81) - 40);
+  for (auto& element : block.elements)
+    element.v = static_cast<u8>(rng()) & element_mask;
+  return block;
+}
+
+TEST(TEST_SUITE_NAME, MxQuantize) {
+  Mx mx;
+  std::array<f32, 32> src{};
+  MxBlock<e4m3> fp8;
+  src[0] = 1.f32;
+  src[1] = -0.75f32;
+  src[2] = std::bit_cast<f32>(0x35800000u);  // 2^-20
+  mx.Quantize(&fp8, src.data(), 1);
+  ASSERT_EQ(fp8.scale.v, 127 - 8);  // 1 = 2^-8 * 256 and 256 is in the top binade of E4M3.
+  ASSERT_EQ(fp8.elements[0].v, 0x78);
+  ASSERT_EQ(fp8.elements[1].v, 0xf4);
+  ASSERT_EQ(fp8.elements[2].v, 0x00);  // 2^-12 is below the smallest subnormal 2^-9.
+  ASSERT_EQ(fp8.elements[3].v, 0x00);
+  ASSERT_TRUE(mx.inexact && mx.underflow && !mx.overflow);
+
+  // Elements that round beyond the largest finite number are clamped.
+  mx.ClearFlags();
+  MxBlock<e2m1> fp4;
+  src[0] = 7.f32;  // 2^2 * 1.75 rounds to 2^3 which exceeds 6.
+  mx.Quantize(&fp4, src.data(), 1);
+  ASSERT_EQ(fp4.scale.v, 127);
+  ASSERT_EQ(fp4.elements[0].v, 0x7);
+  ASSERT_TRUE(mx.overflow);
+
+  // FP4 cannot encode infinities, so the whole block becomes NaN.
+  src[5] = -std::numeric_limits<f32>::infinity();
+  mx.Quantize(&fp4, src.data(), 1);
+  ASSERT_EQ(fp4.scale.v, 0xff);
+  std::array<f32, 32> dst;
+  mx.Dequantize(dst.data(), &fp4, 1);
+  ASSERT_TRUE(std::isnan(dst[0]));
+
+  src[5] = 0.f32;
+  mx.Quantize(&fp4, src.data(), 1);
+  mx.Dequantize(dst.data(), &fp4, 1);
+  ASSERT_EQ(dst[0], 6.f32);
+  ASSERT_EQ(dst[1], -1.f32);  // Ties to even.
+}
+
+template <typename FT>
+void DoTestMxRoundTrip(u8 element_mask) {
+  std::mt19937 rng(kRngSeed);
+  Mx mx;
+  for (i32 i = 0; i < 1000; ++i) {
+    std::array<MxBlock<FT>, 2> blocks{GenMxBlock<FT>(rng, element_mask), GenMxBlock<FT>(rng, element_mask)};
+    std::array<f32, 64> values, round_trip;
+    mx.ClearFlags();
+    mx.Dequantize(values.data(), blocks.data(), 2);
+    mx.Quantize(blocks.data(), values.data(), 2);
+    mx.Dequantize(round_trip.data(), blocks.data(), 2);
+    for (std::size_t j = 0; j < values.size(); ++j) {
+      if (!std::isnan(values[j]))
+        ASSERT_EQ(std::bit_cast<u32>(values[j]), std::bit_cast<u32>(round_trip[j]));
+    }
+    ASSERT_FALSE(mx.inexact);
+  }
+}
+
+// E4M3 is not lossless: Its top binade lacks 1.875 * 2^8, so the scale selection of the specification can clamp elements
+// like 1.875 * 2^7.
+TEST(TEST_SUITE_NAME, MxRoundTrip) {
+  DoTestMxRoundTrip<e5m2>(0xff);
+  DoTestMxRoundTrip<e3m2>(0x3f);
+  DoTestMxRoundTrip<e2m3>(0x3f);
+  DoTestMxRoundTrip<e2m1>(0x0f);
+}
+
+// Products of E4M3, FP6, and FP4 elements and their block sums are exact in f64.
+template <typename FTA, typename FTB>
+void DoTestMxDot(u8 mask_a, u8 mask_b) {
+  std::mt19937 rng(kRngSeed);
+  for (auto [sf_rm, rm] : rounding_modes) {
+    Mx mx;
+    mx.SetupToRiscv();
+    ff.SetupToRiscv();
+    mx.rounding_mode = ff.rounding_mode = rm;
+    for (i32 i = 0; i < 1000; ++i) {
+      constexpr std::size_t kNumBlocks = 4;
+      std::array<MxBlock<FTA>, kNumBlocks> a;
+      std::array<MxBlock<FTB>, kNumBlocks> b;
+      for (std::size_t k = 0; k < kNumBlocks; ++k) {
+        a[k] = GenMxBlock<FTA>(rng, mask_a);
+        b[k] = GenMxBlock<FTB>(rng, mask_b);
+      }
+      mx.ClearFlags();
+      ff.ClearFlags();
+      const f32 result = mx.Dot(a.data(), b.data(), kNumBlocks);
+
+      f32 expected = 0.f32;
+      for (std::size_t k = 0; k < kNumBlocks; ++k) {
+        std::array<f32, 32> va, vb;
+        MxBlock<FTA> unscaled_a = a[k];
+        MxBlock<FTB> unscaled_b = b[k];
+        unscaled_a.scale.v = unscaled_b.scale.v = 127;
+        mx.Dequantize(va.data(), &unscaled_a, 1);
+        mx.Dequantize(vb.data(), &unscaled_b, 1);
+        // The sum is exact, so adding with rm only matters for the sign of zero sums.
+        f64 sum = static_cast<f64>(va[0]) * static_cast<f64>(vb[0]);
+        for (std::size_t j = 1; j < 32; ++j)
+          sum = ff.Add(sum, static_cast<f64>(va[j]) * static_cast<f64>(vb[j]));
+        const f32 block = ff.F64ToF32(std::ldexp(sum, a[k].scale.v + b[k].scale.v - 254));
+        expected = k == 0 ? block : ff.Add(expected, block);
+      }
+      if (std::isnan(expected)) {
+        ASSERT_TRUE(std::isnan(result));
+        continue;
+      }
+      ASSERT_EQ(std::bit_cast<u32>(result), std::bit_cast<u32>(expected));
+      ASSERT_EQ(mx.inexact, ff.inexact);
+      ASSERT_EQ(mx.underflow, ff.underflow);
+      ASSERT_EQ(mx.overflow, ff.overflow);
+    }
+  }
+}
+
+TEST(TEST_SUITE_NAME, MxDot) {
+  DoTestMxDot<e4m3, e4m3>(0xff, 0xff);
+  DoTestMxDot<e2m1, e3m2>(0x0f, 0x3f);
+  DoTestMxDot<e2m3, e2m3>(0x3f, 0x3f);
+
+  // Zero sums follow the IEEE rules for the sign of zero, also when rounding toward negative.
+  Mx mx;
+  mx.rounding_mode = Vfpu::kRoundTowardNegative;
+  MxBlock<e4m3> a{}, b{};
+  a.scale.v = b.scale.v = 127;
+  ASSERT_EQ(std::bit_cast<u32>(mx.Dot(&a, &b, 1)), 0x00000000u);
+  for (auto& element : a.elements)
+    element.v = 0x80;  // -0
+  ASSERT_EQ(std::bit_cast<u32>(mx.Dot(&a, &b, 1)), 0x80000000u);
+  a.elements[0].v = 0x00;
+  ASSERT_EQ(std::bit_cast<u32>(mx.Dot(&a, &b, 1)), 0x80000000u);
+  mx.rounding_mode = Vfpu::kRoundTiesToEven;
+  ASSERT_EQ(std::bit_cast<u32>(mx.Dot(&a, &b, 1)), 0x00000000u);
+  a.elements[0].v = 0x38;  // 1
+  a.elements[1].v = 0xb8;  // -1
+  b.elements[0].v = b.elements[1].v = 0x38;
+  ASSERT_EQ(std::bit_cast<u32>(mx.Dot(&a, &b, 1)), 0x00000000u);
+  mx.rounding_mode = Vfpu::kRoundTowardNegative;
+  ASSERT_EQ(std::bit_cast<u32>(mx.Dot(&a, &b, 1)), 0x80000000u);
+}
+
+template <typename T>
+auto ResultBits(T a) {
+  if constexpr (std::is_integral_v<T>)
+    return a;
+  else
+    return std::bit_cast<typename FloatToUint<T>::type>(a);
+}
+
+// Runs op on both FPUs and expects bit-identical results and flags.
+template <typename Op>
+void ExpectSameAsFloppyFloat(F16Tables& tables, FloppyFloat& ref, f16 a, Op op) {
+  tables.ClearFlags();
+  ref.ClearFlags();
+  const auto result = op(tables);
+  const auto expected = op(ref);
+  ASSERT_EQ(ResultBits(result), ResultBits(expected)) << std::bit_cast<u16>(a);
+  ASSERT_EQ(tables.invalid, ref.invalid) << std::bit_cast<u16>(a);
+  ASSERT_EQ(tables.inexact, ref.inexact) << std::bit_cast<u16>(a);
+  ASSERT_EQ(tables.overflow, ref.overflow) << std::bit_cast<u16>(a);
+  ASSERT_EQ(tables.underflow, ref.underflow) << std::bit_cast<u16>(a);
+  ASSERT_EQ(tables.input_denormal, ref.input_denormal) << std::bit_cast<u16>(a);
+}
+
+TEST(TEST_SUITE_NAME, F16Tables) {
+  F16Tables tables;
+  FloppyFloat ref;
+  for (auto setup : {&Vfpu::SetupToRiscv, &Vfpu::SetupToX86, &Vfpu::SetupToArm}) {
+    (tables.*setup)();
+    (ref.*setup)();
+    // Subnormals are forwarded to FloppyFloat when FPCR.FZ16 flushes them or x86 reports DE.
+    for (const bool flush : {false, true}) {
+      tables.flush_inputs_f16 = tables.flush_outputs_f16 = ref.flush_inputs_f16 = ref.flush_outputs_f16 = flush;
+      for (const auto& rm : rounding_modes) {
+        tables.rounding_mode = rm.second;
+        ref.rounding_mode = rm.second;
+        for (u32 i = 0; i < (1u << 16); ++i) {
+          const f16 a = std::bit_cast<f16>(static_cast<u16>(i));
+          ExpectSameAsFloppyFloat(tables, ref, a, [a](auto& fpu) { return fpu.template Sqrt<f16>(a); });
+          ExpectSameAsFloppyFloat(tables, ref, a, [a](auto& fpu) { return fpu.template Class<f16>(a); });
+          ExpectSameAsFloppyFloat(tables, ref, a, [a](auto& fpu) { return fpu.F16ToF32(a); });
+          ExpectSameAsFloppyFloat(tables, ref, a, [a](auto& fpu) { return fpu.F16ToF64(a); });
+          ExpectSameAsFloppyFloat(tables, ref, a, [a](auto& fpu) { return fpu.F16ToI32(a); });
+          ExpectSameAsFloppyFloat(tables, ref, a, [a](auto& fpu) { return fpu.F16ToI64(a); });
+          ExpectSameAsFloppyFloat(tables, ref, a, [a](auto& fpu) { return fpu.F16ToU32(a); });
+          ExpectSameAsFloppyFloat(tables, ref, a, [a](auto& fpu) { return fpu.F16ToU64(a); });
+        }
+      }
+    }
+  }
+  for (u32 i = 0; i < (1u << 16); ++i) {
+    const f16 a = std::bit_cast<f16>(static_cast<u16>(i));
+    ExpectSameAsFloppyFloat(tables, ref, a, [a](auto& fpu) {
+      return fpu.template Sqrt<f16, Vfpu::kRoundTowardNegative>(a);
+    });
+    ExpectSameAsFloppyFloat(tables, ref, a, [a](auto& fpu) {
+      return fpu.template F16ToU32<Vfpu::kRoundTowardPositive>(a);
+    });
+  }
+}
+
+TEST(TEST_SUITE_NAME, F16TablesImage) {
+  const std::string path = testing::TempDir() + "f16_tables.bin";
+  ASSERT_TRUE(F16Tables::SaveImage(path));
+  F16Tables tables;
+  EXPECT_FALSE(F16Tables::MapImage(path));  // The generated image is already in use.
+  std::remove(path.c_str());
+}
+
+template <typename T>
+void ExpectSameFlags(const Vfpu& fpu, T context) {
+  ASSERT_EQ(fpu.invalid, static_cast<bool>(::softfloat_exceptionFlags & ::softfloat_flag_invalid)) << context;
+  ASSERT_EQ(fpu.division_by_zero, static_cast<bool>(::softfloat_exceptionFlags & ::softfloat_flag_infinite)) << context;
+  ASSERT_EQ(fpu.overflow, static_cast<bool>(::softfloat_exceptionFlags & ::softfloat_flag_overflow)) << context;
+  ASSERT_EQ(fpu.underflow, static_cast<bool>(::softfloat_exceptionFlags & ::softfloat_flag_underflow)) << context;
+  ASSERT_EQ(fpu.inexact, static_cast<bool>(::softfloat_exceptionFlags & ::softfloat_flag_inexact)) << context;
+}
+
+// Checks the generic formats that correspond to f16, f32, and f64 against Berkeley SoftFloat on both paths.
+template <typename IT, typename FT, typename IFUNC, typename SFUNC>
+void DoTestIeee(IFUNC ieee_func, SFUNC sf_func) {
+  using SFT = typename FFloatToSFloat<FT>::type;
+  IeeeFloat fpu;
+#if defined(ARCH_RISCV)
+  fpu.SetupToRiscv();
+#elif defined(ARCH_X86)
+  fpu.SetupToX86();
+#elif defined(ARCH_ARM)
+  fpu.SetupToArm();
+  fpu.nan_propagation_scheme = kArmNanPropagation;
+#endif
+
+  for (bool fast_path : {true, false}) {
+    fpu.fast_path = fast_path;
+    for (const auto& rm : rounding_modes) {
+      ::softfloat_roundingMode = rm.first;
+      fpu.rounding_mode = rm.second;
+      FloatRng<FT> float_rng(kRngSeed);
+      FT a = float_rng.Gen();
+      FT b = float_rng.Gen();
+      for (i32 i = 0; i < kNumIterations / 10; ++i) {
+        const FT c = float_rng.Gen();
+        fpu.ClearFlags();
+        ::softfloat_exceptionFlags = 0;
+        const IT result = ieee_func(fpu, std::bit_cast<IT>(a), std::bit_cast<IT>(b), std::bit_cast<IT>(c));
+        const SFT sf_result = sf_func(std::bit_cast<SFT>(a), std::bit_cast<SFT>(b), std::bit_cast<SFT>(c));
+        ASSERT_EQ(result.v, ToComparableType(sf_result)) << "Iteration: " << i << ", fast path: " << fast_path;
+        ExpectSameFlags(fpu, i);
+        a = b;
+        b = c;
+      }
+    }
+  }
+}
+
+#define IEEE_TEST(name, ftype, itype, sf_prefix)                                                                  \
+  TEST(TEST_SUITE_NAME, name) {                                                                                    \
+    DoTestIeee<itype, ftype>([](IeeeFloat& fpu, itype a, itype b, itype) { return fpu.Add(a, b); },               \
+                             [](auto a, auto b, auto) { return sf_prefix##_add(a, b); });                          \
+    DoTestIeee<itype, ftype>([](IeeeFloat& fpu, itype a, itype b, itype) { return fpu.Sub(a, b); },               \
+                             [](auto a, auto b, auto) { return sf_prefix##_sub(a, b); });                          \
+    DoTestIeee<itype, ftype>([](IeeeFloat& fpu, itype a, itype b, itype) { return fpu.Mul(a, b); },               \
+                             [](auto a, auto b, auto) { return sf_prefix##_mul(a, b); });                          \
+    DoTestIeee<itype, ftype>([](IeeeFloat& fpu, itype a, itype b, itype) { return fpu.Div(a, b); },               \
+                             [](auto a, auto b, auto) { return sf_prefix##_div(a, b); });                          \
+    DoTestIeee<itype, ftype>([](IeeeFloat& fpu, itype a, itype, itype) { return fpu.Sqrt(a); },                   \
+                             [](auto a, auto, auto) { return sf_prefix##_sqrt(a); });                              \
+    DoTestIeee<itype, ftype>([](IeeeFloat& fpu, itype a, itype b, itype c) { return fpu.Fma(a, b, c); },          \
+                             [](auto a, auto b, auto c) { return sf_prefix##_mulAddRef(a, b, c); });               \
+  }
+
+using IeeeHalf = Ieee<5, 10>;
+using IeeeSingle = Ieee<8, 23>;
+using IeeeDouble = Ieee<11, 52>;
+
+IEEE_TEST(IeeeF16, f16, IeeeHalf, f16)
+IEEE_TEST(IeeeF32, f32, IeeeSingle, f32)
+IEEE_TEST(IeeeF64, f64, IeeeDouble, f64)
+
+// The fast path has to agree with the integer implementation, including the flags.
+template <typename IT>
+void DoTestIeeeFastPath() {
+  static_assert(IeeeFloat::HasFastPath<IT>());
+  constexpr u64 kMask = ~0ull >> (63 - IT::kExpBits - IT::kManBits);
+  std::mt19937_64 rng(kRngSeed);
+  IeeeFloat fast;
+  IeeeFloat soft;
+  soft.fast_path = false;
+  for (bool tininess_before_rounding : {false, true}) {
+    fast.tininess_before_rounding = tininess_before_rounding;
+    soft.tininess_before_rounding = tininess_before_rounding;
+    for (i32 i = 0; i < kNumIterations; ++i) {
+      const IT a{static_cast<typename IT::UT>(rng() & kMask)};
+      const IT b{static_cast<typename IT::UT>(rng() & kMask)};
+      const IT c{static_cast<typename IT::UT>(rng() & kMask)};
+      fast.rounding_mode = rounding_modes[i % 5].second;
+      soft.rounding_mode = rounding_modes[i % 5].second;
+      auto check = [&](auto op) {
+        fast.ClearFlags();
+        soft.ClearFlags();
+        const IT result = op(fast);
+        ASSERT_EQ(result.v, op(soft).v) << a.v << " " << b.v << " " << c.v;
+        ASSERT_EQ(fast.invalid, soft.invalid);
+        ASSERT_EQ(fast.division_by_zero, soft.division_by_zero);
+        ASSERT_EQ(fast.overflow, soft.overflow);
+        ASSERT_EQ(fast.underflow, soft.underflow);
+        ASSERT_EQ(fast.inexact, soft.inexact);
+      };
+      check([&](IeeeFloat& fpu) { return fpu.Add(a, b); });
+      check([&](IeeeFloat& fpu) { return fpu.Mul(a, b); });
+      check([&](IeeeFloat& fpu) { return fpu.Div(a, b); });
+      check([&](IeeeFloat& fpu) { return fpu.Sqrt(a); });
+      check([&](IeeeFloat& fpu) { return fpu.Fma(a, b, c); });
+    }
+  }
+}
+
+TEST(TEST_SUITE_NAME, IeeeFastPath) {
+  DoTestIeeeFastPath<tf32>();
+  DoTestIeeeFastPath<Ieee<3, 2>>();
+  DoTestIeeeFastPath<Ieee<2, 3>>();
+  DoTestIeeeFastPath<Ieee<8, 15>>();
+  DoTestIeeeFastPath<Ieee<9, 25>>();
+}
+
+TEST(TEST_SUITE_NAME, MinMax) {
+  FloppyFloat fpu;
+  fpu.SetupToRiscv();
+  // Loaded at run time, since the compiler may quiet a constant signaling NaN.
+  volatile u32 nan_bits[2] = {0x7fc12345u, 0x7f812345u};
+  const f32 qnan = std::bit_cast<f32>(static_cast<u32>(nan_bits[0]));
+  const f32 snan = std::bit_cast<f32>(static_cast<u32>(nan_bits[1]));
+  auto bits = [](f32 a) { return std::bit_cast<u32>(a); };
+
+  ASSERT_EQ(bits(fpu.Maximum(-0.f, 0.f)), 0x00000000u);
+  ASSERT_EQ(bits(fpu.Minimum(0.f, -0.f)), 0x80000000u);
+  ASSERT_EQ(bits(fpu.MaximumNumber(-0.f, 0.f)), 0x00000000u);
+  ASSERT_EQ(bits(fpu.MinimumNumber(0.f, -0.f)), 0x80000000u);
+  ASSERT_EQ(fpu.MinimumNumber(1.f, 2.f), 1.f);
+  ASSERT_EQ(fpu.MaximumMagnitude(-2.f, 1.f), -2.f);
+  ASSERT_EQ(fpu.MaximumMagnitude(-1.f, 1.f), 1.f);
+  ASSERT_EQ(fpu.MinimumMagnitude(2.f, -3.f), 2.f);
+  ASSERT_EQ(fpu.MinimumMagnitude(1.f, -1.f), -1.f);
+
+  fpu.ClearFlags();
+  ASSERT_EQ(bits(fpu.Maximum(qnan, 1.f)), 0x7fc00000u);
+  ASSERT_EQ(bits(fpu.MinimumMagnitude(1.f, qnan)), 0x7fc00000u);
+  ASSERT_FALSE(fpu.invalid);
+  ASSERT_EQ(fpu.MaximumNumber(qnan, 1.f), 1.f);
+  ASSERT_EQ(fpu.MinimumMagnitudeNumber(-3.f, qnan), -3.f);
+  ASSERT_EQ(bits(fpu.MaximumMagnitudeNumber(qnan, qnan)), 0x7fc00000u);
+  ASSERT_FALSE(fpu.invalid);
+  ASSERT_EQ(bits(fpu.Minimum(snan, 1.f)), 0x7fc00000u);
+  ASSERT_TRUE(fpu.invalid);
+  fpu.ClearFlags();
+  ASSERT_EQ(fpu.MaximumMagnitudeNumber(2.f, snan), 2.f);
+  ASSERT_TRUE(fpu.invalid);
+
+  // x86 propagates the first NaN.
+  fpu.SetupToX86();
+  ASSERT_EQ(bits(fpu.Maximum(1.f, snan)), 0x7fc12345u);
+  ASSERT_EQ(bits(fpu.Minimum(qnan, snan)), 0x7fc12345u);
+  ASSERT_EQ(bits(fpu.MinMaxAvx10(snan, qnan, 0x10)), 0x7fc12345u);
+  ASSERT_EQ(bits(fpu.MinMaxAvx10(1.f, qnan, 0x00)), 0x7fc12345u);
+  ASSERT_EQ(fpu.MinMaxAvx10(1.f, qnan, 0x10), 1.f);
+  ASSERT_EQ(fpu.MinMaxAvx10(1.f, -2.f, 0x00), -2.f);
+  ASSERT_EQ(fpu.MinMaxAvx10(1.f, -2.f, 0x01), 1.f);
+  ASSERT_EQ(fpu.MinMaxAvx10(1.f, -2.f, 0x02), 1.f);
+  ASSERT_EQ(fpu.MinMaxAvx10(1.f, -2.f, 0x03), -2.f);
+  ASSERT_EQ(fpu.MinMaxAvx10(-1.f, 2.f, 0x05), -2.f);  // Sign of a.
+  ASSERT_EQ(fpu.MinMaxAvx10(-1.f, -2.f, 0x08), 2.f);  // Cleared sign.
+  ASSERT_EQ(fpu.MinMaxAvx10(1.f, 2.f, 0x0c), -1.f);   // Set sign.
+}
+
+// The batch kernels have to agree with the scalar versions, including the flags.
+template <typename FT>
+void DoTestMinMaxBatch() {
+  using UT = FloatToUint<FT>::type;
+  std::mt19937_64 rng(kRngSeed);
+  auto gen = [&]() {
+    FT value = std::bit_cast<FT>(static_cast<UT>(rng()));
+    if (IsNan(value) && rng() % 4)
+      value = std::bit_cast<FT>(static_cast<UT>(rng() & SignMask<FT>()));  // Mostly zeros instead of NaNs.
+    return value;
+  };
+  constexpr std::size_t kSize = 1000;
+  std::vector<FT> a(kSize), b(kSize), result(kSize);
+
+  for (i32 op = FloppyFloat::kMaximum; op <= FloppyFloat::kMinimumMagnitudeNumber; ++op) {
+    for (i32 i = 0; i < 50; ++i) {
+      for (std::size_t j = 0; j < kSize; ++j) {
+        a[j] = gen();
+        b[j] = (rng() % 8) ? gen() : -a[j];
+      }
+      const std::size_t n = kSize - rng() % 100;
+      FloppyFloat batch;
+      FloppyFloat scalar;
+      batch.SetupToRiscv();
+      scalar.SetupToRiscv();
+      batch.MinMaxBatch(static_cast<FloppyFloat::MinMaxOperation>(op), result.data(), a.data(), b.data(), n);
+      for (std::size_t j = 0; j < n; ++j) {
+        FT expected;
+        switch (op) {
+        case FloppyFloat::kMaximum:
+          expected = scalar.Maximum(a[j], b[j]);
+          break;
+        case FloppyFloat::kMinimum:
+          expected = scalar.Minimum(a[j], b[j]);
+          break;
+        case FloppyFloat::kMaximumNumber:
+          expected = scalar.MaximumNumber(a[j], b[j]);
+          break;
+        case FloppyFloat::kMinimumNumber:
+          expected = scalar.MinimumNumber(a[j], b[j]);
+          break;
+        case FloppyFloat::kMaximumMagnitude:
+          expected = scalar.MaximumMagnitude(a[j], b[j]);
+          break;
+        case FloppyFloat::kMinimumMagnitude:
+          expected = scalar.MinimumMagnitude(a[j], b[j]);
+          break;
+        case FloppyFloat::kMaximumMagnitudeNumber:
+          expected = scalar.MaximumMagnitudeNumber(a[j], b[j]);
+          break;
+        default:
+          expected = scalar.MinimumMagnitudeNumber(a[j], b[j]);
+          break;
+        }
+        ASSERT_EQ(std::bit_cast<UT>(result[j]), std::bit_cast<UT>(expected)) << "Operation: " << op << ", index: " << j;
+      }
+      ASSERT_EQ(batch.invalid, scalar.invalid);
+
+      // In place.
+      batch.MinMaxBatch(static_cast<FloppyFloat::MinMaxOperation>(op), a.data(), a.data(), b.data(), n);
+      for (std::size_t j = 0; j < n; ++j)
+        ASSERT_EQ(std::bit_cast<UT>(a[j]), std::bit_cast<UT>(result[j]));
+    }
+  }
+}
+
+TEST(TEST_SUITE_NAME, MinMaxBatch) {
+  DoTestMinMaxBatch<f16>();
+  DoTestMinMaxBatch<f32>();
+  DoTestMinMaxBatch<f64>();
+}
+
+TEST(TEST_SUITE_NAME, RoundToIntegral) {
+  FloppyFloat fpu;
+  fpu.SetupToRiscv();
+  ASSERT_EQ((fpu.RoundToIntegral<f32, FloppyFloat::kRoundTiesToEven>(2.5f)), 2.f);
+  ASSERT_EQ((fpu.RoundToIntegral<f64, FloppyFloat::kRoundTowardNegative>(-0.5)), -1.);
+  ASSERT_EQ(std::bit_cast<u32>(fpu.RoundToIntegral<f32, FloppyFloat::kRoundTowardPositive>(-0.5f)), 0x80000000u);
+  ASSERT_FALSE(fpu.inexact);
+  ASSERT_EQ((fpu.RoundToIntegral<f32, FloppyFloat::kRoundTiesToAway, true>(2.5f)), 3.f);
+  ASSERT_TRUE(fpu.inexact);
+
+  fpu.ClearFlags();
+  ASSERT_EQ((fpu.RoundToIntegralBounded<f32, i32, FloppyFloat::kRoundTowardZero>(-2147483648.f)), -2147483648.f);
+  ASSERT_EQ((fpu.RoundToIntegralBounded<f64, i64, FloppyFloat::kRoundTowardZero>(-1.5)), -1.);
+  ASSERT_FALSE(fpu.invalid);
+  ASSERT_TRUE(fpu.inexact);
+  fpu.ClearFlags();
+  ASSERT_EQ((fpu.RoundToIntegralBounded<f32, i32, FloppyFloat::kRoundTowardZero>(2147483648.f)), -2147483648.f);
+  ASSERT_TRUE(fpu.invalid);
+  ASSERT_FALSE(fpu.inexact);
+  fpu.ClearFlags();
+  ASSERT_EQ((fpu.RoundToIntegralBounded<f64, i32>(2147483647.5)), -2147483648.);
+  ASSERT_TRUE(fpu.invalid);
+  fpu.ClearFlags();
+  ASSERT_EQ((fpu.RoundToIntegralBounded<f32, i64>(std::numeric_limits<f32>::quiet_NaN())), -9223372036854775808.f);
+  ASSERT_TRUE(fpu.invalid);
+
+  fpu.SetupToX86();
+  fpu.ClearFlags();
+  ASSERT_EQ(fpu.Roundx86(-1.5f, 0x9), -2.f);
+  ASSERT_FALSE(fpu.inexact);
+  ASSERT_EQ(fpu.Roundx86(-1.5, 0x3), -1.);
+  ASSERT_TRUE(fpu.inexact);
+  fpu.rounding_mode = FloppyFloat::kRoundTowardPositive;
+  ASSERT_EQ(fpu.Roundx86(1.25f, 0x4), 2.f);
+  volatile u32 snan_bits = 0x7f812345u;  // Loaded at run time, since the compiler may quiet a constant signaling NaN.
+  ASSERT_EQ(std::bit_cast<u32>(fpu.Roundx86(std::bit_cast<f32>(static_cast<u32>(snan_bits)), 0x0)), 0x7fc12345u);
+  ASSERT_TRUE(fpu.invalid);
+}
+
+// The batch versions have to agree with the scalar versions, including the flags.
+template <typename FT, bool exact>
+void DoTestRoundToIntegralBatch() {
+  using UT = FloatToUint<FT>::type;
+  std::mt19937_64 rng(kRngSeed);
+  FloatRng<FT> float_rng(kRngSeed);
+  constexpr std::size_t kSize = 1000;
+  std::vector<FT> a(kSize), result(kSize);
+
+  const UT subnormal_mask = SignMask<FT>() | static_cast<UT>((UT{1} << NumSignificandBits<FT>()) - 1u);
+
+  for (const auto& [unused, rm] : rounding_modes) {
+    for (i32 i = 0; i < 50; ++i) {
+      for (auto& value : a) {
+        value = float_rng.Gen();
+        if (rng() % 2)  // Values with a fractional part.
+          value = static_cast<FT>(static_cast<f64>(rng() % 100000) / 64. - 781.25);
+        else if (i % 2 && rng() % 8 == 0)
+          value = std::bit_cast<FT>(static_cast<UT>(static_cast<UT>(rng()) & subnormal_mask));
+      }
+      const std::size_t n = kSize - rng() % 100;
+      FloppyFloat batch;
+      FloppyFloat scalar;
+      batch.SetupToRiscv();
+      scalar.SetupToRiscv();
+      batch.rounding_mode = rm;
+      scalar.rounding_mode = rm;
+      // Flushed subnormals have to take the scalar path, which raises IDC for them.
+      batch.flush_inputs = batch.flush_inputs_f16 = scalar.flush_inputs = scalar.flush_inputs_f16 = i % 4 >= 2;
+      batch.flush_outputs = batch.flush_outputs_f16 = scalar.flush_outputs = scalar.flush_outputs_f16 = i % 4 == 3;
+      if constexpr (exact)
+        batch.RoundToIntegralExactBatch(result.data(), a.data(), n);
+      else
+        batch.RoundToIntegralBatch(result.data(), a.data(), n);
+      for (std::size_t j = 0; j < n; ++j) {
+        const FT expected = exact ? scalar.RoundToIntegralExact(a[j]) : scalar.RoundToIntegral(a[j]);
+        ASSERT_EQ(std::bit_cast<UT>(result[j]), std::bit_cast<UT>(expected));
+      }
+      ASSERT_EQ(batch.invalid, scalar.invalid);
+      ASSERT_EQ(batch.inexact, scalar.inexact);
+      ASSERT_EQ(batch.input_denormal, scalar.input_denormal);
+    }
+  }
+}
+
+TEST(TEST_SUITE_NAME, RoundToIntegralBatch) {
+  DoTestRoundToIntegralBatch<f16, false>();
+  DoTestRoundToIntegralBatch<f16, true>();
+  DoTestRoundToIntegralBatch<f32, false>();
+  DoTestRoundToIntegralBatch<f32, true>();
+  DoTestRoundToIntegralBatch<f64, false>();
+  DoTestRoundToIntegralBatch<f64, true>();
+}
+
+// Reference for the estimates of finite nonzero operands, computed from the exact operand with the formulas of the
+// specifications instead of tables and bit manipulation. Subnormal results are truncated like in the specifications.
+u32 RecipEstimateArmRef(u32 a) {
+  const u32 b = (1u << 19) / (a * 2 + 1);
+  return (b + 1) / 2;
+}
+
+u32 RecipSqrtEstimateArmRef(u32 a) {
+  a = (a < 256) ? a * 2 + 1 : ((a >> 1) << 1) * 2 + 2;
+  u64 b = 512;
+  while (a * (b + 1) * (b + 1) < (1ull << 28))
+    ++b;
+  return static_cast<u32>((b + 1) / 2);
+}
+
+template <typename FT>
+FT EstimateRef(Estimator::Operation op, FT a, Vfpu::RoundingMode rm, bool& overflow) {
+  constexpr i32 kBias = Bias<FT>();
+  constexpr i32 kMinExp = 1 - kBias - NumSignificandBits<FT>();
+  const bool sign = std::signbit(static_cast<f64>(a));
+  i32 k;
+  const f64 m = 2. * std::frexp(std::fabs(static_cast<f64>(a)), &k);
+  const i32 e = k - 1;  // |a| = m * 2^e with m in [1, 2).
+  const bool odd = (e + kBias) & 1;
+  overflow = false;
+
+  f64 sig = 1.;
+  i32 exp = 0;
+  switch (op) {
+  case Estimator::kRecipEstimateRiscv:
+    sig = 1. + std::nearbyint((2. / (1. + (std::floor((m - 1.) * 128.) + 0.5) / 128.) - 1.) * 128.) / 128.;
+    exp = -e - 1;
+    break;
+  case Estimator::kRsqrtEstimateRiscv: {
+    const f64 x = odd ? 1. + (std::floor((m - 1.) * 64.) + 0.5) / 64. : 2. + (std::floor((m - 1.) * 64.) + 0.5) / 32.;
+    sig = 1. + std::nearbyint((2. / std::sqrt(x) - 1.) * 128.) / 128.;
+    exp = odd ? -e / 2 - 1 : -(e + 1) / 2;
+    break;
+  }
+  case Estimator::kRecipEstimateArm:
+    sig = RecipEstimateArmRef(256 + static_cast<u32>((m - 1.) * 256.)) / 256.;
+    exp = -e - 1;
+    break;
+  case Estimator::kRsqrtEstimateArm:
+    sig = odd ? RecipSqrtEstimateArmRef(128 + static_cast<u32>((m - 1.) * 128.)) / 256.
+              : RecipSqrtEstimateArmRef(256 + static_cast<u32>((m - 1.) * 256.)) / 256.;
+    exp = odd ? -e / 2 - 1 : -(e + 1) / 2;
+    break;
+  default:
+    exp = (e + kBias > 0) ? 1 - e : kBias;
+    break;
+  }
+
+  if ((op == Estimator::kRecipEstimateRiscv || op == Estimator::kRecipEstimateArm) && e < -kBias - 1) {
+    overflow = true;
+    const bool to_max = rm == Vfpu::kRoundTowardZero || (rm == Vfpu::kRoundTowardNegative && !sign) ||
+                        (rm == Vfpu::kRoundTowardPositive && sign);
+    const FT result = to_max ? std::numeric_limits<FT>::max() : std::numeric_limits<FT>::infinity();
+    return sign ? -result : result;
+  }
+  f64 result = std::ldexp(sig, exp);
+  if (exp < 1 - kBias)
+    result = std::ldexp(std::trunc(std::ldexp(sig, exp - kMinExp)), kMinExp);
+  if (op == Estimator::kRsqrtEstimateRiscv || op == Estimator::kRsqrtEstimateArm)
+    return static_cast<FT>(result);
+  return static_cast<FT>(sign ? -result : result);
+}
+
+template <typename FT>
+FT Estimate(Estimator& fpu, Estimator::Operation op, FT a) {
+  switch (op) {
+  case Estimator::kRecipEstimateRiscv:
+    return fpu.RecipEstimateRiscv(a);
+  case Estimator::kRsqrtEstimateRiscv:
+    return fpu.RsqrtEstimateRiscv(a);
+  case Estimator::kRecipEstimateArm:
+    return fpu.RecipEstimateArm(a);
+  case Estimator::kRsqrtEstimateArm:
+    return fpu.RsqrtEstimateArm(a);
+  case Estimator::kRecipExponentArm:
+    return fpu.RecipExponentArm(a);
+  case Estimator::kRecipEstimateX86:
+    if constexpr (!std::is_same_v<FT, f16>)
+      return fpu.RecipEstimateX86(a);
+    break;
+  case Estimator::kRsqrtEstimateX86:
+    if constexpr (!std::is_same_v<FT, f16>)
+      return fpu.RsqrtEstimateX86(a);
+    break;
+  }
+  return std::numeric_limits<FT>::quiet_NaN();  // The x86 estimates have no f16 variant.
+}
+
+constexpr std::array<Estimator::Operation, 5> kEstimateOperations{
+    Estimator::kRecipEstimateRiscv, Estimator::kRsqrtEstimateRiscv, Estimator::kRecipEstimateArm,
+    Estimator::kRsqrtEstimateArm, Estimator::kRecipExponentArm};
+
+template <typename FT>
+void CheckEstimate(Estimator& fpu, Estimator::Operation op, FT a) {
+  using UT = FloatToUint<FT>::type;
+  if (IsNan(a) || IsInf(a) || IsZero(a) || (std::signbit(static_cast<f64>(a)) &&
+                                            (op == Estimator::kRsqrtEstimateRiscv || op == Estimator::kRsqrtEstimateArm)))
+    return;
+  bool overflow;
+  const FT expected = EstimateRef(op, a, fpu.rounding_mode, overflow);
+  fpu.ClearFlags();
+  const FT result = Estimate(fpu, op, a);
+  ASSERT_EQ(std::bit_cast<UT>(result), std::bit_cast<UT>(expected)) << op << " " << std::bit_cast<UT>(a);
+  ASSERT_EQ(fpu.overflow, overflow);
+  ASSERT_EQ(fpu.inexact, overflow);
+  ASSERT_FALSE(fpu.underflow || fpu.invalid || fpu.division_by_zero);
+}
+
+TEST(TEST_SUITE_NAME, EstimateExhaustiveF16) {
+  Estimator fpu;
+  for (const auto& [unused, rm] : rounding_modes) {
+    fpu.rounding_mode = rm;
+    for (const auto op : kEstimateOperations)
+      for (u32 i = 0; i < 0x10000; ++i)
+        CheckEstimate(fpu, op, std::bit_cast<f16>(static_cast<u16>(i)));
+  }
+}
+
+// Every exponent with every value of the 8 leading fraction bits, which are all the fraction bits the estimates
+// depend on. The remaining fraction bits and the sign are random. Subnormal operands additionally get every position
+// of the leading one.
+template <typename FT>
+void DoTestEstimate() {
+  using UT = FloatToUint<FT>::type;
+  constexpr i32 kSigBits = NumSignificandBits<FT>();
+  std::mt19937_64 rng(kRngSeed);
+  Estimator fpu;
+  for (const auto& [unused, rm] : rounding_modes) {
+    fpu.rounding_mode = rm;
+    for (const auto op : kEstimateOperations) {
+      for (UT exp = 0; exp < (UT{1} << NumExponentBits<FT>()) - 1; ++exp) {
+        for (UT lead = 0; lead < 256; ++lead) {
+          for (i32 shift = 0; shift < (exp ? 1 : kSigBits); ++shift) {
+            const UT low = static_cast<UT>(rng() >> (64 - kSigBits + 8));
+            UT frac = static_cast<UT>(lead << (kSigBits - 8)) | low;
+            if (exp == 0)
+              frac = static_cast<UT>(((UT{1} << kSigBits) | frac) >> (shift + 1));
+            const UT sign = (rng() & 1) ? SignMask<FT>() : 0;
+            CheckEstimate(fpu, op, std::bit_cast<FT>(static_cast<UT>(sign | (exp << kSigBits) | frac)));
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(TEST_SUITE_NAME, Estimate) {
+  DoTestEstimate<f32>();
+  DoTestEstimate<f64>();
+
+  Estimator fpu;
+  fpu.SetupToRiscv();
+  ASSERT_EQ(std::bit_cast<u32>(fpu.RecipEstimateRiscv(1.f)), 0x3f7f0000u);
+  ASSERT_EQ(std::bit_cast<u32>(fpu.RsqrtEstimateRiscv(1.f)), 0x3f7f0000u);
+  ASSERT_EQ(std::bit_cast<u32>(fpu.RecipEstimateRiscv(-std::numeric_limits<f32>::infinity())), 0x80000000u);
+  ASSERT_FALSE(fpu.division_by_zero);
+  ASSERT_EQ(fpu.RecipEstimateRiscv(-0.f), -std::numeric_limits<f32>::infinity());
+  ASSERT_TRUE(fpu.division_by_zero);
+  fpu.ClearFlags();
+  ASSERT_EQ(std::bit_cast<u32>(fpu.RsqrtEstimateRiscv(-1.f)), 0x7fc00000u);
+  ASSERT_TRUE(fpu.invalid);
+  fpu.ClearFlags();
+  ASSERT_EQ(std::bit_cast<u32>(fpu.RsqrtEstimateRiscv(std::numeric_limits<f32>::infinity())), 0u);
+  volatile u32 snan_bits = 0x7f812345u;  // Loaded at run time, since the compiler may quiet a constant signaling NaN.
+  const f32 snan = std::bit_cast<f32>(static_cast<u32>(snan_bits));
+  ASSERT_EQ(std::bit_cast<u32>(fpu.RecipEstimateRiscv(snan)), 0x7fc00000u);
+  ASSERT_TRUE(fpu.invalid);
+
+  fpu.SetupToArm();
+  fpu.ClearFlags();
+  ASSERT_EQ(std::bit_cast<u32>(fpu.RecipEstimateArm(1.f)), 0x3f7f8000u);
+  ASSERT_EQ(std::bit_cast<u32>(fpu.RsqrtEstimateArm(1.f)), 0x3f7f8000u);
+  ASSERT_EQ(std::bit_cast<u64>(fpu.RecipEstimateArm(-1.)), 0xbfeff00000000000ull);
+  ASSERT_EQ(fpu.RecipExponentArm(3.f), 1.f);
+  ASSERT_EQ(fpu.RecipExponentArm(-0.f), -std::numeric_limits<f32>::max() / 1.9999999f);
+  ASSERT_EQ(std::bit_cast<u32>(fpu.RecipExponentArm(std::numeric_limits<f32>::infinity())), 0u);
+  ASSERT_FALSE(fpu.invalid || fpu.inexact || fpu.overflow || fpu.division_by_zero);
+  fpu.rounding_mode = Vfpu::kRoundTowardPositive;
+  ASSERT_EQ(fpu.RecipEstimateArm(-std::numeric_limits<f32>::denorm_min()), std::numeric_limits<f32>::lowest());
+  ASSERT_TRUE(fpu.overflow && fpu.inexact);
+  fpu.nan_propagation_scheme = Vfpu::kNanPropArm64;
+  fpu.ClearFlags();
+  ASSERT_EQ(std::bit_cast<u32>(fpu.RsqrtEstimateArm(snan)), 0x7fc12345u);
+  ASSERT_TRUE(fpu.invalid);
+
+  // FPCR.FZ: Subnormal operands count as zeros and raise IDC, subnormal reciprocals become zeros and raise UFC.
+  fpu.flush_inputs = fpu.flush_outputs = true;
+  fpu.ClearFlags();
+  ASSERT_EQ(fpu.RecipEstimateArm(-std::numeric_limits<f32>::denorm_min()), -std::numeric_limits<f32>::infinity());
+  ASSERT_TRUE(fpu.division_by_zero && fpu.input_denormal && !fpu.overflow && !fpu.inexact);
+  fpu.ClearFlags();
+  ASSERT_EQ(fpu.RsqrtEstimateArm(std::bit_cast<f32>(0x00400000u)), std::numeric_limits<f32>::infinity());
+  ASSERT_TRUE(fpu.division_by_zero && fpu.input_denormal);
+  fpu.ClearFlags();
+  ASSERT_EQ(fpu.RecipExponentArm(std::numeric_limits<f32>::denorm_min()), std::numeric_limits<f32>::max() / 1.9999999f);
+  ASSERT_TRUE(fpu.input_denormal && !fpu.division_by_zero);
+  fpu.ClearFlags();
+  ASSERT_EQ(std::bit_cast<u32>(fpu.RecipEstimateArm(std::bit_cast<f32>(0xfe800000u))), 0x80000000u);
+  ASSERT_TRUE(fpu.underflow && !fpu.inexact && !fpu.input_denormal);
+  fpu.ClearFlags();
+  ASSERT_EQ(std::bit_cast<u32>(fpu.RecipEstimateArm(std::bit_cast<f32>(0x7e000000u))), 0x00ff8000u);
+  ASSERT_FALSE(fpu.underflow);
+  const f16 tiny16 = std::bit_cast<f16>(static_cast<u16>(0x0200u));  // FPCR.FZ16 is separate.
+  ASSERT_EQ(std::bit_cast<u16>(fpu.RecipEstimateArm(tiny16)), 0x77fcu);
+  ASSERT_FALSE(fpu.input_denormal);
+}
+
+// The batch version has to agree with the scalar versions, including the flags.
+template <typename FT>
+void DoTestEstimateBatch() {
+  using UT = FloatToUint<FT>::type;
+  std::mt19937_64 rng(kRngSeed);
+  FloatRng<FT> float_rng(kRngSeed);
+  constexpr std::size_t kSize = 1000;
+  std::vector<FT> a(kSize), result(kSize);
+  std::vector<Estimator::Operation> ops(kEstimateOperations.begin(), kEstimateOperations.end());
+  if constexpr (!std::is_same_v<FT, f16>)
+    ops.insert(ops.end(), {Estimator::kRecipEstimateX86, Estimator::kRsqrtEstimateX86});
+
+  for (const auto op : ops) {
+    for (i32 i = 0; i < 50; ++i) {
+      for (auto& value : a) {
+        value = (i % 2) ? float_rng.Gen() : static_cast<FT>(static_cast<f64>(rng() % 100000) / 64. + 0.5);
+      }
+      const std::size_t n = kSize - rng() % 100;
+      Estimator batch;
+      Estimator scalar;
+      batch.SetupToArm();
+      scalar.SetupToArm();
+      batch.flush_inputs = batch.flush_inputs_f16 = batch.flush_outputs = batch.flush_outputs_f16 = i % 4 >= 2;
+      scalar.flush_inputs = scalar.flush_inputs_f16 = scalar.flush_outputs = scalar.flush_outputs_f16 = i % 4 >= 2;
+      batch.Batch(op, result.data(), a.data(), n);
+      for (std::size_t j = 0; j < n; ++j)
+        ASSERT_EQ(std::bit_cast<UT>(result[j]), std::bit_cast<UT>(Estimate(scalar, op, a[j])));
+      ASSERT_EQ(batch.invalid, scalar.invalid);
+      ASSERT_EQ(batch.division_by_zero, scalar.division_by_zero);
+      ASSERT_EQ(batch.overflow, scalar.overflow);
+      ASSERT_EQ(batch.underflow, scalar.underflow);
+      ASSERT_EQ(batch.inexact, scalar.inexact);
+      ASSERT_EQ(batch.input_denormal, scalar.input_denormal);
+    }
+  }
+}
+
+TEST(TEST_SUITE_NAME, EstimateBatch) {
+  DoTestEstimateBatch<f16>();
+  DoTestEstimateBatch<f32>();
+  DoTestEstimateBatch<f64>();
+}
+
+// Results of VRCP14SS/VRSQRT14SS and VRCP14SD/VRSQRT14SD recorded on an Intel Xeon: {a, recip, rsqrt}.
+constexpr u32 kEstimateX86F32[][3] = {
+    {0x3f800000u, 0x3f800000u, 0x3f800000u}, {0x3f800001u, 0x3f7ffe00u, 0x3f7ffd00u},
+    {0x3fc00000u, 0x3f2aaa80u, 0x3f510480u}, {0x40000000u, 0x3f000000u, 0x3f350280u},
+    {0x40490fdbu, 0x3ea2fa00u, 0x3f106f00u}, {0xc2f6e979u, 0xbc04b780u, 0xffc00000u},
+    {0x3f3504f3u, 0x3fb50600u, 0x3f983880u}, {0x00200001u, 0x7f7ffe00u, 0x5f7ffd00u},
+    {0x00000001u, 0x7f800000u, 0x64b50280u}, {0x7e800001u, 0x007fff00u, 0x1ffffd00u},
+    {0x7f7fffffu, 0x00200000u, 0x1f800000u}, {0x7f800001u, 0x7fc00001u, 0x7fc00001u},
+    {0xbf800000u, 0xbf800000u, 0xffc00000u}};
+constexpr u64 kEstimateX86F64[][3] = {
+    {0x3ff0000000000000ull, 0x3ff0000000000000ull, 0x3ff0000000000000ull},
+    {0x3ff8000000000000ull, 0x3fe5555000000000ull, 0x3fea209000000000ull},
+    {0x400921fb54442d18ull, 0x3fd45f4000000000ull, 0x3fe20de000000000ull},
+    {0xc05edd2f1a9fbe77ull, 0xbf8096f000000000ull, 0xfff8000000000000ull},
+    {0x0004000000000001ull, 0x7fefffc000000000ull, 0x5fefffa000000000ull},
+    {0x7fd0000000000001ull, 0x000fffe000000000ull, 0x1fffffa000000000ull},
+    {0x7fefffffffffffffull, 0x0004000000000000ull, 0x1ff0000000000000ull}};
+
+TEST(TEST_SUITE_NAME, EstimateX86) {
+  Estimator fpu;
+  fpu.SetupToX86();
+  for (const auto& [a, recip, rsqrt] : kEstimateX86F32) {
+    volatile u32 bits = a;  // Loaded at run time, since the compiler may quiet a constant signaling NaN.
+    ASSERT_EQ(std::bit_cast<u32>(fpu.RecipEstimateX86(std::bit_cast<f32>(static_cast<u32>(bits)))), recip) << a;
+    ASSERT_EQ(std::bit_cast<u32>(fpu.RsqrtEstimateX86(std::bit_cast<f32>(static_cast<u32>(bits)))), rsqrt) << a;
+  }
+  for (const auto& [a, recip, rsqrt] : kEstimateX86F64) {
+    ASSERT_EQ(std::bit_cast<u64>(fpu.RecipEstimateX86(std::bit_cast<f64>(a))), recip) << a;
+    ASSERT_EQ(std::bit_cast<u64>(fpu.RsqrtEstimateX86(std::bit_cast<f64>(a))), rsqrt) << a;
+  }
+  ASSERT_FALSE(fpu.invalid || fpu.division_by_zero || fpu.overflow || fpu.underflow || fpu.inexact);
+
+  // MXCSR.DAZ and MXCSR.FTZ.
+  fpu.flush_inputs = true;
+  fpu.flush_outputs = true;
+  ASSERT_EQ(std::bit_cast<u32>(fpu.RecipEstimateX86(std::bit_cast<f32>(0x00200001u))), 0x7f800000u);
+  ASSERT_EQ(std::bit_cast<u32>(fpu.RsqrtEstimateX86(std::bit_cast<f32>(0x80000001u))), 0xff800000u);
+  ASSERT_EQ(std::bit_cast<u32>(fpu.RecipEstimateX86(std::bit_cast<f32>(0xfe800001u))), 0x80000000u);
+  ASSERT_EQ(std::bit_cast<u32>(fpu.RecipEstimateX86(std::bit_cast<f32>(0x7e800000u))), 0x00800000u);
+}
+
+#if defined(__x86_64__)
+__attribute__((target("avx512f"))) u32 HostRecip14(u32 a, u32 mxcsr) {
+  _mm_setcsr(mxcsr);
+  const __m128 x = _mm_castsi128_ps(_mm_cvtsi32_si128(static_cast<i32>(a)));
+  const u32 result = static_cast<u32>(_mm_cvtsi128_si32(_mm_castps_si128(_mm_rcp14_ss(x, x))));
+  _mm_setcsr(0x1f80);
+  return result;
+}
+
+__attribute__((target("avx512f"))) u32 HostRsqrt14(u32 a, u32 mxcsr) {
+  _mm_setcsr(mxcsr);
+  const __m128 x = _mm_castsi128_ps(_mm_cvtsi32_si128(static_cast<i32>(a)));
+  const u32 result = static_cast<u32>(_mm_cvtsi128_si32(_mm_castps_si128(_mm_rsqrt14_ss(x, x))));
+  _mm_setcsr(0x1f80);
+  return result;
+}
+
+__attribute__((target("avx512f"))) u64 HostRecip14(u64 a, u32 mxcsr) {
+  _mm_setcsr(mxcsr);
+  const __m128d x = _mm_castsi128_pd(_mm_cvtsi64_si128(static_cast<i64>(a)));
+  const u64 result = static_cast<u64>(_mm_cvtsi128_si64(_mm_castpd_si128(_mm_rcp14_sd(x, x))));
+  _mm_setcsr(0x1f80);
+  return result;
+}
+
+__attribute__((target("avx512f"))) u64 HostRsqrt14(u64 a, u32 mxcsr) {
+  _mm_setcsr(mxcsr);
+  const __m128d x = _mm_castsi128_pd(_mm_cvtsi64_si128(static_cast<i64>(a)));
+  const u64 result = static_cast<u64>(_mm_cvtsi128_si64(_mm_castpd_si128(_mm_rsqrt14_sd(x, x))));
+  _mm_setcsr(0x1f80);
+  return result;
+}
+
+// Compares the x86 estimates against the host for every f32 fraction at the exponents with special cases, with and
+// without DAZ and FTZ. The estimates do not depend on the exponent otherwise. f64 gets random operands.
+TEST(TEST_SUITE_NAME, EstimateX86HostFpu) {
+  if (!__builtin_cpu_supports("avx512f"))
+    GTEST_SKIP() << "The host does not support AVX-512.";
+  std::mt19937_64 rng(kRngSeed);
+  Estimator fpu;
+  fpu.SetupToX86();
+  for (u32 flush = 0; flush < 2; ++flush) {
+    fpu.flush_inputs = fpu.flush_outputs = flush;
+    const u32 mxcsr = flush ? 0x9fc0 : 0x1f80;
+    for (u32 exp : {0, 1, 2, 126, 127, 128, 253, 254, 255}) {
+      for (u32 i = 0; i < (1u << 24); ++i) {
+        const u32 a = (i >> 23) << 31 | exp << 23 | (i & 0x7fffff);
+        ASSERT_EQ(std::bit_cast<u32>(fpu.RecipEstimateX86(std::bit_cast<f32>(a))), HostRecip14(a, mxcsr)) << a;
+        ASSERT_EQ(std::bit_cast<u32>(fpu.RsqrtEstimateX86(std::bit_cast<f32>(a))), HostRsqrt14(a, mxcsr)) << a;
+      }
+    }
+    for (i32 i = 0; i < kNumIterations * 10; ++i) {
+      u64 a = rng();
+      if (i % 4 == 1)
+        a &= 0x800fffffffffffffull;  // Subnormal.
+      else if (i % 4 == 2)
+        a |= 0x7fe0000000000000ull;  // Large, the reciprocal may be subnormal.
+      ASSERT_EQ(std::bit_cast<u64>(fpu.RecipEstimateX86(std::bit_cast<f64>(a))), HostRecip14(a, mxcsr)) << a;
+      ASSERT_EQ(std::bit_cast<u64>(fpu.RsqrtEstimateX86(std::bit_cast<f64>(a))), HostRsqrt14(a, mxcsr)) << a;
+    }
+  }
+}
+#endif
+
+TEST(TEST_SUITE_NAME, Fli) {
+  // See RISC-V Zfa: "fli.s", the constants as encodings.
+  constexpr u32 kFliF32[32] = {
+      0xbf800000, 0x00800000, 0x37800000, 0x38000000, 0x3b800000, 0x3c000000, 0x3d800000, 0x3e000000,
+      0x3e800000, 0x3ea00000, 0x3ec00000, 0x3ee00000, 0x3f000000, 0x3f200000, 0x3f400000, 0x3f600000,
+      0x3f800000, 0x3fa00000, 0x3fc00000, 0x3fe00000, 0x40000000, 0x40200000, 0x40400000, 0x40800000,
+      0x41000000, 0x41800000, 0x43000000, 0x43800000, 0x47000000, 0x47800000, 0x7f800000, 0x7fc00000};
+  static_assert(FloppyFloat::Fli<f64>(16) == 1.);
+  for (u32 i = 0; i < 32; ++i) {
+    ASSERT_EQ(std::bit_cast<u32>(FloppyFloat::Fli<f32>(i)), kFliF32[i]);
+    if (i != 1 && i != 31) {
+      ASSERT_EQ(FloppyFloat::Fli<f64>(i), static_cast<f64>(std::bit_cast<f32>(kFliF32[i])));
+      if (i != 29)
+        ASSERT_EQ(FloppyFloat::Fli<f16>(i), static_cast<f16>(std::bit_cast<f32>(kFliF32[i])));
+    }
+  }
+  ASSERT_EQ(std::bit_cast<u16>(FloppyFloat::Fli<f16>(1)), 0x0400);
+  ASSERT_EQ(std::bit_cast<u16>(FloppyFloat::Fli<f16>(2)), 0x0100);
+  ASSERT_EQ(std::bit_cast<u16>(FloppyFloat::Fli<f16>(29)), 0x7c00);
+  ASSERT_EQ(std::bit_cast<u16>(FloppyFloat::Fli<f16>(31)), 0x7e00);
+  ASSERT_EQ(std::bit_cast<u64>(FloppyFloat::Fli<f64>(1)), 0x0010000000000000ull);
+  ASSERT_EQ(std::bit_cast<u64>(FloppyFloat::Fli<f64>(31)), 0x7ff8000000000000ull);
+}
+
+// Reference: Truncation, then the remainder modulo 2^32 (both exact in f64).
+i32 F64ToI32ModularRef(f64 a, bool& invalid, bool& inexact) {
+  invalid = false;
+  inexact = false;
+  if (std::isnan(a) || std::isinf(a)) {
+    invalid = true;
+    return 0;
+  }
+  const f64 t = std::trunc(a);
+  inexact = t != a;
+  if (t < -2147483648. || t > 2147483647.) {
+    invalid = true;
+    inexact = false;
+  }
+  f64 m = std::fmod(t, 4294967296.);
+  if (m < 0)
+    m += 4294967296.;
+  return static_cast<i32>(static_cast<u32>(m));
+}
+
+TEST(TEST_SUITE_NAME, F64ToI32Modular) {
+  std::mt19937_64 rng(kRngSeed);
+  FloatRng<f64> float_rng(kRngSeed);
+  FloppyFloat fpu;
+  fpu.SetupToRiscv();
+  for (i32 i = 0; i < kNumIterations; ++i) {
+    f64 a = float_rng.Gen();
+    if (i % 2)  // All magnitudes up to 2^90.
+      a = std::ldexp(static_cast<f64>(rng() >> 11), static_cast<i32>(rng() % 144) - 53) * ((rng() & 1) ? -1. : 1.);
+    bool invalid, inexact;
+    const i32 expected = F64ToI32ModularRef(a, invalid, inexact);
+    fpu.ClearFlags();
+    ASSERT_EQ(fpu.F64ToI32Modular(a), expected) << a;
+    ASSERT_EQ(fpu.invalid, invalid) << a;
+    ASSERT_EQ(fpu.inexact, inexact) << a;
+  }
+
+  fpu.ClearFlags();
+  ASSERT_EQ(fpu.F64ToI32Modular(-2147483648.75), std::numeric_limits<i32>::min());
+  ASSERT_FALSE(fpu.invalid);
+  ASSERT_TRUE(fpu.inexact);
+  fpu.ClearFlags();
+  ASSERT_EQ(fpu.F64ToI32Modular(4294967295.5), -1);
+  ASSERT_TRUE(fpu.invalid);
+  ASSERT_FALSE(fpu.inexact);
+  ASSERT_EQ(fpu.F64ToI32Modular(0x1p80), 0);
+}
+
+TEST(TEST_SUITE_NAME, MoveHighPair) {
+  static_assert(FloppyFloat::MoveHigh(-2.) == 0xc0000000u);
+  static_assert(FloppyFloat::MovePairToF64(0, 0x3ff00000u) == 1.);
+  std::mt19937_64 rng(kRngSeed);
+  for (i32 i = 0; i < 1000; ++i) {
+    const u64 bits = rng();
+    const f64 a = std::bit_cast<f64>(bits);
+    ASSERT_EQ(FloppyFloat::MoveHigh(a), static_cast<u32>(bits >> 32));
+    ASSERT_EQ(std::bit_cast<u64>(FloppyFloat::MovePairToF64(static_cast<u32>(bits), static_cast<u32>(bits >> 32))), bits);
+    const u64 low = rng();
+    const f128 q = FloppyFloat::MovePairToF128(low, bits);
+    ASSERT_EQ(std::bit_cast<u128>(q), (static_cast<u128>(bits) << 64) | low);
+    ASSERT_EQ(FloppyFloat::MoveHigh(q), bits);
+  }
+}
+
+// Random f128 with the given biased exponent and random sign and significand.
+f128 GenF128(std::mt19937_64& rng, i32 exp) {
+  const u128 mant = ((static_cast<u128>(rng()) << 64) | rng()) & ((static_cast<u128>(1) << 112) - 1);
+  return std::bit_cast<f128>((static_cast<u128>(rng() & 1) << 127) | (static_cast<u128>(exp) << 112) | mant);
+}
+
+// The f128 fast paths against SoftFloat: FMAs with addends close to the product (including full cancellation) or far
+// from it and results near the overflow and underflow thresholds, and conversions to integers near their limits.
+TEST(TEST_SUITE_NAME, F128FastPaths) {
+  std::mt19937_64 rng(kRngSeed);
+  FloppyFloat fpu;
+  SoftFloat sfpu;
+  fpu.SetupToRiscv();
+  sfpu.SetupToRiscv();
+  const auto expect_same_flags = [&]() {
+    ASSERT_EQ(fpu.invalid, sfpu.invalid);
+    ASSERT_EQ(fpu.inexact, sfpu.inexact);
+    ASSERT_EQ(fpu.overflow, sfpu.overflow);
+    ASSERT_EQ(fpu.underflow, sfpu.underflow);
+  };
+  for (auto [sf_rm, rm] : rounding_modes) {
+    fpu.rounding_mode = sfpu.rounding_mode = rm;
+    for (i32 i = 0; i < kNumIterations / 10; ++i) {
+      const i32 spread = i % 3 == 0 ? 16383 : 64;
+      const i32 a_exp = static_cast<i32>(16383 + rng() % (2 * spread - 1) - spread + 1);
+      const f128 a = GenF128(rng, std::clamp(a_exp, 1, 32766));
+      const f128 b = GenF128(rng, static_cast<i32>(16383 + rng() % 129 - 64));
+      const i32 p_exp = static_cast<i32>(GetExponent(a) + GetExponent(b)) - 16383;
+      f128 c;
+      switch (i % 4) {
+        case 0:  // Cancels the product up to its last bits.
+          c = -sfpu.Mul(a, b);
+          c = std::bit_cast<f128>(std::bit_cast<u128>(c) + (rng() % 5) - 2);
+          break;
+        case 1:
+          c = GenF128(rng, std::clamp(static_cast<i32>(p_exp + rng() % 9 - 4), 1, 32766));
+          break;
+        case 2:
+          c = GenF128(rng, std::clamp(static_cast<i32>(p_exp + rng() % 601 - 300), 1, 32766));
+          break;
+        default:
+          c = (rng() & 1) ? -0.f128 : 0.f128;
+      }
+      fpu.ClearFlags();
+      sfpu.ClearFlags();
+      ASSERT_EQ(std::bit_cast<u128>(fpu.Fma(a, b, c)), std::bit_cast<u128>(sfpu.Fma(a, b, c))) << i;
+      expect_same_flags();
+
+      const f128 d = GenF128(rng, static_cast<i32>(16383 + rng() % 90 - 25));
+      fpu.ClearFlags();
+      sfpu.ClearFlags();
+      ASSERT_EQ(fpu.F128ToI32(d), sfpu.F128ToI32(d));
+      ASSERT_EQ(fpu.F128ToI64(d), sfpu.F128ToI64(d));
+      ASSERT_EQ(fpu.F128ToU32(d), sfpu.F128ToU32(d));
+      ASSERT_EQ(fpu.F128ToU64(d), sfpu.F128ToU64(d));
+      expect_same_flags();
+
+      const i64 n = static_cast<i64>(rng()) >> (rng() % 64);
+      const i32 n32 = static_cast<i32>(n);
+      ASSERT_EQ(std::bit_cast<u128>(fpu.I32ToF128(n32)), std::bit_cast<u128>(sfpu.I32ToF128(n32)));
+      ASSERT_EQ(std::bit_cast<u128>(fpu.U32ToF128(n32)), std::bit_cast<u128>(sfpu.U32ToF128(n32)));
+      ASSERT_EQ(std::bit_cast<u128>(fpu.I64ToF128(n)), std::bit_cast<u128>(sfpu.I64ToF128(n)));
+      ASSERT_EQ(std::bit_cast<u128>(fpu.U64ToF128(n)), std::bit_cast<u128>(sfpu.U64ToF128(n)));
+    }
+  }
+}
+
+// Reference for the fused Arm steps (c - a * b) / (halve ? 2 : 1): The product is exact in f128, the error of the
+// subtraction is recovered by TwoSum and turns the f128 result into round to odd, which is then rounded once to FT.
+template <typename FT>
+FT ArmStepRef(Vfpu::RoundingMode rm, FT a, FT b, f128 c, bool halve) {
+  FloppyFloat fpu;
+  fpu.rounding_mode = rm;
+  const f128 p = static_cast<f128>(a) * static_cast<f128>(b);
+  f128 s = c - p;
+  const f128 t = s - c;
+  const f128 error = (c - (s - t)) + (-p - t);
+  if (s == 0)
+    return rm == Vfpu::kRoundTowardNegative ? static_cast<FT>(-0.f) : static_cast<FT>(0.f);
+  if (error != 0 && !(std::bit_cast<u128>(s) & 1))
+    s = std::bit_cast<f128>(std::bit_cast<u128>(s) + (((error > 0) == (s > 0)) ? 1 : -1));
+  if (halve)
+    s *= 0.5f128;
+
+  if constexpr (std::is_same_v<FT, f64>) {
+    return fpu.F128ToF64(s);
+  } else if constexpr (std::is_same_v<FT, f32>) {
+    return fpu.F128ToF32(s);
+  } else {
+    fpu.rounding_mode = Vfpu::kRoundTowardZero;
+    f64 d = fpu.F128ToF64(s);
+    if (fpu.inexact)
+      d = std::bit_cast<f64>(std::bit_cast<u64>(d) | 1);
+    fpu.rounding_mode = rm;
+    return fpu.F64ToF16(d);
+  }
+}
+
+template <typename FT>
+void DoTestArmSteps() {
+  using UT = FloatToUint<FT>::type;
+  std::mt19937_64 rng(kRngSeed);
+  FloatRng<FT> float_rng(kRngSeed);
+  FloppyFloat fpu;
+  fpu.SetupToArm();
+  for (const auto& [unused, rm] : rounding_modes) {
+    fpu.rounding_mode = rm;
+    for (i32 i = 0; i < kNumIterations / 10; ++i) {
+      const FT a = float_rng.Gen();
+      FT b = float_rng.Gen();
+      if (i % 2)  // Close to the reciprocal (square root), so that the step cancels.
+        b = (i % 4 == 1) ? static_cast<FT>(1. / static_cast<f64>(a)) : static_cast<FT>(3. / static_cast<f64>(a));
+      if (IsNan(a) || IsNan(b) || IsInf(a) || IsInf(b))
+        continue;
+      FT expected = ArmStepRef(rm, a, b, 2.f128, false);
+      ASSERT_EQ(std::bit_cast<UT>(fpu.RecipStepArm(a, b)), std::bit_cast<UT>(expected)) << static_cast<f64>(a) << " " << static_cast<f64>(b);
+      expected = ArmStepRef(rm, a, b, 3.f128, true);
+      ASSERT_EQ(std::bit_cast<UT>(fpu.RsqrtStepArm(a, b)), std::bit_cast<UT>(expected)) << static_cast<f64>(a) << " " << static_cast<f64>(b);
+      ASSERT_EQ(std::bit_cast<UT>(fpu.MulxArm(a, b)), std::bit_cast<UT>(fpu.Mul(a, b)));
+      ASSERT_EQ(std::bit_cast<UT>(fpu.AbsDiff(a, b)),
+                std::bit_cast<UT>(static_cast<UT>(std::bit_cast<UT>(fpu.Sub(a, b)) & ~SignMask<FT>())));
+    }
+  }
+}
+
+TEST(TEST_SUITE_NAME, ArmSteps) {
+  DoTestArmSteps<f16>();
+  DoTestArmSteps<f32>();
+  DoTestArmSteps<f64>();
+
+  // Special cases of the Arm pseudocode: 0 * inf is exact, infinities keep the sign of -a * b.
+  constexpr f32 kInf = std::numeric_limits<f32>::infinity();
+  FloppyFloat fpu;
+  fpu.SetupToArm();
+  ASSERT_EQ(fpu.MulxArm(-0.f, kInf), -2.f);
+  ASSERT_EQ(fpu.MulxArm(kInf, 0.f), 2.f);
+  ASSERT_EQ(fpu.RecipStepArm(-0.f, kInf), 2.f);
+  ASSERT_EQ(fpu.RsqrtStepArm(kInf, -0.f), 1.5f);
+  ASSERT_FALSE(fpu.invalid);
+  ASSERT_EQ(fpu.RecipStepArm(kInf, 2.f), -kInf);
+  ASSERT_EQ(fpu.RsqrtStepArm(-kInf, 2.f), kInf);
+  ASSERT_EQ(fpu.RsqrtStepArm(1.5, 2.), 0.);
+  ASSERT_EQ(std::bit_cast<u32>(fpu.AbsDiff(1.f, std::numeric_limits<f32>::quiet_NaN())), 0x7fc00000u);
+  ASSERT_FALSE(fpu.invalid || fpu.inexact || fpu.overflow || fpu.underflow);
+  ASSERT_EQ(fpu.RsqrtStepArm(std::numeric_limits<f64>::max(), -1.5), std::numeric_limits<f64>::max() * 0.75);
+  ASSERT_FALSE(fpu.overflow);
+  fpu.MulxArm(std::numeric_limits<f64>::max(), 2.);
+  ASSERT_TRUE(fpu.overflow);
+
+  // The negation of a keeps an f16 signaling NaN signaling.
+  volatile u16 snan_bits = 0x7c01;
+  const f16 snan = std::bit_cast<f16>(static_cast<u16>(snan_bits));
+  const f16 one = static_cast<f16>(1.f);
+  fpu.ClearFlags();
+  fpu.RecipStepArm(snan, one);
+  ASSERT_TRUE(fpu.invalid);
+  fpu.ClearFlags();
+  fpu.RsqrtStepArm(snan, one);
+  ASSERT_TRUE(fpu.invalid);
+}
+
+TEST(TEST_SUITE_NAME, F64ToI32Js) {
+  FloppyFloat fpu;
+  fpu.SetupToArm();
+  bool z;
+  ASSERT_EQ(fpu.F64ToI32Js(-3., z), -3);
+  ASSERT_TRUE(z);
+  ASSERT_EQ(fpu.F64ToI32Js(-0., z), 0);
+  ASSERT_FALSE(z);
+  ASSERT_FALSE(fpu.inexact);
+  ASSERT_EQ(fpu.F64ToI32Js(2.5, z), 2);
+  ASSERT_FALSE(z);
+  ASSERT_TRUE(fpu.inexact);
+  ASSERT_EQ(fpu.F64ToI32Js(4294967298., z), 2);
+  ASSERT_FALSE(z);
+  ASSERT_TRUE(fpu.invalid);
+  fpu.ClearFlags();
+  ASSERT_EQ(fpu.F64ToI32Js(std::numeric_limits<f64>::quiet_NaN(), z), 0);
+  ASSERT_FALSE(z);
+  ASSERT_TRUE(fpu.invalid);
+}
+
+template <typename IT>
+IT F128ToIntRef(SoftFloat& sf, f128 a) {
+  if constexpr (std::is_same_v<IT, i32>)
+    return sf.F128ToI32(a);
+  else if constexpr (std::is_same_v<IT, i64>)
+    return sf.F128ToI64(a);
+  else if constexpr (std::is_same_v<IT, u32>)
+    return sf.F128ToU32(a);
+  else
+    return sf.F128ToU64(a);
+}
+
+// a / 2^fbits rounded once by SoftFloat. f16 goes through f64 rounded to odd, as there is no f128 to f16 conversion.
+template <typename FT>
+FT FixedToFRef(SoftFloat& sf, f128 exact) {
+  if constexpr (std::is_same_v<FT, f16>) {
+    SoftFloat truncating = sf;
+    truncating.rounding_mode = Vfpu::kRoundTowardZero;
+    truncating.ClearFlags();
+    f64 odd = truncating.F128ToF64(exact);
+    if (truncating.inexact)
+      odd = std::bit_cast<f64>(std::bit_cast<u64>(odd) | 1ull);
+    return sf.F64ToF16(odd);
+  } else if constexpr (std::is_same_v<FT, f32>) {
+    return sf.F128ToF32(exact);
+  } else {
+    return sf.F128ToF64(exact);
+  }
+}
+
+// The scaling by 2^fbits is exact in f128, so that SoftFloat's f128 conversions serve as the reference.
+template <typename FT, typename IT>
+void DoTestFixedPoint() {
+  using UT = FloatToUint<FT>::type;
+  constexpr size_t kSize = 150;  // Two full blocks and a remainder.
+  FloatRng<FT> float_rng(kRngSeed);
+  std::mt19937_64 rng(kRngSeed);
+  std::vector<FT> floats(kSize), float_results(kSize);
+  std::vector<IT> ints(kSize), int_results(kSize);
+  for (const bool arm : {true, false}) {
+    for (const auto& [unused, rm] : rounding_modes) {
+      for (i32 iteration = 0; iteration < 40; ++iteration) {
+        const u32 fbits = static_cast<u32>(rng() % (NumBits<IT>() + 1));
+        for (size_t i = 0; i < kSize; ++i) {
+          const FT a = float_rng.Gen();
+          floats[i] = (i % 7) ? static_cast<FT>(std::ldexp(static_cast<f64>(a), -static_cast<i32>(rng() % 16))) : a;
+          ints[i] = static_cast<IT>(rng() >> (rng() % 64));
+        }
+        if (iteration % 2)  // Whole blocks without out-of-range or rounded values take the fast paths.
+          for (size_t i = 0; i < kSize; ++i) {
+            floats[i] = static_cast<FT>(static_cast<f64>(i % 64) / 8.);
+            ints[i] = static_cast<IT>(i % 64);
+          }
+        FloppyFloat fpu, batch_fpu;
+        SoftFloat sf;
+        if (arm) {
+          fpu.SetupToArm();
+          batch_fpu.SetupToArm();
+          sf.SetupToArm();
+        } else {
+          fpu.SetupToRiscv();
+          batch_fpu.SetupToRiscv();
+          sf.SetupToRiscv();
+        }
+        fpu.rounding_mode = rm;
+        batch_fpu.rounding_mode = rm;
+        sf.rounding_mode = rm;
+        const f128 scale = static_cast<f128>(std::ldexp(1., static_cast<i32>(fbits)));
+
+        for (size_t i = 0; i < kSize; ++i) {
+          fpu.ClearFlags();
+          sf.ClearFlags();
+          const IT result = fpu.FToFixed<FT, IT>(floats[i], fbits);
+          const IT expected = F128ToIntRef<IT>(sf, static_cast<f128>(floats[i]) * scale);
+          ASSERT_EQ(result, expected) << static_cast<f64>(floats[i]) << " " << fbits;
+          ASSERT_EQ(fpu.invalid, sf.invalid);
+          ASSERT_EQ(fpu.inexact, sf.inexact);
+        }
+        for (size_t i = 0; i < kSize; ++i) {
+          fpu.ClearFlags();
+          sf.ClearFlags();
+          const FT result = fpu.FixedToF<FT, IT>(ints[i], fbits);
+          const FT expected = FixedToFRef<FT>(sf, static_cast<f128>(ints[i]) / scale);
+          ASSERT_EQ(std::bit_cast<UT>(result), std::bit_cast<UT>(expected)) << ints[i] << " " << fbits;
+          ASSERT_EQ(fpu.overflow, sf.overflow);
+          ASSERT_EQ(fpu.underflow, sf.underflow);
+          ASSERT_EQ(fpu.inexact, sf.inexact);
+        }
+
+        // The batches match the scalar conversions, including the accumulated flags.
+        fpu.ClearFlags();
+        batch_fpu.ClearFlags();
+        batch_fpu.FToFixedBatch(int_results.data(), floats.data(), fbits, kSize);
+        for (size_t i = 0; i < kSize; ++i)
+          ASSERT_EQ(int_results[i], (fpu.FToFixed<FT, IT>(floats[i], fbits)));
+        batch_fpu.FixedToFBatch(float_results.data(), ints.data(), fbits, kSize);
+        for (size_t i = 0; i < kSize; ++i)
+          ASSERT_EQ(std::bit_cast<UT>(float_results[i]), std::bit_cast<UT>(fpu.FixedToF<FT, IT>(ints[i], fbits)));
+        ASSERT_EQ(batch_fpu.invalid, fpu.invalid);
+        ASSERT_EQ(batch_fpu.overflow, fpu.overflow);
+        ASSERT_EQ(batch_fpu.underflow, fpu.underflow);
+        ASSERT_EQ(batch_fpu.inexact, fpu.inexact);
+      }
+    }
+  }
+}
+
+TEST(TEST_SUITE_NAME, FixedPoint) {
+  DoTestFixedPoint<f16, i32>();
+  DoTestFixedPoint<f16, u64>();
+  DoTestFixedPoint<f32, i32>();
+  DoTestFixedPoint<f32, u32>();
+  DoTestFixedPoint<f32, i64>();
+  DoTestFixedPoint<f64, i32>();
+  DoTestFixedPoint<f64, i64>();
+  DoTestFixedPoint<f64, u64>();
+
+  // Q15 and Q31 with the saturation of Arm.
+  FloppyFloat fpu;
+  fpu.SetupToArm();
+  fpu.rounding_mode = Vfpu::kRoundTowardZero;
+  ASSERT_EQ((fpu.FToFixed<f32, i32>(0.5f, 15)), 16384);
+  ASSERT_EQ((fpu.FToFixed<f32, i32>(-1.f, 31)), std::numeric_limits<i32>::min());
+  ASSERT_FALSE(fpu.invalid);
+  ASSERT_EQ((fpu.FToFixed<f32, i32>(1.f, 31)), std::numeric_limits<i32>::max());
+  ASSERT_TRUE(fpu.invalid);
+  ASSERT_EQ(static_cast<f64>(fpu.FixedToF<f16, i32>(1, 24)), 0x1p-24);
+  ASSERT_THROW((fpu.FToFixed<f32, i32>(1.f, 33)), std::runtime_error);
+}
+
+template <typename FT>
+void DoTestArmBatch() {
+  using UT = FloatToUint<FT>::type;
+  std::mt19937_64 rng(kRngSeed);
+  FloatRng<FT> float_rng(kRngSeed);
+  constexpr std::size_t kSize = 1000;
+  std::vector<FT> a(kSize), b(kSize), result(kSize);
+  const UT subnormal_mask = SignMask<FT>() | static_cast<UT>((UT{1} << NumSignificandBits<FT>()) - 1u);
+
+  for (const auto op :
+       {FloppyFloat::kMulxArm, FloppyFloat::kRecipStepArm, FloppyFloat::kRsqrtStepArm, FloppyFloat::kAbsDiff}) {
+    for (const auto& [unused, rm] : rounding_modes) {
+      for (const bool flush : {false, true}) {
+        for (std::size_t j = 0; j < kSize; ++j) {
+          a[j] = float_rng.Gen();
+          b[j] = (j % 8 == 0) ? std::bit_cast<FT>(static_cast<UT>(static_cast<UT>(rng()) & subnormal_mask))
+                              : float_rng.Gen();
+        }
+        FloppyFloat batch;
+        FloppyFloat scalar;
+        batch.SetupToArm();
+        scalar.SetupToArm();
+        batch.rounding_mode = rm;
+        scalar.rounding_mode = rm;
+        // FPCR.FZ and FPCR.FZ16.
+        batch.flush_inputs = batch.flush_inputs_f16 = batch.flush_outputs = batch.flush_outputs_f16 = flush;
+        scalar.flush_inputs = scalar.flush_inputs_f16 = scalar.flush_outputs = scalar.flush_outputs_f16 = flush;
+        batch.ArmBatch(op, result.data(), a.data(), b.data(), kSize);
+        for (std::size_t j = 0; j < kSize; ++j) {
+          FT expected;
+          if (op == FloppyFloat::kMulxArm)
+            expected = scalar.MulxArm(a[j], b[j]);
+          else if (op == FloppyFloat::kRecipStepArm)
+            expected = scalar.RecipStepArm(a[j], b[j]);
+          else if (op == FloppyFloat::kRsqrtStepArm)
+            expected = scalar.RsqrtStepArm(a[j], b[j]);
+          else
+            expected = scalar.AbsDiff(a[j], b[j]);
+          ASSERT_EQ(std::bit_cast<UT>(result[j]), std::bit_cast<UT>(expected));
+        }
+        ASSERT_EQ(batch.invalid, scalar.invalid);
+        ASSERT_EQ(batch.overflow, scalar.overflow);
+        ASSERT_EQ(batch.underflow, scalar.underflow);
+        ASSERT_EQ(batch.inexact, scalar.inexact);
+        ASSERT_EQ(batch.input_denormal, scalar.input_denormal);
+      }
+    }
+  }
+}
+
+TEST(TEST_SUITE_NAME, ArmBatch) {
+  DoTestArmBatch<f16>();
+  DoTestArmBatch<f32>();
+  DoTestArmBatch<f64>();
+}
+
+template <typename FT>
+void DoTestAvx512GetExpGetMant() {
+  using UT = FloatToUint<FT>::type;
+  FloatRng<FT> float_rng(kRngSeed);
+  Avx512 fpu;
+  fpu.SetupToX86();
+  for (i32 i = 0; i < kNumIterations; ++i) {
+    const FT a = float_rng.Gen();
+    if (IsNan(a) || IsInf(a) || IsZero(a))
+      continue;
+    const f64 value = static_cast<f64>(a);
+    ASSERT_EQ(static_cast<f64>(fpu.GetExp(a)), static_cast<f64>(std::ilogb(value)));
+    i32 exp;
+    const f64 mant = std::fabs(std::frexp(value, &exp)) * 2.;  // In [1, 2).
+    exp -= 1;
+    const f64 expected[4] = {mant, (exp & 1) ? mant / 2. : mant, mant / 2., mant >= 1.5 ? mant / 2. : mant};
+    for (u8 interval = 0; interval < 4; ++interval) {
+      ASSERT_EQ(static_cast<f64>(fpu.GetMant(a, interval)), std::copysign(expected[interval], value));
+      ASSERT_EQ(static_cast<f64>(fpu.GetMant(a, interval | 0x4)), expected[interval]);
+    }
+  }
+  ASSERT_FALSE(fpu.invalid || fpu.inexact || fpu.underflow || fpu.overflow);
+
+  constexpr FT kInf = std::numeric_limits<FT>::infinity();
+  ASSERT_EQ(fpu.GetExp(static_cast<FT>(-0.f)), -kInf);
+  ASSERT_EQ(fpu.GetExp(-kInf), kInf);
+  ASSERT_EQ(static_cast<f64>(fpu.GetExp(std::numeric_limits<FT>::denorm_min())),
+            static_cast<f64>(1 - Bias<FT>() - NumSignificandBits<FT>()));
+  ASSERT_EQ(static_cast<f64>(fpu.GetMant(static_cast<FT>(-0.f), 0x2)), -1.);
+  ASSERT_EQ(static_cast<f64>(fpu.GetMant(-kInf, 0x4)), 1.);
+  ASSERT_FALSE(fpu.invalid);
+  ASSERT_TRUE(IsNan(fpu.GetMant(static_cast<FT>(-0.f), 0x8)));
+  ASSERT_TRUE(fpu.invalid);
+  fpu.ClearFlags();
+  ASSERT_EQ(static_cast<f64>(fpu.GetMant(static_cast<FT>(0.f), 0x8)), 1.);
+  const UT snan = std::bit_cast<UT>(kInf) | 1;
+  ASSERT_EQ(std::bit_cast<UT>(fpu.GetExp(std::bit_cast<FT>(snan))), std::bit_cast<UT>(SetQuietBit(std::bit_cast<FT>(snan))));
+  ASSERT_TRUE(fpu.invalid);
+}
+
+TEST(TEST_SUITE_NAME, Avx512GetExpGetMant) {
+  DoTestAvx512GetExpGetMant<f16>();
+  DoTestAvx512GetExpGetMant<f32>();
+  DoTestAvx512GetExpGetMant<f64>();
+}
+
+template <typename FT>
+void DoTestAvx512ScaleF(i32 max_scale) {
+  using UT = FloatToUint<FT>::type;
+  std::mt19937_64 rng(kRngSeed);
+  std::uniform_int_distribution<i32> scale_dist(-max_scale, max_scale);
+  FloatRng<FT> float_rng(kRngSeed);
+  for (const auto& [unused, rm] : rounding_modes) {
+    Avx512 fpu;
+    FloppyFloat ref;
+    fpu.SetupToX86();
+    ref.SetupToX86();
+    fpu.rounding_mode = rm;
+    ref.rounding_mode = rm;
+    for (i32 i = 0; i < kNumIterations / 5; ++i) {
+      const FT a = float_rng.Gen();
+      if (IsNan(a) || IsInf(a))
+        continue;
+      const i32 n = scale_dist(rng);
+      const FT b = static_cast<FT>(n + ((i & 1) ? 0.25 : 0.));
+      const f128 scaled = static_cast<f128>(a) * std::bit_cast<f128>(static_cast<u128>(n + 16383) << 112);  // Exact.
+      FT expected;
+      if constexpr (std::is_same_v<FT, f64>)
+        expected = ref.F128ToF64(scaled);
+      else if constexpr (std::is_same_v<FT, f32>)
+        expected = ref.F128ToF32(scaled);
+      else
+        expected = ref.F64ToF16(static_cast<f64>(scaled));  // Exact in f64 for the tested range.
+      ASSERT_EQ(std::bit_cast<UT>(fpu.ScaleF(a, b)), std::bit_cast<UT>(expected)) << static_cast<f64>(a) << " " << n;
+      ASSERT_EQ(fpu.overflow, ref.overflow);
+      ASSERT_EQ(fpu.underflow, ref.underflow);
+      ASSERT_EQ(fpu.inexact, ref.inexact);
+    }
+  }
+
+  constexpr FT kInf = std::numeric_limits<FT>::infinity();
+  const FT qnan = std::numeric_limits<FT>::quiet_NaN();
+  Avx512 fpu;
+  fpu.SetupToX86();
+  ASSERT_EQ(fpu.ScaleF(static_cast<FT>(-3.f), kInf), -kInf);
+  ASSERT_EQ(static_cast<f64>(fpu.ScaleF(static_cast<FT>(-3.f), -kInf)), -0.);
+  ASSERT_TRUE(std::signbit(fpu.ScaleF(static_cast<FT>(-3.f), -kInf)));
+  ASSERT_EQ(fpu.ScaleF(qnan, kInf), kInf);
+  ASSERT_FALSE(fpu.invalid);
+  ASSERT_TRUE(IsNan(fpu.ScaleF(static_cast<FT>(0.f), kInf)));
+  ASSERT_TRUE(fpu.invalid);
+  fpu.ClearFlags();
+  ASSERT_TRUE(IsNan(fpu.ScaleF(kInf, -kInf)));
+  ASSERT_TRUE(fpu.invalid);
+}
+
+TEST(TEST_SUITE_NAME, Avx512ScaleF) {
+  DoTestAvx512ScaleF<f16>(64);
+  DoTestAvx512ScaleF<f32>(400);
+  DoTestAvx512ScaleF<f64>(2200);
+}
+
+template <typename FT>
+void DoTestAvx512RndScaleReduce() {
+  using UT = FloatToUint<FT>::type;
+  constexpr int kHostRoundingModes[4] = {FE_TONEAREST, FE_DOWNWARD, FE_UPWARD, FE_TOWARDZERO};
+  constexpr Vfpu::RoundingMode kRoundingModes[4] = {Vfpu::kRoundTiesToEven, Vfpu::kRoundTowardNegative,
+                                                     Vfpu::kRoundTowardPositive, Vfpu::kRoundTowardZero};
+  std::mt19937_64 rng(kRngSeed);
+  FloatRng<FT> float_rng(kRngSeed);
+  Avx512 fpu;
+  FloppyFloat ref;
+  fpu.SetupToX86();
+  for (i32 i = 0; i < kNumIterations; ++i) {
+    FT a = float_rng.Gen();
+    if (IsNan(a) || IsInf(a))
+      continue;
+    const u8 imm8 = static_cast<u8>(rng()) & 0xfb;
+    const i32 m = imm8 >> 4;
+    if (i & 1)  // Close to a multiple of 2^-m.
+      a = static_cast<FT>(static_cast<f64>(a) / static_cast<f64>(std::numeric_limits<FT>::max()) * 64.);
+
+    const f64 scale = std::ldexp(1., m);
+    f64 rounded = static_cast<f64>(a);
+    if (std::fabs(rounded) < std::ldexp(1., NumSignificandBits<FT>() - m)) {
+      std::fesetround(kHostRoundingModes[imm8 & 0x3]);
+      rounded = std::nearbyint(rounded * scale) / scale;
+      std::fesetround(FE_TONEAREST);
+    }
+    const bool rounding_inexact = rounded != static_cast<f64>(a);
+
+    fpu.ClearFlags();
+    ASSERT_EQ(static_cast<f64>(fpu.RndScale(a, imm8)), rounded) << static_cast<f64>(a) << " " << static_cast<u32>(imm8);
+    ASSERT_EQ(fpu.inexact, rounding_inexact && !(imm8 & 0x8));
+
+    ref.ClearFlags();
+    ref.rounding_mode = kRoundingModes[imm8 & 0x3];
+    const FT expected = ref.Sub(a, static_cast<FT>(rounded));
+    fpu.ClearFlags();
+    const FT reduced = fpu.Reduce(a, imm8);
+    ASSERT_EQ(std::bit_cast<UT>(reduced), std::bit_cast<UT>(expected)) << static_cast<f64>(a) << " " << static_cast<u32>(imm8);
+    if (!(imm8 & 0x8))
+      ASSERT_EQ(fpu.inexact, rounding_inexact || ref.inexact);
+  }
+  ASSERT_EQ(static_cast<f64>(fpu.Reduce(-std::numeric_limits<FT>::infinity(), 0)), 0.);
+}
+
+TEST(TEST_SUITE_NAME, Avx512RndScaleReduce) {
+  DoTestAvx512RndScaleReduce<f16>();
+  DoTestAvx512RndScaleReduce<f32>();
+  DoTestAvx512RndScaleReduce<f64>();
+}
+
+TEST(TEST_SUITE_NAME, Avx512Range) {
+  Avx512 fpu;
+  fpu.SetupToX86();
+  FloatRng<f64> float_rng(kRngSeed);
+  for (i32 i = 0; i < kNumIterations; ++i) {
+    const f64 a = float_rng.Gen();
+    const f64 b = (i & 1) ? -a : float_rng.Gen();
+    if (IsNan(a) || IsNan(b))
+      continue;
+    const f64 min = (a == b) ? (std::signbit(a) ? a : b) : std::min(a, b);
+    const f64 max = (a == b) ? (std::signbit(a) ? b : a) : std::max(a, b);
+    const f64 min_abs = std::fabs(a) == std::fabs(b) ? min : (std::fabs(a) < std::fabs(b) ? a : b);
+    const f64 max_abs = std::fabs(a) == std::fabs(b) ? max : (std::fabs(a) < std::fabs(b) ? b : a);
+    const f64 selected[4] = {min, max, min_abs, max_abs};
+    for (u8 op = 0; op < 4; ++op) {
+      ASSERT_EQ(std::bit_cast<u64>(fpu.Range(a, b, op)), std::bit_cast<u64>(std::copysign(selected[op], a)));
+      ASSERT_EQ(std::bit_cast<u64>(fpu.Range(a, b, op | 0x4)), std::bit_cast<u64>(selected[op]));
+      ASSERT_EQ(fpu.Range(a, b, op | 0x8), std::fabs(selected[op]));
+      ASSERT_EQ(fpu.Range(a, b, op | 0xc), -std::fabs(selected[op]));
+    }
+  }
+  ASSERT_FALSE(fpu.invalid);
+
+  const f32 qnan = std::numeric_limits<f32>::quiet_NaN();
+  volatile u32 snan_bits = 0x7f800001u;
+  const f32 snan = std::bit_cast<f32>(snan_bits);
+  ASSERT_EQ(fpu.Range(qnan, -2.f, 0x5), -2.f);
+  ASSERT_EQ(fpu.Range(-2.f, qnan, 0x4), -2.f);
+  ASSERT_FALSE(fpu.invalid);
+  ASSERT_EQ(std::bit_cast<u32>(fpu.Range(1.f, snan, 0x4)), 0x7fc00001u);
+  ASSERT_TRUE(fpu.invalid);
+}
+
+TEST(TEST_SUITE_NAME, Avx512FixupImm) {
+  Avx512 fpu;
+  fpu.SetupToX86();
+  constexpr f64 kInf = std::numeric_limits<f64>::infinity();
+  const f64 qnan = std::numeric_limits<f64>::quiet_NaN();
+  // Tokens (QNaN, SNaN, zero, +1, -inf, +inf, negative, positive) to responses (a, QNaN(a), +0, pi/2, +inf, -inf,
+  // -1, keep dst).
+  constexpr u64 kTable = 0x0945'd821;
+  ASSERT_TRUE(IsNan(fpu.FixupImm(3., qnan, kTable, 0)));
+  ASSERT_EQ(fpu.FixupImm(3., -0., kTable, 0), 0.);
+  ASSERT_FALSE(std::signbit(fpu.FixupImm(3., -0., kTable, 0)));
+  ASSERT_EQ(fpu.FixupImm(3., 1., kTable, 0), 1.5707963267948966);
+  ASSERT_EQ(fpu.FixupImm(3., -kInf, kTable, 0), kInf);
+  ASSERT_EQ(fpu.FixupImm(3., kInf, kTable, 0), -kInf);
+  ASSERT_EQ(fpu.FixupImm(3., -5., kTable, 0), -1.);
+  ASSERT_EQ(fpu.FixupImm(3., 5., kTable, 0), 3.);
+  ASSERT_FALSE(fpu.invalid || fpu.division_by_zero || fpu.inexact);
+  volatile u64 snan_bits = 0x7ff0000000000001ull;
+  ASSERT_EQ(std::bit_cast<u64>(fpu.FixupImm(3., std::bit_cast<f64>(snan_bits), kTable, 0)), 0x7ff8000000000001ull);
+  ASSERT_FALSE(fpu.invalid);
+  fpu.FixupImm(3., std::bit_cast<f64>(snan_bits), kTable, 0x10);
+  ASSERT_TRUE(fpu.invalid);
+  fpu.ClearFlags();
+  ASSERT_EQ(std::bit_cast<u32>(fpu.FixupImm(3.f, 0.f, 0x300u, 0x1)), 0xffc00000u);
+  ASSERT_TRUE(fpu.division_by_zero);
+  ASSERT_FALSE(fpu.invalid);
+  ASSERT_EQ(fpu.FixupImm(3.f, -2.f, 0xe000000u, 0x40), std::numeric_limits<f32>::max());
+  ASSERT_TRUE(fpu.invalid);
+}
+
+template <typename FT>
+void DoTestAvx512Batch() {
+  using UT = FloatToUint<FT>::type;
+  std::mt19937_64 rng(kRngSeed);
+  FloatRng<FT> float_rng(kRngSeed);
+  constexpr std::size_t kSize = 1000;
+  std::vector<FT> a(kSize), b(kSize), result(kSize);
+  const UT subnormal_mask = SignMask<FT>() | static_cast<UT>((UT{1} << NumSignificandBits<FT>()) - 1u);
+
+  for (const auto op : {Avx512::kGetExp, Avx512::kGetMant, Avx512::kScaleF, Avx512::kRndScale, Avx512::kReduce,
+                        Avx512::kRange}) {
+    if (std::is_same_v<FT, f16> && op == Avx512::kRange)
+      continue;
+    for (i32 i = 0; i < 8; ++i) {
+      const u8 imm8 = static_cast<u8>(rng());
+      for (std::size_t j = 0; j < kSize; ++j) {
+        a[j] = float_rng.Gen();
+        b[j] = static_cast<FT>(static_cast<f64>(float_rng.Gen()) / static_cast<f64>(std::numeric_limits<FT>::max()));
+        if (i < 4)  // Only normal operands in the first runs.
+          a[j] = std::bit_cast<FT>(static_cast<UT>((std::bit_cast<UT>(a[j]) & ~ExponentMask<FT>()) |
+                                                   (std::bit_cast<UT>(static_cast<FT>(1.f)) & ExponentMask<FT>())));
+      }
+      Avx512 batch;
+      Avx512 scalar;
+      batch.SetupToX86();
+      scalar.SetupToX86();
+      batch.Batch(op, result.data(), a.data(), b.data(), imm8, kSize);
+      for (std::size_t j = 0; j < kSize; ++j) {
+        FT expected;
+        if (op == Avx512::kGetExp)
+          expected = scalar.GetExp(a[j]);
+        else if (op == Avx512::kGetMant)
+          expected = scalar.GetMant(a[j], imm8);
+        else if (op == Avx512::kScaleF)
+          expected = scalar.ScaleF(a[j], b[j]);
+        else if (op == Avx512::kRndScale)
+          expected = scalar.RndScale(a[j], imm8);
+        else if (op == Avx512::kReduce)
+          expected = scalar.Reduce(a[j], imm8);
+        else if constexpr (!std::is_same_v<FT, f16>)
+          expected = scalar.Range(a[j], b[j], imm8);
+        ASSERT_EQ(std::bit_cast<UT>(result[j]), std::bit_cast<UT>(expected));
+      }
+      ASSERT_EQ(batch.invalid, scalar.invalid);
+      ASSERT_EQ(batch.overflow, scalar.overflow);
+      ASSERT_EQ(batch.underflow, scalar.underflow);
+      ASSERT_EQ(batch.inexact, scalar.inexact);
+    }
+  }
+}
+
+TEST(TEST_SUITE_NAME, Avx512Batch) {
+  DoTestAvx512Batch<f16>();
+  DoTestAvx512Batch<f32>();
+  DoTestAvx512Batch<f64>();
+}
+
+// GetExp, GetMant, ScaleF and Range raise DE for subnormal operands unless DAZ treats them as zero. The quiet ({sae})
+// variants leave all flags untouched.
+template <typename FT>
+void DoTestAvx512Denormals() {
+  using UT = FloatToUint<FT>::type;
+  constexpr FT kInf = std::numeric_limits<FT>::infinity();
+  const FT denorm = std::numeric_limits<FT>::denorm_min();
+  Avx512 fpu;
+  fpu.SetupToX86();
+  ASSERT_EQ(static_cast<f64>(fpu.GetExp(denorm)), static_cast<f64>(1 - Bias<FT>() - NumSignificandBits<FT>()));
+  ASSERT_TRUE(fpu.input_denormal);
+  fpu.ClearFlags();
+  ASSERT_EQ(static_cast<f64>(fpu.ScaleF(denorm, static_cast<FT>(1.f))), 2. * static_cast<f64>(denorm));
+  ASSERT_TRUE(fpu.input_denormal);
+  fpu.ClearFlags();
+  const FT snan = std::bit_cast<FT>(static_cast<UT>(std::bit_cast<UT>(kInf) | 1));
+  ASSERT_TRUE(IsNan(fpu.GetMant(snan, 0)));
+  ASSERT_FALSE(fpu.input_denormal);  // No operand is subnormal.
+  ASSERT_EQ(static_cast<f64>(fpu.RndScale(denorm, 0x2)), 1.);
+  ASSERT_EQ(static_cast<f64>(fpu.Reduce(denorm, 0x1)), static_cast<f64>(denorm));
+  ASSERT_FALSE(fpu.input_denormal);
+  ASSERT_TRUE(fpu.invalid && fpu.inexact);
+  fpu.ClearFlags();
+
+  // The quiet variants compute the same results.
+  ASSERT_EQ(static_cast<f64>((fpu.GetExp<FT, true>(denorm))), static_cast<f64>(fpu.GetExp(denorm)));
+  fpu.ClearFlags();
+  ASSERT_TRUE(IsNan(fpu.GetMant<FT, true>(-static_cast<FT>(1.f), 0x8)));
+  constexpr FT kMax = std::numeric_limits<FT>::max();
+  ASSERT_EQ((fpu.ScaleF<FT, Vfpu::kRoundTowardZero, true>(kMax, static_cast<FT>(1.f))), kMax);
+  ASSERT_EQ((fpu.ScaleF<FT, Vfpu::kRoundTowardPositive>(static_cast<FT>(1.f), -static_cast<FT>(60000.f))), denorm);
+  ASSERT_TRUE(fpu.underflow && fpu.inexact);
+  fpu.ClearFlags();
+  ASSERT_EQ(static_cast<f64>(fpu.RndScale<FT, true>(static_cast<FT>(1.5f), 0x0)), 2.);
+  ASSERT_EQ(static_cast<f64>(fpu.Reduce<FT, true>(static_cast<FT>(1.5f), 0x0)), -0.5);
+  ASSERT_FALSE(fpu.invalid || fpu.division_by_zero || fpu.overflow || fpu.underflow || fpu.inexact);
+  ASSERT_FALSE(fpu.input_denormal);
+
+  // DAZ: Subnormal operands are zeros, which don't raise DE.
+  fpu.flush_inputs = fpu.flush_inputs_f16 = true;
+  ASSERT_EQ(fpu.GetExp(denorm), -kInf);
+  ASSERT_EQ(static_cast<f64>(fpu.GetMant(-denorm, 0x0)), -1.);
+  ASSERT_EQ(std::bit_cast<UT>(fpu.ScaleF(-denorm, static_cast<FT>(2.f))), SignMask<FT>());
+  ASSERT_EQ(static_cast<f64>(fpu.ScaleF(static_cast<FT>(3.f), -denorm)), 3.);  // floor(-0) = 0, not -1.
+  ASSERT_EQ(static_cast<f64>(fpu.RndScale(denorm, 0x2)), 0.);
+  ASSERT_EQ(static_cast<f64>(fpu.Reduce(denorm, 0x1)), 0.);
+  ASSERT_FALSE(fpu.input_denormal || fpu.inexact);
+
+  // FTZ: Tiny results of ScaleF are zeros.
+  fpu.flush_outputs = fpu.flush_outputs_f16 = true;
+  ASSERT_EQ(std::bit_cast<UT>(fpu.ScaleF(-std::numeric_limits<FT>::min(), -static_cast<FT>(1.f))), SignMask<FT>());
+  ASSERT_TRUE(fpu.underflow && fpu.inexact);
+  fpu.ClearFlags();
+  ASSERT_EQ(fpu.ScaleF(std::numeric_limits<FT>::min(), static_cast<FT>(1.f)), 2 * std::numeric_limits<FT>::min());
+  ASSERT_FALSE(fpu.underflow || fpu.inexact);
+
+  if constexpr (!std::is_same_v<FT, f16>) {
+    fpu.flush_inputs = false;
+    ASSERT_EQ(fpu.Range(-denorm, static_cast<FT>(0.f), 0x4), -denorm);
+    ASSERT_TRUE(fpu.input_denormal);
+    fpu.ClearFlags();
+    ASSERT_EQ(fpu.FixupImm(static_cast<FT>(3.f), denorm, static_cast<UT>(0x9000'0000u), 0x41), -static_cast<FT>(1.f));
+    ASSERT_FALSE(fpu.invalid || fpu.division_by_zero || fpu.input_denormal);  // A positive value.
+    fpu.ClearFlags();
+    ASSERT_EQ((fpu.Range<FT, true>(-denorm, static_cast<FT>(0.f), 0x4)), -denorm);
+    ASSERT_FALSE(fpu.input_denormal);
+
+    fpu.flush_inputs = true;
+    ASSERT_EQ(std::bit_cast<UT>(fpu.Range(-denorm, static_cast<FT>(0.f), 0x4)), SignMask<FT>());  // -0 < +0.
+    ASSERT_EQ(fpu.FixupImm(static_cast<FT>(3.f), denorm, static_cast<UT>(0x0000'0a00u), 0x41), static_cast<FT>(1.f));
+    ASSERT_TRUE(fpu.division_by_zero && !fpu.invalid && !fpu.input_denormal);  // A zero.
+  }
+}
+
+TEST(TEST_SUITE_NAME, Avx512Denormals) {
+  DoTestAvx512Denormals<f16>();
+  DoTestAvx512Denormals<f32>();
+  DoTestAvx512Denormals<f64>();
+}
+
+template <typename FT>
+void DoTestRemainder() {
+  using UT = FloatToUint<FT>::type;
+  std::mt19937_64 rng(kRngSeed);
+  FloatRng<FT> float_rng(kRngSeed);
+  FloppyFloat fpu;
+  fpu.SetupToX86();
+  for (i32 i = 0; i < kNumIterations; ++i) {
+    const FT a = float_rng.Gen();
+    FT b = float_rng.Gen();
+    if (i & 1)  // Small divisors for large exponent differences.
+      b = static_cast<FT>(static_cast<f64>(b) / static_cast<f64>(std::numeric_limits<FT>::max()));
+    if (IsNan(a) || IsNan(b) || IsInf(a) || IsZero(b))
+      continue;
+    f64 expected = std::remainder(static_cast<f64>(a), static_cast<f64>(b));
+    expected = expected == 0. ? std::copysign(0., static_cast<f64>(a)) : expected;  // See Remainder.
+    ASSERT_EQ(std::bit_cast<UT>(fpu.Remainder(a, b)), std::bit_cast<UT>(static_cast<FT>(expected)))
+        << static_cast<f64>(a) << " " << static_cast<f64>(b);
+
+    // Repeated partial remainders yield the full remainder, and the quotient bits of the last step are those of the
+    // full quotient.
+    for (const bool round_to_nearest : {false, true}) {
+      FT partial = a;
+      u32 quotient;
+      bool incomplete;
+      i32 steps = 0;
+      do {
+        partial = fpu.PartialRemainder(partial, b, round_to_nearest, quotient, incomplete);
+        ++steps;
+      } while (incomplete);
+      ASSERT_LE(steps, (2 * Bias<FT>() + NumSignificandBits<FT>()) / 32 + 1);
+      if (round_to_nearest) {
+        i32 host_quotient;
+        ASSERT_EQ(std::bit_cast<UT>(partial), std::bit_cast<UT>(static_cast<FT>(
+                                                  std::remquo(static_cast<f64>(a), static_cast<f64>(b), &host_quotient))));
+        ASSERT_EQ(quotient, static_cast<u32>(std::abs(host_quotient)) & 0x7);
+      } else {
+        ASSERT_EQ(std::bit_cast<UT>(partial),
+                  std::bit_cast<UT>(static_cast<FT>(std::fmod(static_cast<f64>(a), static_cast<f64>(b)))));
+      }
+    }
+  }
+  ASSERT_FALSE(fpu.invalid || fpu.inexact || fpu.underflow || fpu.overflow || fpu.division_by_zero);
+
+  constexpr FT kInf = std::numeric_limits<FT>::infinity();
+  ASSERT_EQ(static_cast<f64>(fpu.Remainder(static_cast<FT>(-3.f), kInf)), -3.);
+  ASSERT_TRUE(std::signbit(fpu.Remainder(static_cast<FT>(-4.f), static_cast<FT>(2.f))));
+  ASSERT_EQ(static_cast<f64>(fpu.Remainder(static_cast<FT>(5.f), static_cast<FT>(2.f))), 1.);
+  ASSERT_EQ(static_cast<f64>(fpu.Remainder(static_cast<FT>(7.f), static_cast<FT>(2.f))), -1.);
+  ASSERT_FALSE(fpu.invalid);
+  ASSERT_TRUE(IsNan(fpu.Remainder(kInf, static_cast<FT>(2.f))));
+  ASSERT_TRUE(fpu.invalid);
+  fpu.ClearFlags();
+  ASSERT_TRUE(IsNan(fpu.Remainder(static_cast<FT>(2.f), static_cast<FT>(0.f))));
+  ASSERT_TRUE(fpu.invalid);
+}
+
+TEST(TEST_SUITE_NAME, Remainder) {
+  DoTestRemainder<f16>();
+  DoTestRemainder<f32>();
+  DoTestRemainder<f64>();
+
+  // The reduction is incomplete for exponent differences D of 64 or more: 2^100 is reduced by 3 * 2^(D - 32 - D % 32).
+  FloppyFloat fpu;
+  u32 quotient;
+  bool incomplete;
+  ASSERT_EQ(fpu.PartialRemainder(0x1p100, 3., false, quotient, incomplete), std::fmod(0x1p100, 3. * 0x1p64));
+  ASSERT_TRUE(incomplete);
+  ASSERT_EQ(fpu.PartialRemainder(10., 3., false, quotient, incomplete), 1.);
+  ASSERT_FALSE(incomplete);
+  ASSERT_EQ(quotient, 3u);
+  ASSERT_EQ(fpu.PartialRemainder(11., 3., true, quotient, incomplete), -1.);
+  ASSERT_EQ(quotient, 4u);
+}
+
+template <typename FT>
+void DoTestFusedNegations() {
+  using UT = FloatToUint<FT>::type;
+  FloatRng<FT> float_rng(kRngSeed);
+  for (const auto& [unused, rm] : rounding_modes) {
+    FloppyFloat fpu;
+    FloppyFloat ref;
+    fpu.SetupToRiscv();
+    ref.SetupToRiscv();
+    fpu.rounding_mode = rm;
+    ref.rounding_mode = rm;
+    for (i32 i = 0; i < kNumIterations / 10; ++i) {
+      const FT a = float_rng.Gen();
+      const FT b = float_rng.Gen();
+      FT c = float_rng.Gen();
+      if (i & 1)  // Cancellation.
+        c = static_cast<FT>(static_cast<f64>(a) * static_cast<f64>(b));
+      ASSERT_EQ(std::bit_cast<UT>(fpu.Fms(a, b, c)), std::bit_cast<UT>(ref.Fma(a, b, Negate(c))));
+      ASSERT_EQ(std::bit_cast<UT>(fpu.Fnma(a, b, c)), std::bit_cast<UT>(ref.Fma(Negate(a), b, c)));
+      ASSERT_EQ(std::bit_cast<UT>(fpu.Fnms(a, b, c)),
+                std::bit_cast<UT>(ref.Fma(Negate(a), b, Negate(c))));
+      ASSERT_EQ(fpu.invalid, ref.invalid);
+      ASSERT_EQ(fpu.overflow, ref.overflow);
+      ASSERT_EQ(fpu.underflow, ref.underflow);
+      ASSERT_EQ(fpu.inexact, ref.inexact);
+    }
+  }
+
+  // x86 propagates NaN operands without negating them.
+  const UT nan_bits = std::bit_cast<UT>(std::numeric_limits<FT>::quiet_NaN()) | 1;
+  const FT nan = std::bit_cast<FT>(nan_bits);
+  const FT one = static_cast<FT>(1.f);
+  FloppyFloat fpu;
+  fpu.SetupToX86();
+  ASSERT_EQ(std::bit_cast<UT>(fpu.Fms(one, one, nan)), nan_bits);
+  ASSERT_EQ(std::bit_cast<UT>(fpu.Fnma(nan, one, one)), nan_bits);
+  ASSERT_EQ(std::bit_cast<UT>(fpu.Fnms(one, nan, nan)), nan_bits);
+  ASSERT_FALSE(fpu.invalid);
+  ASSERT_EQ(static_cast<f64>(fpu.Fnms(static_cast<FT>(2.f), static_cast<FT>(3.f), one)), -7.);
+  volatile UT snan_bits = ExponentMask<FT>() | 1;
+  const FT snan = std::bit_cast<FT>(static_cast<UT>(snan_bits));
+  fpu.Fnms(snan, one, one);
+  ASSERT_TRUE(fpu.invalid);
+  fpu.SetupToRiscv();
+  ASSERT_EQ(std::bit_cast<UT>(fpu.Fms(one, one, nan)), std::bit_cast<UT>(std::numeric_limits<FT>::quiet_NaN()));
+}
+
+TEST(TEST_SUITE_NAME, FusedNegations) {
+  DoTestFusedNegations<f16>();
+  DoTestFusedNegations<f32>();
+  DoTestFusedNegations<f64>();
+}
+
+// The quiet variants return the same results as the regular ones and leave any pattern of flags untouched.
+template <typename FT, Vfpu::RoundingMode rm>
+void DoTestQuietArithmetic() {
+  using UT = FloatToUint<FT>::type;
+  FloatRng<FT> float_rng(kRngSeed);
+  std::mt19937 rng(kRngSeed);
+  FloppyFloat fpu;
+  FloppyFloat ref;
+  fpu.SetupToX86();
+  ref.SetupToX86();
+  for (i32 i = 0; i < kNumIterations / 20; ++i) {
+    FT a = float_rng.Gen();
+    const FT b = float_rng.Gen();
+    const FT c = float_rng.Gen();
+    if ((i & 1) && std::isnormal(static_cast<f64>(b)))  // Products close to the subnormal range.
+      a = static_cast<FT>(std::ldexp(static_cast<f64>(a) / std::ldexp(1., std::ilogb(static_cast<f64>(a))),
+                                     std::numeric_limits<FT>::min_exponent - 1 - std::ilogb(static_cast<f64>(b))));
+    const u32 flags = rng();
+    fpu.invalid = flags & 1;
+    fpu.division_by_zero = flags & 2;
+    fpu.overflow = flags & 4;
+    fpu.underflow = flags & 8;
+    fpu.inexact = flags & 16;
+    ref.ClearFlags();
+    ASSERT_EQ(std::bit_cast<UT>((fpu.Add<FT, rm, true>(a, b))), std::bit_cast<UT>((ref.Add<FT, rm>(a, b))));
+    ASSERT_EQ(std::bit_cast<UT>((fpu.Sub<FT, rm, true>(a, b))), std::bit_cast<UT>((ref.Sub<FT, rm>(a, b))));
+    ASSERT_EQ(std::bit_cast<UT>((fpu.Mul<FT, rm, true>(a, b))), std::bit_cast<UT>((ref.Mul<FT, rm>(a, b))));
+    ASSERT_EQ(std::bit_cast<UT>((fpu.Div<FT, rm, true>(a, b))), std::bit_cast<UT>((ref.Div<FT, rm>(a, b))));
+    ASSERT_EQ(std::bit_cast<UT>((fpu.Sqrt<FT, rm, true>(a))), std::bit_cast<UT>((ref.Sqrt<FT, rm>(a))));
+    ASSERT_EQ(std::bit_cast<UT>((fpu.Fma<FT, rm, true>(a, b, c))), std::bit_cast<UT>((ref.Fma<FT, rm>(a, b, c))));
+    ASSERT_EQ(std::bit_cast<UT>((fpu.Fms<FT, rm, true>(a, b, c))), std::bit_cast<UT>((ref.Fms<FT, rm>(a, b, c))));
+    ASSERT_EQ(std::bit_cast<UT>((fpu.Fnma<FT, rm, true>(a, b, c))), std::bit_cast<UT>((ref.Fnma<FT, rm>(a, b, c))));
+    ASSERT_EQ(std::bit_cast<UT>((fpu.Fnms<FT, rm, true>(a, b, c))), std::bit_cast<UT>((ref.Fnms<FT, rm>(a, b, c))));
+    ASSERT_EQ(fpu.invalid, static_cast<bool>(flags & 1));
+    ASSERT_EQ(fpu.division_by_zero, static_cast<bool>(flags & 2));
+    ASSERT_EQ(fpu.overflow, static_cast<bool>(flags & 4));
+    ASSERT_EQ(fpu.underflow, static_cast<bool>(flags & 8));
+    ASSERT_EQ(fpu.inexact, static_cast<bool>(flags & 16));
+  }
+}
+
+template <typename FT>
+void DoTestQuietArithmetic() {
+  DoTestQuietArithmetic<FT, Vfpu::kRoundTiesToEven>();
+  DoTestQuietArithmetic<FT, Vfpu::kRoundTiesToAway>();
+  DoTestQuietArithmetic<FT, Vfpu::kRoundTowardPositive>();
+  DoTestQuietArithmetic<FT, Vfpu::kRoundTowardNegative>();
+  DoTestQuietArithmetic<FT, Vfpu::kRoundTowardZero>();
+}
+
+TEST(TEST_SUITE_NAME, QuietArithmetic) {
+  DoTestQuietArithmetic<f16>();
+  DoTestQuietArithmetic<bf16>();
+  DoTestQuietArithmetic<f32>();
+  DoTestQuietArithmetic<f64>();
+}
+
+// The quiet conversions ({er}) as well as the quiet compares and x86 minimum/maximum operations ({sae}) return the
+// same results as the regular ones and leave any pattern of flags untouched.
+template <Vfpu::RoundingMode rm>
+void DoTestQuietConversionsAndCompares() {
+  FloatRng<f64> float_rng(kRngSeed);
+  std::mt19937 rng(kRngSeed);
+  std::mt19937_64 rng64(kRngSeed);
+  FloppyFloat fpu;
+  FloppyFloat ref;
+  fpu.SetupToX86();
+  ref.SetupToX86();
+  for (i32 i = 0; i < kNumIterations / 20; ++i) {
+    const f64 a = float_rng.Gen();
+    const f64 b = (i & 3) ? float_rng.Gen() : a;
+    const f32 a32 = static_cast<f32>(a);
+    const f32 b32 = static_cast<f32>(b);
+    const i64 n = static_cast<i64>(rng64()) >> (rng() % 64);
+    const u32 flags = rng();
+    fpu.invalid = flags & 1;
+    fpu.division_by_zero = flags & 2;
+    fpu.overflow = flags & 4;
+    fpu.underflow = flags & 8;
+    fpu.inexact = flags & 16;
+    ref.ClearFlags();
+    ASSERT_EQ(std::bit_cast<u32>((fpu.F64ToF32<rm, true>(a))), std::bit_cast<u32>((ref.F64ToF32<rm>(a))));
+    ASSERT_EQ(std::bit_cast<u16>((fpu.F64ToF16<rm, true>(a))), std::bit_cast<u16>((ref.F64ToF16<rm>(a))));
+    ASSERT_EQ((fpu.F64ToI32<rm, true>(a)), (ref.F64ToI32<rm>(a)));
+    ASSERT_EQ((fpu.F64ToU64<rm, true>(a)), (ref.F64ToU64<rm>(a)));
+    ASSERT_EQ((fpu.F32ToI64<rm, true>(a32)), (ref.F32ToI64<rm>(a32)));
+    ASSERT_EQ(std::bit_cast<u32>((fpu.I64ToF32<rm, true>(n))), std::bit_cast<u32>((ref.I64ToF32<rm>(n))));
+    ASSERT_EQ(std::bit_cast<u64>((fpu.U64ToF64<rm, true>(static_cast<u64>(n)))),
+              std::bit_cast<u64>((ref.U64ToF64<rm>(static_cast<u64>(n)))));
+    ASSERT_EQ((fpu.EqSignaling<f64, true>(a, b)), (ref.EqSignaling<f64>(a, b)));
+    ASSERT_EQ((fpu.LtQuiet<f64, true>(a, b)), (ref.LtQuiet<f64>(a, b)));
+    ASSERT_EQ((fpu.LeSignaling<f32, true>(a32, b32)), (ref.LeSignaling<f32>(a32, b32)));
+    ASSERT_EQ(std::bit_cast<u64>((fpu.Maxx86<f64, true>(a, b))), std::bit_cast<u64>((ref.Maxx86<f64>(a, b))));
+    ASSERT_EQ(std::bit_cast<u32>((fpu.Minx86<f32, true>(a32, b32))), std::bit_cast<u32>((ref.Minx86<f32>(a32, b32))));
+    const u8 imm8 = static_cast<u8>(rng() & 0x1f);
+    ASSERT_EQ(std::bit_cast<u64>((fpu.MinMaxAvx10<f64, true>(a, b, imm8))),
+              std::bit_cast<u64>((ref.MinMaxAvx10<f64>(a, b, imm8))));
+    ASSERT_EQ(fpu.invalid, static_cast<bool>(flags & 1));
+    ASSERT_EQ(fpu.division_by_zero, static_cast<bool>(flags & 2));
+    ASSERT_EQ(fpu.overflow, static_cast<bool>(flags & 4));
+    ASSERT_EQ(fpu.underflow, static_cast<bool>(flags & 8));
+    ASSERT_EQ(fpu.inexact, static_cast<bool>(flags & 16));
+  }
+}
+
+TEST(TEST_SUITE_NAME, QuietConversionsAndCompares) {
+  DoTestQuietConversionsAndCompares<Vfpu::kRoundTiesToEven>();
+  DoTestQuietConversionsAndCompares<Vfpu::kRoundTiesToAway>();
+  DoTestQuietConversionsAndCompares<Vfpu::kRoundTowardPositive>();
+  DoTestQuietConversionsAndCompares<Vfpu::kRoundTowardNegative>();
+  DoTestQuietConversionsAndCompares<Vfpu::kRoundTowardZero>();
+}
+
+// With FPCR.DN = 0, Arm propagates the first signaling NaN, otherwise the first NaN, with the addend of an FMA first.
+TEST(TEST_SUITE_NAME, ArmPropagateNan) {
+  FloppyFloat fpu;
+  SoftFloat sfpu;
+  fpu.SetupToArm();
+  sfpu.SetupToArm();
+  fpu.nan_propagation_scheme = Vfpu::kNanPropArm64;
+  sfpu.nan_propagation_scheme = Vfpu::kNanPropArm64;
+  volatile u32 snan_bits = 0x7f800001u;  // Loaded at run time, since the compiler may quiet a constant signaling NaN.
+  const f32 snan = std::bit_cast<f32>(static_cast<u32>(snan_bits));
+  const f32 qnan_a = std::bit_cast<f32>(0xffc00002u);
+  const f32 qnan_b = std::bit_cast<f32>(0x7fc00003u);
+  const f32 inf = std::numeric_limits<f32>::infinity();
+
+  ASSERT_EQ(std::bit_cast<u32>(fpu.Add<f32>(qnan_a, snan)), 0x7fc00001u);
+  ASSERT_EQ(std::bit_cast<u32>(fpu.Add<f32>(qnan_a, qnan_b)), 0xffc00002u);
+  ASSERT_EQ(std::bit_cast<u32>(fpu.Mul<f32>(1.f, qnan_b)), 0x7fc00003u);
+  ASSERT_EQ(std::bit_cast<u32>(fpu.Fma<f32>(qnan_a, 1.f, qnan_b)), 0x7fc00003u);
+  ASSERT_EQ(std::bit_cast<u32>(fpu.Fma<f32>(qnan_a, snan, qnan_b)), 0x7fc00001u);
+  fpu.ClearFlags();
+  ASSERT_EQ(std::bit_cast<u32>(fpu.Fma<f32>(inf, 0.f, qnan_b)), 0x7fc00000u);
+  ASSERT_TRUE(fpu.invalid);
+  ASSERT_EQ(std::bit_cast<u32>(fpu.MaximumNumber<f32>(qnan_a, 1.f)), std::bit_cast<u32>(1.f));
+  ASSERT_EQ(std::bit_cast<u32>(fpu.MaximumNumber<f32>(snan, 1.f)), 0x7fc00001u);
+  ASSERT_EQ(std::bit_cast<u32>(fpu.MinimumNumber<f32>(qnan_a, qnan_b)), 0xffc00002u);
+
+  // Conversions keep the sign and the upper bits of the payload.
+  ASSERT_EQ(std::bit_cast<u64>(fpu.F32ToF64(std::bit_cast<f32>(0xffc00123u))), 0xfff8002460000000ull);
+  fpu.ClearFlags();
+  volatile u64 snan_bits64 = 0x7ff4000000000000ull;
+  ASSERT_EQ(std::bit_cast<u16>(fpu.F64ToF16(std::bit_cast<f64>(static_cast<u64>(snan_bits64)))), 0x7f00u);
+  ASSERT_TRUE(fpu.invalid);
+
+  FloatRng<f32> float_rng(kRngSeed);
+  for (i32 i = 0; i < kNumIterations / 10; ++i) {
+    const f32 a = float_rng.Gen();
+    const f32 b = float_rng.Gen();
+    const f32 c = float_rng.Gen();
+    ASSERT_EQ(std::bit_cast<u32>(fpu.Sub<f32>(a, b)), std::bit_cast<u32>(sfpu.Sub<f32>(a, b)));
+    ASSERT_EQ(std::bit_cast<u32>(fpu.Fma<f32>(a, b, c)), std::bit_cast<u32>(sfpu.Fma<f32>(a, b, c)));
+    ASSERT_EQ(std::bit_cast<u16>(fpu.F32ToF16(a)), std::bit_cast<u16>(sfpu.F32ToF16(a)));
+  }
+}
+
+// Flushing is compared with the full operations on flushed operands, whose results are flushed if they underflow or
+// are subnormal. Without flushing, x86 still raises DE.
+template <typename FT>
+void DoTestFlushDenormals(bool x86, bool in, bool out) {
+  using UT = FloatToUint<FT>::type;
+  FloatRng<FT> float_rng(kRngSeed);
+  std::mt19937 rng(kRngSeed);
+  FloppyFloat fpu;
+  FloppyFloat ref;
+  if (x86) {
+    fpu.SetupToX86();
+    ref.SetupToX86();
+  } else {
+    fpu.SetupToArm();
+    ref.SetupToArm();
+  }
+  fpu.flush_inputs = fpu.flush_inputs_f16 = in;
+  fpu.flush_outputs = fpu.flush_outputs_f16 = out;
+  const auto subnormal = [&rng]() {
+    const UT mask = SignMask<FT>() | static_cast<UT>((UT{1} << NumSignificandBits<FT>()) - 1u);
+    return std::bit_cast<FT>(static_cast<UT>(static_cast<UT>(rng()) & mask));
+  };
+
+  for (i32 i = 0; i < kNumIterations / 20; ++i) {
+    FT a = float_rng.Gen();
+    FT b = (i % 5 == 1) ? subnormal() : float_rng.Gen();
+    const FT c = (i % 7 == 1) ? subnormal() : float_rng.Gen();
+    if ((i % 3 == 1) && std::isnormal(static_cast<f64>(a)) && std::isnormal(static_cast<f64>(b)))  // Tiny products.
+      a = static_cast<FT>(std::ldexp(static_cast<f64>(a) / std::ldexp(1., std::ilogb(static_cast<f64>(a))),
+                                     std::numeric_limits<FT>::min_exponent - 1 - std::ilogb(static_cast<f64>(b))));
+    const auto flush = [in](FT x) { return in ? FlushToZero(x) : x; };
+    fpu.rounding_mode = ref.rounding_mode = static_cast<Vfpu::RoundingMode>(i % 5);
+
+    const auto check = [&](FT result, FT expected, bool input_denormal) {
+      bool underflow = ref.underflow;
+      bool inexact = ref.inexact;
+      if (out && (ref.underflow || IsSubnormal(expected))) {
+        expected = std::copysign(static_cast<FT>(0.), expected);
+        underflow = true;
+        inexact = x86;
+      }
+      ASSERT_EQ(std::bit_cast<UT>(result), std::bit_cast<UT>(expected));
+      ASSERT_EQ(fpu.invalid, ref.invalid);
+      ASSERT_EQ(fpu.division_by_zero, ref.division_by_zero);
+      ASSERT_EQ(fpu.overflow, ref.overflow);
+      ASSERT_EQ(fpu.underflow, underflow);
+      ASSERT_EQ(fpu.inexact, inexact);
+      ASSERT_EQ(fpu.input_denormal, input_denormal);
+      fpu.ClearFlags();
+      ref.ClearFlags();
+    };
+    // x86 raises DE for subnormal operands unless DAZ flushes them or NaN operands take precedence. Arm raises IDC for
+    // operands flushed by FPCR.FZ.
+    const auto denormal = [&](std::initializer_list<FT> operands) {
+      const bool subnormal = std::ranges::any_of(operands, [](FT x) { return IsSubnormal(x); });
+      const bool nan = std::ranges::any_of(operands, [](FT x) { return IsNan(x); });
+      return x86 ? !in && subnormal && !nan : in && out && subnormal;
+    };
+    check(fpu.Add<FT>(a, b), ref.Add<FT>(flush(a), flush(b)), denormal({a, b}));
+    check(fpu.Sub<FT>(a, b), ref.Sub<FT>(flush(a), flush(b)), denormal({a, b}));
+    check(fpu.Mul<FT>(a, b), ref.Mul<FT>(flush(a), flush(b)), denormal({a, b}));
+    check(fpu.Div<FT>(a, b), ref.Div<FT>(flush(a), flush(b)), denormal({a, b}));
+    check(fpu.Sqrt<FT>(a), ref.Sqrt<FT>(flush(a)), denormal({a}));
+    check(fpu.Fma<FT>(a, b, c), ref.Fma<FT>(flush(a), flush(b), flush(c)), denormal({a, b, c}));
+    check(fpu.Fnma<FT>(a, b, c), ref.Fnma<FT>(flush(a), flush(b), flush(c)), denormal({a, b, c}));
+    check(fpu.MulxArm<FT>(a, b), ref.MulxArm<FT>(flush(a), flush(b)), denormal({a, b}));
+    check(fpu.RecipStepArm<FT>(a, b), ref.RecipStepArm<FT>(flush(a), flush(b)), denormal({a, b}));
+    check(fpu.RsqrtStepArm<FT>(a, b), ref.RsqrtStepArm<FT>(flush(a), flush(b)), denormal({a, b}));
+    check(fpu.AbsDiff<FT>(a, b), ref.AbsDiff<FT>(flush(a), flush(b)), denormal({a, b}));
+
+    // Rounding never reports DE, but Arm raises IDC for operands flushed by FPCR.FZ.
+    check(fpu.RoundToIntegral<FT>(b), ref.RoundToIntegral<FT>(flush(b)), !x86 && denormal({b}));
+    check(fpu.RoundToIntegralExact<FT>(b), ref.RoundToIntegralExact<FT>(flush(b)), !x86 && denormal({b}));
+    if (x86) {
+      const u8 imm8 = static_cast<u8>(i % 16);
+      check(fpu.Roundx86<FT>(b, imm8), ref.Roundx86<FT>(flush(b), imm8), false);
+    }
+    if constexpr (!std::is_same_v<FT, f16>)
+      check((fpu.RoundToIntegralBounded<FT, i32>(b)), (ref.RoundToIntegralBounded<FT, i32>(flush(b))),
+            !x86 && denormal({b}));
+
+    // The variants with a static rounding mode flush with flush set. The quiet ones leave all flags untouched.
+    constexpr auto kRm = Vfpu::kRoundTowardPositive;
+    check(fpu.Mul<FT, kRm, false, true>(a, b), ref.Mul<FT, kRm>(flush(a), flush(b)), denormal({a, b}));
+    check(fpu.Fma<FT, kRm, false, true>(a, b, c), ref.Fma<FT, kRm>(flush(a), flush(b), flush(c)), denormal({a, b, c}));
+    const FT quiet = fpu.Div<FT, kRm, true, true>(a, b);
+    ASSERT_FALSE(fpu.invalid || fpu.division_by_zero || fpu.overflow || fpu.underflow || fpu.inexact);
+    ASSERT_FALSE(fpu.input_denormal);
+    ASSERT_EQ(std::bit_cast<UT>(quiet), std::bit_cast<UT>(fpu.Div<FT, kRm, false, true>(a, b)));
+    fpu.ClearFlags();
+
+    // Compares and minimum/maximum operations see flushed operands, too. Their results are never flushed.
+    const bool lt = fpu.LtQuiet<FT>(a, b);
+    ASSERT_EQ(lt, ref.LtQuiet<FT>(flush(a), flush(b)));
+    const FT max = fpu.Maxx86<FT>(a, b);
+    ASSERT_EQ(std::bit_cast<UT>(max), std::bit_cast<UT>(ref.Maxx86<FT>(flush(a), flush(b))));
+    const FT min = fpu.MinimumNumber<FT>(a, b);
+    ASSERT_EQ(std::bit_cast<UT>(min), std::bit_cast<UT>(ref.MinimumNumber<FT>(flush(a), flush(b))));
+    ASSERT_EQ(fpu.invalid, ref.invalid);
+    ASSERT_EQ(fpu.input_denormal, denormal({a, b}));
+    fpu.ClearFlags();
+    ref.ClearFlags();
+  }
+}
+
+// Conversions from FT flush their operands like the arithmetic operations. Conversions to integers never raise DE,
+// and half-precision results are never flushed.
+template <typename FT>
+void DoTestFlushConversions(bool x86, bool in, bool out) {
+  using UT = FloatToUint<FT>::type;
+  std::mt19937_64 rng(kRngSeed);
+  FloppyFloat fpu;
+  FloppyFloat ref;
+  if (x86) {
+    fpu.SetupToX86();
+    ref.SetupToX86();
+  } else {
+    fpu.SetupToArm();
+    ref.SetupToArm();
+  }
+  fpu.flush_inputs = in;
+  fpu.flush_outputs = out;
+  const auto check_flags = [&](bool underflow, bool inexact, bool input_denormal) {
+    ASSERT_EQ(fpu.invalid, ref.invalid);
+    ASSERT_EQ(fpu.overflow, ref.overflow);
+    ASSERT_EQ(fpu.underflow, underflow);
+    ASSERT_EQ(fpu.inexact, inexact);
+    ASSERT_EQ(fpu.input_denormal, input_denormal);
+    fpu.ClearFlags();
+    ref.ClearFlags();
+  };
+
+  for (i32 i = 0; i < kNumIterations / 20; ++i) {
+    // Subnormals, and values around the smallest normal number of the target type (f16 for f32, f32 for f64).
+    constexpr i32 kTargetMinExp = std::is_same_v<FT, f32> ? 127 - 14 : 1023 - 126;
+    const UT exp = (i % 3 == 0) ? 0u : static_cast<UT>(kTargetMinExp + 2 - static_cast<i32>(rng() % 16));
+    const UT mask = SignMask<FT>() | static_cast<UT>((UT{1} << NumSignificandBits<FT>()) - 1u);
+    const UT bits = static_cast<UT>((static_cast<UT>(rng()) & mask) | (exp << NumSignificandBits<FT>()));
+    const FT a = std::bit_cast<FT>(bits);
+    const FT flushed = in ? FlushToZero(a) : a;
+    const bool denormal = x86 ? !in && IsSubnormal(a) : in && out && IsSubnormal(a);
+    fpu.rounding_mode = ref.rounding_mode = static_cast<Vfpu::RoundingMode>(i % 5);
+
+    ASSERT_EQ((fpu.FToFixed<FT, i32>(a, 4)), (ref.FToFixed<FT, i32>(flushed, 4)));
+    check_flags(ref.underflow, ref.inexact, !x86 && denormal);
+    if constexpr (std::is_same_v<FT, f32>) {
+      ASSERT_EQ(std::bit_cast<u16>(fpu.F32ToF16(a)), std::bit_cast<u16>(ref.F32ToF16(flushed)));
+      check_flags(ref.underflow, ref.inexact, denormal);
+    } else {
+      f32 expected = ref.F64ToF32(flushed);
+      bool underflow = ref.underflow;
+      bool inexact = ref.inexact;
+      if (out && (ref.underflow || IsSubnormal(expected))) {
+        expected = std::copysign(0.f32, expected);
+        underflow = true;
+        inexact = x86;
+      }
+      ASSERT_EQ(std::bit_cast<u32>(fpu.F64ToF32(a)), std::bit_cast<u32>(expected));
+      check_flags(underflow, inexact, denormal);
+    }
+  }
+}
+
+template <typename FT>
+void DoTestFlushDenormals() {
+  for (bool x86 : {false, true}) {
+    DoTestFlushDenormals<FT>(x86, false, false);
+    DoTestFlushDenormals<FT>(x86, true, false);
+    DoTestFlushDenormals<FT>(x86, false, true);
+    DoTestFlushDenormals<FT>(x86, true, true);
+    if constexpr (!std::is_same_v<FT, f16>) {
+      DoTestFlushConversions<FT>(x86, false, false);
+      DoTestFlushConversions<FT>(x86, true, false);
+      DoTestFlushConversions<FT>(x86, false, true);
+      DoTestFlushConversions<FT>(x86, true, true);
+    }
+  }
+}
+
+TEST(TEST_SUITE_NAME, FlushDenormals) {
+  DoTestFlushDenormals<f16>();
+  DoTestFlushDenormals<f32>();
+  DoTestFlushDenormals<f64>();
+
+  // A flushed subnormal product: x86 raises underflow and inexact, Arm only underflow (and IDC for flushed operands).
+  // The product of x and y rounds to the smallest normal number, which is tiny before rounding (Arm) but not after it.
+  const f32 x = std::bit_cast<f32>(0x20000001u);
+  const f32 y = std::bit_cast<f32>(0x1ffffffeu);
+  FloppyFloat fpu;
+  fpu.SetupToArm();
+  fpu.flush_inputs = fpu.flush_outputs = true;
+  ASSERT_EQ(std::bit_cast<u32>(fpu.Mul<f32>(-static_cast<f32>(0x1p-70), static_cast<f32>(0x1p-70))), 0x80000000u);
+  ASSERT_TRUE(fpu.underflow && !fpu.inexact && !fpu.input_denormal);
+  fpu.ClearFlags();
+  ASSERT_EQ(std::bit_cast<u32>(fpu.Mul<f32>(x, y)), 0u);
+  ASSERT_TRUE(fpu.underflow && !fpu.inexact);
+  ASSERT_EQ(fpu.Add<f32>(static_cast<f32>(0x1p-140), 1.f32), 1.f32);
+  fpu.ClearFlags();
+  // FMULX sees a flushed subnormal times infinity as 0 * inf.
+  ASSERT_EQ(fpu.MulxArm<f32>(-static_cast<f32>(0x1p-140), std::numeric_limits<f32>::infinity()), -2.f32);
+  ASSERT_TRUE(fpu.input_denormal && !fpu.invalid);
+  ASSERT_TRUE(fpu.input_denormal && !fpu.inexact);
+  const f16 tiny16 = static_cast<f16>(0x1p-10);
+  ASSERT_EQ(std::bit_cast<u16>(fpu.Mul<f16>(tiny16, tiny16)), 0x0010u);  // FPCR.FZ16 is separate.
+  fpu.SetupToX86();
+  fpu.ClearFlags();
+  ASSERT_EQ(std::bit_cast<u32>(fpu.Mul<f32>(-static_cast<f32>(0x1p-70), static_cast<f32>(0x1p-70))), 0x80000000u);
+  ASSERT_TRUE(fpu.underflow && fpu.inexact && !fpu.input_denormal);
+  fpu.ClearFlags();
+  ASSERT_EQ(fpu.Mul<f32>(x, y), std::numeric_limits<f32>::min());
+  ASSERT_TRUE(!fpu.underflow && fpu.inexact);
+}
+
+template <typename AT, typename FT>
+AT WidenForDot(FloppyFloat& fpu, FT a) {
+  if constexpr (std::is_same_v<AT, FT>)
+    return a;
+  else if constexpr (std::is_same_v<FT, f16>)
+    return fpu.F16ToF32(a);
+  else
+    return fpu.F32ToF64(a);
+}
+
+template <typename FT, typename AT>
+void DoTestDotProduct() {
+  using UT = FloatToUint<AT>::type;
+  FloatRng<FT> float_rng(kRngSeed);
+  FloatRng<AT> acc_rng(kRngSeed + 1);
+  FloatRng<f16> small_rng(kRngSeed + 2);
+  for (const auto& [unused, rm] : rounding_modes) {
+    DotProduct fpu;
+    FloppyFloat ref;
+    fpu.SetupToRiscv();
+    ref.SetupToRiscv();
+    fpu.rounding_mode = rm;
+    ref.rounding_mode = rm;
+    for (i32 i = 0; i < kNumIterations / 10; ++i) {
+      FT a[4], b[4];
+      for (i32 j = 0; j < 4; ++j) {
+        a[j] = float_rng.Gen();
+        b[j] = float_rng.Gen();
+      }
+      const AT acc = acc_rng.Gen();
+
+      // A single fused term is an FMA.
+      fpu.ClearFlags();
+      ref.ClearFlags();
+      AT expected = ref.Fma(WidenForDot<AT>(ref, a[0]), WidenForDot<AT>(ref, b[0]), acc);
+      ASSERT_EQ(std::bit_cast<UT>(fpu.Dot(DotProduct::kFused, a, b, 1, acc)), std::bit_cast<UT>(expected));
+      ASSERT_EQ(fpu.invalid, ref.invalid);
+      ASSERT_EQ(fpu.overflow, ref.overflow);
+      ASSERT_EQ(fpu.underflow, ref.underflow);
+      ASSERT_EQ(fpu.inexact, ref.inexact);
+
+      // The other profiles round like the corresponding sequences of multiplications and additions.
+      fpu.ClearFlags();
+      ref.ClearFlags();
+      AT p[4];
+      for (i32 j = 0; j < 4; ++j)
+        p[j] = ref.Mul(WidenForDot<AT>(ref, a[j]), WidenForDot<AT>(ref, b[j]));
+      expected = ref.Add(ref.Add(ref.Add(ref.Add(acc, p[0]), p[1]), p[2]), p[3]);
+      ASSERT_EQ(std::bit_cast<UT>(fpu.Dot(DotProduct::kPerStep, a, b, 4, acc)), std::bit_cast<UT>(expected));
+      ASSERT_EQ(fpu.invalid, ref.invalid);
+      ASSERT_EQ(fpu.inexact, ref.inexact);
+      for (i32 j = 0; j < 4; ++j)
+        p[j] = ref.Mul(WidenForDot<AT>(ref, a[j]), WidenForDot<AT>(ref, b[j]));
+      expected = ref.Add(acc, ref.Add(ref.Add(p[0], p[1]), ref.Add(p[2], p[3])));
+      ASSERT_EQ(std::bit_cast<UT>(fpu.Dot(DotProduct::kPairwise, a, b, 4, acc)), std::bit_cast<UT>(expected));
+
+      // Values of f16 keep the sum of four products exact in f128, which then only needs the final rounding.
+      FT c[4], d[4];
+      for (i32 j = 0; j < 4; ++j) {
+        c[j] = static_cast<FT>(FlushToZero(small_rng.Gen()));
+        d[j] = static_cast<FT>(FlushToZero(small_rng.Gen()));
+      }
+      const AT small_acc = static_cast<AT>(small_rng.Gen());
+      bool finite = !IsInfOrNan(small_acc);
+      f128 exact = static_cast<f128>(small_acc);
+      for (i32 j = 0; j < 4; ++j) {
+        finite &= !IsInfOrNan(c[j]) && !IsInfOrNan(d[j]);
+        exact += static_cast<f128>(c[j]) * static_cast<f128>(d[j]);
+      }
+      if (!finite || exact == 0)
+        continue;
+      fpu.ClearFlags();
+      ref.ClearFlags();
+      if constexpr (std::is_same_v<AT, f32>)
+        expected = ref.F128ToF32(exact);
+      else
+        expected = ref.F128ToF64(exact);
+      ASSERT_EQ(std::bit_cast<UT>(fpu.Dot(DotProduct::kFused, c, d, 4, small_acc)), std::bit_cast<UT>(expected));
+      ASSERT_EQ(fpu.overflow, ref.overflow);
+      ASSERT_EQ(fpu.underflow, ref.underflow);
+      ASSERT_EQ(fpu.inexact, ref.inexact);
+    }
+  }
+
+  // Terms that cancel exactly leave the accumulator, and an exact zero sum is -0 only when rounding down.
+  DotProduct fpu;
+  fpu.SetupToRiscv();
+  const FT big = static_cast<FT>(1024.f);
+  const FT third = static_cast<FT>(0.333251953125f);
+  const FT a[3] = {big, third, big};
+  const FT b[3] = {big, third, static_cast<FT>(-1024.f)};
+  const AT tiny = std::numeric_limits<AT>::denorm_min();
+  ASSERT_EQ(std::bit_cast<UT>(fpu.Dot(DotProduct::kFused, a, b, 3, tiny)),
+            std::bit_cast<UT>(static_cast<AT>(static_cast<f64>(third) * static_cast<f64>(third) + tiny)));
+  ASSERT_EQ(std::bit_cast<UT>(fpu.Dot(DotProduct::kFused, a, b, 1, static_cast<AT>(-1048576.f))),
+            std::bit_cast<UT>(static_cast<AT>(0.f)));
+  fpu.rounding_mode = Vfpu::kRoundTowardNegative;
+  ASSERT_EQ(std::bit_cast<UT>(fpu.Dot(DotProduct::kFused, a, b, 1, static_cast<AT>(-1048576.f))),
+            std::bit_cast<UT>(static_cast<AT>(-0.f)));
+
+  // Batches compute the same dot products as the scalar function.
+  FloatRng<FT> batch_rng(kRngSeed);
+  constexpr size_t kTerms = 3, kCount = 64;
+  std::vector<FT> x(kTerms * kCount), y(kTerms * kCount);
+  std::vector<AT> batch(kCount);
+  for (size_t j = 0; j < kTerms * kCount; ++j) {
+    x[j] = batch_rng.Gen();
+    y[j] = batch_rng.Gen();
+  }
+  for (DotProduct::Profile profile : {DotProduct::kFused, DotProduct::kPerStep, DotProduct::kPairwise}) {
+    for (size_t j = 0; j < kCount; ++j)
+      batch[j] = static_cast<AT>(j);
+    fpu.Batch(profile, batch.data(), x.data(), y.data(), kTerms, kCount);
+    for (size_t j = 0; j < kCount; ++j)
+      ASSERT_EQ(std::bit_cast<UT>(batch[j]),
+                std::bit_cast<UT>(fpu.Dot(profile, &x[j * kTerms], &y[j * kTerms], kTerms, static_cast<AT>(j))));
+  }
+}
+
+TEST(TEST_SUITE_NAME, DotProduct) {
+  DoTestDotProduct<f16, f32>();
+  DoTestDotProduct<f32, f64>();
+  DoTestDotProduct<f64, f64>();
+
+  // dpps rounds the products and the pairwise sums: (2^24 + 1) + (-2^24 + 1) = 2^24 - 2^24 + 1.
+  DotProduct fpu;
+  fpu.SetupToX86();
+  const f32 a[4] = {16777216.f32, 1.f32, -16777216.f32, 1.f32};
+  const f32 ones[4] = {1.f32, 1.f32, 1.f32, 1.f32};
+  f32 dst[4];
+  fpu.Dpps(dst, a, ones, 0xf5);
+  ASSERT_EQ(dst[0], 1.f32);
+  ASSERT_EQ(dst[1], 0.f32);
+  ASSERT_EQ(dst[2], 1.f32);
+  ASSERT_EQ(dst[3], 0.f32);
+  ASSERT_TRUE(fpu.inexact);
+  ASSERT_EQ(fpu.Dot(DotProduct::kFused, a, ones, 4, 0.f32), 2.f32);
+  fpu.Dpps(dst, a, ones, 0x58);  // Lanes 0 and 2 only.
+  ASSERT_EQ(dst[3], 0.f32);
+  ASSERT_EQ(dst[0], 0.f32);
+  fpu.ClearFlags();
+  fpu.Dpps(dst, a, ones, 0xaf);  // Lanes 1 and 3 only.
+  ASSERT_EQ(dst[2], 2.f32);
+  ASSERT_FALSE(fpu.inexact);
+
+  const f64 c[2] = {1e300, 1e-300};
+  const f64 d[2] = {1e300, 1e-300};
+  f64 dst64[2];
+  fpu.Dppd(dst64, c, d, 0x22);
+  ASSERT_EQ(dst64[0], 0.);
+  ASSERT_EQ(dst64[1], 1e-300 * 1e-300);
+  ASSERT_TRUE(fpu.underflow);
+  fpu.Dppd(dst64, c, d, 0x31);
+  ASSERT_TRUE(IsPosInf(dst64[0]));
+  ASSERT_TRUE(fpu.overflow);
+}
+
+// The instruction definitions as sequences of scalar operations.
+template <typename FT>
+void ComplexReference(FloppyFloat& ref, ComplexFloat::Operation op, FT* d, const FT* a, const FT* b) {
+  FT re, im, tr, ti;
+  switch (op) {
+  case ComplexFloat::kCmla0Arm:
+    re = ref.Fma(a[0], b[0], d[0]);
+    im = ref.Fma(a[0], b[1], d[1]);
+    break;
+  case ComplexFloat::kCmla90Arm:
+    re = ref.Fma(a[1], Negate(b[1]), d[0]);
+    im = ref.Fma(a[1], b[0], d[1]);
+    break;
+  case ComplexFloat::kCmla180Arm:
+    re = ref.Fma(a[0], Negate(b[0]), d[0]);
+    im = ref.Fma(a[0], Negate(b[1]), d[1]);
+    break;
+  case ComplexFloat::kCmla270Arm:
+    re = ref.Fma(a[1], b[1], d[0]);
+    im = ref.Fma(a[1], Negate(b[0]), d[1]);
+    break;
+  case ComplexFloat::kCadd90Arm:
+    re = ref.Sub(a[0], b[1]);
+    im = ref.Add(a[1], b[0]);
+    break;
+  case ComplexFloat::kCadd270Arm:
+    re = ref.Add(a[0], b[1]);
+    im = ref.Sub(a[1], b[0]);
+    break;
+  case ComplexFloat::kMaddcX86:
+  case ComplexFloat::kMulcX86:
+    tr = op == ComplexFloat::kMulcX86 ? ref.Mul(a[0], b[0]) : ref.Fma(a[0], b[0], d[0]);
+    ti = op == ComplexFloat::kMulcX86 ? ref.Mul(a[1], b[0]) : ref.Fma(a[1], b[0], d[1]);
+    re = ref.Fnma(a[1], b[1], tr);
+    im = ref.Fma(a[0], b[1], ti);
+    break;
+  default:
+    tr = op == ComplexFloat::kConjMulcX86 ? ref.Mul(a[0], b[0]) : ref.Fma(a[0], b[0], d[0]);
+    ti = op == ComplexFloat::kConjMulcX86 ? ref.Mul(a[1], b[0]) : ref.Fma(a[1], b[0], d[1]);
+    re = ref.Fma(a[1], b[1], tr);
+    im = ref.Fnma(a[0], b[1], ti);
+    break;
+  }
+  d[0] = re;
+  d[1] = im;
+}
+
+template <typename FT>
+void DoTestComplexFloat() {
+  using UT = FloatToUint<FT>::type;
+  constexpr size_t kSize = 200;  // Three full blocks and a remainder.
+  FloatRng<FT> float_rng(kRngSeed);
+  std::uniform_int_distribution<i32> dist(-8, 8);
+  std::mt19937 mt(kRngSeed);
+  std::vector<FT> a(2 * kSize), b(2 * kSize), acc(2 * kSize), dst(2 * kSize), expected(2 * kSize);
+  for (i32 op = ComplexFloat::kCmla0Arm; op <= ComplexFloat::kConjMulcX86; ++op) {
+    for (const auto& [unused, rm] : rounding_modes) {
+      for (i32 iteration = 0; iteration < 20; ++iteration) {
+        // Mostly moderate values, which the kernel handles, and some specials from the generator.
+        for (size_t i = 0; i < 2 * kSize; ++i) {
+          a[i] = (i % 17) ? static_cast<FT>(std::ldexp(static_cast<f64>(dist(mt)) / 3., dist(mt))) : float_rng.Gen();
+          b[i] = (i % 13) ? static_cast<FT>(std::ldexp(static_cast<f64>(dist(mt)) / 7., dist(mt))) : float_rng.Gen();
+          acc[i] = (i % 11) ? static_cast<FT>(dist(mt) / 5.) : float_rng.Gen();
+        }
+        ComplexFloat fpu;
+        FloppyFloat ref;
+        if (op >= ComplexFloat::kMaddcX86) {
+          fpu.SetupToX86();
+          ref.SetupToX86();
+        } else {
+          fpu.SetupToArm();
+          ref.SetupToArm();
+        }
+        fpu.rounding_mode = rm;
+        ref.rounding_mode = rm;
+        expected = acc;
+        for (size_t i = 0; i < kSize; ++i)
+          ComplexReference(ref, static_cast<ComplexFloat::Operation>(op), &expected[2 * i], &a[2 * i], &b[2 * i]);
+        dst = acc;
+        fpu.Batch(static_cast<ComplexFloat::Operation>(op), dst.data(), a.data(), b.data(), kSize);
+        for (size_t i = 0; i < 2 * kSize; ++i)
+          ASSERT_EQ(std::bit_cast<UT>(dst[i]), std::bit_cast<UT>(expected[i])) << op << " " << i;
+        ASSERT_EQ(fpu.invalid, ref.invalid) << op << " " << rm;
+        ASSERT_EQ(fpu.overflow, ref.overflow);
+        ASSERT_EQ(fpu.underflow, ref.underflow);
+        ASSERT_EQ(fpu.inexact, ref.inexact);
+      }
+    }
+  }
+
+  // Two FCMLA with the rotations 0 and 90 accumulate the product, 0 and 270 the product with the conjugate.
+  ComplexFloat fpu;
+  fpu.SetupToArm();
+  const FT x[2] = {static_cast<FT>(1.f), static_cast<FT>(2.f)};
+  const FT y[2] = {static_cast<FT>(3.f), static_cast<FT>(4.f)};
+  FT z[2] = {static_cast<FT>(0.f), static_cast<FT>(0.f)};
+  fpu.CmlaArm(z, x, y, 0);
+  fpu.CmlaArm(z, x, y, 90);
+  ASSERT_EQ(static_cast<f64>(z[0]), -5.);
+  ASSERT_EQ(static_cast<f64>(z[1]), 10.);
+  z[0] = z[1] = static_cast<FT>(0.f);
+  fpu.CmlaArm(z, x, y, 0);
+  fpu.CmlaArm(z, x, y, 270);
+  ASSERT_EQ(static_cast<f64>(z[0]), 11.);
+  ASSERT_EQ(static_cast<f64>(z[1]), -2.);
+  fpu.CaddArm(z, x, y, 90);
+  ASSERT_EQ(static_cast<f64>(z[0]), -3.);
+  ASSERT_EQ(static_cast<f64>(z[1]), 5.);
+  fpu.MulcX86(z, x, y, true);
+  ASSERT_EQ(static_cast<f64>(z[0]), 11.);
+  ASSERT_EQ(static_cast<f64>(z[1]), 2.);
+  ASSERT_THROW(fpu.CaddArm(z, x, y, 180), std::runtime_error);
+}
+
+TEST(TEST_SUITE_NAME, ComplexFloat) {
+  DoTestComplexFloat<f16>();
+  DoTestComplexFloat<f32>();
+  DoTestComplexFloat<f64>();
+}
+
+#if defined(ARCH_X86)
+// Canonical double extended precision values. NaN operands are covered by the X87NanPropagation test.
+f80 GenF80(std::mt19937_64& rng) {
+  const u64 r = rng();
+  const u16 sign = (r & 1) << 15;
+  const u64 signif = rng() | 0x8000000000000000ull;
+  switch ((r >> 1) % 8) {
+  case 0:
+    return f80{0, sign};
+  case 1:
+    return f80{0x8000000000000000ull, static_cast<u16>(sign | 0x7fff)};
+  case 2:
+    return f80{signif >> (1 + rng() % 63), sign};  // Denormal.
+  case 3:
+    return f80{signif, static_cast<u16>(sign | (rng() % 2 ? 1 + rng() % 64 : 0x7ffe - rng() % 64))};
+  case 4:
+    return f80{signif & (~0ull << (rng() % 64)), static_cast<u16>(sign | (16383 - 32 + rng() % 64))};
+  default:
+    return f80{signif, static_cast<u16>(sign | (16383 - 128 + rng() % 256))};
+  }
+}
+
+extFloat80_t ToSoftFloat(f80 a) {
+  extFloat80_t result;
+  result.signif = a.signif;
+  result.signExp = a.sign_exp;
+  return result;
+}
+
+void CheckX87Result(const X87& x87, f80 x87_result, extFloat80_t sf_result, size_t i) {
+  ASSERT_EQ(x87_result.sign_exp, sf_result.signExp) << "Iteration: " << i;
+  ASSERT_EQ(x87_result.signif, sf_result.signif) << "Iteration: " << i;
+  ASSERT_EQ(x87.invalid, static_cast<bool>(::softfloat_exceptionFlags & ::softfloat_flag_invalid)) << "Iteration: " << i;
+  ASSERT_EQ(x87.division_by_zero, static_cast<bool>(::softfloat_exceptionFlags & ::softfloat_flag_infinite))
+    << "Iteration: " << i;
+  ASSERT_EQ(x87.overflow, static_cast<bool>(::softfloat_exceptionFlags & ::softfloat_flag_overflow)) << "Iteration: " << i;
+  ASSERT_EQ(x87.underflow, static_cast<bool>(::softfloat_exceptionFlags & ::softfloat_flag_underflow))
+    << "Iteration: " << i;
+  ASSERT_EQ(x87.inexact, static_cast<bool>(::softfloat_exceptionFlags & ::softfloat_flag_inexact)) << "Iteration: " << i;
+}
+
+TEST(TEST_SUITE_NAME, X87Arithmetic) {
+  const std::array<std::pair<uint_fast8_t, X87::PrecisionControl>, 3> precisions{
+      {{80, X87::kPrecisionExtended}, {64, X87::kPrecisionDouble}, {32, X87::kPrecisionSingle}}};
+  std::mt19937_64 rng(kRngSeed);
+  X87 x87;
+  for (auto [sf_precision, precision] : precisions) {
+    for (auto [sf_rm, rm] : rounding_modes) {
+      ::extF80_roundingPrecision = sf_precision;
+      ::softfloat_roundingMode = sf_rm;
+      x87.precision_control = precision;
+      x87.rounding_mode = rm;
+      for (i32 i = 0; i < kNumIterations / 10; ++i) {
+        const f80 a = GenF80(rng);
+        const f80 b = GenF80(rng);
+        ::softfloat_exceptionFlags = 0;
+        x87.ClearFlags();
+        CheckX87Result(x87, x87.Add(a, b), ::extF80_add(ToSoftFloat(a), ToSoftFloat(b)), i);
+        ::softfloat_exceptionFlags = 0;
+        x87.ClearFlags();
+        CheckX87Result(x87, x87.Sub(a, b), ::extF80_sub(ToSoftFloat(a), ToSoftFloat(b)), i);
+        ::softfloat_exceptionFlags = 0;
+        x87.ClearFlags();
+        CheckX87Result(x87, x87.Mul(a, b), ::extF80_mul(ToSoftFloat(a), ToSoftFloat(b)), i);
+        ::softfloat_exceptionFlags = 0;
+        x87.ClearFlags();
+        CheckX87Result(x87, x87.Div(a, b), ::extF80_div(ToSoftFloat(a), ToSoftFloat(b)), i);
+        ::softfloat_exceptionFlags = 0;
+        x87.ClearFlags();
+        CheckX87Result(x87, x87.Sqrt(a), ::extF80_sqrt(ToSoftFloat(a)), i);
+      }
+    }
+  }
+  ::extF80_roundingPrecision = 80;
+}
+
+#if defined(__x86_64__)
+enum class X87HostOp { kAdd, kSub, kMul, kDiv, kSqrt };
+
+// Runs a single operation on the host's x87 FPU with the control word cw and returns the result. sw receives the status
+// word right after the operation, before storing the result can touch C1.
+f80 HostX87(X87HostOp op, u16 cw, f80 a, f80 b, u16& sw) {
+  f80 result{};
+  u16 saved_cw;
+  asm volatile("fnstcw %0" : "=m"(saved_cw));
+  asm volatile("fnclex\n\tfldcw %0" : : "m"(cw));
+  asm volatile("fldt %0\n\tfldt %1" : : "m"(b), "m"(a));  // ST(0) = a, ST(1) = b
+  switch (op) {
+  case X87HostOp::kAdd:
+    asm volatile("fadd %st(1), %st");
+    break;
+  case X87HostOp::kSub:
+    asm volatile("fsub %st(1), %st");
+    break;
+  case X87HostOp::kMul:
+    asm volatile("fmul %st(1), %st");
+    break;
+  case X87HostOp::kDiv:
+    asm volatile("fdiv %st(1), %st");
+    break;
+  case X87HostOp::kSqrt:
+    asm volatile("fsqrt");
+    break;
+  }
+  asm volatile("fnstsw %0" : "=m"(sw));
+  asm volatile("fstpt %0\n\tfstp %%st(0)" : "=m"(result));
+  asm volatile("fnclex\n\tfldcw %0" : : "m"(saved_cw));
+  return result;
+}
+
+// Compares X87 against the host's x87 FPU for every precision control and rounding control setting. The exception
+// flags, DE included, and the round-up indication C1 must match.
+TEST(TEST_SUITE_NAME, X87HostFpu) {
+  std::mt19937_64 rng(kRngSeed);
+  X87 x87;
+  for (u16 pc : {0, 2, 3}) {
+    for (u16 rc = 0; rc < 4; ++rc) {
+      const u16 cw = static_cast<u16>(0x007f | pc << 8 | rc << 10);  // All exceptions masked.
+      x87.SetControlWord(cw);
+      for (i32 i = 0; i < kNumIterations / 10; ++i) {
+        const f80 a = GenF80(rng);
+        const f80 b = GenF80(rng);
+        for (X87HostOp op : {X87HostOp::kAdd, X87HostOp::kSub, X87HostOp::kMul, X87HostOp::kDiv, X87HostOp::kSqrt}) {
+          u16 host_sw;
+          const f80 host_result = HostX87(op, cw, a, b, host_sw);
+          x87.ClearFlags();
+          f80 result;
+          switch (op) {
+          case X87HostOp::kAdd:
+            result = x87.Add(a, b);
+            break;
+          case X87HostOp::kSub:
+            result = x87.Sub(a, b);
+            break;
+          case X87HostOp::kMul:
+            result = x87.Mul(a, b);
+            break;
+          case X87HostOp::kDiv:
+            result = x87.Div(a, b);
+            break;
+          case X87HostOp::kSqrt:
+            result = x87.Sqrt(a);
+            break;
+          }
+          ASSERT_EQ(result.sign_exp, host_result.sign_exp) << "Iteration: " << i << ", cw: " << cw;
+          ASSERT_EQ(result.signif, host_result.signif) << "Iteration: " << i << ", cw: " << cw;
+          ASSERT_EQ(x87.GetStatusWord() & 0x023f, host_sw & 0x023f) << "Iteration: " << i << ", cw: " << cw;
+        }
+      }
+    }
+  }
+}
+#endif
+
+TEST(TEST_SUITE_NAME, X87Conversions) {
+  std::mt19937_64 rng(kRngSeed);
+  FloatRng<f32> f32_rng(kRngSeed);
+  FloatRng<f64> f64_rng(kRngSeed);
+  X87 x87;
+  for (auto [sf_rm, rm] : rounding_modes) {
+    ::softfloat_roundingMode = sf_rm;
+    x87.rounding_mode = rm;
+    for (i32 i = 0; i < kNumIterations / 10; ++i) {
+      const f32 a32 = f32_rng.Gen();
+      const f64 a64 = f64_rng.Gen();
+      const f80 a = GenF80(rng);
+      ::softfloat_exceptionFlags = 0;
+      x87.ClearFlags();
+      CheckX87Result(x87, x87.F32ToF80(a32), ::f32_to_extF80(std::bit_cast<float32_t>(a32)), i);
+      ::softfloat_exceptionFlags = 0;
+      x87.ClearFlags();
+      CheckX87Result(x87, x87.F64ToF80(a64), ::f64_to_extF80(std::bit_cast<float64_t>(a64)), i);
+      ::softfloat_exceptionFlags = 0;
+      x87.ClearFlags();
+      ASSERT_EQ(std::bit_cast<u32>(x87.F80ToF32(a)), ::extF80_to_f32(ToSoftFloat(a)).v) << "Iteration: " << i;
+      CheckX87Result(x87, a, ToSoftFloat(a), i);
+      ::softfloat_exceptionFlags = 0;
+      x87.ClearFlags();
+      ASSERT_EQ(std::bit_cast<u64>(x87.F80ToF64(a)), ::extF80_to_f64(ToSoftFloat(a)).v) << "Iteration: " << i;
+      CheckX87Result(x87, a, ToSoftFloat(a), i);
+      ::softfloat_exceptionFlags = 0;
+      x87.ClearFlags();
+      ASSERT_EQ(x87.F80ToI32(a), ::extF80_to_i32(ToSoftFloat(a), sf_rm, true)) << "Iteration: " << i;
+      CheckX87Result(x87, a, ToSoftFloat(a), i);
+      ::softfloat_exceptionFlags = 0;
+      x87.ClearFlags();
+      ASSERT_EQ(x87.F80ToI64(a), ::extF80_to_i64(ToSoftFloat(a), sf_rm, true)) << "Iteration: " << i;
+      CheckX87Result(x87, a, ToSoftFloat(a), i);
+      const i64 i64_val = static_cast<i64>(rng()) >> (rng() % 64);
+      ::softfloat_exceptionFlags = 0;
+      x87.ClearFlags();
+      CheckX87Result(x87, x87.I64ToF80(i64_val), ::i64_to_extF80(i64_val), i);
+      CheckX87Result(x87, x87.I32ToF80(static_cast<i32>(i64_val)), ::i32_to_extF80(static_cast<i32>(i64_val)), i);
+    }
+  }
+}
+
+TEST(TEST_SUITE_NAME, X87NanPropagation) {
+  X87 x87;
+  const f80 one{0x8000000000000000ull, 0x3fff};
+  const f80 qnan_small{0xc000000000000001ull, 0x7fff};
+  const f80 qnan_large{0xc000000000000002ull, 0xffff};
+  const f80 snan_large{0xa000000000000000ull, 0x7fff};
+  ASSERT_EQ(x87.Add(qnan_small, one), qnan_small);
+  ASSERT_EQ(x87.Add(one, qnan_large), qnan_large);
+  ASSERT_FALSE(x87.invalid);
+  ASSERT_EQ(x87.Mul(qnan_small, qnan_large), qnan_large);  // The larger significand wins.
+  ASSERT_EQ(x87.Sub(qnan_small, snan_large), qnan_small);  // QNaNs take precedence over SNaNs.
+  ASSERT_TRUE(x87.invalid);
+  x87.ClearFlags();
+  ASSERT_EQ(x87.Sqrt(snan_large), (f80{0xe000000000000000ull, 0x7fff}));
+  ASSERT_TRUE(x87.invalid);
+}
+
+TEST(TEST_SUITE_NAME, X87UnsupportedAndDenormalOperands) {
+  X87 x87;
+  const f80 indefinite{0xc000000000000000ull, 0xffff};
+  const f80 one{0x8000000000000000ull, 0x3fff};
+  const f80 unnormal{0x4000000000000000ull, 0x4000};
+  const f80 pseudo_infinity{0x0000000000000000ull, 0x7fff};
+  const f80 pseudo_denormal{0x8000000000000000ull, 0x0000};  // Equal to the smallest normal number.
+  ASSERT_EQ(x87.Add(unnormal, one), indefinite);
+  ASSERT_TRUE(x87.invalid);
+  x87.ClearFlags();
+  ASSERT_EQ(x87.Mul(one, pseudo_infinity), indefinite);
+  ASSERT_TRUE(x87.invalid);
+  x87.ClearFlags();
+  ASSERT_EQ(x87.F80ToI32(unnormal), std::numeric_limits<i32>::min());
+  ASSERT_TRUE(x87.invalid);
+  x87.ClearFlags();
+  ASSERT_EQ(x87.Add(pseudo_denormal, pseudo_denormal), (f80{0x8000000000000000ull, 0x0002}));
+  ASSERT_TRUE(x87.denormal);
+  ASSERT_FALSE(x87.invalid || x87.underflow || x87.inexact);
+  ASSERT_EQ(x87.GetStatusWord() & 0x7f, 0x02);
+}
+
+TEST(TEST_SUITE_NAME, X87ControlWord) {
+  X87 x87;
+  ASSERT_EQ(x87.GetControlWord(), 0x037f);
+  const f80 one{0x8000000000000000ull, 0x3fff};
+  const f80 three{0xc000000000000000ull, 0x4000};
+  x87.SetControlWord(0x007f);  // Single precision, round to nearest.
+  ASSERT_EQ(x87.precision_control, X87::kPrecisionSingle);
+  ASSERT_EQ(x87.Div(one, three), (f80{0xaaaaab0000000000ull, 0x3ffd}));
+  ASSERT_TRUE(x87.c1);  // Rounded up.
+  x87.SetControlWord(0x0e7f);  // Double precision, round toward zero.
+  ASSERT_EQ(x87.rounding_mode, X87::kRoundTowardZero);
+  ASSERT_EQ(x87.Div(one, three), (f80{0xaaaaaaaaaaaaa800ull, 0x3ffd}));
+  ASSERT_FALSE(x87.c1);
+  ASSERT_EQ(x87.GetControlWord(), 0x0e7f);
+  x87.SetControlWord(0x037e);  // Unmasks invalid operations.
+  x87.ClearFlags();
+  x87.Sqrt(f80{0x8000000000000000ull, 0xbfff});
+  ASSERT_EQ(x87.GetStatusWord() & 0x80ff, 0x8081);
+}
+
+TEST(TEST_SUITE_NAME, X87RegisterStack) {
+  X87 x87;
+  for (i32 i = 1; i <= 8; ++i)
+    x87.Push(x87.I32ToF80(i));
+  ASSERT_FALSE(x87.invalid);
+  ASSERT_EQ(x87.GetTagWord(), 0x0000);
+  x87.Fadd(0, 1);  // 8 + 7
+  ASSERT_EQ(x87.F80ToI32(x87.St(0)), 15);
+  x87.Fsqrt();
+  x87.Fmul(0, 0);
+  ASSERT_EQ(x87.F80ToI32(x87.St(0)), 15);
+  x87.Push(x87.I32ToF80(9));  // Stack overflow.
+  ASSERT_TRUE(x87.invalid && x87.stack_fault && x87.c1);
+  ASSERT_EQ(x87.St(0), (f80{0xc000000000000000ull, 0xffff}));
+  x87.ClearFlags();
+  for (i32 i = 0; i < 8; ++i)
+    x87.Pop();
+  ASSERT_FALSE(x87.invalid);
+  ASSERT_EQ(x87.GetTagWord(), 0xffff);
+  ASSERT_EQ((x87.GetStatusWord() >> 11) & 7, 7);  // TOP
+  x87.Pop();  // Stack underflow.
+  ASSERT_TRUE(x87.invalid && x87.stack_fault && !x87.c1);
+  ASSERT_EQ((x87.GetStatusWord() >> 11) & 7, 0);
+}
+
+TEST(TEST_SUITE_NAME, X87PartialRemainder) {
+  // The remainders are exact, so those of the double extended precision format must match those of binary64.
+  FloatRng<f64> float_rng(kRngSeed);
+  FloppyFloat fpu;
+  X87 x87;
+  for (i32 i = 0; i < kNumIterations; ++i) {
+    const f64 a = float_rng.Gen();
+    const f64 b = (i & 1) ? float_rng.Gen() * 0x1p-1000 : float_rng.Gen();
+    if (IsNan(a) || IsNan(b) || IsInf(a) || IsZero(b))
+      continue;
+    for (const bool round_to_nearest : {false, true}) {
+      u32 quotient;
+      bool incomplete;
+      const f64 expected = fpu.PartialRemainder(a, b, round_to_nearest, quotient, incomplete);
+      const f80 result = x87.PartialRemainder(x87.F64ToF80(a), x87.F64ToF80(b), round_to_nearest);
+      ASSERT_EQ(std::bit_cast<u64>(x87.F80ToF64(result)), std::bit_cast<u64>(expected)) << a << " " << b;
+      ASSERT_EQ(x87.c2, incomplete);
+      if (!incomplete)
+        ASSERT_EQ(static_cast<u32>(x87.c0) << 2 | static_cast<u32>(x87.c3) << 1 | static_cast<u32>(x87.c1), quotient);
+    }
+  }
+  ASSERT_FALSE(x87.inexact || x87.underflow);
+
+  x87.ClearFlags();
+  x87.Push(x87.I32ToF80(3));
+  x87.Push(x87.I32ToF80(-11));
+  x87.Fprem();
+  ASSERT_EQ(x87.F80ToI32(x87.St(0)), -2);
+  ASSERT_EQ((x87.GetStatusWord() >> 8) & 0x47, 0x42);  // C3 = Q1, C2 = 0, C1 = Q0, C0 = Q2
+  x87.SetSt(0, x87.I32ToF80(-11));
+  x87.Fprem1();
+  ASSERT_EQ(x87.F80ToI32(x87.St(0)), 1);
+  ASSERT_EQ((x87.GetStatusWord() >> 8) & 0x47, 0x01);
+  ASSERT_EQ(x87.PartialRemainder(f80{3, 0}, f80{2, 0}, false), (f80{1, 0}));  // Denormals.
+  ASSERT_EQ(x87.PartialRemainder(f80{3, 0}, f80{2, 0}, true), (f80{1, 0x8000}));
+  ASSERT_FALSE(x87.underflow);
+  x87.SetSt(0, x87.I32ToF80(0));
+  x87.Fxch(1);
+  x87.Fprem();
+  ASSERT_TRUE(x87.invalid);
+  ASSERT_EQ(x87.St(0), (f80{0xc000000000000000ull, 0xffff}));
+}
+#endif
 
 int main(int argc, char* argv[]) {
   ::testing::InitGoogleTest(&argc, argv);
@@ -6,6 +6,7 @@
 #include <gtest/gtest.h>
 
 #include <bit>
+#include <bitset>
 #include <cmath>
 #include <functional>
 #include <iostream>
@@ -13,6 +14,7 @@
 
 #include "float_rng.h"
 #include "soft_float.h"
+#include "softfloat_ref.h"
 
 extern "C" {
 #include "softfloat.h"
@@ -33,25 +35,11 @@ std::array<std::pair<uint_fast8_t, SoftFloat::RoundingMode>, 5> rounding_modes{
      {::softfloat_round_min, SoftFloat::RoundingMode::kRoundTowardNegative},
      {::softfloat_round_minMag, SoftFloat::RoundingMode::kRoundTowardZero}}};
 
-template <typename T>
-struct FFloatToSFloat;
-
-template <>
-struct FFloatToSFloat<f16> {
-  using type = float16_t;
-};
-template <>
-struct FFloatToSFloat<f32> {
-  using type = float32_t;
-};
-template <>
-struct FFloatToSFloat<f64> {
-  using type = float64_t;
-};
-
 template <typename T>
 auto ToComparableType(T a) {
-  if constexpr (std::is_floating_point<decltype(a)>::value) {
+  if constexpr (std::is_same_v<decltype(a), f128>) {
+    return ToComparableType(std::bit_cast<float128_t>(a));
+  } else if constexpr (std::is_floating_point<decltype(a)>::value) {
     return std::bit_cast<typename FloatToUint<T>::type>(a);
   } else if constexpr (std::is_same_v<decltype(a), float16_t>) {
     return a.v;
@@ -59,6 +47,8 @@ auto ToComparableType(T a) {
     return a.v;
   } else if constexpr (std::is_same_v<decltype(a), float64_t>) {
     return a.v;
+  } else if constexpr (std::is_same_v<decltype(a), float128_t>) {
+    return std::bitset<128>(a.v[1]) << 64 | std::bitset<128>(a.v[0]);  // Unlike u128, printable by gtest.
   } else {
     return a;
   }
@@ -89,6 +79,7 @@ void DoTest(FFFUNC ff_func, SFFUNC sf_func) {
   ff.SetupToX86();
 #elif defined(ARCH_ARM)
   ff.SetupToArm();
+  ff.nan_propagation_scheme = kArmNanPropagation;
 #endif
 
   ::softfloat_exceptionFlags = 0;
@@ -96,11 +87,11 @@ void DoTest(FFFUNC ff_func, SFFUNC sf_func) {
 
   FloatRng<FT> float_rng(kRngSeed);
   FT valuefa{float_rng.Gen()};
-  typename FFloatToSFloat<FT>::type valuesfa{std::bit_cast<typename FloatToUint<FT>::type>(valuefa)};
+  auto valuesfa = std::bit_cast<typename FFloatToSFloat<FT>::type>(valuefa);
   FT valuefb{float_rng.Gen()};
-  typename FFloatToSFloat<FT>::type valuesfb{std::bit_cast<typename FloatToUint<FT>::type>(valuefb)};
+  auto valuesfb = std::bit_cast<typename FFloatToSFloat<FT>::type>(valuefb);
   FT valuefc{float_rng.Gen()};
-  typename FFloatToSFloat<FT>::type valuesfc{std::bit_cast<typename FloatToUint<FT>::type>(valuefc)};
+  auto valuesfc = std::bit_cast<typename FFloatToSFloat<FT>::type>(valuefc);
 
   for (i32 i = 0; i < kNumIterations; ++i) {
     if constexpr (num_args == 1) {
@@ -133,7 +124,7 @@ void DoTest(FFFUNC ff_func, SFFUNC sf_func) {
     valuesfb = valuesfa;
     valuefb = valuefa;
     valuefa = float_rng.Gen();
-    valuesfa.v = std::bit_cast<typename FloatToUint<FT>::type>(valuefa);
+    valuesfa = std::bit_cast<typename FFloatToSFloat<FT>::type>(valuefa);
   }
 }
 
@@ -212,6 +203,11 @@ TEST_MACRO_2(Addf64, &SoftFloat::Add<f64>, f64_add, f64, 1, RoundTiesToAway)
 TEST_MACRO_2(Addf64, &SoftFloat::Add<f64>, f64_add, f64, 2, RoundTowardPositive)
 TEST_MACRO_2(Addf64, &SoftFloat::Add<f64>, f64_add, f64, 3, RoundTowardNegative)
 TEST_MACRO_2(Addf64, &SoftFloat::Add<f64>, f64_add, f64, 4, RoundTowardZero)
+TEST_MACRO_2(Addf128, &SoftFloat::Add<f128>, f128_add, f128, 0, RoundTiesToEven)
+TEST_MACRO_2(Addf128, &SoftFloat::Add<f128>, f128_add, f128, 1, RoundTiesToAway)
+TEST_MACRO_2(Addf128, &SoftFloat::Add<f128>, f128_add, f128, 2, RoundTowardPositive)
+TEST_MACRO_2(Addf128, &SoftFloat::Add<f128>, f128_add, f128, 3, RoundTowardNegative)
+TEST_MACRO_2(Addf128, &SoftFloat::Add<f128>, f128_add, f128, 4, RoundTowardZero)
 
 TEST_MACRO_2(Subf16, &SoftFloat::Sub<f16>, f16_sub, f16, 0, RoundTiesToEven)
 TEST_MACRO_2(Subf16, &SoftFloat::Sub<f16>, f16_sub, f16, 1, RoundTiesToAway)
@@ -228,6 +224,11 @@ TEST_MACRO_2(Subf64, &SoftFloat::Sub<f64>, f64_sub, f64, 1, RoundTiesToAway)
 TEST_MACRO_2(Subf64, &SoftFloat::Sub<f64>, f64_sub, f64, 2, RoundTowardPositive)
 TEST_MACRO_2(Subf64, &SoftFloat::Sub<f64>, f64_sub, f64, 3, RoundTowardNegative)
 TEST_MACRO_2(Subf64, &SoftFloat::Sub<f64>, f64_sub, f64, 4, RoundTowardZero)
+TEST_MACRO_2(Subf128, &SoftFloat::Sub<f128>, f128_sub, f128, 0, RoundTiesToEven)
+TEST_MACRO_2(Subf128, &SoftFloat::Sub<f128>, f128_sub, f128, 1, RoundTiesToAway)
+TEST_MACRO_2(Subf128, &SoftFloat::Sub<f128>, f128_sub, f128, 2, RoundTowardPositive)
+TEST_MACRO_2(Subf128, &SoftFloat::Sub<f128>, f128_sub, f128, 3, RoundTowardNegative)
+TEST_MACRO_2(Subf128, &SoftFloat::Sub<f128>, f128_sub, f128, 4, RoundTowardZero)
 
 TEST_MACRO_2(Mulf16, &SoftFloat::Mul<f16>, f16_mul, f16, 0, RoundTiesToEven)
 TEST_MACRO_2(Mulf16, &SoftFloat::Mul<f16>, f16_mul, f16, 1, RoundTiesToAway)
@@ -244,6 +245,11 @@ TEST_MACRO_2(Mulf64, &SoftFloat::Mul<f64>, f64_mul, f64, 1, RoundTiesToAway)
 TEST_MACRO_2(Mulf64, &SoftFloat::Mul<f64>, f64_mul, f64, 2, RoundTowardPositive)
 TEST_MACRO_2(Mulf64, &SoftFloat::Mul<f64>, f64_mul, f64, 3, RoundTowardNegative)
 TEST_MACRO_2(Mulf64, &SoftFloat::Mul<f64>, f64_mul, f64, 4, RoundTowardZero)
+TEST_MACRO_2(Mulf128, &SoftFloat::Mul<f128>, f128_mul, f128, 0, RoundTiesToEven)
+TEST_MACRO_2(Mulf128, &SoftFloat::Mul<f128>, f128_mul, f128, 1, RoundTiesToAway)
+TEST_MACRO_2(Mulf128, &SoftFloat::Mul<f128>, f128_mul, f128, 2, RoundTowardPositive)
+TEST_MACRO_2(Mulf128, &SoftFloat::Mul<f128>, f128_mul, f128, 3, RoundTowardNegative)
+TEST_MACRO_2(Mulf128, &SoftFloat::Mul<f128>, f128_mul, f128, 4, RoundTowardZero)
 
 TEST_MACRO_2(Divf16, &SoftFloat::Div<f16>, f16_div, f16, 0, RoundTiesToEven)
 TEST_MACRO_2(Divf16, &SoftFloat::Div<f16>, f16_div, f16, 1, RoundTiesToAway)
@@ -260,6 +266,11 @@ TEST_MACRO_2(Divf64, &SoftFloat::Div<f64>, f64_div, f64, 1, RoundTiesToAway)
 TEST_MACRO_2(Divf64, &SoftFloat::Div<f64>, f64_div, f64, 2, RoundTowardPositive)
 TEST_MACRO_2(Divf64, &SoftFloat::Div<f64>, f64_div, f64, 3, RoundTowardNegative)
 TEST_MACRO_2(Divf64, &SoftFloat::Div<f64>, f64_div, f64, 4, RoundTowardZero)
+TEST_MACRO_2(Divf128, &SoftFloat::Div<f128>, f128_div, f128, 0, RoundTiesToEven)
+TEST_MACRO_2(Divf128, &SoftFloat::Div<f128>, f128_div, f128, 1, RoundTiesToAway)
+TEST_MACRO_2(Divf128, &SoftFloat::Div<f128>, f128_div, f128, 2, RoundTowardPositive)
+TEST_MACRO_2(Divf128, &SoftFloat::Div<f128>, f128_div, f128, 3, RoundTowardNegative)
+TEST_MACRO_2(Divf128, &SoftFloat::Div<f128>, f128_div, f128, 4, RoundTowardZero)
 
 TEST_MACRO_1(Sqrtf16, &SoftFloat::Sqrt<f16>, f16_sqrt, f16, 0, RoundTiesToEven)
 TEST_MACRO_1(Sqrtf16, &SoftFloat::Sqrt<f16>, f16_sqrt, f16, 1, RoundTiesToAway)
@@ -276,22 +287,32 @@ TEST_MACRO_1(Sqrtf64, &SoftFloat::Sqrt<f64>, f64_sqrt, f64, 1, RoundTiesToAway)
 TEST_MACRO_1(Sqrtf64, &SoftFloat::Sqrt<f64>, f64_sqrt, f64, 2, RoundTowardPositive)
 TEST_MACRO_1(Sqrtf64, &SoftFloat::Sqrt<f64>, f64_sqrt, f64, 3, RoundTowardNegative)
 TEST_MACRO_1(Sqrtf64, &SoftFloat::Sqrt<f64>, f64_sqrt, f64, 4, RoundTowardZero)
-
-TEST_MACRO_3(Fmaf16, &SoftFloat::Fma<f16>, f16_mulAdd, f16, 0, RoundTiesToEven)
-TEST_MACRO_3(Fmaf16, &SoftFloat::Fma<f16>, f16_mulAdd, f16, 1, RoundTiesToAway)
-TEST_MACRO_3(Fmaf16, &SoftFloat::Fma<f16>, f16_mulAdd, f16, 2, RoundTowardPositive)
-TEST_MACRO_3(Fmaf16, &SoftFloat::Fma<f16>, f16_mulAdd, f16, 3, RoundTowardNegative)
-TEST_MACRO_3(Fmaf16, &SoftFloat::Fma<f16>, f16_mulAdd, f16, 4, RoundTowardZero)
-TEST_MACRO_3(Fmaf32, &SoftFloat::Fma<f32>, f32_mulAdd, f32, 0, RoundTiesToEven)
-TEST_MACRO_3(Fmaf32, &SoftFloat::Fma<f32>, f32_mulAdd, f32, 1, RoundTiesToAway)
-TEST_MACRO_3(Fmaf32, &SoftFloat::Fma<f32>, f32_mulAdd, f32, 2, RoundTowardPositive)
-TEST_MACRO_3(Fmaf32, &SoftFloat::Fma<f32>, f32_mulAdd, f32, 3, RoundTowardNegative)
-TEST_MACRO_3(Fmaf32, &SoftFloat::Fma<f32>, f32_mulAdd, f32, 4, RoundTowardZero)
-TEST_MACRO_3(Fmaf64, &SoftFloat::Fma<f64>, f64_mulAdd, f64, 0, RoundTiesToEven)
-TEST_MACRO_3(Fmaf64, &SoftFloat::Fma<f64>, f64_mulAdd, f64, 1, RoundTiesToAway)
-TEST_MACRO_3(Fmaf64, &SoftFloat::Fma<f64>, f64_mulAdd, f64, 2, RoundTowardPositive)
-TEST_MACRO_3(Fmaf64, &SoftFloat::Fma<f64>, f64_mulAdd, f64, 3, RoundTowardNegative)
-TEST_MACRO_3(Fmaf64, &SoftFloat::Fma<f64>, f64_mulAdd, f64, 4, RoundTowardZero)
+TEST_MACRO_1(Sqrtf128, &SoftFloat::Sqrt<f128>, f128_sqrt, f128, 0, RoundTiesToEven)
+TEST_MACRO_1(Sqrtf128, &SoftFloat::Sqrt<f128>, f128_sqrt, f128, 1, RoundTiesToAway)
+TEST_MACRO_1(Sqrtf128, &SoftFloat::Sqrt<f128>, f128_sqrt, f128, 2, RoundTowardPositive)
+TEST_MACRO_1(Sqrtf128, &SoftFloat::Sqrt<f128>, f128_sqrt, f128, 3, RoundTowardNegative)
+TEST_MACRO_1(Sqrtf128, &SoftFloat::Sqrt<f128>, f128_sqrt, f128, 4, RoundTowardZero)
+
+TEST_MACRO_3(Fmaf16, &SoftFloat::Fma<f16>, f16_mulAddRef, f16, 0, RoundTiesToEven)
+TEST_MACRO_3(Fmaf16, &SoftFloat::Fma<f16>, f16_mulAddRef, f16, 1, RoundTiesToAway)
+TEST_MACRO_3(Fmaf16, &SoftFloat::Fma<f16>, f16_mulAddRef, f16, 2, RoundTowardPositive)
+TEST_MACRO_3(Fmaf16, &SoftFloat::Fma<f16>, f16_mulAddRef, f16, 3, RoundTowardNegative)
+TEST_MACRO_3(Fmaf16, &SoftFloat::Fma<f16>, f16_mulAddRef, f16, 4, RoundTowardZero)
+TEST_MACRO_3(Fmaf32, &SoftFloat::Fma<f32>, f32_mulAddRef, f32, 0, RoundTiesToEven)
+TEST_MACRO_3(Fmaf32, &SoftFloat::Fma<f32>, f32_mulAddRef, f32, 1, RoundTiesToAway)
+TEST_MACRO_3(Fmaf32, &SoftFloat::Fma<f32>, f32_mulAddRef, f32, 2, RoundTowardPositive)
+TEST_MACRO_3(Fmaf32, &SoftFloat::Fma<f32>, f32_mulAddRef, f32, 3, RoundTowardNegative)
+TEST_MACRO_3(Fmaf32, &SoftFloat::Fma<f32>, f32_mulAddRef, f32, 4, RoundTowardZero)
+TEST_MACRO_3(Fmaf64, &SoftFloat::Fma<f64>, f64_mulAddRef, f64, 0, RoundTiesToEven)
+TEST_MACRO_3(Fmaf64, &SoftFloat::Fma<f64>, f64_mulAddRef, f64, 1, RoundTiesToAway)
+TEST_MACRO_3(Fmaf64, &SoftFloat::Fma<f64>, f64_mulAddRef, f64, 2, RoundTowardPositive)
+TEST_MACRO_3(Fmaf64, &SoftFloat::Fma<f64>, f64_mulAddRef, f64, 3, RoundTowardNegative)
+TEST_MACRO_3(Fmaf64, &SoftFloat::Fma<f64>, f64_mulAddRef, f64, 4, RoundTowardZero)
+TEST_MACRO_3(Fmaf128, &SoftFloat::Fma<f128>, f128_mulAddRef, f128, 0, RoundTiesToEven)
+TEST_MACRO_3(Fmaf128, &SoftFloat::Fma<f128>, f128_mulAddRef, f128, 1, RoundTiesToAway)
+TEST_MACRO_3(Fmaf128, &SoftFloat::Fma<f128>, f128_mulAddRef, f128, 2, RoundTowardPositive)
+TEST_MACRO_3(Fmaf128, &SoftFloat::Fma<f128>, f128_mulAddRef, f128, 3, RoundTowardNegative)
+TEST_MACRO_3(Fmaf128, &SoftFloat::Fma<f128>, f128_mulAddRef, f128, 4, RoundTowardZero)
 
 // TEST_MACRO_1(F16ToF32, static_cast<f32 (SoftFloat::*)(f16)>(&SoftFloat::F16ToF32), f16_to_f32, f16, 0, )
 // TEST_MACRO_1(F16ToF64, static_cast<f64 (SoftFloat::*)(f16)>(&SoftFloat::F16ToF64), f16_to_f64, f16, 0, )
@@ -311,6 +332,16 @@ TEST_MACRO_1(F64ToF32, static_cast<f32 (SoftFloat::*)(f64)>(&SoftFloat::F64ToF32
 TEST_MACRO_1(F64ToF32, static_cast<f32 (SoftFloat::*)(f64)>(&SoftFloat::F64ToF32), f64_to_f32, f64, 2, RoundTowardPositive)
 TEST_MACRO_1(F64ToF32, static_cast<f32 (SoftFloat::*)(f64)>(&SoftFloat::F64ToF32), f64_to_f32, f64, 3, RoundTowardNegative)
 TEST_MACRO_1(F64ToF32, static_cast<f32 (SoftFloat::*)(f64)>(&SoftFloat::F64ToF32), f64_to_f32, f64, 4, RoundTowardZero)
+TEST_MACRO_1(F128ToF32, static_cast<f32 (SoftFloat::*)(f128)>(&SoftFloat::F128ToF32), f128_to_f32, f128, 0, RoundTiesToEven)
+TEST_MACRO_1(F128ToF32, static_cast<f32 (SoftFloat::*)(f128)>(&SoftFloat::F128ToF32), f128_to_f32, f128, 1, RoundTiesToAway)
+TEST_MACRO_1(F128ToF32, static_cast<f32 (SoftFloat::*)(f128)>(&SoftFloat::F128ToF32), f128_to_f32, f128, 2, RoundTowardPositive)
+TEST_MACRO_1(F128ToF32, static_cast<f32 (SoftFloat::*)(f128)>(&SoftFloat::F128ToF32), f128_to_f32, f128, 3, RoundTowardNegative)
+TEST_MACRO_1(F128ToF32, static_cast<f32 (SoftFloat::*)(f128)>(&SoftFloat::F128ToF32), f128_to_f32, f128, 4, RoundTowardZero)
+TEST_MACRO_1(F128ToF64, static_cast<f64 (SoftFloat::*)(f128)>(&SoftFloat::F128ToF64), f128_to_f64, f128, 0, RoundTiesToEven)
+TEST_MACRO_1(F128ToF64, static_cast<f64 (SoftFloat::*)(f128)>(&SoftFloat::F128ToF64), f128_to_f64, f128, 1, RoundTiesToAway)
+TEST_MACRO_1(F128ToF64, static_cast<f64 (SoftFloat::*)(f128)>(&SoftFloat::F128ToF64), f128_to_f64, f128, 2, RoundTowardPositive)
+TEST_MACRO_1(F128ToF64, static_cast<f64 (SoftFloat::*)(f128)>(&SoftFloat::F128ToF64), f128_to_f64, f128, 3, RoundTowardNegative)
+TEST_MACRO_1(F128ToF64, static_cast<f64 (SoftFloat::*)(f128)>(&SoftFloat::F128ToF64), f128_to_f64, f128, 4, RoundTowardZero)
 
 TEST_MACRO_FTOI(F16ToI32, static_cast<i32 (SoftFloat::*)(f16)>(&SoftFloat::F16ToI32), f16_to_i32, f16, 0, RoundTiesToEven)
 TEST_MACRO_FTOI(F16ToI32, static_cast<i32 (SoftFloat::*)(f16)>(&SoftFloat::F16ToI32), f16_to_i32, f16, 1, RoundTiesToAway)
@@ -375,6 +406,27 @@ TEST_MACRO_FTOI(F64ToU64, static_cast<u64 (SoftFloat::*)(f64)>(&SoftFloat::F64To
 TEST_MACRO_FTOI(F64ToU64, static_cast<u64 (SoftFloat::*)(f64)>(&SoftFloat::F64ToU64), f64_to_ui64, f64, 3, RoundTowardNegative)
 TEST_MACRO_FTOI(F64ToU64, static_cast<u64 (SoftFloat::*)(f64)>(&SoftFloat::F64ToU64), f64_to_ui64, f64, 4, RoundTowardZero)
 
+TEST_MACRO_FTOI(F128ToI32, static_cast<i32 (SoftFloat::*)(f128)>(&SoftFloat::F128ToI32), f128_to_i32, f128, 0, RoundTiesToEven)
+TEST_MACRO_FTOI(F128ToI32, static_cast<i32 (SoftFloat::*)(f128)>(&SoftFloat::F128ToI32), f128_to_i32, f128, 1, RoundTiesToAway)
+TEST_MACRO_FTOI(F128ToI32, static_cast<i32 (SoftFloat::*)(f128)>(&SoftFloat::F128ToI32), f128_to_i32, f128, 2, RoundTowardPositive)
+TEST_MACRO_FTOI(F128ToI32, static_cast<i32 (SoftFloat::*)(f128)>(&SoftFloat::F128ToI32), f128_to_i32, f128, 3, RoundTowardNegative)
+TEST_MACRO_FTOI(F128ToI32, static_cast<i32 (SoftFloat::*)(f128)>(&SoftFloat::F128ToI32), f128_to_i32, f128, 4, RoundTowardZero)
+TEST_MACRO_FTOI(F128ToI64, static_cast<i64 (SoftFloat::*)(f128)>(&SoftFloat::F128ToI64), f128_to_i64, f128, 0, RoundTiesToEven)
+TEST_MACRO_FTOI(F128ToI64, static_cast<i64 (SoftFloat::*)(f128)>(&SoftFloat::F128ToI64), f128_to_i64, f128, 1, RoundTiesToAway)
+TEST_MACRO_FTOI(F128ToI64, static_cast<i64 (SoftFloat::*)(f128)>(&SoftFloat::F128ToI64), f128_to_i64, f128, 2, RoundTowardPositive)
+TEST_MACRO_FTOI(F128ToI64, static_cast<i64 (SoftFloat::*)(f128)>(&SoftFloat::F128ToI64), f128_to_i64, f128, 3, RoundTowardNegative)
+TEST_MACRO_FTOI(F128ToI64, static_cast<i64 (SoftFloat::*)(f128)>(&SoftFloat::F128ToI64), f128_to_i64, f128, 4, RoundTowardZero)
+TEST_MACRO_FTOI(F128ToU32, static_cast<u32 (SoftFloat::*)(f128)>(&SoftFloat::F128ToU32), f128_to_ui32, f128, 0, RoundTiesToEven)
+TEST_MACRO_FTOI(F128ToU32, static_cast<u32 (SoftFloat::*)(f128)>(&SoftFloat::F128ToU32), f128_to_ui32, f128, 1, RoundTiesToAway)
+TEST_MACRO_FTOI(F128ToU32, static_cast<u32 (SoftFloat::*)(f128)>(&SoftFloat::F128ToU32), f128_to_ui32, f128, 2, RoundTowardPositive)
+TEST_MACRO_FTOI(F128ToU32, static_cast<u32 (SoftFloat::*)(f128)>(&SoftFloat::F128ToU32), f128_to_ui32, f128, 3, RoundTowardNegative)
+TEST_MACRO_FTOI(F128ToU32, static_cast<u32 (SoftFloat::*)(f128)>(&SoftFloat::F128ToU32), f128_to_ui32, f128, 4, RoundTowardZero)
+TEST_MACRO_FTOI(F128ToU64, static_cast<u64 (SoftFloat::*)(f128)>(&SoftFloat::F128ToU64), f128_to_ui64, f128, 0, RoundTiesToEven)
+TEST_MACRO_FTOI(F128ToU64, static_cast<u64 (SoftFloat::*)(f128)>(&SoftFloat::F128ToU64), f128_to_ui64, f128, 1, RoundTiesToAway)
+TEST_MACRO_FTOI(F128ToU64, static_cast<u64 (SoftFloat::*)(f128)>(&SoftFloat::F128ToU64), f128_to_ui64, f128, 2, RoundTowardPositive)
+TEST_MACRO_FTOI(F128ToU64, static_cast<u64 (SoftFloat::*)(f128)>(&SoftFloat::F128ToU64), f128_to_ui64, f128, 3, RoundTowardNegative)
+TEST_MACRO_FTOI(F128ToU64, static_cast<u64 (SoftFloat::*)(f128)>(&SoftFloat::F128ToU64), f128_to_ui64, f128, 4, RoundTowardZero)
+
 TEST_MACRO_ITOF(I32ToF16, I32ToF16, i32_to_f16, i32, 0, RoundTiesToEven)
 TEST_MACRO_ITOF(I32ToF16, I32ToF16, i32_to_f16, i32, 1, RoundTiesToAway)
 TEST_MACRO_ITOF(I32ToF16, I32ToF16, i32_to_f16, i32, 2, RoundTowardPositive)
@@ -390,6 +442,11 @@ TEST_MACRO_ITOF(I32ToF64, I32ToF64, i32_to_f64, i32, 1, RoundTiesToAway)
 TEST_MACRO_ITOF(I32ToF64, I32ToF64, i32_to_f64, i32, 2, RoundTowardPositive)
 TEST_MACRO_ITOF(I32ToF64, I32ToF64, i32_to_f64, i32, 3, RoundTowardNegative)
 TEST_MACRO_ITOF(I32ToF64, I32ToF64, i32_to_f64, i32, 4, RoundTowardZero)
+TEST_MACRO_ITOF(I32ToF128, I32ToF128, i32_to_f128, i32, 0, RoundTiesToEven)
+TEST_MACRO_ITOF(I32ToF128, I32ToF128, i32_to_f128, i32, 1, RoundTiesToAway)
+TEST_MACRO_ITOF(I32ToF128, I32ToF128, i32_to_f128, i32, 2, RoundTowardPositive)
+TEST_MACRO_ITOF(I32ToF128, I32ToF128, i32_to_f128, i32, 3, RoundTowardNegative)
+TEST_MACRO_ITOF(I32ToF128, I32ToF128, i32_to_f128, i32, 4, RoundTowardZero)
 
 TEST_MACRO_ITOF(U32ToF16, U32ToF16, ui32_to_f16, u32, 0, RoundTiesToEven)
 TEST_MACRO_ITOF(U32ToF16, U32ToF16, ui32_to_f16, u32, 1, RoundTiesToAway)
@@ -406,6 +463,11 @@ TEST_MACRO_ITOF(U32ToF64, U32ToF64, ui32_to_f64, u32, 1, RoundTiesToAway)
 TEST_MACRO_ITOF(U32ToF64, U32ToF64, ui32_to_f64, u32, 2, RoundTowardPositive)
 TEST_MACRO_ITOF(U32ToF64, U32ToF64, ui32_to_f64, u32, 3, RoundTowardNegative)
 TEST_MACRO_ITOF(U32ToF64, U32ToF64, ui32_to_f64, u32, 4, RoundTowardZero)
+TEST_MACRO_ITOF(U32ToF128, U32ToF128, ui32_to_f128, u32, 0, RoundTiesToEven)
+TEST_MACRO_ITOF(U32ToF128, U32ToF128, ui32_to_f128, u32, 1, RoundTiesToAway)
+TEST_MACRO_ITOF(U32ToF128, U32ToF128, ui32_to_f128, u32, 2, RoundTowardPositive)
+TEST_MACRO_ITOF(U32ToF128, U32ToF128, ui32_to_f128, u32, 3, RoundTowardNegative)
+TEST_MACRO_ITOF(U32ToF128, U32ToF128, ui32_to_f128, u32, 4, RoundTowardZero)
 
 TEST_MACRO_ITOF(I64ToF16, I64ToF16, i64_to_f16, i64, 0, RoundTiesToEven)
 TEST_MACRO_ITOF(I64ToF16, I64ToF16, i64_to_f16, i64, 1, RoundTiesToAway)
@@ -422,6 +484,11 @@ TEST_MACRO_ITOF(I64ToF64, I64ToF64, i64_to_f64, i64, 1, RoundTiesToAway)
 TEST_MACRO_ITOF(I64ToF64, I64ToF64, i64_to_f64, i64, 2, RoundTowardPositive)
 TEST_MACRO_ITOF(I64ToF64, I64ToF64, i64_to_f64, i64, 3, RoundTowardNegative)
 TEST_MACRO_ITOF(I64ToF64, I64ToF64, i64_to_f64, i64, 4, RoundTowardZero)
+TEST_MACRO_ITOF(I64ToF128, I64ToF128, i64_to_f128, i64, 0, RoundTiesToEven)
+TEST_MACRO_ITOF(I64ToF128, I64ToF128, i64_to_f128, i64, 1, RoundTiesToAway)
+TEST_MACRO_ITOF(I64ToF128, I64ToF128, i64_to_f128, i64, 2, RoundTowardPositive)
+TEST_MACRO_ITOF(I64ToF128, I64ToF128, i64_to_f128, i64, 3, RoundTowardNegative)
+TEST_MACRO_ITOF(I64ToF128, I64ToF128, i64_to_f128, i64, 4, RoundTowardZero)
 
 TEST_MACRO_ITOF(U64ToF16, U64ToF16, ui64_to_f16, u64, 0, RoundTiesToEven)
 TEST_MACRO_ITOF(U64ToF16, U64ToF16, ui64_to_f16, u64, 1, RoundTiesToAway)
@@ -438,6 +505,11 @@ TEST_MACRO_ITOF(U64ToF64, U64ToF64, ui64_to_f64, u64, 1, RoundTiesToAway)
 TEST_MACRO_ITOF(U64ToF64, U64ToF64, ui64_to_f64, u64, 2, RoundTowardPositive)
 TEST_MACRO_ITOF(U64ToF64, U64ToF64, ui64_to_f64, u64, 3, RoundTowardNegative)
 TEST_MACRO_ITOF(U64ToF64, U64ToF64, ui64_to_f64, u64, 4, RoundTowardZero)
+TEST_MACRO_ITOF(U64ToF128, U64ToF128, ui64_to_f128, u64, 0, RoundTiesToEven)
+TEST_MACRO_ITOF(U64ToF128, U64ToF128, ui64_to_f128, u64, 1, RoundTiesToAway)
+TEST_MACRO_ITOF(U64ToF128, U64ToF128, ui64_to_f128, u64, 2, RoundTowardPositive)
+TEST_MACRO_ITOF(U64ToF128, U64ToF128, ui64_to_f128, u64, 3, RoundTowardNegative)
+TEST_MACRO_ITOF(U64ToF128, U64ToF128, ui64_to_f128, u64, 4, RoundTowardZero)
 
 int main(int argc, char* argv[]) {
   ::testing::InitGoogleTest(&argc, argv);